@@ -46,6 +46,12 @@ if exist obj\scintilla\version.txt (
 ) else (
     set BUILD_SCINTILLA=1
 )
+REM The version only changes with upstream releases - also rebuild when a source or header
+REM is newer than the library, as local changes to Scintilla don't touch version.txt
+if !BUILD_SCINTILLA! equ 0 (
+    powershell -NoProfile -Command "$lib = (Get-Item obj\scintilla\libscintilla.a).LastWriteTime; if (Get-ChildItem scintilla\include, scintilla\src, scintilla\win32 -File | Where-Object { $_.LastWriteTime -gt $lib }) { exit 1 }"
+    if errorlevel 1 set BUILD_SCINTILLA=1
+)
 
 if !BUILD_SCINTILLA! equ 1 (
     echo Building Scintilla static library ^(version !SCI_VERSION!^)...
@@ -93,6 +99,19 @@ if errorlevel 1 echo Error compiling window.c && exit /b 1
 gcc -c src/editor.c -o obj/editor.o -Isrc %CFLAGS%
 if errorlevel 1 echo Error compiling editor.c && exit /b 1
 
+gcc -c src/wordindex.c -o obj/wordindex.o -Isrc %CFLAGS%
+if errorlevel 1 echo Error compiling wordindex.c && exit /b 1
+gcc -c src/occurrences.c -o obj/occurrences.o -Isrc %CFLAGS%
+if errorlevel 1 echo Error compiling occurrences.c && exit /b 1
+gcc -c src/matchindex.c -o obj/matchindex.o -Isrc %CFLAGS%
+if errorlevel 1 echo Error compiling matchindex.c && exit /b 1
+gcc -c src/findresults.c -o obj/findresults.o -Isrc %CFLAGS%
+if errorlevel 1 echo Error compiling findresults.c && exit /b 1
+gcc -c src/incsearch.c -o obj/incsearch.o -Isrc %CFLAGS%
+if errorlevel 1 echo Error compiling incsearch.c && exit /b 1
+gcc -c src/findinfiles.c -o obj/findinfiles.o -Isrc %CFLAGS%
+if errorlevel 1 echo Error compiling findinfiles.c && exit /b 1
+
 gcc -c src/resource.c -o obj/resource.o -Isrc %CFLAGS%
 if errorlevel 1 echo Error compiling resource.c && exit /b 1
 
@@ -117,6 +136,9 @@ if errorlevel 1 echo Error compiling lexer_mappings_generated.c && exit /b 1
 gcc -c src/syntax.c -o obj/syntax.o -Isrc %CFLAGS%
 if errorlevel 1 echo Error compiling syntax.c && exit /b 1
 
+gcc -c src/sniff.c -o obj/sniff.o -Isrc %CFLAGS%
+if errorlevel 1 echo Error compiling sniff.c && exit /b 1
+
 gcc -c src/config.c -o obj/config.o -Isrc %CFLAGS%
 if errorlevel 1 echo Error compiling config.c && exit /b 1
 
@@ -129,6 +151,12 @@ if errorlevel 1 echo Error compiling session.c && exit /b 1
 gcc -c src/fileops.c -o obj/fileops.o -Isrc %CFLAGS%
 if errorlevel 1 echo Error compiling fileops.c && exit /b 1
 
+gcc -c src/largefile.c -o obj/largefile.o -Isrc %CFLAGS%
+if errorlevel 1 echo Error compiling largefile.c && exit /b 1
+
+gcc -c src/autosave.c -o obj/autosave.o -Isrc %CFLAGS%
+if errorlevel 1 echo Error compiling autosave.c && exit /b 1
+
 gcc -c src/splitview.c -o obj/splitview.o -Isrc %CFLAGS%
 if errorlevel 1 echo Error compiling splitview.c && exit /b 1
 
@@ -141,9 +169,12 @@ if errorlevel 1 echo Error compiling preferences.c && exit /b 1
 gcc -c src/shellintegrate.c -o obj/shellintegrate.o -Isrc %CFLAGS%
 if errorlevel 1 echo Error compiling shellintegrate.c && exit /b 1
 
+g++ -c src/scintilla_bridge.cxx -o obj/scintilla_bridge.o -Isrc -Iscintilla/src %CXXFLAGS%
+if errorlevel 1 echo Error compiling scintilla_bridge.cxx && exit /b 1
+
 REM Link the executable with static libraries
 echo Linking executable with static libraries...
-gcc %LDFLAGS% obj/main.o obj/window.o obj/editor.o obj/resource.o obj/tabs.o obj/toolbar.o obj/statusbar.o obj/findreplace.o obj/themes.o obj/lexer_mappings_generated.o obj/syntax.o obj/config.o obj/registry_config.o obj/session.o obj/fileops.o obj/splitview.o obj/gotoline.o obj/preferences.o obj/shellintegrate.o obj/resources.o obj/scintilla/libscintilla.a obj/lexilla/liblexilla.a -o bin/notepad+.exe -mwindows -lcomctl32 -lgdi32 -luser32 -lkernel32 -lshell32 -lcomdlg32 -ldwmapi -ladvapi32 -lshlwapi -lstdc++ -lole32 -luuid -loleaut32 -limm32
+gcc %LDFLAGS% obj/main.o obj/window.o obj/editor.o obj/wordindex.o obj/occurrences.o obj/matchindex.o obj/findresults.o obj/incsearch.o obj/resource.o obj/tabs.o obj/toolbar.o obj/statusbar.o obj/findreplace.o obj/findinfiles.o obj/themes.o obj/lexer_mappings_generated.o obj/syntax.o obj/sniff.o obj/config.o obj/registry_config.o obj/session.o obj/fileops.o obj/largefile.o obj/autosave.o obj/splitview.o obj/gotoline.o obj/preferences.o obj/shellintegrate.o obj/scintilla_bridge.o obj/resources.o obj/scintilla/libscintilla.a obj/lexilla/liblexilla.a -o bin/notepad+.exe -mwindows -lcomctl32 -lgdi32 -luser32 -lkernel32 -lshell32 -lcomdlg32 -ldwmapi -ladvapi32 -lshlwapi -lpsapi -lstdc++ -lole32 -luuid -loleaut32 -limm32
 if errorlevel 1 echo Error linking executable && exit /b 1
 
 echo Build completed successfully!
@@ -173,6 +204,7 @@ g++ -c %SCI_SRC%/ChangeHistory.cxx -o obj/scintilla/ChangeHistory.o %SCI_CFLAGS%
 g++ -c %SCI_SRC%/CharacterCategoryMap.cxx -o obj/scintilla/CharacterCategoryMap.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/CharacterType.cxx -o obj/scintilla/CharacterType.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/CharClassify.cxx -o obj/scintilla/CharClassify.o %SCI_CFLAGS% || exit /b 1
+g++ -c %SCI_SRC%/Compression.cxx -o obj/scintilla/Compression.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/ContractionState.cxx -o obj/scintilla/ContractionState.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/DBCS.cxx -o obj/scintilla/DBCS.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/Decoration.cxx -o obj/scintilla/Decoration.o %SCI_CFLAGS% || exit /b 1
@@ -184,13 +216,17 @@ g++ -c %SCI_SRC%/Geometry.cxx -o obj/scintilla/Geometry.o %SCI_CFLAGS% || exit /
 g++ -c %SCI_SRC%/Indicator.cxx -o obj/scintilla/Indicator.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/KeyMap.cxx -o obj/scintilla/KeyMap.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/LineMarker.cxx -o obj/scintilla/LineMarker.o %SCI_CFLAGS% || exit /b 1
+g++ -c %SCI_SRC%/LinearRegex.cxx -o obj/scintilla/LinearRegex.o %SCI_CFLAGS% || exit /b 1
+g++ -c %SCI_SRC%/LiteralSearch.cxx -o obj/scintilla/LiteralSearch.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/MarginView.cxx -o obj/scintilla/MarginView.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/PerLine.cxx -o obj/scintilla/PerLine.o %SCI_CFLAGS% || exit /b 1
+g++ -c %SCI_SRC%/PieceTable.cxx -o obj/scintilla/PieceTable.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/PositionCache.cxx -o obj/scintilla/PositionCache.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/RESearch.cxx -o obj/scintilla/RESearch.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/RunStyles.cxx -o obj/scintilla/RunStyles.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/Selection.cxx -o obj/scintilla/Selection.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/Style.cxx -o obj/scintilla/Style.o %SCI_CFLAGS% || exit /b 1
+g++ -c %SCI_SRC%/TextScanner.cxx -o obj/scintilla/TextScanner.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/UndoHistory.cxx -o obj/scintilla/UndoHistory.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/UniConversion.cxx -o obj/scintilla/UniConversion.o %SCI_CFLAGS% || exit /b 1
 g++ -c %SCI_SRC%/UniqueString.cxx -o obj/scintilla/UniqueString.o %SCI_CFLAGS% || exit /b 1
@@ -207,7 +243,7 @@ g++ -c %WIN32_SRC%/SurfaceD2D.cxx -o obj/scintilla/SurfaceD2D.o %SCI_CFLAGS% ||
 g++ -c %WIN32_SRC%/ScintillaWin.cxx -o obj/scintilla/ScintillaWin.o %SCI_CFLAGS% || exit /b 1
 
 echo Creating Scintilla static library...
-ar rcs obj/scintilla/libscintilla.a obj/scintilla/AutoComplete.o obj/scintilla/CallTip.o obj/scintilla/CaseConvert.o obj/scintilla/CaseFolder.o obj/scintilla/CellBuffer.o obj/scintilla/ChangeHistory.o obj/scintilla/CharacterCategoryMap.o obj/scintilla/CharacterType.o obj/scintilla/CharClassify.o obj/scintilla/ContractionState.o obj/scintilla/DBCS.o obj/scintilla/Decoration.o obj/scintilla/Document.o obj/scintilla/EditModel.o obj/scintilla/Editor.o obj/scintilla/EditView.o obj/scintilla/Geometry.o obj/scintilla/Indicator.o obj/scintilla/KeyMap.o obj/scintilla/LineMarker.o obj/scintilla/MarginView.o obj/scintilla/PerLine.o obj/scintilla/PositionCache.o obj/scintilla/RESearch.o obj/scintilla/RunStyles.o obj/scintilla/Selection.o obj/scintilla/Style.o obj/scintilla/UndoHistory.o obj/scintilla/UniConversion.o obj/scintilla/UniqueString.o obj/scintilla/ViewStyle.o obj/scintilla/XPM.o obj/scintilla/ScintillaBase.o obj/scintilla/HanjaDic.o obj/scintilla/PlatWin.o obj/scintilla/ListBox.o obj/scintilla/SurfaceGDI.o obj/scintilla/SurfaceD2D.o obj/scintilla/ScintillaWin.o
+ar rcs obj/scintilla/libscintilla.a obj/scintilla/AutoComplete.o obj/scintilla/CallTip.o obj/scintilla/CaseConvert.o obj/scintilla/CaseFolder.o obj/scintilla/CellBuffer.o obj/scintilla/ChangeHistory.o obj/scintilla/CharacterCategoryMap.o obj/scintilla/CharacterType.o obj/scintilla/CharClassify.o obj/scintilla/Compression.o obj/scintilla/ContractionState.o obj/scintilla/DBCS.o obj/scintilla/Decoration.o obj/scintilla/Document.o obj/scintilla/EditModel.o obj/scintilla/Editor.o obj/scintilla/EditView.o obj/scintilla/Geometry.o obj/scintilla/Indicator.o obj/scintilla/KeyMap.o obj/scintilla/LineMarker.o obj/scintilla/LinearRegex.o obj/scintilla/LiteralSearch.o obj/scintilla/MarginView.o obj/scintilla/PerLine.o obj/scintilla/PieceTable.o obj/scintilla/PositionCache.o obj/scintilla/RESearch.o obj/scintilla/RunStyles.o obj/scintilla/Selection.o obj/scintilla/Style.o obj/scintilla/TextScanner.o obj/scintilla/UndoHistory.o obj/scintilla/UniConversion.o obj/scintilla/UniqueString.o obj/scintilla/ViewStyle.o obj/scintilla/XPM.o obj/scintilla/ScintillaBase.o obj/scintilla/HanjaDic.o obj/scintilla/PlatWin.o obj/scintilla/ListBox.o obj/scintilla/SurfaceGDI.o obj/scintilla/SurfaceD2D.o obj/scintilla/ScintillaWin.o
 echo Scintilla static library built successfully
 exit /b 0
 
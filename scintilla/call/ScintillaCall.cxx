@@ -523,6 +523,14 @@ int ScintillaCall::Margins() {
 	return static_cast<int>(Call(Message::GetMargins));
 }
 
+void ScintillaCall::SetLineNumberOffset(Line offset) {
+	Call(Message::SetLineNumberOffset, offset);
+}
+
+Line ScintillaCall::LineNumberOffset() {
+	return Call(Message::GetLineNumberOffset);
+}
+
 void ScintillaCall::StyleClearAll() {
 	Call(Message::StyleClearAll);
 }
@@ -871,6 +879,22 @@ std::string ScintillaCall::UndoActionText(int action) {
 	return CallReturnString(Message::GetUndoActionText, action);
 }
 
+void ScintillaCall::SetUndoMemoryLimit(Position bytes) {
+	Call(Message::SetUndoMemoryLimit, bytes);
+}
+
+Position ScintillaCall::UndoMemoryLimit() {
+	return Call(Message::GetUndoMemoryLimit);
+}
+
+Position ScintillaCall::UndoMemory() {
+	return Call(Message::GetUndoMemory);
+}
+
+bool ScintillaCall::UndoSpillFailed() {
+	return Call(Message::GetUndoSpillFailed);
+}
+
 void ScintillaCall::IndicSetStyle(int indicator, Scintilla::IndicatorStyle indicatorStyle) {
 	Call(Message::IndicSetStyle, indicator, static_cast<intptr_t>(indicatorStyle));
 }
@@ -1251,6 +1275,18 @@ Position ScintillaCall::FindTextFull(Scintilla::FindOption searchFlags, TextToFi
 	return CallPointer(Message::FindTextFull, static_cast<uintptr_t>(searchFlags), ft);
 }
 
+Position ScintillaCall::FindAll(Scintilla::FindOption searchFlags, TextToFindAll *fa) {
+	return CallPointer(Message::FindAll, static_cast<uintptr_t>(searchFlags), fa);
+}
+
+void ScintillaCall::SetSearchThreads(int threads) {
+	Call(Message::SetSearchThreads, threads);
+}
+
+int ScintillaCall::SearchThreads() {
+	return static_cast<int>(Call(Message::GetSearchThreads));
+}
+
 Position ScintillaCall::FormatRange(bool draw, void *fr) {
 	return CallPointer(Message::FormatRange, draw, fr);
 }
@@ -1547,6 +1583,10 @@ void ScintillaCall::SetSearchFlags(Scintilla::FindOption searchFlags) {
 	Call(Message::SetSearchFlags, static_cast<uintptr_t>(searchFlags));
 }
 
+Position ScintillaCall::ReplaceAllInTarget(const char *text, const char *replacement) {
+	return CallString(Message::ReplaceAllInTarget, reinterpret_cast<uintptr_t>(text), replacement);
+}
+
 FindOption ScintillaCall::SearchFlags() {
 	return static_cast<Scintilla::FindOption>(Call(Message::GetSearchFlags));
 }
@@ -3251,6 +3291,10 @@ void *ScintillaCall::CreateLoader(Position bytes, Scintilla::DocumentOption docu
 	return reinterpret_cast<void *>(Call(Message::CreateLoader, bytes, static_cast<intptr_t>(documentOptions)));
 }
 
+void *ScintillaCall::CreateSearchLoader(Position bytes) {
+	return reinterpret_cast<void *>(Call(Message::CreateSearchLoader, bytes));
+}
+
 void ScintillaCall::FindIndicatorShow(Position start, Position end) {
 	Call(Message::FindIndicatorShow, start, end);
 }
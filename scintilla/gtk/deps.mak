@@ -139,6 +139,7 @@ CellBuffer.o: \
 	../src/Position.h \
 	../src/SplitVector.h \
 	../src/Partitioning.h \
+	../src/PartitionTree.h \
 	../src/RunStyles.h \
 	../src/SparseVector.h \
 	../src/ChangeHistory.h \
@@ -165,6 +166,9 @@ CharClassify.o: \
 	../src/CharClassify.cxx \
 	../src/CharacterType.h \
 	../src/CharClassify.h
+Compression.o: \
+	../src/Compression.cxx \
+	../src/Compression.h
 ContractionState.o: \
 	../src/ContractionState.cxx \
 	../src/Debugging.h \
@@ -430,6 +434,7 @@ RunStyles.o: \
 	../src/Position.h \
 	../src/SplitVector.h \
 	../src/Partitioning.h \
+	../src/PartitionTree.h \
 	../src/RunStyles.h
 ScintillaBase.o: \
 	../src/ScintillaBase.cxx \
@@ -491,7 +496,8 @@ UndoHistory.o: \
 	../src/SparseVector.h \
 	../src/ChangeHistory.h \
 	../src/CellBuffer.h \
-	../src/UndoHistory.h
+	../src/UndoHistory.h \
+	../src/Compression.h
 UniConversion.o: \
 	../src/UniConversion.cxx \
 	../src/UniConversion.h
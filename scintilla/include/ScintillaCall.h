@@ -18,6 +18,7 @@ enum class Message;	// Declare in case ScintillaMessages.h not included
 // Declare in case ScintillaStructures.h not included
 struct TextRangeFull;
 struct TextToFindFull;
+struct TextToFindAll;
 struct RangeToFormatFull;
 
 class IDocumentEditable;
@@ -176,6 +177,8 @@ public:
 	Colour MarginBackN(int margin);
 	void SetMargins(int margins);
 	int Margins();
+	void SetLineNumberOffset(Line offset);
+	Line LineNumberOffset();
 	void StyleClearAll();
 	void StyleSetFore(int style, Colour fore);
 	void StyleSetBack(int style, Colour back);
@@ -263,6 +266,10 @@ public:
 	Position UndoActionPosition(int action);
 	int UndoActionText(int action, char *text);
 	std::string UndoActionText(int action);
+	void SetUndoMemoryLimit(Position bytes);
+	Position UndoMemoryLimit();
+	Position UndoMemory();
+	bool UndoSpillFailed();
 	void IndicSetStyle(int indicator, Scintilla::IndicatorStyle indicatorStyle);
 	Scintilla::IndicatorStyle IndicGetStyle(int indicator);
 	void IndicSetFore(int indicator, Colour fore);
@@ -358,6 +365,9 @@ public:
 	Scintilla::PrintOption PrintColourMode();
 	Position FindText(Scintilla::FindOption searchFlags, void *ft);
 	Position FindTextFull(Scintilla::FindOption searchFlags, TextToFindFull *ft);
+	Position FindAll(Scintilla::FindOption searchFlags, TextToFindAll *fa);
+	void SetSearchThreads(int threads);
+	int SearchThreads();
 	Position FormatRange(bool draw, void *fr);
 	Position FormatRangeFull(bool draw, RangeToFormatFull *fr);
 	void SetChangeHistory(Scintilla::ChangeHistoryOption changeHistory);
@@ -432,6 +442,7 @@ public:
 	Position ReplaceTargetMinimal(Position length, const char *text);
 	Position SearchInTarget(Position length, const char *text);
 	void SetSearchFlags(Scintilla::FindOption searchFlags);
+	Position ReplaceAllInTarget(const char *text, const char *replacement);
 	Scintilla::FindOption SearchFlags();
 	void CallTipShow(Position pos, const char *definition);
 	void CallTipCancel();
@@ -858,6 +869,7 @@ public:
 	void SetTechnology(Scintilla::Technology technology);
 	Scintilla::Technology Technology();
 	void *CreateLoader(Position bytes, Scintilla::DocumentOption documentOptions);
+	void *CreateSearchLoader(Position bytes);
 	void FindIndicatorShow(Position start, Position end);
 	void FindIndicatorFlash(Position start, Position end);
 	void FindIndicatorHide();
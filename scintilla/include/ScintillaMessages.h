@@ -105,6 +105,8 @@ enum class Message {
 	GetMarginBackN = 2251,
 	SetMargins = 2252,
 	GetMargins = 2253,
+	SetLineNumberOffset = 2825,
+	GetLineNumberOffset = 2826,
 	StyleClearAll = 2050,
 	StyleSetFore = 2051,
 	StyleSetBack = 2052,
@@ -188,6 +190,10 @@ enum class Message {
 	GetUndoActionType = 2802,
 	GetUndoActionPosition = 2803,
 	GetUndoActionText = 2804,
+	SetUndoMemoryLimit = 2822,
+	GetUndoMemoryLimit = 2823,
+	GetUndoMemory = 2824,
+	GetUndoSpillFailed = 2828,
 	IndicSetStyle = 2080,
 	IndicGetStyle = 2081,
 	IndicSetFore = 2082,
@@ -283,6 +289,9 @@ enum class Message {
 	GetPrintColourMode = 2149,
 	FindText = 2150,
 	FindTextFull = 2196,
+	FindAll = 2818,
+	SetSearchThreads = 2820,
+	GetSearchThreads = 2821,
 	FormatRange = 2151,
 	FormatRangeFull = 2777,
 	SetChangeHistory = 2780,
@@ -352,6 +361,7 @@ enum class Message {
 	ReplaceTargetMinimal = 2779,
 	SearchInTarget = 2197,
 	SetSearchFlags = 2198,
+	ReplaceAllInTarget = 2819,
 	GetSearchFlags = 2199,
 	CallTipShow = 2200,
 	CallTipCancel = 2201,
@@ -766,6 +776,7 @@ enum class Message {
 	SetTechnology = 2630,
 	GetTechnology = 2631,
 	CreateLoader = 2632,
+	CreateSearchLoader = 2827,
 	FindIndicatorShow = 2640,
 	FindIndicatorFlash = 2641,
 	FindIndicatorHide = 2642,
@@ -44,6 +44,7 @@ SOURCES += \
     ../../src/Document.cxx \
     ../../src/Decoration.cxx \
     ../../src/DBCS.cxx \
+    ../../src/Compression.cxx \
     ../../src/ContractionState.cxx \
     ../../src/CharClassify.cxx \
     ../../src/CharacterType.cxx \
@@ -42,6 +42,7 @@ SOURCES += \
     ../../src/Document.cxx \
     ../../src/Decoration.cxx \
     ../../src/DBCS.cxx \
+    ../../src/Compression.cxx \
     ../../src/ContractionState.cxx \
     ../../src/CharClassify.cxx \
     ../../src/CharacterType.cxx \
@@ -71,6 +72,7 @@ HEADERS  += \
     ../../src/Platform.h \
     ../../src/PerLine.h \
     ../../src/Partitioning.h \
+    ../../src/PartitionTree.h \
     ../../src/LineMarker.h \
     ../../src/KeyMap.h \
     ../../src/Indicator.h \
@@ -78,6 +80,7 @@ HEADERS  += \
     ../../src/Editor.h \
     ../../src/Document.h \
     ../../src/Decoration.h \
+    ../../src/Compression.h \
     ../../src/ContractionState.h \
     ../../src/CharClassify.h \
     ../../src/CharacterType.h \
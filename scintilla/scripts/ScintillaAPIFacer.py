@@ -16,6 +16,7 @@ typeAliases = {
 	# Convert iface types to C++ types
 	# bool and void are OK as is
 	"cells": "const char *",
+	"findall": "TextToFindAll *",
 	"colour": "Colour",
 	"colouralpha": "ColourAlpha",
 	"findtext": "void *",
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <memory>
 #include <type_traits>
+#include <atomic>
 
 #include "ScintillaTypes.h"
 
@@ -30,10 +31,12 @@
 #include "Position.h"
 #include "SplitVector.h"
 #include "Partitioning.h"
+#include "PartitionTree.h"
 #include "RunStyles.h"
 #include "SparseVector.h"
 #include "ChangeHistory.h"
 #include "CellBuffer.h"
+#include "PieceTable.h"
 #include "UndoHistory.h"
 #include "UniConversion.h"
 
@@ -91,12 +94,23 @@ public:
 	virtual ~ILineVector() {}
 };
 
+class IStyleRuns {
+public:
+	virtual Sci::Position Length() const noexcept = 0;
+	virtual char ValueAt(Sci::Position position) const noexcept = 0;
+	virtual void GetRange(char *buffer, Sci::Position position, Sci::Position retrieveLength) const = 0;
+	virtual FillResult<Sci::Position> FillRange(Sci::Position position, char value, Sci::Position fillLength) = 0;
+	virtual void InsertSpace(Sci::Position position, Sci::Position insertLength) = 0;
+	virtual void DeleteRange(Sci::Position position, Sci::Position deleteLength) = 0;
+	virtual ~IStyleRuns() {}
+};
+
 }
 
 using namespace Scintilla;
 using namespace Scintilla::Internal;
 
-template <typename POS>
+template <typename POS, typename PARTITIONING=Partitioning<POS>>
 class LineStartIndex {
 	// line_cast(): cast Sci::Line to either 32-bit or 64-bit value
 	// This avoids warnings from Visual C++ Code Analysis and shortens code
@@ -105,7 +119,7 @@ class LineStartIndex {
 	}
 public:
 	int refCount;
-	Partitioning<POS> starts;
+	PARTITIONING starts;
 
 	LineStartIndex() : refCount(0), starts(4) {
 		// Minimal initial allocation
@@ -154,12 +168,14 @@ public:
 	}
 };
 
-template <typename POS>
+// Line starts are a Partitioning or, when edits are expected to be scattered over a
+// large document, a PartitionTree.
+template <typename POS, typename PARTITIONING=Partitioning<POS>>
 class LineVector : public ILineVector {
-	Partitioning<POS> starts;
+	PARTITIONING starts;
 	PerLine *perLine;
-	LineStartIndex<POS> startsUTF16;
-	LineStartIndex<POS> startsUTF32;
+	LineStartIndex<POS, PARTITIONING> startsUTF16;
+	LineStartIndex<POS, PARTITIONING> startsUTF32;
 	LineCharacterIndexType activeIndices;
 
 	void SetActiveIndices() noexcept {
@@ -332,17 +348,254 @@ public:
 	}
 };
 
-CellBuffer::CellBuffer(bool hasStyles_, bool largeDocument_) :
-	hasStyles(hasStyles_), largeDocument(largeDocument_) {
+template <typename POS, typename PARTITIONING=Partitioning<POS>>
+class StyleRuns : public IStyleRuns {
+	RunStyles<POS, char, PARTITIONING> runs;
+	// Styles are read in order while lexing and drawing so the last run read is kept to
+	// find the next one without a search. Layout reads styles from several threads so each
+	// thread has its own cursor, discarded when it was for other runs or before a change.
+	// Versions are unique over all StyleRuns so a reused address can't match a stale cursor.
+	struct ReadCursor {
+		uint64_t version = 0;
+		RunCursor<POS> run;
+	};
+	static inline std::atomic<uint64_t> versions = 0;
+	static thread_local ReadCursor readCursor;
+	uint64_t version = ++versions;
+	// pos_cast(): cast Sci::Position to either 32-bit or 64-bit value
+	static constexpr POS pos_cast(Sci::Position pos) noexcept {
+		return static_cast<POS>(pos);
+	}
+	RunCursor<POS> &Cursor() const noexcept {
+		if (readCursor.version != version) {
+			readCursor = { version, {} };
+		}
+		return readCursor.run;
+	}
+	void Changed() noexcept {
+		version = ++versions;
+	}
+public:
+	Sci::Position Length() const noexcept override {
+		return runs.Length();
+	}
+	char ValueAt(Sci::Position position) const noexcept override {
+		if ((position < 0) || (position >= runs.Length()))
+			return '\0';
+		return runs.ValueAt(pos_cast(position), Cursor());
+	}
+	void GetRange(char *buffer, Sci::Position position, Sci::Position retrieveLength) const override {
+		runs.GetRange(buffer, pos_cast(position), pos_cast(retrieveLength), Cursor());
+	}
+	FillResult<Sci::Position> FillRange(Sci::Position position, char value, Sci::Position fillLength) override {
+		RunCursor<POS> &cursor = Cursor();
+		if ((cursor.run >= 0) && (position >= cursor.start) && (position + fillLength <= cursor.end) &&
+			(runs.ValueAt(pos_cast(position), cursor) == value)) {
+			// Restyling text with the style it already has
+			return { false, position, fillLength };
+		}
+		const FillResult<POS> fr = runs.FillRange(pos_cast(position), value, pos_cast(fillLength));
+		if (fr.changed)
+			Changed();
+		return { fr.changed, fr.position, fr.fillLength };
+	}
+	void InsertSpace(Sci::Position position, Sci::Position insertLength) override {
+		Changed();
+		runs.InsertSpace(pos_cast(position), pos_cast(insertLength));
+	}
+	void DeleteRange(Sci::Position position, Sci::Position deleteLength) override {
+		Changed();
+		runs.DeleteRange(pos_cast(position), pos_cast(deleteLength));
+	}
+};
+
+template <typename POS, typename PARTITIONING>
+thread_local typename StyleRuns<POS, PARTITIONING>::ReadCursor StyleRuns<POS, PARTITIONING>::readCursor;
+
+TextStore::TextStore(bool pieceTable) {
+	if (pieceTable)
+		pieces = std::make_unique<PieceTable>();
+}
+
+TextStore::~TextStore() noexcept = default;
+
+char TextStore::ValueAt(ptrdiff_t position) const noexcept {
+	if (pieces)
+		return pieces->ValueAt(position);
+	return gap.ValueAt(position);
+}
+
+ptrdiff_t TextStore::Length() const noexcept {
+	if (pieces)
+		return pieces->Length();
+	return gap.Length();
+}
+
+ptrdiff_t TextStore::Capacity() const noexcept {
+	if (pieces)
+		return pieces->Capacity();
+	return gap.Capacity();
+}
+
+void TextStore::GetRange(char *buffer, ptrdiff_t position, ptrdiff_t retrieveLength) const {
+	if (pieces)
+		pieces->GetRange(buffer, position, retrieveLength);
+	else
+		gap.GetRange(buffer, position, retrieveLength);
+}
+
+void TextStore::ReAllocate(ptrdiff_t newSize) {
+	if (pieces)
+		pieces->ReAllocate(newSize);
+	else
+		gap.ReAllocate(newSize);
+}
+
+void TextStore::InsertFromArray(ptrdiff_t position, const char *s, ptrdiff_t positionFrom, ptrdiff_t insertLength) {
+	if (pieces)
+		pieces->InsertFromArray(position, s, positionFrom, insertLength);
+	else
+		gap.InsertFromArray(position, s, positionFrom, insertLength);
+}
+
+void TextStore::DeleteRange(ptrdiff_t position, ptrdiff_t deleteLength) {
+	if (pieces)
+		pieces->DeleteRange(position, deleteLength);
+	else
+		gap.DeleteRange(position, deleteLength);
+}
+
+const char *TextStore::BufferPointer() {
+	if (pieces)
+		return pieces->BufferPointer();
+	return gap.BufferPointer();
+}
+
+const char *TextStore::RangePointer(ptrdiff_t position, ptrdiff_t rangeLength) {
+	if (pieces)
+		return pieces->RangePointer(position, rangeLength);
+	return gap.RangePointer(position, rangeLength);
+}
+
+// Text about to be deleted. A piece table copies a range spanning pieces into scratch rather
+// than joining it into a new piece that would only be dropped.
+const char *TextStore::RangeText(ptrdiff_t position, ptrdiff_t rangeLength, std::vector<char> &scratch) {
+	if (pieces) {
+		const ptrdiff_t piece = pieces->PieceFromPosition(position);
+		if ((position + rangeLength) > pieces->PieceStart(piece + 1)) {
+			scratch.resize(rangeLength);
+			pieces->GetRange(scratch.data(), position, rangeLength);
+			return scratch.data();
+		}
+	}
+	return RangePointer(position, rangeLength);
+}
+
+// Text before the gap, or in the first piece, is contiguous.
+ptrdiff_t TextStore::GapPosition() const noexcept {
+	if (pieces)
+		return (pieces->Pieces() > 1) ? pieces->PieceStart(1) : pieces->Length();
+	return gap.GapPosition();
+}
+
+// A piece table of more than two pieces is joined into one block first. That leaves the
+// text as it was so the view is const but it must not happen while other threads read.
+// Searches use the view of just the range they read instead.
+SplitView TextStore::View() const {
+	const char *segment1 = nullptr;
+	const char *segment2 = nullptr;
+	const size_t length = Length();
+	size_t length1 = 0;
+	if (pieces) {
+		if (pieces->Pieces() > 2)
+			pieces->BufferPointer();
+		segment1 = pieces->PieceText(0);
+		length1 = (pieces->Pieces() > 1) ? pieces->PieceStart(1) : length;
+		segment2 = (pieces->Pieces() > 1) ? pieces->PieceText(1) - length1 : segment1;
+	} else {
+		length1 = gap.GapPosition();
+		if (length1 == 0) {
+			// Assign segment2 to segment1 / length1 to avoid useless test against 0 length1
+			length1 = length;
+		}
+		segment1 = gap.ElementPointer(0);
+		segment2 = gap.ElementPointer(length1) - length1;
+	}
+	return SplitView {
+		segment1,
+		length1,
+		segment2,
+		length
+	};
+}
+
+// A view that can read [start, end). A gap buffer gives the whole text. A piece table joins
+// the pieces over the range when it spans more than two, so the copy is only as long as the
+// range. Once a range is in one piece, views inside it change nothing so threads can share them.
+SplitView TextStore::View(ptrdiff_t start, ptrdiff_t end) const {
+	if (!pieces)
+		return View();
+	const ptrdiff_t length = Length();
+	start = std::clamp<ptrdiff_t>(start, 0, length);
+	end = std::clamp<ptrdiff_t>(end, start, length);
+	const char *segment1 = nullptr;
+	const char *segment2 = nullptr;
+	ptrdiff_t length1 = end;
+	const ptrdiff_t piece = pieces->PieceFromPosition(start);
+	const ptrdiff_t pieceStart = pieces->PieceStart(piece);
+	const ptrdiff_t pieceEnd = pieces->PieceStart(piece + 1);
+	if (end <= pieceEnd) {
+		segment1 = pieces->PieceText(piece) - pieceStart;
+		segment2 = segment1;
+	} else if ((piece + 1 < pieces->Pieces()) && (end <= pieces->PieceStart(piece + 2))) {
+		segment1 = pieces->PieceText(piece) - pieceStart;
+		length1 = pieceEnd;
+		segment2 = pieces->PieceText(piece + 1) - pieceEnd;
+	} else {
+		segment1 = pieces->RangePointer(start, end - start) - start;
+		segment2 = segment1;
+	}
+	return SplitView {
+		segment1,
+		static_cast<size_t>(length1),
+		segment2,
+		static_cast<size_t>(length),
+		static_cast<size_t>(start),
+		static_cast<size_t>(end)
+	};
+}
+
+CellBuffer::CellBuffer(bool hasStyles_, bool largeDocument_, bool pieceTable_, bool styleRuns_, bool indexTree_) :
+	hasStyles(hasStyles_), largeDocument(largeDocument_), indexTree(indexTree_), substance(pieceTable_) {
 	readOnly = false;
 	utf8Substance = false;
 	utf8LineEnds = LineEndType::Default;
 	collectingUndo = true;
 	uh = std::make_unique<UndoHistory>();
-	if (largeDocument)
-		plv = std::make_unique<LineVector<Sci::Position>>();
-	else
-		plv = std::make_unique<LineVector<int>>();
+	if (indexTree_) {
+		if (largeDocument)
+			plv = std::make_unique<LineVector<Sci::Position, PartitionTree<Sci::Position>>>();
+		else
+			plv = std::make_unique<LineVector<int, PartitionTree<int>>>();
+	} else {
+		if (largeDocument)
+			plv = std::make_unique<LineVector<Sci::Position>>();
+		else
+			plv = std::make_unique<LineVector<int>>();
+	}
+	if (hasStyles && styleRuns_) {
+		if (largeDocument) {
+			if (indexTree_)
+				styleRuns = std::make_unique<StyleRuns<Sci::Position, PartitionTree<Sci::Position>>>();
+			else
+				styleRuns = std::make_unique<StyleRuns<Sci::Position>>();
+		} else {
+			if (indexTree_)
+				styleRuns = std::make_unique<StyleRuns<int, PartitionTree<int>>>();
+			else
+				styleRuns = std::make_unique<StyleRuns<int>>();
+		}
+	}
 }
 
 CellBuffer::~CellBuffer() noexcept = default;
@@ -371,6 +624,8 @@ void CellBuffer::GetCharRange(char *buffer, Sci::Position position, Sci::Positio
 }
 
 char CellBuffer::StyleAt(Sci::Position position) const noexcept {
+	if (styleRuns)
+		return styleRuns->ValueAt(position);
 	return hasStyles ? style.ValueAt(position) : '\0';
 }
 
@@ -383,11 +638,16 @@ void CellBuffer::GetStyleRange(unsigned char *buffer, Sci::Position position, Sc
 		std::fill(buffer, buffer + lengthRetrieve, static_cast<unsigned char>(0));
 		return;
 	}
-	if ((position + lengthRetrieve) > style.Length()) {
+	const Sci::Position lengthStyles = styleRuns ? styleRuns->Length() : style.Length();
+	if ((position + lengthRetrieve) > lengthStyles) {
 		Platform::DebugPrintf("Bad GetStyleRange %.0f for %.0f of %.0f\n",
 				      static_cast<double>(position),
 				      static_cast<double>(lengthRetrieve),
-				      static_cast<double>(style.Length()));
+				      static_cast<double>(lengthStyles));
+		return;
+	}
+	if (styleRuns) {
+		styleRuns->GetRange(reinterpret_cast<char *>(buffer), position, lengthRetrieve);
 		return;
 	}
 	style.GetRange(reinterpret_cast<char *>(buffer), position, lengthRetrieve);
@@ -397,7 +657,7 @@ const char *CellBuffer::BufferPointer() {
 	return substance.BufferPointer();
 }
 
-const char *CellBuffer::RangePointer(Sci::Position position, Sci::Position rangeLength) noexcept {
+const char *CellBuffer::RangePointer(Sci::Position position, Sci::Position rangeLength) {
 	return substance.RangePointer(position, rangeLength);
 }
 
@@ -405,19 +665,12 @@ Sci::Position CellBuffer::GapPosition() const noexcept {
 	return substance.GapPosition();
 }
 
-SplitView CellBuffer::AllView() const noexcept {
-	const size_t length = substance.Length();
-	size_t length1 = substance.GapPosition();
-	if (length1 == 0) {
-		// Assign segment2 to segment1 / length1 to avoid useless test against 0 length1
-		length1 = length;
-	}
-	return SplitView {
-		substance.ElementPointer(0),
-		length1,
-		substance.ElementPointer(length1) - length1,
-		length
-	};
+SplitView CellBuffer::AllView() const {
+	return substance.View();
+}
+
+SplitView CellBuffer::RangeView(Sci::Position start, Sci::Position end) const {
+	return substance.View(start, end);
 }
 
 // The char* returned is to an allocation owned by the undo history
@@ -439,10 +692,60 @@ const char *CellBuffer::InsertString(Sci::Position position, const char *s, Sci:
 	return data;
 }
 
-bool CellBuffer::SetStyleAt(Sci::Position position, char styleValue) noexcept {
+// Append text whose line starts have already been found by TextScanner so it is not scanned again.
+// lineStarts are offsets into s. Only for loading: returns false without changing anything when
+// undo, change history, a line character index or Unicode line ends need the full insertion.
+bool CellBuffer::AppendScannedText(const char *s, Sci::Position insertLength, const Sci::Position *lineStarts, Sci::Line lineCount) {
+	if (readOnly || collectingUndo || changeHistory || MaintainingLineCharacterIndex() ||
+		(utf8LineEnds == LineEndType::Unicode)) {
+		return false;
+	}
+	if (insertLength <= 0) {
+		return true;
+	}
+	const Sci::Position position = substance.Length();
+	const Sci::Line lineLast = plv->Lines() - 1;
+	if ((lineCount > 0) && (lineLast == 0) && (position == 0)) {
+		// First text of a load: size the line vector from the line density of this block
+		// and the space allocated for the whole document.
+		const Sci::Position expected = std::max<Sci::Position>(substance.Capacity(), insertLength);
+		const Sci::Line estimate = static_cast<Sci::Line>(
+			static_cast<double>(lineCount) * static_cast<double>(expected) / static_cast<double>(insertLength));
+		plv->AllocateLines(estimate + estimate / 8 + 1);
+	}
+
+	const unsigned char chPrev = substance.ValueAt(position - 1);
+	substance.InsertFromArray(position, s, 0, insertLength);
+	InsertStyles(position, insertLength);
+
+	const bool atLineStart = plv->LineStart(lineLast) == position;
+	plv->InsertText(lineLast, insertLength);
+	if ((chPrev == '\r') && (s[0] == '\n')) {
+		// Patch up what was end of line
+		plv->SetLineStart(lineLast, position + 1);
+	}
+
+	constexpr Sci::Line PositionBlockSize = 128;
+	Sci::Position positions[PositionBlockSize]{};
+	Sci::Line lineInsert = lineLast + 1;
+	for (Sci::Line block = 0; block < lineCount; block += PositionBlockSize) {
+		const Sci::Line nPositions = std::min(lineCount - block, PositionBlockSize);
+		for (Sci::Line i = 0; i < nPositions; i++) {
+			positions[i] = position + lineStarts[block + i];
+		}
+		plv->InsertLines(lineInsert, positions, nPositions, atLineStart);
+		lineInsert += nPositions;
+	}
+	return true;
+}
+
+bool CellBuffer::SetStyleAt(Sci::Position position, char styleValue) {
 	if (!hasStyles) {
 		return false;
 	}
+	if (styleRuns) {
+		return styleRuns->FillRange(position, styleValue, 1).changed;
+	}
 	const char curVal = style.ValueAt(position);
 	if (curVal != styleValue) {
 		style.SetValueAt(position, styleValue);
@@ -452,10 +755,13 @@ bool CellBuffer::SetStyleAt(Sci::Position position, char styleValue) noexcept {
 	}
 }
 
-bool CellBuffer::SetStyleFor(Sci::Position position, Sci::Position lengthStyle, char styleValue) noexcept {
+bool CellBuffer::SetStyleFor(Sci::Position position, Sci::Position lengthStyle, char styleValue) {
 	if (!hasStyles) {
 		return false;
 	}
+	if (styleRuns) {
+		return styleRuns->FillRange(position, styleValue, lengthStyle).changed;
+	}
 	bool changed = false;
 	PLATFORM_ASSERT(lengthStyle == 0 ||
 		(lengthStyle > 0 && lengthStyle + position <= style.Length()));
@@ -470,6 +776,45 @@ bool CellBuffer::SetStyleFor(Sci::Position position, Sci::Position lengthStyle,
 	return changed;
 }
 
+bool CellBuffer::SetStyles(Sci::Position position, const char *styles, Sci::Position lengthStyle,
+	Sci::Position &startChanged, Sci::Position &endChanged) {
+	if (!hasStyles) {
+		return false;
+	}
+	bool changed = false;
+	if (styleRuns) {
+		// Lexers write long stretches of one style so each stretch is one fill
+		Sci::Position i = 0;
+		while (i < lengthStyle) {
+			const char styleValue = styles[i];
+			Sci::Position iEnd = i + 1;
+			while ((iEnd < lengthStyle) && (styles[iEnd] == styleValue)) {
+				iEnd++;
+			}
+			const FillResult<Sci::Position> fr = styleRuns->FillRange(position + i, styleValue, iEnd - i);
+			if (fr.changed) {
+				if (!changed) {
+					startChanged = fr.position;
+				}
+				changed = true;
+				endChanged = fr.position + fr.fillLength - 1;
+			}
+			i = iEnd;
+		}
+		return changed;
+	}
+	for (Sci::Position i = 0; i < lengthStyle; i++) {
+		if (SetStyleAt(position + i, styles[i])) {
+			if (!changed) {
+				startChanged = position + i;
+			}
+			changed = true;
+			endChanged = position + i;
+		}
+	}
+	return changed;
+}
+
 // The char* returned is to an allocation owned by the undo history
 const char *CellBuffer::DeleteChars(Sci::Position position, Sci::Position deleteLength, bool &startSequence) {
 	// InsertString and DeleteChars are the bottleneck though which all changes occur
@@ -479,7 +824,8 @@ const char *CellBuffer::DeleteChars(Sci::Position position, Sci::Position delete
 		if (collectingUndo) {
 			// Save into the undo/redo stack, but only the characters - not the formatting
 			// The gap would be moved to position anyway for the deletion so this doesn't cost extra
-			data = substance.RangePointer(position, deleteLength);
+			std::vector<char> scratch;
+			data = substance.RangeText(position, deleteLength, scratch);
 			data = uh->AppendAction(ActionType::remove, position, data, deleteLength, startSequence);
 		}
 
@@ -502,7 +848,7 @@ void CellBuffer::Allocate(Sci::Position newSize) {
 		throw std::runtime_error("CellBuffer::Allocate: size of standard document limited to 2G.");
 	}
 	substance.ReAllocate(newSize);
-	if (hasStyles) {
+	if (hasStyles && !styleRuns) {
 		style.ReAllocate(newSize);
 	}
 }
@@ -631,6 +977,18 @@ bool CellBuffer::HasStyles() const noexcept {
 	return hasStyles;
 }
 
+bool CellBuffer::IsPieceTable() const noexcept {
+	return substance.IsPieceTable();
+}
+
+bool CellBuffer::HasStyleRuns() const noexcept {
+	return styleRuns != nullptr;
+}
+
+bool CellBuffer::HasIndexTree() const noexcept {
+	return indexTree;
+}
+
 void CellBuffer::SetSavePoint() {
 	uh->SetSavePoint();
 	if (changeHistory) {
@@ -810,9 +1168,7 @@ void CellBuffer::BasicInsertString(Sci::Position position, const char *s, Sci::P
 	}
 
 	substance.InsertFromArray(position, s, 0, insertLength);
-	if (hasStyles) {
-		style.InsertValue(position, insertLength, 0);
-	}
+	InsertStyles(position, insertLength);
 
 	const bool atLineStart = plv->LineStart(lineInsert-1) == position;
 	// Point all the lines after the insertion point further along in the buffer
@@ -1011,10 +1367,15 @@ void CellBuffer::BasicDeleteChars(Sci::Position position, Sci::Position deleteLe
 			}
 		}
 
+		// The gap is moved to position for the deletion anyway so read the deleted text in place
+		std::vector<char> scratch;
+		const char *deleted = substance.RangeText(position, deleteLength, scratch);
 		unsigned char ch = chNext;
 		for (Sci::Position i = 0; i < deleteLength; i++) {
-			chNext = substance.ValueAt(position + i + 1);
-			if (ch == '\r') {
+			chNext = (i + 1 < deleteLength) ? deleted[i + 1] : substance.ValueAt(position + i + 1);
+			if ((ch > '\r') && (utf8LineEnds != LineEndType::Unicode)) {
+				// Most common case: not a line end
+			} else if (ch == '\r') {
 				if (chNext != '\n') {
 					RemoveLine(lineRemove);
 				}
@@ -1049,11 +1410,23 @@ void CellBuffer::BasicDeleteChars(Sci::Position position, Sci::Position deleteLe
 	if (lineRecalculateStart >= 0) {
 		RecalculateIndexLineStarts(lineRecalculateStart, lineRecalculateStart);
 	}
-	if (hasStyles) {
+	if (styleRuns) {
+		styleRuns->DeleteRange(position, deleteLength);
+	} else if (hasStyles) {
 		style.DeleteRange(position, deleteLength);
 	}
 }
 
+// Inserted text has style 0 until it is styled
+void CellBuffer::InsertStyles(Sci::Position position, Sci::Position insertLength) {
+	if (styleRuns) {
+		styleRuns->InsertSpace(position, insertLength);
+		styleRuns->FillRange(position, 0, insertLength);
+	} else if (hasStyles) {
+		style.InsertValue(position, insertLength, 0);
+	}
+}
+
 bool CellBuffer::SetUndoCollection(bool collectUndo) noexcept {
 	collectingUndo = collectUndo;
 	uh->DropUndoSequence();
@@ -1097,7 +1470,7 @@ int CellBuffer::StartUndo() noexcept {
 	return uh->StartUndo();
 }
 
-Action CellBuffer::GetUndoStep() const noexcept {
+Action CellBuffer::GetUndoStep() const {
 	return uh->GetUndoStep();
 }
 
@@ -1135,7 +1508,7 @@ int CellBuffer::StartRedo() noexcept {
 	return uh->StartRedo();
 }
 
-Action CellBuffer::GetRedoStep() const noexcept {
+Action CellBuffer::GetRedoStep() const {
 	return uh->GetRedoStep();
 }
 
@@ -1275,7 +1648,7 @@ Sci::Position CellBuffer::UndoActionPosition(int action) const noexcept {
 	return uh->Position(action);
 }
 
-std::string_view CellBuffer::UndoActionText(int action) const noexcept {
+std::string_view CellBuffer::UndoActionText(int action) const {
 	return uh->Text(action);
 }
 
@@ -1287,6 +1660,22 @@ void CellBuffer::ChangeLastUndoActionText(size_t length, const char *text) {
 	uh->ChangeLastUndoActionText(length, text);
 }
 
+void CellBuffer::SetUndoMemoryLimit(size_t limit) {
+	uh->SetMemoryLimit(limit);
+}
+
+size_t CellBuffer::UndoMemoryLimit() const noexcept {
+	return uh->MemoryLimit();
+}
+
+size_t CellBuffer::UndoMemory() const noexcept {
+	return uh->MemoryUsage();
+}
+
+bool CellBuffer::UndoSpillFailed() const noexcept {
+	return uh->SpillFailed();
+}
+
 void CellBuffer::ChangeHistorySet(bool set) {
 	if (set) {
 		if (!changeHistory && !uh->CanUndo()) {
@@ -20,14 +20,29 @@ public:
 	virtual void RemoveLine(Sci::Line line)=0;
 };
 
+// Loading fast path for text whose line starts are already known, saving a scan.
+// Kept off the public ILoader so its vtable is unchanged - reach it with dynamic_cast.
+class ILoaderLines {
+public:
+	virtual ~ILoaderLines() {}
+	// lineStarts holds lineCount offsets into data of the first character after each line end.
+	virtual int AddDataLines(const char *data, Sci::Position length, const Sci::Position *lineStarts, Sci::Position lineCount) = 0;
+};
+
 class UndoHistory;
 class ChangeHistory;
+class PieceTable;
 
 /**
  * The line vector contains information about each of the lines in a cell buffer.
  */
 class ILineVector;
 
+/**
+ * Styles stored as runs of the same style.
+ */
+class IStyleRuns;
+
 enum class ActionType : unsigned char { insert, remove, container };
 
 /**
@@ -41,31 +56,74 @@ struct Action {
 	Sci::Position lenData = 0;
 };
 
+/**
+ * The text as two segments, the second indexed by document position like the first.
+ * A view of part of the text can only read [readStart, readEnd); other positions read as 0
+ * while length stays the length of the whole text.
+ */
 struct SplitView {
 	const char *segment1 = nullptr;
 	size_t length1 = 0;
 	const char *segment2 = nullptr;
 	size_t length = 0;
+	size_t readStart = 0;
+	size_t readEnd = static_cast<size_t>(-1);
 
 	bool operator==(const SplitView &other) const noexcept {
 		return segment1 == other.segment1 && length1 == other.length1 &&
-			segment2 == other.segment2 && length == other.length;
+			segment2 == other.segment2 && length == other.length &&
+			readStart == other.readStart && readEnd == other.readEnd;
 	}
 	bool operator!=(const SplitView &other) const noexcept {
 		return !(*this == other);
 	}
 
+	size_t ReadEnd() const noexcept {
+		return (readEnd < length) ? readEnd : length;
+	}
+
 	char CharAt(size_t position) const noexcept {
 		if (position < length1) {
-			return segment1[position];
+			return (position >= readStart) ? segment1[position] : 0;
 		}
-		if (position < length) {
+		if ((position < length) && (position < readEnd)) {
 			return segment2[position];
 		}
 		return 0;
 	}
 };
 
+/**
+ * The characters of a cell buffer, held in a gap buffer or, when chosen as the buffer
+ * is created, a piece table where edits far apart do not move the text between them.
+ */
+class TextStore {
+	SplitVector<char> gap;
+	std::unique_ptr<PieceTable> pieces;
+public:
+	explicit TextStore(bool pieceTable);
+	// Deleted so TextStore objects can not be copied.
+	TextStore(const TextStore &) = delete;
+	TextStore(TextStore &&) = delete;
+	TextStore &operator=(const TextStore &) = delete;
+	TextStore &operator=(TextStore &&) = delete;
+	~TextStore() noexcept;
+
+	bool IsPieceTable() const noexcept { return pieces != nullptr; }
+	char ValueAt(ptrdiff_t position) const noexcept;
+	ptrdiff_t Length() const noexcept;
+	ptrdiff_t Capacity() const noexcept;
+	void GetRange(char *buffer, ptrdiff_t position, ptrdiff_t retrieveLength) const;
+	void ReAllocate(ptrdiff_t newSize);
+	void InsertFromArray(ptrdiff_t position, const char *s, ptrdiff_t positionFrom, ptrdiff_t insertLength);
+	void DeleteRange(ptrdiff_t position, ptrdiff_t deleteLength);
+	const char *BufferPointer();
+	const char *RangePointer(ptrdiff_t position, ptrdiff_t rangeLength);
+	const char *RangeText(ptrdiff_t position, ptrdiff_t rangeLength, std::vector<char> &scratch);
+	ptrdiff_t GapPosition() const noexcept;
+	SplitView View() const;
+	SplitView View(ptrdiff_t start, ptrdiff_t end) const;
+};
 
 /**
  * Holder for an expandable array of characters that supports undo and line markers.
@@ -76,8 +134,10 @@ class CellBuffer {
 private:
 	bool hasStyles;
 	bool largeDocument;
-	SplitVector<char> substance;
+	bool indexTree;
+	TextStore substance;
 	SplitVector<char> style;
+	std::unique_ptr<IStyleRuns> styleRuns;
 	bool readOnly;
 	bool utf8Substance;
 	Scintilla::LineEndType utf8LineEnds;
@@ -97,10 +157,11 @@ private:
 	/// Actions without undo
 	void BasicInsertString(Sci::Position position, const char *s, Sci::Position insertLength);
 	void BasicDeleteChars(Sci::Position position, Sci::Position deleteLength);
+	void InsertStyles(Sci::Position position, Sci::Position insertLength);
 
 public:
 
-	CellBuffer(bool hasStyles_, bool largeDocument_);
+	CellBuffer(bool hasStyles_, bool largeDocument_, bool pieceTable_=false, bool styleRuns_=false, bool indexTree_=false);
 	// Deleted so CellBuffer objects can not be copied.
 	CellBuffer(const CellBuffer &) = delete;
 	CellBuffer(CellBuffer &&) = delete;
@@ -115,9 +176,10 @@ public:
 	char StyleAt(Sci::Position position) const noexcept;
 	void GetStyleRange(unsigned char *buffer, Sci::Position position, Sci::Position lengthRetrieve) const;
 	const char *BufferPointer();
-	const char *RangePointer(Sci::Position position, Sci::Position rangeLength) noexcept;
+	const char *RangePointer(Sci::Position position, Sci::Position rangeLength);
 	Sci::Position GapPosition() const noexcept;
-	SplitView AllView() const noexcept;
+	SplitView AllView() const;
+	SplitView RangeView(Sci::Position start, Sci::Position end) const;
 
 	Sci::Position Length() const noexcept;
 	void Allocate(Sci::Position newSize);
@@ -139,11 +201,16 @@ public:
 	void InsertLine(Sci::Line line, Sci::Position position, bool lineStart);
 	void RemoveLine(Sci::Line line);
 	const char *InsertString(Sci::Position position, const char *s, Sci::Position insertLength, bool &startSequence);
+	bool AppendScannedText(const char *s, Sci::Position insertLength, const Sci::Position *lineStarts, Sci::Line lineCount);
 
 	/// Setting styles for positions outside the range of the buffer is safe and has no effect.
 	/// @return true if the style of a character is changed.
-	bool SetStyleAt(Sci::Position position, char styleValue) noexcept;
-	bool SetStyleFor(Sci::Position position, Sci::Position lengthStyle, char styleValue) noexcept;
+	bool SetStyleAt(Sci::Position position, char styleValue);
+	bool SetStyleFor(Sci::Position position, Sci::Position lengthStyle, char styleValue);
+	/// Set the styles of lengthStyle positions from an array.
+	/// @return true with the first and last positions changed in startChanged and endChanged if any changed.
+	bool SetStyles(Sci::Position position, const char *styles, Sci::Position lengthStyle,
+		Sci::Position &startChanged, Sci::Position &endChanged);
 
 	const char *DeleteChars(Sci::Position position, Sci::Position deleteLength, bool &startSequence);
 
@@ -151,6 +218,9 @@ public:
 	void SetReadOnly(bool set) noexcept;
 	bool IsLarge() const noexcept;
 	bool HasStyles() const noexcept;
+	bool IsPieceTable() const noexcept;
+	bool HasStyleRuns() const noexcept;
+	bool HasIndexTree() const noexcept;
 
 	/// The save point is a marker in the undo stack where the container has stated that
 	/// the buffer was saved. Undo and redo can move over the save point.
@@ -175,11 +245,11 @@ public:
 	/// called that many times. Similarly for redo.
 	bool CanUndo() const noexcept;
 	int StartUndo() noexcept;
-	Action GetUndoStep() const noexcept;
+	Action GetUndoStep() const;
 	void PerformUndoStep();
 	bool CanRedo() const noexcept;
 	int StartRedo() noexcept;
-	Action GetRedoStep() const noexcept;
+	Action GetRedoStep() const;
 	void PerformRedoStep();
 
 	int UndoActions() const noexcept;
@@ -193,9 +263,13 @@ public:
 	int UndoCurrent() const noexcept;
 	int UndoActionType(int action) const noexcept;
 	Sci::Position UndoActionPosition(int action) const noexcept;
-	std::string_view UndoActionText(int action) const noexcept;
+	std::string_view UndoActionText(int action) const;
 	void PushUndoActionType(int type, Sci::Position position);
 	void ChangeLastUndoActionText(size_t length, const char *text);
+	void SetUndoMemoryLimit(size_t limit);
+	size_t UndoMemoryLimit() const noexcept;
+	size_t UndoMemory() const noexcept;
+	bool UndoSpillFailed() const noexcept;
 
 	void ChangeHistorySet(bool set);
 	[[nodiscard]] int EditionAt(Sci::Position pos) const noexcept;
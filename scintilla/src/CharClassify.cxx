@@ -58,3 +58,23 @@ int CharClassify::GetCharsOfClass(CharacterClass characterClass, unsigned char *
 	}
 	return count;
 }
+
+void CharClassBits::Assign(unsigned long long *bits, unsigned char ch, bool value) noexcept {
+	const unsigned long long mask = 1ULL << (ch % bitsPerWord);
+	if (value)
+		bits[ch / bitsPerWord] |= mask;
+	else
+		bits[ch / bitsPerWord] &= ~mask;
+}
+
+void CharClassBits::SetClasses(const CharClassify &charClassify) noexcept {
+	for (int ch = 0; ch < 256; ch++) {
+		const unsigned char uch = static_cast<unsigned char>(ch);
+		Assign(word, uch, charClassify.GetClass(uch) == CharacterClass::word);
+		Assign(punctuation, uch, charClassify.GetClass(uch) == CharacterClass::punctuation);
+	}
+}
+
+void CharClassBits::SetKnown(unsigned char ch, bool isKnown) noexcept {
+	Assign(known, ch, isKnown);
+}
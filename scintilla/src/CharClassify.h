@@ -27,6 +27,35 @@ private:
 	CharacterClass charClass[maxChar];
 };
 
+/**
+ * Word and punctuation bytes as 256 bit sets so the edges of whole word matches can be
+ * checked with a couple of bit tests. Only bytes marked known are complete characters
+ * wherever they appear - the others are parts of multi-byte characters and have to be
+ * decoded and classified by Document.
+ */
+class CharClassBits {
+public:
+	void SetClasses(const CharClassify &charClassify) noexcept;
+	void SetKnown(unsigned char ch, bool isKnown) noexcept;
+	bool IsKnown(unsigned char ch) const noexcept { return Test(known, ch); }
+	// Is ch a word or punctuation character with chOther of a different class
+	bool IsEdge(unsigned char ch, unsigned char chOther) const noexcept {
+		return (Test(word, ch) && !Test(word, chOther)) ||
+			(Test(punctuation, ch) && !Test(punctuation, chOther));
+	}
+
+private:
+	static constexpr int bitsPerWord = 64;
+	static constexpr int words = 256 / bitsPerWord;
+	static bool Test(const unsigned long long *bits, unsigned char ch) noexcept {
+		return (bits[ch / bitsPerWord] >> (ch % bitsPerWord)) & 1U;
+	}
+	static void Assign(unsigned long long *bits, unsigned char ch, bool value) noexcept;
+	unsigned long long word[words] {};
+	unsigned long long punctuation[words] {};
+	unsigned long long known[words] {};
+};
+
 }
 
 #endif
@@ -0,0 +1,169 @@
+// Scintilla source code edit control
+/** @file Compression.cxx
+ ** Fast compression of blocks of text held for undo.
+ **/
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+
+#include "Compression.h"
+
+using namespace Scintilla::Internal;
+
+namespace {
+
+constexpr size_t minMatch = 4;
+// The format requires the last 5 bytes to be literals and no match to start in the last 12
+constexpr size_t lastLiterals = 5;
+constexpr size_t matchFindLimit = 12;
+constexpr size_t maxOffset = 0xFFFF;
+constexpr size_t lengthInToken = 15;
+constexpr int hashBits = 12;
+// After 64 bytes without a match, look at every second position then every third and so on
+// so text that does not repeat is passed over quickly.
+constexpr int skipShift = 6;
+
+uint32_t Read32(const char *p) noexcept {
+	uint32_t value = 0;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+constexpr uint32_t Hash(uint32_t sequence) noexcept {
+	return (sequence * 2654435761U) >> (32 - hashBits);
+}
+
+// Lengths too long for the token continue in bytes of 255 ended by a smaller byte.
+void WriteLength(std::string &block, size_t length) {
+	while (length >= UINT8_MAX) {
+		block.push_back(static_cast<char>(UINT8_MAX));
+		length -= UINT8_MAX;
+	}
+	block.push_back(static_cast<char>(length));
+}
+
+void WriteLiterals(std::string &block, const char *literals, size_t literalLength, size_t matchCode) {
+	const size_t token = (std::min(literalLength, lengthInToken) << 4) | std::min(matchCode, lengthInToken);
+	block.push_back(static_cast<char>(token));
+	if (literalLength >= lengthInToken) {
+		WriteLength(block, literalLength - lengthInToken);
+	}
+	block.append(literals, literalLength);
+}
+
+void WriteSequence(std::string &block, const char *literals, size_t literalLength, size_t offset, size_t matchLength) {
+	const size_t matchCode = matchLength - minMatch;
+	WriteLiterals(block, literals, literalLength, matchCode);
+	block.push_back(static_cast<char>(offset & UINT8_MAX));
+	block.push_back(static_cast<char>(offset >> 8));
+	if (matchCode >= lengthInToken) {
+		WriteLength(block, matchCode - lengthInToken);
+	}
+}
+
+[[noreturn]] void InvalidBlock() {
+	throw std::runtime_error("DecompressBlock: invalid block.");
+}
+
+}
+
+std::string Scintilla::Internal::CompressBlock(std::string_view text) {
+	const char *const start = text.data();
+	const size_t length = text.length();
+	std::string block;
+	block.reserve(length + length / UINT8_MAX + 16);
+	size_t anchor = 0;
+	if (length > matchFindLimit) {
+		// Last position seen for each hash of 4 bytes. Entries are checked before use so
+		// the initial 0 values do no harm.
+		std::vector<uint32_t> table(size_t{1} << hashBits);
+		const size_t findEnd = length - matchFindLimit;
+		const size_t matchEnd = length - lastLiterals;
+		size_t position = 0;
+		while (position < findEnd) {
+			const uint32_t sequence = Read32(start + position);
+			const uint32_t hash = Hash(sequence);
+			const size_t candidate = table[hash];
+			table[hash] = static_cast<uint32_t>(position);
+			if ((candidate < position) && ((position - candidate) <= maxOffset) &&
+				(Read32(start + candidate) == sequence)) {
+				size_t matchLength = minMatch;
+				while (((position + matchLength) < matchEnd) &&
+					(start[candidate + matchLength] == start[position + matchLength])) {
+					matchLength++;
+				}
+				WriteSequence(block, start + anchor, position - anchor, position - candidate, matchLength);
+				position += matchLength;
+				anchor = position;
+			} else {
+				position += 1 + ((position - anchor) >> skipShift);
+			}
+		}
+	}
+	WriteLiterals(block, start + anchor, length - anchor, 0);
+	return block;
+}
+
+void Scintilla::Internal::DecompressBlock(std::string_view block, char *destination, size_t length) {
+	const unsigned char *in = reinterpret_cast<const unsigned char *>(block.data());
+	const unsigned char *const inEnd = in + block.length();
+	const auto readLength = [&in, inEnd](size_t lengthToken) {
+		if (lengthToken == lengthInToken) {
+			unsigned char more = UINT8_MAX;
+			while (more == UINT8_MAX) {
+				if (in >= inEnd) {
+					InvalidBlock();
+				}
+				more = *in++;
+				lengthToken += more;
+			}
+		}
+		return lengthToken;
+	};
+	size_t out = 0;
+	while (in < inEnd) {
+		const unsigned char token = *in++;
+		const size_t literalLength = readLength(token >> 4);
+		if ((literalLength > static_cast<size_t>(inEnd - in)) || (literalLength > (length - out))) {
+			InvalidBlock();
+		}
+		memcpy(destination + out, in, literalLength);
+		in += literalLength;
+		out += literalLength;
+		if (in == inEnd) {
+			// The last sequence has only literals
+			break;
+		}
+		if ((inEnd - in) < 2) {
+			InvalidBlock();
+		}
+		const size_t offset = in[0] | (in[1] << 8);
+		in += 2;
+		const size_t matchLength = readLength(token & lengthInToken) + minMatch;
+		if ((offset == 0) || (offset > out) || (matchLength > (length - out))) {
+			InvalidBlock();
+		}
+		char *target = destination + out;
+		const char *source = target - offset;
+		if (offset >= matchLength) {
+			memcpy(target, source, matchLength);
+		} else {
+			// Overlapping copies repeat the last offset bytes
+			for (size_t i = 0; i < matchLength; i++) {
+				target[i] = source[i];
+			}
+		}
+		out += matchLength;
+	}
+	if (out != length) {
+		InvalidBlock();
+	}
+}
@@ -0,0 +1,24 @@
+// Scintilla source code edit control
+/** @file Compression.h
+ ** Fast compression of blocks of text held for undo.
+ **/
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+namespace Scintilla::Internal {
+
+// Blocks use the LZ4 block format: runs of literals followed by copies of up to 64K back.
+// Speed matters more than ratio as blocks are compressed while typing and expanded while undoing.
+
+// Compress text into a block which may be larger than text when it does not repeat.
+std::string CompressBlock(std::string_view text);
+
+// Expand block into exactly length bytes at destination, throwing if block is not valid
+// for that length.
+void DecompressBlock(std::string_view block, char *destination, size_t length);
+
+}
+
+#endif
@@ -24,6 +24,9 @@
 #include <algorithm>
 #include <memory>
 #include <chrono>
+#include <atomic>
+#include <thread>
+#include <future>
 
 #ifndef NO_CXX11_REGEX
 #include <regex>
@@ -42,12 +45,14 @@
 #include "Partitioning.h"
 #include "RunStyles.h"
 #include "CellBuffer.h"
+#include "LiteralSearch.h"
 #include "PerLine.h"
 #include "CharClassify.h"
 #include "Decoration.h"
 #include "CaseFolder.h"
 #include "Document.h"
 #include "RESearch.h"
+#include "LinearRegex.h"
 #include "UniConversion.h"
 #include "ElapsedPeriod.h"
 
@@ -150,7 +155,9 @@ CharacterExtracted::CharacterExtracted(const unsigned char *charBytes, size_t wi
 
 Document::Document(DocumentOption options) :
 	refCount(0),
-	cb(!FlagSet(options, DocumentOption::StylesNone), FlagSet(options, DocumentOption::TextLarge)),
+	cb(!FlagSet(options, DocumentOption::StylesNone), FlagSet(options, DocumentOption::TextLarge),
+		FlagSet(options, DocumentOption::TextPieces), FlagSet(options, DocumentOption::StylesRuns),
+		FlagSet(options, DocumentOption::IndexTree)),
 	endStyled(0),
 	styleClock(0),
 	enteredModification(0),
@@ -179,6 +186,8 @@ Document::Document(DocumentOption options) :
 	perLineData[ldAnnotation] = std::make_unique<LineAnnotation>();
 	perLineData[ldEOLAnnotation] = std::make_unique<LineAnnotation>();
 
+	SetCharClassBits();
+
 	decorations = DecorationListCreate(IsLarge());
 
 	cb.SetPerLine(this);
@@ -267,6 +276,7 @@ bool Document::SetDBCSCodePage(int dbcsCodePage_) {
 	if (dbcsCodePage != dbcsCodePage_) {
 		dbcsCodePage = dbcsCodePage_;
 		SetCaseFolder(nullptr);
+		SetCharClassBits();
 		cb.SetLineEndTypes(lineEndBitSet & LineEndTypesSupported());
 		cb.SetUTF8Substance(CpUtf8 == dbcsCodePage);
 		ModifiedAt(0);	// Need to restyle whole document
@@ -398,7 +408,7 @@ Sci::Position Document::UndoActionPosition(int action) const noexcept {
 	return cb.UndoActionPosition(action);
 }
 
-std::string_view Document::UndoActionText(int action) const noexcept {
+std::string_view Document::UndoActionText(int action) const {
 	return cb.UndoActionText(action);
 }
 
@@ -410,6 +420,22 @@ void Document::ChangeLastUndoActionText(size_t length, const char *text) {
 	cb.ChangeLastUndoActionText(length, text);
 }
 
+void Document::SetUndoMemoryLimit(size_t limit) {
+	cb.SetUndoMemoryLimit(limit);
+}
+
+size_t Document::UndoMemoryLimit() const noexcept {
+	return cb.UndoMemoryLimit();
+}
+
+size_t Document::UndoMemory() const noexcept {
+	return cb.UndoMemory();
+}
+
+bool Document::UndoSpillFailed() const noexcept {
+	return cb.UndoSpillFailed();
+}
+
 int Document::GetMark(Sci::Line line, bool includeChangeHistory) const {
 	int marksHistory = 0;
 	if (includeChangeHistory && (line < LinesTotal())) {
@@ -1555,6 +1581,28 @@ int SCI_METHOD Document::AddData(const char *data, Sci_Position length) {
 	return static_cast<int>(Status::Ok);
 }
 
+int Document::AddDataLines(const char *data, Sci::Position length, const Sci::Position *lineStarts, Sci::Position lineCount) {
+	try {
+		const Sci::Position position = Length();
+		// A document being loaded has no watchers so the only notification work is moving decorations.
+		if (watchers.empty() && (enteredModification == 0) &&
+			cb.AppendScannedText(data, length, lineStarts, lineCount)) {
+			ModifiedAt(position);
+			NotifyModified(
+				DocModification(
+					ModificationFlags::InsertText | ModificationFlags::User,
+					position, length, lineCount, data));
+		} else {
+			InsertString(position, data, length);
+		}
+	} catch (std::bad_alloc &) {
+		return static_cast<int>(Status::BadAlloc);
+	} catch (...) {
+		return static_cast<int>(Status::Failure);
+	}
+	return static_cast<int>(Status::Ok);
+}
+
 IDocumentEditable *Document::AsDocumentEditable() noexcept {
 	return static_cast<IDocumentEditable *>(this);
 }
@@ -1942,7 +1990,10 @@ std::string_view Document::EOLString() const noexcept {
 
 DocumentOption Document::Options() const noexcept {
 	return (IsLarge() ? DocumentOption::TextLarge : DocumentOption::Default) |
-		(cb.HasStyles() ? DocumentOption::Default : DocumentOption::StylesNone);
+		(cb.HasStyles() ? DocumentOption::Default : DocumentOption::StylesNone) |
+		(cb.IsPieceTable() ? DocumentOption::TextPieces : DocumentOption::Default) |
+		(cb.HasStyleRuns() ? DocumentOption::StylesRuns : DocumentOption::Default) |
+		(cb.HasIndexTree() ? DocumentOption::IndexTree : DocumentOption::Default);
 }
 
 bool Document::IsWhiteLine(Sci::Line line) const {
@@ -2180,6 +2231,9 @@ constexpr bool IsWordEdge(CharacterClass cc, CharacterClass ccNext) noexcept {
 		(cc == CharacterClass::word || cc == CharacterClass::punctuation);
 }
 
+// Bytes either side of a searched range that a search reads: a word edge or the rest of a character
+constexpr Sci::Position searchViewMargin = UTF8MaxBytes + 1;
+
 }
 
 /**
@@ -2230,6 +2284,39 @@ bool Document::MatchesWordOptions(bool word, bool wordStart, Sci::Position pos,
 			(wordStart && IsWordStartAt(pos));
 }
 
+/**
+ * MatchesWordOptions for FindText. Most candidates of a whole word search have ASCII on
+ * both sides of each edge so those bytes are classified with charClassBits straight from
+ * the search's view of the text. Only edges next to a multi-byte character are decoded.
+ */
+bool Document::MatchesWordOptions(const SplitView &view, bool word, bool wordStart, Sci::Position pos, Sci::Position length) const {
+	if (!word && !wordStart)
+		return true;
+	if (pos < 0 || static_cast<size_t>(pos) >= view.length)
+		return MatchesWordOptions(word, wordStart, pos, length);
+
+	// Word start is needed both by itself and as the start of a whole word
+	const unsigned char ch = view.CharAt(pos);
+	const unsigned char chBefore = (pos > 0) ? view.CharAt(pos - 1) : ' ';
+	if (charClassBits.IsKnown(ch) && charClassBits.IsKnown(chBefore)) {
+		if (!charClassBits.IsEdge(ch, chBefore))
+			return false;
+	} else if (!IsWordStartAt(pos)) {
+		return false;
+	}
+	if (wordStart)
+		return true;
+	if (length <= 0)
+		return false;
+
+	const Sci::Position end = pos + length;
+	const unsigned char chLast = view.CharAt(end - 1);
+	const unsigned char chAfter = (static_cast<size_t>(end) < view.length) ? view.CharAt(end) : ' ';
+	if (charClassBits.IsKnown(chLast) && charClassBits.IsKnown(chAfter))
+		return charClassBits.IsEdge(chLast, chAfter);
+	return IsWordEndAt(end);
+}
+
 bool Document::HasCaseFolder() const noexcept {
 	return pcf != nullptr;
 }
@@ -2251,40 +2338,6 @@ CharacterExtracted Document::ExtractCharacter(Sci::Position position) const noex
 	return CharacterExtracted(charBytes, widthCharBytes);
 }
 
-namespace {
-
-// Equivalent of memchr over the split view
-ptrdiff_t SplitFindChar(const SplitView &view, size_t start, size_t length, int ch) noexcept {
-	size_t range1Length = 0;
-	if (start < view.length1) {
-		range1Length = std::min(length, view.length1 - start);
-		const char *match = static_cast<const char *>(memchr(view.segment1 + start, ch, range1Length));
-		if (match) {
-			return match - view.segment1;
-		}
-		start += range1Length;
-	}
-	const char *match2 = static_cast<const char *>(memchr(view.segment2 + start, ch, length - range1Length));
-	if (match2) {
-		return match2 - view.segment2;
-	}
-	return -1;
-}
-
-// Equivalent of memcmp over the split view
-// This does not call memcmp as search texts are commonly too short to overcome the
-// call overhead.
-bool SplitMatch(const SplitView &view, size_t start, std::string_view text) noexcept {
-	for (size_t i = 0; i < text.length(); i++) {
-		if (view.CharAt(i + start) != text[i]) {
-			return false;
-		}
-	}
-	return true;
-}
-
-}
-
 /**
  * Find text in document, supporting both forward and backward
  * searches (just pass minPos > maxPos to do a backward search)
@@ -2321,21 +2374,22 @@ Sci::Position Document::FindText(Sci::Position minPos, Sci::Position maxPos, con
 			// Back all of a character
 			pos = NextPosition(pos, increment);
 		}
-		const SplitView cbView = cb.AllView();
+		// Only the searched range is viewed so a piece table joins no more than that
+		const SplitView cbView = cb.RangeView(std::min(startPos, endPos) - searchViewMargin, limitPos + searchViewMargin);
 		if (caseSensitive) {
 			const Sci::Position endSearch = (startPos <= endPos) ? endPos - lengthFind + 1 : endPos;
 			const unsigned char charStartSearch =  search[0];
 			if (forward && ((0 == dbcsCodePage) || (CpUtf8 == dbcsCodePage && !UTF8IsTrailByte(charStartSearch)))) {
 				// This is a fast case where there is no need to test byte values to iterate
-				// so becomes the equivalent of a memchr+memcmp loop.
+				// so the whole search text can be looked for with SplitFindLiteral.
 				// UTF-8 search will not be self-synchronizing when starts with trail byte
-				const std::string_view suffix(search + 1, lengthFind - 1);
+				const std::string_view needle(search, lengthFind);
 				while (pos < endSearch) {
-					pos = SplitFindChar(cbView, pos, limitPos - pos, charStartSearch);
+					pos = SplitFindLiteral(cbView, pos, limitPos, needle);
 					if (pos < 0) {
 						break;
 					}
-					if (SplitMatch(cbView, pos + 1, suffix) && MatchesWordOptions(word, wordStart, pos, lengthFind)) {
+					if (MatchesWordOptions(cbView, word, wordStart, pos, lengthFind)) {
 						return pos;
 					}
 					pos++;
@@ -2349,7 +2403,7 @@ Sci::Position Document::FindText(Sci::Position minPos, Sci::Position maxPos, con
 						for (int indexSearch = 1; (indexSearch < lengthFind) && found; indexSearch++) {
 							found = cbView.CharAt(pos + indexSearch) == search[indexSearch];
 						}
-						if (found && MatchesWordOptions(word, wordStart, pos, lengthFind)) {
+						if (found && MatchesWordOptions(cbView, word, wordStart, pos, lengthFind)) {
 							return pos;
 						}
 					}
@@ -2371,51 +2425,21 @@ Sci::Position Document::FindText(Sci::Position minPos, Sci::Position maxPos, con
 			std::vector<char> searchThing((lengthFind+1) * UTF8MaxBytes * maxFoldingExpansion + 1);
 			const size_t lenSearch =
 				pcf->Fold(searchThing.data(), searchThing.size(), search, lengthFind);
+			const std::string_view folded(searchThing.data(), lenSearch);
 			while (forward ? (pos < endPos) : (pos >= endPos)) {
-				int widthFirstCharacter = 1;
-				Sci::Position posIndexDocument = pos;
-				size_t indexSearch = 0;
-				bool characterMatches = true;
-				while (indexSearch < lenSearch) {
-					const unsigned char leadByte = cbView.CharAt(posIndexDocument);
-					int widthChar = 1;
-					size_t lenFlat = 1;
-					if (UTF8IsAscii(leadByte)) {
-						if ((posIndexDocument + 1) > limitPos) {
-							break;
-						}
-						characterMatches = searchThing[indexSearch] == MakeLowerCase(leadByte);
-					} else {
-						char bytes[UTF8MaxBytes]{ static_cast<char>(leadByte) };
-						const int widthCharBytes = UTF8BytesOfLead[leadByte];
-						for (int b = 1; b < widthCharBytes; b++) {
-							bytes[b] = cbView.CharAt(posIndexDocument + b);
-						}
-						widthChar = UTF8Classify(bytes, widthCharBytes) & UTF8MaskWidth;
-						if (!indexSearch) {	// First character
-							widthFirstCharacter = widthChar;
-						}
-						if ((posIndexDocument + widthChar) > limitPos) {
-							break;
-						}
-						char folded[UTF8MaxBytes * maxFoldingExpansion + 1];
-						lenFlat = pcf->Fold(folded, sizeof(folded), bytes, widthChar);
-						// memcmp may examine lenFlat bytes in both arguments so assert it doesn't read past end of searchThing
-						assert((indexSearch + lenFlat) <= searchThing.size());
-						// Does folded match the buffer
-						characterMatches = 0 == memcmp(folded, searchThing.data() + indexSearch, lenFlat);
-					}
-					if (!characterMatches) {
+				if (forward) {
+					// Skip ASCII that can not start a match. Candidates are always character starts
+					// as trail bytes are outside ASCII and so stop the skip first.
+					pos = SplitFindFoldedCandidate(cbView, pos, limitPos, folded);
+					if (pos < 0) {
 						break;
 					}
-					posIndexDocument += widthChar;
-					indexSearch += lenFlat;
 				}
-				if (characterMatches && (indexSearch == lenSearch)) {
-					if (MatchesWordOptions(word, wordStart, pos, posIndexDocument - pos)) {
-						*length = posIndexDocument - pos;
-						return pos;
-					}
+				int widthFirstCharacter = 1;
+				const Sci::Position lengthMatch = SplitMatchFoldedUTF8(cbView, pos, limitPos, folded, *pcf, widthFirstCharacter);
+				if ((lengthMatch > 0) && MatchesWordOptions(cbView, word, wordStart, pos, lengthMatch)) {
+					*length = lengthMatch;
+					return pos;
 				}
 				if (forward) {
 					pos += widthFirstCharacter;
@@ -2467,7 +2491,7 @@ Sci::Position Document::FindText(Sci::Position minPos, Sci::Position maxPos, con
 					indexSearch += lenFlat;
 				}
 				if (characterMatches && (indexSearch == lenSearch)) {
-					if (MatchesWordOptions(word, wordStart, pos, indexDocument)) {
+					if (MatchesWordOptions(cbView, word, wordStart, pos, indexDocument)) {
 						*length = indexDocument;
 						return pos;
 					}
@@ -2484,7 +2508,14 @@ Sci::Position Document::FindText(Sci::Position minPos, Sci::Position maxPos, con
 			const Sci::Position endSearch = (startPos <= endPos) ? endPos - lengthFind + 1 : endPos;
 			std::vector<char> searchThing(lengthFind + 1);
 			pcf->Fold(searchThing.data(), searchThing.size(), search, lengthFind);
+			const std::string_view folded(searchThing.data(), lengthFind);
 			while (forward ? (pos < endSearch) : (pos >= endSearch)) {
+				if (forward) {
+					pos = SplitFindFoldedCandidate(cbView, pos, limitPos, folded);
+					if ((pos < 0) || (pos >= endSearch)) {
+						break;
+					}
+				}
 				bool found = (pos + lengthFind) <= limitPos;
 				for (int indexSearch = 0; (indexSearch < lengthFind) && found; indexSearch++) {
 					const char ch = cbView.CharAt(pos + indexSearch);
@@ -2497,7 +2528,7 @@ Sci::Position Document::FindText(Sci::Position minPos, Sci::Position maxPos, con
 						found = folded[0] == chTest;
 					}
 				}
-				if (found && MatchesWordOptions(word, wordStart, pos, lengthFind)) {
+				if (found && MatchesWordOptions(cbView, word, wordStart, pos, lengthFind)) {
 					return pos;
 				}
 				pos += increment;
@@ -2508,6 +2539,218 @@ Sci::Position Document::FindText(Sci::Position minPos, Sci::Position maxPos, con
 	return -1;
 }
 
+/**
+ * Find the next match of search forwards from pos to maxPos and move pos past it,
+ * stepping over a character after an empty match so the same match is not found again.
+ */
+bool Document::FindNextMatch(Sci::Position &pos, Sci::Position maxPos, const char *search,
+                        FindOption flags, Sci::Position length, Range &match, RegexSearchBase *searcher) {
+	if (pos > maxPos)
+		return false;
+	Sci::Position lengthFound = length;
+	// A regular expression searcher other than the document's own lets other threads search
+	const Sci::Position found = (searcher && FlagSet(flags, FindOption::RegExp)) ?
+		searcher->FindText(this, pos, maxPos, search, FlagSet(flags, FindOption::MatchCase),
+			FlagSet(flags, FindOption::WholeWord), FlagSet(flags, FindOption::WordStart), flags, &lengthFound) :
+		FindText(pos, maxPos, search, flags, &lengthFound);
+	if (found < 0)
+		return false;
+	match = Range(found, found + lengthFound);
+	if (lengthFound > 0)
+		pos = match.end;
+	else
+		pos = (found >= maxPos) ? maxPos + 1 : NextPosition(found, 1);
+	return true;
+}
+
+namespace {
+
+// Amount of text each thread searches at a time when searching in parallel
+constexpr Sci::Position parallelSearchChunk = 0x100000;
+
+bool LinearRegexCanMatchLineEnd(const Document *doc, const char *s, Sci::Position length, bool caseSensitive);
+
+}
+
+/**
+ * Whether matches of search can be found independently in separate runs of lines.
+ * Regular expressions are matched within single lines except by the linear engine,
+ * whose matches can only continue over a line end when the pattern can match CR or LF.
+ * Other text can only match across a line end when it contains a line end character.
+ */
+bool Document::CanSearchInParallel(const char *search, FindOption flags, Sci::Position length) const noexcept {
+	if (FlagSet(flags, FindOption::RegExp) && !FlagSet(flags, FindOption::LinearRegEx))
+		return true;
+	if (GetLineEndTypesActive() != LineEndType::Default)
+		return false;
+	if (FlagSet(flags, FindOption::RegExp)) {
+		try {
+			return !LinearRegexCanMatchLineEnd(this, search, length, FlagSet(flags, FindOption::MatchCase));
+		} catch (...) {
+			return false;
+		}
+	}
+	const std::string_view text(search, length);
+	return text.find_first_of("\r\n") == std::string_view::npos;
+}
+
+/**
+ * Find every match of search from minPos to maxPos in one forward pass so that the pattern
+ * is prepared once rather than once per match.
+ * Matches are appended to matches, if not null, until there are maxMatches of them.
+ * Returns the number of matches found which, with null matches, counts all of them.
+ * With more than one thread, a large range is split into chunks of whole lines that are
+ * searched concurrently, each thread with its own regular expression searcher, and the
+ * matches of the chunks are joined in order. The text is only read so it is safe for the
+ * threads to share while the caller waits for them.
+ */
+Sci::Position Document::FindAll(Sci::Position minPos, Sci::Position maxPos, const char *search,
+                        FindOption flags, Sci::Position length, std::vector<Range> *matches, Sci::Position maxMatches,
+                        unsigned int threads) {
+	if (length <= 0)
+		return 0;
+	if (minPos > maxPos)
+		std::swap(minPos, maxPos);
+	Sci::Position count = 0;
+	Range match;
+
+	if ((threads > 1) && (maxPos - minPos >= parallelSearchChunk * 2) && CanSearchInParallel(search, flags, length)) {
+		// Chunks start at line starts so no match crosses into the next chunk
+		std::vector<Sci::Position> chunkStarts{ minPos };
+		Sci::Position chunkStart = minPos;
+		while (maxPos - chunkStart > parallelSearchChunk) {
+			const Sci::Position nextStart = LineStart(SciLineFromPosition(chunkStart + parallelSearchChunk) + 1);
+			if (nextStart >= maxPos)
+				break;
+			chunkStarts.push_back(nextStart);
+			chunkStart = nextStart;
+		}
+		const size_t chunks = chunkStarts.size();
+		chunkStarts.push_back(maxPos);
+
+		std::vector<std::vector<Range>> chunkMatches(matches ? chunks : 0);
+		std::vector<Sci::Position> chunkCounts(chunks);
+		std::atomic<size_t> nextIndex = 0;
+		const bool regExp = FlagSet(flags, FindOption::RegExp);
+
+		// Join the range of a piece table now as the threads only read - their views are inside it
+		RangeView(minPos - searchViewMargin, maxPos + searchViewMargin);
+
+		// Search chunks on multiple threads
+		std::vector<std::future<void>> futures;
+		const size_t workers = std::min<size_t>(threads, chunks);
+		for (size_t th = 0; th < workers; th++) {
+			std::future<void> fut = std::async(std::launch::async,
+				[=, &chunkStarts, &chunkMatches, &chunkCounts, &nextIndex]() {
+				std::unique_ptr<RegexSearchBase> searcher;
+				if (regExp)
+					searcher.reset(CreateRegexSearch(&charClass));
+				for (size_t chunk = nextIndex.fetch_add(1); chunk < chunks; chunk = nextIndex.fetch_add(1)) {
+					const Sci::Position chunkEnd = chunkStarts[chunk + 1];
+					const bool last = chunk + 1 == chunks;
+					Sci::Position pos = chunkStarts[chunk];
+					Range found;
+					while (!(matches && (chunkCounts[chunk] >= maxMatches)) &&
+						FindNextMatch(pos, chunkEnd, search, flags, length, found, searcher.get())) {
+						// An empty match at the end belongs to the next chunk
+						if (!last && (found.start >= chunkEnd))
+							break;
+						if (matches)
+							chunkMatches[chunk].push_back(found);
+						chunkCounts[chunk]++;
+					}
+				}
+			});
+			futures.push_back(std::move(fut));
+		}
+		for (const std::future<void> &f : futures) {
+			f.wait();
+		}
+		// Rethrows any RegexError
+		for (std::future<void> &f : futures) {
+			f.get();
+		}
+
+		for (size_t chunk = 0; chunk < chunks; chunk++) {
+			if (matches) {
+				const size_t wanted = std::min<size_t>(chunkMatches[chunk].size(), maxMatches - count);
+				matches->insert(matches->end(), chunkMatches[chunk].begin(), chunkMatches[chunk].begin() + wanted);
+				count += wanted;
+			} else {
+				count += chunkCounts[chunk];
+			}
+		}
+		return count;
+	}
+
+	Sci::Position pos = minPos;
+	while (!(matches && (count >= maxMatches)) && FindNextMatch(pos, maxPos, search, flags, length, match)) {
+		if (matches)
+			matches->push_back(match);
+		count++;
+	}
+	return count;
+}
+
+/**
+ * Replace every match of search from minPos to maxPos in a single undo action.
+ * All matches are found before any is replaced so replaced text is never searched again.
+ * They are then replaced from last to first, each as a deletion and an insertion of just
+ * the text that differs, so markers and other line data outside the matches are kept.
+ * With substitute, replacement is expanded for each match as by SubstituteByPosition.
+ * Returns the number of matches replaced, which is fewer than were found if the document
+ * stops accepting changes part way, and sets changed to the replaced text.
+ */
+Sci::Position Document::ReplaceAll(Sci::Position minPos, Sci::Position maxPos, const char *search,
+                        FindOption flags, Sci::Position length, std::string_view replacement, bool substitute, Range &changed) {
+	if (length <= 0)
+		return 0;
+	if (minPos > maxPos)
+		std::swap(minPos, maxPos);
+	// Find every match before changing anything, expanding regex tags while each match is current
+	std::vector<Range> matches;
+	std::string substitutions;
+	std::vector<size_t> substitutionEnds;
+	Sci::Position pos = minPos;
+	Range match;
+	while (FindNextMatch(pos, maxPos, search, flags, length, match)) {
+		matches.push_back(match);
+		if (substitute) {
+			Sci::Position lengthSubstituted = replacement.length();
+			const char *substituted = SubstituteByPosition(replacement.data(), &lengthSubstituted);
+			if (substituted)
+				substitutions.append(substituted, lengthSubstituted);
+			substitutionEnds.push_back(substitutions.length());
+		}
+	}
+	if (matches.empty())
+		return 0;
+
+	// Replace from the last match back so earlier matches are still where they were found.
+	// Only the matched text changes so markers, folds and indicators elsewhere are kept.
+	UndoGroup ug(this);
+	Sci::Position growth = 0;
+	size_t replaced = 0;
+	for (size_t i = matches.size(); i-- > 0;) {
+		std::string_view text = replacement;
+		if (substitute) {
+			const size_t start = (i > 0) ? substitutionEnds[i - 1] : 0;
+			text = std::string_view(substitutions).substr(start, substitutionEnds[i] - start);
+		}
+		Range range = matches[i];
+		const Sci::Position difference = static_cast<Sci::Position>(text.length()) - range.Length();
+		TrimReplacement(text, range);
+		if ((range.Length() > 0) && !DeleteChars(range.start, range.Length()))
+			break;	// Read-only: the later matches stay replaced
+		InsertString(range.start, text);
+		growth += difference;
+		replaced++;
+	}
+	if (replaced > 0)
+		changed = Range(matches[matches.size() - replaced].start, matches.back().end + growth);
+	return replaced;
+}
+
 const char *Document::SubstituteByPosition(const char *text, Sci::Position *length) {
 	if (regex) {
 		return regex->SubstituteByPosition(this, text, length);
@@ -2537,10 +2780,34 @@ void Document::AllocateLines(Sci::Line lines) {
 
 void Document::SetDefaultCharClasses(bool includeWordClass) {
 	charClass.SetDefaultCharClasses(includeWordClass);
+	SetCharClassBits();
+	// Compiled regular expressions may depend on which characters are words
+	regex.reset();
 }
 
 void Document::SetCharClasses(const unsigned char *chars, CharacterClass newCharClass) {
 	charClass.SetCharClasses(chars, newCharClass);
+	SetCharClassBits();
+	regex.reset();
+}
+
+/**
+ * Copy the classes into bit sets for whole word searches and mark the bytes that are complete
+ * characters wherever they occur: every byte in single byte encodings, ASCII in UTF-8 and in
+ * DBCS only ASCII that can't be the second byte of a character.
+ */
+void Document::SetCharClassBits() noexcept {
+	charClassBits.SetClasses(charClass);
+	for (int ch = 0; ch < 256; ch++) {
+		const unsigned char uch = static_cast<unsigned char>(ch);
+		bool known = true;
+		if (CpUtf8 == dbcsCodePage) {
+			known = UTF8IsAscii(uch);
+		} else if (dbcsCodePage) {
+			known = UTF8IsAscii(uch) && !IsDBCSTrailByteNoExcept(static_cast<char>(uch));
+		}
+		charClassBits.SetKnown(uch, known);
+	}
 }
 
 int Document::GetCharsOfClass(CharacterClass characterClass, unsigned char *buffer) const {
@@ -2580,19 +2847,12 @@ bool SCI_METHOD Document::SetStyles(Sci_Position length, const char *styles) {
 		return false;
 	}
 	enteredStyling++;
-	bool didChange = false;
 	Sci::Position startMod = 0;
 	Sci::Position endMod = 0;
-	for (int iPos = 0; iPos < length; iPos++, endStyled++) {
-		PLATFORM_ASSERT(endStyled < Length());
-		if (cb.SetStyleAt(endStyled, styles[iPos])) {
-			if (!didChange) {
-				startMod = endStyled;
-			}
-			didChange = true;
-			endMod = endStyled;
-		}
-	}
+	PLATFORM_ASSERT(length <= 0 || endStyled + length <= Length());
+	const bool didChange = cb.SetStyles(endStyled, styles, length, startMod, endMod);
+	if (length > 0)
+		endStyled += length;
 	if (didChange) {
 		const DocModification mh(ModificationFlags::ChangeStyle | ModificationFlags::User,
 			                startMod, endMod - startMod + 1);
@@ -3040,6 +3300,48 @@ Sci::Position Document::BraceMatch(Sci::Position position, Sci::Position /*maxRe
 	return -1;
 }
 
+#ifndef NO_CXX11_REGEX
+
+/**
+ * Compiled C++11 regular expressions keyed by pattern and flags, most recently used first,
+ * so that repeated searches for the same pattern don't construct the regex each time.
+ */
+template <typename Regex>
+class CompiledRegexCache {
+	struct Entry {
+		std::string pattern;
+		std::regex::flag_type flags;
+		Regex regexp;
+	};
+	std::vector<Entry> entries;
+public:
+	static constexpr size_t maxEntries = 4;
+	template <typename Convert>
+	const Regex &Compiled(const char *s, std::regex::flag_type flags, Convert convert) {
+		for (auto it = entries.begin(); it != entries.end(); ++it) {
+			if ((it->flags == flags) && (it->pattern == s)) {
+				std::rotate(entries.begin(), it, it + 1);
+				return entries.front().regexp;
+			}
+		}
+		// Compile before touching entries as assign throws std::regex_error for bad patterns
+		Regex regexp;
+		regexp.assign(convert(s), flags);
+		if (entries.size() >= maxEntries) {
+			entries.pop_back();
+		}
+		entries.insert(entries.begin(), Entry{ s, flags, std::move(regexp) });
+		return entries.front().regexp;
+	}
+};
+
+struct Cxx11RegexCache {
+	CompiledRegexCache<std::regex> bytes;
+	CompiledRegexCache<std::wregex> wide;
+};
+
+#endif
+
 /**
  * Implementation of RegexSearchBase for the default built-in regular expression engine
  */
@@ -3056,6 +3358,15 @@ public:
 private:
 	RESearch search;
 	std::string substituted;
+	// Pattern and options search was last compiled with, so it is only recompiled when they change
+	std::string compiledPattern;
+	bool compiledCaseSensitive = false;
+	bool compiledPosix = false;
+	bool compiled = false;
+	LinearRegex linear;
+#ifndef NO_CXX11_REGEX
+	Cxx11RegexCache cxx11Cache;
+#endif
 };
 
 namespace {
@@ -3395,7 +3706,7 @@ bool MatchOnLines(const Document *doc, const Regex &regexp, const RESearchRange
 }
 
 Sci::Position Cxx11RegexFindText(const Document *doc, Sci::Position minPos, Sci::Position maxPos, const char *s,
-	bool caseSensitive, Sci::Position *length, RESearch &search) {
+	bool caseSensitive, Sci::Position *length, RESearch &search, Cxx11RegexCache &cache) {
 	const RESearchRange resr(doc, minPos, maxPos);
 	try {
 		//ElapsedPeriod ep;
@@ -3414,13 +3725,12 @@ Sci::Position Cxx11RegexFindText(const Document *doc, Sci::Position minPos, Sci:
 
 		bool matched = false;
 		if (CpUtf8 == doc->dbcsCodePage) {
-			const std::wstring ws = WStringFromUTF8(s);
-			std::wregex regexp;
-			regexp.assign(ws, flagsRe);
+			const std::wregex &regexp = cache.wide.Compiled(s, flagsRe,
+				[](const char *pattern) { return WStringFromUTF8(pattern); });
 			matched = MatchOnLines<UTF8Iterator>(doc, regexp, resr, search);
 		} else {
-			std::regex regexp;
-			regexp.assign(s, flagsRe);
+			const std::regex &regexp = cache.bytes.Compiled(s, flagsRe,
+				[](const char *pattern) { return pattern; });
 			matched = MatchOnLines<ByteIterator>(doc, regexp, resr, search);
 		}
 
@@ -3446,6 +3756,53 @@ Sci::Position Cxx11RegexFindText(const Document *doc, Sci::Position minPos, Sci:
 
 #endif
 
+// Presents a document to LinearRegex
+class DocumentRegexText : public LinearRegexText {
+	const Document *doc;
+public:
+	DocumentRegexText(const Document *doc_, Sci::Position start, Sci::Position end) :
+		LinearRegexText(doc_->RangeView(start - searchViewMargin, end + searchViewMargin), doc_->dbcsCodePage), doc(doc_) {
+	}
+	bool IsDBCSLeadByte(char ch) const noexcept override {
+		return doc->IsDBCSLeadByteNoExcept(ch);
+	}
+	bool IsWordCharacter(int ch) const noexcept override {
+		return doc->WordCharacterClass(ch) == CharacterClass::word;
+	}
+};
+
+Sci::Position LinearRegexFindText(const Document *doc, Sci::Position minPos, Sci::Position maxPos, const char *s,
+	bool caseSensitive, Sci::Position *length, RESearch &search, LinearRegex &linear) {
+	const RESearchRange resr(doc, minPos, maxPos);
+	// Matches may span lines so the whole range is searched at once, backwards by finding the last match
+	const Sci::Position searchStart = std::min(resr.startPos, resr.endPos);
+	const Sci::Position searchEnd = std::max(resr.startPos, resr.endPos);
+	const DocumentRegexText text(doc, searchStart, searchEnd);
+	const char *errmsg = linear.Compile(std::string_view(s, *length), caseSensitive, text);
+	if (errmsg) {
+		throw RegexError();
+	}
+	if (!linear.Search(text, searchStart, searchEnd, resr.increment < 0)) {
+		return -1;
+	}
+	for (size_t co = 0; co < RESearch::MAXTAG && co < LinearRegex::MAXTAG; co++) {
+		search.bopat[co] = linear.bopat[co];
+		search.eopat[co] = linear.eopat[co];
+	}
+	*length = linear.eopat[0] - linear.bopat[0];
+	return linear.bopat[0];
+}
+
+// An invalid pattern can match anything so is left to be reported by a single threaded search
+bool LinearRegexCanMatchLineEnd(const Document *doc, const char *s, Sci::Position length, bool caseSensitive) {
+	const DocumentRegexText text(doc, 0, 0);
+	LinearRegex linear;
+	if (linear.Compile(std::string_view(s, length), caseSensitive, text)) {
+		return true;
+	}
+	return linear.CanMatchLineEnd(text);
+}
+
 }
 
 Sci::Position BuiltinRegex::FindText(Document *doc, Sci::Position minPos, Sci::Position maxPos, const char *s,
@@ -3455,17 +3812,29 @@ Sci::Position BuiltinRegex::FindText(Document *doc, Sci::Position minPos, Sci::P
 #ifndef NO_CXX11_REGEX
 	if (FlagSet(flags, FindOption::Cxx11RegEx)) {
 			return Cxx11RegexFindText(doc, minPos, maxPos, s,
-			caseSensitive, length, search);
+			caseSensitive, length, search, cxx11Cache);
 	}
 #endif
+	if (FlagSet(flags, FindOption::LinearRegEx)) {
+		return LinearRegexFindText(doc, minPos, maxPos, s, caseSensitive, length, search, linear);
+	}
 
 	const RESearchRange resr(doc, minPos, maxPos);
 
 	const bool posix = FlagSet(flags, FindOption::Posix);
 
-	const char *errmsg = search.Compile(s, *length, caseSensitive, posix);
-	if (errmsg) {
-		return -1;
+	const std::string_view pattern(s, *length);
+	if (!compiled || (pattern != compiledPattern) ||
+		(caseSensitive != compiledCaseSensitive) || (posix != compiledPosix)) {
+		compiled = false;
+		const char *errmsg = search.Compile(s, *length, caseSensitive, posix);
+		if (errmsg) {
+			return -1;
+		}
+		compiledPattern = pattern;
+		compiledCaseSensitive = caseSensitive;
+		compiledPosix = posix;
+		compiled = true;
 	}
 	// Find a variable in a property file: \$(\([A-Za-z0-9_.]+\))
 	// Replace first '.' with '-' in each property file variable reference:
@@ -277,7 +277,7 @@ bool DiscardLastCombinedCharacter(std::string_view &text) noexcept;
 
 /**
  */
-class Document : PerLine, public Scintilla::IDocument, public Scintilla::ILoader, public Scintilla::IDocumentEditable {
+class Document : PerLine, public Scintilla::IDocument, public Scintilla::ILoader, public Scintilla::IDocumentEditable, public ILoaderLines {
 
 public:
 	/** Used to pair watcher pointer with user data. */
@@ -296,6 +296,7 @@ private:
 	int refCount;
 	CellBuffer cb;
 	CharClassify charClass;
+	CharClassBits charClassBits;
 	CharacterCategoryMap charMap;
 	std::unique_ptr<CaseFolder> pcf;
 	Sci::Position endStyled;
@@ -404,6 +405,7 @@ public:
 	Sci::Position InsertString(Sci::Position position, std::string_view sv);
 	void ChangeInsertion(const char *s, Sci::Position length);
 	int SCI_METHOD AddData(const char *data, Sci_Position length) override;
+	int AddDataLines(const char *data, Sci::Position length, const Sci::Position *lineStarts, Sci::Position lineCount) override;
 	IDocumentEditable *AsDocumentEditable() noexcept;
 	void *SCI_METHOD ConvertToDocument() override;
 	Sci::Position Undo();
@@ -439,9 +441,13 @@ public:
 	int UndoCurrent() const noexcept;
 	int UndoActionType(int action) const noexcept;
 	Sci::Position UndoActionPosition(int action) const noexcept;
-	std::string_view UndoActionText(int action) const noexcept;
+	std::string_view UndoActionText(int action) const;
 	void PushUndoActionType(int type, Sci::Position position);
 	void ChangeLastUndoActionText(size_t length, const char *text);
+	void SetUndoMemoryLimit(size_t limit);
+	size_t UndoMemoryLimit() const noexcept;
+	size_t UndoMemory() const noexcept;
+	bool UndoSpillFailed() const noexcept;
 
 	void ChangeHistorySet(bool set) { cb.ChangeHistorySet(set); }
 	[[nodiscard]] int EditionAt(Sci::Position pos) const noexcept { return cb.EditionAt(pos); }
@@ -450,8 +456,10 @@ public:
 	[[nodiscard]] Sci::Position EditionNextDelete(Sci::Position pos) const noexcept { return cb.EditionNextDelete(pos); }
 
 	const char *SCI_METHOD BufferPointer() override { return cb.BufferPointer(); }
-	const char *RangePointer(Sci::Position position, Sci::Position rangeLength) noexcept { return cb.RangePointer(position, rangeLength); }
+	const char *RangePointer(Sci::Position position, Sci::Position rangeLength) { return cb.RangePointer(position, rangeLength); }
 	Sci::Position GapPosition() const noexcept { return cb.GapPosition(); }
+	SplitView AllView() const { return cb.AllView(); }
+	SplitView RangeView(Sci::Position start, Sci::Position end) const { return cb.RangeView(start, end); }
 
 	int SCI_METHOD GetLineIndentation(Sci_Position line) override;
 	Sci::Position SetLineIndentation(Sci::Line line, Sci::Position indent);
@@ -527,9 +535,17 @@ public:
 	bool IsWordAt(Sci::Position start, Sci::Position end) const;
 
 	bool MatchesWordOptions(bool word, bool wordStart, Sci::Position pos, Sci::Position length) const;
+	bool MatchesWordOptions(const SplitView &view, bool word, bool wordStart, Sci::Position pos, Sci::Position length) const;
 	bool HasCaseFolder() const noexcept;
 	void SetCaseFolder(std::unique_ptr<CaseFolder> pcf_) noexcept;
 	Sci::Position FindText(Sci::Position minPos, Sci::Position maxPos, const char *search, Scintilla::FindOption flags, Sci::Position *length);
+	bool FindNextMatch(Sci::Position &pos, Sci::Position maxPos, const char *search, Scintilla::FindOption flags, Sci::Position length, Range &match,
+		RegexSearchBase *searcher=nullptr);
+	bool CanSearchInParallel(const char *search, Scintilla::FindOption flags, Sci::Position length) const noexcept;
+	Sci::Position FindAll(Sci::Position minPos, Sci::Position maxPos, const char *search, Scintilla::FindOption flags, Sci::Position length,
+		std::vector<Range> *matches, Sci::Position maxMatches, unsigned int threads=1);
+	Sci::Position ReplaceAll(Sci::Position minPos, Sci::Position maxPos, const char *search, Scintilla::FindOption flags, Sci::Position length,
+		std::string_view replacement, bool substitute, Range &changed);
 	const char *SubstituteByPosition(const char *text, Sci::Position *length);
 	Scintilla::LineCharacterIndexType LineCharacterIndex() const noexcept;
 	void AllocateLineCharacterIndex(Scintilla::LineCharacterIndexType lineCharacterIndex);
@@ -597,6 +613,7 @@ public:
 	Sci::Position BraceMatch(Sci::Position position, Sci::Position maxReStyle, Sci::Position startPos, bool useStartPos) noexcept;
 
 private:
+	void SetCharClassBits() noexcept;
 	void NotifyModifyAttempt();
 	void NotifySavePoint(bool atSavePoint);
 	void NotifyGroupCompleted() noexcept;
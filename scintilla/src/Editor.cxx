@@ -178,6 +178,7 @@ Editor::Editor() : durationWrapOneByte(0.000001, 0.00000001, 0.00001) {
 
 	targetRange = SelectionSegment();
 	searchFlags = FindOption::None;
+	searchThreads = 1;
 
 	topLine = 0;
 	posTopLine = 0;
@@ -4278,6 +4279,39 @@ Sci::Position Editor::FindText(
 	}
 }
 
+/**
+ * Search for every occurrence of text in a range in one pass.
+ * @return The number of occurrences, which are stored in the ranges array up to maxRanges,
+ * or -1 for an invalid regular expression. With a null ranges array they are only counted.
+ */
+Sci::Position Editor::FindAll(
+    uptr_t wParam,		///< Search modes : @c FindOption::MatchCase, @c FindOption::WholeWord,
+    ///< @c FindOption::WordStart, @c FindOption::RegExp or @c FindOption::Posix.
+    sptr_t lParam) {	///< @c Sci_TextToFindAll structure: The text to search for in the given range.
+
+	TextToFindAll *fa = static_cast<TextToFindAll *>(PtrFromSPtr(lParam));
+	const Sci::Position length = strlen(fa->lpstrText);
+	if (!pdoc->HasCaseFolder())
+		pdoc->SetCaseFolder(CaseFolderForEncoding());
+	try {
+		if (!fa->ranges) {
+			return pdoc->FindAll(fa->chrg.cpMin, fa->chrg.cpMax, fa->lpstrText,
+				static_cast<FindOption>(wParam), length, nullptr, 0, searchThreads);
+		}
+		std::vector<Range> matches;
+		const Sci::Position count = pdoc->FindAll(fa->chrg.cpMin, fa->chrg.cpMax, fa->lpstrText,
+			static_cast<FindOption>(wParam), length, &matches, std::max<Sci::Position>(fa->maxRanges, 0), searchThreads);
+		for (size_t i = 0; i < matches.size(); i++) {
+			fa->ranges[i].cpMin = matches[i].start;
+			fa->ranges[i].cpMax = matches[i].end;
+		}
+		return count;
+	} catch (RegexError &) {
+		errorStatus = Status::RegEx;
+		return -1;
+	}
+}
+
 /**
  * Search of a text in the document, in the given range.
  * @return The position of the found text, -1 if not found.
@@ -4402,6 +4436,27 @@ Sci::Position Editor::SearchInTarget(const char *text, Sci::Position length) {
 	}
 }
 
+/**
+ * Replace every occurrence of text in the target using the search flags, as one undo action.
+ * @return The number of occurrences replaced or -1 for an invalid regular expression.
+ */
+Sci::Position Editor::ReplaceAllInTarget(const char *text, const char *replacement) {
+	if (!pdoc->HasCaseFolder())
+		pdoc->SetCaseFolder(CaseFolderForEncoding());
+	try {
+		Range changed;
+		const Sci::Position count = pdoc->ReplaceAll(targetRange.start.Position(), targetRange.end.Position(), text,
+				searchFlags, strlen(text), replacement, FlagSet(searchFlags, FindOption::RegExp), changed);
+		if (count > 0) {
+			targetRange = SelectionSegment(SelectionPosition(changed.start), SelectionPosition(changed.end));
+		}
+		return count;
+	} catch (RegexError &) {
+		errorStatus = Status::RegEx;
+		return -1;
+	}
+}
+
 void Editor::GoToLine(Sci::Line lineNo) {
 	if (lineNo > pdoc->LinesTotal())
 		lineNo = pdoc->LinesTotal();
@@ -6546,6 +6601,10 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 		PLATFORM_ASSERT(lParam);
 		return SearchInTarget(ConstCharPtrFromSPtr(lParam), PositionFromUPtr(wParam));
 
+	case Message::ReplaceAllInTarget:
+		PLATFORM_ASSERT(wParam && lParam);
+		return ReplaceAllInTarget(ConstCharPtrFromUPtr(wParam), ConstCharPtrFromSPtr(lParam));
+
 	case Message::SetSearchFlags:
 		searchFlags = static_cast<FindOption>(wParam);
 		break;
@@ -6637,6 +6696,16 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 	case Message::FindTextFull:
 		return FindTextFull(wParam, lParam);
 
+	case Message::FindAll:
+		return FindAll(wParam, lParam);
+
+	case Message::SetSearchThreads:
+		searchThreads = std::clamp(static_cast<unsigned int>(wParam), 1U, std::max(std::thread::hardware_concurrency(), 1U));
+		break;
+
+	case Message::GetSearchThreads:
+		return searchThreads;
+
 	case Message::GetTextRange:
 		if (TextRange *tr = static_cast<TextRange *>(PtrFromSPtr(lParam))) {
 			return GetTextRange(tr->lpstrText, tr->chrg.cpMin, tr->chrg.cpMax);
@@ -6800,6 +6869,19 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 		pdoc->ChangeLastUndoActionText(wParam, CharPtrFromSPtr(lParam));
 		break;
 
+	case Message::SetUndoMemoryLimit:
+		pdoc->SetUndoMemoryLimit(wParam);
+		break;
+
+	case Message::GetUndoMemoryLimit:
+		return pdoc->UndoMemoryLimit();
+
+	case Message::GetUndoMemory:
+		return pdoc->UndoMemory();
+
+	case Message::GetUndoSpillFailed:
+		return pdoc->UndoSpillFailed();
+
 	case Message::GetCaretPeriod:
 		return caret.period;
 
@@ -7679,6 +7761,16 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 	case Message::GetMargins:
 		return vs.ms.size();
 
+	case Message::SetLineNumberOffset:
+		if (vs.lineNumberOffset != LineFromUPtr(wParam)) {
+			vs.lineNumberOffset = LineFromUPtr(wParam);
+			Redraw();
+		}
+		break;
+
+	case Message::GetLineNumberOffset:
+		return vs.lineNumberOffset;
+
 	case Message::StyleClearAll:
 		vs.ClearStyles();
 		InvalidateStyleRedraw();
@@ -8470,6 +8562,27 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 			return reinterpret_cast<sptr_t>(loader);
 		}
 
+	case Message::CreateSearchLoader: {
+			// Only the text is copied so styles aren't kept
+			const DocumentOption options = DocumentOption::StylesNone |
+				(pdoc->IsLarge() ? DocumentOption::TextLarge : DocumentOption::Default);
+			Document *doc = new Document(options);
+			doc->AddRef();
+			doc->Allocate(PositionFromUPtr(wParam));
+			doc->SetUndoCollection(false);
+			doc->SetDBCSCodePage(pdoc->dbcsCodePage);
+			doc->SetLineEndTypesAllowed(pdoc->GetLineEndTypesAllowed());
+			for (const CharacterClass characterClass : { CharacterClass::space, CharacterClass::newLine,
+				CharacterClass::word, CharacterClass::punctuation }) {
+				unsigned char chars[256 + 1] {};
+				pdoc->GetCharsOfClass(characterClass, chars);
+				doc->SetCharClasses(chars, characterClass);
+			}
+			doc->SetCaseFolder(CaseFolderForEncoding());
+			ILoader *loader = doc;
+			return reinterpret_cast<sptr_t>(loader);
+		}
+
 	case Message::SetModEventMask:
 		modEventMask = static_cast<ModificationFlags>(wParam);
 		return 0;
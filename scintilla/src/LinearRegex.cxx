@@ -0,0 +1,1145 @@
+// Scintilla source code edit control
+/** @file LinearRegex.cxx
+ ** Regular expression search that takes time linear in the length of the text.
+ **/
+// The License.txt file describes the conditions under which this software may be distributed.
+
+// The method is that of Thompson and Pike as described by Russ Cox in
+// "Regular Expression Matching: the Virtual Machine Approach".
+// The pattern is parsed into a tree which is compiled into a program of instructions.
+// Every thread of the program steps over each character together and threads that reach
+// the same instruction are merged, keeping the one that would have been tried first by a
+// backtracking engine, so matches and groups are the same as leftmost-first backtracking.
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <cstring>
+#include <cctype>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <map>
+#include <optional>
+#include <algorithm>
+#include <memory>
+
+#include "ScintillaTypes.h"
+
+#include "Debugging.h"
+
+#include "Position.h"
+#include "SplitVector.h"
+#include "Partitioning.h"
+#include "RunStyles.h"
+#include "SparseVector.h"
+#include "ChangeHistory.h"
+#include "CellBuffer.h"
+#include "CaseConvert.h"
+#include "UniConversion.h"
+#include "LiteralSearch.h"
+#include "LinearRegex.h"
+
+using namespace Scintilla;
+using namespace Scintilla::Internal;
+
+namespace {
+
+// Limits that keep compiling bounded. Searching is then bounded by the program size.
+constexpr size_t maxInstructions = 100000;
+constexpr int maxNesting = 200;
+constexpr int maxRepeat = 1000;
+constexpr int maxGroups = 1000;
+// Case variants are added for each character of ranges up to this size
+constexpr int maxCaseRange = 0x3000;
+
+enum class Op : unsigned char { character, set, anyButLineEnd, split, jump, save, assertion, match };
+
+enum class Assertion : unsigned char { lineStart, lineEnd, wordBoundary, notWordBoundary, wordStart, wordEnd };
+
+struct Instruction {
+	Op op;
+	int x;	// Character, set index, slot, assertion or first choice of split and target of jump
+	int y;	// Second choice of split
+};
+
+enum ClassFlags {
+	classDigit = 1, classNotDigit = 2, classWord = 4, classNotWord = 8, classSpace = 16, classNotSpace = 32
+};
+
+constexpr bool IsDigit(int ch) noexcept {
+	return ch >= '0' && ch <= '9';
+}
+
+bool IsSpace(int ch, bool unicode) noexcept {
+	if ((ch == ' ') || (ch >= '\t' && ch <= '\r')) {
+		return true;
+	}
+	if (!unicode || ch < 0x80) {
+		return false;
+	}
+	return ch == 0xA0 || ch == 0x1680 || (ch >= 0x2000 && ch <= 0x200A) || ch == 0x2028 || ch == 0x2029 ||
+		ch == 0x202F || ch == 0x205F || ch == 0x3000 || ch == 0xFEFF;
+}
+
+struct CharacterRanges {
+	std::vector<std::pair<int, int>> ranges;	// Sorted, separate and inclusive
+	int classes = 0;
+	bool negated = false;
+
+	void Add(int first, int last) {
+		ranges.emplace_back(first, last);
+	}
+	void Normalize() {
+		std::sort(ranges.begin(), ranges.end());
+		std::vector<std::pair<int, int>> merged;
+		for (const std::pair<int, int> &range : ranges) {
+			if (!merged.empty() && range.first <= merged.back().second + 1) {
+				merged.back().second = std::max(merged.back().second, range.second);
+			} else {
+				merged.push_back(range);
+			}
+		}
+		ranges = std::move(merged);
+	}
+	[[nodiscard]] bool Contains(int ch, const LinearRegexText &text) const noexcept {
+		bool in = false;
+		if (ch >= 0) {
+			const auto it = std::upper_bound(ranges.begin(), ranges.end(), ch,
+				[](int value, const std::pair<int, int> &range) noexcept { return value < range.first; });
+			in = (it != ranges.begin()) && (ch <= std::prev(it)->second);
+		}
+		if (!in && classes) {
+			// Bytes of invalid UTF-8 are negative and are not digits, word characters or spaces
+			const bool valid = ch >= 0;
+			const bool unicode = text.codePage == CpUtf8;
+			in = ((classes & classDigit) && IsDigit(ch)) ||
+				((classes & classNotDigit) && !IsDigit(ch)) ||
+				((classes & classWord) && valid && text.IsWordCharacter(ch)) ||
+				((classes & classNotWord) && !(valid && text.IsWordCharacter(ch))) ||
+				((classes & classSpace) && IsSpace(ch, unicode)) ||
+				((classes & classNotSpace) && !IsSpace(ch, unicode));
+		}
+		return in != negated;
+	}
+};
+
+struct Decoded {
+	int ch;
+	int width;
+};
+
+// Character at position of text. Bytes that do not start a valid UTF-8 character are
+// returned as their negated value.
+Decoded DecodeAt(const LinearRegexText &text, Sci::Position position) noexcept {
+	const unsigned char lead = text.view.CharAt(position);
+	if (lead < 0x80) {
+		return { lead, 1 };
+	}
+	const Sci::Position length = text.view.length;
+	if (text.codePage == CpUtf8) {
+		unsigned char bytes[UTF8MaxBytes] { lead };
+		const int widthLead = UTF8BytesOfLead[lead];
+		for (int b = 1; b < widthLead && position + b < length; b++) {
+			bytes[b] = text.view.CharAt(position + b);
+		}
+		const int utf8status = UTF8Classify(bytes, std::min<Sci::Position>(widthLead, length - position));
+		if (utf8status & UTF8MaskInvalid) {
+			return { -static_cast<int>(lead), 1 };
+		}
+		const int width = utf8status & UTF8MaskWidth;
+		return { UnicodeFromUTF8(bytes), width };
+	}
+	if (text.codePage && (position + 1 < length) && text.IsDBCSLeadByte(lead)) {
+		return { (lead << 8) | static_cast<unsigned char>(text.view.CharAt(position + 1)), 2 };
+	}
+	return { lead, 1 };
+}
+
+// The character that ends just before position
+int CharacterBefore(const LinearRegexText &text, Sci::Position position) noexcept {
+	if (position <= 0) {
+		return -1;
+	}
+	Sci::Position start = position - 1;
+	if (text.codePage == CpUtf8) {
+		while ((start > 0) && (position - start < UTF8MaxBytes) &&
+			UTF8IsTrailByte(static_cast<unsigned char>(text.view.CharAt(start)))) {
+			start--;
+		}
+		const Decoded decoded = DecodeAt(text, start);
+		if (start + decoded.width == position) {
+			return decoded.ch;
+		}
+		return -static_cast<int>(static_cast<unsigned char>(text.view.CharAt(position - 1)));
+	}
+	if (text.codePage && (start > 0) && text.IsDBCSLeadByte(text.view.CharAt(start - 1))) {
+		start--;
+	}
+	return DecodeAt(text, start).ch;
+}
+
+bool IsWordAt(const LinearRegexText &text, int ch) noexcept {
+	return ch >= 0 && text.IsWordCharacter(ch);
+}
+
+bool AssertionHolds(Assertion assertion, const LinearRegexText &text, Sci::Position position) noexcept {
+	const SplitView &view = text.view;
+	const Sci::Position length = view.length;
+	switch (assertion) {
+	case Assertion::lineStart: {
+		if (position == 0) {
+			return true;
+		}
+		const char chPrev = view.CharAt(position - 1);
+		return (chPrev == '\n') || ((chPrev == '\r') && (position == length || view.CharAt(position) != '\n'));
+	}
+	case Assertion::lineEnd: {
+		if (position == length) {
+			return true;
+		}
+		const char ch = view.CharAt(position);
+		return (ch == '\r') || ((ch == '\n') && (position == 0 || view.CharAt(position - 1) != '\r'));
+	}
+	default:
+		break;
+	}
+	const bool wordBefore = IsWordAt(text, CharacterBefore(text, position));
+	const bool wordAfter = (position < length) && IsWordAt(text, DecodeAt(text, position).ch);
+	switch (assertion) {
+	case Assertion::wordBoundary:
+		return wordBefore != wordAfter;
+	case Assertion::notWordBoundary:
+		return wordBefore == wordAfter;
+	case Assertion::wordStart:
+		return !wordBefore && wordAfter;
+	case Assertion::wordEnd:
+		return wordBefore && !wordAfter;
+	default:
+		return false;
+	}
+}
+
+// Single character of a case conversion or -1
+int SingleCharacter(const char *converted) noexcept {
+	if (!converted || !*converted) {
+		return -1;
+	}
+	const size_t length = strlen(converted);
+	const int width = UTF8Classify(converted, length) & UTF8MaskWidth;
+	if (static_cast<size_t>(width) != length) {
+		return -1;
+	}
+	return UnicodeFromUTF8(reinterpret_cast<const unsigned char *>(converted));
+}
+
+// Sets of characters that are the same ignoring case, like k, K and KELVIN SIGN
+class CaseClasses {
+	std::map<int, int> parent;
+	std::map<int, std::vector<int>> members;
+	int Root(int ch) {
+		auto it = parent.find(ch);
+		while (it != parent.end() && it->second != ch) {
+			ch = it->second;
+			it = parent.find(ch);
+		}
+		return ch;
+	}
+	void Join(int a, int b) {
+		parent.try_emplace(a, a);
+		parent.try_emplace(b, b);
+		const int rootA = Root(a);
+		const int rootB = Root(b);
+		if (rootA != rootB) {
+			parent[std::max(rootA, rootB)] = std::min(rootA, rootB);
+		}
+	}
+public:
+	CaseClasses() {
+		constexpr int lastCased = 0x1FFFF;
+		for (int ch = 0; ch <= lastCased; ch++) {
+			for (const CaseConversion conversion : { CaseConversion::fold, CaseConversion::lower, CaseConversion::upper }) {
+				const int other = SingleCharacter(CaseConvert(ch, conversion));
+				if (other >= 0 && other != ch) {
+					Join(ch, other);
+				}
+			}
+		}
+		for (const std::pair<const int, int> &entry : parent) {
+			members[Root(entry.first)].push_back(entry.first);
+		}
+		for (std::pair<const int, int> &entry : parent) {
+			entry.second = Root(entry.first);
+		}
+	}
+	// Characters equal to ch ignoring case, including ch
+	void Variants(int ch, std::vector<int> &variants) const {
+		const auto it = parent.find(ch);
+		if (it == parent.end()) {
+			variants.push_back(ch);
+			return;
+		}
+		const std::vector<int> &same = members.at(it->second);
+		variants.insert(variants.end(), same.begin(), same.end());
+	}
+};
+
+const CaseClasses &UnicodeCaseClasses() {
+	static const CaseClasses caseClasses;
+	return caseClasses;
+}
+
+void CaseVariants(int ch, bool unicode, std::vector<int> &variants) {
+	if (unicode && ch >= 0x80) {
+		UnicodeCaseClasses().Variants(ch, variants);
+	} else if (unicode && (ch == 'k' || ch == 'K' || ch == 's' || ch == 'S')) {
+		// KELVIN SIGN and LATIN SMALL LETTER LONG S fold to ASCII
+		UnicodeCaseClasses().Variants(ch, variants);
+	} else {
+		variants.push_back(ch);
+		if (ch >= 'a' && ch <= 'z') {
+			variants.push_back(ch - 'a' + 'A');
+		} else if (ch >= 'A' && ch <= 'Z') {
+			variants.push_back(ch - 'A' + 'a');
+		}
+	}
+}
+
+struct SyntaxError {
+	const char *message;
+};
+
+struct Node {
+	enum class Kind { empty, character, set, anyButLineEnd, concatenation, alternation, repetition, group, assertion };
+	Kind kind = Kind::empty;
+	int value = 0;		// Character, set index, group number (-1 when not capturing) or assertion
+	int literal = -1;	// Character of the pattern for a character or the set of its case variants
+	int minimum = 0;
+	int maximum = 0;	// -1 when unbounded
+	bool greedy = true;
+	std::vector<Node> children;
+};
+
+class Parser {
+	std::string_view pattern;
+	size_t pos = 0;
+	bool caseSensitive;
+	const LinearRegexText &text;
+	std::vector<CharacterRanges> &sets;
+	int depth = 0;
+public:
+	int groups = 0;
+
+	Parser(std::string_view pattern_, bool caseSensitive_, const LinearRegexText &text_, std::vector<CharacterRanges> &sets_) noexcept :
+		pattern(pattern_), caseSensitive(caseSensitive_), text(text_), sets(sets_) {
+	}
+
+	Node Parse() {
+		Node root = ParseAlternation();
+		if (pos < pattern.length()) {
+			throw SyntaxError { "Unmatched )" };
+		}
+		return root;
+	}
+
+private:
+	[[nodiscard]] bool AtEnd() const noexcept {
+		return pos >= pattern.length();
+	}
+	[[nodiscard]] char Peek(size_t offset = 0) const noexcept {
+		return (pos + offset < pattern.length()) ? pattern[pos + offset] : '\0';
+	}
+
+	// Next character of the pattern decoded the same way as the text
+	int NextCharacter() {
+		const unsigned char lead = pattern[pos];
+		if (lead >= 0x80) {
+			if (text.codePage == CpUtf8) {
+				const int utf8status = UTF8Classify(pattern.substr(pos));
+				if (!(utf8status & UTF8MaskInvalid)) {
+					const int width = utf8status & UTF8MaskWidth;
+					const int ch = UnicodeFromUTF8(pattern.substr(pos, width));
+					pos += width;
+					return ch;
+				}
+				pos++;
+				return -static_cast<int>(lead);
+			}
+			if (text.codePage && (pos + 1 < pattern.length()) && text.IsDBCSLeadByte(lead)) {
+				const int ch = (lead << 8) | static_cast<unsigned char>(pattern[pos + 1]);
+				pos += 2;
+				return ch;
+			}
+		}
+		pos++;
+		return lead;
+	}
+
+	int HexDigits(size_t minimum, size_t maximum) {
+		int value = 0;
+		size_t digits = 0;
+		while (digits < maximum && std::isxdigit(static_cast<unsigned char>(Peek()))) {
+			const char ch = pattern[pos++];
+			value = value * 16 + (IsDigit(ch) ? ch - '0' : (ch | 0x20) - 'a' + 10);
+			if (value > 0x10FFFF) {
+				throw SyntaxError { "Character value too large" };
+			}
+			digits++;
+		}
+		if (digits < minimum) {
+			throw SyntaxError { "Invalid hexadecimal escape" };
+		}
+		return value;
+	}
+
+	// Character after '\' that stands for a single character, pos is after the '\'
+	int EscapedCharacter() {
+		if (AtEnd()) {
+			throw SyntaxError { "Trailing \\" };
+		}
+		const char ch = pattern[pos];
+		switch (ch) {
+		case 'n': pos++; return '\n';
+		case 'r': pos++; return '\r';
+		case 't': pos++; return '\t';
+		case 'f': pos++; return '\f';
+		case 'v': pos++; return '\v';
+		case 'a': pos++; return '\a';
+		case 'e': pos++; return 0x1B;
+		case '0': pos++; return 0;
+		case 'x':
+			pos++;
+			if (Peek() == '{') {
+				pos++;
+				const int value = HexDigits(1, 8);
+				if (Peek() != '}') {
+					throw SyntaxError { "Invalid hexadecimal escape" };
+				}
+				pos++;
+				return value;
+			}
+			return HexDigits(2, 2);
+		case 'u':
+			pos++;
+			return HexDigits(4, 4);
+		default:
+			if (IsDigit(ch)) {
+				throw SyntaxError { "Back references are not supported" };
+			}
+			return NextCharacter();
+		}
+	}
+
+	// Flag for \d \D \w \W \s \S or 0, pos is after the '\'
+	int EscapedClass() noexcept {
+		switch (Peek()) {
+		case 'd': return classDigit;
+		case 'D': return classNotDigit;
+		case 'w': return classWord;
+		case 'W': return classNotWord;
+		case 's': return classSpace;
+		case 'S': return classNotSpace;
+		default: return 0;
+		}
+	}
+
+	Node SetNode(CharacterRanges &&set, int literal = -1) {
+		Node node;
+		node.kind = Node::Kind::set;
+		node.value = static_cast<int>(sets.size());
+		node.literal = literal;
+		sets.push_back(std::move(set));
+		return node;
+	}
+
+	Node CharacterNode(int ch) {
+		if (!caseSensitive) {
+			std::vector<int> variants;
+			CaseVariants(ch, text.codePage == CpUtf8, variants);
+			if (variants.size() > 1) {
+				CharacterRanges set;
+				for (const int variant : variants) {
+					set.Add(variant, variant);
+				}
+				set.Normalize();
+				return SetNode(std::move(set), ch);
+			}
+		}
+		Node node;
+		node.kind = Node::Kind::character;
+		node.value = ch;
+		node.literal = ch;
+		return node;
+	}
+
+	void AddNamedClass(std::string_view name, CharacterRanges &set) {
+		struct NamedRanges {
+			std::string_view name;
+			const char *ranges;	// Pairs of first and last characters
+		};
+		static constexpr NamedRanges named[] = {
+			{ "alnum", "09AZaz" },
+			{ "alpha", "AZaz" },
+			{ "blank", "\t\t  " },
+			{ "cntrl", "\x01\x1f\x7f\x7f" },
+			{ "digit", "09" },
+			{ "graph", "!~" },
+			{ "lower", "az" },
+			{ "print", " ~" },
+			{ "punct", "!/:@[`{~" },
+			{ "space", "\t\r  " },
+			{ "upper", "AZ" },
+			{ "word", "09AZ__az" },
+			{ "xdigit", "09AFaf" },
+		};
+		for (const NamedRanges &entry : named) {
+			if (entry.name == name) {
+				for (const char *range = entry.ranges; *range; range += 2) {
+					set.Add(static_cast<unsigned char>(range[0]), static_cast<unsigned char>(range[1]));
+				}
+				if (name == "cntrl") {
+					set.Add(0, 0);
+				}
+				return;
+			}
+		}
+		throw SyntaxError { "Unknown character class" };
+	}
+
+	// pos is after the '['
+	Node ParseSet() {
+		CharacterRanges set;
+		if (Peek() == '^') {
+			set.negated = true;
+			pos++;
+		}
+		bool first = true;
+		for (;;) {
+			if (AtEnd()) {
+				throw SyntaxError { "Missing ]" };
+			}
+			if (Peek() == ']' && !first) {
+				pos++;
+				break;
+			}
+			first = false;
+			if (Peek() == '[' && Peek(1) == ':') {
+				const size_t close = pattern.find(":]", pos + 2);
+				if (close == std::string_view::npos) {
+					throw SyntaxError { "Missing :]" };
+				}
+				AddNamedClass(pattern.substr(pos + 2, close - pos - 2), set);
+				pos = close + 2;
+				continue;
+			}
+			int low = 0;
+			if (Peek() == '\\') {
+				pos++;
+				const int flag = EscapedClass();
+				if (flag) {
+					pos++;
+					set.classes |= flag;
+					continue;
+				}
+				if (Peek() == 'b') {
+					pos++;
+					low = '\b';
+				} else {
+					low = EscapedCharacter();
+				}
+			} else {
+				low = NextCharacter();
+			}
+			int high = low;
+			if (Peek() == '-' && Peek(1) != ']' && Peek(1) != '\0') {
+				pos++;
+				if (Peek() == '\\') {
+					pos++;
+					if (EscapedClass()) {
+						throw SyntaxError { "Invalid range" };
+					}
+					high = (Peek() == 'b') ? (pos++, '\b') : EscapedCharacter();
+				} else {
+					high = NextCharacter();
+				}
+				if (high < low) {
+					throw SyntaxError { "Invalid range" };
+				}
+			}
+			set.Add(low, high);
+		}
+		if (!caseSensitive) {
+			const bool unicode = text.codePage == CpUtf8;
+			std::vector<int> variants;
+			for (const std::pair<int, int> &range : std::vector<std::pair<int, int>>(set.ranges)) {
+				if (range.second - range.first >= maxCaseRange) {
+					continue;
+				}
+				for (int ch = std::max(range.first, 0); ch <= range.second; ch++) {
+					variants.clear();
+					CaseVariants(ch, unicode, variants);
+					for (const int variant : variants) {
+						set.Add(variant, variant);
+					}
+				}
+			}
+		}
+		set.Normalize();
+		return SetNode(std::move(set));
+	}
+
+	Node ParseAtom() {
+		const char ch = Peek();
+		Node node;
+		switch (ch) {
+		case '(': {
+			pos++;
+			if (++depth > maxNesting) {
+				throw SyntaxError { "Too many nested groups" };
+			}
+			node.kind = Node::Kind::group;
+			node.value = -1;
+			if (Peek() == '?') {
+				if (Peek(1) != ':') {
+					throw SyntaxError { "Look around is not supported" };
+				}
+				pos += 2;
+			} else {
+				if (++groups > maxGroups) {
+					throw SyntaxError { "Too many groups" };
+				}
+				node.value = groups;
+			}
+			node.children.push_back(ParseAlternation());
+			if (Peek() != ')') {
+				throw SyntaxError { "Missing )" };
+			}
+			pos++;
+			depth--;
+			return node;
+		}
+		case '[':
+			pos++;
+			return ParseSet();
+		case '.':
+			pos++;
+			node.kind = Node::Kind::anyButLineEnd;
+			return node;
+		case '^':
+		case '$':
+			pos++;
+			node.kind = Node::Kind::assertion;
+			node.value = static_cast<int>((ch == '^') ? Assertion::lineStart : Assertion::lineEnd);
+			return node;
+		case '*':
+		case '+':
+		case '?':
+			throw SyntaxError { "Nothing to repeat" };
+		case '\\': {
+			pos++;
+			const int flag = EscapedClass();
+			if (flag) {
+				pos++;
+				CharacterRanges set;
+				set.classes = flag;
+				return SetNode(std::move(set));
+			}
+			Assertion assertion = Assertion::wordBoundary;
+			switch (Peek()) {
+			case 'b': assertion = Assertion::wordBoundary; break;
+			case 'B': assertion = Assertion::notWordBoundary; break;
+			case '<': assertion = Assertion::wordStart; break;
+			case '>': assertion = Assertion::wordEnd; break;
+			default:
+				return CharacterNode(EscapedCharacter());
+			}
+			pos++;
+			node.kind = Node::Kind::assertion;
+			node.value = static_cast<int>(assertion);
+			return node;
+		}
+		default:
+			return CharacterNode(NextCharacter());
+		}
+	}
+
+	// Reads {n}, {n,} or {n,m} when there is one, otherwise leaves pos unchanged
+	bool ParseCount(int &minimum, int &maximum) {
+		const size_t start = pos;
+		const auto number = [this](int &value) {
+			if (!IsDigit(Peek())) {
+				return false;
+			}
+			value = 0;
+			while (IsDigit(Peek())) {
+				value = value * 10 + (pattern[pos++] - '0');
+				if (value > maxRepeat) {
+					throw SyntaxError { "Repeat count too large" };
+				}
+			}
+			return true;
+		};
+		pos++;
+		if (number(minimum)) {
+			maximum = minimum;
+			if (Peek() == ',') {
+				pos++;
+				maximum = -1;
+				number(maximum);
+			}
+			if (Peek() == '}') {
+				pos++;
+				if (maximum >= 0 && maximum < minimum) {
+					throw SyntaxError { "Invalid repeat count" };
+				}
+				return true;
+			}
+		}
+		// Not a count so '{' is matched literally
+		pos = start;
+		return false;
+	}
+
+	Node ParseRepetition() {
+		Node atom = ParseAtom();
+		for (;;) {
+			int minimum = 0;
+			int maximum = -1;
+			const char ch = Peek();
+			if (ch == '*') {
+				pos++;
+			} else if (ch == '+') {
+				minimum = 1;
+				pos++;
+			} else if (ch == '?') {
+				maximum = 1;
+				pos++;
+			} else if (ch == '{' && ParseCount(minimum, maximum)) {
+				// Count read
+			} else {
+				return atom;
+			}
+			if (atom.kind == Node::Kind::assertion || atom.kind == Node::Kind::repetition) {
+				throw SyntaxError { "Nothing to repeat" };
+			}
+			Node repetition;
+			repetition.kind = Node::Kind::repetition;
+			repetition.minimum = minimum;
+			repetition.maximum = maximum;
+			if (Peek() == '?') {
+				repetition.greedy = false;
+				pos++;
+			}
+			repetition.children.push_back(std::move(atom));
+			atom = std::move(repetition);
+		}
+	}
+
+	Node ParseConcatenation() {
+		Node node;
+		node.kind = Node::Kind::concatenation;
+		while (!AtEnd() && Peek() != '|' && Peek() != ')') {
+			node.children.push_back(ParseRepetition());
+		}
+		if (node.children.size() == 1) {
+			return std::move(node.children.front());
+		}
+		return node;
+	}
+
+	Node ParseAlternation() {
+		Node first = ParseConcatenation();
+		if (Peek() != '|') {
+			return first;
+		}
+		Node node;
+		node.kind = Node::Kind::alternation;
+		node.children.push_back(std::move(first));
+		while (Peek() == '|') {
+			pos++;
+			node.children.push_back(ParseConcatenation());
+		}
+		return node;
+	}
+};
+
+}
+
+struct LinearRegex::Program {
+	std::vector<Instruction> instructions;
+	std::vector<CharacterRanges> sets;
+	size_t slotCount = 2;
+	// Every match starts with prefix. Folded when searching ignoring case.
+	std::string prefix;
+	bool prefixFolded = false;
+
+	// Threads waiting at instructions, in the order a backtracking engine would try them.
+	// Sparse set so membership and clearing take constant time.
+	struct ThreadList {
+		std::vector<int> pcs;
+		std::vector<int> indices;
+		int count = 0;
+		std::vector<Sci::Position> slots;	// slotCount for each instruction
+		void Allocate(size_t instructionCount, size_t slotCount) {
+			pcs.assign(instructionCount, 0);
+			indices.assign(instructionCount, 0);
+			slots.assign(instructionCount * slotCount, -1);
+			count = 0;
+		}
+		[[nodiscard]] bool Contains(int pc) const noexcept {
+			const int index = indices[pc];
+			return index < count && pcs[index] == pc;
+		}
+		void Insert(int pc) noexcept {
+			indices[pc] = count;
+			pcs[count++] = pc;
+		}
+	};
+	ThreadList current;
+	ThreadList next;
+	std::vector<Sci::Position> working;
+	std::vector<Sci::Position> matched;
+	// Instructions still to follow and slots to restore once a choice has been followed
+	struct Pending {
+		int pc;
+		int slot;	// Restore working[slot] to position instead of following pc when >= 0
+		Sci::Position position;
+	};
+	std::vector<Pending> pending;
+
+	void Emit(Op op, int x = 0, int y = 0) {
+		if (instructions.size() >= maxInstructions) {
+			throw SyntaxError { "Regular expression too large" };
+		}
+		instructions.push_back({ op, x, y });
+	}
+	[[nodiscard]] int Here() const noexcept {
+		return static_cast<int>(instructions.size());
+	}
+
+	void Generate(const Node &node) {
+		switch (node.kind) {
+		case Node::Kind::empty:
+			break;
+		case Node::Kind::character:
+			Emit(Op::character, node.value);
+			break;
+		case Node::Kind::set:
+			Emit(Op::set, node.value);
+			break;
+		case Node::Kind::anyButLineEnd:
+			Emit(Op::anyButLineEnd);
+			break;
+		case Node::Kind::assertion:
+			Emit(Op::assertion, node.value);
+			break;
+		case Node::Kind::concatenation:
+			for (const Node &child : node.children) {
+				Generate(child);
+			}
+			break;
+		case Node::Kind::group:
+			if (node.value >= 0) {
+				Emit(Op::save, node.value * 2);
+			}
+			Generate(node.children.front());
+			if (node.value >= 0) {
+				Emit(Op::save, node.value * 2 + 1);
+			}
+			break;
+		case Node::Kind::alternation: {
+			std::vector<int> jumps;
+			for (size_t branch = 0; branch < node.children.size(); branch++) {
+				const bool lastBranch = branch + 1 == node.children.size();
+				const int split = Here();
+				if (!lastBranch) {
+					Emit(Op::split, split + 1);
+				}
+				Generate(node.children[branch]);
+				if (!lastBranch) {
+					jumps.push_back(Here());
+					Emit(Op::jump);
+					instructions[split].y = Here();
+				}
+			}
+			for (const int jump : jumps) {
+				instructions[jump].x = Here();
+			}
+			break;
+		}
+		case Node::Kind::repetition: {
+			const Node &child = node.children.front();
+			for (int i = 0; i < node.minimum; i++) {
+				Generate(child);
+			}
+			if (node.maximum < 0) {
+				// Loop: choose between another repeat and continuing
+				const int split = Here();
+				Emit(Op::split);
+				Generate(child);
+				Emit(Op::jump, split);
+				SetChoices(split, split + 1, Here(), node.greedy);
+			} else {
+				std::vector<int> splits;
+				for (int i = node.minimum; i < node.maximum; i++) {
+					splits.push_back(Here());
+					Emit(Op::split);
+					Generate(child);
+				}
+				for (const int split : splits) {
+					SetChoices(split, split + 1, Here(), node.greedy);
+				}
+			}
+			break;
+		}
+		}
+	}
+
+	void SetChoices(int split, int repeat, int skip, bool greedy) noexcept {
+		instructions[split].x = greedy ? repeat : skip;
+		instructions[split].y = greedy ? skip : repeat;
+	}
+
+	// Literal characters every match starts with that can be looked for quickly
+	void FindPrefix(const Node &root, bool caseSensitive, int codePage) {
+		prefix.clear();
+		prefixFolded = !caseSensitive;
+		if (codePage && codePage != CpUtf8) {
+			// Trail bytes of DBCS may look like the prefix so the search can not skip
+			return;
+		}
+		const bool sequence = root.kind == Node::Kind::concatenation;
+		const size_t count = sequence ? root.children.size() : 1;
+		for (size_t i = 0; i < count; i++) {
+			const Node &node = sequence ? root.children[i] : root;
+			if (node.literal < 0 || (node.kind != Node::Kind::character && node.kind != Node::Kind::set)) {
+				break;
+			}
+			const int ch = node.literal;
+			if (caseSensitive) {
+				if (codePage == CpUtf8 && ch >= 0x80) {
+					char bytes[UTF8MaxBytes + 1] {};
+					UTF8FromUTF32Character(ch, bytes);
+					prefix.append(bytes);
+				} else if (ch <= 0xFF) {
+					prefix.push_back(static_cast<char>(ch));
+				} else {
+					break;
+				}
+			} else {
+				// Only ASCII folds predictably, anything else stops the search for candidates
+				if (ch >= 0x80) {
+					break;
+				}
+				prefix.push_back(static_cast<char>((ch >= 'A' && ch <= 'Z') ? ch - 'A' + 'a' : ch));
+			}
+		}
+		if (codePage == CpUtf8 && !prefix.empty() && UTF8IsTrailByte(static_cast<unsigned char>(prefix[0]))) {
+			// An invalid byte of the pattern could match inside a character
+			prefix.clear();
+		}
+	}
+
+	// Adds the thread at pc and every thread it leads to without consuming a character
+	void AddThread(ThreadList &list, int pcStart, Sci::Position position, const LinearRegexText &text) {
+		pending.push_back({ pcStart, -1, 0 });
+		while (!pending.empty()) {
+			const Pending entry = pending.back();
+			pending.pop_back();
+			if (entry.slot >= 0) {
+				working[entry.slot] = entry.position;
+				continue;
+			}
+			int pc = entry.pc;
+			while (!list.Contains(pc)) {
+				list.Insert(pc);
+				const Instruction &instruction = instructions[pc];
+				if (instruction.op == Op::jump) {
+					pc = instruction.x;
+				} else if (instruction.op == Op::split) {
+					pending.push_back({ instruction.y, -1, 0 });
+					pc = instruction.x;
+				} else if (instruction.op == Op::save) {
+					if (static_cast<size_t>(instruction.x) < slotCount) {
+						pending.push_back({ 0, instruction.x, working[instruction.x] });
+						working[instruction.x] = position;
+					}
+					pc++;
+				} else if (instruction.op == Op::assertion) {
+					if (!AssertionHolds(static_cast<Assertion>(instruction.x), text, position)) {
+						break;
+					}
+					pc++;
+				} else {
+					std::copy(working.begin(), working.end(), list.slots.begin() + pc * slotCount);
+					break;
+				}
+			}
+		}
+	}
+
+	bool Run(const LinearRegexText &text, Sci::Position start, Sci::Position end) {
+		current.count = 0;
+		bool found = false;
+		Sci::Position position = start;
+		for (;;) {
+			if (!found) {
+				if ((current.count == 0) && !prefix.empty()) {
+					// No match in progress so skip to where the next one could start
+					const ptrdiff_t candidate = prefixFolded ?
+						SplitFindFoldedCandidate(text.view, static_cast<size_t>(position), static_cast<size_t>(end), prefix) :
+						SplitFindLiteral(text.view, static_cast<size_t>(position), static_cast<size_t>(end), prefix);
+					if (candidate < 0) {
+						break;
+					}
+					position = candidate;
+				}
+				std::fill(working.begin(), working.end(), -1);
+				AddThread(current, 0, position, text);
+			}
+			if (current.count == 0) {
+				break;
+			}
+			Decoded decoded { -1, 0 };
+			bool consume = position < end;
+			if (consume) {
+				decoded = DecodeAt(text, position);
+				consume = position + decoded.width <= end;
+			}
+			next.count = 0;
+			for (int i = 0; i < current.count; i++) {
+				const int pc = current.pcs[i];
+				const Instruction &instruction = instructions[pc];
+				const auto threadSlots = current.slots.begin() + pc * slotCount;
+				if (instruction.op == Op::match) {
+					// Threads after this would give lower priority matches so are dropped
+					std::copy(threadSlots, threadSlots + slotCount, matched.begin());
+					found = true;
+					break;
+				}
+				if (!consume) {
+					continue;
+				}
+				bool matches = false;
+				switch (instruction.op) {
+				case Op::character:
+					matches = decoded.ch == instruction.x;
+					break;
+				case Op::set:
+					matches = sets[instruction.x].Contains(decoded.ch, text);
+					break;
+				case Op::anyButLineEnd:
+					matches = (decoded.ch != '\r') && (decoded.ch != '\n');
+					break;
+				default:
+					break;
+				}
+				if (matches) {
+					std::copy(threadSlots, threadSlots + slotCount, working.begin());
+					AddThread(next, pc + 1, position + decoded.width, text);
+				}
+			}
+			if (!consume) {
+				break;
+			}
+			std::swap(current, next);
+			position += decoded.width;
+		}
+		return found;
+	}
+};
+
+LinearRegex::LinearRegex() = default;
+
+LinearRegex::~LinearRegex() = default;
+
+const char *LinearRegex::Compile(std::string_view pattern, bool caseSensitive, const LinearRegexText &text) {
+	if (program && (pattern == compiledPattern) && (caseSensitive == compiledCaseSensitive) &&
+		(text.codePage == compiledCodePage)) {
+		return nullptr;
+	}
+	program.reset();
+	try {
+		std::unique_ptr<Program> compiling = std::make_unique<Program>();
+		Parser parser(pattern, caseSensitive, text, compiling->sets);
+		const Node root = parser.Parse();
+		compiling->slotCount = std::min(parser.groups + 1, MAXTAG) * 2;
+		compiling->Emit(Op::save, 0);
+		compiling->Generate(root);
+		compiling->Emit(Op::save, 1);
+		compiling->Emit(Op::match);
+		compiling->FindPrefix(root, caseSensitive, text.codePage);
+		const size_t instructionCount = compiling->instructions.size();
+		compiling->current.Allocate(instructionCount, compiling->slotCount);
+		compiling->next.Allocate(instructionCount, compiling->slotCount);
+		compiling->working.assign(compiling->slotCount, -1);
+		compiling->matched.assign(compiling->slotCount, -1);
+		program = std::move(compiling);
+	} catch (const SyntaxError &error) {
+		return error.message;
+	}
+	compiledPattern = pattern;
+	compiledCaseSensitive = caseSensitive;
+	compiledCodePage = text.codePage;
+	return nullptr;
+}
+
+bool LinearRegex::CanMatchLineEnd(const LinearRegexText &text) const noexcept {
+	if (!program) {
+		return true;
+	}
+	for (const Instruction &instruction : program->instructions) {
+		if (instruction.op == Op::character) {
+			if ((instruction.x == '\r') || (instruction.x == '\n')) {
+				return true;
+			}
+		} else if (instruction.op == Op::set) {
+			const CharacterRanges &set = program->sets[instruction.x];
+			if (set.Contains('\r', text) || set.Contains('\n', text)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool LinearRegex::Search(const LinearRegexText &text, Sci::Position start, Sci::Position end, bool last) {
+	bopat.fill(-1);
+	eopat.fill(-1);
+	if (!program) {
+		return false;
+	}
+	end = std::min<Sci::Position>(end, text.view.length);
+	bool found = false;
+	std::vector<Sci::Position> lastMatch;
+	while (start <= end && program->Run(text, start, end)) {
+		found = true;
+		if (!last) {
+			break;
+		}
+		lastMatch = program->matched;
+		const Sci::Position matchStart = program->matched[0];
+		const Sci::Position matchEnd = program->matched[1];
+		if (matchEnd > matchStart) {
+			start = matchEnd;
+		} else if (matchEnd < end) {
+			// Step over a character after an empty match so it is not found again
+			start = matchEnd + DecodeAt(text, matchEnd).width;
+		} else {
+			break;
+		}
+	}
+	if (found) {
+		const std::vector<Sci::Position> &slots = last ? lastMatch : program->matched;
+		for (size_t tag = 0; tag * 2 < slots.size(); tag++) {
+			if (slots[tag * 2] >= 0 && slots[tag * 2 + 1] >= 0) {
+				bopat[tag] = slots[tag * 2];
+				eopat[tag] = slots[tag * 2 + 1];
+			}
+		}
+	}
+	return found;
+}
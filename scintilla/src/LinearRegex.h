@@ -0,0 +1,73 @@
+// Scintilla source code edit control
+/** @file LinearRegex.h
+ ** Regular expression search that takes time linear in the length of the text.
+ **/
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#ifndef LINEARREGEX_H
+#define LINEARREGEX_H
+
+namespace Scintilla::Internal {
+
+// The text searched: the bytes of a document and what the engine needs to know about them
+class LinearRegexText {
+public:
+	SplitView view;
+	int codePage = 0;
+	LinearRegexText(const SplitView &view_, int codePage_) noexcept : view(view_), codePage(codePage_) {
+	}
+	virtual ~LinearRegexText() = default;
+	[[nodiscard]] virtual bool IsDBCSLeadByte(char ch) const noexcept = 0;
+	// ch is a character decoded from the text: a byte, a DBCS pair or a Unicode code point
+	[[nodiscard]] virtual bool IsWordCharacter(int ch) const noexcept = 0;
+};
+
+// Compiles a regular expression into a program for a Pike virtual machine which runs every
+// possible match together in one pass over the text without backtracking, so searches take
+// time proportional to the length of the text times the length of the program.
+// The syntax is a subset of ECMAScript without back references or look around:
+// . [] [^] [[:alpha:]] \d \D \w \W \s \S \b \B \< \> ^ $ | () (?:) * + ? {n} {n,} {n,m}
+// with lazy quantifiers and \n \r \t \f \v \a \e \0 \xHH \x{H...} \uHHHH escapes.
+// ^ and $ match at the start and end of every line with CR, LF and CR+LF as line ends
+// so a match may continue over several lines. . does not match CR or LF.
+// UTF-8 text is matched by Unicode character and the bytes of an invalid sequence only
+// match . and negated sets.
+class LinearRegex {
+public:
+	static constexpr int MAXTAG = 10;
+	using MatchPositions = std::array<Sci::Position, MAXTAG>;
+	MatchPositions bopat {};
+	MatchPositions eopat {};
+
+	LinearRegex();
+	// Deleted so LinearRegex objects can not be copied.
+	LinearRegex(const LinearRegex &) = delete;
+	LinearRegex(LinearRegex &&) = delete;
+	LinearRegex &operator=(const LinearRegex &) = delete;
+	LinearRegex &operator=(LinearRegex &&) = delete;
+	~LinearRegex();
+
+	// Returns nullptr once compiled or a description of what is wrong with pattern.
+	// Compiling the pattern last compiled with the same options does nothing.
+	const char *Compile(std::string_view pattern, bool caseSensitive, const LinearRegexText &text);
+
+	// Finds the first match starting at or after start that ends at or before end or, with
+	// last, the last of the matches found one after another from start.
+	// Groups that did not take part in the match have positions of -1.
+	bool Search(const LinearRegexText &text, Sci::Position start, Sci::Position end, bool last);
+
+	// Whether the compiled pattern can match CR or LF, so a match may continue over lines.
+	// True when nothing is compiled.
+	[[nodiscard]] bool CanMatchLineEnd(const LinearRegexText &text) const noexcept;
+
+private:
+	struct Program;
+	std::unique_ptr<Program> program;
+	std::string compiledPattern;
+	bool compiledCaseSensitive = false;
+	int compiledCodePage = -1;
+};
+
+}
+
+#endif
@@ -0,0 +1,277 @@
+// Scintilla source code edit control
+/** @file LiteralSearch.cxx
+ ** Search for literal text in the split view of a document.
+ **/
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <cstring>
+
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <memory>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define LITERAL_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#include "ScintillaTypes.h"
+
+#include "Debugging.h"
+
+#include "Position.h"
+#include "SplitVector.h"
+#include "Partitioning.h"
+#include "RunStyles.h"
+#include "SparseVector.h"
+#include "ChangeHistory.h"
+#include "CellBuffer.h"
+#include "CharacterType.h"
+#include "CaseFolder.h"
+#include "UniConversion.h"
+#include "LiteralSearch.h"
+
+using namespace Scintilla::Internal;
+
+namespace {
+
+// The kernels work on one contiguous segment. text is indexed by view position so
+// segment2 can be passed with positions after length1.
+
+#if defined(LITERAL_SSE2)
+
+unsigned int CountTrailingZeros(unsigned int mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index = 0;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+#endif
+
+// Match starting in [pos, stop - needle.length()] of text
+ptrdiff_t FindInSegment(const char *text, size_t pos, size_t stop, std::string_view needle) noexcept {
+	const size_t lengthNeedle = needle.length();
+	if ((stop < pos) || (stop - pos < lengthNeedle)) {
+		return -1;
+	}
+	const size_t limit = stop - lengthNeedle + 1;
+	if (lengthNeedle == 1) {
+		const char *match = static_cast<const char *>(memchr(text + pos, needle[0], limit - pos));
+		return match ? match - text : -1;
+	}
+	const char first = needle.front();
+	const char last = needle.back();
+	const size_t lastOffset = lengthNeedle - 1;
+#if defined(LITERAL_SSE2)
+	// The load of the last bytes of the final block ends at stop
+	const __m128i firsts = _mm_set1_epi8(first);
+	const __m128i lasts = _mm_set1_epi8(last);
+	const auto anchors = [&](size_t offset) noexcept {
+		const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + offset));
+		const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + offset + lastOffset));
+		return static_cast<unsigned int>(_mm_movemask_epi8(
+			_mm_and_si128(_mm_cmpeq_epi8(blockFirst, firsts), _mm_cmpeq_epi8(blockLast, lasts))));
+	};
+	while (limit - pos >= 32) {
+		// Two blocks at a time as most blocks have no candidates
+		unsigned int mask = anchors(pos) | (anchors(pos + 16) << 16);
+		while (mask) {
+			const size_t candidate = pos + CountTrailingZeros(mask);
+			if (memcmp(text + candidate + 1, needle.data() + 1, lengthNeedle - 2) == 0) {
+				return candidate;
+			}
+			mask &= mask - 1;
+		}
+		pos += 32;
+	}
+#endif
+	while (pos < limit) {
+		const char *match = static_cast<const char *>(memchr(text + pos, first, limit - pos));
+		if (!match) {
+			break;
+		}
+		pos = match - text;
+		if ((text[pos + lastOffset] == last) && (memcmp(text + pos + 1, needle.data() + 1, lengthNeedle - 2) == 0)) {
+			return pos;
+		}
+		pos++;
+	}
+	return -1;
+}
+
+// The ASCII byte other than folded that folds to folded, or folded itself when there is none
+constexpr char OtherCase(char folded) noexcept {
+	return (folded >= 'a' && folded <= 'z') ? static_cast<char>(folded - 'a' + 'A') : folded;
+}
+
+constexpr bool IsHighByte(char ch) noexcept {
+	return static_cast<unsigned char>(ch) >= 0x80;
+}
+
+constexpr bool EitherCase(char ch, char folded) noexcept {
+	return ch == folded || ch == OtherCase(folded);
+}
+
+// Candidate in [pos, stop) of text. The byte after a candidate is only looked at
+// before stop. When it would be at stop, next is used if there is one.
+ptrdiff_t FindCandidateInSegment(const char *text, size_t pos, size_t stop, std::string_view folded,
+	bool hasNext, char next) noexcept {
+	const bool single = folded.length() == 1;
+#if defined(LITERAL_SSE2)
+	const __m128i lower0 = _mm_set1_epi8(folded[0]);
+	const __m128i upper0 = _mm_set1_epi8(OtherCase(folded[0]));
+	if (single) {
+		while (stop - pos >= 16) {
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + pos));
+			const __m128i matches = _mm_or_si128(_mm_cmpeq_epi8(block, lower0), _mm_cmpeq_epi8(block, upper0));
+			// The sign bit of block is set for bytes outside ASCII
+			const unsigned int mask = _mm_movemask_epi8(_mm_or_si128(matches, block));
+			if (mask) {
+				return pos + CountTrailingZeros(mask);
+			}
+			pos += 16;
+		}
+	} else {
+		const __m128i lower1 = _mm_set1_epi8(folded[1]);
+		const __m128i upper1 = _mm_set1_epi8(OtherCase(folded[1]));
+		while (stop - pos >= 17) {
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + pos));
+			const __m128i following = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + pos + 1));
+			const __m128i matches0 = _mm_or_si128(_mm_cmpeq_epi8(block, lower0), _mm_cmpeq_epi8(block, upper0));
+			const __m128i matches1 = _mm_or_si128(_mm_or_si128(
+				_mm_cmpeq_epi8(following, lower1), _mm_cmpeq_epi8(following, upper1)), following);
+			const unsigned int mask = _mm_movemask_epi8(_mm_or_si128(_mm_and_si128(matches0, matches1), block));
+			if (mask) {
+				return pos + CountTrailingZeros(mask);
+			}
+			pos += 16;
+		}
+	}
+#endif
+	for (; pos < stop; pos++) {
+		const char ch = text[pos];
+		if (IsHighByte(ch)) {
+			return pos;
+		}
+		if (EitherCase(ch, folded[0])) {
+			if (single) {
+				return pos;
+			}
+			const bool followed = (pos + 1 < stop) || hasNext;
+			const char chNext = (pos + 1 < stop) ? text[pos + 1] : next;
+			if (followed && (IsHighByte(chNext) || EitherCase(chNext, folded[1]))) {
+				return pos;
+			}
+		}
+	}
+	return -1;
+}
+
+}
+
+ptrdiff_t Scintilla::Internal::SplitFindLiteral(const SplitView &view, size_t start, size_t end, std::string_view needle) noexcept {
+	const size_t lengthNeedle = needle.length();
+	// A view of part of the text is only searched where it can be read
+	start = std::max(start, view.readStart);
+	end = std::min(end, view.ReadEnd());
+	if ((end < start) || (end - start < lengthNeedle) || (lengthNeedle == 0)) {
+		return -1;
+	}
+	if (start < view.length1) {
+		// Matches inside segment1
+		const size_t end1 = std::min(end, view.length1);
+		const ptrdiff_t match = FindInSegment(view.segment1, start, end1, needle);
+		if (match >= 0) {
+			return match;
+		}
+		// Matches that start in segment1 and finish in segment2
+		const size_t limit = end - lengthNeedle + 1;
+		size_t pos = std::max(start, (end1 >= lengthNeedle) ? end1 - lengthNeedle + 1 : 0);
+		for (; (pos < end1) && (pos < limit); pos++) {
+			size_t i = 0;
+			while ((i < lengthNeedle) && (view.CharAt(pos + i) == needle[i])) {
+				i++;
+			}
+			if (i == lengthNeedle) {
+				return pos;
+			}
+		}
+		start = end1;
+	}
+	return FindInSegment(view.segment2, start, end, needle);
+}
+
+ptrdiff_t Scintilla::Internal::SplitFindFoldedCandidate(const SplitView &view, size_t start, size_t end, std::string_view folded) noexcept {
+	start = std::max(start, view.readStart);
+	end = std::min(end, view.ReadEnd());
+	if ((end <= start) || folded.empty()) {
+		return -1;
+	}
+	if (start < view.length1) {
+		const size_t end1 = std::min(end, view.length1);
+		const bool hasNext = end1 < end;
+		const ptrdiff_t candidate = FindCandidateInSegment(view.segment1, start, end1, folded,
+			hasNext, hasNext ? view.segment2[end1] : '\0');
+		if (candidate >= 0 || !hasNext) {
+			return candidate;
+		}
+		start = end1;
+	}
+	return FindCandidateInSegment(view.segment2, start, end, folded, false, '\0');
+}
+
+size_t Scintilla::Internal::SplitMatchFoldedUTF8(const SplitView &view, size_t pos, size_t end, std::string_view folded, CaseFolder &pcf, int &widthFirstCharacter) {
+	constexpr size_t maxFoldingExpansion = 4;
+	widthFirstCharacter = 1;
+	size_t posIndexDocument = pos;
+	size_t indexSearch = 0;
+	while (indexSearch < folded.length()) {
+		const unsigned char leadByte = view.CharAt(posIndexDocument);
+		int widthChar = 1;
+		size_t lenFlat = 1;
+		if (UTF8IsAscii(leadByte)) {
+			if ((posIndexDocument + 1) > end) {
+				return 0;
+			}
+			if (folded[indexSearch] != MakeLowerCase(leadByte)) {
+				return 0;
+			}
+		} else {
+			char bytes[UTF8MaxBytes]{ static_cast<char>(leadByte) };
+			const int widthCharBytes = UTF8BytesOfLead[leadByte];
+			for (int b = 1; b < widthCharBytes; b++) {
+				bytes[b] = view.CharAt(posIndexDocument + b);
+			}
+			widthChar = UTF8Classify(bytes, widthCharBytes) & UTF8MaskWidth;
+			if (!indexSearch) {	// First character
+				widthFirstCharacter = widthChar;
+			}
+			if ((posIndexDocument + widthChar) > end) {
+				return 0;
+			}
+			char foldedChar[UTF8MaxBytes * maxFoldingExpansion + 1];
+			lenFlat = pcf.Fold(foldedChar, sizeof(foldedChar), bytes, widthChar);
+			// Does the folded character match the rest of the search
+			if ((lenFlat > folded.length() - indexSearch) ||
+				(memcmp(foldedChar, folded.data() + indexSearch, lenFlat) != 0)) {
+				return 0;
+			}
+		}
+		posIndexDocument += widthChar;
+		indexSearch += lenFlat;
+	}
+	return posIndexDocument - pos;
+}
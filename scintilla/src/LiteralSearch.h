@@ -0,0 +1,34 @@
+// Scintilla source code edit control
+/** @file LiteralSearch.h
+ ** Search for literal text in the split view of a document.
+ **/
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#ifndef LITERALSEARCH_H
+#define LITERALSEARCH_H
+
+namespace Scintilla::Internal {
+
+class CaseFolder;
+
+// Positions are into the whole view and a match has to fit between start and end.
+// The Find functions return -1 when nothing is found.
+
+// First occurrence of needle. Blocks are compared on both the first and last bytes of
+// needle so common first bytes are rejected without looking at the rest.
+ptrdiff_t SplitFindLiteral(const SplitView &view, size_t start, size_t end, std::string_view needle) noexcept;
+
+// First position where text folded by Document::FindText may match folded, a search already
+// case folded. ASCII bytes only match an ASCII byte of folded in either case so those are
+// checked here for the first two bytes of folded. Any byte outside ASCII is a candidate as
+// it may fold to anything and has to be checked with the case folder.
+ptrdiff_t SplitFindFoldedCandidate(const SplitView &view, size_t start, size_t end, std::string_view folded) noexcept;
+
+// Length of the UTF-8 text at pos that matches folded, a search case folded by pcf, when each
+// character is folded by pcf, or 0 when it doesn't match before end. widthFirstCharacter is set
+// to the width of the character at pos so a search can step over it.
+size_t SplitMatchFoldedUTF8(const SplitView &view, size_t pos, size_t end, std::string_view folded, CaseFolder &pcf, int &widthFirstCharacter);
+
+}
+
+#endif
@@ -370,7 +370,7 @@ void MarginView::PaintOneMargin(Surface *surface, PRectangle rc, PRectangle rcOn
 			if (firstSubLine) {
 				std::string sNumber;
 				if (lineDoc >= 0) {
-					sNumber = std::to_string(lineDoc + 1);
+					sNumber = std::to_string(lineDoc + vs.lineNumberOffset + 1);
 				}
 				if (FlagSet(model.foldFlags, (FoldFlag::LevelNumbers | FoldFlag::LineState))) {
 					char number[100] = "";
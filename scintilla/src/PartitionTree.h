@@ -0,0 +1,474 @@
+// Scintilla source code edit control
+/** @file PartitionTree.h
+ ** Partitioning held in blocks indexed by Fenwick trees for scattered changes.
+ **/
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#ifndef PARTITIONTREE_H
+#define PARTITIONTREE_H
+
+namespace Scintilla::Internal {
+
+/// Divide an interval into multiple partitions with the same interface and behaviour as Partitioning.
+/// Partitioning moves a single step through the partition positions so changes that alternate
+/// between distant partitions, such as typing with carets spread over a long document, rewrite
+/// every position in between. Here the positions are held in blocks of up to blockSize, relative
+/// to the start of their block. Fenwick trees over the blocks hold the lengths and numbers of
+/// positions of the blocks so finding a block from a partition or a position, and moving all the
+/// blocks after a change, take O(log(blocks)) while changing a block takes O(blockSize).
+
+template <typename T>
+class PartitionTree {
+private:
+	static constexpr size_t blockSize = 1024;
+
+	// Each block holds the starts of partitions relative to the first which is always 0.
+	// The last block ends with the end of the last partition.
+	std::vector<std::vector<T>> blocks;
+	// Distance from the start of each block to the start of the next or the end of the interval
+	std::vector<T> spans;
+	// Fenwick trees, indexed from 1, of spans and of block sizes
+	std::vector<T> spanTree;
+	std::vector<T> countTree;
+	size_t topStep = 1;
+	T partitions = 1;
+
+	struct Place {
+		size_t block;
+		T first;	// Partition number of the first start in block
+		T base;	// Position of the first start in block
+	};
+
+	static constexpr size_t LowBit(size_t i) noexcept {
+		return i & (~i + 1);
+	}
+
+	size_t LastBlock() const noexcept {
+		return blocks.size() - 1;
+	}
+
+	T BlockCount(size_t block) const noexcept {
+		return static_cast<T>(blocks[block].size());
+	}
+
+	void SetTopStep() noexcept {
+		topStep = 1;
+		while ((topStep * 2) <= blocks.size()) {
+			topStep *= 2;
+		}
+	}
+
+	void Rebuild() {
+		const size_t length = blocks.size();
+		spanTree.assign(length + 1, 0);
+		countTree.assign(length + 1, 0);
+		for (size_t i = 1; i <= length; i++) {
+			spanTree[i] += spans[i - 1];
+			countTree[i] += BlockCount(i - 1);
+			const size_t parent = i + LowBit(i);
+			if (parent <= length) {
+				spanTree[parent] += spanTree[i];
+				countTree[parent] += countTree[i];
+			}
+		}
+		SetTopStep();
+	}
+
+	// The node of a new last block covers some of the blocks before it which are summed.
+	void AppendBlock(std::vector<T> &&block, T span) {
+		blocks.push_back(std::move(block));
+		spans.push_back(span);
+		const size_t node = blocks.size();
+		T spanNode = span;
+		T countNode = BlockCount(node - 1);
+		for (size_t i = node - 1; i > node - LowBit(node); i -= LowBit(i)) {
+			spanNode += spanTree[i];
+			countNode += countTree[i];
+		}
+		spanTree.push_back(spanNode);
+		countTree.push_back(countNode);
+		SetTopStep();
+	}
+
+	void SpanAdd(size_t block, T delta) noexcept {
+		spans[block] += delta;
+		for (size_t i = block + 1; i < spanTree.size(); i += LowBit(i)) {
+			spanTree[i] += delta;
+		}
+	}
+
+	void CountAdd(size_t block, T delta) noexcept {
+		for (size_t i = block + 1; i < countTree.size(); i += LowBit(i)) {
+			countTree[i] += delta;
+		}
+	}
+
+	// The span of the last block is its last start, the end of the interval.
+	void FixLastSpan() noexcept {
+		const size_t last = LastBlock();
+		const T delta = blocks[last].back() - spans[last];
+		if (delta != 0) {
+			SpanAdd(last, delta);
+		}
+	}
+
+	// Find the block holding the start of partition, which must be in [0 .. Partitions()].
+	Place Locate(T partition) const noexcept {
+		Place place { 0, 0, 0 };
+		for (size_t step = topStep; step > 0; step >>= 1) {
+			const size_t next = place.block + step;
+			if ((next < countTree.size()) && (place.first + countTree[next] <= partition)) {
+				place.block = next;
+				place.first += countTree[next];
+				place.base += spanTree[next];
+			}
+		}
+		return place;
+	}
+
+	// Find the last block starting at or before pos, which must be in [0 .. Length()).
+	Place LocatePosition(T pos) const noexcept {
+		Place place { 0, 0, 0 };
+		for (size_t step = topStep; step > 0; step >>= 1) {
+			const size_t next = place.block + step;
+			if ((next < spanTree.size()) && (place.base + spanTree[next] <= pos)) {
+				place.block = next;
+				place.first += countTree[next];
+				place.base += spanTree[next];
+			}
+		}
+		return place;
+	}
+
+	// Split an overfull block into blocks of up to blockSize.
+	void SplitBlock(size_t block) {
+		const size_t size = blocks[block].size();
+		if (size <= blockSize) {
+			return;
+		}
+		const size_t pieces = (size + blockSize - 1) / blockSize;
+		const bool atEnd = block == LastBlock();
+		std::vector<std::vector<T>> added;
+		std::vector<T> addedSpans;
+		std::vector<T> &whole = blocks[block];
+		const T spanWhole = spans[block];
+		size_t startPiece = 0;
+		for (size_t piece = 0; piece < pieces; piece++) {
+			const size_t endPiece = size * (piece + 1) / pieces;
+			if (piece > 0) {
+				const T offset = whole[startPiece];
+				std::vector<T> part(whole.begin() + startPiece, whole.begin() + endPiece);
+				for (T &start : part) {
+					start -= offset;
+				}
+				const T spanPart = ((piece + 1) < pieces) ? whole[endPiece] - offset : spanWhole - offset;
+				added.push_back(std::move(part));
+				addedSpans.push_back(spanPart);
+			}
+			startPiece = endPiece;
+		}
+		const size_t sizeFirst = size / pieces;
+		const T spanFirst = whole[sizeFirst];
+		std::vector<T> firstPiece;
+		firstPiece.reserve(blockSize + 1);
+		firstPiece.assign(whole.begin(), whole.begin() + sizeFirst);
+		whole = std::move(firstPiece);
+		SpanAdd(block, spanFirst - spanWhole);
+		CountAdd(block, static_cast<T>(sizeFirst) - static_cast<T>(size));
+		if (atEnd) {
+			for (size_t i = 0; i < added.size(); i++) {
+				AppendBlock(std::move(added[i]), addedSpans[i]);
+			}
+		} else {
+			blocks.insert(blocks.begin() + block + 1,
+				std::make_move_iterator(added.begin()), std::make_move_iterator(added.end()));
+			spans.insert(spans.begin() + block + 1, addedSpans.begin(), addedSpans.end());
+			Rebuild();
+		}
+	}
+
+	// Join a small block with a neighbour so that many deletions do not leave many blocks.
+	void MergeBlock(size_t block) {
+		if ((blocks.size() <= 1) || (blocks[block].size() >= blockSize / 4)) {
+			return;
+		}
+		if ((block < LastBlock()) && (blocks[block].size() + blocks[block + 1].size() <= blockSize)) {
+			MergeWithNext(block);
+		} else if ((block > 0) && (blocks[block - 1].size() + blocks[block].size() <= blockSize)) {
+			MergeWithNext(block - 1);
+		}
+	}
+
+	void MergeWithNext(size_t block) {
+		const size_t next = block + 1;
+		const T offset = spans[block];
+		for (const T start : blocks[next]) {
+			blocks[block].push_back(start + offset);
+		}
+		const T spanNext = spans[next];
+		const T countNext = BlockCount(next);
+		if (next == LastBlock()) {
+			blocks.pop_back();
+			spans.pop_back();
+			spanTree.pop_back();
+			countTree.pop_back();
+			SetTopStep();
+			SpanAdd(block, spanNext);
+			CountAdd(block, countNext);
+		} else {
+			blocks.erase(blocks.begin() + next);
+			spans.erase(spans.begin() + next);
+			spans[block] += spanNext;
+			Rebuild();
+		}
+	}
+
+	// Move the start of partition, which is the first of block, by delta.
+	void MoveBlockStart(size_t block, T delta) noexcept {
+		SpanAdd(block - 1, delta);
+		std::vector<T> &starts = blocks[block];
+		for (size_t i = 1; i < starts.size(); i++) {
+			starts[i] -= delta;
+		}
+		if (block == LastBlock()) {
+			FixLastSpan();
+		} else {
+			SpanAdd(block, -delta);
+		}
+	}
+
+	// Return the block and index where partition is to be inserted. The first start of a
+	// block stays 0 so inserting before it appends to the previous block.
+	std::pair<Place, size_t> InsertionPlace(T partition) const noexcept {
+		if (partition > Partitions()) {
+			const Place place = Locate(Partitions());
+			return { place, blocks[place.block].size() };
+		}
+		Place place = Locate(partition);
+		if ((partition == place.first) && (place.block > 0)) {
+			place.block--;
+			place.first -= BlockCount(place.block);
+			place.base -= spans[place.block];
+		}
+		return { place, static_cast<size_t>(partition - place.first) };
+	}
+
+	template <typename POSITION>
+	void InsertStarts(T partition, const POSITION *positions, size_t length) {
+		if (length == 0) {
+			return;
+		}
+		const auto [place, index] = InsertionPlace(partition);
+		std::vector<T> &starts = blocks[place.block];
+		starts.insert(starts.begin() + index, length, 0);
+		for (size_t i = 0; i < length; i++) {
+			starts[index + i] = static_cast<T>(positions[i]) - place.base;
+		}
+		CountAdd(place.block, static_cast<T>(length));
+		partitions += static_cast<T>(length);
+		if (place.block == LastBlock()) {
+			FixLastSpan();
+		}
+		SplitBlock(place.block);
+	}
+
+public:
+	// growSize is accepted so either class can be constructed the same way
+	explicit PartitionTree([[maybe_unused]] size_t growSize=8) {
+		DeleteAll();
+	}
+
+	T Partitions() const noexcept {
+		return partitions;
+	}
+
+	void ReAllocate(ptrdiff_t newSize) {
+		blocks.reserve(newSize / blockSize + 1);
+	}
+
+	T Length() const noexcept {
+		return PositionFromPartition(Partitions());
+	}
+
+	void InsertPartition(T partition, T pos) {
+		InsertStarts(partition, &pos, 1);
+	}
+
+	void InsertPartitions(T partition, const T *positions, size_t length) {
+		InsertStarts(partition, positions, length);
+	}
+
+	void InsertPartitionsWithCast(T partition, const ptrdiff_t *positions, size_t length) {
+		InsertStarts(partition, positions, length);
+	}
+
+	void SetPartitionStartPosition(T partition, T pos) noexcept {
+		if ((partition < 0) || (partition > Partitions())) {
+			return;
+		}
+		const Place place = Locate(partition);
+		const size_t index = static_cast<size_t>(partition - place.first);
+		if (index == 0) {
+			if (place.block > 0) {
+				MoveBlockStart(place.block, pos - place.base);
+			}
+		} else {
+			blocks[place.block][index] = pos - place.base;
+			if (place.block == LastBlock()) {
+				FixLastSpan();
+			}
+		}
+	}
+
+	void InsertText(T partitionInsert, T delta) noexcept {
+		// Point all the partitions after the insertion point further along in the buffer
+		const T partition = partitionInsert + 1;
+		if ((partition <= 0) || (partition > Partitions()) || (delta == 0)) {
+			return;
+		}
+		const Place place = Locate(partition);
+		const size_t index = static_cast<size_t>(partition - place.first);
+		if (index == 0) {
+			SpanAdd(place.block - 1, delta);
+		} else {
+			std::vector<T> &starts = blocks[place.block];
+			for (size_t i = index; i < starts.size(); i++) {
+				starts[i] += delta;
+			}
+			if (place.block == LastBlock()) {
+				FixLastSpan();
+			} else {
+				SpanAdd(place.block, delta);
+			}
+		}
+	}
+
+	void RemovePartition(T partition) {
+		if ((partition == 0) && (Partitions() > 1)) {
+			// The first start stays 0. RunStyles removes the first runs after deleting the text
+			// they covered, so the next start takes their place, which removing it here does too.
+			partition = 1;
+		}
+		if ((partition <= 0) || (partition > Partitions())) {
+			return;
+		}
+		const Place place = Locate(partition);
+		const size_t index = static_cast<size_t>(partition - place.first);
+		std::vector<T> &starts = blocks[place.block];
+		partitions--;
+		if (index == 0) {
+			if (starts.size() == 1) {
+				// Whole block goes so its span passes to the block before
+				const T span = spans[place.block];
+				if (place.block == LastBlock()) {
+					blocks.pop_back();
+					spans.pop_back();
+					spanTree.pop_back();
+					countTree.pop_back();
+					SetTopStep();
+					FixLastSpan();
+				} else {
+					blocks.erase(blocks.begin() + place.block);
+					spans.erase(spans.begin() + place.block);
+					spans[place.block - 1] += span;
+					Rebuild();
+				}
+				return;
+			}
+			MoveBlockStart(place.block, starts[1]);
+		}
+		starts.erase(starts.begin() + index);
+		CountAdd(place.block, -1);
+		if (place.block == LastBlock()) {
+			FixLastSpan();
+		}
+		MergeBlock(place.block);
+	}
+
+	T PositionFromPartition(T partition) const noexcept {
+		PLATFORM_ASSERT(partition >= 0);
+		PLATFORM_ASSERT(partition <= Partitions());
+		if ((partition < 0) || (partition > Partitions())) {
+			return 0;
+		}
+		const Place place = Locate(partition);
+		return place.base + blocks[place.block][partition - place.first];
+	}
+
+	/// Return value in range [0 .. Partitions() - 1] even for arguments outside interval
+	T PartitionFromPosition(T pos) const noexcept {
+		const T partitions = Partitions();
+		if (partitions <= 1)
+			return 0;
+		if (pos >= Length())
+			return partitions - 1;
+		if (pos < 0)
+			return 0;
+		const Place place = LocatePosition(pos);
+		const std::vector<T> &starts = blocks[place.block];
+		const auto it = std::upper_bound(starts.begin(), starts.end(), pos - place.base);
+		const T partition = place.first + static_cast<T>(it - starts.begin()) - 1;
+		return std::min(partition, partitions - 1);
+	}
+
+	void DeleteAll() {
+		blocks.clear();
+		spans.clear();
+		blocks.emplace_back();
+		blocks.back().reserve(blockSize + 1);
+		// 0 stays for ever and the end of the first partition will be the start of the second
+		blocks.back().push_back(0);
+		blocks.back().push_back(0);
+		spans.push_back(0);
+		partitions = 1;
+		Rebuild();
+	}
+
+	void Check() const {
+#ifdef CHECK_CORRECTNESS
+		if (Length() < 0) {
+			throw std::runtime_error("PartitionTree: Length can not be negative.");
+		}
+		if (Partitions() < 1) {
+			throw std::runtime_error("PartitionTree: Must always have 1 or more partitions.");
+		}
+		T first = 0;
+		T base = 0;
+		for (size_t block = 0; block < blocks.size(); block++) {
+			const Place place = Locate(first);
+			if ((place.block != block) || (place.base != base)) {
+				throw std::runtime_error("PartitionTree: Trees do not match blocks.");
+			}
+			if (blocks[block].empty() || (blocks[block].front() != 0)) {
+				throw std::runtime_error("PartitionTree: Block must start with 0.");
+			}
+			first += BlockCount(block);
+			base += spans[block];
+		}
+		if (blocks.back().back() != spans.back()) {
+			throw std::runtime_error("PartitionTree: Last block must end at the end.");
+		}
+		if (Length() == 0) {
+			if ((PositionFromPartition(0) != 0) || (PositionFromPartition(1) != 0)) {
+				throw std::runtime_error("PartitionTree: Invalid empty partitioning.");
+			}
+		} else {
+			// Positions should be a strictly ascending sequence
+			for (T i = 0; i < Partitions(); i++) {
+				const T pos = PositionFromPartition(i);
+				const T posNext = PositionFromPartition(i+1);
+				if (pos > posNext) {
+					throw std::runtime_error("PartitionTree: Negative partition.");
+				} else if (pos == posNext) {
+					throw std::runtime_error("PartitionTree: Empty partition.");
+				}
+			}
+		}
+#endif
+	}
+
+};
+
+}
+
+#endif
@@ -0,0 +1,343 @@
+// Scintilla source code edit control
+/** @file PieceTable.cxx
+ ** Text held as a sequence of pieces of unchanging buffers.
+ **/
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#include <cstddef>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <memory>
+
+#include "Debugging.h"
+
+#include "Position.h"
+#include "SplitVector.h"
+#include "Partitioning.h"
+#include "PieceTable.h"
+
+using namespace Scintilla::Internal;
+
+// An empty table has one empty piece without text as a Partitioning always has a partition.
+PieceTable::PieceTable() {
+	texts.Insert(0, nullptr);
+}
+
+PieceTable::~PieceTable() noexcept = default;
+
+ptrdiff_t PieceTable::Capacity() const noexcept {
+	return Length() + addSize - addUsed;
+}
+
+// Make block the current add block.
+void PieceTable::NewBlock(std::unique_ptr<char[]> block, ptrdiff_t size) {
+	blocks.push_back(std::move(block));
+	blockSizes.push_back(size);
+	blockBytes += size;
+	addText = blocks.back().get();
+	addUsed = 0;
+	addSize = size;
+}
+
+// Space for text at the end of the current add block, starting a new block when it is full.
+char *PieceTable::AddSpace(ptrdiff_t length) {
+	if (addSize - addUsed < length) {
+		const ptrdiff_t size = std::max(length, addBlockSize);
+		NewBlock(std::unique_ptr<char[]>(new char[size]), size);
+	}
+	char *space = addText + addUsed;
+	addUsed += length;
+	return space;
+}
+
+// The blocks have been written with much more than the text, so most of it is deleted text
+// or pieces joined again since.
+bool PieceTable::WantsCompacting() const noexcept {
+	return (blockBytes - (addSize - addUsed)) > (2 * Length() + compactSlack);
+}
+
+// Copy the text in add blocks into one new block and let go of the others, joining pieces
+// that then follow on in memory. Read only text stays where it is.
+void PieceTable::Compact() {
+	// Block ranges sorted by address so the block of a piece is found with a binary search
+	std::vector<std::pair<const char *, const char *>> ranges;
+	for (size_t i = 0; i < blocks.size(); i++) {
+		ranges.emplace_back(blocks[i].get(), blocks[i].get() + blockSizes[i]);
+	}
+	std::sort(ranges.begin(), ranges.end());
+	auto inBlock = [&ranges](const char *text) noexcept {
+		auto it = std::upper_bound(ranges.begin(), ranges.end(), text,
+			[](const char *t, const std::pair<const char *, const char *> &range) noexcept {
+				return t < range.first;
+			});
+		return (it != ranges.begin()) && (text < std::prev(it)->second);
+	};
+
+	const ptrdiff_t pieces = Pieces();
+	ptrdiff_t live = 0;
+	for (ptrdiff_t piece = 0; piece < pieces; piece++) {
+		if (inBlock(texts.ValueAt(piece)))
+			live += PieceStart(piece + 1) - PieceStart(piece);
+	}
+	const ptrdiff_t size = live + addBlockSize;
+	std::unique_ptr<char[]> block(new char[size]);
+
+	std::vector<ptrdiff_t> lengths;
+	std::vector<const char *> pieceTexts;
+	char *copy = block.get();
+	for (ptrdiff_t piece = 0; piece < pieces; piece++) {
+		const ptrdiff_t length = PieceStart(piece + 1) - PieceStart(piece);
+		const char *text = texts.ValueAt(piece);
+		if (inBlock(text)) {
+			std::copy_n(text, length, copy);
+			text = copy;
+			copy += length;
+		}
+		if (!pieceTexts.empty() && (pieceTexts.back() + lengths.back() == text)) {
+			lengths.back() += length;
+		} else {
+			lengths.push_back(length);
+			pieceTexts.push_back(text);
+		}
+	}
+
+	const ptrdiff_t length = Length();
+	starts.DeleteAll();
+	starts.InsertText(0, length);
+	ptrdiff_t position = 0;
+	for (size_t piece = 1; piece < lengths.size(); piece++) {
+		position += lengths[piece - 1];
+		starts.InsertPartition(piece, position);
+	}
+	texts.DeleteAll();
+	texts.InsertFromArray(0, pieceTexts.data(), 0, pieceTexts.size());
+
+	terminated = nullptr;
+	blocks.clear();
+	blockSizes.clear();
+	blockBytes = 0;
+	NewBlock(std::move(block), size);
+	addUsed = live;
+}
+
+// Make position the start of a piece and return that piece, which is Pieces() at the end.
+ptrdiff_t PieceTable::SplitAt(ptrdiff_t position) {
+	if (position >= Length()) {
+		return Pieces();
+	}
+	const ptrdiff_t piece = starts.PartitionFromPosition(position);
+	const ptrdiff_t start = starts.PositionFromPartition(piece);
+	if (position == start) {
+		return piece;
+	}
+	starts.InsertPartition(piece + 1, position);
+	texts.Insert(piece + 1, texts.ValueAt(piece) + (position - start));
+	return piece + 1;
+}
+
+void PieceTable::InsertPiece(ptrdiff_t position, const char *text, ptrdiff_t insertLength) {
+	terminated = nullptr;
+	if (Length() == 0) {
+		texts.SetValueAt(0, text);
+		starts.InsertText(0, insertLength);
+		return;
+	}
+	if (position > 0) {
+		// Typing appends to the add block just after the previous insertion, so lengthen its piece
+		const ptrdiff_t before = starts.PartitionFromPosition(position - 1);
+		const ptrdiff_t startBefore = starts.PositionFromPartition(before);
+		if ((starts.PositionFromPartition(before + 1) == position) &&
+			(texts.ValueAt(before) + (position - startBefore) == text)) {
+			starts.InsertText(before, insertLength);
+			return;
+		}
+	}
+	const ptrdiff_t piece = SplitAt(position);
+	// An empty piece at position is added then lengthened
+	starts.InsertPartition(piece, position);
+	starts.InsertText(piece, insertLength);
+	texts.Insert(piece, text);
+}
+
+// Remove pieces [first, last) which are not all of the pieces.
+void PieceTable::RemovePieces(ptrdiff_t first, ptrdiff_t last) {
+	const ptrdiff_t length = starts.PositionFromPartition(last) - starts.PositionFromPartition(first);
+	// Fold the pieces into the first, shorten it to nothing and drop its boundary
+	for (ptrdiff_t piece = last - 1; piece > first; piece--) {
+		starts.RemovePartition(piece);
+	}
+	texts.DeleteRange(first + 1, last - first - 1);
+	starts.InsertText(first, -length);
+	starts.RemovePartition((first > 0) ? first : 1);
+	texts.Delete(first);
+}
+
+// Join a piece to the one before when its text follows on in memory.
+void PieceTable::MergeAt(ptrdiff_t piece) {
+	const ptrdiff_t startBefore = starts.PositionFromPartition(piece - 1);
+	const ptrdiff_t start = starts.PositionFromPartition(piece);
+	if (texts.ValueAt(piece - 1) + (start - startBefore) == texts.ValueAt(piece)) {
+		starts.RemovePartition(piece);
+		texts.Delete(piece);
+	}
+}
+
+void PieceTable::GetRange(char *buffer, ptrdiff_t position, ptrdiff_t retrieveLength) const {
+	if (retrieveLength <= 0) {
+		return;
+	}
+	ptrdiff_t piece = starts.PartitionFromPosition(position);
+	ptrdiff_t start = starts.PositionFromPartition(piece);
+	while (retrieveLength > 0) {
+		const ptrdiff_t end = starts.PositionFromPartition(piece + 1);
+		const ptrdiff_t lengthCopy = std::min(end - position, retrieveLength);
+		std::copy_n(texts.ValueAt(piece) + (position - start), lengthCopy, buffer);
+		buffer += lengthCopy;
+		position += lengthCopy;
+		retrieveLength -= lengthCopy;
+		piece++;
+		start = end;
+	}
+}
+
+void PieceTable::ReAllocate(ptrdiff_t newSize) {
+	if (newSize < 0) {
+		throw std::runtime_error("PieceTable::ReAllocate: negative size.");
+	}
+	const ptrdiff_t wanted = newSize - Length();
+	if (wanted > addSize - addUsed) {
+		NewBlock(std::unique_ptr<char[]>(new char[wanted]), wanted);
+	}
+}
+
+void PieceTable::InsertFromArray(ptrdiff_t position, const char *s, ptrdiff_t positionFrom, ptrdiff_t insertLength) {
+	if ((position < 0) || (position > Length())) {
+		throw std::runtime_error("PieceTable::InsertFromArray: position out of range.");
+	}
+	if (insertLength <= 0) {
+		return;
+	}
+	char *text = AddSpace(insertLength);
+	std::copy_n(s + positionFrom, insertLength, text);
+	InsertPiece(position, text, insertLength);
+}
+
+void PieceTable::InsertReadOnly(ptrdiff_t position, const char *s, ptrdiff_t insertLength, std::shared_ptr<const void> owner) {
+	if ((position < 0) || (position > Length())) {
+		throw std::runtime_error("PieceTable::InsertReadOnly: position out of range.");
+	}
+	if (insertLength <= 0) {
+		return;
+	}
+	if (owner && (owners.empty() || (owners.back() != owner))) {
+		owners.push_back(std::move(owner));
+	}
+	InsertPiece(position, s, insertLength);
+}
+
+void PieceTable::DeleteRange(ptrdiff_t position, ptrdiff_t deleteLength) {
+	if ((position < 0) || ((position + deleteLength) > Length())) {
+		throw std::runtime_error("PieceTable::DeleteRange: position out of range.");
+	}
+	if (deleteLength <= 0) {
+		return;
+	}
+	if ((position == 0) && (deleteLength == Length())) {
+		DeleteAll();
+		return;
+	}
+	terminated = nullptr;
+	const ptrdiff_t first = SplitAt(position);
+	const ptrdiff_t last = SplitAt(position + deleteLength);
+	RemovePieces(first, last);
+	// Deleting what was just typed leaves pieces that can be joined again
+	if ((first > 0) && (first < Pieces())) {
+		MergeAt(first);
+	}
+}
+
+void PieceTable::DeleteAll() {
+	starts.DeleteAll();
+	texts.DeleteAll();
+	texts.Insert(0, nullptr);
+	terminated = nullptr;
+	owners.clear();
+	// Keep the current add block, which may have been reserved for the next insertions
+	if (blocks.size() > 1) {
+		std::unique_ptr<char[]> current = std::move(blocks.back());
+		blocks.clear();
+		blockSizes.clear();
+		blockBytes = 0;
+		NewBlock(std::move(current), addSize);
+	}
+	addUsed = 0;
+}
+
+const char *PieceTable::RangePointer(ptrdiff_t position, ptrdiff_t rangeLength) {
+	const ptrdiff_t piece = starts.PartitionFromPosition(position);
+	const ptrdiff_t start = starts.PositionFromPartition(piece);
+	if ((position + rangeLength) <= starts.PositionFromPartition(piece + 1)) {
+		return texts.ValueAt(piece) + (position - start);
+	}
+	// Repeatedly joining large ranges, as saving after each edit does, would otherwise fill
+	// memory with copies. Compacting may leave the range in one piece.
+	if (WantsCompacting()) {
+		Compact();
+		const ptrdiff_t pieceCompacted = starts.PartitionFromPosition(position);
+		if ((position + rangeLength) <= starts.PositionFromPartition(pieceCompacted + 1)) {
+			return texts.ValueAt(pieceCompacted) + (position - starts.PositionFromPartition(pieceCompacted));
+		}
+	}
+	char *joined = AddSpace(rangeLength);
+	GetRange(joined, position, rangeLength);
+	const ptrdiff_t first = SplitAt(position);
+	const ptrdiff_t last = SplitAt(position + rangeLength);
+	for (ptrdiff_t p = last - 1; p > first; p--) {
+		starts.RemovePartition(p);
+	}
+	texts.DeleteRange(first + 1, last - first - 1);
+	texts.SetValueAt(first, joined);
+	return joined;
+}
+
+const char *PieceTable::BufferPointer() {
+	if (terminated) {
+		return terminated;
+	}
+	const ptrdiff_t length = Length();
+	const ptrdiff_t size = length + 1 + addBlockSize;
+	std::unique_ptr<char[]> block(new char[size]);
+	GetRange(block.get(), 0, length);
+	block[length] = '\0';
+	starts.DeleteAll();
+	starts.InsertText(0, length);
+	texts.DeleteAll();
+	texts.Insert(0, block.get());
+	owners.clear();
+	blocks.clear();
+	blockSizes.clear();
+	blockBytes = 0;
+	NewBlock(std::move(block), size);
+	addUsed = length + 1;
+	terminated = addText;
+	return terminated;
+}
+
+void PieceTable::Check() const {
+	if (texts.Length() != Pieces()) {
+		throw std::runtime_error("PieceTable: Each piece needs a text.");
+	}
+	if (Length() > 0) {
+		for (ptrdiff_t piece = 0; piece < Pieces(); piece++) {
+			if (PieceStart(piece) >= PieceStart(piece + 1)) {
+				throw std::runtime_error("PieceTable: Empty piece.");
+			}
+			if (!texts.ValueAt(piece)) {
+				throw std::runtime_error("PieceTable: Piece without text.");
+			}
+		}
+	}
+}
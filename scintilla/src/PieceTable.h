@@ -0,0 +1,113 @@
+// Scintilla source code edit control
+/** @file PieceTable.h
+ ** Text held as a sequence of pieces of unchanging buffers.
+ **/
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#ifndef PIECETABLE_H
+#define PIECETABLE_H
+
+namespace Scintilla::Internal {
+
+/**
+ * A piece table lists the text as pieces, each a pointer into a buffer that is never
+ * changed once written. Inserted text is appended to add blocks and deleting only
+ * shortens, splits or drops pieces, so edits cost the same anywhere in the document
+ * instead of moving the bytes between the edit and the previous one as a gap buffer does.
+ * Text inserted read only, such as a memory mapped file, is not copied at all: the
+ * pieces point into it and its owner is kept alive while the table may refer to it.
+ * The piece positions are a Partitioning so finding the piece of a position is a binary
+ * search and a run of edits near each other updates few of them.
+ * Reading a range across pieces as one block joins that range into a new piece.
+ * The add blocks are compacted once they hold much more than the text: the text still
+ * in them is copied into one block and the rest is let go.
+ */
+class PieceTable {
+	Partitioning<ptrdiff_t> starts;
+	SplitVector<const char *> texts;
+	std::vector<std::unique_ptr<char[]>> blocks;
+	std::vector<ptrdiff_t> blockSizes;
+	ptrdiff_t blockBytes = 0;
+	std::vector<std::shared_ptr<const void>> owners;
+	char *addText = nullptr;
+	ptrdiff_t addUsed = 0;
+	ptrdiff_t addSize = 0;
+	ptrdiff_t reserved = 0;
+	// Joined copy of the whole text, followed by a NUL, until the next change
+	const char *terminated = nullptr;
+
+	void NewBlock(std::unique_ptr<char[]> block, ptrdiff_t size);
+	char *AddSpace(ptrdiff_t length);
+	bool WantsCompacting() const noexcept;
+	void Compact();
+	ptrdiff_t SplitAt(ptrdiff_t position);
+	void InsertPiece(ptrdiff_t position, const char *text, ptrdiff_t insertLength);
+	void RemovePieces(ptrdiff_t first, ptrdiff_t last);
+	void MergeAt(ptrdiff_t piece);
+
+public:
+	static constexpr ptrdiff_t addBlockSize = 0x10000;
+	/// Add blocks may hold this much more than twice the text before they are compacted.
+	static constexpr ptrdiff_t compactSlack = 0x100000;
+
+	PieceTable();
+	// Deleted so PieceTable objects can not be copied.
+	PieceTable(const PieceTable &) = delete;
+	PieceTable(PieceTable &&) = delete;
+	PieceTable &operator=(const PieceTable &) = delete;
+	PieceTable &operator=(PieceTable &&) = delete;
+	~PieceTable() noexcept;
+
+	ptrdiff_t Length() const noexcept {
+		return starts.Length();
+	}
+	/// Length plus the space reserved for insertions that is not yet used.
+	ptrdiff_t Capacity() const noexcept;
+	ptrdiff_t Pieces() const noexcept {
+		return starts.Partitions();
+	}
+	ptrdiff_t PieceStart(ptrdiff_t piece) const noexcept {
+		return starts.PositionFromPartition(piece);
+	}
+	/// The piece holding position, the last piece for the end of the text.
+	ptrdiff_t PieceFromPosition(ptrdiff_t position) const noexcept {
+		return starts.PartitionFromPosition(position);
+	}
+	const char *PieceText(ptrdiff_t piece) const noexcept {
+		return texts.ValueAt(piece);
+	}
+	/// Bytes allocated for add blocks, whether used by the text or not.
+	ptrdiff_t BlockBytes() const noexcept {
+		return blockBytes;
+	}
+
+	/// Retrieving positions outside the range of the text works and returns 0
+	char ValueAt(ptrdiff_t position) const noexcept {
+		if ((position < 0) || (position >= Length())) {
+			return 0;
+		}
+		const ptrdiff_t piece = starts.PartitionFromPosition(position);
+		return texts.ValueAt(piece)[position - starts.PositionFromPartition(piece)];
+	}
+	void GetRange(char *buffer, ptrdiff_t position, ptrdiff_t retrieveLength) const;
+
+	/// Reserve space so insertions up to a length of newSize are appended to one block.
+	void ReAllocate(ptrdiff_t newSize);
+	void InsertFromArray(ptrdiff_t position, const char *s, ptrdiff_t positionFrom, ptrdiff_t insertLength);
+	/// Insert text that stays where it is, kept alive by owner, instead of copying it.
+	void InsertReadOnly(ptrdiff_t position, const char *s, ptrdiff_t insertLength, std::shared_ptr<const void> owner);
+	void DeleteRange(ptrdiff_t position, ptrdiff_t deleteLength);
+	void DeleteAll();
+
+	/// Return a pointer to a range of the text, joining the pieces it spans if needed.
+	/// The pointer is valid until the text is next changed or joined.
+	const char *RangePointer(ptrdiff_t position, ptrdiff_t rangeLength);
+	/// Join the whole text into one block followed by a NUL and return it. This lets go of
+	/// every other block and read only text so it also reclaims the space of deleted text.
+	const char *BufferPointer();
+	void Check() const;
+};
+
+}
+
+#endif
@@ -24,13 +24,14 @@
 #include "Position.h"
 #include "SplitVector.h"
 #include "Partitioning.h"
+#include "PartitionTree.h"
 #include "RunStyles.h"
 
 using namespace Scintilla::Internal;
 
 // Find the first run at a position
-template <typename DISTANCE, typename STYLE>
-DISTANCE RunStyles<DISTANCE, STYLE>::RunFromPosition(DISTANCE position) const noexcept {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+DISTANCE RunStyles<DISTANCE, STYLE, PARTITIONING>::RunFromPosition(DISTANCE position) const noexcept {
 	DISTANCE run = starts.PartitionFromPosition(position);
 	// Go to first element with this position
 	while ((run > 0) && (position == starts.PositionFromPartition(run-1))) {
@@ -40,8 +41,8 @@ DISTANCE RunStyles<DISTANCE, STYLE>::RunFromPosition(DISTANCE position) const no
 }
 
 // If there is no run boundary at position, insert one continuing style.
-template <typename DISTANCE, typename STYLE>
-DISTANCE RunStyles<DISTANCE, STYLE>::SplitRun(DISTANCE position) {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+DISTANCE RunStyles<DISTANCE, STYLE, PARTITIONING>::SplitRun(DISTANCE position) {
 	DISTANCE run = RunFromPosition(position);
 	const DISTANCE posRun = starts.PositionFromPartition(run);
 	if (posRun < position) {
@@ -53,14 +54,14 @@ DISTANCE RunStyles<DISTANCE, STYLE>::SplitRun(DISTANCE position) {
 	return run;
 }
 
-template <typename DISTANCE, typename STYLE>
-void RunStyles<DISTANCE, STYLE>::RemoveRun(DISTANCE run) {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+void RunStyles<DISTANCE, STYLE, PARTITIONING>::RemoveRun(DISTANCE run) {
 	starts.RemovePartition(run);
 	styles.DeleteRange(run, 1);
 }
 
-template <typename DISTANCE, typename STYLE>
-void RunStyles<DISTANCE, STYLE>::RemoveRunIfEmpty(DISTANCE run) {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+void RunStyles<DISTANCE, STYLE, PARTITIONING>::RemoveRunIfEmpty(DISTANCE run) {
 	if ((run < starts.Partitions()) && (starts.Partitions() > 1)) {
 		if (starts.PositionFromPartition(run) == starts.PositionFromPartition(run+1)) {
 			RemoveRun(run);
@@ -68,8 +69,8 @@ void RunStyles<DISTANCE, STYLE>::RemoveRunIfEmpty(DISTANCE run) {
 	}
 }
 
-template <typename DISTANCE, typename STYLE>
-void RunStyles<DISTANCE, STYLE>::RemoveRunIfSameAsPrevious(DISTANCE run) {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+void RunStyles<DISTANCE, STYLE, PARTITIONING>::RemoveRunIfSameAsPrevious(DISTANCE run) {
 	if ((run > 0) && (run < starts.Partitions())) {
 		const DISTANCE runBefore = run - 1;
 		if (styles.ValueAt(runBefore) == styles.ValueAt(run)) {
@@ -78,23 +79,23 @@ void RunStyles<DISTANCE, STYLE>::RemoveRunIfSameAsPrevious(DISTANCE run) {
 	}
 }
 
-template <typename DISTANCE, typename STYLE>
-RunStyles<DISTANCE, STYLE>::RunStyles() {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+RunStyles<DISTANCE, STYLE, PARTITIONING>::RunStyles() {
 	styles.InsertValue(0, 2, 0);
 }
 
-template <typename DISTANCE, typename STYLE>
-DISTANCE RunStyles<DISTANCE, STYLE>::Length() const noexcept {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+DISTANCE RunStyles<DISTANCE, STYLE, PARTITIONING>::Length() const noexcept {
 	return starts.PositionFromPartition(starts.Partitions());
 }
 
-template <typename DISTANCE, typename STYLE>
-STYLE RunStyles<DISTANCE, STYLE>::ValueAt(DISTANCE position) const noexcept {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+STYLE RunStyles<DISTANCE, STYLE, PARTITIONING>::ValueAt(DISTANCE position) const noexcept {
 	return styles.ValueAt(starts.PartitionFromPosition(position));
 }
 
-template <typename DISTANCE, typename STYLE>
-DISTANCE RunStyles<DISTANCE, STYLE>::FindNextChange(DISTANCE position, DISTANCE end) const noexcept {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+DISTANCE RunStyles<DISTANCE, STYLE, PARTITIONING>::FindNextChange(DISTANCE position, DISTANCE end) const noexcept {
 	const DISTANCE run = starts.PartitionFromPosition(position);
 	if (run < starts.Partitions()) {
 		const DISTANCE runChange = starts.PositionFromPartition(run);
@@ -113,18 +114,59 @@ DISTANCE RunStyles<DISTANCE, STYLE>::FindNextChange(DISTANCE position, DISTANCE
 	}
 }
 
-template <typename DISTANCE, typename STYLE>
-DISTANCE RunStyles<DISTANCE, STYLE>::StartRun(DISTANCE position) const noexcept {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+DISTANCE RunStyles<DISTANCE, STYLE, PARTITIONING>::StartRun(DISTANCE position) const noexcept {
 	return starts.PositionFromPartition(starts.PartitionFromPosition(position));
 }
 
-template <typename DISTANCE, typename STYLE>
-DISTANCE RunStyles<DISTANCE, STYLE>::EndRun(DISTANCE position) const noexcept {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+DISTANCE RunStyles<DISTANCE, STYLE, PARTITIONING>::EndRun(DISTANCE position) const noexcept {
 	return starts.PositionFromPartition(starts.PartitionFromPosition(position) + 1);
 }
 
-template <typename DISTANCE, typename STYLE>
-FillResult<DISTANCE> RunStyles<DISTANCE, STYLE>::FillRange(DISTANCE position, STYLE value, DISTANCE fillLength) {
+// Retrieve the values of a range by walking its runs rather than looking up each position
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+void RunStyles<DISTANCE, STYLE, PARTITIONING>::GetRange(STYLE *buffer, DISTANCE position, DISTANCE retrieveLength) const {
+	RunCursor<DISTANCE> cursor;
+	GetRange(buffer, position, retrieveLength, cursor);
+}
+
+// Point cursor at the run containing position, stepping to the next run when position
+// has just moved past the end of the cursor's run.
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+void RunStyles<DISTANCE, STYLE, PARTITIONING>::MoveCursor(DISTANCE position, RunCursor<DISTANCE> &cursor) const noexcept {
+	if ((cursor.run >= 0) && (position >= cursor.start) && (position < cursor.end)) {
+		return;
+	}
+	if ((cursor.run >= 0) && (position == cursor.end) && (cursor.run + 1 < starts.Partitions())) {
+		cursor.run++;
+	} else {
+		cursor.run = starts.PartitionFromPosition(position);
+	}
+	cursor.start = starts.PositionFromPartition(cursor.run);
+	cursor.end = starts.PositionFromPartition(cursor.run + 1);
+}
+
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+STYLE RunStyles<DISTANCE, STYLE, PARTITIONING>::ValueAt(DISTANCE position, RunCursor<DISTANCE> &cursor) const noexcept {
+	MoveCursor(position, cursor);
+	return styles.ValueAt(cursor.run);
+}
+
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+void RunStyles<DISTANCE, STYLE, PARTITIONING>::GetRange(STYLE *buffer, DISTANCE position, DISTANCE retrieveLength, RunCursor<DISTANCE> &cursor) const {
+	const DISTANCE end = position + retrieveLength;
+	while (position < end) {
+		MoveCursor(position, cursor);
+		const DISTANCE endRun = std::min(cursor.end, end);
+		std::fill(buffer, buffer + (endRun - position), styles.ValueAt(cursor.run));
+		buffer += endRun - position;
+		position = endRun;
+	}
+}
+
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+FillResult<DISTANCE> RunStyles<DISTANCE, STYLE, PARTITIONING>::FillRange(DISTANCE position, STYLE value, DISTANCE fillLength) {
 	const FillResult<DISTANCE> resultNoChange{false, position, fillLength};
 	if (fillLength <= 0) {
 		return resultNoChange;
@@ -191,13 +233,13 @@ FillResult<DISTANCE> RunStyles<DISTANCE, STYLE>::FillRange(DISTANCE position, ST
 	return resultNoChange;
 }
 
-template <typename DISTANCE, typename STYLE>
-void RunStyles<DISTANCE, STYLE>::SetValueAt(DISTANCE position, STYLE value) {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+void RunStyles<DISTANCE, STYLE, PARTITIONING>::SetValueAt(DISTANCE position, STYLE value) {
 	FillRange(position, value, 1);
 }
 
-template <typename DISTANCE, typename STYLE>
-void RunStyles<DISTANCE, STYLE>::InsertSpace(DISTANCE position, DISTANCE insertLength) {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+void RunStyles<DISTANCE, STYLE, PARTITIONING>::InsertSpace(DISTANCE position, DISTANCE insertLength) {
 	DISTANCE runStart = RunFromPosition(position);
 	if (starts.PositionFromPartition(runStart) == position) {
 		STYLE runStyle = ValueAt(position);
@@ -225,15 +267,15 @@ void RunStyles<DISTANCE, STYLE>::InsertSpace(DISTANCE position, DISTANCE insertL
 	}
 }
 
-template <typename DISTANCE, typename STYLE>
-void RunStyles<DISTANCE, STYLE>::DeleteAll() {
-	starts = Partitioning<DISTANCE>();
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+void RunStyles<DISTANCE, STYLE, PARTITIONING>::DeleteAll() {
+	starts = PARTITIONING();
 	styles = SplitVector<STYLE>();
 	styles.InsertValue(0, 2, 0);
 }
 
-template <typename DISTANCE, typename STYLE>
-void RunStyles<DISTANCE, STYLE>::DeleteRange(DISTANCE position, DISTANCE deleteLength) {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+void RunStyles<DISTANCE, STYLE, PARTITIONING>::DeleteRange(DISTANCE position, DISTANCE deleteLength) {
 	DISTANCE end = position + deleteLength;
 	DISTANCE runStart = RunFromPosition(position);
 	DISTANCE runEnd = RunFromPosition(end);
@@ -254,13 +296,13 @@ void RunStyles<DISTANCE, STYLE>::DeleteRange(DISTANCE position, DISTANCE deleteL
 	}
 }
 
-template <typename DISTANCE, typename STYLE>
-DISTANCE RunStyles<DISTANCE, STYLE>::Runs() const noexcept {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+DISTANCE RunStyles<DISTANCE, STYLE, PARTITIONING>::Runs() const noexcept {
 	return starts.Partitions();
 }
 
-template <typename DISTANCE, typename STYLE>
-bool RunStyles<DISTANCE, STYLE>::AllSame() const noexcept {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+bool RunStyles<DISTANCE, STYLE, PARTITIONING>::AllSame() const noexcept {
 	for (DISTANCE run = 1; run < starts.Partitions(); run++) {
 		const DISTANCE runBefore = run - 1;
 		if (styles.ValueAt(run) != styles.ValueAt(runBefore))
@@ -269,13 +311,13 @@ bool RunStyles<DISTANCE, STYLE>::AllSame() const noexcept {
 	return true;
 }
 
-template <typename DISTANCE, typename STYLE>
-bool RunStyles<DISTANCE, STYLE>::AllSameAs(STYLE value) const noexcept {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+bool RunStyles<DISTANCE, STYLE, PARTITIONING>::AllSameAs(STYLE value) const noexcept {
 	return AllSame() && (styles.ValueAt(0) == value);
 }
 
-template <typename DISTANCE, typename STYLE>
-DISTANCE RunStyles<DISTANCE, STYLE>::Find(STYLE value, DISTANCE start) const noexcept {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+DISTANCE RunStyles<DISTANCE, STYLE, PARTITIONING>::Find(STYLE value, DISTANCE start) const noexcept {
 	if (start < Length()) {
 		DISTANCE run = start ? RunFromPosition(start) : 0;
 		if (styles.ValueAt(run) == value)
@@ -290,8 +332,8 @@ DISTANCE RunStyles<DISTANCE, STYLE>::Find(STYLE value, DISTANCE start) const noe
 	return -1;
 }
 
-template <typename DISTANCE, typename STYLE>
-void RunStyles<DISTANCE, STYLE>::Check() const {
+template <typename DISTANCE, typename STYLE, typename PARTITIONING>
+void RunStyles<DISTANCE, STYLE, PARTITIONING>::Check() const {
 	if (Length() < 0) {
 		throw std::runtime_error("RunStyles: Length can not be negative.");
 	}
@@ -321,7 +363,10 @@ void RunStyles<DISTANCE, STYLE>::Check() const {
 
 template class Scintilla::Internal::RunStyles<int, int>;
 template class Scintilla::Internal::RunStyles<int, char>;
+template class Scintilla::Internal::RunStyles<int, int, PartitionTree<int>>;
+template class Scintilla::Internal::RunStyles<int, char, PartitionTree<int>>;
 #if (PTRDIFF_MAX != INT_MAX) || defined(__HAIKU__) || defined(PTRDIFF_DOESNT_ALIAS_INT)
 template class Scintilla::Internal::RunStyles<ptrdiff_t, int>;
 template class Scintilla::Internal::RunStyles<ptrdiff_t, char>;
+template class Scintilla::Internal::RunStyles<ptrdiff_t, char, PartitionTree<ptrdiff_t>>;
 #endif
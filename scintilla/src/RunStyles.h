@@ -22,12 +22,24 @@ struct FillResult {
 	DISTANCE fillLength;
 };
 
-template <typename DISTANCE, typename STYLE>
+// Remembers the run last accessed so sequential reads find the run at or just after it
+// without a search. Only valid while the RunStyles is unchanged: reset it after any change.
+template <typename DISTANCE>
+struct RunCursor {
+	DISTANCE run = -1;
+	DISTANCE start = 0;
+	DISTANCE end = 0;
+};
+
+// The run starts are a Partitioning unless a PartitionTree is chosen for changes scattered
+// over many runs.
+template <typename DISTANCE, typename STYLE, typename PARTITIONING=Partitioning<DISTANCE>>
 class RunStyles {
 private:
-	Partitioning<DISTANCE> starts;
+	PARTITIONING starts;
 	SplitVector<STYLE> styles;
 	DISTANCE RunFromPosition(DISTANCE position) const noexcept;
+	void MoveCursor(DISTANCE position, RunCursor<DISTANCE> &cursor) const noexcept;
 	DISTANCE SplitRun(DISTANCE position);
 	void RemoveRun(DISTANCE run);
 	void RemoveRunIfEmpty(DISTANCE run);
@@ -39,6 +51,10 @@ public:
 	DISTANCE FindNextChange(DISTANCE position, DISTANCE end) const noexcept;
 	DISTANCE StartRun(DISTANCE position) const noexcept;
 	DISTANCE EndRun(DISTANCE position) const noexcept;
+	void GetRange(STYLE *buffer, DISTANCE position, DISTANCE retrieveLength) const;
+	// As ValueAt and GetRange starting from cursor, which is moved to the last run read
+	STYLE ValueAt(DISTANCE position, RunCursor<DISTANCE> &cursor) const noexcept;
+	void GetRange(STYLE *buffer, DISTANCE position, DISTANCE retrieveLength, RunCursor<DISTANCE> &cursor) const;
 	// Returns changed=true if some values may have changed
 	FillResult<DISTANCE> FillRange(DISTANCE position, STYLE value, DISTANCE fillLength);
 	void SetValueAt(DISTANCE position, STYLE value);
@@ -166,6 +166,11 @@ public:
 		return lengthBody;
 	}
 
+	/// Number of elements that can be held before reallocating.
+	ptrdiff_t Capacity() const noexcept {
+		return body.size();
+	}
+
 	/// Insert a single value into the buffer.
 	/// Inserting at positions outside the current range fails.
 	void Insert(ptrdiff_t position, T v) {
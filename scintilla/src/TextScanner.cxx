@@ -0,0 +1,265 @@
+// Scintilla source code edit control
+/** @file TextScanner.cxx
+ ** Single pass scan of loaded text for UTF-8 validity, line ends and line starts.
+ **/
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define SCANNER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(SCANNER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SCANNER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SCANNER_TARGET_AVX2
+#endif
+
+#include "Position.h"
+#include "UniConversion.h"
+#include "TextScanner.h"
+
+using namespace Scintilla::Internal;
+
+namespace {
+
+// The kernels find the next byte the scan has to look at: a CR or LF and,
+// when checking UTF-8, any byte outside ASCII. Everything else is skipped in bulk.
+
+constexpr uint64_t BroadcastByte(unsigned char ch) noexcept {
+	return 0x0101010101010101ULL * ch;
+}
+
+constexpr uint64_t highBits = BroadcastByte(0x80);
+
+// Non-zero when any byte of word is zero
+constexpr uint64_t HasZeroByte(uint64_t word) noexcept {
+	return (word - BroadcastByte(1)) & ~word & highBits;
+}
+
+const char *FindInterestingScalar(const char *p, const char *end, bool highBytes) noexcept {
+	const uint64_t highMask = highBytes ? highBits : 0;
+	while (end - p >= static_cast<ptrdiff_t>(sizeof(uint64_t))) {
+		uint64_t word = 0;
+		memcpy(&word, p, sizeof(word));
+		if (HasZeroByte(word ^ BroadcastByte('\r')) | HasZeroByte(word ^ BroadcastByte('\n')) | (word & highMask)) {
+			break;
+		}
+		p += sizeof(word);
+	}
+	for (; p < end; p++) {
+		const unsigned char ch = *p;
+		if ((ch == '\r') || (ch == '\n') || (highBytes && (ch >= 0x80))) {
+			return p;
+		}
+	}
+	return end;
+}
+
+#if defined(SCANNER_X86)
+
+unsigned int CountTrailingZeros(unsigned int mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index = 0;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+const char *FindInterestingSSE2(const char *p, const char *end, bool highBytes) noexcept {
+	const __m128i cr = _mm_set1_epi8('\r');
+	const __m128i lf = _mm_set1_epi8('\n');
+	const unsigned int highMask = highBytes ? 0xFFFF : 0;
+	while (end - p >= 16) {
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+		const __m128i eol = _mm_or_si128(_mm_cmpeq_epi8(block, cr), _mm_cmpeq_epi8(block, lf));
+		const unsigned int mask = _mm_movemask_epi8(eol) | (_mm_movemask_epi8(block) & highMask);
+		if (mask) {
+			return p + CountTrailingZeros(mask);
+		}
+		p += 16;
+	}
+	return FindInterestingScalar(p, end, highBytes);
+}
+
+SCANNER_TARGET_AVX2
+const char *FindInterestingAVX2(const char *p, const char *end, bool highBytes) noexcept {
+	const __m256i cr = _mm256_set1_epi8('\r');
+	const __m256i lf = _mm256_set1_epi8('\n');
+	const unsigned int highMask = highBytes ? 0xFFFFFFFFU : 0;
+	while (end - p >= 32) {
+		const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+		const __m256i eol = _mm256_or_si256(_mm256_cmpeq_epi8(block, cr), _mm256_cmpeq_epi8(block, lf));
+		const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(eol)) |
+			(static_cast<unsigned int>(_mm256_movemask_epi8(block)) & highMask);
+		if (mask) {
+			return p + CountTrailingZeros(mask);
+		}
+		p += 32;
+	}
+	return FindInterestingSSE2(p, end, highBytes);
+}
+
+bool ProcessorHasAVX2() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+	int info[4] {};
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+	__cpuid(info, 1);
+	constexpr int osxsave = 1 << 27;
+	constexpr int avx = 1 << 28;
+	if ((info[2] & (osxsave | avx)) != (osxsave | avx)) {
+		return false;
+	}
+	// The operating system must preserve the YMM registers
+	if ((_xgetbv(0) & 6) != 6) {
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+}
+
+TextScanner::TextScanner(bool checkUTF8_, ScanKernel kernel) : findInteresting(FindInterestingScalar), checkUTF8(checkUTF8_) {
+	if (kernel == ScanKernel::automatic) {
+		kernel = KernelAvailable(ScanKernel::avx2) ? ScanKernel::avx2 :
+			KernelAvailable(ScanKernel::sse2) ? ScanKernel::sse2 : ScanKernel::scalar;
+	}
+#if defined(SCANNER_X86)
+	if (kernel == ScanKernel::avx2 && KernelAvailable(kernel)) {
+		findInteresting = FindInterestingAVX2;
+	} else if (kernel != ScanKernel::scalar) {
+		findInteresting = FindInterestingSSE2;
+	}
+#endif
+}
+
+bool TextScanner::KernelAvailable(ScanKernel kernel) noexcept {
+	switch (kernel) {
+#if defined(SCANNER_X86)
+	case ScanKernel::sse2:
+		return true;
+	case ScanKernel::avx2: {
+		static const bool hasAVX2 = ProcessorHasAVX2();
+		return hasAVX2;
+	}
+#endif
+	case ScanKernel::automatic:
+	case ScanKernel::scalar:
+		return true;
+	default:
+		return false;
+	}
+}
+
+size_t TextScanner::Scan(std::string_view chunk, bool atEnd) {
+	lineStarts.clear();
+	const size_t length = chunk.length();
+	if (length == 0 && !atEnd) {
+		return 0;
+	}
+	const char *const start = chunk.data();
+	const char *const end = start + length;
+	const char *p = start;
+
+	// Only one of these can be carried over as a partial character never ends with CR
+	if (lastWasCR && (p < end) && (*p == '\n')) {
+		// Second half of a CR+LF: the line start was reported after the CR
+		counts.cr--;
+		counts.crlf++;
+		p++;
+	}
+	lastWasCR = false;
+	if (pendingLength > 0) {
+		// Complete the character held back from the previous chunk
+		const size_t needed = UTF8BytesOfLead[pending[0]];
+		while (pendingLength < needed && p < end) {
+			pending[pendingLength++] = *p++;
+		}
+		if ((pendingLength < needed) && !atEnd && UTF8IsTruncated(pending, pendingLength)) {
+			position += length;
+			return length;
+		}
+		const bool wellFormed = (pendingLength == needed) && UTF8WellFormed(UTF8Classify(pending, pendingLength));
+		pendingLength = 0;
+		if (!wellFormed) {
+			// The bytes before this chunk have already been consumed
+			valid = false;
+			checkUTF8 = false;
+			return 0;
+		}
+		ascii = false;
+	}
+
+	while (p < end) {
+		p = findInteresting(p, end, checkUTF8);
+		if (p >= end) {
+			break;
+		}
+		const unsigned char ch = *p;
+		if (ch == '\n') {
+			counts.lf++;
+			p++;
+			lineStarts.push_back(p - start);
+		} else if (ch == '\r') {
+			p++;
+			if (p == end) {
+				// May be completed into a CR+LF by the next chunk
+				counts.cr++;
+				lastWasCR = true;
+			} else if (*p == '\n') {
+				counts.crlf++;
+				p++;
+			} else {
+				counts.cr++;
+			}
+			lineStarts.push_back(p - start);
+		} else {
+			const unsigned char *us = reinterpret_cast<const unsigned char *>(p);
+			const size_t remaining = end - p;
+			const int utf8Status = UTF8Classify(us, remaining);
+			if (UTF8WellFormed(utf8Status)) {
+				ascii = false;
+				p += utf8Status & UTF8MaskWidth;
+			} else if (!atEnd && UTF8IsTruncated(us, remaining)) {
+				memcpy(pending, us, remaining);
+				pendingLength = remaining;
+				break;
+			} else {
+				valid = false;
+				checkUTF8 = false;
+				const size_t consumed = p - start;
+				position += consumed;
+				return consumed;
+			}
+		}
+	}
+	position += length;
+	return length;
+}
+
+void TextScanner::SetCheckUTF8(bool checkUTF8_) noexcept {
+	checkUTF8 = checkUTF8_;
+	pendingLength = 0;
+}
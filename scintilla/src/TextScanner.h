@@ -0,0 +1,77 @@
+// Scintilla source code edit control
+/** @file TextScanner.h
+ ** Single pass scan of loaded text for UTF-8 validity, line ends and line starts.
+ **/
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#ifndef TEXTSCANNER_H
+#define TEXTSCANNER_H
+
+namespace Scintilla::Internal {
+
+// Implementations of the search for the next byte that needs attention.
+// automatic picks the widest one the processor supports.
+enum class ScanKernel { automatic, scalar, sse2, avx2 };
+
+struct LineEndCounts {
+	Sci::Position cr = 0;
+	Sci::Position lf = 0;
+	Sci::Position crlf = 0;
+};
+
+// Scans text arriving in chunks once, finding everything a loader needs to know:
+// whether it is valid UTF-8, how many of each line end it contains and where each line starts.
+// The line starts are found the same way as CellBuffer so they can be handed to
+// CellBuffer::AppendScannedText instead of scanning the text again when it is inserted.
+// Only CR, LF and CR+LF are line ends, Unicode line ends are not recognised.
+class TextScanner {
+	using FindFunction = const char *(*)(const char *p, const char *end, bool highBytes) noexcept;
+	FindFunction findInteresting;
+	std::vector<Sci::Position> lineStarts;
+	LineEndCounts counts;
+	Sci::Position position = 0;
+	unsigned char pending[UTF8MaxBytes] {};
+	size_t pendingLength = 0;
+	bool checkUTF8;
+	bool valid = true;
+	bool ascii = true;
+	bool lastWasCR = false;
+public:
+	explicit TextScanner(bool checkUTF8_, ScanKernel kernel=ScanKernel::automatic);
+	[[nodiscard]] static bool KernelAvailable(ScanKernel kernel) noexcept;
+
+	// Scan the next chunk. Returns the number of bytes consumed which is the whole chunk
+	// unless UTF-8 is being checked and an invalid sequence starts at the returned offset.
+	// Checking then stops so the rest of the chunk can be scanned again as other text.
+	// A character split by the end of the chunk is checked with the next chunk.
+	size_t Scan(std::string_view chunk, bool atEnd);
+	// Starting to check part way through discards any partial character
+	void SetCheckUTF8(bool checkUTF8_) noexcept;
+
+	// No invalid UTF-8 has been seen while checking
+	[[nodiscard]] bool Valid() const noexcept {
+		return valid;
+	}
+	// No byte outside ASCII has been consumed while checking
+	[[nodiscard]] bool AllASCII() const noexcept {
+		return ascii;
+	}
+	// Totals for everything scanned. A CR that ends a chunk counts as a CR until the next
+	// chunk shows whether it is the start of a CR+LF.
+	[[nodiscard]] const LineEndCounts &Counts() const noexcept {
+		return counts;
+	}
+	// Offsets from the start of the last chunk scanned to the lines that start in it.
+	// When the chunk continues a CR+LF no start is reported for its first LF.
+	[[nodiscard]] const std::vector<Sci::Position> &LineStarts() const noexcept {
+		return lineStarts;
+	}
+	// Total bytes consumed
+	[[nodiscard]] Sci::Position Length() const noexcept {
+		return position;
+	}
+};
+
+}
+
+#endif
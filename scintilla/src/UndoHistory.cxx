@@ -22,6 +22,16 @@
 #include <algorithm>
 #include <memory>
 
+#if defined(_WIN32)
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN 1
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#endif
+
 #include "ScintillaTypes.h"
 
 #include "Debugging.h"
@@ -34,6 +44,7 @@
 #include "ChangeHistory.h"
 #include "CellBuffer.h"
 #include "UndoHistory.h"
+#include "Compression.h"
 
 namespace Scintilla::Internal {
 
@@ -184,18 +195,258 @@ Sci::Position UndoActions::Length(int action) const noexcept {
 	return lengths.SignedValueAt(action);
 }
 
+namespace {
+
+// Opens a temporary file for reading and writing that is deleted when closed, or returns nullptr.
+// The tmpfile of the Windows C runtime used by MinGW creates its file in the root of the current
+// drive which normal users can not write to, so on Windows the file goes in the temporary directory.
+FILE *OpenTemporaryFile() noexcept {
+#if defined(_WIN32)
+	wchar_t directory[MAX_PATH + 1] {};
+	wchar_t path[MAX_PATH + 1] {};
+	const DWORD lengthDirectory = ::GetTempPathW(MAX_PATH + 1, directory);
+	if ((lengthDirectory == 0) || (lengthDirectory > MAX_PATH) ||
+		(::GetTempFileNameW(directory, L"sci", 0, path) == 0)) {
+		return nullptr;
+	}
+	// GetTempFileNameW created the file so it is opened again to be deleted when closed
+	HANDLE handle = ::CreateFileW(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		::DeleteFileW(path);
+		return nullptr;
+	}
+	const int fd = _open_osfhandle(reinterpret_cast<intptr_t>(handle), _O_RDWR | _O_BINARY);
+	if (fd == -1) {
+		::CloseHandle(handle);
+		return nullptr;
+	}
+	FILE *fp = _fdopen(fd, "w+b");
+	if (!fp) {
+		_close(fd);
+	}
+	return fp;
+#else
+	return std::tmpfile();
+#endif
+}
+
+}
+
+// A temporary file, deleted when closed, holding compressed segments end to end.
+class SpillFile {
+	FILE *fp;
+	int64_t end = 0;
+	bool Seek(int64_t offset) const noexcept {
+#if defined(_WIN32)
+		return _fseeki64(fp, offset, SEEK_SET) == 0;
+#else
+		return fseeko(fp, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+	}
+public:
+	SpillFile() noexcept : fp(OpenTemporaryFile()) {
+	}
+	// Deleted so SpillFile objects can not be copied.
+	SpillFile(const SpillFile &) = delete;
+	SpillFile(SpillFile &&) = delete;
+	SpillFile &operator=(const SpillFile &) = delete;
+	SpillFile &operator=(SpillFile &&) = delete;
+	~SpillFile() noexcept {
+		if (fp) {
+			fclose(fp);
+		}
+	}
+	// Returns the offset written at or -1 on failure.
+	int64_t Write(std::string_view block) noexcept {
+		if (!fp || !Seek(end) || (fwrite(block.data(), 1, block.length(), fp) != block.length())) {
+			return -1;
+		}
+		const int64_t offset = end;
+		end += block.length();
+		return offset;
+	}
+	void Read(int64_t offset, char *data, size_t length) const {
+		if (!fp || !Seek(offset) || (fread(data, 1, length, fp) != length)) {
+			throw std::runtime_error("ScrapStack: can not read spilled undo text.");
+		}
+	}
+	// Later writes reuse the space from offset onwards.
+	void Discard(int64_t offset) noexcept {
+		end = std::min(end, offset);
+	}
+};
+
+void ScrapStack::Window::Clear() noexcept {
+	start = 0;
+	text.clear();
+}
+
+bool ScrapStack::Window::Contains(size_t position, size_t length) const noexcept {
+	return (position >= start) && ((position + length) <= (start + text.length()));
+}
+
+ScrapStack::ScrapStack(size_t segmentSize_) : segmentSize(segmentSize_) {
+}
+
+ScrapStack::~ScrapStack() noexcept = default;
+
 void ScrapStack::Clear() noexcept {
 	stack.clear();
+	base = 0;
 	current = 0;
+	segments.clear();
+	firstInMemory = 0;
+	blocksMemory = 0;
+	blocksSpilled = 0;
+	if (spillFailed) {
+		// Try for a new file next time
+		spill.reset();
+		spillFailed = false;
+	} else if (spill) {
+		spill->Discard(0);
+	}
+	stepWindow.Clear();
+	textWindow.Clear();
+}
+
+// Remove the text from position onwards.
+void ScrapStack::Truncate(size_t position) {
+	stepWindow.Clear();
+	textWindow.Clear();
+	if (position >= base) {
+		stack.resize(position - base);
+		return;
+	}
+	// Expand the segment holding position back into the stack and drop it and those after it
+	const size_t first = position / segmentSize;
+	std::string text;
+	AppendSegment(first, text);
+	text.resize(position - first * segmentSize);
+	for (size_t segment = first; segment < segments.size(); segment++) {
+		const Segment &seg = segments[segment];
+		if (seg.offset >= 0) {
+			spill->Discard(seg.offset);
+			blocksSpilled -= seg.blockLength;
+		} else {
+			blocksMemory -= seg.blockLength;
+		}
+	}
+	segments.resize(first);
+	firstInMemory = std::min(firstInMemory, first);
+	stack = std::move(text);
+	base = first * segmentSize;
+}
+
+// Bring memory back within the limit before incoming bytes are added.
+void ScrapStack::Compact(size_t incoming) {
+	if ((stack.length() + incoming + blocksMemory) <= memoryLimit) {
+		return;
+	}
+	// Compress the oldest text down to half the limit so that the stack is not moved for each action
+	size_t compressed = 0;
+	while (((stack.length() - compressed) >= segmentSize) && ((stack.length() - compressed) > (memoryLimit / 2))) {
+		const std::string_view text(stack.data() + compressed, segmentSize);
+		Segment segment;
+		segment.block = CompressBlock(text);
+		if (segment.block.length() >= segmentSize) {
+			segment.block = text;
+			segment.stored = true;
+		}
+		segment.block.shrink_to_fit();
+		segment.blockLength = segment.block.length();
+		blocksMemory += segment.blockLength;
+		segments.push_back(std::move(segment));
+		compressed += segmentSize;
+	}
+	if (compressed > 0) {
+		stack.erase(0, compressed);
+		base += compressed;
+	}
+	// Write the oldest compressed segments out. If there is no temporary file they stay in memory.
+	while (((stack.length() + incoming + blocksMemory) > memoryLimit) && (firstInMemory < segments.size())) {
+		Spill(firstInMemory);
+		if (segments[firstInMemory].offset < 0) {
+			break;
+		}
+		firstInMemory++;
+	}
+}
+
+void ScrapStack::Spill(size_t segment) {
+	if (!spill) {
+		spill = std::make_unique<SpillFile>();
+	}
+	Segment &seg = segments[segment];
+	const int64_t offset = spill->Write(seg.block);
+	if (offset >= 0) {
+		seg.offset = offset;
+		std::string().swap(seg.block);
+		blocksMemory -= seg.blockLength;
+		blocksSpilled += seg.blockLength;
+	} else {
+		spillFailed = true;
+	}
+}
+
+void ScrapStack::AppendSegment(size_t segment, std::string &text) const {
+	const Segment &seg = segments[segment];
+	std::string spilled;
+	std::string_view block = seg.block;
+	if (seg.offset >= 0) {
+		spilled.resize(seg.blockLength);
+		spill->Read(seg.offset, spilled.data(), seg.blockLength);
+		block = spilled;
+	}
+	if (seg.stored) {
+		text.append(block);
+	} else {
+		const size_t length = text.length();
+		text.resize(length + segmentSize);
+		DecompressBlock(block, text.data() + length, segmentSize);
+	}
+}
+
+const char *ScrapStack::WindowText(size_t position, size_t length, Window &window) const {
+	if (position >= base) {
+		return stack.data() + position - base;
+	}
+	if (length == 0) {
+		return stack.data();
+	}
+	if (window.Contains(position, length)) {
+		return window.text.data() + position - window.start;
+	}
+	// Text may continue over several segments and into the stack
+	const size_t end = position + length;
+	const size_t first = position / segmentSize;
+	window.Clear();
+	try {
+		window.start = first * segmentSize;
+		for (size_t segment = first; (segment < segments.size()) && ((segment * segmentSize) < end); segment++) {
+			AppendSegment(segment, window.text);
+		}
+		if (end > base) {
+			window.text.append(stack, 0, end - base);
+		}
+	} catch (...) {
+		window.Clear();
+		throw;
+	}
+	return window.text.data() + position - window.start;
 }
 
 const char *ScrapStack::Push(const char *text, size_t length) {
-	if (current < stack.length()) {
-		stack.resize(current);
+	if (current < (base + stack.length())) {
+		Truncate(current);
+	}
+	if (memoryLimit) {
+		// Before appending so the text returned stays valid until the next change
+		Compact(length);
 	}
 	stack.append(text, length);
-	current = stack.length();
-	return stack.data() + current - length;
+	current = base + stack.length();
+	return stack.data() + stack.length() - length;
 }
 
 void ScrapStack::SetCurrent(size_t position) noexcept {
@@ -203,7 +454,7 @@ void ScrapStack::SetCurrent(size_t position) noexcept {
 }
 
 void ScrapStack::MoveForward(size_t length) noexcept {
-	if ((current + length) <= stack.length()) {
+	if ((current + length) <= (base + stack.length())) {
 		current += length;
 	}
 }
@@ -214,12 +465,40 @@ void ScrapStack::MoveBack(size_t length) noexcept {
 	}
 }
 
-const char *ScrapStack::CurrentText() const noexcept {
-	return stack.data() + current;
+size_t ScrapStack::CurrentPosition() const noexcept {
+	return current;
+}
+
+const char *ScrapStack::TextAt(size_t position, size_t length) const {
+	return WindowText(position, length, textWindow);
+}
+
+const char *ScrapStack::StepText(size_t position, size_t length) const {
+	return WindowText(position, length, stepWindow);
+}
+
+void ScrapStack::SetMemoryLimit(size_t limit) {
+	memoryLimit = limit;
+	if (memoryLimit) {
+		Compact(0);
+	}
+}
+
+size_t ScrapStack::MemoryLimit() const noexcept {
+	return memoryLimit;
 }
 
-const char *ScrapStack::TextAt(size_t position) const noexcept {
-	return stack.data() + position;
+size_t ScrapStack::MemoryUsage() const noexcept {
+	return stack.capacity() + blocksMemory + segments.capacity() * sizeof(Segment) +
+		stepWindow.text.capacity() + textWindow.text.capacity();
+}
+
+size_t ScrapStack::SpilledBytes() const noexcept {
+	return blocksSpilled;
+}
+
+bool ScrapStack::SpillFailed() const noexcept {
+	return spillFailed;
 }
 
 // The undo history stores a sequence of user operations that represent the user's view of the
@@ -325,6 +604,10 @@ const char *UndoHistory::AppendAction(ActionType at, Sci::Position position, con
 		actions.PushBack();
 	} else {
 		actions.Truncate(currentAction+1);
+		if (memory && (memory->act > currentAction)) {
+			// Remembered position was for an action that has been replaced
+			memory = {};
+		}
 	}
 	actions.Create(currentAction, at, position, lengthData, mayCoalesce);
 	currentAction++;
@@ -495,23 +778,33 @@ Sci::Position UndoHistory::Length(int action) const noexcept {
 	return actions.Length(action);
 }
 
-std::string_view UndoHistory::Text(int action) noexcept {
-	// Assumes first call after any changes is for action 0.
-	// TODO: may need to invalidate memory in other circumstances
+std::string_view UndoHistory::Text(int action) {
 	if (action == 0) {
 		memory = {};
 	}
+	// Start from whichever known scrap position is nearest: the start, the last action
+	// looked at or the current action whose text starts at the scraps current position.
+	// Reading the actions recently added is then proportional to their number, not to
+	// the length of the whole history.
 	int act = 0;
 	size_t position = 0;
 	if (memory && memory->act <= action) {
 		act = memory->act;
 		position = memory->position;
 	}
+	const int fromCurrent = (action < currentAction) ? currentAction - action : action - currentAction;
+	if (fromCurrent < action - act) {
+		act = currentAction;
+		position = scraps->CurrentPosition();
+		for (; act > action; act--) {
+			position -= actions.Length(act - 1);
+		}
+	}
 	for (; act < action; act++) {
 		position += actions.Length(act);
 	}
 	const size_t length = actions.Length(action);
-	const char *scrap = scraps->TextAt(position);
+	const char *scrap = scraps->TextAt(position, length);
 	memory = {action, position};
 	return {scrap, length};
 }
@@ -577,7 +870,7 @@ int UndoHistory::StartUndo() const noexcept {
 	return currentAction - act;
 }
 
-Action UndoHistory::GetUndoStep() const noexcept {
+Action UndoHistory::GetUndoStep() const {
 	const int previousAction = PreviousAction();
 	Action acta {
 		actions.types[previousAction].at,
@@ -587,7 +880,7 @@ Action UndoHistory::GetUndoStep() const noexcept {
 		actions.Length(previousAction)
 	};
 	if (acta.lenData) {
-		acta.data = scraps->CurrentText() - acta.lenData;
+		acta.data = scraps->StepText(scraps->CurrentPosition() - acta.lenData, acta.lenData);
 	}
 	return acta;
 }
@@ -621,7 +914,7 @@ int UndoHistory::StartRedo() const noexcept {
 	return act - currentAction + 1;
 }
 
-Action UndoHistory::GetRedoStep() const noexcept {
+Action UndoHistory::GetRedoStep() const {
 	Action acta{
 		actions.types[currentAction].at,
 		actions.types[currentAction].mayCoalesce,
@@ -630,7 +923,7 @@ Action UndoHistory::GetRedoStep() const noexcept {
 		actions.Length(currentAction)
 	};
 	if (acta.lenData) {
-		acta.data = scraps->CurrentText();
+		acta.data = scraps->StepText(scraps->CurrentPosition(), acta.lenData);
 	}
 	return acta;
 }
@@ -640,4 +933,21 @@ void UndoHistory::CompletedRedoStep() noexcept {
 	currentAction++;
 }
 
+void UndoHistory::SetMemoryLimit(size_t limit) {
+	scraps->SetMemoryLimit(limit);
+}
+
+size_t UndoHistory::MemoryLimit() const noexcept {
+	return scraps->MemoryLimit();
+}
+
+size_t UndoHistory::MemoryUsage() const noexcept {
+	return actions.types.capacity() * sizeof(UndoActionType) +
+		actions.positions.SizeInBytes() + actions.lengths.SizeInBytes() + scraps->MemoryUsage();
+}
+
+bool UndoHistory::SpillFailed() const noexcept {
+	return scraps->SpillFailed();
+}
+
 }
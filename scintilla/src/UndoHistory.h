@@ -62,17 +62,76 @@ struct UndoActions {
 	[[nodiscard]] Sci::Position Length(int action) const noexcept;
 };
 
+// ScrapStack holds the text of all actions end to end.
+// With a memory limit, once the text exceeds the limit the oldest text is compressed in
+// segments of segmentSize and, if still over the limit, the compressed segments are written
+// to a temporary file. Segments are expanded into a window when their text is needed.
+
+class SpillFile;
+
 class ScrapStack {
+	struct Segment {
+		std::string block;	// Compressed text, empty after spilling
+		size_t blockLength = 0;
+		bool stored = false;	// Did not compress so block is the text
+		int64_t offset = -1;	// Position in spill file or -1 when in memory
+	};
+	// Text copied from segments, starting at position start of the stack.
+	struct Window {
+		size_t start = 0;
+		std::string text;
+		void Clear() noexcept;
+		[[nodiscard]] bool Contains(size_t position, size_t length) const noexcept;
+	};
+	size_t segmentSize;
+	size_t memoryLimit = 0;
+	// Text from base onwards is uncompressed in stack, text before is in segments.
 	std::string stack;
+	size_t base = 0;
 	size_t current = 0;
+	std::vector<Segment> segments;
+	size_t firstInMemory = 0;
+	size_t blocksMemory = 0;
+	size_t blocksSpilled = 0;
+	bool spillFailed = false;
+	std::unique_ptr<SpillFile> spill;
+	// Separate windows so the text of an undo step stays valid while other text is read
+	mutable Window stepWindow;
+	mutable Window textWindow;
+
+	void Truncate(size_t position);
+	void Compact(size_t incoming);
+	void Spill(size_t segment);
+	void AppendSegment(size_t segment, std::string &text) const;
+	const char *WindowText(size_t position, size_t length, Window &window) const;
 public:
+	static constexpr size_t defaultSegmentSize = 256 * 1024;
+
+	explicit ScrapStack(size_t segmentSize_=defaultSegmentSize);
+	// Deleted so ScrapStack objects can not be copied.
+	ScrapStack(const ScrapStack &) = delete;
+	ScrapStack(ScrapStack &&) = delete;
+	ScrapStack &operator=(const ScrapStack &) = delete;
+	ScrapStack &operator=(ScrapStack &&) = delete;
+	~ScrapStack() noexcept;
+
 	void Clear() noexcept;
 	const char *Push(const char *text, size_t length);
 	void SetCurrent(size_t position) noexcept;
 	void MoveForward(size_t length) noexcept;
 	void MoveBack(size_t length) noexcept;
-	[[nodiscard]] const char *CurrentText() const noexcept;
-	[[nodiscard]] const char *TextAt(size_t position) const noexcept;
+	[[nodiscard]] size_t CurrentPosition() const noexcept;
+	// The text returned stays valid until the next call to the same method or a change.
+	[[nodiscard]] const char *TextAt(size_t position, size_t length) const;
+	[[nodiscard]] const char *StepText(size_t position, size_t length) const;
+
+	/// 0 means no limit so text is never compressed.
+	void SetMemoryLimit(size_t limit);
+	[[nodiscard]] size_t MemoryLimit() const noexcept;
+	[[nodiscard]] size_t MemoryUsage() const noexcept;
+	[[nodiscard]] size_t SpilledBytes() const noexcept;
+	// Text over the limit stays in memory when the temporary file can not be created or written.
+	[[nodiscard]] bool SpillFailed() const noexcept;
 };
 
 constexpr int coalesceFlag = 0x100;
@@ -132,7 +191,7 @@ public:
 	[[nodiscard]] int Type(int action) const noexcept;
 	[[nodiscard]] Sci::Position Position(int action) const noexcept;
 	[[nodiscard]] Sci::Position Length(int action) const noexcept;
-	[[nodiscard]] std::string_view Text(int action) noexcept;
+	[[nodiscard]] std::string_view Text(int action);
 	void PushUndoActionType(int type, Sci::Position position);
 	void ChangeLastUndoActionText(size_t length, const char *text);
 
@@ -148,12 +207,18 @@ public:
 	/// called that many times. Similarly for redo.
 	bool CanUndo() const noexcept;
 	int StartUndo() const noexcept;
-	Action GetUndoStep() const noexcept;
+	Action GetUndoStep() const;
 	void CompletedUndoStep() noexcept;
 	bool CanRedo() const noexcept;
 	int StartRedo() const noexcept;
-	Action GetRedoStep() const noexcept;
+	Action GetRedoStep() const;
 	void CompletedRedoStep() noexcept;
+
+	/// Text of actions beyond the memory limit is compressed then spilled to a temporary file.
+	void SetMemoryLimit(size_t limit);
+	[[nodiscard]] size_t MemoryLimit() const noexcept;
+	[[nodiscard]] size_t MemoryUsage() const noexcept;
+	[[nodiscard]] bool SpillFailed() const noexcept;
 };
 
 }
@@ -6,6 +6,8 @@
 // The License.txt file describes the conditions under which this software may be distributed.
 
 #include <cstdlib>
+#include <cstdint>
+#include <cstring>
 
 #include <stdexcept>
 #include <string>
@@ -455,4 +457,136 @@ std::string FixInvalidUTF8(const std::string &text) {
 	return result;
 }
 
+
+UTF8FromUTF16Stream::UTF8FromUTF16Stream(bool bigEndian_) noexcept : bigEndian(bigEndian_) {
+}
+
+void UTF8FromUTF16Stream::AppendUnit(unsigned int unit, char *putf, size_t &k) noexcept {
+	if (leadSurrogate) {
+		if (unit >= SURROGATE_TRAIL_FIRST && unit <= SURROGATE_TRAIL_LAST) {
+			const int uch = SUPPLEMENTAL_PLANE_FIRST + ((leadSurrogate & maskSurrogate) << shiftSurrogate) + (unit & maskSurrogate);
+			UTF8AppendCharacter(uch, putf, k);
+			leadSurrogate = 0;
+			return;
+		}
+		UTF8AppendCharacter(unicodeReplacementChar, putf, k);
+		leadSurrogate = 0;
+	}
+	if (unit >= SURROGATE_LEAD_FIRST && unit <= SURROGATE_LEAD_LAST) {
+		leadSurrogate = unit;
+	} else if (unit >= SURROGATE_TRAIL_FIRST && unit <= SURROGATE_TRAIL_LAST) {
+		UTF8AppendCharacter(unicodeReplacementChar, putf, k);
+	} else {
+		UTF8AppendCharacter(unit, putf, k);
+	}
+}
+
+size_t UTF8FromUTF16Stream::Convert(std::string_view chunk, char *putf, size_t len, bool atEnd) {
+	if (len < MaxOutput(chunk.length())) {
+		throw std::runtime_error("UTF8FromUTF16Stream: output buffer too small.");
+	}
+	const unsigned char *us = reinterpret_cast<const unsigned char *>(chunk.data());
+	const size_t length = chunk.length();
+	const size_t high = bigEndian ? 0 : 1;
+	const size_t low = 1 - high;
+	size_t i = 0;
+	size_t k = 0;
+	if (oddByte >= 0 && length > 0) {
+		// Byte pair split by the previous chunk
+		const unsigned char pair[2] = { static_cast<unsigned char>(oddByte), us[0] };
+		AppendUnit((pair[high] << 8) | pair[low], putf, k);
+		oddByte = -1;
+		i = 1;
+	}
+	for (; i + 2 <= length; i += 2) {
+		const unsigned int unit = (us[i + high] << 8) | us[i + low];
+		if (unit < first2Byte && !leadSurrogate) {
+			putf[k++] = static_cast<char>(unit);
+		} else {
+			AppendUnit(unit, putf, k);
+		}
+	}
+	if (i < length) {
+		oddByte = us[i];
+	}
+	if (atEnd) {
+		if (leadSurrogate) {
+			UTF8AppendCharacter(unicodeReplacementChar, putf, k);
+		}
+		if (oddByte >= 0) {
+			UTF8AppendCharacter(unicodeReplacementChar, putf, k);
+		}
+		Reset();
+	}
+	return k;
+}
+
+void UTF8FromUTF16Stream::Reset() noexcept {
+	leadSurrogate = 0;
+	oddByte = -1;
+}
+
+bool UTF8IsTruncated(const unsigned char *us, size_t len) noexcept {
+	if (!UTF8IsFirstByte(us[0]) || UTF8BytesOfLead[us[0]] <= len) {
+		return false;
+	}
+	for (size_t i = 1; i < len; i++) {
+		if (!UTF8IsTrailByte(us[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UTF8Validator::Check(std::string_view chunk, bool atEnd) noexcept {
+	const unsigned char *us = reinterpret_cast<const unsigned char *>(chunk.data());
+	const size_t length = chunk.length();
+	size_t i = 0;
+	if (pendingLength > 0 && valid) {
+		// Complete the character held back from the previous chunk
+		const size_t needed = UTF8BytesOfLead[pending[0]];
+		while (pendingLength < needed && i < length) {
+			pending[pendingLength++] = us[i++];
+		}
+		if (pendingLength < needed) {
+			valid = !atEnd && UTF8IsTruncated(pending, pendingLength);
+			return valid;
+		}
+		valid = UTF8WellFormed(UTF8Classify(pending, pendingLength));
+		pendingLength = 0;
+	}
+	while (i < length && valid) {
+		// Skip ASCII 8 bytes at a time
+		while (i + sizeof(uint64_t) <= length) {
+			uint64_t word = 0;
+			memcpy(&word, us + i, sizeof(word));
+			if (word & 0x8080808080808080ULL) {
+				break;
+			}
+			i += sizeof(word);
+		}
+		if (i >= length) {
+			break;
+		}
+		if (UTF8IsAscii(us[i])) {
+			i++;
+			continue;
+		}
+		ascii = false;
+		const size_t remaining = length - i;
+		const int utf8Status = UTF8Classify(us + i, remaining);
+		if (!UTF8WellFormed(utf8Status)) {
+			if (!atEnd && UTF8IsTruncated(us + i, remaining)) {
+				memcpy(pending, us + i, remaining);
+				pendingLength = remaining;
+				return valid;
+			}
+			valid = false;
+			break;
+		}
+		i += utf8Status & UTF8MaskWidth;
+	}
+	return valid;
+}
+
 }
@@ -69,6 +69,14 @@ inline int UTF8Classify(std::string_view sv) noexcept {
 	return UTF8Classify(sv.data(), sv.length());
 }
 
+constexpr bool UTF8WellFormed(int utf8Status) noexcept {
+	// Non-characters are flagged invalid but have their full width
+	return !(utf8Status & UTF8MaskInvalid) || ((utf8Status & UTF8MaskWidth) > 1);
+}
+
+// Could the len bytes at us be the start of a valid character that continues in the next chunk?
+bool UTF8IsTruncated(const unsigned char *us, size_t len) noexcept;
+
 // Similar to UTF8Classify but returns a length of 1 for invalid bytes
 // instead of setting the invalid flag
 int UTF8DrawBytes(const char *s, size_t len) noexcept;
@@ -111,6 +119,47 @@ constexpr unsigned int UTF16LengthFromUTF8ByteCount(unsigned int byteCount) noex
 	return (byteCount < 4) ? 1 : 2;
 }
 
+// Streaming conversions for text that arrives in chunks such as blocks of a file.
+// A character split between chunks is held back until the next chunk completes it
+// so memory use is bounded by the chunk size.
+
+// Converts little or big endian UTF-16 bytes to UTF-8.
+// Unpaired surrogates and a final odd byte become the replacement character.
+class UTF8FromUTF16Stream {
+	bool bigEndian;
+	unsigned int leadSurrogate = 0;
+	int oddByte = -1;
+	void AppendUnit(unsigned int unit, char *putf, size_t &k) noexcept;
+public:
+	explicit UTF8FromUTF16Stream(bool bigEndian_) noexcept;
+	// Output space Convert needs for a chunk of length bytes
+	static constexpr size_t MaxOutput(size_t length) noexcept {
+		return (length / 2 + 3) * 3;
+	}
+	// Returns the number of bytes written to putf which must hold MaxOutput(chunk.length())
+	size_t Convert(std::string_view chunk, char *putf, size_t len, bool atEnd);
+	void Reset() noexcept;
+};
+
+// Checks that text arriving in chunks is well formed UTF-8.
+// Non-characters like U+FFFE are accepted as they are correctly encoded.
+class UTF8Validator {
+	unsigned char pending[UTF8MaxBytes] {};
+	size_t pendingLength = 0;
+	bool valid = true;
+	bool ascii = true;
+public:
+	// Returns false once any invalid sequence has been seen.
+	bool Check(std::string_view chunk, bool atEnd) noexcept;
+	[[nodiscard]] bool Valid() const noexcept {
+		return valid;
+	}
+	// No byte outside ASCII has been seen yet
+	[[nodiscard]] bool AllASCII() const noexcept {
+		return ascii;
+	}
+};
+
 }
 
 #endif
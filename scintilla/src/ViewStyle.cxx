@@ -250,6 +250,7 @@ ViewStyle::ViewStyle(size_t stylesSize_) :
 	theEdge = EdgeProperties(0, ColourRGBA::Grey(light));
 
 	marginNumberPadding = 3;
+	lineNumberOffset = 0;
 	ctrlCharPadding = 3; // +3 For a blank on front and rounded edge each side
 	lastSegItalicsOffset = 2;
 
@@ -323,6 +324,7 @@ ViewStyle::ViewStyle(const ViewStyle &source) : ViewStyle(source.styles.size())
 	theMultiEdge = source.theMultiEdge;
 
 	marginNumberPadding = source.marginNumberPadding;
+	lineNumberOffset = source.lineNumberOffset;
 	ctrlCharPadding = source.ctrlCharPadding;
 	lastSegItalicsOffset = source.lastSegItalicsOffset;
 
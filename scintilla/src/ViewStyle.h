@@ -177,6 +177,7 @@ public:
 	EdgeProperties theEdge;
 	std::vector<EdgeProperties> theMultiEdge;
 	int marginNumberPadding; // the right-side padding of the number margin
+	Sci::Line lineNumberOffset; // added to the line numbers shown in number margins
 	int ctrlCharPadding; // the padding around control character text blobs
 	int lastSegItalicsOffset; // the offset so as not to clip italic characters at EOLs
 	int autocStyle;
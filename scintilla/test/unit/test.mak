@@ -18,14 +18,19 @@ TESTEDSRC=\
  ../../src/ChangeHistory.cxx \
  ../../src/CharacterCategoryMap.cxx \
  ../../src/CharClassify.cxx \
+ ../../src/Compression.cxx \
  ../../src/ContractionState.cxx \
  ../../src/Decoration.cxx \
  ../../src/Document.cxx \
  ../../src/Geometry.cxx \
+ ../../src/LinearRegex.cxx \
+ ../../src/LiteralSearch.cxx \
  ../../src/PerLine.cxx \
+ ../../src/PieceTable.cxx \
  ../../src/RESearch.cxx \
  ../../src/RunStyles.cxx \
  ../../src/Selection.cxx \
+ ../../src/TextScanner.cxx \
  ../../src/UndoHistory.cxx \
  ../../src/UniConversion.cxx \
  ../../src/UniqueString.cxx
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <cassert>
 #include <cstring>
+#include <cstdio>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -13,6 +14,10 @@
 #include <optional>
 #include <algorithm>
 #include <memory>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
 
 #include "ScintillaTypes.h"
 
@@ -21,6 +26,7 @@
 #include "Position.h"
 #include "SplitVector.h"
 #include "Partitioning.h"
+#include "PartitionTree.h"
 #include "RunStyles.h"
 #include "SparseVector.h"
 #include "ChangeHistory.h"
@@ -46,18 +52,18 @@ TEST_CASE("ScrapStack") {
 		REQUIRE(memcmp(t, "abc", 3) == 0);
 
 		ss.MoveBack(3);
-		const char *text = ss.CurrentText();
+		const char *text = ss.StepText(ss.CurrentPosition(), 3);
 		REQUIRE(memcmp(text, "abc", 3) == 0);
 
 		ss.MoveForward(1);
-		const char *text2 = ss.CurrentText();
+		const char *text2 = ss.StepText(ss.CurrentPosition(), 2);
 		REQUIRE(memcmp(text2, "bc", 2) == 0);
 
 		ss.SetCurrent(1);
-		const char *text3 = ss.CurrentText();
+		const char *text3 = ss.StepText(ss.CurrentPosition(), 2);
 		REQUIRE(memcmp(text3, "bc", 2) == 0);
 
-		const char *text4 = ss.TextAt(2);
+		const char *text4 = ss.TextAt(2, 1);
 		REQUIRE(memcmp(text4, "c", 1) == 0);
 
 		ss.Clear();
@@ -66,12 +72,73 @@ TEST_CASE("ScrapStack") {
 	}
 }
 
+TEST_CASE("ScrapStackMemoryLimit") {
+
+	// Small segments so a few hundred bytes are compressed and spilled
+	constexpr size_t segmentSize = 64;
+	ScrapStack ss(segmentSize);
+	ss.SetMemoryLimit(256);
+	REQUIRE(256 == ss.MemoryLimit());
+
+	std::string all;
+	for (int i = 0; i < 200; i++) {
+		const std::string piece = "piece " + std::to_string(i) + ";";
+		ss.Push(piece.c_str(), piece.length());
+		all += piece;
+	}
+	REQUIRE(ss.CurrentPosition() == all.length());
+	REQUIRE(ss.SpilledBytes() > 0);
+
+	SECTION("Read") {
+		// Ranges within a segment, across segments, and across segments and the stack
+		for (size_t position = 0; position < all.length(); position += 37) {
+			for (const size_t length : { size_t{1}, size_t{10}, segmentSize, segmentSize * 3 }) {
+				const size_t lengthRead = std::min(length, all.length() - position);
+				REQUIRE(Equal(ss.TextAt(position, lengthRead), std::string_view(all).substr(position, lengthRead)));
+				REQUIRE(Equal(ss.StepText(position, lengthRead), std::string_view(all).substr(position, lengthRead)));
+			}
+		}
+	}
+
+	SECTION("WindowsIndependent") {
+		const char *step = ss.StepText(10, 20);
+		const char *text = ss.TextAt(700, 20);
+		REQUIRE(Equal(step, std::string_view(all).substr(10, 20)));
+		REQUIRE(Equal(text, std::string_view(all).substr(700, 20)));
+	}
+
+	SECTION("TruncateIntoSegments") {
+		// Pushing after moving back drops the later text, even when spilled
+		ss.SetCurrent(100);
+		ss.Push("new", 3);
+		all = all.substr(0, 100) + "new";
+		REQUIRE(ss.CurrentPosition() == all.length());
+		REQUIRE(Equal(ss.TextAt(0, all.length()), all));
+		for (int i = 0; i < 100; i++) {
+			ss.Push("0123456789", 10);
+			all += "0123456789";
+		}
+		REQUIRE(Equal(ss.TextAt(0, all.length()), all));
+		ss.MoveBack(10);
+		REQUIRE(Equal(ss.StepText(ss.CurrentPosition(), 10), "0123456789"));
+	}
+
+	SECTION("Clear") {
+		ss.Clear();
+		REQUIRE(0 == ss.SpilledBytes());
+		const char *text = ss.Push("1", 1);
+		REQUIRE(memcmp(text, "1", 1) == 0);
+	}
+}
+
 TEST_CASE("CellBuffer") {
+	const bool pieceTable = GENERATE(false, true);
+	const bool indexTree = GENERATE(false, true);
 
 	constexpr std::string_view sText = "Scintilla";
 	constexpr Sci::Position sLength = sText.length();
 
-	CellBuffer cb(true, false);
+	CellBuffer cb(true, false, pieceTable, false, indexTree);
 
 	SECTION("InsertOneLine") {
 		bool startSequence = false;
@@ -240,6 +307,39 @@ TEST_CASE("CellBuffer") {
 		REQUIRE(cb.Length() == 0);
 	}
 
+	SECTION("RangeView") {
+		// Scattered insertions leave a piece table in many pieces
+		std::string reference;
+		bool startSequence = false;
+		for (int i = 0; i < 40; i++) {
+			const std::string text = std::to_string(i) + "abcdefg\n";
+			const Sci::Position position = (i * 37) % (reference.length() + 1);
+			cb.InsertString(position, text.data(), text.length(), startSequence);
+			reference.insert(position, text);
+		}
+		const Sci::Position length = cb.Length();
+		for (Sci::Position start = 0; start < length; start += 23) {
+			for (const Sci::Position end : { start, start + 1, start + 9, start + 100, length }) {
+				const SplitView view = cb.RangeView(start, end);
+				REQUIRE(view.length == reference.length());
+				for (Sci::Position i = start; i < std::min(end, length); i++) {
+					REQUIRE(view.CharAt(i) == reference[i]);
+				}
+				if (pieceTable && (start > 0)) {
+					REQUIRE(view.CharAt(start - 1) == 0);
+				}
+			}
+		}
+		// Deleting across pieces records the deleted text
+		const char *deleted = cb.DeleteChars(5, 100, startSequence);
+		REQUIRE(Equal(deleted, std::string_view(reference).substr(5, 100)));
+		reference.erase(5, 100);
+		std::string contents(cb.Length(), '\0');
+		cb.GetCharRange(contents.data(), 0, cb.Length());
+		REQUIRE(contents == reference);
+		REQUIRE(cb.Lines() == static_cast<Sci::Line>(std::count(reference.begin(), reference.end(), '\n') + 1));
+	}
+
 }
 
 bool Equal(const Action &a, ActionType at, Sci::Position position, std::string_view value) noexcept {
@@ -644,6 +744,40 @@ TEST_CASE("UndoHistory") {
 		REQUIRE(uh.TentativeSteps() == -1);
 		REQUIRE(uh.CanUndo());
 	}
+
+	SECTION("TextWithoutStartingAtZero") {
+		// Texts of the latest actions can be read without first reading action 0
+		bool startSequence = false;
+		uh.AppendAction(ActionType::insert, 0, "ab", 2, startSequence, true);
+		uh.AppendAction(ActionType::insert, 2, "cde", 3, startSequence, true);
+		uh.AppendAction(ActionType::remove, 1, "b", 1, startSequence, true);
+		uh.AppendAction(ActionType::insert, 0, "fghi", 4, startSequence, true);
+		REQUIRE(uh.Text(2) == "b");
+		REQUIRE(uh.Text(3) == "fghi");
+		REQUIRE(uh.Text(1) == "cde");
+
+		// After undoing, the actions that can be redone are still readable
+		uh.StartUndo();
+		uh.GetUndoStep();
+		uh.CompletedUndoStep();
+		REQUIRE(uh.Current() == 3);
+		REQUIRE(uh.Text(2) == "b");
+		REQUIRE(uh.Text(3) == "fghi");
+
+		// Replacing undone actions must not reuse the remembered position of the old ones
+		uh.StartUndo();
+		uh.GetUndoStep();
+		uh.CompletedUndoStep();
+		uh.AppendAction(ActionType::insert, 1, "jk", 2, startSequence, false);
+		uh.AppendAction(ActionType::insert, 3, "l", 1, startSequence, true);
+		REQUIRE(uh.Actions() == 4);
+		REQUIRE(uh.Text(3) == "l");
+		REQUIRE(uh.Text(2) == "jk");
+		REQUIRE(uh.Text(0) == "ab");
+		REQUIRE(uh.Text(1) == "cde");
+		REQUIRE(uh.Text(2) == "jk");
+		REQUIRE(uh.Text(3) == "l");
+	}
 }
 
 TEST_CASE("UndoActions") {
@@ -671,8 +805,10 @@ TEST_CASE("UndoActions") {
 
 
 TEST_CASE("CharacterIndex") {
+	const bool pieceTable = GENERATE(false, true);
+	const bool indexTree = GENERATE(false, true);
 
-	CellBuffer cb(true, false);
+	CellBuffer cb(true, false, pieceTable, false, indexTree);
 
 	SECTION("Setup") {
 		REQUIRE(cb.LineCharacterIndex() == LineCharacterIndexType::None);
@@ -1321,9 +1457,10 @@ void RedoBlock(CellBuffer &cb) {
 }
 
 TEST_CASE("CellBufferWithChangeHistory") {
+	const bool pieceTable = GENERATE(false, true);
 
 	SECTION("StraightUndoRedoSaveRevertRedo") {
-		CellBuffer cb(true, false);
+		CellBuffer cb(true, false, pieceTable);
 		cb.SetUndoCollection(false);
 		constexpr std::string_view sInsert = "abcdefghijklmnopqrstuvwxyz";
 		bool startSequence = false;
@@ -1462,7 +1599,7 @@ TEST_CASE("CellBufferWithChangeHistory") {
 	}
 
 	SECTION("Detached") {
-		CellBuffer cb(true, false);
+		CellBuffer cb(true, false, pieceTable);
 		cb.SetUndoCollection(false);
 		constexpr std::string_view sInsert = "abcdefghijklmnopqrstuvwxyz";
 		bool startSequence = false;
@@ -1528,8 +1665,9 @@ void PushUndoAction(CellBuffer &cb, int type, Sci::Position pos, std::string_vie
 }
 
 TEST_CASE("CellBufferLoadUndoHistory") {
+	const bool pieceTable = GENERATE(false, true);
 
-	CellBuffer cb(false, false);
+	CellBuffer cb(false, false, pieceTable);
 	constexpr int remove = 1;
 	constexpr int insert = 0;
 
@@ -1611,12 +1749,183 @@ public:
 
 }
 
+TEST_CASE("CellBufferStyles") {
+	const bool styleRuns = GENERATE(false, true);
+	const bool indexTree = GENERATE(false, true);
+
+	CellBuffer cb(true, false, false, styleRuns, indexTree);
+	REQUIRE(styleRuns == cb.HasStyleRuns());
+	bool startSequence = false;
+	cb.InsertString(0, "0123456789", 10, startSequence);
+
+	const auto styles = [&cb](Sci::Position position, Sci::Position length) {
+		std::string result(length, '\0');
+		cb.GetStyleRange(reinterpret_cast<unsigned char *>(result.data()), position, length);
+		return result;
+	};
+
+	SECTION("Initial") {
+		REQUIRE(std::string(10, '\0') == styles(0, 10));
+		REQUIRE(0 == cb.StyleAt(-1));
+		REQUIRE(0 == cb.StyleAt(10));
+	}
+
+	SECTION("SetStyleAt") {
+		REQUIRE(cb.SetStyleAt(3, 5));
+		REQUIRE(!cb.SetStyleAt(3, 5));
+		REQUIRE(5 == cb.StyleAt(3));
+		REQUIRE(0 == cb.StyleAt(4));
+	}
+
+	SECTION("SetStyleFor") {
+		REQUIRE(cb.SetStyleFor(2, 4, 7));
+		REQUIRE(!cb.SetStyleFor(3, 2, 7));
+		REQUIRE(std::string("\0\0\7\7\7\7\0\0\0\0", 10) == styles(0, 10));
+		REQUIRE(std::string("\7\7\0", 3) == styles(4, 3));
+	}
+
+	SECTION("SetStyles") {
+		Sci::Position startChanged = -1;
+		Sci::Position endChanged = -1;
+		REQUIRE(cb.SetStyles(0, "\0\0\1\1\1\0\2\2\0\0", 10, startChanged, endChanged));
+		REQUIRE(2 == startChanged);
+		REQUIRE(7 == endChanged);
+		REQUIRE(std::string("\0\0\1\1\1\0\2\2\0\0", 10) == styles(0, 10));
+		REQUIRE(!cb.SetStyles(1, "\0\1\1", 3, startChanged, endChanged));
+		REQUIRE(cb.SetStyles(3, "\1\3", 2, startChanged, endChanged));
+		REQUIRE(4 == startChanged);
+		REQUIRE(4 == endChanged);
+	}
+
+	SECTION("InsertionHasStyleZero") {
+		cb.SetStyleFor(0, 10, 4);
+		cb.InsertString(5, "ab", 2, startSequence);
+		REQUIRE(std::string("\4\4\4\4\4\0\0\4\4\4\4\4", 12) == styles(0, 12));
+		cb.InsertString(0, "c", 1, startSequence);
+		cb.InsertString(13, "d", 1, startSequence);
+		REQUIRE(0 == cb.StyleAt(0));
+		REQUIRE(4 == cb.StyleAt(1));
+		REQUIRE(0 == cb.StyleAt(13));
+	}
+
+	SECTION("Delete") {
+		Sci::Position startChanged = -1;
+		Sci::Position endChanged = -1;
+		cb.SetStyles(0, "\1\1\2\2\3\3\4\4\5\5", 10, startChanged, endChanged);
+		cb.DeleteChars(3, 4, startSequence);
+		REQUIRE(std::string("\1\1\2\4\5\5", 6) == styles(0, 6));
+		cb.DeleteChars(0, 6, startSequence);
+		REQUIRE(0 == cb.Length());
+		cb.InsertString(0, "x", 1, startSequence);
+		REQUIRE(0 == cb.StyleAt(0));
+	}
+
+	SECTION("MixedAccessMatchesString") {
+		// Reads, writes and edits interleaved so a cached run is reused after each kind of change
+		std::string reference(10, '\0');
+		RandomSequence rseq;
+		for (int i = 0; i < 5000; i++) {
+			const Sci::Position length = cb.Length();
+			const int action = rseq.Next() % 10;
+			const Sci::Position position = rseq.Next() % (length + 1);
+			const Sci::Position span = std::min<Sci::Position>(rseq.Next() % 8, length - position);
+			if (action < 3) {
+				const char value = static_cast<char>(rseq.Next() % 3);
+				cb.SetStyleFor(position, span, value);
+				std::fill(reference.begin() + position, reference.begin() + position + span, value);
+			} else if (action < 4) {
+				cb.InsertString(position, "abc", 3, startSequence);
+				reference.insert(position, 3, '\0');
+			} else if ((action < 5) && (span > 0)) {
+				cb.DeleteChars(position, span, startSequence);
+				reference.erase(position, span);
+			} else if (action < 8) {
+				REQUIRE(reference.substr(position, span) == styles(position, span));
+			} else if (position < length) {
+				REQUIRE(reference[position] == cb.StyleAt(position));
+			}
+		}
+		REQUIRE(reference == styles(0, cb.Length()));
+	}
+}
+
+TEST_CASE("CellBufferUndoMemoryLimit") {
+
+	// Several megabytes of changes with a 1 megabyte limit so most undo text is compressed
+	// or spilled then has to be read back to undo and redo.
+	CellBuffer cb(true, false);
+	constexpr size_t limit = 1024 * 1024;
+	cb.SetUndoMemoryLimit(limit);
+	REQUIRE(limit == cb.UndoMemoryLimit());
+
+	unsigned int seed = 3;
+	const auto randomText = [&seed](size_t length) {
+		std::string text;
+		for (size_t i = 0; i < length; i++) {
+			seed = seed * 1103515245u + 12345u;
+			text.push_back(static_cast<char>('a' + ((seed >> 16) % 26)));
+		}
+		return text;
+	};
+
+	std::vector<std::string> states;
+	const auto documentText = [&cb]() {
+		return std::string(cb.BufferPointer(), cb.Length());
+	};
+	states.push_back(documentText());
+	for (int change = 0; change < 40; change++) {
+		bool startSequence = false;
+		if ((change % 4) == 3) {
+			const Sci::Position length = cb.Length() / 3;
+			cb.DeleteChars(cb.Length() / 4, length, startSequence);
+		} else {
+			const std::string text = randomText(128 * 1024 + change);
+			cb.InsertString(cb.Length() / 2, text.c_str(), text.length(), startSequence);
+		}
+		states.push_back(documentText());
+	}
+	REQUIRE(!cb.UndoSpillFailed());
+	REQUIRE(cb.UndoMemory() < 2 * limit);
+
+	// Each change is a separate action so undo goes back through every state
+	for (size_t state = states.size() - 1; state > 0; state--) {
+		REQUIRE(cb.StartUndo() == 1);
+		cb.PerformUndoStep();
+		REQUIRE(documentText() == states[state - 1]);
+	}
+	REQUIRE(!cb.CanUndo());
+	for (size_t state = 1; state < states.size(); state++) {
+		REQUIRE(cb.StartRedo() == 1);
+		cb.PerformRedoStep();
+		REQUIRE(documentText() == states[state]);
+	}
+
+	// Undo half way then change so the later history is dropped
+	for (int step = 0; step < 20; step++) {
+		cb.StartUndo();
+		cb.PerformUndoStep();
+	}
+	bool startSequence = false;
+	cb.InsertString(0, "new", 3, startSequence);
+	REQUIRE(!cb.CanRedo());
+	cb.StartUndo();
+	cb.PerformUndoStep();
+	REQUIRE(documentText() == states[20]);
+	for (size_t state = 20; state > 0; state--) {
+		cb.StartUndo();
+		cb.PerformUndoStep();
+		REQUIRE(documentText() == states[state - 1]);
+	}
+}
+
 #if 1
 TEST_CASE("CellBufferLong") {
+	const bool pieceTable = GENERATE(false, true);
+	const bool indexTree = GENERATE(false, true);
 
 	// Call methods on CellBuffer pseudo-randomly trying  to trigger assertion failures
 
-	CellBuffer cb(true, false);
+	CellBuffer cb(true, false, pieceTable, false, indexTree);
 
 	SECTION("Random") {
 		RandomSequence rseq;
@@ -1656,3 +1965,463 @@ TEST_CASE("CellBufferLong") {
 	}
 }
 #endif
+
+// Measures keystrokes in a large document with and without the periodic capture of the
+// latest undo actions that background autosave performs between keystrokes.
+// Hidden, run with: unitTest [benchmark]
+TEST_CASE("AutosaveCaptureLatency", "[.][benchmark]") {
+
+	constexpr Sci::Position documentSize = 200 * 1024 * 1024;
+	constexpr int keystrokes = 20000;
+	constexpr int keystrokesPerCapture = 50;
+
+	using Clock = std::chrono::steady_clock;
+	const auto micros = [](Clock::duration d) {
+		return std::chrono::duration<double, std::micro>(d).count();
+	};
+
+	CellBuffer cb(true, false);
+	cb.SetUndoCollection(false);
+	{
+		const std::string line = "2024-01-01 12:00:00.000 INFO  [worker-3] request id=0000abcd status=200\n";
+		std::string block;
+		while (block.length() < 1024 * 1024) {
+			block += line;
+		}
+		bool startSequence = false;
+		while (cb.Length() < documentSize) {
+			cb.InsertString(cb.Length(), block.data(), block.length(), startSequence);
+		}
+	}
+	cb.SetUndoCollection(true);
+
+	// A long history already behind the edits being captured
+	for (int i = 0; i < 200000; i++) {
+		bool startSequence = false;
+		cb.InsertString(i % 1000, "x", 1, startSequence);
+	}
+
+	// Typing starts in the middle - move the gap there first so it isn't timed
+	Sci::Position position = documentSize / 2;
+	{
+		bool startSequence = false;
+		cb.InsertString(position, "y", 1, startSequence);
+		position++;
+	}
+
+	for (const bool capture : { false, true }) {
+		std::vector<double> times;
+		double captureTotal = 0.0;
+		double captureMax = 0.0;
+		int base = cb.UndoCurrent();
+		std::string delta;
+		for (int i = 0; i < keystrokes; i++) {
+			const auto start = Clock::now();
+			bool startSequence = false;
+			cb.InsertString(position, "y", 1, startSequence);
+			position++;
+			times.push_back(micros(Clock::now() - start));
+			if (capture && ((i + 1) % keystrokesPerCapture == 0)) {
+				const auto captureStart = Clock::now();
+				delta.clear();
+				const int current = cb.UndoCurrent();
+				for (int act = base; act < current; act++) {
+					const std::string_view text = cb.UndoActionText(act);
+					delta += static_cast<char>(cb.UndoActionType(act));
+					delta += std::to_string(cb.UndoActionPosition(act));
+					delta.append(text);
+				}
+				base = current;
+				const double elapsed = micros(Clock::now() - captureStart);
+				captureTotal += elapsed;
+				captureMax = std::max(captureMax, elapsed);
+			}
+		}
+		std::sort(times.begin(), times.end());
+		std::printf("%-22s keystroke median %6.2f us  p99 %6.2f us  max %8.2f us",
+			capture ? "With delta capture" : "Without capture",
+			times[times.size() / 2], times[times.size() * 99 / 100], times.back());
+		if (capture) {
+			std::printf("  capture mean %6.2f us  max %8.2f us",
+				captureTotal / (keystrokes / keystrokesPerCapture), captureMax);
+		}
+		std::printf("\n");
+	}
+}
+
+// Measures single character edits scattered through a large document with the text in a gap
+// buffer and in a piece table, then what reading the edited text back costs each of them.
+// There are no styles as those are in a gap buffer either way.
+// Hidden, run with: unitTest [benchmark]
+TEST_CASE("ScatteredEditThroughput", "[.][benchmark]") {
+
+	constexpr Sci::Position documentSize = 64 * 1024 * 1024;
+	constexpr int edits = 20000;
+
+	using Clock = std::chrono::steady_clock;
+	const auto millis = [](Clock::duration d) {
+		return std::chrono::duration<double, std::milli>(d).count();
+	};
+
+	for (const bool pieceTable : { false, true }) {
+		CellBuffer cb(false, false, pieceTable);
+		cb.SetUndoCollection(false);
+		{
+			const std::string line = "2024-01-01 12:00:00.000 INFO  [worker-3] request id=0000abcd status=200\n";
+			std::string block;
+			while (block.length() < 1024 * 1024) {
+				block += line;
+			}
+			cb.Allocate(documentSize + block.length());
+			bool startSequence = false;
+			while (cb.Length() < documentSize) {
+				cb.InsertString(cb.Length(), block.data(), block.length(), startSequence);
+			}
+		}
+		cb.SetUndoCollection(true);
+
+		unsigned long long seed = 1;
+		const auto start = Clock::now();
+		for (int i = 0; i < edits; i++) {
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			const Sci::Position position = static_cast<Sci::Position>((seed >> 20) % cb.Length());
+			bool startSequence = false;
+			if (i % 2 == 0) {
+				cb.InsertString(position, "y", 1, startSequence);
+			} else {
+				cb.DeleteChars(position, 1, startSequence);
+			}
+		}
+		const double editMs = millis(Clock::now() - start);
+
+		const auto startRead = Clock::now();
+		std::string text(cb.Length(), '\0');
+		cb.GetCharRange(text.data(), 0, cb.Length());
+		const double readMs = millis(Clock::now() - startRead);
+
+		const auto startView = Clock::now();
+		const SplitView view = cb.AllView();
+		const double viewMs = millis(Clock::now() - startView);
+		REQUIRE(view.CharAt(0) == text[0]);
+
+		std::printf("%-12s %6d edits %8.1f ms (%8.0f edits/s)  read %6.1f ms  view %6.1f ms\n",
+			pieceTable ? "Piece table" : "Gap buffer", edits, editMs, edits * 1000.0 / editMs, readMs, viewMs);
+	}
+}
+
+namespace {
+
+// Text and styles from a lexilla .styled file where {n} starts style n
+void ReadStyled(const std::filesystem::path &path, std::string &text, std::string &styles) {
+	std::ifstream file(path, std::ios::binary);
+	std::stringstream buffer;
+	buffer << file.rdbuf();
+	const std::string styled = buffer.str();
+	char style = 0;
+	for (size_t i = 0; i < styled.length(); i++) {
+		if (styled[i] == '{') {
+			const size_t close = styled.find('}', i);
+			if ((close != std::string::npos) && (close > i + 1) &&
+				(styled.find_first_not_of("0123456789", i + 1) == close)) {
+				style = static_cast<char>(std::stoi(styled.substr(i + 1, close - i - 1)));
+				i = close;
+				continue;
+			}
+		}
+		text.push_back(styled[i]);
+		styles.push_back(style);
+	}
+}
+
+}
+
+// Compares the memory taken by styles stored a byte per character and as runs for the
+// lexilla example files and a large generated log, then times lexer-like writes of
+// styles and renderer-like reads of each line and of each position with both stores.
+// Hidden, run with: unitTest [benchmark]
+TEST_CASE("StyleRunsMemory", "[.][benchmark]") {
+
+	using Clock = std::chrono::steady_clock;
+	const auto millis = [](Clock::duration d) {
+		return std::chrono::duration<double, std::milli>(d).count();
+	};
+	// Each run is a start position and a style byte with 32-bit positions in standard
+	// documents and 64-bit positions in large documents
+	constexpr double runBytes = sizeof(int) + sizeof(char);
+	constexpr double runBytesLarge = sizeof(Sci::Position) + sizeof(char);
+
+	const std::filesystem::path examples = "../../../lexilla/test/examples";
+	if (std::filesystem::is_directory(examples)) {
+		std::printf("%-12s %10s %10s %8s %12s %12s\n", "Examples", "Bytes", "Runs", "Avg run", "Runs/bytes", "Large");
+		std::vector<std::filesystem::path> directories;
+		for (const auto &entry : std::filesystem::directory_iterator(examples)) {
+			if (entry.is_directory())
+				directories.push_back(entry.path());
+		}
+		std::sort(directories.begin(), directories.end());
+		size_t bytesAll = 0;
+		size_t runsAll = 0;
+		for (const std::filesystem::path &directory : directories) {
+			size_t bytes = 0;
+			size_t runs = 0;
+			for (const auto &entry : std::filesystem::recursive_directory_iterator(directory)) {
+				if (entry.path().extension() != ".styled")
+					continue;
+				std::string text;
+				std::string styles;
+				ReadStyled(entry.path(), text, styles);
+				RunStyles<Sci::Position, char> rs;
+				rs.InsertSpace(0, styles.length());
+				for (size_t i = 0; i < styles.length(); i++) {
+					size_t end = i + 1;
+					while ((end < styles.length()) && (styles[end] == styles[i]))
+						end++;
+					rs.FillRange(i, styles[i], end - i);
+					i = end - 1;
+				}
+				bytes += styles.length();
+				runs += rs.Runs();
+			}
+			if (bytes == 0)
+				continue;
+			std::printf("%-12s %10zu %10zu %8.1f %12.2f %12.2f\n", directory.filename().string().c_str(),
+				bytes, runs, static_cast<double>(bytes) / runs, runs * runBytes / bytes, runs * runBytesLarge / bytes);
+			bytesAll += bytes;
+			runsAll += runs;
+		}
+		std::printf("%-12s %10zu %10zu %8.1f %12.2f %12.2f\n", "All", bytesAll, runsAll,
+			static_cast<double>(bytesAll) / runsAll, runsAll * runBytes / bytesAll, runsAll * runBytesLarge / bytesAll);
+	} else {
+		std::printf("No lexilla examples at %s\n", examples.string().c_str());
+	}
+
+	// A log styled as a log lexer would: time, level, source then default for the message
+	constexpr Sci::Position documentSize = 256 * 1024 * 1024;
+	std::string block;
+	std::string blockStyles;
+	const std::string_view levels[] = { "INFO ", "DEBUG", "WARN ", "ERROR" };
+	for (int i = 0; block.length() < 1024 * 1024; i++) {
+		const std::string_view parts[] = {
+			"2024-01-01 12:00:00.000", " ", levels[i % 7 % 4], " ", "[worker-3]",
+			" request id=0000abcd status=200 elapsed=12ms\n" };
+		const char partStyles[] = { 1, 0, static_cast<char>(2 + i % 7 % 4), 0, 6, 0 };
+		for (size_t part = 0; part < std::size(parts); part++) {
+			block.append(parts[part]);
+			blockStyles.append(parts[part].length(), partStyles[part]);
+		}
+	}
+
+	for (const bool styleRuns : { false, true }) {
+		CellBuffer cb(true, false, false, styleRuns);
+		cb.SetUndoCollection(false);
+		cb.Allocate(documentSize + block.length());
+		bool startSequence = false;
+		while (cb.Length() < documentSize) {
+			cb.InsertString(cb.Length(), block.data(), block.length(), startSequence);
+		}
+
+		// Lexers flush their styles in chunks of a few thousand
+		constexpr Sci::Position chunk = 4000;
+		const auto startWrite = Clock::now();
+		for (Sci::Position position = 0; position < cb.Length(); position += chunk) {
+			const Sci::Position length = std::min(chunk, cb.Length() - position);
+			const size_t offset = position % block.length();
+			Sci::Position startChanged = 0;
+			Sci::Position endChanged = 0;
+			if (offset + length <= block.length()) {
+				cb.SetStyles(position, blockStyles.data() + offset, length, startChanged, endChanged);
+			} else {
+				const std::string styles = blockStyles.substr(offset) + blockStyles.substr(0, length - (block.length() - offset));
+				cb.SetStyles(position, styles.data(), length, startChanged, endChanged);
+			}
+		}
+		const double writeMs = millis(Clock::now() - startWrite);
+
+		std::vector<unsigned char> lineStyles;
+		size_t check = 0;
+		const auto startRead = Clock::now();
+		for (Sci::Line line = 0; line < cb.Lines(); line++) {
+			const Sci::Position start = cb.LineStart(line);
+			const Sci::Position length = cb.LineStart(line + 1) - start;
+			lineStyles.resize(length);
+			cb.GetStyleRange(lineStyles.data(), start, length);
+			check += lineStyles.empty() ? 0 : lineStyles.front();
+		}
+		const double readMs = millis(Clock::now() - startRead);
+		REQUIRE(check > 0);
+
+		// Lexers and drawing also read one position at a time
+		const auto startReadAt = Clock::now();
+		for (Sci::Position position = 0; position < cb.Length(); position++) {
+			check += cb.StyleAt(position);
+		}
+		const double readAtMs = millis(Clock::now() - startReadAt);
+
+		const double megabytes = cb.Length() / (1024.0 * 1024.0);
+		if (styleRuns) {
+			RunStyles<int, char> rs;
+			rs.InsertSpace(0, static_cast<int>(cb.Length()));
+			Sci::Position position = 0;
+			while (position < cb.Length()) {
+				const Sci::Position end = std::min<Sci::Position>(position + block.length(), cb.Length());
+				for (Sci::Position i = position; i < end;) {
+					const char style = blockStyles[i - position];
+					Sci::Position runEnd = i + 1;
+					while ((runEnd < end) && (blockStyles[runEnd - position] == style))
+						runEnd++;
+					rs.FillRange(static_cast<int>(i), style, static_cast<int>(runEnd - i));
+					i = runEnd;
+				}
+				position = end;
+			}
+			std::printf("Log runs      %6.0f MB of styles as %.0f MB of runs", megabytes, rs.Runs() * runBytes / (1024.0 * 1024.0));
+		} else {
+			std::printf("Log bytes     %6.0f MB of styles", megabytes);
+		}
+		std::printf("  write %6.0f MB/s  read %6.0f MB/s  read each %6.0f MB/s\n", megabytes * 1000.0 / writeMs,
+			megabytes * 1000.0 / readMs, megabytes * 1000.0 / readAtMs);
+	}
+}
+
+// Measures typing with 1000 carets spread over a 10 million line document with the line
+// starts in a Partitioning and in a PartitionTree, then the cost of finding every line start.
+// The text is in a piece table without styles so the line starts dominate.
+// Hidden, run with: unitTest [benchmark]
+TEST_CASE("MultiCaretTyping", "[.][benchmark]") {
+
+	constexpr Sci::Line documentLines = 10'000'000;
+	constexpr Sci::Line carets = 1000;
+	constexpr int keystrokes = 20;
+
+	using Clock = std::chrono::steady_clock;
+	const auto millis = [](Clock::duration d) {
+		return std::chrono::duration<double, std::milli>(d).count();
+	};
+
+	const std::string line = "0000000\n";
+	std::string block;
+	while (block.length() < 1024 * 1024) {
+		block += line;
+	}
+	const Sci::Position documentSize = documentLines * line.length();
+
+	for (const bool indexTree : { false, true }) {
+		CellBuffer cb(false, false, true, false, indexTree);
+		cb.SetUndoCollection(false);
+		cb.Allocate(documentSize);
+		bool startSequence = false;
+		while (cb.Length() < documentSize) {
+			cb.InsertString(cb.Length(), block.data(), std::min<Sci::Position>(block.length(), documentSize - cb.Length()), startSequence);
+		}
+		cb.SetUndoCollection(true);
+		REQUIRE(documentLines + 1 == cb.Lines());
+
+		// Each keystroke inserts at every caret from first to last as Editor does
+		const auto start = Clock::now();
+		for (int keystroke = 0; keystroke < keystrokes; keystroke++) {
+			for (Sci::Line caret = 0; caret < carets; caret++) {
+				const Sci::Line lineCaret = caret * (documentLines / carets);
+				const Sci::Position position = cb.LineStart(lineCaret) + 3 + keystroke;
+				cb.InsertString(position, "x", 1, startSequence);
+			}
+		}
+		const double typeMs = millis(Clock::now() - start);
+		REQUIRE(documentSize + carets * keystrokes == cb.Length());
+		REQUIRE(cb.LineStart(documentLines - 1) == documentSize - static_cast<Sci::Position>(line.length()) + carets * keystrokes);
+
+		size_t check = 0;
+		const auto startLookup = Clock::now();
+		for (Sci::Line l = 0; l < cb.Lines(); l++) {
+			check += cb.LineStart(l);
+		}
+		const double lookupMs = millis(Clock::now() - startLookup);
+		REQUIRE(check > 0);
+
+		std::printf("%-16s %4d keystrokes at %lld carets %9.1f ms (%8.3f ms each)  every line start %6.1f ms\n",
+			indexTree ? "PartitionTree" : "Partitioning", keystrokes, static_cast<long long>(carets),
+			typeMs, typeMs / keystrokes, lookupMs);
+	}
+
+	// The same keystrokes on the line starts alone
+	const auto typeLines = [&](auto &starts) {
+		std::vector<int> positions;
+		for (Sci::Line l = 1; l <= documentLines; l++) {
+			positions.push_back(static_cast<int>(l * line.length()));
+		}
+		starts.InsertText(0, static_cast<int>(documentSize));
+		starts.InsertPartitions(1, positions.data(), positions.size() - 1);
+		const auto startLines = Clock::now();
+		for (int keystroke = 0; keystroke < keystrokes; keystroke++) {
+			for (Sci::Line caret = 0; caret < carets; caret++) {
+				starts.InsertText(static_cast<int>(caret * (documentLines / carets)), 1);
+			}
+		}
+		REQUIRE(documentSize + carets * keystrokes == starts.Length());
+		return millis(Clock::now() - startLines);
+	};
+	Partitioning<int> partitioning(256);
+	PartitionTree<int> tree;
+	const double partitioningMs = typeLines(partitioning);
+	const double treeMs = typeLines(tree);
+	std::printf("Line starts only: Partitioning %8.3f ms  PartitionTree %8.3f ms each keystroke\n",
+		partitioningMs / keystrokes, treeMs / keystrokes);
+}
+
+// Measures the memory held by undo after large replacements in a log file with no limit and
+// with a 32 MB limit, and the time to make the changes and then undo them all.
+// Hidden, run with: unitTest [benchmark]
+TEST_CASE("UndoMemory", "[.][benchmark]") {
+
+	constexpr Sci::Position documentSize = 64 * 1024 * 1024;
+	constexpr Sci::Position replaceSize = 16 * 1024 * 1024;
+	constexpr int replacements = 8;
+
+	using Clock = std::chrono::steady_clock;
+	const auto millis = [](Clock::duration d) {
+		return std::chrono::duration<double, std::milli>(d).count();
+	};
+	constexpr double megabyte = 1024.0 * 1024.0;
+
+	for (const size_t limit : { size_t{0}, size_t{32 * 1024 * 1024} }) {
+		CellBuffer cb(true, false);
+		cb.SetUndoCollection(false);
+		std::string block;
+		for (int line = 0; block.length() < 1024 * 1024; line++) {
+			block += "2024-01-01 12:00:00." + std::to_string(line % 1000) +
+				" INFO  [worker-" + std::to_string(line % 7) + "] request id=" + std::to_string(line * 7919) + " status=200\n";
+		}
+		bool startSequence = false;
+		while (cb.Length() < documentSize) {
+			cb.InsertString(cb.Length(), block.data(), block.length(), startSequence);
+		}
+		cb.SetUndoCollection(true);
+		cb.SetUndoMemoryLimit(limit);
+
+		// Each replacement deletes a range and inserts an edited copy like a replace all
+		const auto start = Clock::now();
+		for (int replacement = 0; replacement < replacements; replacement++) {
+			const Sci::Position position = (replacement * (documentSize / replacements)) % (documentSize - replaceSize);
+			std::string text(cb.RangePointer(position, replaceSize), replaceSize);
+			std::replace(text.begin(), text.end(), 'I', 'i');
+			cb.BeginUndoAction();
+			cb.DeleteChars(position, replaceSize, startSequence);
+			cb.InsertString(position, text.data(), text.length(), startSequence);
+			cb.EndUndoAction();
+		}
+		const double changeMs = millis(Clock::now() - start);
+		const size_t memory = cb.UndoMemory();
+
+		const auto startUndo = Clock::now();
+		while (cb.CanUndo()) {
+			const int steps = cb.StartUndo();
+			for (int step = 0; step < steps; step++) {
+				cb.PerformUndoStep();
+			}
+		}
+		const double undoMs = millis(Clock::now() - startUndo);
+		REQUIRE(std::string_view(cb.RangePointer(0, block.length()), block.length()) == block);
+
+		std::printf("limit %4.0f MB: undo memory %6.1f MB for %4.0f MB of changes  changes %7.1f ms  undo all %7.1f ms\n",
+			limit / megabyte, memory / megabyte, 2.0 * replacements * replaceSize / megabyte, changeMs, undoMs);
+	}
+}
@@ -129,3 +129,37 @@ TEST_CASE_METHOD(CharClassifyTest, "CharsOfClass") {
 		}
 	}
 }
+
+TEST_CASE_METHOD(CharClassifyTest, "Bits") {
+	const auto isEdge = [](CharacterClass cc, CharacterClass ccOther) noexcept {
+		return (cc != ccOther) && (cc == CharacterClass::word || cc == CharacterClass::punctuation);
+	};
+	for (const bool custom : { false, true }) {
+		if (custom) {
+			const unsigned char wordChars[] = "-$\xa0";
+			pcc->SetCharClasses(wordChars, CharacterClass::word);
+			const unsigned char spaceChars[] = "_";
+			pcc->SetCharClasses(spaceChars, CharacterClass::space);
+		}
+		CharClassBits bits;
+		bits.SetClasses(*pcc);
+		for (int ch = 0; ch < byteValues; ch++) {
+			for (int chOther = 0; chOther < byteValues; chOther++) {
+				const unsigned char uch = static_cast<unsigned char>(ch);
+				const unsigned char uchOther = static_cast<unsigned char>(chOther);
+				REQUIRE(bits.IsEdge(uch, uchOther) == isEdge(pcc->GetClass(uch), pcc->GetClass(uchOther)));
+			}
+		}
+	}
+
+	CharClassBits bits;
+	REQUIRE_FALSE(bits.IsKnown('a'));
+	bits.SetKnown('a', true);
+	bits.SetKnown(0xff, true);
+	REQUIRE(bits.IsKnown('a'));
+	REQUIRE(bits.IsKnown(0xff));
+	REQUIRE_FALSE(bits.IsKnown('b'));
+	bits.SetKnown('a', false);
+	REQUIRE_FALSE(bits.IsKnown('a'));
+	REQUIRE(bits.IsKnown(0xff));
+}
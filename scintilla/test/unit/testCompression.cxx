@@ -0,0 +1,90 @@
+/** @file testCompression.cxx
+ ** Unit Tests for Scintilla internal data structures
+ **/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Compression.h"
+
+#include "catch.hpp"
+
+using namespace Scintilla::Internal;
+
+namespace {
+
+std::string RoundTrip(std::string_view text) {
+	const std::string block = CompressBlock(text);
+	std::string expanded(text.length(), '\0');
+	DecompressBlock(block, expanded.data(), expanded.length());
+	return expanded;
+}
+
+}
+
+TEST_CASE("Compression") {
+
+	SECTION("Short") {
+		REQUIRE(RoundTrip("").empty());
+		REQUIRE(RoundTrip("a") == "a");
+		REQUIRE(RoundTrip("abcdefghijkl") == "abcdefghijkl");
+		REQUIRE(RoundTrip("abcdefghijklm") == "abcdefghijklm");
+	}
+
+	SECTION("Repeats") {
+		const std::string same(100000, 'x');
+		const std::string block = CompressBlock(same);
+		REQUIRE(block.length() < 1000);
+		REQUIRE(RoundTrip(same) == same);
+
+		std::string lines;
+		for (int line = 0; line < 5000; line++) {
+			lines += "2024-01-01 12:00:" + std::to_string(line % 60) + " INFO request " + std::to_string(line) + " done\n";
+		}
+		REQUIRE(CompressBlock(lines).length() < lines.length() / 2);
+		REQUIRE(RoundTrip(lines) == lines);
+	}
+
+	SECTION("LongLiteralsAndMatches") {
+		// Literal and match lengths that need continuation bytes including exactly 15 + 255
+		std::string text;
+		unsigned int seed = 7;
+		for (int i = 0; i < 270; i++) {
+			seed = seed * 1103515245u + 12345u;
+			text.push_back(static_cast<char>(seed >> 16));
+		}
+		text += std::string(15 + 255 + 4, 'q');
+		text += text;
+		REQUIRE(RoundTrip(text) == text);
+	}
+
+	SECTION("Random") {
+		std::string text;
+		unsigned int seed = 1;
+		for (int i = 0; i < 200000; i++) {
+			seed = seed * 1103515245u + 12345u;
+			// Small alphabet so there are many short matches at varied offsets
+			text.push_back(static_cast<char>('a' + ((seed >> 16) % 6)));
+		}
+		REQUIRE(RoundTrip(text) == text);
+	}
+
+	SECTION("Invalid") {
+		const std::string text(1000, 'z');
+		const std::string block = CompressBlock(text);
+		std::string expanded(text.length(), '\0');
+		// Wrong length
+		REQUIRE_THROWS_AS(DecompressBlock(block, expanded.data(), 999), std::runtime_error);
+		// Truncated
+		REQUIRE_THROWS_AS(DecompressBlock(std::string_view(block).substr(0, 3), expanded.data(), expanded.length()), std::runtime_error);
+		// Offset before the start
+		const std::string badOffset("\x10" "a" "\x05\x00", 4);
+		REQUIRE_THROWS_AS(DecompressBlock(badOffset, expanded.data(), 5), std::runtime_error);
+	}
+}
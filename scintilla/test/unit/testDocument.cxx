@@ -95,7 +95,7 @@ std::ostream &operator << (std::ostream &os, Match const &value) {
 struct DocPlus {
 	Document document;
 
-	DocPlus(std::string_view svInitial, int codePage) : document(DocumentOption::Default) {
+	DocPlus(std::string_view svInitial, int codePage, DocumentOption options=DocumentOption::Default) : document(options) {
 		SetCodePage(codePage);
 		document.InsertString(0, svInitial);
 	}
@@ -164,6 +164,7 @@ void TimeTrace(std::string_view sv, const Catch::Timer &tikka) {
 }
 
 TEST_CASE("Document") {
+	const DocumentOption options = GENERATE(DocumentOption::Default, DocumentOption::TextPieces, DocumentOption::IndexTree);
 
 	constexpr std::string_view sText = "Scintilla";
 	constexpr Sci::Position sLength = sText.length();
@@ -171,7 +172,7 @@ TEST_CASE("Document") {
 	constexpr FindOption reCxx11 = FindOption::RegExp | FindOption::Cxx11RegEx;
 
 	SECTION("InsertOneLine") {
-		DocPlus doc("", 0);
+		DocPlus doc("", 0, options);
 		const Sci::Position length = doc.document.InsertString(0, sText);
 		REQUIRE(sLength == doc.document.Length());
 		REQUIRE(length == sLength);
@@ -189,7 +190,7 @@ TEST_CASE("Document") {
 	// Arguments are expected to be at character boundaries and will be tweaked if
 	// part way through a character.
 	SECTION("SearchInLatin") {
-		DocPlus doc("abcde", 0);	// a b c d e
+		DocPlus doc("abcde", 0, options);	// a b c d e
 		constexpr std::string_view finding = "b";
 		Sci::Position lengthFinding = finding.length();
 		Sci::Position location = doc.FindNeedle(finding, FindOption::MatchCase, &lengthFinding);
@@ -203,7 +204,7 @@ TEST_CASE("Document") {
 	}
 
 	SECTION("SearchInBothSegments") {
-		DocPlus doc("ab-ab", 0);	// a b - a b
+		DocPlus doc("ab-ab", 0, options);	// a b - a b
 		constexpr std::string_view finding = "ab";
 		for (int gapPos = 0; gapPos <= 5; gapPos++) {
 			doc.MoveGap(gapPos);
@@ -216,7 +217,7 @@ TEST_CASE("Document") {
 	}
 
 	SECTION("InsensitiveSearchInLatin") {
-		DocPlus doc("abcde", 0);	// a b c d e
+		DocPlus doc("abcde", 0, options);	// a b c d e
 		constexpr std::string_view finding = "B";
 		Sci::Position lengthFinding = finding.length();
 		Sci::Position location = doc.FindNeedle(finding, FindOption::None, &lengthFinding);
@@ -231,7 +232,7 @@ TEST_CASE("Document") {
 
 	SECTION("InsensitiveSearchIn1252") {
 		// In Windows Latin, code page 1252, C6 is AE and E6 is ae
-		DocPlus doc("tru\xc6s\xe6t", 0);	// t r u AE s ae t
+		DocPlus doc("tru\xc6s\xe6t", 0, options);	// t r u AE s ae t
 		doc.SetSBCSFoldings(foldings1252, std::size(foldings1252));
 
 		// Search for upper-case AE
@@ -256,7 +257,7 @@ TEST_CASE("Document") {
 
 	SECTION("Search2InLatin") {
 		// Checks that the initial '_' and final 'f' are ignored since they are outside the search bounds
-		DocPlus doc("_abcdef", 0);	// _ a b c d e f
+		DocPlus doc("_abcdef", 0, options);	// _ a b c d e f
 		constexpr std::string_view finding = "cd";
 		Sci::Position lengthFinding = finding.length();
 		const size_t docLength = doc.document.Length() - 1;
@@ -280,7 +281,7 @@ TEST_CASE("Document") {
 	}
 
 	SECTION("SearchInUTF8") {
-		DocPlus doc("ab\xCE\x93" "d", CpUtf8);	// a b gamma d
+		DocPlus doc("ab\xCE\x93" "d", CpUtf8, options);	// a b gamma d
 		constexpr std::string_view finding = "b";
 		Sci::Position lengthFinding = finding.length();
 		Sci::Position location = doc.FindNeedle(finding, FindOption::MatchCase, &lengthFinding);
@@ -302,7 +303,7 @@ TEST_CASE("Document") {
 	}
 
 	SECTION("InsensitiveSearchInUTF8") {
-		DocPlus doc("ab\xCE\x93" "d", CpUtf8);	// a b gamma d
+		DocPlus doc("ab\xCE\x93" "d", CpUtf8, options);	// a b gamma d
 		constexpr std::string_view finding = "b";
 		Sci::Position lengthFinding = finding.length();
 		Sci::Position location = doc.FindNeedle(finding, FindOption::None, &lengthFinding);
@@ -328,7 +329,7 @@ TEST_CASE("Document") {
 		// {CJK UNIFIED IDEOGRAPH-9955} is two bytes: {0xE9, 'b'} in Shift-JIS
 		// The 'b' can be incorrectly matched by the search string 'b' when the search
 		// does not iterate the text correctly.
-		DocPlus doc("ab\xe9" "b ", 932);	// a b {CJK UNIFIED IDEOGRAPH-9955} {space}
+		DocPlus doc("ab\xe9" "b ", 932, options);	// a b {CJK UNIFIED IDEOGRAPH-9955} {space}
 		constexpr std::string_view finding = "b";
 		// Search forwards
 		Sci::Position lengthFinding = finding.length();
@@ -344,7 +345,7 @@ TEST_CASE("Document") {
 		// {CJK UNIFIED IDEOGRAPH-9955} is two bytes: {0xE9, 'b'} in Shift-JIS
 		// The 'b' can be incorrectly matched by the search string 'b' when the search
 		// does not iterate the text correctly.
-		DocPlus doc("ab\xe9" "b ", 932);	// a b {CJK UNIFIED IDEOGRAPH-9955} {space}
+		DocPlus doc("ab\xe9" "b ", 932, options);	// a b {CJK UNIFIED IDEOGRAPH-9955} {space}
 		constexpr std::string_view finding = "b";
 		// Search forwards
 		Sci::Position lengthFinding = finding.length();
@@ -371,7 +372,7 @@ TEST_CASE("Document") {
 	}
 
 	SECTION("GetCharacterAndWidth DBCS") {
-		Document doc(DocumentOption::Default);
+		Document doc(options);
 		doc.SetDBCSCodePage(932);
 		REQUIRE(doc.CodePage() == 932);
 		const Sci::Position length = doc.InsertString(0, "H\x84\xff\x84H", 5);
@@ -443,7 +444,7 @@ TEST_CASE("Document") {
 	}
 
 	SECTION("NextPosition Valid DBCS") {
-		Document doc(DocumentOption::Default);
+		Document doc(options);
 		doc.SetDBCSCodePage(932);
 		REQUIRE(doc.CodePage() == 932);
 		// This text is valid in code page 932.
@@ -490,7 +491,7 @@ TEST_CASE("Document") {
 	}
 
 	SECTION("RegexSearchAndSubstitution") {
-		DocPlus doc("\n\r\r\n 1a\xCE\x93z \n\r\r\n 2b\xCE\x93y \n\r\r\n", CpUtf8);// 1a gamma z 2b gamma y
+		DocPlus doc("\n\r\r\n 1a\xCE\x93z \n\r\r\n 2b\xCE\x93y \n\r\r\n", CpUtf8, options);// 1a gamma z 2b gamma y
 		const Sci::Position docLength = doc.document.Length();
 		Match match;
 
@@ -528,8 +529,155 @@ TEST_CASE("Document") {
 		#endif
 	}
 
+	SECTION("FindAll") {
+		DocPlus doc("ab Ab ab\nxab ab\n", CpUtf8, options);
+		const Sci::Position docLength = doc.document.Length();
+		std::vector<Range> matches;
+
+		REQUIRE(doc.document.FindAll(0, docLength, "ab", FindOption::None, 2, &matches, 100) == 5);
+		REQUIRE(matches.size() == 5);
+		REQUIRE(matches[0] == Range(0, 2));
+		REQUIRE(matches[1] == Range(3, 5));
+		REQUIRE(matches[4] == Range(13, 15));
+
+		// Limited by maxMatches or only counting
+		matches.clear();
+		REQUIRE(doc.document.FindAll(0, docLength, "ab", FindOption::MatchCase, 2, &matches, 2) == 2);
+		REQUIRE(matches[1] == Range(6, 8));
+		REQUIRE(doc.document.FindAll(0, docLength, "ab", FindOption::MatchCase, 2, nullptr, 0) == 4);
+		REQUIRE(doc.document.FindAll(0, docLength, "ab", FindOption::MatchCase | FindOption::WholeWord, 2, nullptr, 0) == 3);
+
+		// Regular expressions, repeated to use the cached compiled form, and empty matches
+		for (const FindOption re : { rePosix, reCxx11 }) {
+			#ifdef NO_CXX11_REGEX
+			if (re == reCxx11)
+				continue;
+			#endif
+			for (int repeat = 0; repeat < 2; repeat++) {
+				matches.clear();
+				REQUIRE(doc.document.FindAll(0, docLength, "^[a-z]+", re, 7, &matches, 100) == 2);
+				REQUIRE(matches[0] == Range(0, 2));
+				REQUIRE(matches[1] == Range(9, 12));
+			}
+			matches.clear();
+			REQUIRE(doc.document.FindAll(0, 5, "b*", re, 2, &matches, 100) >= 5);
+			REQUIRE(matches[0] == Range(0, 0));
+			REQUIRE(matches[1] == Range(1, 2));
+			REQUIRE(matches[2] == Range(2, 2));
+			REQUIRE(matches[4] == Range(4, 5));
+		}
+	}
+
+	SECTION("FindAllThreads") {
+		// Large enough to be split into chunks, with lines of different lengths and line ends
+		std::string text;
+		for (int line = 0; text.length() < 0x240000; line++) {
+			text += (line % 3 == 0) ? "ab Ab xab" : "abab \xCE\x93" "ab";
+			text.append(line % 7, ' ');
+			text += (line % 5 == 0) ? "\r\n" : "\n";
+		}
+		DocPlus doc(text, CpUtf8, options);
+		const Sci::Position docLength = doc.document.Length();
+
+		struct Search {
+			const char *text;
+			FindOption flags;
+		};
+		const Search searches[] = {
+			{ "ab", FindOption::MatchCase },
+			{ "ab", FindOption::None },
+			{ "ab", FindOption::WholeWord },
+			{ "^ab", rePosix },
+			{ "b*$", rePosix },
+		};
+		for (const Search &search : searches) {
+			const Sci::Position length = strlen(search.text);
+			std::vector<Range> sequential;
+			std::vector<Range> parallel;
+			const Sci::Position count = doc.document.FindAll(7, docLength, search.text, search.flags, length, &sequential, docLength);
+			REQUIRE(count > 0);
+			REQUIRE(doc.document.FindAll(7, docLength, search.text, search.flags, length, &parallel, docLength, 4) == count);
+			REQUIRE(parallel == sequential);
+			REQUIRE(doc.document.FindAll(7, docLength, search.text, search.flags, length, nullptr, 0, 4) == count);
+
+			// Stops at maxMatches in the same place
+			parallel.clear();
+			REQUIRE(doc.document.FindAll(7, docLength, search.text, search.flags, length, &parallel, count / 2, 4) == count / 2);
+			REQUIRE(std::equal(parallel.begin(), parallel.end(), sequential.begin()));
+		}
+
+		// Linear regular expressions that can match CR or LF are searched on one thread
+		constexpr FindOption reLinear = FindOption::RegExp | FindOption::LinearRegEx;
+		std::vector<Range> sequential;
+		std::vector<Range> chunked;
+		const Sci::Position count = doc.document.FindAll(0, docLength, "ab\\s+ab", reLinear, 7, &sequential, docLength);
+		REQUIRE(count > docLength / 20);
+		REQUIRE(doc.document.FindAll(0, docLength, "ab\\s+ab", reLinear, 7, &chunked, docLength, 4) == count);
+		REQUIRE(chunked == sequential);
+		for (const char *pattern : { "x?ab\\b", "[a-z]+\\S.$" }) {
+			REQUIRE(doc.document.CanSearchInParallel(pattern, reLinear, strlen(pattern)));
+		}
+		for (const char *pattern : { "ab\\s+ab", "ab\\nab", "ab[^x]ab", "ab\\Wab", "ab[\\x00-z]", "ab(" }) {
+			REQUIRE(!doc.document.CanSearchInParallel(pattern, reLinear, strlen(pattern)));
+		}
+
+		// Text with a line end can match across chunks so is searched on one thread
+		std::vector<Range> matches;
+		REQUIRE(doc.document.FindAll(0, docLength, "ab\nabab", FindOption::MatchCase, 7, &matches, docLength, 4) > 0);
+	}
+
+	SECTION("ReplaceAll") {
+		DocPlus doc("x ab Ab ab\nab1 cd\n", CpUtf8, options);
+		doc.document.DeleteUndoHistory();
+		Range changed;
+
+		REQUIRE(doc.document.ReplaceAll(0, doc.document.Length(), "ab", FindOption::WholeWord, 2, "wxyz", false, changed) == 3);
+		REQUIRE(doc.Contents() == "x wxyz wxyz wxyz\nab1 cd\n");
+		REQUIRE(changed == Range(2, 16));
+		REQUIRE(doc.document.LinesTotal() == 3);
+
+		// One undo action restores everything
+		REQUIRE(doc.document.Undo() >= 0);
+		REQUIRE(doc.Contents() == "x ab Ab ab\nab1 cd\n");
+		REQUIRE(!doc.document.CanUndo());
+
+		// No matches leaves the document alone
+		REQUIRE(doc.document.ReplaceAll(0, doc.document.Length(), "zz", FindOption::None, 2, "y", false, changed) == 0);
+		REQUIRE(!doc.document.CanUndo());
+
+		// Regular expression replacement expands tags for each match and can join lines
+		REQUIRE(doc.document.ReplaceAll(0, doc.document.Length(), "(.)b", rePosix | FindOption::MatchCase, 4, "<\\1>", true, changed) == 4);
+		REQUIRE(doc.Contents() == "x <a> <A> <a>\n<a>1 cd\n");
+		REQUIRE(doc.document.ReplaceAll(0, doc.document.Length(), "$", rePosix, 1, ";", true, changed) == 3);
+		REQUIRE(doc.Contents() == "x <a> <A> <a>;\n<a>1 cd;\n;");
+		REQUIRE(doc.document.ReplaceAll(0, doc.document.Length(), ";\n", FindOption::None, 2, " ", false, changed) == 2);
+		REQUIRE(doc.Contents() == "x <a> <A> <a> <a>1 cd ;");
+		REQUIRE(doc.document.LinesTotal() == 1);
+	}
+
+	SECTION("ReplaceAllKeepsMarkers") {
+		DocPlus doc("ab\nkeep\nkeep\nab ab\n", CpUtf8, options);
+		doc.document.DeleteUndoHistory();
+		const int handle1 = doc.document.AddMark(1, 1);
+		const int handle2 = doc.document.AddMark(2, 2);
+		Range changed;
+
+		// Only the matches change so the lines between them keep their markers
+		REQUIRE(doc.document.ReplaceAll(0, doc.document.Length(), "ab", FindOption::None, 2, "wxyz", false, changed) == 3);
+		REQUIRE(doc.Contents() == "wxyz\nkeep\nkeep\nwxyz wxyz\n");
+		REQUIRE(changed == Range(0, 24));
+		REQUIRE(doc.document.LineFromHandle(handle1) == 1);
+		REQUIRE(doc.document.LineFromHandle(handle2) == 2);
+
+		REQUIRE(doc.document.Undo() >= 0);
+		REQUIRE(doc.Contents() == "ab\nkeep\nkeep\nab ab\n");
+		REQUIRE(!doc.document.CanUndo());
+		REQUIRE(doc.document.LineFromHandle(handle1) == 1);
+		REQUIRE(doc.document.LineFromHandle(handle2) == 2);
+	}
+
 	SECTION("RegexAssertion") {
-		DocPlus doc("ab cd ef\r\ngh ij kl", CpUtf8);
+		DocPlus doc("ab cd ef\r\ngh ij kl", CpUtf8, options);
 		const Sci::Position docLength = doc.document.Length();
 		Match match;
 
@@ -638,7 +786,7 @@ TEST_CASE("Document") {
 	SECTION("RegexContextualAssertion") {
 		// For std::regex, check the use of assertions next to text in forward direction
 		// These are more common than empty assertions
-		DocPlus doc("ab cd ef\r\ngh ij kl", CpUtf8);
+		DocPlus doc("ab cd ef\r\ngh ij kl", CpUtf8, options);
 		const Sci::Position docLength = doc.document.Length();
 		Match match;
 
@@ -676,7 +824,7 @@ TEST_CASE("Document") {
 	}
 
 	SECTION("RESearchMovePositionOutsideCharUTF8") {
-		DocPlus doc(" a\xCE\x93\xCE\x93z ", CpUtf8);// a gamma gamma z
+		DocPlus doc(" a\xCE\x93\xCE\x93z ", CpUtf8, options);// a gamma gamma z
 		const Sci::Position docLength = doc.document.Length();
 		constexpr std::string_view finding = R"([a-z](\w)\1)";
 
@@ -697,7 +845,7 @@ TEST_CASE("Document") {
 	}
 
 	SECTION("RESearchMovePositionOutsideCharDBCS") {
-		DocPlus doc(" \x98\x61xx 1aa\x83\xA1\x83\xA1z ", 932);// U+548C xx 1aa gamma gamma z
+		DocPlus doc(" \x98\x61xx 1aa\x83\xA1\x83\xA1z ", 932, options);// U+548C xx 1aa gamma gamma z
 		const Sci::Position docLength = doc.document.Length();
 
 		Match match = doc.FindString(0, docLength, R"([a-z](\w)\1)", rePosix);
@@ -715,7 +863,7 @@ TEST_CASE("Document") {
 	}
 
 	SECTION("BraceMatch") {
-		DocPlus doc("{}(()())[]", CpUtf8);
+		DocPlus doc("{}(()())[]", CpUtf8, options);
 		constexpr Sci::Position maxReStyle = 0; // unused parameter
 		Sci::Position pos = doc.document.BraceMatch(0, maxReStyle, 0, false);
 		REQUIRE(pos == 1);
@@ -755,7 +903,7 @@ TEST_CASE("Document") {
 	}
 
 	SECTION("BraceMatch DBCS") {
-		DocPlus doc("{\x81}\x81{}", 932); // { U+00B1 U+FF0B }
+		DocPlus doc("{\x81}\x81{}", 932, options); // { U+00B1 U+FF0B }
 		constexpr Sci::Position maxReStyle = 0; // unused parameter
 		Sci::Position pos = doc.document.BraceMatch(0, maxReStyle, 0, false);
 		REQUIRE(pos == 5);
@@ -766,11 +914,12 @@ TEST_CASE("Document") {
 }
 
 TEST_CASE("DocumentUndo") {
+	const DocumentOption options = GENERATE(DocumentOption::Default, DocumentOption::TextPieces, DocumentOption::IndexTree);
 
 	// These tests check that Undo reports the end of coalesced deletes
 
 	constexpr std::string_view sText = "Scintilla";
-	DocPlus doc(sText, 0);
+	DocPlus doc(sText, 0, options);
 
 	SECTION("CheckDeleteForwards") {
 		// Delete forwards like the Del key
@@ -840,39 +989,42 @@ TEST_CASE("DocumentUndo") {
 }
 
 TEST_CASE("Words") {
+	const DocumentOption options = GENERATE(DocumentOption::Default, DocumentOption::TextPieces, DocumentOption::IndexTree);
 
 	SECTION("WordsInText") {
-		const DocPlus doc(" abc ", 0);
+		const DocPlus doc(" abc ", 0, options);
 		REQUIRE(doc.document.IsWordAt(1, 4));
 		REQUIRE(!doc.document.IsWordAt(0, 1));
 		REQUIRE(!doc.document.IsWordAt(1, 2));
-		const DocPlus docPunct(" [!] ", 0);
+		const DocPlus docPunct(" [!] ", 0, options);
 		REQUIRE(docPunct.document.IsWordAt(1, 4));
 		REQUIRE(!docPunct.document.IsWordAt(0, 1));
 		REQUIRE(!docPunct.document.IsWordAt(1, 2));
-		const DocPlus docMixed(" -ab ", 0);	// '-' is punctuation, 'ab' is word
+		const DocPlus docMixed(" -ab ", 0, options);	// '-' is punctuation, 'ab' is word
 		REQUIRE(docMixed.document.IsWordAt(2, 4));
 		REQUIRE(docMixed.document.IsWordAt(1, 4));
 		REQUIRE(docMixed.document.IsWordAt(1, 2));
 		REQUIRE(!docMixed.document.IsWordAt(1, 3));	// 3 is between a and b so not word edge
 		// Scintilla's word definition just examines the ends
-		const DocPlus docOverSpace(" a b ", 0);
+		const DocPlus docOverSpace(" a b ", 0, options);
 		REQUIRE(docOverSpace.document.IsWordAt(1, 4));
 	}
 
 	SECTION("WordsAtEnds") {
-		const DocPlus doc("a c", 0);
+		const DocPlus doc("a c", 0, options);
 		REQUIRE(doc.document.IsWordAt(0, 1));
 		REQUIRE(doc.document.IsWordAt(2, 3));
-		const DocPlus docEndSpace(" a c ", 0);
+		const DocPlus docEndSpace(" a c ", 0, options);
 		REQUIRE(!docEndSpace.document.IsWordAt(0, 2));
 		REQUIRE(!docEndSpace.document.IsWordAt(3, 5));
 	}
 }
 
 TEST_CASE("SafeSegment") {
+	const DocumentOption options = GENERATE(DocumentOption::Default, DocumentOption::TextPieces, DocumentOption::IndexTree);
+
 	SECTION("Short") {
-		const DocPlus doc("", 0);
+		const DocPlus doc("", 0, options);
 		// all encoding: break before or after last space
 		constexpr std::string_view text = "12 ";
 		const size_t length = doc.document.SafeSegment(text);
@@ -882,7 +1034,7 @@ TEST_CASE("SafeSegment") {
 	}
 
 	SECTION("ASCII") {
-		const DocPlus doc("", 0);
+		const DocPlus doc("", 0, options);
 		// all encoding: break before or after last space
 		std::string_view text = "12 3 \t45";
 		size_t length = doc.document.SafeSegment(text);
@@ -915,7 +1067,7 @@ TEST_CASE("SafeSegment") {
 	}
 
 	SECTION("UTF-8") {
-		const DocPlus doc("", CpUtf8);
+		const DocPlus doc("", CpUtf8, options);
 		// break before last character: no trail byte
 		std::string_view text = "JapaneseJa";
 		size_t length = doc.document.SafeSegment(text);
@@ -947,7 +1099,7 @@ TEST_CASE("SafeSegment") {
 		// For UTF-8, SafeSegment first discards any final bytes that do not represent a valid character
 		// then discards the final whole character.
 
-		const DocPlus doc("", CpUtf8);
+		const DocPlus doc("", CpUtf8, options);
 
 		// break before last character after discarding incomplete last character: 0 trail byte
 		std::string_view text = "Japanese\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xc2";	// Invalid text as ends with start byte
@@ -965,7 +1117,7 @@ TEST_CASE("SafeSegment") {
 	}
 
 	SECTION("UTF-8 Combining Characters") {
-		const DocPlus doc("", CpUtf8);
+		const DocPlus doc("", CpUtf8, options);
 
 		// There may be combining characters like accents and tone marks after the
 		// last letter in a sub-string and these may be included in the sub-string
@@ -997,7 +1149,7 @@ TEST_CASE("SafeSegment") {
 	}
 
 	SECTION("DBCS Shift-JIS") {
-		const DocPlus doc("", 932);
+		const DocPlus doc("", 932, options);
 		// word and punctuation boundary in middle of text: single byte
 		std::string_view text = "(IsBreakSpace(text[j]))";
 		size_t length = doc.document.SafeSegment(text);
@@ -1174,8 +1326,10 @@ TEST_CASE("DiscardLastCombinedCharacter") {
 }
 
 TEST_CASE("PerLine") {
+	const DocumentOption options = GENERATE(DocumentOption::Default, DocumentOption::TextPieces, DocumentOption::IndexTree);
+
 	SECTION("LineMarkers") {
-		DocPlus doc("1\n2\n", CpUtf8);
+		DocPlus doc("1\n2\n", CpUtf8, options);
 		REQUIRE(doc.document.LinesTotal() == 3);
 		const int mh1 = doc.document.AddMark(0, 0);
 		const int mh2 = doc.document.AddMark(1, 1);
@@ -1210,7 +1364,7 @@ TEST_CASE("PerLine") {
 	}
 
 	SECTION("LineAnnotation") {
-		DocPlus doc("1\n2\n", CpUtf8);
+		DocPlus doc("1\n2\n", CpUtf8, options);
 		REQUIRE(doc.document.LinesTotal() == 3);
 		Sci::Position length = doc.document.Length();
 		doc.document.AnnotationSetText(0, "1");
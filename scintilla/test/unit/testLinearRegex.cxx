@@ -0,0 +1,331 @@
+/** @file testLinearRegex.cxx
+ ** Unit Tests for Scintilla internal data structures
+ **/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <map>
+#include <set>
+#include <optional>
+#include <algorithm>
+#include <memory>
+#include <chrono>
+#include <regex>
+
+#include "ScintillaTypes.h"
+
+#include "ILoader.h"
+#include "ILexer.h"
+
+#include "Debugging.h"
+
+#include "CharacterCategoryMap.h"
+#include "Position.h"
+#include "SplitVector.h"
+#include "Partitioning.h"
+#include "RunStyles.h"
+#include "CellBuffer.h"
+#include "CharClassify.h"
+#include "Decoration.h"
+#include "CaseFolder.h"
+#include "Document.h"
+#include "LinearRegex.h"
+
+#include "catch.hpp"
+
+using namespace Scintilla;
+using namespace Scintilla::Internal;
+
+namespace {
+
+// Text split in two around a gap of bytes that must never be matched
+class TestText : public LinearRegexText {
+	std::string buffer;
+public:
+	TestText(std::string_view text, size_t part1Length, int codePage_=CpUtf8) :
+		LinearRegexText(SplitView(), codePage_) {
+		constexpr size_t gapLength = 5;
+		buffer.append(text.substr(0, part1Length));
+		buffer.append(gapLength, 'a');
+		buffer.append(text.substr(part1Length));
+		view.segment1 = buffer.data();
+		view.length1 = part1Length;
+		view.segment2 = buffer.data() + gapLength;
+		view.length = text.length();
+	}
+	bool IsDBCSLeadByte(char ch) const noexcept override {
+		// Shift-JIS
+		const unsigned char uch = ch;
+		return codePage == 932 && (((uch >= 0x81) && (uch <= 0x9F)) || ((uch >= 0xE0) && (uch <= 0xFC)));
+	}
+	bool IsWordCharacter(int ch) const noexcept override {
+		return (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_' || ch >= 0x80;
+	}
+};
+
+// Group 0 of the first match as "start,end" or "none" and "error" when the pattern is invalid
+std::string Find(std::string_view pattern, std::string_view text, bool caseSensitive=true, bool last=false) {
+	std::string result;
+	for (size_t split = 0; split <= text.length(); split++) {
+		const TestText testText(text, split);
+		LinearRegex regex;
+		if (regex.Compile(pattern, caseSensitive, testText)) {
+			return "error";
+		}
+		const bool found = regex.Search(testText, 0, text.length(), last);
+		const std::string position = found ?
+			std::to_string(regex.bopat[0]) + "," + std::to_string(regex.eopat[0]) : "none";
+		if (split == 0) {
+			result = position;
+		} else {
+			// Where the gap is makes no difference
+			REQUIRE(position == result);
+		}
+	}
+	return result;
+}
+
+std::string Group(std::string_view pattern, std::string_view text, int group) {
+	const TestText testText(text, text.length() / 2);
+	LinearRegex regex;
+	REQUIRE(!regex.Compile(pattern, true, testText));
+	REQUIRE(regex.Search(testText, 0, text.length(), false));
+	if (regex.bopat[group] < 0) {
+		return "unset";
+	}
+	return std::string(text.substr(regex.bopat[group], regex.eopat[group] - regex.bopat[group]));
+}
+
+}
+
+TEST_CASE("LinearRegex") {
+
+	SECTION("Literals") {
+		REQUIRE(Find("abc", "xxabcxx") == "2,5");
+		REQUIRE(Find("abd", "xxabcxx") == "none");
+		REQUIRE(Find("", "xx") == "0,0");
+		REQUIRE(Find("a\\.c", "abc a.c") == "4,7");
+		REQUIRE(Find("\\x41\\u0042\\x{43}", "-ABC") == "1,4");
+		REQUIRE(Find("\\t", "a\tb") == "1,2");
+		REQUIRE(Find("{}", "a{}") == "1,3");
+		REQUIRE(Find("a{,2}", "a{,2}") == "0,5");
+	}
+
+	SECTION("Sets") {
+		REQUIRE(Find("[0-9]+", "abc123def") == "3,6");
+		REQUIRE(Find("[^a-z]+", "abc123def") == "3,6");
+		REQUIRE(Find("[[:upper:]]+", "abcDEFghi") == "3,6");
+		REQUIRE(Find("[]a]+", "x]a]y") == "1,4");
+		REQUIRE(Find("[a-]+", "x-a-y") == "1,4");
+		REQUIRE(Find("[\\d.]+", "v1.25x") == "1,5");
+		REQUIRE(Find("\\d+", "abc 42") == "4,6");
+		REQUIRE(Find("\\w+", "  word_1 ") == "2,8");
+		REQUIRE(Find("\\S+", "  xy ") == "2,4");
+		REQUIRE(Find("\\s+", "a \t b") == "1,4");
+	}
+
+	SECTION("Repeats") {
+		REQUIRE(Find("ab*c", "ac abc abbc") == "0,2");
+		REQUIRE(Find("ab+c", "ac abc abbc") == "3,6");
+		REQUIRE(Find("ab?c", "abbc abc") == "5,8");
+		REQUIRE(Find("b{2}", "ab bbb") == "3,5");
+		REQUIRE(Find("b{2,}", "ab bbbb") == "3,7");
+		REQUIRE(Find("b{1,2}", "bbbb") == "0,2");
+		REQUIRE(Find("<.*>", "<a><b>") == "0,6");
+		REQUIRE(Find("<.*?>", "<a><b>") == "0,3");
+		REQUIRE(Find("a??", "a") == "0,0");
+		REQUIRE(Find("(a*)*b", "aaab") == "0,4");
+	}
+
+	SECTION("Alternation") {
+		// Leftmost first like a backtracking engine, not leftmost longest
+		REQUIRE(Find("a|ab", "ab") == "0,1");
+		REQUIRE(Find("ab|a", "ab") == "0,2");
+		REQUIRE(Find("cat|dog", "hotdog") == "3,6");
+		REQUIRE(Find("x(?:cat|dog)y", "xdogy") == "0,5");
+	}
+
+	SECTION("Groups") {
+		REQUIRE(Group("(\\w+)@(\\w+)", "mail: user@host.", 1) == "user");
+		REQUIRE(Group("(\\w+)@(\\w+)", "mail: user@host.", 2) == "host");
+		REQUIRE(Group("(a)|(b)", "b", 1) == "unset");
+		REQUIRE(Group("(a)|(b)", "b", 2) == "b");
+		REQUIRE(Group("(a|b)*", "abab", 1) == "b");
+		REQUIRE(Group("(?:x)(y)", "xy", 1) == "y");
+	}
+
+	SECTION("Assertions") {
+		REQUIRE(Find("\\bcat\\b", "concat cat") == "7,10");
+		REQUIRE(Find("\\Bcat", "cat concat") == "7,10");
+		REQUIRE(Find("\\<c", "acb cd") == "4,5");
+		REQUIRE(Find("b\\>", "bc ab") == "4,5");
+		REQUIRE(Find("^b", "ab") == "none");
+		REQUIRE(Find("a$", "ab") == "none");
+	}
+
+	SECTION("Lines") {
+		// ^ and $ work on every line end and matches may cross lines
+		REQUIRE(Find("^b", "a\r\nb") == "3,4");
+		REQUIRE(Find("^b", "a\rb") == "2,3");
+		REQUIRE(Find("^b", "a\nb") == "2,3");
+		REQUIRE(Find("a$", "a\r\nb") == "0,1");
+		REQUIRE(Find("^$", "a\r\n\r\nb") == "3,3");
+		REQUIRE(Find("a$\\r\\n^b", "a\r\nb") == "0,4");
+		REQUIRE(Find("a.b", "a\nb") == "none");
+		REQUIRE(Find("a\\s+b", "a\r\n b") == "0,5");
+		REQUIRE(Find("^.*$", "\r\nxy\r\n") == "0,0");
+	}
+
+	SECTION("Unicode") {
+		REQUIRE(Find(".", "\xc3\xa9x") == "0,2");
+		REQUIRE(Find("[\xc3\xa9]", "e\xc3\xa9") == "1,3");
+		REQUIRE(Find("\\u00e9", "e\xc3\xa9") == "1,3");
+		REQUIRE(Find("\xc3\x89", "\xc3\xa9", false) == "0,2");
+		REQUIRE(Find("K", "\xe2\x84\xaa", false) == "0,3");
+		REQUIRE(Find("[a-z]+", "X\xc5\xbfY", false) == "0,4");
+		REQUIRE(Find("ABC", "xabc", false) == "1,4");
+		// Invalid bytes only match . and negated sets
+		REQUIRE(Find("a.b", "a\xff" "b") == "0,3");
+		REQUIRE(Find("a[^x]b", "a\xff" "b") == "0,3");
+		REQUIRE(Find("a\\wb", "a\xff" "b") == "none");
+		// Characters are compared, not bytes
+		REQUIRE(Find("\\x{a9}", "\xc3\xa9") == "none");
+	}
+
+	SECTION("DBCS") {
+		// The trail byte of 0x82 0x61 is 'a' which can not match on its own
+		const TestText text("\x82" "a" "a", 1, 932);
+		LinearRegex regex;
+		REQUIRE(!regex.Compile("a", true, text));
+		REQUIRE(regex.Search(text, 0, 3, false));
+		REQUIRE(regex.bopat[0] == 2);
+		REQUIRE(!regex.Compile(".", true, text));
+		REQUIRE(regex.Search(text, 0, 3, false));
+		REQUIRE(regex.eopat[0] == 2);
+	}
+
+	SECTION("Last") {
+		REQUIRE(Find("a+", "aa b aaa c", true, true) == "5,8");
+		REQUIRE(Find("x*", "ab", true, true) == "2,2");
+		REQUIRE(Find("q", "ab", true, true) == "none");
+	}
+
+	SECTION("Range") {
+		const TestText text("abc abc abc", 5);
+		LinearRegex regex;
+		REQUIRE(!regex.Compile("abc", true, text));
+		REQUIRE(regex.Search(text, 1, 11, false));
+		REQUIRE(regex.bopat[0] == 4);
+		// Matches must end by the end of the range
+		REQUIRE(!regex.Search(text, 5, 10, false));
+		REQUIRE(!regex.Compile("^abc", true, text));
+		REQUIRE(!regex.Search(text, 1, 11, false));
+	}
+
+	SECTION("Errors") {
+		for (const char *pattern : { "(", "a)", "[a", "*a", "a**", "\\1", "(?=a)", "[z-a]", "a{1001}", "\\", "[[:nothing:]]", "\\xg" }) {
+			REQUIRE(Find(pattern, "a") == "error");
+		}
+		// Too large a program once repeats are expanded
+		REQUIRE(Find("(a{1000}){1000}", "a") == "error");
+	}
+
+	SECTION("Pathological") {
+		// Exponential for backtracking engines
+		const std::string text(100000, 'a');
+		const auto start = std::chrono::steady_clock::now();
+		const TestText testText(text, text.length() / 2);
+		LinearRegex regex;
+		for (const char *pattern : { "(a|aa)*b", "(a*)*b", "(a+)+b", "(.*a){20}b" }) {
+			REQUIRE(!regex.Compile(pattern, true, testText));
+			REQUIRE(!regex.Search(testText, 0, text.length(), false));
+		}
+		REQUIRE(!regex.Compile("(a|aa)*$", true, testText));
+		REQUIRE(regex.Search(testText, 0, text.length(), false));
+		REQUIRE(regex.eopat[0] == static_cast<Sci::Position>(text.length()));
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		REQUIRE(elapsed.count() < 10.0);
+	}
+}
+
+TEST_CASE("LinearRegexDocument") {
+
+	Document doc(DocumentOption::Default);
+	doc.SetDBCSCodePage(CpUtf8);
+	doc.SetCaseFolder(std::make_unique<CaseFolderUnicode>());
+	doc.InsertString(0, "first line\r\nsecond line\r\nthird\r\n");
+	constexpr FindOption linear = FindOption::RegExp | FindOption::LinearRegEx;
+
+	SECTION("Forward") {
+		Sci::Position length = 9;
+		REQUIRE(doc.FindText(0, doc.Length(), "^s[\\w ]+$", linear, &length) == 12);
+		REQUIRE(length == 11);
+		length = 9;
+		REQUIRE(doc.FindText(0, doc.Length(), "line$\\s+^", linear, &length) == 6);
+		REQUIRE(length == 6);
+		length = 10;
+		REQUIRE(doc.FindText(0, doc.Length(), "^([a-z]+)$", linear, &length) == 25);
+		REQUIRE(length == 5);
+	}
+
+	SECTION("Backward") {
+		Sci::Position length = 4;
+		REQUIRE(doc.FindText(doc.Length(), 0, "line", linear, &length) == 19);
+		REQUIRE(length == 4);
+		length = 4;
+		REQUIRE(doc.FindText(18, 0, "line", linear, &length) == 6);
+	}
+
+	SECTION("Case") {
+		Sci::Position length = 6;
+		REQUIRE(doc.FindText(0, doc.Length(), "SECOND", linear, &length) == 12);
+		length = 6;
+		REQUIRE(doc.FindText(0, doc.Length(), "SECOND", linear | FindOption::MatchCase, &length) == -1);
+	}
+
+	SECTION("Substitute") {
+		Sci::Position length = 11;
+		REQUIRE(doc.FindText(0, doc.Length(), "(\\w+) (\\w+)", linear, &length) == 0);
+		length = 5;
+		const char *substituted = doc.SubstituteByPosition("\\2 \\1", &length);
+		REQUIRE(std::string_view(substituted, length) == "line first");
+	}
+
+	SECTION("Error") {
+		Sci::Position length = 3;
+		REQUIRE_THROWS_AS(doc.FindText(0, doc.Length(), "(ab", linear, &length), RegexError);
+	}
+}
+
+// Speed of the linear engine compared with std::regex. Hidden, run with: unitTest [benchmark]
+TEST_CASE("LinearRegexThroughput", "[.][benchmark]") {
+
+	std::string text;
+	for (int i = 0; text.length() < 4 * 1024 * 1024; i++) {
+		text += "    value = buffer[index + " + std::to_string(i) + "] * count;\r\n";
+	}
+	const TestText testText(text, text.length() / 2, CpUtf8);
+	const std::string_view patterns[] = { "index \\+ 99999\\]", "\\bcount;$", "[a-z]+\\[\\w+ \\+ 7\\d*\\]", "(a|aa)*q" };
+	for (const std::string_view pattern : patterns) {
+		LinearRegex regex;
+		REQUIRE(!regex.Compile(pattern, true, testText));
+		size_t matches = 0;
+		const auto start = std::chrono::steady_clock::now();
+		Sci::Position pos = 0;
+		while (regex.Search(testText, pos, text.length(), false)) {
+			matches++;
+			pos = std::max(regex.eopat[0], regex.bopat[0] + 1);
+		}
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		std::printf("%-28s %8zu matches %8.1f MB/s\n", std::string(pattern).c_str(), matches,
+			text.length() / (1024.0 * 1024.0) / elapsed.count());
+	}
+}
@@ -0,0 +1,427 @@
+/** @file testLiteralSearch.cxx
+ ** Unit Tests for Scintilla internal data structures
+ **/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <set>
+#include <optional>
+#include <algorithm>
+#include <memory>
+#include <chrono>
+
+#include "ScintillaTypes.h"
+
+#include "ILoader.h"
+#include "ILexer.h"
+
+#include "Debugging.h"
+
+#include "CharacterCategoryMap.h"
+#include "Position.h"
+#include "SplitVector.h"
+#include "Partitioning.h"
+#include "RunStyles.h"
+#include "CellBuffer.h"
+#include "CharClassify.h"
+#include "Decoration.h"
+#include "CaseFolder.h"
+#include "Document.h"
+#include "LiteralSearch.h"
+
+#include "catch.hpp"
+
+using namespace Scintilla;
+using namespace Scintilla::Internal;
+
+namespace {
+
+// Text laid out as SplitVector does with a gap of bytes that must never be matched
+struct GappedText {
+	std::string buffer;
+	SplitView view;
+	GappedText(std::string_view text, size_t part1Length, char gapFill) {
+		constexpr size_t gapLength = 7;
+		buffer.append(text.substr(0, part1Length));
+		buffer.append(gapLength, gapFill);
+		buffer.append(text.substr(part1Length));
+		view.segment1 = buffer.data();
+		view.length1 = part1Length;
+		view.segment2 = buffer.data() + gapLength;
+		view.length = text.length();
+	}
+};
+
+ptrdiff_t NaiveFind(std::string_view text, size_t start, size_t end, std::string_view needle) {
+	for (size_t pos = start; pos + needle.length() <= end; pos++) {
+		if (text.substr(pos, needle.length()) == needle) {
+			return pos;
+		}
+	}
+	return -1;
+}
+
+bool EitherCase(char ch, char folded) {
+	return ch == folded || ((folded >= 'a') && (folded <= 'z') && (ch == folded - 'a' + 'A'));
+}
+
+bool HighByte(char ch) {
+	return static_cast<unsigned char>(ch) >= 0x80;
+}
+
+ptrdiff_t NaiveCandidate(std::string_view text, size_t start, size_t end, std::string_view folded) {
+	for (size_t pos = start; pos < end; pos++) {
+		if (HighByte(text[pos])) {
+			return pos;
+		}
+		if (EitherCase(text[pos], folded[0])) {
+			if (folded.length() == 1) {
+				return pos;
+			}
+			if ((pos + 1 < end) && (HighByte(text[pos + 1]) || EitherCase(text[pos + 1], folded[1]))) {
+				return pos;
+			}
+		}
+	}
+	return -1;
+}
+
+// Every match of search in the document, found with repeated calls to FindText
+Sci::Position CountMatches(Document &doc, std::string_view search, FindOption flags) {
+	Sci::Position count = 0;
+	Sci::Position pos = 0;
+	for (;;) {
+		Sci::Position length = search.length();
+		pos = doc.FindText(pos, doc.Length(), search.data(), flags, &length);
+		if (pos < 0) {
+			return count;
+		}
+		count++;
+		pos += std::max<Sci::Position>(length, 1);
+	}
+}
+
+}
+
+TEST_CASE("LiteralSearch") {
+
+	// Long enough for the vector loops with matches near the ends, in the middle and overlapping
+	std::string text;
+	for (int i = 0; i < 6; i++) {
+		text += "abcabd xyz abcabcabd Abc aBD ";
+	}
+	text += "abcabd";
+
+	SECTION("FindLiteral") {
+		const std::string_view needles[] = {
+			"a", "d", "ab", "bd", "abd", "abcabd", "abd xyz abcabcabd Abc", "abcabd xyz abcabcabd Abc aBD abc", "q", "abe",
+		};
+		for (const std::string_view needle : needles) {
+			for (size_t split = 0; split <= text.length(); split++) {
+				// The gap is filled with copies of the first byte so straying into it finds matches
+				const GappedText gapped(text, split, needle[0]);
+				for (size_t start = 0; start < text.length(); start += 5) {
+					for (const size_t end : { text.length(), text.length() - 3, start + needle.length() + 20 }) {
+						const size_t endClipped = std::min(end, text.length());
+						REQUIRE(SplitFindLiteral(gapped.view, start, endClipped, needle) ==
+							NaiveFind(text, start, endClipped, needle));
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("FindLiteralEmpty") {
+		const GappedText gapped(text, 10, 'a');
+		REQUIRE(SplitFindLiteral(gapped.view, 0, text.length(), "") == -1);
+		REQUIRE(SplitFindLiteral(gapped.view, 5, 3, "a") == -1);
+		REQUIRE(SplitFindLiteral(gapped.view, 0, 2, "abc") == -1);
+	}
+
+	SECTION("FindFoldedCandidate") {
+		std::string mixed = text;
+		mixed[40] = '\xc3';
+		mixed[41] = '\xa9';
+		mixed[95] = '\xe2';
+		const std::string_view foldeds[] = {
+			"a", "d", "ab", "bd", "b\xc3", "\xc3\xa9", "q", "x ",
+		};
+		for (const std::string_view folded : foldeds) {
+			for (size_t split = 0; split <= mixed.length(); split++) {
+				const GappedText gapped(mixed, split, 'a');
+				for (size_t start = 0; start < mixed.length(); start += 3) {
+					for (const size_t end : { mixed.length(), start + 1, start + 2, start + 20 }) {
+						const size_t endClipped = std::min(end, mixed.length());
+						REQUIRE(SplitFindFoldedCandidate(gapped.view, start, endClipped, folded) ==
+							NaiveCandidate(mixed, start, endClipped, folded));
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("FindTextIgnoreCase") {
+		// Characters outside ASCII that fold to ASCII still match: KELVIN SIGN and LATIN SMALL LETTER LONG S
+		std::string prose;
+		for (int i = 0; i < 10; i++) {
+			prose += "Some text that goes on for a while. ";
+		}
+		const Sci::Position kelvin = prose.length();
+		prose += "\xe2\x84\xaa" "ey ";
+		const Sci::Position longS = prose.length();
+		prose += "a\xc5\xbf" "k ";
+		const Sci::Position upper = prose.length();
+		prose += "ASK KEY";
+		Document doc(DocumentOption::Default);
+		doc.SetDBCSCodePage(CpUtf8);
+		doc.SetCaseFolder(std::make_unique<CaseFolderUnicode>());
+		doc.InsertString(0, prose);
+		for (const Sci::Position gap : { Sci::Position(0), kelvin + 1, longS + 2, doc.Length() }) {
+			// Moves the gap
+			doc.InsertString(gap, "");
+			doc.InsertString(gap, "x");
+			doc.DeleteChars(gap, 1);
+			Sci::Position length = 3;
+			REQUIRE(doc.FindText(0, doc.Length(), "key", FindOption::None, &length) == kelvin);
+			REQUIRE(length == 5);
+			length = 3;
+			REQUIRE(doc.FindText(kelvin + 1, doc.Length(), "key", FindOption::None, &length) == upper + 4);
+			REQUIRE(length == 3);
+			length = 3;
+			REQUIRE(doc.FindText(0, doc.Length(), "ASK", FindOption::None, &length) == longS);
+			REQUIRE(length == 4);
+			length = 3;
+			REQUIRE(doc.FindText(0, doc.Length(), "ask", FindOption::MatchCase, &length) == -1);
+			length = 3;
+			REQUIRE(doc.FindText(0, doc.Length(), "ASK", FindOption::MatchCase, &length) == upper);
+			length = 5;
+			REQUIRE(doc.FindText(0, doc.Length(), "WHILE", FindOption::WholeWord, &length) == 29);
+			length = 4;
+			REQUIRE(doc.FindText(0, doc.Length(), "TEXT", FindOption::None, &length) == 5);
+		}
+	}
+
+	SECTION("MatchFoldedUTF8") {
+		// "xKÖLN Straße" where folding makes the text and the search different lengths
+		const std::string_view mixed = "xK\xc3\x96LN Stra\xc3\x9f" "e";
+		CaseFolderUnicode caseFolder;
+		const std::string_view folded = "k\xc3\xb6ln";
+		const std::string_view foldedStreet = "strasse";
+		for (size_t split = 0; split <= mixed.length(); split++) {
+			const GappedText gapped(mixed, split, 'k');
+			int widthFirst = 0;
+			REQUIRE(SplitMatchFoldedUTF8(gapped.view, 1, mixed.length(), folded, caseFolder, widthFirst) == 5);
+			REQUIRE(widthFirst == 1);
+			REQUIRE(SplitMatchFoldedUTF8(gapped.view, 0, mixed.length(), folded, caseFolder, widthFirst) == 0);
+			// Doesn't match past end
+			REQUIRE(SplitMatchFoldedUTF8(gapped.view, 1, 5, folded, caseFolder, widthFirst) == 0);
+			REQUIRE(SplitMatchFoldedUTF8(gapped.view, 7, mixed.length(), foldedStreet, caseFolder, widthFirst) == 7);
+			REQUIRE(SplitMatchFoldedUTF8(gapped.view, 1, mixed.length(), "\xc3\xb6", caseFolder, widthFirst) == 0);
+			REQUIRE(widthFirst == 1);
+			REQUIRE(SplitMatchFoldedUTF8(gapped.view, 2, mixed.length(), "\xc3\xb6l", caseFolder, widthFirst) == 3);
+			REQUIRE(widthFirst == 2);
+		}
+	}
+}
+
+// Whole word searches classify ASCII neighbours from bit sets and decode the rest, which
+// has to agree with checking every edge the slow way
+TEST_CASE("WholeWordSearch") {
+
+	// Every match of search that MatchesWordOptions accepts, from a search without word options
+	const auto reference = [](Document &doc, std::string_view search, FindOption flags) {
+		const bool word = FlagSet(flags, FindOption::WholeWord);
+		const bool wordStart = FlagSet(flags, FindOption::WordStart);
+		const FindOption plain = FlagSet(flags, FindOption::MatchCase) ? FindOption::MatchCase : FindOption::None;
+		std::vector<Sci::Position> found;
+		Sci::Position pos = 0;
+		for (;;) {
+			Sci::Position length = search.length();
+			pos = doc.FindText(pos, doc.Length(), search.data(), plain, &length);
+			if (pos < 0) {
+				return found;
+			}
+			if (doc.MatchesWordOptions(word, wordStart, pos, length)) {
+				found.push_back(pos);
+			}
+			pos++;
+		}
+	};
+	const auto matches = [](Document &doc, std::string_view search, FindOption flags) {
+		std::vector<Sci::Position> found;
+		Sci::Position pos = 0;
+		for (;;) {
+			Sci::Position length = search.length();
+			pos = doc.FindText(pos, doc.Length(), search.data(), flags, &length);
+			if (pos < 0) {
+				return found;
+			}
+			found.push_back(pos);
+			pos++;
+		}
+	};
+
+	struct Case {
+		int codePage;
+		std::string_view text;
+		std::vector<std::string_view> searches;
+	};
+	const Case cases[] = {
+		// Neighbours in and out of ASCII: letters, a no-break space, guillemets and a combining accent
+		{ CpUtf8, "ab ab_ab-ab \xc3\xa9" "ab ab\xc2\xa0" "ab\xc2\xab" "ab\xc2\xbb" "ab\xcc\x81 ab\n(ab)",
+			{ "ab", "AB", "b", "(", ")" } },
+		// Bytes above 0x7f are word characters in single byte encodings
+		{ 0, "ab \xe9" "ab ab\xe9 \xa0" "ab\xa0 ab-ab,ab", { "ab", "b", "-" } },
+		// Shift-JIS characters whose second byte is ASCII: 0x83 0x5c and 0x82 0x61
+		{ 932, "ab\x83\x5c" "ab \x82\x61" "ab ab\\ab \\ab", { "ab", "\\", "b" } },
+	};
+	for (const Case &c : cases) {
+		for (const bool customWords : { false, true }) {
+			Document doc(DocumentOption::Default);
+			doc.SetDBCSCodePage(c.codePage);
+			if (c.codePage == CpUtf8) {
+				doc.SetCaseFolder(std::make_unique<CaseFolderUnicode>());
+			} else {
+				doc.SetCaseFolder(std::make_unique<CaseFolderTable>());
+			}
+			if (customWords) {
+				const unsigned char wordChars[] = "-\\";
+				doc.SetCharClasses(wordChars, CharacterClass::word);
+			}
+			doc.InsertString(0, c.text);
+			for (Sci::Position gap = 0; gap <= doc.Length(); gap++) {
+				// Moves the gap
+				doc.InsertString(gap, "x");
+				doc.DeleteChars(gap, 1);
+				for (const std::string_view search : c.searches) {
+					for (const FindOption flags : { FindOption::WholeWord, FindOption::WordStart,
+						FindOption::WholeWord | FindOption::MatchCase, FindOption::WordStart | FindOption::MatchCase }) {
+						REQUIRE(matches(doc, search, flags) == reference(doc, search, flags));
+					}
+				}
+			}
+		}
+	}
+}
+
+// FindText throughput on text with many matches and with few. Hidden, run with: unitTest [benchmark]
+TEST_CASE("LiteralSearchThroughput", "[.][benchmark]") {
+
+	constexpr size_t textSize = 64 * 1024 * 1024;
+
+	static const char *const words[] = {
+		"buffer", "length", "index", "window", "editor", "result", "count", "value",
+		"position", "line", "style", "text", "offset", "start", "finish", "caf\xc3\xa9"
+	};
+	std::string text;
+	unsigned int seed = 12345;
+	const auto random = [&seed]() {
+		seed = seed * 1103515245u + 12345u;
+		return (seed >> 8) & 0xFFFFFF;
+	};
+	while (text.length() < textSize) {
+		text += "    ";
+		for (int w = 0; w < 8; w++) {
+			text += (random() % 5000 == 0) ? "needle" : words[random() % std::size(words)];
+			text += (w < 7) ? " " : ";\n";
+		}
+	}
+
+	Document doc(DocumentOption::Default);
+	doc.SetDBCSCodePage(CpUtf8);
+	doc.SetCaseFolder(std::make_unique<CaseFolderUnicode>());
+	doc.InsertString(0, text);
+	// Searches have to cross the gap
+	doc.InsertString(doc.Length() / 2, " ");
+
+	struct Search {
+		const char *name;
+		const char *text;
+		FindOption flags;
+	};
+	const Search searches[] = {
+		{ "Sparse, match case", "needle", FindOption::MatchCase },
+		{ "Dense, match case", "value", FindOption::MatchCase },
+		{ "Absent, match case", "haystack", FindOption::MatchCase },
+		{ "Sparse, ignore case", "NEEDLE", FindOption::None },
+		{ "Dense, ignore case", "VALUE", FindOption::None },
+		{ "Absent, ignore case", "HAYSTACK", FindOption::None },
+		{ "Non-ASCII, ignore case", "CAF\xc3\x89", FindOption::None },
+	};
+	for (const Search &search : searches) {
+		const auto start = std::chrono::steady_clock::now();
+		const Sci::Position count = CountMatches(doc, search.text, search.flags);
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		std::printf("%-24s %9lld matches %8.1f MB/s\n", search.name, static_cast<long long>(count),
+			doc.Length() / (1024.0 * 1024.0) / elapsed.count());
+	}
+}
+
+// Whole word search throughput on source code, where most candidates are inside longer
+// identifiers and are rejected by the word checks. Hidden, run with: unitTest [benchmark]
+TEST_CASE("WholeWordSearchThroughput", "[.][benchmark]") {
+
+	constexpr size_t textSize = 64 * 1024 * 1024;
+
+	static const char *const identifiers[] = {
+		"index", "lineIndex", "index_of", "reindex", "indexes", "count", "countLines",
+		"i", "it", "item", "position", "posIndex", "value", "result", "_index", "caf\xc3\xa9_index"
+	};
+	static const char *const operators[] = {
+		" = ", " < ", " + ", "->", ".", ", ", "(", ")", "[", "]", " == ", "++; "
+	};
+	std::string text;
+	unsigned int seed = 12345;
+	const auto random = [&seed]() {
+		seed = seed * 1103515245u + 12345u;
+		return (seed >> 8) & 0xFFFFFF;
+	};
+	while (text.length() < textSize) {
+		text += "\tif (";
+		for (int t = 0; t < 10; t++) {
+			text += identifiers[random() % std::size(identifiers)];
+			text += operators[random() % std::size(operators)];
+		}
+		text += ") {\n";
+	}
+
+	struct Search {
+		const char *name;
+		const char *text;
+		FindOption flags;
+	};
+	const Search searches[] = {
+		{ "Word, match case", "index", FindOption::WholeWord | FindOption::MatchCase },
+		{ "Word, ignore case", "INDEX", FindOption::WholeWord },
+		{ "Short word, match case", "i", FindOption::WholeWord | FindOption::MatchCase },
+		{ "Word start, match case", "count", FindOption::WordStart | FindOption::MatchCase },
+	};
+	for (const int codePage : { CpUtf8, 0 }) {
+		Document doc(DocumentOption::Default);
+		doc.SetDBCSCodePage(codePage);
+		if (codePage == CpUtf8) {
+			doc.SetCaseFolder(std::make_unique<CaseFolderUnicode>());
+		} else {
+			doc.SetCaseFolder(std::make_unique<CaseFolderTable>());
+		}
+		doc.InsertString(0, text);
+		// Searches have to cross the gap
+		doc.InsertString(doc.Length() / 2, " ");
+		std::printf("%s\n", codePage == CpUtf8 ? "UTF-8" : "Single byte");
+		for (const Search &search : searches) {
+			const auto start = std::chrono::steady_clock::now();
+			const Sci::Position count = CountMatches(doc, search.text, search.flags);
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			std::printf("  %-24s %9lld matches %8.1f MB/s\n", search.name, static_cast<long long>(count),
+				doc.Length() / (1024.0 * 1024.0) / elapsed.count());
+		}
+	}
+}
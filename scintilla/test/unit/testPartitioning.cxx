@@ -17,6 +17,7 @@
 #include "Position.h"
 #include "SplitVector.h"
 #include "Partitioning.h"
+#include "PartitionTree.h"
 
 #include "catch.hpp"
 
@@ -48,9 +49,9 @@ TEST_CASE("CompileCopying Partitioning") {
 
 }
 
-TEST_CASE("Partitioning") {
+TEMPLATE_TEST_CASE("Partitioning", "", Partitioning<Sci::Position>, PartitionTree<Sci::Position>) {
 
-	Partitioning<Sci::Position> part;
+	TestType part;
 
 	SECTION("IsEmptyInitially") {
 		REQUIRE(1 == part.Partitions());
@@ -222,3 +223,97 @@ TEST_CASE("Partitioning") {
 	}
 
 }
+
+TEST_CASE("PartitionTree") {
+
+	PartitionTree<int> part;
+
+	SECTION("ManyBlocks") {
+		// Enough partitions to need many blocks
+		const int partitions = 10000;
+		part.InsertText(0, partitions * 2);
+		std::vector<int> positions;
+		for (int i = 1; i < partitions; i++) {
+			positions.push_back(i * 2);
+		}
+		part.InsertPartitions(1, positions.data(), positions.size());
+		REQUIRE(partitions == part.Partitions());
+		part.InsertText(9000, 5);
+		part.InsertText(10, 3);
+		part.InsertText(5000, -1);
+		REQUIRE(20 == part.PositionFromPartition(10));
+		REQUIRE(25 == part.PositionFromPartition(11));
+		REQUIRE(10003 == part.PositionFromPartition(5000));
+		REQUIRE(10004 == part.PositionFromPartition(5001));
+		REQUIRE(18002 == part.PositionFromPartition(9000));
+		REQUIRE(18009 == part.PositionFromPartition(9001));
+		REQUIRE(20007 == part.Length());
+		REQUIRE(5000 == part.PartitionFromPosition(10003));
+		REQUIRE(5001 == part.PartitionFromPosition(10004));
+		for (int i = partitions - 1; i > 0; i -= 2) {
+			part.RemovePartition(i);
+		}
+		REQUIRE(partitions / 2 == part.Partitions());
+		REQUIRE(20007 == part.Length());
+		part.Check();
+	}
+
+	SECTION("MatchesVector") {
+		// Pseudo-random changes compared with a std::vector of starts
+		std::vector<int> reference { 0, 0 };
+		unsigned int seed = 1;
+		auto random = [&seed](int range) {
+			seed = seed * 1103515245u + 12345u;
+			return static_cast<int>((seed >> 8) % range);
+		};
+		for (int i = 0; i < 50000; i++) {
+			const int partitions = static_cast<int>(reference.size()) - 1;
+			const int action = random(10);
+			const int partition = 1 + random(partitions);
+			if (action < 3) {
+				const int delta = 1 + random(5);
+				for (size_t p = partition; p < reference.size(); p++) {
+					reference[p] += delta;
+				}
+				part.InsertText(partition - 1, delta);
+			} else if ((action < 6) || (partitions < 3)) {
+				const int before = reference[partition - 1];
+				const int after = reference[partition];
+				if (after - before >= 2) {
+					const int position = before + 1 + random(after - before - 1);
+					reference.insert(reference.begin() + partition, position);
+					part.InsertPartition(partition, position);
+				}
+			} else if (action < 8) {
+				if (partition < partitions) {
+					reference.erase(reference.begin() + partition);
+					part.RemovePartition(partition);
+				}
+			} else if (action < 9) {
+				if (partition < partitions) {
+					const int before = reference[partition - 1];
+					const int after = reference[partition + 1];
+					const int position = before + 1 + random(after - before - 1);
+					reference[partition] = position;
+					part.SetPartitionStartPosition(partition, position);
+				}
+			} else {
+				std::vector<int> positions;
+				for (int position = reference[partition - 1] + 1; position < reference[partition]; position += 2) {
+					positions.push_back(position);
+				}
+				reference.insert(reference.begin() + partition, positions.begin(), positions.end());
+				part.InsertPartitions(partition, positions.data(), positions.size());
+			}
+			REQUIRE(static_cast<int>(reference.size()) - 1 == part.Partitions());
+			REQUIRE(reference.back() == part.Length());
+			const int probe = random(static_cast<int>(reference.size()));
+			REQUIRE(reference[probe] == part.PositionFromPartition(probe));
+			const int position = random(reference.back() + 1);
+			const int expected = static_cast<int>(std::upper_bound(reference.begin(), reference.end(), position) - reference.begin()) - 1;
+			REQUIRE(std::min(expected, part.Partitions() - 1) == part.PartitionFromPosition(position));
+		}
+		part.Check();
+	}
+
+}
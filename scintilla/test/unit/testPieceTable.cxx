@@ -0,0 +1,237 @@
+/** @file testPieceTable.cxx
+ ** Unit Tests for Scintilla internal data structures
+ **/
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <memory>
+
+#include "Debugging.h"
+
+#include "Position.h"
+#include "SplitVector.h"
+#include "Partitioning.h"
+#include "PieceTable.h"
+
+#include "catch.hpp"
+
+using namespace Scintilla::Internal;
+
+namespace {
+
+std::string Contents(const PieceTable &pt) {
+	std::string contents(pt.Length(), '\0');
+	pt.GetRange(contents.data(), 0, pt.Length());
+	return contents;
+}
+
+void Insert(PieceTable &pt, ptrdiff_t position, std::string_view sv) {
+	pt.InsertFromArray(position, sv.data(), 0, sv.length());
+	pt.Check();
+}
+
+}
+
+// Test PieceTable.
+
+TEST_CASE("PieceTable") {
+
+	PieceTable pt;
+
+	SECTION("IsEmptyInitially") {
+		REQUIRE(0 == pt.Length());
+		REQUIRE(1 == pt.Pieces());
+		REQUIRE(0 == pt.ValueAt(0));
+		pt.Check();
+	}
+
+	SECTION("InsertOne") {
+		Insert(pt, 0, "abc");
+		REQUIRE(3 == pt.Length());
+		REQUIRE(1 == pt.Pieces());
+		REQUIRE('a' == pt.ValueAt(0));
+		REQUIRE('c' == pt.ValueAt(2));
+		REQUIRE(0 == pt.ValueAt(3));
+		REQUIRE(0 == pt.ValueAt(-1));
+	}
+
+	SECTION("TypingExtendsPiece") {
+		Insert(pt, 0, "0123456789");
+		Insert(pt, 5, "a");
+		REQUIRE(3 == pt.Pieces());
+		Insert(pt, 6, "b");
+		Insert(pt, 7, "c");
+		REQUIRE(3 == pt.Pieces());
+		REQUIRE("01234abc56789" == Contents(pt));
+	}
+
+	SECTION("InsertAtEnds") {
+		Insert(pt, 0, "middle");
+		Insert(pt, 0, "<");
+		Insert(pt, pt.Length(), ">");
+		REQUIRE("<middle>" == Contents(pt));
+		REQUIRE(3 == pt.Pieces());
+	}
+
+	SECTION("DeleteRestoresPieces") {
+		Insert(pt, 0, "0123456789");
+		Insert(pt, 4, "xyz");
+		REQUIRE(3 == pt.Pieces());
+		pt.DeleteRange(4, 3);
+		pt.Check();
+		REQUIRE("0123456789" == Contents(pt));
+		REQUIRE(1 == pt.Pieces());
+	}
+
+	SECTION("DeleteAcrossPieces") {
+		Insert(pt, 0, "aaaa");
+		Insert(pt, 0, "bbbb");
+		Insert(pt, 0, "cccc");
+		REQUIRE(3 == pt.Pieces());
+		pt.DeleteRange(2, 8);
+		pt.Check();
+		REQUIRE("ccaa" == Contents(pt));
+		REQUIRE(2 == pt.Pieces());
+		pt.DeleteRange(0, 2);
+		pt.Check();
+		REQUIRE("aa" == Contents(pt));
+		REQUIRE(1 == pt.Pieces());
+	}
+
+	SECTION("DeleteAll") {
+		Insert(pt, 0, "abc");
+		Insert(pt, 1, "def");
+		pt.DeleteRange(0, pt.Length());
+		pt.Check();
+		REQUIRE(0 == pt.Length());
+		REQUIRE(1 == pt.Pieces());
+		Insert(pt, 0, "g");
+		REQUIRE("g" == Contents(pt));
+	}
+
+	SECTION("OutOfRange") {
+		Insert(pt, 0, "abc");
+		REQUIRE_THROWS_AS(pt.InsertFromArray(4, "x", 0, 1), std::runtime_error);
+		REQUIRE_THROWS_AS(pt.DeleteRange(2, 2), std::runtime_error);
+		REQUIRE("abc" == Contents(pt));
+	}
+
+	SECTION("RangePointer") {
+		Insert(pt, 0, "abcdef");
+		Insert(pt, 3, "123");
+		REQUIRE(3 == pt.Pieces());
+		// Within one piece: nothing changes
+		REQUIRE(0 == memcmp(pt.RangePointer(0, 3), "abc", 3));
+		REQUIRE(3 == pt.Pieces());
+		// Spanning pieces: the range is joined
+		REQUIRE(0 == memcmp(pt.RangePointer(2, 5), "c123d", 5));
+		pt.Check();
+		REQUIRE("abc123def" == Contents(pt));
+		REQUIRE(3 == pt.Pieces());
+		REQUIRE(0 == memcmp(pt.RangePointer(2, 5), "c123d", 5));
+	}
+
+	SECTION("BufferPointer") {
+		Insert(pt, 0, "abcdef");
+		Insert(pt, 3, "123");
+		Insert(pt, 0, "[");
+		const char *text = pt.BufferPointer();
+		pt.Check();
+		REQUIRE(1 == pt.Pieces());
+		REQUIRE(std::string_view("[abc123def") == text);
+		REQUIRE(text == pt.BufferPointer());
+		Insert(pt, pt.Length(), "]");
+		REQUIRE(std::string_view("[abc123def]") == pt.BufferPointer());
+	}
+
+	SECTION("ReadOnly") {
+		std::shared_ptr<std::string> original = std::make_shared<std::string>("original text");
+		std::weak_ptr<std::string> watch = original;
+		pt.InsertReadOnly(0, original->data(), original->length(), original);
+		pt.Check();
+		const char *start = original->data();
+		original.reset();
+		REQUIRE(!watch.expired());
+		REQUIRE(start == pt.RangePointer(0, 8));
+		Insert(pt, 9, "(edited) ");
+		REQUIRE("original (edited) text" == Contents(pt));
+		// Joining copies the text so the original can go
+		pt.BufferPointer();
+		REQUIRE(watch.expired());
+		REQUIRE("original (edited) text" == Contents(pt));
+	}
+
+	SECTION("ReadsStayBounded") {
+		// Each edit followed by reading the whole text, as saving and autosave do, joins
+		// everything into a new block. Compacting keeps the blocks to a few copies.
+		std::shared_ptr<std::string> original = std::make_shared<std::string>(0x400000, 'a');
+		pt.InsertReadOnly(0, original->data(), original->length(), original);
+		std::string reference = *original;
+		for (int round = 0; round < 50; round++) {
+			const ptrdiff_t position = (round * 0x13579) % pt.Length();
+			Insert(pt, position, "xy");
+			reference.insert(position, "xy");
+			pt.DeleteRange(position / 2, 1);
+			reference.erase(position / 2, 1);
+			const ptrdiff_t gap = (pt.Pieces() > 1) ? pt.PieceStart(1) : pt.Length();
+			REQUIRE(0 == memcmp(pt.RangePointer(gap, pt.Length() - gap), reference.data() + gap, pt.Length() - gap));
+			REQUIRE(0 == memcmp(pt.RangePointer(0, pt.Length()), reference.data(), pt.Length()));
+			pt.Check();
+			REQUIRE(pt.BlockBytes() < 4 * pt.Length() + PieceTable::compactSlack);
+		}
+		REQUIRE(reference == Contents(pt));
+	}
+
+	SECTION("Reserve") {
+		pt.ReAllocate(PieceTable::addBlockSize * 4);
+		REQUIRE(pt.Capacity() >= PieceTable::addBlockSize * 4);
+		const std::string block(PieceTable::addBlockSize, 'x');
+		for (int i = 0; i < 4; i++) {
+			Insert(pt, pt.Length(), block);
+		}
+		REQUIRE(1 == pt.Pieces());
+		REQUIRE(PieceTable::addBlockSize * 4 == pt.Length());
+	}
+
+	SECTION("MatchesString") {
+		// Pseudo-random edits compared with a std::string
+		std::string reference;
+		unsigned int seed = 1;
+		auto random = [&seed](unsigned int range) {
+			seed = seed * 1103515245u + 12345u;
+			return static_cast<ptrdiff_t>((seed >> 8) % range);
+		};
+		for (int i = 0; i < 5000; i++) {
+			const ptrdiff_t length = reference.length();
+			const ptrdiff_t action = random(10);
+			if ((action < 5) || (length == 0)) {
+				const ptrdiff_t position = random(static_cast<unsigned int>(length + 1));
+				const std::string text(1 + random(8), static_cast<char>('a' + random(26)));
+				Insert(pt, position, text);
+				reference.insert(position, text);
+			} else if (action < 8) {
+				const ptrdiff_t position = random(static_cast<unsigned int>(length));
+				const ptrdiff_t lengthDelete = std::min<ptrdiff_t>(1 + random(12), length - position);
+				pt.DeleteRange(position, lengthDelete);
+				pt.Check();
+				reference.erase(position, lengthDelete);
+			} else if (action < 9) {
+				const ptrdiff_t position = random(static_cast<unsigned int>(length));
+				const ptrdiff_t lengthRange = std::min<ptrdiff_t>(1 + random(20), length - position);
+				REQUIRE(0 == memcmp(pt.RangePointer(position, lengthRange), reference.data() + position, lengthRange));
+				pt.Check();
+			} else if (random(50) == 0) {
+				REQUIRE(reference == pt.BufferPointer());
+			}
+			REQUIRE(static_cast<ptrdiff_t>(reference.length()) == pt.Length());
+			const ptrdiff_t probe = random(static_cast<unsigned int>(reference.length() + 1));
+			REQUIRE((probe < pt.Length() ? reference[probe] : 0) == pt.ValueAt(probe));
+		}
+		REQUIRE(reference == Contents(pt));
+	}
+}
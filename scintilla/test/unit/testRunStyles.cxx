@@ -17,6 +17,7 @@
 #include "Position.h"
 #include "SplitVector.h"
 #include "Partitioning.h"
+#include "PartitionTree.h"
 #include "RunStyles.h"
 
 #include "catch.hpp"
@@ -79,9 +80,9 @@ namespace Scintilla::Internal {	// Xcode clang 9.0 doesn't like this when in the
 	}
 }
 
-TEST_CASE("RunStyles") {
+TEMPLATE_TEST_CASE("RunStyles", "", (RunStyles<int, int>), (RunStyles<int, int, PartitionTree<int>>)) {
 
-	RunStyles<int, int> rs;
+	TestType rs;
 
 	SECTION("IsEmptyInitially") {
 		REQUIRE(0 == rs.Length());
@@ -167,6 +168,41 @@ TEST_CASE("RunStyles") {
 		REQUIRE(4 == rs.EndRun(1));
 	}
 
+	SECTION("GetRange") {
+		rs.InsertSpace(0, 6);
+		rs.FillRange(1, 7, 2);
+		rs.FillRange(4, 9, 2);
+		int values[5] {};
+		rs.GetRange(values, 1, 5);
+		REQUIRE(7 == values[0]);
+		REQUIRE(7 == values[1]);
+		REQUIRE(0 == values[2]);
+		REQUIRE(9 == values[3]);
+		REQUIRE(9 == values[4]);
+	}
+
+	SECTION("Cursor") {
+		rs.InsertSpace(0, 6);
+		rs.FillRange(1, 7, 2);
+		rs.FillRange(4, 9, 2);
+		RunCursor<int> cursor;
+		REQUIRE(0 == rs.ValueAt(0, cursor));
+		REQUIRE(7 == rs.ValueAt(1, cursor));
+		REQUIRE(1 == cursor.start);
+		REQUIRE(3 == cursor.end);
+		REQUIRE(7 == rs.ValueAt(2, cursor));
+		REQUIRE(9 == rs.ValueAt(5, cursor));
+		REQUIRE(0 == rs.ValueAt(0, cursor));
+		int values[4] {};
+		rs.GetRange(values, 2, 3, cursor);
+		REQUIRE(7 == values[0]);
+		REQUIRE(0 == values[1]);
+		REQUIRE(9 == values[2]);
+		REQUIRE(4 == cursor.start);
+		rs.GetRange(values, 5, 1, cursor);
+		REQUIRE(9 == values[0]);
+	}
+
 	SECTION("FillRangeAlreadyFilled") {
 		rs.InsertSpace(0, 5);
 		const int startFill = 1;
@@ -367,6 +403,25 @@ TEST_CASE("RunStyles") {
 		rs.Check();
 	}
 
+	SECTION("DeleteFirstRuns") {
+		rs.InsertSpace(0, 6);
+		rs.FillRange(0, 5, 2);
+		rs.FillRange(2, 6, 2);
+		REQUIRE(3 == rs.Runs());
+		rs.DeleteRange(0, 3);
+		REQUIRE(3 == rs.Length());
+		REQUIRE(2 == rs.Runs());
+		REQUIRE(6 == rs.ValueAt(0));
+		REQUIRE(0 == rs.ValueAt(1));
+		REQUIRE(1 == rs.EndRun(0));
+		rs.Check();
+		rs.DeleteRange(0, 1);
+		REQUIRE(1 == rs.Runs());
+		REQUIRE(0 == rs.ValueAt(0));
+		REQUIRE(2 == rs.EndRun(0));
+		rs.Check();
+	}
+
 	SECTION("OutsideBounds") {
 		rs.InsertSpace(0, 1);
 		const int startFill = 1;
@@ -0,0 +1,285 @@
+/** @file testTextScanner.cxx
+ ** Unit Tests for Scintilla internal data structures
+ **/
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <memory>
+#include <chrono>
+
+#include "ScintillaTypes.h"
+
+#include "Debugging.h"
+
+#include "Position.h"
+#include "SplitVector.h"
+#include "Partitioning.h"
+#include "RunStyles.h"
+#include "SparseVector.h"
+#include "ChangeHistory.h"
+#include "CellBuffer.h"
+#include "UniConversion.h"
+#include "TextScanner.h"
+
+#include "catch.hpp"
+
+using namespace Scintilla;
+using namespace Scintilla::Internal;
+
+// Test TextScanner.
+
+namespace {
+
+struct ScanResult {
+	std::vector<Sci::Position> lineStarts;
+	LineEndCounts counts;
+	bool valid = true;
+	bool ascii = true;
+	size_t consumed = 0;
+};
+
+// Scan text in chunks, collecting the line starts as document positions
+ScanResult ScanInChunks(std::string_view text, size_t chunkSize, bool checkUTF8, ScanKernel kernel=ScanKernel::automatic) {
+	TextScanner scanner(checkUTF8, kernel);
+	ScanResult result;
+	size_t offset = 0;
+	do {
+		const size_t length = std::min(chunkSize, text.length() - offset);
+		const bool atEnd = offset + length == text.length();
+		if ((offset > 0) && (text[offset - 1] == '\r') && (text[offset] == '\n') &&
+			!result.lineStarts.empty() && (result.lineStarts.back() == static_cast<Sci::Position>(offset))) {
+			// The CR ending the previous chunk is part of a CR+LF so its line starts after the LF
+			result.lineStarts.back()++;
+		}
+		const size_t consumed = scanner.Scan(text.substr(offset, length), atEnd);
+		for (const Sci::Position start : scanner.LineStarts()) {
+			result.lineStarts.push_back(offset + start);
+		}
+		offset += consumed;
+		if (consumed < length) {
+			break;
+		}
+	} while (offset < text.length());
+	result.counts = scanner.Counts();
+	result.valid = scanner.Valid();
+	result.ascii = scanner.AllASCII();
+	result.consumed = static_cast<size_t>(scanner.Length());
+	return result;
+}
+
+std::vector<Sci::Position> LineStartsOf(const CellBuffer &cb) {
+	std::vector<Sci::Position> starts;
+	for (Sci::Line line = 1; line < cb.Lines(); line++) {
+		starts.push_back(cb.LineStart(line));
+	}
+	return starts;
+}
+
+constexpr std::string_view mixedText =
+	"ab\r\ncd\ref\n\n\r\r\n"
+	"\xc3\xa9t\xc3\xa9\r\n"				// été
+	"\xe2\x82\xac 1\n"				// €
+	"\xf0\x9f\x98\x80\r"				// Emoji
+	"0123456789abcdef0123456789abcdef0123456789abcdef\n"
+	"\xef\xbf\xbe\r\n";				// Non-character U+FFFE is well formed
+
+}
+
+TEST_CASE("TextScanner") {
+
+	SECTION("Empty") {
+		const ScanResult result = ScanInChunks("", 16, true);
+		REQUIRE(result.lineStarts.empty());
+		REQUIRE(result.valid);
+		REQUIRE(result.ascii);
+		REQUIRE(result.consumed == 0);
+	}
+
+	SECTION("LineEnds") {
+		const ScanResult result = ScanInChunks("a\nb\r\nc\rd\n", 1024, true);
+		REQUIRE(result.lineStarts == std::vector<Sci::Position>{2, 5, 7, 9});
+		REQUIRE(result.counts.lf == 2);
+		REQUIRE(result.counts.crlf == 1);
+		REQUIRE(result.counts.cr == 1);
+		REQUIRE(result.valid);
+		REQUIRE(result.ascii);
+	}
+
+	SECTION("ChunkSplits") {
+		// Every chunk size gives the same result as scanning in one go,
+		// including CR+LF and multi-byte characters split between chunks
+		const ScanResult whole = ScanInChunks(mixedText, mixedText.length(), true);
+		REQUIRE(whole.valid);
+		REQUIRE(!whole.ascii);
+		REQUIRE(whole.counts.crlf == 4);
+		REQUIRE(whole.counts.lf == 4);
+		REQUIRE(whole.counts.cr == 3);
+		for (size_t chunkSize = 1; chunkSize <= mixedText.length(); chunkSize++) {
+			const ScanResult result = ScanInChunks(mixedText, chunkSize, true);
+			REQUIRE(result.lineStarts == whole.lineStarts);
+			REQUIRE(result.counts.cr == whole.counts.cr);
+			REQUIRE(result.counts.lf == whole.counts.lf);
+			REQUIRE(result.counts.crlf == whole.counts.crlf);
+			REQUIRE(result.valid);
+			REQUIRE(result.consumed == mixedText.length());
+		}
+	}
+
+	SECTION("Kernels") {
+		// Long enough to use the vector loops with line ends and high bytes at every alignment
+		std::string text;
+		for (int i = 0; i < 200; i++) {
+			text.append(i % 37, 'x');
+			text += (i % 3 == 0) ? "\r\n" : (i % 3 == 1) ? "\n" : "\xc3\xa9\r";
+		}
+		const ScanResult scalar = ScanInChunks(text, 4096, true, ScanKernel::scalar);
+		for (const ScanKernel kernel : { ScanKernel::sse2, ScanKernel::avx2 }) {
+			if (TextScanner::KernelAvailable(kernel)) {
+				for (const bool checkUTF8 : { false, true }) {
+					const ScanResult result = ScanInChunks(text, 4096, checkUTF8, kernel);
+					REQUIRE(result.lineStarts == scalar.lineStarts);
+					REQUIRE(result.counts.cr == scalar.counts.cr);
+					REQUIRE(result.counts.crlf == scalar.counts.crlf);
+					REQUIRE(result.ascii == (!checkUTF8 || scalar.ascii));
+				}
+			}
+		}
+	}
+
+	SECTION("Invalid") {
+		// Scanning stops at the invalid byte and continues without checking
+		constexpr std::string_view text = "ab\ncd\xff" "ef\ngh";
+		TextScanner scanner(true);
+		const size_t consumed = scanner.Scan(text, true);
+		REQUIRE(consumed == 5);
+		REQUIRE(!scanner.Valid());
+		REQUIRE(scanner.AllASCII());
+		REQUIRE(scanner.LineStarts() == std::vector<Sci::Position>{3});
+		REQUIRE(scanner.Scan(text.substr(consumed), true) == text.length() - consumed);
+		REQUIRE(scanner.LineStarts() == std::vector<Sci::Position>{4});
+		REQUIRE(scanner.Length() == static_cast<Sci::Position>(text.length()));
+		REQUIRE(scanner.Counts().lf == 2);
+	}
+
+	SECTION("InvalidAfterSplit") {
+		// A character started in one chunk and broken by the next is reported at the start of the next
+		TextScanner scanner(true);
+		REQUIRE(scanner.Scan("a\xc3\xa9 \xe2\x82", false) == 6);
+		REQUIRE(scanner.Valid());
+		REQUIRE(scanner.Scan("x\n", true) == 0);
+		REQUIRE(!scanner.Valid());
+		REQUIRE(!scanner.AllASCII());
+	}
+
+	SECTION("TruncatedAtEnd") {
+		const ScanResult result = ScanInChunks("ab\xe2\x82", 3, true);
+		REQUIRE(!result.valid);
+	}
+}
+
+TEST_CASE("AppendScannedText") {
+
+	SECTION("MatchesInsertString") {
+		// Appending with scanned line starts builds the same lines as inserting the text
+		for (size_t chunkSize = 1; chunkSize <= mixedText.length(); chunkSize++) {
+			CellBuffer cbInsert(true, false);
+			CellBuffer cbAppend(true, false);
+			cbInsert.SetUndoCollection(false);
+			cbAppend.SetUndoCollection(false);
+			TextScanner scanner(true);
+			for (size_t offset = 0; offset < mixedText.length(); offset += chunkSize) {
+				const std::string_view chunk = mixedText.substr(offset, chunkSize);
+				bool startSequence = false;
+				cbInsert.InsertString(offset, chunk.data(), chunk.length(), startSequence);
+				REQUIRE(scanner.Scan(chunk, offset + chunk.length() == mixedText.length()) == chunk.length());
+				const std::vector<Sci::Position> &starts = scanner.LineStarts();
+				REQUIRE(cbAppend.AppendScannedText(chunk.data(), chunk.length(), starts.data(), starts.size()));
+			}
+			REQUIRE(cbAppend.Length() == static_cast<Sci::Position>(mixedText.length()));
+			REQUIRE(cbAppend.Lines() == cbInsert.Lines());
+			REQUIRE(LineStartsOf(cbAppend) == LineStartsOf(cbInsert));
+		}
+	}
+
+	SECTION("NeedsFullInsertion") {
+		// With undo on the text must go through InsertString
+		CellBuffer cb(true, false);
+		const Sci::Position starts[] = { 2 };
+		REQUIRE(!cb.AppendScannedText("a\nb", 3, starts, 1));
+		REQUIRE(cb.Length() == 0);
+	}
+}
+
+// Compares the single scan with the separate passes it replaces. Hidden, run with: unitTest [benchmark]
+TEST_CASE("TextScannerThroughput", "[.][benchmark]") {
+
+	constexpr size_t textSize = 64 * 1024 * 1024;
+	constexpr size_t chunkSize = 1024 * 1024;
+
+	std::string text;
+	while (text.length() < textSize) {
+		text += "2024-01-01 12:00:00.000 INFO  [worker-3] request id=0000abcd status=200\r\n";
+		text += "caf\xc3\xa9 na\xc3\xafve \xe2\x82\xac\r\n";
+	}
+
+	const auto report = [](const char *name, size_t bytes, std::chrono::duration<double> elapsed) {
+		std::printf("%-32s %8.1f MB/s\n", name, bytes / (1024.0 * 1024.0) / elapsed.count());
+	};
+
+	{
+		// Validate, count line ends and let CellBuffer find the lines
+		const auto start = std::chrono::steady_clock::now();
+		UTF8Validator validator;
+		Sci::Position crlf = 0;
+		char chPrev = 0;
+		CellBuffer cb(true, false);
+		cb.SetUndoCollection(false);
+		cb.Allocate(text.length());
+		for (size_t offset = 0; offset < text.length(); offset += chunkSize) {
+			const std::string_view chunk = std::string_view(text).substr(offset, chunkSize);
+			validator.Check(chunk, offset + chunk.length() == text.length());
+			for (const char ch : chunk) {
+				if (chPrev == '\r' && ch == '\n') {
+					crlf++;
+				}
+				chPrev = ch;
+			}
+			bool startSequence = false;
+			cb.InsertString(offset, chunk.data(), chunk.length(), startSequence);
+		}
+		report("Three passes", text.length(), std::chrono::steady_clock::now() - start);
+		REQUIRE(validator.Valid());
+		REQUIRE(crlf == cb.Lines() - 1);
+	}
+
+	for (const ScanKernel kernel : { ScanKernel::scalar, ScanKernel::sse2, ScanKernel::avx2 }) {
+		if (!TextScanner::KernelAvailable(kernel)) {
+			continue;
+		}
+		const auto start = std::chrono::steady_clock::now();
+		TextScanner scanner(true, kernel);
+		CellBuffer cb(true, false);
+		cb.SetUndoCollection(false);
+		cb.Allocate(text.length());
+		for (size_t offset = 0; offset < text.length(); offset += chunkSize) {
+			const std::string_view chunk = std::string_view(text).substr(offset, chunkSize);
+			scanner.Scan(chunk, offset + chunk.length() == text.length());
+			const std::vector<Sci::Position> &starts = scanner.LineStarts();
+			cb.AppendScannedText(chunk.data(), chunk.length(), starts.data(), starts.size());
+		}
+		const char *names[] = { "", "Single scan (scalar)", "Single scan (SSE2)", "Single scan (AVX2)" };
+		report(names[static_cast<int>(kernel)], text.length(), std::chrono::steady_clock::now() - start);
+		REQUIRE(scanner.Valid());
+		REQUIRE(scanner.Counts().crlf == cb.Lines() - 1);
+	}
+}
@@ -2,6 +2,7 @@
  ** Unit Tests for Scintilla internal data structures
  **/
 
+#include <cstdio>
 #include <cstring>
 
 #include <string>
@@ -10,6 +11,7 @@
 #include <optional>
 #include <algorithm>
 #include <memory>
+#include <chrono>
 
 #include "Debugging.h"
 
@@ -397,3 +399,203 @@ TEST_CASE("UTF8Classify") {
 		REQUIRE(UTFClass("\xF0\x9F\x9Fq") == (1 | UTF8MaskInvalid));
 	}
 }
+
+namespace {
+
+// Convert UTF-16 bytes in chunks of chunkSize bytes
+std::string UTF8FromUTF16Chunks(std::string_view bytes, bool bigEndian, size_t chunkSize) {
+	UTF8FromUTF16Stream stream(bigEndian);
+	std::string result;
+	std::vector<char> buffer(UTF8FromUTF16Stream::MaxOutput(chunkSize));
+	size_t position = 0;
+	do {
+		const std::string_view chunk = bytes.substr(position, chunkSize);
+		position += chunk.length();
+		const size_t written = stream.Convert(chunk, buffer.data(), buffer.size(), position >= bytes.length());
+		result.append(buffer.data(), written);
+	} while (position < bytes.length());
+	return result;
+}
+
+// Swap each byte pair so little endian test data can be checked as big endian
+std::string SwapBytePairs(std::string_view bytes) {
+	std::string swapped(bytes);
+	for (size_t i = 0; i + 1 < swapped.length(); i += 2) {
+		std::swap(swapped[i], swapped[i + 1]);
+	}
+	return swapped;
+}
+
+bool UTF8ValidInChunks(std::string_view text, size_t chunkSize) {
+	UTF8Validator validator;
+	size_t position = 0;
+	do {
+		const std::string_view chunk = text.substr(position, chunkSize);
+		position += chunk.length();
+		validator.Check(chunk, position >= text.length());
+	} while (position < text.length());
+	return validator.Valid();
+}
+
+// "a" U+00E9 U+20AC U+1F310 "z" in UTF-16LE and UTF-8
+const std::string_view mixedUTF16LE("a\0\xE9\0\xAC\x20\x3C\xD8\x10\xDF" "z\0", 12);
+const std::string_view mixedUTF8("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x8C\x90z");
+
+}
+
+TEST_CASE("UTF8FromUTF16Stream") {
+
+	SECTION("UTF8FromUTF16Stream ASCII") {
+		const std::string_view bytes("a\0b\0", 4);
+		REQUIRE(UTF8FromUTF16Chunks(bytes, false, 4) == "ab");
+		REQUIRE(UTF8FromUTF16Chunks(SwapBytePairs(bytes), true, 4) == "ab");
+	}
+
+	SECTION("UTF8FromUTF16Stream Mixed") {
+		REQUIRE(UTF8FromUTF16Chunks(mixedUTF16LE, false, 1024) == mixedUTF8);
+		REQUIRE(UTF8FromUTF16Chunks(SwapBytePairs(mixedUTF16LE), true, 1024) == mixedUTF8);
+	}
+
+	SECTION("UTF8FromUTF16Stream Every chunk size") {
+		// Splits byte pairs and the surrogate pair at every possible place
+		const std::string swapped = SwapBytePairs(mixedUTF16LE);
+		for (size_t chunkSize = 1; chunkSize <= mixedUTF16LE.length(); chunkSize++) {
+			REQUIRE(UTF8FromUTF16Chunks(mixedUTF16LE, false, chunkSize) == mixedUTF8);
+			REQUIRE(UTF8FromUTF16Chunks(swapped, true, chunkSize) == mixedUTF8);
+		}
+	}
+
+	SECTION("UTF8FromUTF16Stream NUL") {
+		const std::string_view bytes("a\0\0\0b\0", 6);
+		REQUIRE(UTF8FromUTF16Chunks(bytes, false, 3) == std::string_view("a\0b", 3));
+	}
+
+	SECTION("UTF8FromUTF16Stream Unpaired lead surrogate") {
+		const std::string_view bytes("\x3C\xD8" "a\0", 4);
+		REQUIRE(UTF8FromUTF16Chunks(bytes, false, 2) == "\xEF\xBF\xBD" "a");
+	}
+
+	SECTION("UTF8FromUTF16Stream Lead surrogate at end") {
+		const std::string_view bytes("a\0\x3C\xD8", 4);
+		REQUIRE(UTF8FromUTF16Chunks(bytes, false, 2) == "a\xEF\xBF\xBD");
+	}
+
+	SECTION("UTF8FromUTF16Stream Unpaired trail surrogate") {
+		const std::string_view bytes("\x10\xDF" "a\0", 4);
+		REQUIRE(UTF8FromUTF16Chunks(bytes, false, 1) == "\xEF\xBF\xBD" "a");
+	}
+
+	SECTION("UTF8FromUTF16Stream Odd byte at end") {
+		const std::string_view bytes("a\0b", 3);
+		REQUIRE(UTF8FromUTF16Chunks(bytes, false, 2) == "a\xEF\xBF\xBD");
+	}
+
+	SECTION("UTF8FromUTF16Stream Output too small") {
+		UTF8FromUTF16Stream stream(false);
+		char buffer[4] {};
+		REQUIRE_THROWS(stream.Convert(mixedUTF16LE, buffer, sizeof(buffer), true));
+	}
+}
+
+TEST_CASE("UTF8Validator") {
+
+	SECTION("UTF8Validator ASCII") {
+		UTF8Validator validator;
+		REQUIRE(validator.Check("Some plain ASCII text that is longer than a word", true));
+		REQUIRE(validator.AllASCII());
+	}
+
+	SECTION("UTF8Validator Every chunk size") {
+		for (size_t chunkSize = 1; chunkSize <= mixedUTF8.length(); chunkSize++) {
+			REQUIRE(UTF8ValidInChunks(mixedUTF8, chunkSize));
+		}
+	}
+
+	SECTION("UTF8Validator Not ASCII") {
+		UTF8Validator validator;
+		REQUIRE(validator.Check("abc", false));
+		REQUIRE(validator.AllASCII());
+		REQUIRE(validator.Check("\xC3\xA9", true));
+		REQUIRE(!validator.AllASCII());
+	}
+
+	SECTION("UTF8Validator Non-character") {
+		REQUIRE(UTF8ValidInChunks("\xEF\xBF\xBF", 1));
+	}
+
+	SECTION("UTF8Validator Invalid") {
+		// Windows-1252 e acute between ASCII
+		REQUIRE(!UTF8ValidInChunks("abc\xE9zzzzzzzzzz", 100));
+		REQUIRE(!UTF8ValidInChunks("abc\xE9zzzzzzzzzz", 4));
+	}
+
+	SECTION("UTF8Validator Invalid trail after chunk boundary") {
+		REQUIRE(!UTF8ValidInChunks("\xE2\x82q", 2));
+		REQUIRE(!UTF8ValidInChunks("\xE2\x82q", 1));
+	}
+
+	SECTION("UTF8Validator Truncated at end") {
+		REQUIRE(!UTF8ValidInChunks("a\xE2\x82", 2));
+		REQUIRE(!UTF8ValidInChunks("a\xE2\x82", 100));
+	}
+
+	SECTION("UTF8Validator Stays invalid") {
+		UTF8Validator validator;
+		REQUIRE(!validator.Check("\xFF", false));
+		REQUIRE(!validator.Check("abc", true));
+	}
+}
+
+// Throughput of the streaming conversions. Hidden, run with: unitTest [benchmark]
+TEST_CASE("UniConversionThroughput", "[.][benchmark]") {
+
+	constexpr size_t textSize = 64 * 1024 * 1024;
+	constexpr size_t chunkSize = 1024 * 1024;
+
+	// Text with a mix of ASCII, 2, 3 and 4 byte UTF-8 characters
+	std::string utf8;
+	while (utf8.length() < textSize) {
+		utf8 += "The quick brown fox jumps over the lazy dog 0123456789\r\n";
+		utf8 += mixedUTF8;
+	}
+	std::string utf16LE;
+	for (size_t i = 0; i < utf8.length();) {
+		const int width = UTF8Classify(utf8.data() + i, utf8.length() - i) & UTF8MaskWidth;
+		wchar_t units[2] {};
+		const unsigned int unitCount = UTF16FromUTF32Character(UnicodeFromUTF8(std::string_view(utf8.data() + i, width)), units);
+		for (unsigned int u = 0; u < unitCount; u++) {
+			utf16LE += static_cast<char>(units[u] & 0xFF);
+			utf16LE += static_cast<char>((units[u] >> 8) & 0xFF);
+		}
+		i += width;
+	}
+	const std::string utf16BE = SwapBytePairs(utf16LE);
+
+	const auto report = [](const char *name, size_t bytes, std::chrono::duration<double> elapsed) {
+		std::printf("%-24s %8.1f MB/s\n", name, bytes / (1024.0 * 1024.0) / elapsed.count());
+	};
+
+	for (const bool bigEndian : { false, true }) {
+		const std::string &bytes = bigEndian ? utf16BE : utf16LE;
+		const auto start = std::chrono::steady_clock::now();
+		const std::string converted = UTF8FromUTF16Chunks(bytes, bigEndian, chunkSize);
+		report(bigEndian ? "UTF-16BE to UTF-8" : "UTF-16LE to UTF-8", bytes.length(),
+			std::chrono::steady_clock::now() - start);
+		REQUIRE(converted == utf8);
+	}
+
+	{
+		const auto start = std::chrono::steady_clock::now();
+		const bool valid = UTF8ValidInChunks(utf8, chunkSize);
+		report("UTF-8 validation", utf8.length(), std::chrono::steady_clock::now() - start);
+		REQUIRE(valid);
+	}
+
+	{
+		const std::string ascii(textSize, 'x');
+		const auto start = std::chrono::steady_clock::now();
+		const bool valid = UTF8ValidInChunks(ascii, chunkSize);
+		report("ASCII validation", ascii.length(), std::chrono::steady_clock::now() - start);
+		REQUIRE(valid);
+	}
+}
@@ -140,6 +140,7 @@ $(DIR_O)/CellBuffer.o: \
 	../src/Position.h \
 	../src/SplitVector.h \
 	../src/Partitioning.h \
+	../src/PartitionTree.h \
 	../src/RunStyles.h \
 	../src/SparseVector.h \
 	../src/ChangeHistory.h \
@@ -166,6 +167,9 @@ $(DIR_O)/CharClassify.o: \
 	../src/CharClassify.cxx \
 	../src/CharacterType.h \
 	../src/CharClassify.h
+$(DIR_O)/Compression.o: \
+	../src/Compression.cxx \
+	../src/Compression.h
 $(DIR_O)/ContractionState.o: \
 	../src/ContractionState.cxx \
 	../src/Debugging.h \
@@ -431,6 +435,7 @@ $(DIR_O)/RunStyles.o: \
 	../src/Position.h \
 	../src/SplitVector.h \
 	../src/Partitioning.h \
+	../src/PartitionTree.h \
 	../src/RunStyles.h
 $(DIR_O)/ScintillaBase.o: \
 	../src/ScintillaBase.cxx \
@@ -492,7 +497,8 @@ $(DIR_O)/UndoHistory.o: \
 	../src/SparseVector.h \
 	../src/ChangeHistory.h \
 	../src/CellBuffer.h \
-	../src/UndoHistory.h
+	../src/UndoHistory.h \
+	../src/Compression.h
 $(DIR_O)/UniConversion.o: \
 	../src/UniConversion.cxx \
 	../src/UniConversion.h
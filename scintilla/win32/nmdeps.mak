@@ -140,6 +140,7 @@ $(DIR_O)/CellBuffer.obj: \
 	../src/Position.h \
 	../src/SplitVector.h \
 	../src/Partitioning.h \
+	../src/PartitionTree.h \
 	../src/RunStyles.h \
 	../src/SparseVector.h \
 	../src/ChangeHistory.h \
@@ -166,6 +167,9 @@ $(DIR_O)/CharClassify.obj: \
 	../src/CharClassify.cxx \
 	../src/CharacterType.h \
 	../src/CharClassify.h
+$(DIR_O)/Compression.obj: \
+	../src/Compression.cxx \
+	../src/Compression.h
 $(DIR_O)/ContractionState.obj: \
 	../src/ContractionState.cxx \
 	../src/Debugging.h \
@@ -431,6 +435,7 @@ $(DIR_O)/RunStyles.obj: \
 	../src/Position.h \
 	../src/SplitVector.h \
 	../src/Partitioning.h \
+	../src/PartitionTree.h \
 	../src/RunStyles.h
 $(DIR_O)/ScintillaBase.obj: \
 	../src/ScintillaBase.cxx \
@@ -492,7 +497,8 @@ $(DIR_O)/UndoHistory.obj: \
 	../src/SparseVector.h \
 	../src/ChangeHistory.h \
 	../src/CellBuffer.h \
-	../src/UndoHistory.h
+	../src/UndoHistory.h \
+	../src/Compression.h
 $(DIR_O)/UniConversion.obj: \
 	../src/UniConversion.cxx \
 	../src/UniConversion.h
@@ -94,6 +94,7 @@ SRC_OBJS=\
 	$(DIR_O)\CharacterCategoryMap.obj \
 	$(DIR_O)\CharacterType.obj \
 	$(DIR_O)\CharClassify.obj \
+	$(DIR_O)\Compression.obj \
 	$(DIR_O)\ContractionState.obj \
 	$(DIR_O)\DBCS.obj \
 	$(DIR_O)\Decoration.obj \
@@ -105,13 +106,17 @@ SRC_OBJS=\
 	$(DIR_O)\Indicator.obj \
 	$(DIR_O)\KeyMap.obj \
 	$(DIR_O)\LineMarker.obj \
+	$(DIR_O)\LinearRegex.obj \
+	$(DIR_O)\LiteralSearch.obj \
 	$(DIR_O)\MarginView.obj \
 	$(DIR_O)\PerLine.obj \
+	$(DIR_O)\PieceTable.obj \
 	$(DIR_O)\PositionCache.obj \
 	$(DIR_O)\RESearch.obj \
 	$(DIR_O)\RunStyles.obj \
 	$(DIR_O)\Selection.obj \
 	$(DIR_O)\Style.obj \
+	$(DIR_O)\TextScanner.obj \
 	$(DIR_O)\UndoHistory.obj \
 	$(DIR_O)\UniConversion.obj \
 	$(DIR_O)\UniqueString.obj \
@@ -210,6 +210,8 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SCI_GETMARGINBACKN 2251
 #define SCI_SETMARGINS 2252
 #define SCI_GETMARGINS 2253
+#define SCI_SETLINENUMBEROFFSET 2825
+#define SCI_GETLINENUMBEROFFSET 2826
 #define STYLE_DEFAULT 32
 #define STYLE_LINENUMBER 33
 #define STYLE_BRACELIGHT 34
@@ -368,6 +370,10 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SCI_GETUNDOACTIONTYPE 2802
 #define SCI_GETUNDOACTIONPOSITION 2803
 #define SCI_GETUNDOACTIONTEXT 2804
+#define SCI_SETUNDOMEMORYLIMIT 2822
+#define SCI_GETUNDOMEMORYLIMIT 2823
+#define SCI_GETUNDOMEMORY 2824
+#define SCI_GETUNDOSPILLFAILED 2828
 #define INDIC_PLAIN 0
 #define INDIC_SQUIGGLE 1
 #define INDIC_TT 2
@@ -524,8 +530,12 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SCFIND_REGEXP 0x00200000
 #define SCFIND_POSIX 0x00400000
 #define SCFIND_CXX11REGEX 0x00800000
+#define SCFIND_LINEARREGEX 0x01000000
 #define SCI_FINDTEXT 2150
 #define SCI_FINDTEXTFULL 2196
+#define SCI_FINDALL 2818
+#define SCI_SETSEARCHTHREADS 2820
+#define SCI_GETSEARCHTHREADS 2821
 #define SCI_FORMATRANGE 2151
 #define SCI_FORMATRANGEFULL 2777
 #define SC_CHANGE_HISTORY_DISABLED 0
@@ -602,6 +612,7 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SCI_REPLACETARGETMINIMAL 2779
 #define SCI_SEARCHINTARGET 2197
 #define SCI_SETSEARCHFLAGS 2198
+#define SCI_REPLACEALLINTARGET 2819
 #define SCI_GETSEARCHFLAGS 2199
 #define SCI_CALLTIPSHOW 2200
 #define SCI_CALLTIPCANCEL 2201
@@ -849,7 +860,10 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SCI_GETZOOM 2374
 #define SC_DOCUMENTOPTION_DEFAULT 0
 #define SC_DOCUMENTOPTION_STYLES_NONE 0x1
+#define SC_DOCUMENTOPTION_STYLES_RUNS 0x2
 #define SC_DOCUMENTOPTION_TEXT_LARGE 0x100
+#define SC_DOCUMENTOPTION_TEXT_PIECES 0x200
+#define SC_DOCUMENTOPTION_INDEX_TREE 0x400
 #define SCI_CREATEDOCUMENT 2375
 #define SCI_ADDREFDOCUMENT 2376
 #define SCI_RELEASEDOCUMENT 2377
@@ -1135,6 +1149,7 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SCI_SETTECHNOLOGY 2630
 #define SCI_GETTECHNOLOGY 2631
 #define SCI_CREATELOADER 2632
+#define SCI_CREATESEARCHLOADER 2827
 #define SCI_FINDINDICATORSHOW 2640
 #define SCI_FINDINDICATORFLASH 2641
 #define SCI_FINDINDICATORHIDE 2642
@@ -1375,6 +1390,13 @@ struct Sci_TextToFindFull {
 	struct Sci_CharacterRangeFull chrgText;
 };
 
+struct Sci_TextToFindAll {
+	struct Sci_CharacterRangeFull chrg;
+	const char *lpstrText;
+	struct Sci_CharacterRangeFull *ranges;
+	Sci_Position maxRanges;
+};
+
 typedef void *Sci_SurfaceID;
 
 struct Sci_Rectangle {
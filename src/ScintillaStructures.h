@@ -46,6 +46,13 @@ struct TextToFindFull {
 	CharacterRangeFull chrgText;
 };
 
+struct TextToFindAll {
+	CharacterRangeFull chrg;
+	const char *lpstrText;
+	CharacterRangeFull *ranges;
+	Position maxRanges;
+};
+
 using SurfaceID = void *;
 
 struct Rectangle {
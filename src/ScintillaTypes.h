@@ -290,6 +290,7 @@ enum class FindOption {
 	RegExp = 0x00200000,
 	Posix = 0x00400000,
 	Cxx11RegEx = 0x00800000,
+	LinearRegEx = 0x01000000,
 };
 
 enum class ChangeHistoryOption {
@@ -424,7 +425,10 @@ enum class PopUp {
 enum class DocumentOption {
 	Default = 0,
 	StylesNone = 0x1,
+	StylesRuns = 0x2,
 	TextLarge = 0x100,
+	TextPieces = 0x200,
+	IndexTree = 0x400,
 };
 
 enum class Status {
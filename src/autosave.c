@@ -0,0 +1,653 @@
+/*
+ * Background autosave for Notepad+
+ * Keeps the unsaved content of every tab on disk while editing so that a crash loses at
+ * most the last few seconds of work.
+ *
+ * A tab with unsaved edits has a snapshot of its text - the temp file the session journal
+ * names for it - and beside it a delta file with the edits made since the snapshot:
+ *   B length hash          the snapshot the deltas apply to
+ *   I position length      text inserted, the text follows the header line
+ *   D position length      text deleted
+ * Every record is a header line ending with a checksum of the record.
+ *
+ * Edits are read from the undo history, only the actions added since the last capture, so a
+ * capture takes time in proportion to the typing done, not to the size of the document.
+ * A new snapshot (checkpoint) is only needed when the deltas can't describe the change -
+ * undo past the last capture, the undo history emptied - or once they have grown past
+ * AUTOSAVE_CHECKPOINT_BYTES. As that copies the document it waits for a pause in typing.
+ * All files are written by a worker thread in the order the captures were made.
+ */
+
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "autosave.h"
+#include "tabs.h"
+#include "fileops.h"
+#include "session.h"
+#include "Scintilla.h"
+
+#define DELTA_EXTENSION         ".delta"
+#define DELTA_MAX_HEADER        80
+
+/* SCI_GETUNDOACTIONTYPE - the low byte is the type, container actions don't change text */
+#define UNDO_ACTION_TYPE_MASK   0xFF
+#define UNDO_ACTION_INSERT      0
+#define UNDO_ACTION_REMOVE      1
+
+/* Start of the edit hash checked against the undo actions a delta is built from - text
+ * changed without an undo action, such as with undo collection off or after the undo history
+ * was emptied, makes them differ and forces a checkpoint instead */
+#define AUTOSAVE_EDIT_HASH_SEED 2166136261u
+
+typedef enum {
+    AUTOSAVE_JOB_DELTAS,        /* Append records to the delta file */
+    AUTOSAVE_JOB_CHECKPOINT,    /* Replace the snapshot and start a new delta file */
+    AUTOSAVE_JOB_DELETE         /* Remove the snapshot and its deltas */
+} AutosaveJobType;
+
+typedef struct AutosaveJob {
+    AutosaveJobType type;
+    char snapshotPath[MAX_PATH];
+    char* data;                 /* Delta records or the text of the document */
+    size_t length;
+    struct AutosaveJob* next;
+} AutosaveJob;
+
+/* Growable buffer the delta records of a capture are formatted into */
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} DeltaBuffer;
+
+typedef struct {
+    char type;
+    long long position;
+    long long length;
+    unsigned long long hash;
+    const char* text;
+} DeltaRecord;
+
+static HANDLE g_worker = NULL;
+static HANDLE g_wakeEvent = NULL;       /* Set when jobs are queued and on shutdown */
+static HANDLE g_idleEvent = NULL;       /* Set while there is nothing left to write */
+static CRITICAL_SECTION g_queueLock;
+static AutosaveJob* g_queueHead = NULL;
+static AutosaveJob* g_queueTail = NULL;
+static volatile LONG g_stopping = 0;
+static HWND g_notifyWindow = NULL;
+
+static BOOL DeltaBufferReserve(DeltaBuffer* buffer, size_t length)
+{
+    if (buffer->length + length > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity * 2 : 4096;
+        while (capacity < buffer->length + length) {
+            capacity *= 2;
+        }
+        char* data = (char*)realloc(buffer->data, capacity);
+        if (!data) {
+            return FALSE;
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+    return TRUE;
+}
+
+static BOOL DeltaBufferAppend(DeltaBuffer* buffer, const char* text, size_t length)
+{
+    if (!DeltaBufferReserve(buffer, length)) {
+        return FALSE;
+    }
+    if (length > 0) {
+        memcpy(buffer->data + buffer->length, text, length);
+        buffer->length += length;
+    }
+    return TRUE;
+}
+
+/* FNV-1a over a record's header fields and text */
+static unsigned int RecordChecksum(const char* header, size_t headerLength, const char* text, size_t textLength)
+{
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < headerLength; i++) {
+        hash ^= (unsigned char)header[i];
+        hash *= 16777619u;
+    }
+    for (size_t i = 0; i < textLength; i++) {
+        hash ^= (unsigned char)text[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* Fingerprint of a whole snapshot. FNV style but a word at a time so a 200 MB
+ * document is hashed in a few tens of milliseconds. */
+static unsigned long long SnapshotHash(const char* data, size_t length)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    size_t i = 0;
+    for (; i + sizeof(unsigned long long) <= length; i += sizeof(unsigned long long)) {
+        unsigned long long word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 1099511628211ULL;
+    }
+    for (; i < length; i++) {
+        hash = (hash ^ (unsigned char)data[i]) * 1099511628211ULL;
+    }
+    /* Multiplying only carries upwards - fold the high bits back down */
+    hash ^= hash >> 29;
+    return hash ^ (unsigned long long)length;
+}
+
+static BOOL AppendRecord(DeltaBuffer* buffer, const char* header, const char* text, size_t textLength)
+{
+    char line[DELTA_MAX_HEADER];
+    size_t headerLength = strlen(header);
+    sprintf(line, "%s %08x\n", header, RecordChecksum(header, headerLength, text, textLength));
+    return DeltaBufferAppend(buffer, line, strlen(line)) && DeltaBufferAppend(buffer, text, textLength);
+}
+
+/* Parse the record at *offset and move past it. FALSE for a torn or damaged record. */
+static BOOL ReadRecord(const char* data, size_t size, size_t* offset, DeltaRecord* record)
+{
+    const char* start = data + *offset;
+    size_t available = size - *offset;
+    const char* newline = (const char*)memchr(start, '\n', available < DELTA_MAX_HEADER ? available : DELTA_MAX_HEADER);
+    if (!newline) {
+        return FALSE;
+    }
+    const char* mark = newline;
+    while (mark > start && mark[-1] != ' ') {
+        mark--;
+    }
+    if (mark == start) {
+        return FALSE;
+    }
+
+    char header[DELTA_MAX_HEADER];
+    size_t headerLength = (size_t)(mark - 1 - start);
+    memcpy(header, start, headerLength);
+    header[headerLength] = '\0';
+    unsigned int checksum = (unsigned int)strtoul(mark, NULL, 16);
+
+    memset(record, 0, sizeof(DeltaRecord));
+    record->type = header[0];
+    if (record->type == 'B') {
+        if (sscanf(header, "B %lld %llx", &record->length, &record->hash) != 2) {
+            return FALSE;
+        }
+    } else if (record->type == 'I' || record->type == 'D') {
+        if (sscanf(header + 1, " %lld %lld", &record->position, &record->length) != 2) {
+            return FALSE;
+        }
+    } else {
+        return FALSE;
+    }
+    if (record->position < 0 || record->length < 0) {
+        return FALSE;
+    }
+
+    size_t textOffset = (size_t)(newline + 1 - data);
+    size_t textLength = (record->type == 'I') ? (size_t)record->length : 0;
+    if (textLength > size - textOffset) {
+        return FALSE;
+    }
+    record->text = data + textOffset;
+    if (RecordChecksum(header, headerLength, record->text, textLength) != checksum) {
+        return FALSE;
+    }
+    *offset = textOffset + textLength;
+    return TRUE;
+}
+
+static void GetDeltaPath(const char* snapshotPath, char* deltaPath)
+{
+    sprintf(deltaPath, "%s%s", snapshotPath, DELTA_EXTENSION);
+}
+
+/* Snapshot file of a tab - "New N" tabs by name, files by a hash of their path */
+static void GetSnapshotPath(const TabInfo* tab, char* path)
+{
+    char tempDir[MAX_PATH];
+    GetSessionDir(tempDir);
+
+    if (strncmp(tab->filePath, "New ", 4) == 0) {
+        sprintf(path, "%s%s.txt", tempDir, tab->filePath);
+    } else {
+        unsigned int hash = 0;
+        const char* p = tab->filePath;
+        while (*p) {
+            hash = hash * 31 + (unsigned char)*p++;
+        }
+        sprintf(path, "%sunsaved_%u.tmp", tempDir, hash);
+    }
+}
+
+static BOOL AppendToFile(const char* path, const char* data, size_t length)
+{
+    HANDLE file = CreateFile(path, FILE_APPEND_DATA, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return FALSE;
+    }
+    DWORD written = 0;
+    BOOL ok = WriteFile(file, data, (DWORD)length, &written, NULL) && written == (DWORD)length;
+    ok = ok && FlushFileBuffers(file);
+    CloseHandle(file);
+    return ok;
+}
+
+static BOOL RunJob(AutosaveJob* job)
+{
+    char deltaPath[MAX_PATH + sizeof(DELTA_EXTENSION)];
+    GetDeltaPath(job->snapshotPath, deltaPath);
+
+    switch (job->type) {
+        case AUTOSAVE_JOB_DELTAS:
+            return AppendToFile(deltaPath, job->data, job->length);
+
+        case AUTOSAVE_JOB_CHECKPOINT:
+            {
+                /* If the delta file isn't replaced after the snapshot, its B record no
+                 * longer matches and replay ignores the stale deltas */
+                DeltaBuffer base = {0};
+                char header[DELTA_MAX_HEADER];
+                sprintf(header, "B %lld %016llx", (long long)job->length, SnapshotHash(job->data, job->length));
+                BOOL ok = AppendRecord(&base, header, NULL, 0) &&
+                          WriteBufferToFile(job->snapshotPath, job->data, job->length) &&
+                          WriteBufferToFile(deltaPath, base.data, base.length);
+                if (!ok) {
+                    /* The deltas queued after this checkpoint must not be appended to the old one */
+                    DeleteFile(deltaPath);
+                }
+                free(base.data);
+                return ok;
+            }
+
+        case AUTOSAVE_JOB_DELETE:
+            DeleteFile(deltaPath);
+            DeleteFile(job->snapshotPath);
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static DWORD WINAPI AutosaveThreadProc(LPVOID param)
+{
+    (void)param;
+
+    for (;;) {
+        WaitForSingleObject(g_wakeEvent, INFINITE);
+
+        for (;;) {
+            EnterCriticalSection(&g_queueLock);
+            AutosaveJob* job = g_queueHead;
+            if (job) {
+                g_queueHead = job->next;
+                if (!g_queueHead) {
+                    g_queueTail = NULL;
+                }
+            } else {
+                SetEvent(g_idleEvent);
+            }
+            LeaveCriticalSection(&g_queueLock);
+            if (!job) {
+                break;
+            }
+
+            if (!RunJob(job)) {
+                /* The UI thread drops the tab's base so its next capture is a checkpoint */
+                char* path = _strdup(job->snapshotPath);
+                if (path && !PostMessage(g_notifyWindow, WM_AUTOSAVE_FAILED, 0, (LPARAM)path)) {
+                    free(path);
+                }
+            }
+            free(job->data);
+            free(job);
+        }
+
+        if (g_stopping) {
+            break;
+        }
+    }
+    return 0;
+}
+
+/* Hand a job to the worker - takes ownership of data */
+static BOOL QueueJob(AutosaveJobType type, const char* snapshotPath, char* data, size_t length)
+{
+    AutosaveJob* job = (AutosaveJob*)malloc(sizeof(AutosaveJob));
+    if (!job) {
+        free(data);
+        return FALSE;
+    }
+    job->type = type;
+    strncpy(job->snapshotPath, snapshotPath, MAX_PATH - 1);
+    job->snapshotPath[MAX_PATH - 1] = '\0';
+    job->data = data;
+    job->length = length;
+    job->next = NULL;
+
+    if (!g_worker) {
+        /* No worker thread - write on this one */
+        BOOL ok = RunJob(job);
+        free(job->data);
+        free(job);
+        return ok;
+    }
+
+    EnterCriticalSection(&g_queueLock);
+    if (g_queueTail) {
+        g_queueTail->next = job;
+    } else {
+        g_queueHead = job;
+    }
+    g_queueTail = job;
+    ResetEvent(g_idleEvent);
+    LeaveCriticalSection(&g_queueLock);
+    SetEvent(g_wakeEvent);
+    return TRUE;
+}
+
+/* Start the worker thread. Without it autosave still works but writes on the UI thread. */
+BOOL InitializeAutosave(HWND notifyWindow)
+{
+    if (g_worker) {
+        return TRUE;
+    }
+
+    g_notifyWindow = notifyWindow;
+    g_stopping = 0;
+    InitializeCriticalSection(&g_queueLock);
+    g_wakeEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    g_idleEvent = CreateEvent(NULL, TRUE, TRUE, NULL);
+    if (g_wakeEvent && g_idleEvent) {
+        g_worker = CreateThread(NULL, 0, AutosaveThreadProc, NULL, 0, NULL);
+    }
+    return g_worker != NULL;
+}
+
+/* Finish writing everything queued and stop the worker */
+void CleanupAutosave(void)
+{
+    if (g_worker) {
+        InterlockedExchange(&g_stopping, 1);
+        SetEvent(g_wakeEvent);
+        WaitForSingleObject(g_worker, INFINITE);
+        CloseHandle(g_worker);
+        g_worker = NULL;
+    }
+    if (g_wakeEvent) {
+        CloseHandle(g_wakeEvent);
+        CloseHandle(g_idleEvent);
+        DeleteCriticalSection(&g_queueLock);
+        g_wakeEvent = NULL;
+        g_idleEvent = NULL;
+    }
+}
+
+void AutosaveFlush(void)
+{
+    if (g_worker) {
+        WaitForSingleObject(g_idleEvent, INFINITE);
+    }
+}
+
+/* Fold an edit into the hash of the edits since the last capture */
+static unsigned int HashEdit(unsigned int hash, int type, long long position, long long length)
+{
+    long long fields[3] = { type, position, length };
+    const unsigned char* bytes = (const unsigned char*)fields;
+    for (size_t i = 0; i < sizeof(fields); i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* Called for every insertion and deletion so has to stay cheap */
+void AutosaveNoteEdit(TabInfo* tab, int modificationType, INT_PTR position, INT_PTR length)
+{
+    tab->sessionDirty = TRUE;
+    tab->lastEditTime = GetTickCount();
+    tab->autosaveEditHash = HashEdit(tab->autosaveEditHash,
+                                     (modificationType & SC_MOD_INSERTTEXT) ? UNDO_ACTION_INSERT : UNDO_ACTION_REMOVE,
+                                     position, length);
+
+    if (modificationType & SC_PERFORMED_UNDO) {
+        /* Actions undone past the last capture can't be described by new deltas */
+        int current = (int)SendMessage(tab->editorHandle, SCI_GETUNDOCURRENT, 0, 0);
+        if (current < tab->autosaveLowAction) {
+            tab->autosaveLowAction = current;
+        }
+    }
+}
+
+static void MarkCaptured(TabInfo* tab, int current, INT_PTR length)
+{
+    tab->autosaveAction = current;
+    tab->autosaveLowAction = current;
+    tab->autosaveLength = length;
+    tab->autosaveEditHash = AUTOSAVE_EDIT_HASH_SEED;
+    tab->sessionDirty = FALSE;
+}
+
+/* Format the undo actions since the last capture as delta records. Fails if they don't
+ * account for the document's length - the undo history was emptied or bypassed. */
+static BOOL CaptureDeltas(SciFnDirect fn, sptr_t ptr, const TabInfo* tab, int current, INT_PTR length,
+                          DeltaBuffer* deltas)
+{
+    INT_PTR expectedLength = tab->autosaveLength;
+    unsigned int editHash = AUTOSAVE_EDIT_HASH_SEED;
+    char header[DELTA_MAX_HEADER];
+    char* text = NULL;
+    size_t textCapacity = 0;
+    BOOL ok = TRUE;
+
+    for (int action = tab->autosaveAction; action < current && ok; action++) {
+        int type = (int)fn(ptr, SCI_GETUNDOACTIONTYPE, action, 0) & UNDO_ACTION_TYPE_MASK;
+        long long position = (long long)fn(ptr, SCI_GETUNDOACTIONPOSITION, action, 0);
+        size_t textLength = (size_t)fn(ptr, SCI_GETUNDOACTIONTEXT, action, 0);
+
+        if (type == UNDO_ACTION_INSERT) {
+            if (textLength > textCapacity) {
+                char* grown = (char*)realloc(text, textLength);
+                if (!grown) {
+                    ok = FALSE;
+                    break;
+                }
+                text = grown;
+                textCapacity = textLength;
+            }
+            fn(ptr, SCI_GETUNDOACTIONTEXT, action, (sptr_t)text);
+            sprintf(header, "I %lld %lld", position, (long long)textLength);
+            ok = AppendRecord(deltas, header, text, textLength);
+            expectedLength += (INT_PTR)textLength;
+            editHash = HashEdit(editHash, type, position, (long long)textLength);
+        } else if (type == UNDO_ACTION_REMOVE) {
+            sprintf(header, "D %lld %lld", position, (long long)textLength);
+            ok = AppendRecord(deltas, header, NULL, 0);
+            expectedLength -= (INT_PTR)textLength;
+            editHash = HashEdit(editHash, type, position, (long long)textLength);
+        }
+    }
+    free(text);
+    return ok && expectedLength == length && editHash == tab->autosaveEditHash;
+}
+
+/* Copy the document out of both halves of the gap buffer without moving the gap */
+static char* CopyDocument(SciFnDirect fn, sptr_t ptr, INT_PTR length)
+{
+    char* text = (char*)malloc(length > 0 ? (size_t)length : 1);
+    if (!text) {
+        return NULL;
+    }
+    INT_PTR gap = (INT_PTR)fn(ptr, SCI_GETGAPPOSITION, 0, 0);
+    if (gap > 0) {
+        memcpy(text, (const char*)fn(ptr, SCI_GETRANGEPOINTER, 0, gap), (size_t)gap);
+    }
+    if (length > gap) {
+        memcpy(text + gap, (const char*)fn(ptr, SCI_GETRANGEPOINTER, gap, length - gap), (size_t)(length - gap));
+    }
+    return text;
+}
+
+void AutosaveTab(TabInfo* tab, BOOL final)
+{
+    BOOL isNewFile = (strncmp(tab->filePath, "New ", 4) == 0);
+
+    if (!tab->editorHandle || tab->loadJob) {
+        /* Placeholder or still loading - nothing can have been edited */
+        return;
+    }
+
+    if (!isNewFile && !tab->isModified) {
+        /* Saved since the last capture - the file on disk is the content now */
+        if (tab->tempFilePath[0] != '\0') {
+            QueueJob(AUTOSAVE_JOB_DELETE, tab->tempFilePath, NULL, 0);
+            tab->tempFilePath[0] = '\0';
+        }
+        tab->autosaveBase = FALSE;
+        tab->sessionDirty = FALSE;
+        return;
+    }
+
+    if (!tab->sessionDirty && tab->tempFilePath[0] != '\0') {
+        return;
+    }
+
+    SciFnDirect fn = (SciFnDirect)SendMessage(tab->editorHandle, SCI_GETDIRECTFUNCTION, 0, 0);
+    sptr_t ptr = (sptr_t)SendMessage(tab->editorHandle, SCI_GETDIRECTPOINTER, 0, 0);
+    if (!fn || !ptr) {
+        return;
+    }
+    int current = (int)fn(ptr, SCI_GETUNDOCURRENT, 0, 0);
+    INT_PTR length = (INT_PTR)fn(ptr, SCI_GETLENGTH, 0, 0);
+
+    if (tab->autosaveBase && tab->tempFilePath[0] != '\0' &&
+        tab->autosaveLowAction >= tab->autosaveAction && current >= tab->autosaveAction &&
+        current - tab->autosaveAction <= AUTOSAVE_MAX_DELTA_ACTIONS) {
+        DeltaBuffer deltas = {0};
+        if (CaptureDeltas(fn, ptr, tab, current, length, &deltas) &&
+            (final || tab->autosaveDeltaBytes + deltas.length <= AUTOSAVE_CHECKPOINT_BYTES)) {
+            if (deltas.length == 0) {
+                MarkCaptured(tab, current, length);
+            } else if (QueueJob(AUTOSAVE_JOB_DELTAS, tab->tempFilePath, deltas.data, deltas.length)) {
+                tab->autosaveDeltaBytes += deltas.length;
+                MarkCaptured(tab, current, length);
+            } else {
+                tab->autosaveBase = FALSE;
+            }
+            return;
+        }
+        free(deltas.data);
+    }
+
+    /* Checkpoint - copying the document waits for a pause in typing */
+    if (!final && GetTickCount() - tab->lastEditTime < AUTOSAVE_IDLE_TIME) {
+        return;
+    }
+    char* text = CopyDocument(fn, ptr, length);
+    if (!text) {
+        return;
+    }
+    GetSnapshotPath(tab, tab->tempFilePath);
+    tab->autosaveBase = QueueJob(AUTOSAVE_JOB_CHECKPOINT, tab->tempFilePath, text, (size_t)length);
+    if (tab->autosaveBase) {
+        tab->autosaveDeltaBytes = 0;
+        MarkCaptured(tab, current, length);
+    }
+}
+
+/* Read a whole file - NULL if it doesn't exist */
+static char* ReadWholeFile(const char* path, size_t* size)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* data = (fileSize > 0) ? (char*)malloc((size_t)fileSize) : NULL;
+    if (data && fread(data, 1, (size_t)fileSize, file) != (size_t)fileSize) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *size = data ? (size_t)fileSize : 0;
+    return data;
+}
+
+void AutosaveRestoreTab(TabInfo* tab)
+{
+    tab->autosaveBase = FALSE;
+    if (!tab->editorHandle || tab->tempFilePath[0] == '\0') {
+        return;
+    }
+
+    char deltaPath[MAX_PATH + sizeof(DELTA_EXTENSION)];
+    size_t size = 0;
+    GetDeltaPath(tab->tempFilePath, deltaPath);
+    char* data = ReadWholeFile(deltaPath, &size);
+    if (!data) {
+        /* Snapshot without deltas - the first capture after an edit takes a checkpoint */
+        return;
+    }
+
+    SciFnDirect fn = (SciFnDirect)SendMessage(tab->editorHandle, SCI_GETDIRECTFUNCTION, 0, 0);
+    sptr_t ptr = (sptr_t)SendMessage(tab->editorHandle, SCI_GETDIRECTPOINTER, 0, 0);
+    INT_PTR length = (INT_PTR)fn(ptr, SCI_GETLENGTH, 0, 0);
+
+    /* Only apply deltas written for exactly this snapshot */
+    DeltaRecord record;
+    size_t offset = 0;
+    if (!ReadRecord(data, size, &offset, &record) || record.type != 'B' || record.length != (long long)length ||
+        record.hash != SnapshotHash((const char*)fn(ptr, SCI_GETCHARACTERPOINTER, 0, 0), (size_t)length)) {
+        free(data);
+        return;
+    }
+
+    int collecting = (int)fn(ptr, SCI_GETUNDOCOLLECTION, 0, 0);
+    fn(ptr, SCI_SETUNDOCOLLECTION, 0, 0);
+    BOOL complete = TRUE;
+    while (offset < size) {
+        if (!ReadRecord(data, size, &offset, &record) || record.position > (long long)length) {
+            complete = FALSE;
+            break;
+        }
+        if (record.type == 'I') {
+            fn(ptr, SCI_SETTARGETRANGE, (uptr_t)record.position, (sptr_t)record.position);
+            fn(ptr, SCI_REPLACETARGET, (uptr_t)record.length, (sptr_t)record.text);
+            length += (INT_PTR)record.length;
+        } else if (record.type == 'D' && record.position + record.length <= (long long)length) {
+            fn(ptr, SCI_DELETERANGE, (uptr_t)record.position, (sptr_t)record.length);
+            length -= (INT_PTR)record.length;
+        } else {
+            complete = FALSE;
+            break;
+        }
+    }
+    fn(ptr, SCI_SETUNDOCOLLECTION, collecting, 0);
+    free(data);
+
+    /* A torn record at the end has to be replaced before anything is appended after it */
+    tab->autosaveBase = complete;
+    tab->autosaveDeltaBytes = size;
+    MarkCaptured(tab, (int)fn(ptr, SCI_GETUNDOCURRENT, 0, 0), length);
+}
+
+void AutosaveFailed(char* snapshotPath)
+{
+    int tabCount = GetTabCount();
+    for (int i = 0; i < tabCount; i++) {
+        TabInfo* tab = GetTab(i);
+        if (tab && _stricmp(tab->tempFilePath, snapshotPath) == 0) {
+            tab->autosaveBase = FALSE;
+            tab->sessionDirty = TRUE;
+        }
+    }
+    free(snapshotPath);
+}
@@ -0,0 +1,48 @@
+/*
+ * Background autosave header for Notepad+
+ * Keeps the unsaved content of every tab on disk while editing
+ */
+
+#ifndef AUTOSAVE_H
+#define AUTOSAVE_H
+
+#include <windows.h>
+#include "tabs.h"
+
+/* How often the edits of dirty tabs are captured (milliseconds) */
+#define AUTOSAVE_INTERVAL           5000
+
+/* A full checkpoint waits until the document hasn't been edited for this long (milliseconds) */
+#define AUTOSAVE_IDLE_TIME          2000
+
+/* Deltas written since the last checkpoint before a new checkpoint is taken */
+#define AUTOSAVE_CHECKPOINT_BYTES   (8 * 1024 * 1024)
+
+/* Captures with more undo actions than this are written as a checkpoint instead */
+#define AUTOSAVE_MAX_DELTA_ACTIONS  100000
+
+/* Posted when the worker couldn't write a tab's autosave - lParam is the snapshot path
+ * allocated with malloc, passed on to AutosaveFailed */
+#define WM_AUTOSAVE_FAILED          (WM_APP + 3)
+
+/* Autosave system initialization */
+BOOL InitializeAutosave(HWND notifyWindow);
+void CleanupAutosave(void);
+
+/* Record an edit from SCN_MODIFIED */
+void AutosaveNoteEdit(TabInfo* tab, int modificationType, INT_PTR position, INT_PTR length);
+
+/* Write what changed in a tab since it was last captured. Unless final, full
+ * checkpoints wait for a pause in typing. */
+void AutosaveTab(TabInfo* tab, BOOL final);
+
+/* Wait until everything queued has been written */
+void AutosaveFlush(void);
+
+/* Bring a tab just loaded from its snapshot up to date with the deltas written after it */
+void AutosaveRestoreTab(TabInfo* tab);
+
+/* WM_AUTOSAVE_FAILED handler */
+void AutosaveFailed(char* snapshotPath);
+
+#endif /* AUTOSAVE_H */
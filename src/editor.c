@@ -11,6 +11,8 @@
 #include "editor.h"
 #include "resource.h"
 #include "config.h"
+#include "tabs.h"
+#include "fileops.h"
 
 /* Editor state */
 static HWND g_hEditor = NULL;
@@ -138,6 +140,8 @@ void ConfigureEditor(void)
     
     /* Set basic editor properties */
     SendEditor(SCI_SETCODEPAGE, CP_UTF8, 0);
+    SendEditor(SCI_SETSEARCHTHREADS, EDITOR_SEARCH_THREADS, 0);
+    SendEditor(SCI_SETUNDOMEMORYLIMIT, EDITOR_UNDO_MEMORY_LIMIT, 0);
     SendEditor(SCI_SETCARETLINEVISIBLE, 1, 0);
     SendEditor(SCI_SETCARETLINEBACK, 0xE8E8E8, 0);
     SendEditor(SCI_SETHSCROLLBAR, 1, 0);
@@ -253,30 +257,9 @@ BOOL EditorSaveFile(void)
         return EditorSaveFileAs();
     }
     
-    /* Get text from editor */
-    long textLength = (long)SendEditor(SCI_GETLENGTH, 0, 0);
-    char* buffer = (char*)malloc(textLength + 1);
-    if (!buffer) {
-        MessageBox(NULL, "Out of memory", "Error", MB_ICONERROR | MB_OK);
-        return FALSE;
-    }
-    
-    SendEditor(SCI_GETTEXT, textLength + 1, (sptr_t)buffer);
-    
-    /* Write to file */
-    FILE* file = fopen(g_currentFile, "wb");
-    if (!file) {
-        free(buffer);
-        MessageBox(NULL, "Failed to save file", "Error", MB_ICONERROR | MB_OK);
-        return FALSE;
-    }
-    
-    size_t bytesWritten = fwrite(buffer, 1, textLength, file);
-    fclose(file);
-    free(buffer);
-    
-    if (bytesWritten != (size_t)textLength) {
-        MessageBox(NULL, "Failed to write complete file", "Error", MB_ICONERROR | MB_OK);
+    /* Streamed through a temporary file so a failed save can't truncate the original */
+    if (!WriteEditorToFile(g_hEditor, g_currentFile, ENCODING_UTF8)) {
+        MessageBox(NULL, "Failed to save file. The file on disk has not been changed.", "Error", MB_ICONERROR | MB_OK);
         return FALSE;
     }
     
@@ -641,16 +624,10 @@ BOOL IsWordAutocompleteEnabled(void)
     return g_wordAutocompleteEnabled;
 }
 
-/* Comparison function for qsort */
-static int CompareStrings(const void* a, const void* b)
-{
-    return strcmp(*(const char**)a, *(const char**)b);
-}
-
-/* Trigger word autocomplete at current position */
-void TriggerWordAutocompleteForEditor(HWND editorHandle)
+/* Trigger word autocomplete at current position from the document's word index */
+void TriggerWordAutocompleteForEditor(HWND editorHandle, WordIndex* index)
 {
-    if (!editorHandle || !g_wordAutocompleteEnabled) return;
+    if (!editorHandle || !index || !g_wordAutocompleteEnabled) return;
     
     /* Don't show if autocomplete is already active */
     if (SendMessage(editorHandle, SCI_AUTOCACTIVE, 0, 0)) {
@@ -684,78 +661,10 @@ void TriggerWordAutocompleteForEditor(HWND editorHandle)
     SendMessage(editorHandle, SCI_GETTEXTRANGE, 0, (LPARAM)&tr);
     partialWord[charsTyped] = '\0';
     
-    /* Get all text from document */
-    long textLength = (long)SendMessage(editorHandle, SCI_GETLENGTH, 0, 0);
-    char* buffer = (char*)malloc(textLength + 1);
-    if (!buffer) return;
-    
-    SendMessage(editorHandle, SCI_GETTEXT, textLength + 1, (LPARAM)buffer);
-    
-    /* Collect unique words that start with the partial word */
-    char** words = (char**)malloc(sizeof(char*) * 1000);  /* Max 1000 words */
-    int wordCount = 0;
-    int maxWords = 1000;
-    
-    /* Tokenize the buffer to find words */
-    char* token = strtok(buffer, " \t\n\r.,;:!?()[]{}\"'<>/\\|@#$%^&*+-=~`");
-    while (token != NULL && wordCount < maxWords) {
-        /* Check if word starts with partial word and is longer */
-        if (strlen(token) > (size_t)charsTyped && 
-            _strnicmp(token, partialWord, charsTyped) == 0 &&
-            strcmp(token, partialWord) != 0) {
-            
-            /* Check if word is already in list */
-            BOOL found = FALSE;
-            for (int i = 0; i < wordCount; i++) {
-                if (_stricmp(words[i], token) == 0) {
-                    found = TRUE;
-                    break;
-                }
-            }
-            
-            /* Add word if not duplicate */
-            if (!found) {
-                words[wordCount] = _strdup(token);
-                if (words[wordCount]) {
-                    wordCount++;
-                }
-            }
-        }
-        
-        token = strtok(NULL, " \t\n\r.,;:!?()[]{}\"'<>/\\|@#$%^&*+-=~`");
-    }
-    
-    free(buffer);
-    
-    /* If we found matching words, show autocomplete */
-    if (wordCount > 0) {
-        /* Sort words alphabetically */
-        qsort(words, wordCount, sizeof(char*), CompareStrings);
-        
-        /* Build space-separated list for Scintilla */
-        size_t totalLen = 0;
-        for (int i = 0; i < wordCount; i++) {
-            totalLen += strlen(words[i]) + 1;  /* +1 for space/null */
-        }
-        
-        char* wordList = (char*)malloc(totalLen + 1);
-        if (wordList) {
-            wordList[0] = '\0';
-            for (int i = 0; i < wordCount; i++) {
-                if (i > 0) strcat(wordList, " ");
-                strcat(wordList, words[i]);
-            }
-            
-            /* Show autocomplete list */
-            SendMessage(editorHandle, SCI_AUTOCSHOW, charsTyped, (LPARAM)wordList);
-            
-            free(wordList);
-        }
-    }
-    
-    /* Free word list */
-    for (int i = 0; i < wordCount; i++) {
-        free(words[i]);
+    /* Words starting with the partial word, already sorted and without duplicates */
+    char* wordList = NULL;
+    if (WordIndexComplete(index, partialWord, (size_t)charsTyped, WORD_AUTOCOMPLETE_MAX_WORDS, &wordList) > 0) {
+        SendMessage(editorHandle, SCI_AUTOCSHOW, charsTyped, (LPARAM)wordList);
     }
-    free(words);
+    free(wordList);
 }
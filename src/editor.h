@@ -8,6 +8,7 @@
 
 #include <windows.h>
 #include "Scintilla.h"
+#include "wordindex.h"
 
 /* Editor initialization and cleanup */
 BOOL InitializeEditor(HWND parentWindow);
@@ -48,10 +49,19 @@ void EnableChangeHistory(HWND editor, BOOL enable);
 BOOL IsChangeHistoryEnabled(void);
 BOOL IsAutoIndentEnabled(void);
 
+/* Threads Scintilla may use to find every match in large documents - it limits this
+ * to the processor count, so asking for many uses all of them */
+#define EDITOR_SEARCH_THREADS 64
+
+/* Memory each document's undo history may use before its oldest text is compressed and
+ * then written to a temporary file, so long sessions on large files stay bounded */
+#define EDITOR_UNDO_MEMORY_LIMIT (64 * 1024 * 1024)
+
 /* Autocomplete features */
+#define WORD_AUTOCOMPLETE_MAX_WORDS 1000  /* Longest list shown */
 void SetWordAutocomplete(BOOL enable);
 BOOL IsWordAutocompleteEnabled(void);
-void TriggerWordAutocompleteForEditor(HWND editorHandle);
+void TriggerWordAutocompleteForEditor(HWND editorHandle, WordIndex* index);
 
 /* Editor state and information */
 BOOL IsModified(void);
@@ -14,8 +14,54 @@
 #include "syntax.h"
 #include "statusbar.h"
 #include "Scintilla.h"
+#include "scintilla_bridge.h"
 #include "lexer_mappings_generated.h"
 
+/* File load profiling - set to 1 to log load time, first paint and peak memory (debug builds only) */
+#ifndef PROFILE_FILE_LOAD
+#define PROFILE_FILE_LOAD 0
+#endif
+
+#if PROFILE_FILE_LOAD
+#include <psapi.h>
+static LARGE_INTEGER g_loadFreq;
+static LARGE_INTEGER g_loadStart;
+static HWND g_loadEditor = NULL;
+static unsigned long long g_loadSize = 0;
+static FILE* g_loadProfileFile = NULL;
+
+static void FL_PROFILE_START(HWND editor, unsigned long long size) {
+    if (!g_loadProfileFile) {
+        char profilePath[MAX_PATH];
+        GetModuleFileName(NULL, profilePath, MAX_PATH);
+        char* sl = strrchr(profilePath, '\\');
+        if (sl) { sl[1] = '\0'; strcat(profilePath, "fileload_profile.txt"); }
+        g_loadProfileFile = fopen(profilePath, "a");
+    }
+    QueryPerformanceFrequency(&g_loadFreq);
+    QueryPerformanceCounter(&g_loadStart);
+    g_loadEditor = editor;
+    g_loadSize = size;
+}
+
+static void FL_PROFILE_MARK(const char* label) {
+    LARGE_INTEGER now;
+    PROCESS_MEMORY_COUNTERS pmc;
+    QueryPerformanceCounter(&now);
+    double ms = (double)(now.QuadPart - g_loadStart.QuadPart) * 1000.0 / g_loadFreq.QuadPart;
+    memset(&pmc, 0, sizeof(pmc));
+    GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc));
+    char buf[256];
+    sprintf(buf, "[LOAD] %llu bytes %s: %.2f ms, peak RSS %.1f MB\n", g_loadSize, label, ms,
+            (double)pmc.PeakWorkingSetSize / (1024.0 * 1024.0));
+    OutputDebugString(buf);
+    if (g_loadProfileFile) { fprintf(g_loadProfileFile, "%s", buf); fflush(g_loadProfileFile); }
+}
+#else
+#define FL_PROFILE_START(editor, size)
+#define FL_PROFILE_MARK(label)
+#endif
+
 /* BOM markers */
 static const unsigned char UTF8_BOM[] = {0xEF, 0xBB, 0xBF};
 static const unsigned char UTF16_LE_BOM[] = {0xFF, 0xFE};
@@ -55,8 +101,9 @@ const char* GetLineEndingName(LineEnding lineEnding)
     return "Unknown";
 }
 
-/* Detect file encoding from data */
-int DetectFileEncodingFromData(const char* data, size_t size, BOOL* hasBOM)
+/* Detect the encoding of a sample from the start of a file. complete says whether the
+ * sample is the whole file - if not, a character cut off at its end is not an error. */
+static int DetectEncodingFromSample(const char* data, size_t size, BOOL complete, BOOL* hasBOM)
 {
     if (hasBOM) *hasBOM = FALSE;
     
@@ -82,59 +129,41 @@ int DetectFileEncodingFromData(const char* data, size_t size, BOOL* hasBOM)
         return ENCODING_UTF16_BE;
     }
     
-    /* Check for valid UTF-8 */
-    BOOL isValidUTF8 = TRUE;
-    BOOL hasHighBytes = FALSE;
-    
-    for (size_t i = 0; i < size && isValidUTF8; i++) {
-        if (udata[i] >= 0x80) {
-            hasHighBytes = TRUE;
-            if ((udata[i] & 0xE0) == 0xC0) {
-                /* 2-byte sequence */
-                if (i + 1 >= size || (udata[i + 1] & 0xC0) != 0x80) {
-                    isValidUTF8 = FALSE;
-                } else {
-                    i++;
-                }
-            } else if ((udata[i] & 0xF0) == 0xE0) {
-                /* 3-byte sequence */
-                if (i + 2 >= size || (udata[i + 1] & 0xC0) != 0x80 || (udata[i + 2] & 0xC0) != 0x80) {
-                    isValidUTF8 = FALSE;
-                } else {
-                    i += 2;
-                }
-            } else if ((udata[i] & 0xF8) == 0xF0) {
-                /* 4-byte sequence */
-                if (i + 3 >= size || (udata[i + 1] & 0xC0) != 0x80 || 
-                    (udata[i + 2] & 0xC0) != 0x80 || (udata[i + 3] & 0xC0) != 0x80) {
-                    isValidUTF8 = FALSE;
-                } else {
-                    i += 3;
-                }
-            } else {
-                isValidUTF8 = FALSE;
-            }
-        }
-    }
-    
-    if (isValidUTF8) {
+    /* Valid UTF-8 (including pure ASCII) is UTF-8, anything else is ANSI */
+    void* validator = UTF8ValidatorCreate();
+    if (!validator) {
         return ENCODING_UTF8;
     }
+    BOOL isValidUTF8 = UTF8ValidatorCheck(validator, data, size, complete);
+    UTF8ValidatorRelease(validator);
     
-    /* If not valid UTF-8 and has high bytes, assume ANSI */
-    if (hasHighBytes) {
-        return ENCODING_ANSI;
+    return isValidUTF8 ? ENCODING_UTF8 : ENCODING_ANSI;
+}
+
+/* Detect file encoding from data */
+int DetectFileEncodingFromData(const char* data, size_t size, BOOL* hasBOM)
+{
+    return DetectEncodingFromSample(data, size, TRUE, hasBOM);
+}
+
+/* The most common line ending - CRLF wins ties and text without line ends */
+static int LineEndingFromCounts(Sci_Position crlfCount, Sci_Position lfCount, Sci_Position crCount)
+{
+    if (crlfCount >= lfCount && crlfCount >= crCount) {
+        return LINEEND_CRLF;
+    } else if (lfCount >= crCount) {
+        return LINEEND_LF;
+    } else {
+        return LINEEND_CR;
     }
-    
-    return ENCODING_UTF8;  /* Pure ASCII is valid UTF-8 */
 }
 
 /* Detect line ending type from data */
 int DetectLineEndingFromData(const char* data, size_t size)
 {
-    int crlfCount = 0;
-    int lfCount = 0;
-    int crCount = 0;
+    Sci_Position crlfCount = 0;
+    Sci_Position lfCount = 0;
+    Sci_Position crCount = 0;
     
     for (size_t i = 0; i < size; i++) {
         if (data[i] == '\r') {
@@ -149,14 +178,7 @@ int DetectLineEndingFromData(const char* data, size_t size)
         }
     }
     
-    /* Return the most common line ending */
-    if (crlfCount >= lfCount && crlfCount >= crCount) {
-        return LINEEND_CRLF;
-    } else if (lfCount >= crCount) {
-        return LINEEND_LF;
-    } else {
-        return LINEEND_CR;
-    }
+    return LineEndingFromCounts(crlfCount, lfCount, crCount);
 }
 
 /* Convert from other encoding to UTF-8 */
@@ -183,34 +205,21 @@ char* ConvertToUTF8(const char* data, size_t size, int encoding, size_t* outSize
             return _strdup("");
         }
         
-        const wchar_t* wdata = (const wchar_t*)(data + offset);
-        size_t wlen = (size - offset) / 2;
-        
-        /* Swap bytes for big-endian */
-        wchar_t* swapped = NULL;
-        if (encoding == ENCODING_UTF16_BE) {
-            swapped = (wchar_t*)malloc(wlen * 2);
-            if (swapped) {
-                for (size_t i = 0; i < wlen; i++) {
-                    swapped[i] = ((wdata[i] & 0xFF) << 8) | ((wdata[i] >> 8) & 0xFF);
-                }
-                wdata = swapped;
-            }
-        }
-        
-        /* Convert to UTF-8 */
-        int utf8Size = WideCharToMultiByte(CP_UTF8, 0, wdata, (int)wlen, NULL, 0, NULL, NULL);
-        if (utf8Size > 0) {
-            char* result = (char*)malloc(utf8Size + 1);
-            if (result) {
-                WideCharToMultiByte(CP_UTF8, 0, wdata, (int)wlen, result, utf8Size, NULL, NULL);
+        /* Convert straight from the bytes - no byte swapped copy for big-endian */
+        void* stream = UTF16StreamCreate(encoding == ENCODING_UTF16_BE);
+        size_t maxSize = UTF16StreamMaxOutput(size - offset);
+        char* result = stream ? (char*)malloc(maxSize + 1) : NULL;
+        if (result) {
+            size_t utf8Size = UTF16StreamConvert(stream, data + offset, size - offset, result, maxSize, TRUE);
+            if (utf8Size != (size_t)-1) {
                 result[utf8Size] = '\0';
                 if (outSize) *outSize = utf8Size;
-                if (swapped) free(swapped);
+                UTF16StreamRelease(stream);
                 return result;
             }
+            free(result);
         }
-        if (swapped) free(swapped);
+        UTF16StreamRelease(stream);
     }
     
     if (encoding == ENCODING_ANSI) {
@@ -342,43 +351,274 @@ int ConfirmSaveChanges(HWND parent, const char* fileName)
                      MB_YESNOCANCEL | MB_ICONQUESTION);
 }
 
-/* Save tab to file */
-BOOL SaveTabToFile(int tabIndex)
+/* Streamed save - the document is written straight from the two halves of Scintilla's gap
+ * buffer, converted FILESAVE_CHUNK_SIZE bytes at a time, to a temporary file in the same
+ * directory which then replaces the target. A failed save leaves the original untouched. */
+typedef struct {
+    HANDLE file;
+    int encoding;
+    wchar_t* wide;          /* Converted encodings: FILESAVE_CHUNK_SIZE UTF-16 code units */
+    char* out;              /* UTF-16 BE and ANSI: FILESAVE_CHUNK_SIZE * 2 bytes */
+    char carry[4];          /* UTF-8 character split between the halves of the buffer */
+    int carryLength;
+    BOOL failed;
+} SaveWriter;
+
+static BOOL WriteAll(SaveWriter* writer, const void* data, size_t length)
 {
-    TabInfo* tab = GetTab(tabIndex);
-    if (!tab || !tab->editorHandle) {
+    const char* p = (const char*)data;
+    while (length > 0 && !writer->failed) {
+        DWORD toWrite = (length < FILESAVE_CHUNK_SIZE) ? (DWORD)length : FILESAVE_CHUNK_SIZE;
+        DWORD written = 0;
+        if (!WriteFile(writer->file, p, toWrite, &written, NULL) || written != toWrite) {
+            writer->failed = TRUE;
+        }
+        p += toWrite;
+        length -= toWrite;
+    }
+    return !writer->failed;
+}
+
+/* Convert whole UTF-8 characters to the target encoding and write them.
+ * length is at most FILESAVE_CHUNK_SIZE so the UTF-16 never needs more code units than that. */
+static BOOL WriteConverted(SaveWriter* writer, const char* data, size_t length)
+{
+    if (length == 0) {
+        return !writer->failed;
+    }
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, data, (int)length, writer->wide, FILESAVE_CHUNK_SIZE);
+    if (wlen <= 0) {
+        writer->failed = TRUE;
         return FALSE;
     }
     
-    /* Check if this is a new file */
-    if (strncmp(tab->filePath, "New ", 4) == 0) {
-        return SaveTabToFileAs(tabIndex);
+    if (writer->encoding == ENCODING_UTF16_LE) {
+        return WriteAll(writer, writer->wide, (size_t)wlen * sizeof(wchar_t));
+    }
+    if (writer->encoding == ENCODING_UTF16_BE) {
+        for (int i = 0; i < wlen; i++) {
+            writer->out[i * 2] = (char)((writer->wide[i] >> 8) & 0xFF);
+            writer->out[i * 2 + 1] = (char)(writer->wide[i] & 0xFF);
+        }
+        return WriteAll(writer, writer->out, (size_t)wlen * 2);
+    }
+    int ansiLength = WideCharToMultiByte(CP_ACP, 0, writer->wide, wlen, writer->out, FILESAVE_CHUNK_SIZE * 2, NULL, NULL);
+    if (ansiLength <= 0) {
+        writer->failed = TRUE;
+        return FALSE;
+    }
+    return WriteAll(writer, writer->out, ansiLength);
+}
+
+/* Bytes in the UTF-8 character started by lead - 1 for bytes that can't start one */
+static int UTF8SequenceLength(unsigned char lead)
+{
+    if (lead >= 0xF0 && lead <= 0xF4) return 4;
+    if (lead >= 0xE0) return (lead <= 0xEF) ? 3 : 1;
+    if (lead >= 0xC2) return 2;
+    return 1;
+}
+
+#define IS_UTF8_TRAIL(ch) (((unsigned char)(ch) & 0xC0) == 0x80)
+
+/* Write a contiguous piece of the document. Chunks are cut at character boundaries; a
+ * character cut off by the end of the piece is carried over to the next one. */
+static BOOL WriteDocumentPiece(SaveWriter* writer, const char* data, size_t length, BOOL atEnd)
+{
+    if (writer->encoding == ENCODING_UTF8 || writer->encoding == ENCODING_UTF8_BOM) {
+        return WriteAll(writer, data, length);
+    }
+    
+    size_t pos = 0;
+    if (writer->carryLength > 0) {
+        /* Finish the character from the previous piece - converted as is if it can't be */
+        int needed = UTF8SequenceLength((unsigned char)writer->carry[0]);
+        while (writer->carryLength < needed && pos < length && IS_UTF8_TRAIL(data[pos])) {
+            writer->carry[writer->carryLength++] = data[pos++];
+        }
+        WriteConverted(writer, writer->carry, writer->carryLength);
+        writer->carryLength = 0;
     }
     
-    /* Get text from editor */
-    long textLength = (long)SendMessage(tab->editorHandle, SCI_GETLENGTH, 0, 0);
-    char* buffer = (char*)malloc(textLength + 1);
-    if (!buffer) {
-        MessageBox(NULL, "Out of memory", "Error", MB_ICONERROR | MB_OK);
+    size_t end = length;
+    if (!atEnd) {
+        size_t lead = length;
+        while (lead > pos && length - lead < 3 && IS_UTF8_TRAIL(data[lead - 1])) {
+            lead--;
+        }
+        if (lead > pos && (size_t)UTF8SequenceLength((unsigned char)data[lead - 1]) > length - (lead - 1)) {
+            end = lead - 1;
+            writer->carryLength = (int)(length - end);
+            memcpy(writer->carry, data + end, writer->carryLength);
+        }
+    }
+    
+    while (pos < end && !writer->failed) {
+        size_t chunk = end - pos;
+        if (chunk > FILESAVE_CHUNK_SIZE) {
+            /* End the chunk before the character that straddles the cut */
+            size_t back = 0;
+            chunk = FILESAVE_CHUNK_SIZE;
+            while (back < 3 && IS_UTF8_TRAIL(data[pos + chunk - back])) {
+                back++;
+            }
+            if (!IS_UTF8_TRAIL(data[pos + chunk - back])) {
+                chunk -= back;
+            }
+        }
+        WriteConverted(writer, data + pos, chunk);
+        pos += chunk;
+    }
+    return !writer->failed;
+}
+
+/* Create the temporary file a save writes to - on the same volume as the target so
+ * it can replace it by renaming rather than copying */
+static BOOL BeginSafeWrite(SaveWriter* writer, const char* filePath, char* tempPath)
+{
+    char directory[MAX_PATH];
+    
+    strncpy(directory, filePath, MAX_PATH - 1);
+    directory[MAX_PATH - 1] = '\0';
+    char* slash = strrchr(directory, '\\');
+    if (slash) {
+        slash[1] = '\0';
+    } else {
+        strcpy(directory, ".");
+    }
+    if (!GetTempFileName(directory, "np+", 0, tempPath)) {
+        return FALSE;
+    }
+    
+    writer->file = CreateFile(tempPath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (writer->file == INVALID_HANDLE_VALUE) {
+        DeleteFile(tempPath);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* Flush the temporary file and replace the target with it, or remove it if anything failed */
+static BOOL FinishSafeWrite(SaveWriter* writer, const char* filePath, const char* tempPath)
+{
+    /* Make sure the data is on disk before it replaces the original */
+    if (!writer->failed && !FlushFileBuffers(writer->file)) {
+        writer->failed = TRUE;
+    }
+    CloseHandle(writer->file);
+    
+    /* ReplaceFile keeps what belongs to the original rather than its data - security,
+     * alternate data streams, creation time and attributes. A new file, or one on a volume
+     * that can't be replaced that way, is moved into place instead. */
+    if (!writer->failed &&
+        !ReplaceFile(filePath, tempPath, NULL, REPLACEFILE_IGNORE_MERGE_ERRORS, NULL, NULL)) {
+        DWORD error = GetLastError();
+        if (error != ERROR_FILE_NOT_FOUND && error != ERROR_UNABLE_TO_MOVE_REPLACEMENT &&
+            error != ERROR_UNABLE_TO_MOVE_REPLACEMENT_2 && error != ERROR_NOT_SUPPORTED &&
+            error != ERROR_INVALID_FUNCTION) {
+            writer->failed = TRUE;
+        } else {
+            /* Keep attributes such as hidden, the temporary file was created without them */
+            DWORD attributes = GetFileAttributes(filePath);
+            if (attributes != INVALID_FILE_ATTRIBUTES) {
+                SetFileAttributes(tempPath, attributes & ~FILE_ATTRIBUTE_READONLY);
+            }
+            if (!MoveFileEx(tempPath, filePath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+                writer->failed = TRUE;
+            }
+        }
+    }
+    if (writer->failed) {
+        DeleteFile(tempPath);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* Write the editor's text to filePath in the given encoding without copying the document.
+ * The text goes to a temporary file beside the target which then replaces it. */
+BOOL WriteEditorToFile(HWND editor, const char* filePath, int encoding)
+{
+    SaveWriter writer;
+    char tempPath[MAX_PATH];
+    
+    memset(&writer, 0, sizeof(writer));
+    writer.encoding = encoding;
+    if (!BeginSafeWrite(&writer, filePath, tempPath)) {
         return FALSE;
     }
     
-    SendMessage(tab->editorHandle, SCI_GETTEXT, textLength + 1, (LPARAM)buffer);
+    if (encoding != ENCODING_UTF8 && encoding != ENCODING_UTF8_BOM) {
+        writer.wide = (wchar_t*)malloc(FILESAVE_CHUNK_SIZE * sizeof(wchar_t));
+        writer.out = (char*)malloc(FILESAVE_CHUNK_SIZE * 2);
+        writer.failed = !writer.wide || !writer.out;
+    }
+    
+    if (encoding == ENCODING_UTF8_BOM) {
+        WriteAll(&writer, UTF8_BOM, 3);
+    } else if (encoding == ENCODING_UTF16_LE) {
+        WriteAll(&writer, UTF16_LE_BOM, 2);
+    } else if (encoding == ENCODING_UTF16_BE) {
+        WriteAll(&writer, UTF16_BE_BOM, 2);
+    }
+    
+    /* Each side of the gap is contiguous - asking for either one doesn't move the gap */
+    Sci_Position length = (Sci_Position)SendMessage(editor, SCI_GETLENGTH, 0, 0);
+    Sci_Position gap = (Sci_Position)SendMessage(editor, SCI_GETGAPPOSITION, 0, 0);
+    if (gap > 0) {
+        const char* before = (const char*)SendMessage(editor, SCI_GETRANGEPOINTER, 0, gap);
+        WriteDocumentPiece(&writer, before, (size_t)gap, gap == length);
+    }
+    if (length > gap) {
+        const char* after = (const char*)SendMessage(editor, SCI_GETRANGEPOINTER, gap, length - gap);
+        WriteDocumentPiece(&writer, after, (size_t)(length - gap), TRUE);
+    }
+    
+    free(writer.wide);
+    free(writer.out);
+    
+    return FinishSafeWrite(&writer, filePath, tempPath);
+}
+
+/* Write a buffer to filePath as is, replacing the file atomically like WriteEditorToFile.
+ * Doesn't touch any window so it can be used from worker threads. */
+BOOL WriteBufferToFile(const char* filePath, const char* data, size_t length)
+{
+    SaveWriter writer;
+    char tempPath[MAX_PATH];
+    
+    memset(&writer, 0, sizeof(writer));
+    writer.encoding = ENCODING_UTF8;
+    if (!BeginSafeWrite(&writer, filePath, tempPath)) {
+        return FALSE;
+    }
+    WriteAll(&writer, data, length);
+    return FinishSafeWrite(&writer, filePath, tempPath);
+}
+
+/* Save tab to file */
+BOOL SaveTabToFile(int tabIndex)
+{
+    TabInfo* tab = GetTab(tabIndex);
+    if (!tab || !tab->editorHandle) {
+        return FALSE;
+    }
     
-    /* Write to file */
-    FILE* file = fopen(tab->filePath, "wb");
-    if (!file) {
-        free(buffer);
-        MessageBox(NULL, "Failed to save file", "Error", MB_ICONERROR | MB_OK);
+    /* The editor holds an empty placeholder until a background load completes, and only
+     * a page of a large file */
+    if (tab->loadJob || tab->largeFile) {
         return FALSE;
     }
     
-    size_t bytesWritten = fwrite(buffer, 1, textLength, file);
-    fclose(file);
-    free(buffer);
+    /* Check if this is a new file */
+    if (strncmp(tab->filePath, "New ", 4) == 0) {
+        return SaveTabToFileAs(tabIndex);
+    }
     
-    if (bytesWritten != (size_t)textLength) {
-        MessageBox(NULL, "Failed to write complete file", "Error", MB_ICONERROR | MB_OK);
+    /* Write in the file's own encoding - the original is only replaced once all of it is written */
+    if (!WriteEditorToFile(tab->editorHandle, tab->filePath, tab->encoding)) {
+        MessageBox(NULL, "Failed to save file. The file on disk has not been changed.", "Error", MB_ICONERROR | MB_OK);
         return FALSE;
     }
     
@@ -396,7 +636,7 @@ BOOL SaveTabToFile(int tabIndex)
 BOOL SaveTabToFileAs(int tabIndex)
 {
     TabInfo* tab = GetTab(tabIndex);
-    if (!tab || !tab->editorHandle) {
+    if (!tab || !tab->editorHandle || tab->loadJob || tab->largeFile) {
         return FALSE;
     }
     
@@ -437,99 +677,542 @@ BOOL SaveTabToFileAs(int tabIndex)
     ApplySyntaxHighlightingForFile(tab->editorHandle, filename);
     
     /* Update file type in status bar */
-    const char* extension = strrchr(filename, '.');
-    UpdateFileType(GetFileTypeFromExtension(extension));
+    UpdateFileType(GetFileTypeForEditor(tab->editorHandle, filename));
     
     /* Now save */
     return SaveTabToFile(tabIndex);
 }
 
-/* Load file to tab */
-BOOL LoadFileToTab(int tabIndex, const char* filePath)
+/* Open and map a file for reading - views are mapped on demand by MapFileRange */
+BOOL OpenMappedFile(MappedFile* mf, const char* filePath)
 {
-    TabInfo* tab = GetTab(tabIndex);
-    if (!tab || !tab->editorHandle || !filePath) {
+    LARGE_INTEGER size;
+    
+    memset(mf, 0, sizeof(MappedFile));
+    mf->file = CreateFile(filePath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                          OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (mf->file == INVALID_HANDLE_VALUE) {
+        mf->file = NULL;
         return FALSE;
     }
     
-    /* Open file */
-    FILE* file = fopen(filePath, "rb");
-    if (!file) {
-        MessageBox(NULL, "Failed to open file", "Error", MB_ICONERROR | MB_OK);
+    if (!GetFileSizeEx(mf->file, &size)) {
+        CloseHandle(mf->file);
+        mf->file = NULL;
         return FALSE;
     }
+    mf->size = (unsigned long long)size.QuadPart;
+    mf->viewLimit = FILELOAD_VIEW_SIZE;
+    
+    /* Empty files can't be mapped - nothing to read anyway */
+    if (mf->size > 0) {
+        mf->mapping = CreateFileMapping(mf->file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mf->mapping) {
+            CloseHandle(mf->file);
+            mf->file = NULL;
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* Get a pointer to [offset, offset + length) - remaps the view when the range is outside it.
+ * length must not exceed mf->viewLimit minus the allocation granularity. */
+const char* MapFileRange(MappedFile* mf, unsigned long long offset, size_t length)
+{
+    if (offset + length > mf->size) {
+        return NULL;
+    }
     
-    /* Get file size */
-    fseek(file, 0, SEEK_END);
-    long fileSize = ftell(file);
-    fseek(file, 0, SEEK_SET);
+    if (mf->view && offset >= mf->viewOffset && offset + length <= mf->viewOffset + mf->viewSize) {
+        return mf->view + (offset - mf->viewOffset);
+    }
     
-    /* Read file */
-    char* buffer = (char*)malloc(fileSize + 1);
-    if (!buffer) {
-        fclose(file);
-        MessageBox(NULL, "Out of memory", "Error", MB_ICONERROR | MB_OK);
-        return FALSE;
+    if (mf->view) {
+        UnmapViewOfFile(mf->view);
+        mf->view = NULL;
+    }
+    
+    /* View offsets must be a multiple of the allocation granularity */
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    unsigned long long base = offset - (offset % si.dwAllocationGranularity);
+    unsigned long long remaining = mf->size - base;
+    mf->viewSize = (remaining < mf->viewLimit) ? (size_t)remaining : mf->viewLimit;
+    mf->viewOffset = base;
+    mf->view = (const char*)MapViewOfFile(mf->mapping, FILE_MAP_READ,
+                                          (DWORD)(base >> 32), (DWORD)(base & 0xFFFFFFFF), mf->viewSize);
+    if (!mf->view || offset + length > base + mf->viewSize) {
+        return NULL;
     }
+    return mf->view + (offset - base);
+}
+
+void CloseMappedFile(MappedFile* mf)
+{
+    if (mf->view) UnmapViewOfFile(mf->view);
+    if (mf->mapping) CloseHandle(mf->mapping);
+    if (mf->file) CloseHandle(mf->file);
+    memset(mf, 0, sizeof(MappedFile));
+}
+
+/* Reusable state for converting one chunk at a time */
+typedef struct {
+    void* utf16;        /* UTF-16 to UTF-8 stream - also finishes ANSI conversion */
+    wchar_t* wide;      /* ANSI only: FILELOAD_CHUNK_SIZE UTF-16 code units */
+    char* utf8;         /* utf8Size bytes */
+    size_t utf8Size;
+} ChunkBuffers;
+
+static BOOL AllocChunkBuffers(ChunkBuffers* buffers, int encoding)
+{
+    memset(buffers, 0, sizeof(ChunkBuffers));
+    buffers->utf16 = UTF16StreamCreate(encoding == ENCODING_UTF16_BE);
+    if (encoding == ENCODING_ANSI) {
+        buffers->wide = (wchar_t*)malloc(FILELOAD_CHUNK_SIZE * sizeof(wchar_t));
+    }
+    /* ANSI goes through UTF-16 at up to one code unit per byte */
+    buffers->utf8Size = UTF16StreamMaxOutput(encoding == ENCODING_ANSI ? FILELOAD_CHUNK_SIZE * 2 : FILELOAD_CHUNK_SIZE);
+    buffers->utf8 = (char*)malloc(buffers->utf8Size);
+    return buffers->utf16 && buffers->utf8 && (encoding != ENCODING_ANSI || buffers->wide);
+}
+
+static void FreeChunkBuffers(ChunkBuffers* buffers)
+{
+    UTF16StreamRelease(buffers->utf16);
+    free(buffers->wide);
+    free(buffers->utf8);
+    memset(buffers, 0, sizeof(ChunkBuffers));
+}
+
+/* Convert a chunk of UTF-16 or ANSI text to UTF-8 in buffers->utf8.
+ * UTF-16 code units split by the end of a chunk are carried over by the stream; a double
+ * byte ANSI character split by the end of the chunk is left for the next chunk unless atEnd.
+ * *consumed receives the number of input bytes used. Returns the UTF-8 length or -1. */
+static int ConvertChunkToUTF8(const char* data, size_t size, int encoding, BOOL atEnd,
+                              ChunkBuffers* buffers, size_t* consumed)
+{
+    size_t utf8Length;
     
-    size_t bytesRead = fread(buffer, 1, fileSize, file);
-    buffer[bytesRead] = '\0';
-    fclose(file);
+    if (encoding == ENCODING_UTF16_LE || encoding == ENCODING_UTF16_BE) {
+        *consumed = size;
+        utf8Length = UTF16StreamConvert(buffers->utf16, data, size, buffers->utf8, buffers->utf8Size, atEnd);
+    } else if (encoding == ENCODING_ANSI) {
+        size_t length = size;
+        CPINFO cpInfo;
+        
+        /* Don't split a double byte character */
+        if (!atEnd && GetCPInfo(CP_ACP, &cpInfo) && cpInfo.MaxCharSize > 1) {
+            size_t i = 0;
+            size_t charStart = 0;
+            while (i < size) {
+                charStart = i;
+                i += IsDBCSLeadByte((BYTE)data[i]) ? 2 : 1;
+            }
+            if (i > size) {
+                length = charStart;
+            }
+        }
+        *consumed = length;
+        
+        if (length == 0) {
+            return 0;
+        }
+        int wlen = MultiByteToWideChar(CP_ACP, 0, data, (int)length, buffers->wide, FILELOAD_CHUNK_SIZE);
+        if (wlen <= 0) {
+            return -1;
+        }
+        /* The wide buffer holds little-endian UTF-16 */
+        utf8Length = UTF16StreamConvert(buffers->utf16, (const char*)buffers->wide, (size_t)wlen * sizeof(wchar_t),
+                                        buffers->utf8, buffers->utf8Size, atEnd);
+    } else {
+        return -1;
+    }
     
-    /* Detect and convert encoding */
+    return (utf8Length == (size_t)-1) ? -1 : (int)utf8Length;
+}
+
+/* A file being loaded - prepared and attached on the UI thread, streamed on any thread */
+struct FileLoadJob {
+    char filePath[MAX_PATH];
+    HWND editor;                    /* Editor that created the loader */
+    HWND notifyWindow;              /* Receives WM_FILELOAD_PROGRESS and WM_FILELOAD_DONE */
+    HANDLE thread;                  /* Worker thread for background loads */
+    MappedFile file;
+    unsigned long long fileSize;
+    void* loader;                   /* ILoader from SCI_CREATELOADER */
+    int encoding;
     BOOL hasBOM;
-    int encoding = DetectFileEncodingFromData(buffer, bytesRead, &hasBOM);
-    
-    /* Explicit check for UTF-16 LE BOM - ensure proper detection */
-    if (bytesRead >= 2 && (unsigned char)buffer[0] == 0xFF && (unsigned char)buffer[1] == 0xFE) {
-        encoding = ENCODING_UTF16_LE;
-        hasBOM = TRUE;
-    }
-    /* Explicit check for UTF-16 BE BOM */
-    else if (bytesRead >= 2 && (unsigned char)buffer[0] == 0xFE && (unsigned char)buffer[1] == 0xFF) {
-        encoding = ENCODING_UTF16_BE;
-        hasBOM = TRUE;
-    }
-    /* Explicit check for UTF-8 BOM */
-    else if (bytesRead >= 3 && (unsigned char)buffer[0] == 0xEF && 
-             (unsigned char)buffer[1] == 0xBB && (unsigned char)buffer[2] == 0xBF) {
-        encoding = ENCODING_UTF8_BOM;
-        hasBOM = TRUE;
-    }
-    
-    /* Debug log to file */
-    FILE* log = fopen("d:\\DEV\\notepad+\\debug_load.txt", "a");
-    if (log) {
-        fprintf(log, "File: %s\n", filePath);
-        fprintf(log, "Encoding: %d (UTF8=0, UTF16LE=2)\n", encoding);
-        fprintf(log, "HasBOM: %d\n", hasBOM);
-        fprintf(log, "Bytes: %zu\n", bytesRead);
-        fprintf(log, "First 4 bytes: %02X %02X %02X %02X\n\n", 
-                (unsigned char)buffer[0], (unsigned char)buffer[1],
-                (unsigned char)buffer[2], (unsigned char)buffer[3]);
-        fclose(log);
-    }
-    
-    char* utf8Data = buffer;
-    size_t utf8Size = bytesRead;
-    
-    if (encoding != ENCODING_UTF8) {
-        utf8Data = ConvertToUTF8(buffer, bytesRead, encoding, &utf8Size);
-        if (!utf8Data) {
-            free(buffer);
-            MessageBox(NULL, "Failed to convert file encoding", "Error", MB_ICONERROR | MB_OK);
+    int lineEnding;                 /* Counted over the whole file by StreamFileLoad */
+    BOOL checkUTF8;                 /* Encoding detected as UTF-8 from the sample - check the rest */
+    unsigned long long offset;      /* Next file offset to stream */
+    volatile LONG cancelled;
+    volatile LONG percent;
+    BOOL succeeded;
+};
+
+/* Open and map the file, detect its encoding and create the loader */
+static BOOL PrepareFileLoad(FileLoadJob* job, HWND editor, const char* filePath, int encoding)
+{
+    memset(job, 0, sizeof(FileLoadJob));
+    strncpy(job->filePath, filePath, MAX_PATH - 1);
+    job->editor = editor;
+    job->lineEnding = LINEEND_CRLF;
+    
+    if (!OpenMappedFile(&job->file, filePath)) {
+        return FALSE;
+    }
+    
+    job->fileSize = job->file.size;
+    FL_PROFILE_START(editor, job->fileSize);
+    
+    /* Detect the encoding from a bounded sample at the start of the file.
+     * A detected UTF-8 file is checked as it streams in - see StreamFileLoad. */
+    if (job->file.size > 0) {
+        size_t sampleSize = (job->file.size < FILELOAD_DETECT_SAMPLE) ? (size_t)job->file.size : FILELOAD_DETECT_SAMPLE;
+        const char* sample = MapFileRange(&job->file, 0, sampleSize);
+        if (!sample) {
+            CloseMappedFile(&job->file);
             return FALSE;
         }
-        free(buffer);
-        buffer = utf8Data;
+        
+        if (encoding == FILELOAD_DETECT_ENCODING) {
+            encoding = DetectEncodingFromSample(sample, sampleSize, sampleSize == job->file.size, &job->hasBOM);
+            job->checkUTF8 = (encoding == ENCODING_UTF8);
+        }
+    } else if (encoding == FILELOAD_DETECT_ENCODING) {
+        encoding = ENCODING_UTF8;
     }
+    job->encoding = encoding;
     
-    /* Set text in editor */
-    SendMessage(tab->editorHandle, SCI_SETTEXT, 0, (LPARAM)utf8Data);
-    SendMessage(tab->editorHandle, SCI_SETSAVEPOINT, 0, 0);
-    SendMessage(tab->editorHandle, SCI_EMPTYUNDOBUFFER, 0, 0);
+    if (job->hasBOM) {
+        job->offset = (encoding == ENCODING_UTF8_BOM) ? 3 : 2;
+    }
     
-    free(buffer);
+    /* Worst case UTF-8 size decides whether the document needs 64-bit line positions */
+    unsigned long long maxLength = job->file.size;
+    if (encoding == ENCODING_UTF16_LE || encoding == ENCODING_UTF16_BE) {
+        maxLength = job->file.size / 2 * 3;
+    } else if (encoding == ENCODING_ANSI) {
+        maxLength = job->file.size * 3;
+    }
+    if (sizeof(void*) < 8 && maxLength > 0x7FFFFFFF) {
+        CloseMappedFile(&job->file);
+        return FALSE;
+    }
+    /* A detected UTF-8 file may still turn out to be ANSI */
+    if (job->checkUTF8) {
+        maxLength = job->file.size * 3;
+    }
+    int options = (maxLength > 0x7FFFFFFF) ? SC_DOCUMENTOPTION_TEXT_LARGE : SC_DOCUMENTOPTION_DEFAULT;
+    if (job->file.size >= FILELOAD_PIECES_SIZE) {
+        options |= SC_DOCUMENTOPTION_TEXT_PIECES | SC_DOCUMENTOPTION_INDEX_TREE;
+    }
+    
+    job->loader = (void*)SendMessage(editor, SCI_CREATELOADER, (WPARAM)(job->file.size - job->offset), options);
+    if (!job->loader) {
+        CloseMappedFile(&job->file);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* Add a block to the loader with the line starts the scanner found in it */
+static int AddScannedData(void* loader, void* scanner, const char* data, size_t length)
+{
+    Sci_Position lineCount = 0;
+    const Sci_Position* lineStarts = TextScannerLineStarts(scanner, &lineCount);
+    if (length == 0) {
+        return LOADER_STATUS_OK;
+    }
+    return LoaderAddDataLines(loader, data, (Sci_Position)length, lineStarts, lineCount);
+}
+
+/* Stream the file into the loader FILELOAD_CHUNK_SIZE bytes at a time.
+ * Each block is scanned once by a TextScanner, which finds the line starts the document
+ * needs, counts the line endings and checks a file detected as UTF-8 from its first
+ * FILELOAD_DETECT_SAMPLE bytes. If invalid UTF-8 turns up after nothing but ASCII, the
+ * file is ANSI and the rest is converted as ANSI - the same result as checking the whole
+ * file up front. Once real UTF-8 has been seen, invalid bytes are kept as they are.
+ * Only touches the job and the loader, so it may run on a worker thread. */
+static BOOL StreamFileLoad(FileLoadJob* job)
+{
+    ChunkBuffers buffers;
+    MappedFile* mf = &job->file;
+    int status = LOADER_STATUS_OK;
+    void* scanner = TextScannerCreate(job->checkUTF8);
+    
+    memset(&buffers, 0, sizeof(buffers));
+    if (!scanner) {
+        status = LOADER_STATUS_BADALLOC;
+    } else if (job->encoding != ENCODING_UTF8 && job->encoding != ENCODING_UTF8_BOM) {
+        if (!AllocChunkBuffers(&buffers, job->encoding)) {
+            status = LOADER_STATUS_BADALLOC;
+        }
+    }
+    
+    while (job->offset < mf->size && status == LOADER_STATUS_OK) {
+        if (job->cancelled) {
+            status = LOADER_STATUS_FAILURE;
+            break;
+        }
+        
+        unsigned long long remaining = mf->size - job->offset;
+        size_t length = (remaining < FILELOAD_CHUNK_SIZE) ? (size_t)remaining : FILELOAD_CHUNK_SIZE;
+        BOOL atEnd = (length == remaining);
+        const char* data = MapFileRange(mf, job->offset, length);
+        if (!data) {
+            status = LOADER_STATUS_FAILURE;
+            break;
+        }
+        
+        if (job->encoding == ENCODING_UTF8 || job->encoding == ENCODING_UTF8_BOM) {
+            /* Zero copy: straight from the mapped view into the document */
+            size_t scanned = TextScannerScan(scanner, data, length, atEnd);
+            if (scanned == (size_t)-1) {
+                status = LOADER_STATUS_BADALLOC;
+                break;
+            }
+            status = AddScannedData(job->loader, scanner, data, scanned);
+            job->offset += scanned;
+            if (scanned < length && TextScannerAllASCII(scanner)) {
+                /* Invalid UTF-8 - everything loaded so far reads the same in ANSI so convert from here on.
+                 * Otherwise checking has stopped and the next pass adds the rest unchanged. */
+                job->encoding = ENCODING_ANSI;
+                if (!AllocChunkBuffers(&buffers, ENCODING_ANSI)) {
+                    status = LOADER_STATUS_BADALLOC;
+                    break;
+                }
+            }
+        } else {
+            size_t consumed = 0;
+            int utf8Length = ConvertChunkToUTF8(data, length, job->encoding, atEnd, &buffers, &consumed);
+            if (utf8Length < 0 || (consumed == 0 && length > 0)) {
+                status = LOADER_STATUS_FAILURE;
+                break;
+            }
+            if (utf8Length > 0) {
+                if (TextScannerScan(scanner, buffers.utf8, utf8Length, atEnd) == (size_t)-1) {
+                    status = LOADER_STATUS_BADALLOC;
+                    break;
+                }
+                status = AddScannedData(job->loader, scanner, buffers.utf8, utf8Length);
+            }
+            job->offset += consumed;
+        }
+        
+        /* Report progress in whole percent steps */
+        LONG percent = (LONG)(job->offset * 100 / mf->size);
+        if (percent != job->percent) {
+            job->percent = percent;
+            if (job->notifyWindow) {
+                PostMessage(job->notifyWindow, WM_FILELOAD_PROGRESS, (WPARAM)percent, (LPARAM)job);
+            }
+        }
+    }
+    
+    if (status == LOADER_STATUS_OK) {
+        Sci_Position cr, lf, crlf;
+        TextScannerLineEndCounts(scanner, &cr, &lf, &crlf);
+        job->lineEnding = LineEndingFromCounts(crlf, lf, cr);
+    }
+    
+    TextScannerRelease(scanner);
+    FreeChunkBuffers(&buffers);
+    CloseMappedFile(mf);
+    
+    return status == LOADER_STATUS_OK;
+}
+
+/* Replace the editor's document with the loaded one */
+static void AttachLoadedDocument(FileLoadJob* job)
+{
+    HWND editor = job->editor;
+    
+    FL_PROFILE_MARK("document loaded");
+    
+    /* Indentation settings and the undo memory limit belong to the document, carry them over
+     * from the one being replaced */
+    int tabWidth = (int)SendMessage(editor, SCI_GETTABWIDTH, 0, 0);
+    int useTabs = (int)SendMessage(editor, SCI_GETUSETABS, 0, 0);
+    int indent = (int)SendMessage(editor, SCI_GETINDENT, 0, 0);
+    int tabIndents = (int)SendMessage(editor, SCI_GETTABINDENTS, 0, 0);
+    int backspaceUnindents = (int)SendMessage(editor, SCI_GETBACKSPACEUNINDENTS, 0, 0);
+    LRESULT undoMemoryLimit = SendMessage(editor, SCI_GETUNDOMEMORYLIMIT, 0, 0);
+    
+    void* document = LoaderConvertToDocument(job->loader);
+    job->loader = NULL;
+    SendMessage(editor, SCI_SETDOCPOINTER, 0, (LPARAM)document);
+    SendMessage(editor, SCI_RELEASEDOCUMENT, 0, (LPARAM)document);
+    
+    SendMessage(editor, SCI_SETCODEPAGE, SC_CP_UTF8, 0);
+    SendMessage(editor, SCI_SETTABWIDTH, tabWidth, 0);
+    SendMessage(editor, SCI_SETUSETABS, useTabs, 0);
+    SendMessage(editor, SCI_SETINDENT, indent, 0);
+    SendMessage(editor, SCI_SETTABINDENTS, tabIndents, 0);
+    SendMessage(editor, SCI_SETBACKSPACEUNINDENTS, backspaceUnindents, 0);
+    SendMessage(editor, SCI_SETUNDOMEMORYLIMIT, (WPARAM)undoMemoryLimit, 0);
+    SendMessage(editor, SCI_SETEOLMODE,
+                job->lineEnding == LINEEND_LF ? SC_EOL_LF : (job->lineEnding == LINEEND_CR ? SC_EOL_CR : SC_EOL_CRLF), 0);
+    
+    /* The loader document was built without undo collection */
+    SendMessage(editor, SCI_SETUNDOCOLLECTION, 1, 0);
+    SendMessage(editor, SCI_EMPTYUNDOBUFFER, 0, 0);
+}
+
+static void FillFileInfo(FileLoadJob* job, FileInfo* info)
+{
+    strncpy(info->filePath, job->filePath, MAX_PATH - 1);
+    info->filePath[MAX_PATH - 1] = '\0';
+    info->encoding = job->encoding;
+    info->lineEnding = job->lineEnding;
+    info->hasBOM = job->hasBOM;
+    DWORD attributes = GetFileAttributes(job->filePath);
+    info->isReadOnly = (attributes != INVALID_FILE_ATTRIBUTES) && (attributes & FILE_ATTRIBUTE_READONLY);
+    info->fileSize = job->fileSize;
+}
+
+/* Load a file into an editor without reading it into a heap buffer first.
+ * The file is memory mapped and streamed into a new document created with SCI_CREATELOADER,
+ * FILELOAD_CHUNK_SIZE bytes at a time. UTF-8 files are handed to Scintilla straight from the
+ * mapped view; other encodings are converted one chunk at a time into a reused buffer.
+ * Pass FILELOAD_DETECT_ENCODING to detect the encoding from the file content.
+ * The editor's document is only replaced if the whole file was loaded. */
+BOOL LoadFileIntoEditor(HWND editor, const char* filePath, int encoding, FileInfo* info)
+{
+    FileLoadJob job;
+    
+    if (!editor || !filePath || !PrepareFileLoad(&job, editor, filePath, encoding)) {
+        return FALSE;
+    }
+    
+    if (!StreamFileLoad(&job)) {
+        LoaderRelease(job.loader);
+        return FALSE;
+    }
+    
+    AttachLoadedDocument(&job);
+    
+    if (info) {
+        FillFileInfo(&job, info);
+    }
+    return TRUE;
+}
+
+/* Worker thread for StartFileLoad */
+static DWORD WINAPI FileLoadThreadProc(LPVOID param)
+{
+    FileLoadJob* job = (FileLoadJob*)param;
+    
+    job->succeeded = StreamFileLoad(job);
+    PostMessage(job->notifyWindow, WM_FILELOAD_DONE, 0, (LPARAM)job);
+    return 0;
+}
+
+/* Start loading a file on a worker thread. The editor keeps its current document until
+ * the worker posts WM_FILELOAD_DONE to notifyWindow; FinishFileLoad must then be called on
+ * the UI thread. WM_FILELOAD_PROGRESS is posted as each percent of the file is read. */
+FileLoadJob* StartFileLoad(HWND editor, const char* filePath, int encoding, HWND notifyWindow)
+{
+    if (!editor || !filePath || !notifyWindow) {
+        return NULL;
+    }
+    
+    FileLoadJob* job = (FileLoadJob*)malloc(sizeof(FileLoadJob));
+    if (!job) {
+        return NULL;
+    }
+    
+    if (!PrepareFileLoad(job, editor, filePath, encoding)) {
+        free(job);
+        return NULL;
+    }
+    job->notifyWindow = notifyWindow;
+    
+    job->thread = CreateThread(NULL, 0, FileLoadThreadProc, job, 0, NULL);
+    if (!job->thread) {
+        LoaderRelease(job->loader);
+        CloseMappedFile(&job->file);
+        free(job);
+        return NULL;
+    }
+    return job;
+}
+
+/* Ask a background load to stop - WM_FILELOAD_DONE is still posted */
+void CancelFileLoad(FileLoadJob* job)
+{
+    if (job) {
+        InterlockedExchange(&job->cancelled, 1);
+    }
+}
+
+/* Whether CancelFileLoad was called for the job */
+BOOL IsFileLoadCancelled(FileLoadJob* job)
+{
+    return job ? job->cancelled != 0 : FALSE;
+}
+
+/* Percentage of the file read so far */
+int GetFileLoadProgress(FileLoadJob* job)
+{
+    return job ? (int)job->percent : 0;
+}
+
+/* Complete a background load after WM_FILELOAD_DONE. Attaches the document to the editor
+ * unless the load failed or was cancelled, fills info and frees the job. */
+BOOL FinishFileLoad(FileLoadJob* job, FileInfo* info)
+{
+    if (!job) {
+        return FALSE;
+    }
+    
+    WaitForSingleObject(job->thread, INFINITE);
+    CloseHandle(job->thread);
+    
+    BOOL attached = FALSE;
+    if (job->succeeded && !job->cancelled && IsWindow(job->editor)) {
+        AttachLoadedDocument(job);
+        if (info) {
+            FillFileInfo(job, info);
+        }
+        attached = TRUE;
+    } else if (job->loader) {
+        LoaderRelease(job->loader);
+    }
+    
+    free(job);
+    return attached;
+}
+
+/* Called when an editor has painted - records time to first paint after a profiled load */
+void ReportFileLoadPainted(HWND editor)
+{
+#if PROFILE_FILE_LOAD
+    if (g_loadEditor && editor == g_loadEditor) {
+        FL_PROFILE_MARK("first paint");
+        g_loadEditor = NULL;
+    }
+#else
+    (void)editor;
+#endif
+}
+
+/* Load file to tab */
+BOOL LoadFileToTab(int tabIndex, const char* filePath)
+{
+    TabInfo* tab = GetTab(tabIndex);
+    FileInfo info;
+    
+    if (!tab || !tab->editorHandle || !filePath) {
+        return FALSE;
+    }
+    
+    if (!LoadFileIntoEditor(tab->editorHandle, filePath, FILELOAD_DETECT_ENCODING, &info)) {
+        MessageBox(NULL, "Failed to open file", "Error", MB_ICONERROR | MB_OK);
+        return FALSE;
+    }
+    SendMessage(tab->editorHandle, SCI_SETSAVEPOINT, 0, 0);
     
     /* Update tab info */
     strcpy(tab->filePath, filePath);
@@ -540,13 +1223,14 @@ BOOL LoadFileToTab(int tabIndex, const char* filePath)
         strcpy(tab->displayName, filePath);
     }
     tab->isModified = FALSE;
+    tab->encoding = (FileEncoding)info.encoding;
+    tab->lineEnding = (LineEnding)info.lineEnding;
     
     /* Apply syntax highlighting */
     ApplySyntaxHighlightingForFile(tab->editorHandle, filePath);
     
     /* Update file type in status bar */
-    const char* extension = strrchr(filePath, '.');
-    UpdateFileType(GetFileTypeFromExtension(extension));
+    UpdateFileType(GetFileTypeForEditor(tab->editorHandle, filePath));
     
     /* Add to recent files */
     AddRecentFile(filePath);
@@ -18,12 +18,65 @@ typedef struct {
     int lineEnding;    /* LineEnding from tabs.h */
     BOOL hasBOM;
     BOOL isReadOnly;
+    unsigned long long fileSize;  /* Size on disk in bytes */
 } FileInfo;
 
+/* Mapped file loading - the file is mapped FILELOAD_VIEW_SIZE bytes at a time and
+ * handed to a Scintilla loader FILELOAD_CHUNK_SIZE bytes at a time */
+#define FILELOAD_VIEW_SIZE      (64 * 1024 * 1024)
+#define FILELOAD_CHUNK_SIZE     (1024 * 1024)
+#define FILELOAD_DETECT_ENCODING (-1)
+
+/* Encoding detection only looks at this much of the start of a file - the rest of a
+ * UTF-8 file is checked as it streams in */
+#define FILELOAD_DETECT_SAMPLE  (64 * 1024)
+
+/* Files at least this large are loaded on a worker thread */
+#define FILELOAD_BACKGROUND_SIZE (16 * 1024 * 1024)
+
+/* Files at least this large keep their text in a piece table and their line starts in a tree
+ * so edits far apart stay fast. Styles stay a byte per character: SC_DOCUMENTOPTION_STYLES_RUNS
+ * would save memory but styling and drawing read them slower */
+#define FILELOAD_PIECES_SIZE    (64 * 1024 * 1024)
+
+/* Background load notifications - lParam is the FileLoadJob, wParam the percentage read */
+#define WM_FILELOAD_PROGRESS    (WM_APP + 1)
+#define WM_FILELOAD_DONE        (WM_APP + 2)
+
+/* Saving converts and writes FILESAVE_CHUNK_SIZE bytes of the document at a time */
+#define FILESAVE_CHUNK_SIZE     (1024 * 1024)
+
+typedef struct FileLoadJob FileLoadJob;
+
+/* Memory mapped file - only one view of at most viewLimit bytes is mapped at a time
+ * so files larger than the address space can still be streamed */
+typedef struct {
+    HANDLE file;
+    HANDLE mapping;
+    unsigned long long size;
+    const char* view;               /* Currently mapped view (NULL if none) */
+    unsigned long long viewOffset;  /* File offset of view[0] */
+    size_t viewSize;
+    size_t viewLimit;               /* FILELOAD_VIEW_SIZE unless lowered after opening */
+} MappedFile;
+
+BOOL OpenMappedFile(MappedFile* mf, const char* filePath);
+const char* MapFileRange(MappedFile* mf, unsigned long long offset, size_t length);
+void CloseMappedFile(MappedFile* mf);
+
 /* File operations */
 BOOL SaveTabToFile(int tabIndex);
 BOOL SaveTabToFileAs(int tabIndex);
+BOOL WriteEditorToFile(HWND editor, const char* filePath, int encoding);
+BOOL WriteBufferToFile(const char* filePath, const char* data, size_t length);
 BOOL LoadFileToTab(int tabIndex, const char* filePath);
+BOOL LoadFileIntoEditor(HWND editor, const char* filePath, int encoding, FileInfo* info);
+FileLoadJob* StartFileLoad(HWND editor, const char* filePath, int encoding, HWND notifyWindow);
+void CancelFileLoad(FileLoadJob* job);
+BOOL IsFileLoadCancelled(FileLoadJob* job);
+int GetFileLoadProgress(FileLoadJob* job);
+BOOL FinishFileLoad(FileLoadJob* job, FileInfo* info);
+void ReportFileLoadPainted(HWND editor);
 
 /* Encoding detection and conversion (internal use - different signatures) */
 int DetectFileEncodingFromData(const char* data, size_t size, BOOL* hasBOM);
@@ -0,0 +1,681 @@
+/*
+ * Find in Files implementation for Notepad+
+ * Walks a folder tree on one thread while a pool of workers maps each file found and
+ * searches it with the same matchers as documents are searched with (see ByteSearch in
+ * scintilla_bridge.h). Results are gathered per worker and handed to the UI in blocks.
+ */
+
+#include <windows.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "findinfiles.h"
+#include "scintilla_bridge.h"
+
+/* A file waiting to be searched */
+typedef struct QueuedFile {
+    struct QueuedFile* next;
+    char path[MAX_PATH];
+} QueuedFile;
+
+/* Text collected by one worker before it is handed over */
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} ResultBuffer;
+
+typedef struct {
+    FindInFilesJob* job;
+    void* search;                   /* ByteSearch - each worker has its own */
+    HANDLE thread;
+    ResultBuffer output;
+} FindWorker;
+
+struct FindInFilesJob {
+    FindInFilesOptions options;
+    HWND notifyWindow;
+    LONG id;
+    HANDLE thread;                  /* Walks the folders then waits for the workers */
+    FindWorker workers[FINDINFILES_MAX_THREADS];
+    int workerCount;
+    DWORD granularity;              /* View offsets are multiples of this */
+
+    CRITICAL_SECTION lock;          /* Guards the queue and the results */
+    QueuedFile* queueHead;
+    QueuedFile* queueTail;
+    HANDLE queued;                  /* Counts queued files, then one end marker per worker */
+    HANDLE slots;                   /* Counts free places in the queue */
+    ResultBuffer results;           /* Results not taken yet */
+
+    volatile LONG cancelled;
+    volatile LONG finished;
+    volatile LONG64 filesSearched;
+    volatile LONG64 filesMatched;
+    volatile LONG64 matches;
+    volatile LONG64 bytesSearched;
+    LARGE_INTEGER startTime;
+    LARGE_INTEGER endTime;
+};
+
+static volatile LONG g_lastJobId = 0;
+
+/* Match one pattern of length patternLength against a whole name, ignoring case */
+static BOOL MatchWildcard(const char* name, const char* pattern, size_t patternLength)
+{
+    const char* patternEnd = pattern + patternLength;
+    const char* star = NULL;        /* Pattern just after the last '*' seen */
+    const char* starName = NULL;    /* Name position that '*' is matched up to */
+
+    while (*name) {
+        if (pattern < patternEnd && *pattern == '*') {
+            star = ++pattern;
+            starName = name;
+        } else if (pattern < patternEnd &&
+                   (*pattern == '?' || tolower((unsigned char)*pattern) == tolower((unsigned char)*name))) {
+            pattern++;
+            name++;
+        } else if (star) {
+            /* Let the last '*' take one more character and try again */
+            pattern = star;
+            name = ++starName;
+        } else {
+            return FALSE;
+        }
+    }
+    while (pattern < patternEnd && *pattern == '*') {
+        pattern++;
+    }
+    return pattern == patternEnd;
+}
+
+BOOL FindInFilesMatchPattern(const char* name, const char* patterns)
+{
+    const char* p = patterns;
+    while (*p) {
+        const char* end = strchr(p, ';');
+        size_t length = end ? (size_t)(end - p) : strlen(p);
+        while (length > 0 && *p == ' ') {
+            p++;
+            length--;
+        }
+        while (length > 0 && p[length - 1] == ' ') {
+            length--;
+        }
+        /* "*.*" means every file, as in the file dialogs, with or without a dot */
+        if (length > 0 && ((length == 3 && strncmp(p, "*.*", 3) == 0) || MatchWildcard(name, p, length))) {
+            return TRUE;
+        }
+        if (!end) {
+            break;
+        }
+        p = end + 1;
+    }
+    return FALSE;
+}
+
+static BOOL AppendResult(ResultBuffer* buffer, const char* text, size_t length)
+{
+    if (buffer->length + length + 1 > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity * 2 : FINDINFILES_FLUSH_SIZE * 2;
+        while (capacity < buffer->length + length + 1) {
+            capacity *= 2;
+        }
+        char* data = (char*)realloc(buffer->data, capacity);
+        if (!data) {
+            return FALSE;
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->data + buffer->length, text, length);
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+    return TRUE;
+}
+
+/* Hand a worker's results over, telling the UI when there weren't any waiting already */
+static void FlushResults(FindWorker* worker)
+{
+    FindInFilesJob* job = worker->job;
+    BOOL wasEmpty;
+
+    if (worker->output.length == 0) {
+        return;
+    }
+    EnterCriticalSection(&job->lock);
+    wasEmpty = (job->results.length == 0);
+    AppendResult(&job->results, worker->output.data, worker->output.length);
+    LeaveCriticalSection(&job->lock);
+    worker->output.length = 0;
+
+    if (wasEmpty && job->notifyWindow) {
+        PostMessage(job->notifyWindow, WM_FINDINFILES_RESULTS, (WPARAM)job->id, (LPARAM)job);
+    }
+}
+
+/* Where a file is up to while its views are searched */
+typedef struct {
+    const char* path;
+    LONG64 lineNumber;              /* Line number at the start of the current view */
+    LONG64 matches;
+    BOOL headerWritten;             /* The path heads the worker's unflushed results */
+} FileProgress;
+
+/* Add a matching line to the worker's results */
+static void WriteMatch(FindWorker* worker, FileProgress* file, LONG64 lineNumber, const char* line, size_t length)
+{
+    char prefix[32];
+    ResultBuffer* output = &worker->output;
+
+    if (!file->headerWritten) {
+        AppendResult(output, file->path, strlen(file->path));
+        AppendResult(output, "\r\n", 2);
+        file->headerWritten = TRUE;
+    }
+    if (length > FINDINFILES_MAX_LINE) {
+        /* Don't cut a UTF-8 character in two */
+        length = FINDINFILES_MAX_LINE;
+        while (length > 0 && ((unsigned char)line[length] & 0xC0) == 0x80) {
+            length--;
+        }
+    }
+    int prefixLength = snprintf(prefix, sizeof(prefix), "\t%lld: ", (long long)lineNumber);
+    AppendResult(output, prefix, (size_t)prefixLength);
+    AppendResult(output, line, length);
+    AppendResult(output, "\r\n", 2);
+
+    if (output->length >= FINDINFILES_FLUSH_SIZE) {
+        FlushResults(worker);
+        file->headerWritten = FALSE;
+    }
+}
+
+/* Search a view that starts at a line start. Each matching line is listed once, and
+ * lines are only counted up to each match - the rest of the view only when asked. */
+static void SearchView(FindWorker* worker, FileProgress* file, const char* data, size_t length, BOOL countRest)
+{
+    size_t pos = 0;
+    size_t counted = 0;             /* Lines before this are counted in lineNumber */
+    size_t lineStart = 0;
+    size_t matchStart, matchEnd;
+
+    while (pos <= length && !worker->job->cancelled &&
+           ByteSearchFind(worker->search, data, length, pos, &matchStart, &matchEnd)) {
+        const char* newline;
+        while ((newline = (const char*)memchr(data + counted, '\n', matchStart - counted)) != NULL) {
+            file->lineNumber++;
+            counted = lineStart = (size_t)(newline - data) + 1;
+        }
+        counted = matchStart;
+
+        newline = (const char*)memchr(data + matchStart, '\n', length - matchStart);
+        size_t lineEnd = newline ? (size_t)(newline - data) : length;
+        size_t textEnd = (lineEnd > lineStart && data[lineEnd - 1] == '\r') ? lineEnd - 1 : lineEnd;
+        WriteMatch(worker, file, file->lineNumber, data + lineStart, textEnd - lineStart);
+        file->matches++;
+
+        if (!newline) {
+            return;
+        }
+        file->lineNumber++;
+        counted = lineStart = pos = lineEnd + 1;
+    }
+
+    if (countRest) {
+        const char* newline;
+        while ((newline = (const char*)memchr(data + counted, '\n', length - counted)) != NULL) {
+            file->lineNumber++;
+            counted = (size_t)(newline - data) + 1;
+        }
+    }
+}
+
+/* Search a UTF-16 file as UTF-8, converting it a chunk at a time from after its byte order
+ * mark. The text after the last line end of each chunk is carried over to the next, unless
+ * that would be longer than a chunk, when the line is split like one longer than a view. */
+static void SearchUTF16File(FindWorker* worker, FileProgress* file, HANDLE mapping,
+                            unsigned long long fileSize, BOOL bigEndian)
+{
+    FindInFilesJob* job = worker->job;
+    size_t capacity = FINDINFILES_UTF16_CHUNK + UTF16StreamMaxOutput(FINDINFILES_UTF16_CHUNK);
+    char* buffer = (char*)malloc(capacity);
+    void* stream = buffer ? UTF16StreamCreate(bigEndian) : NULL;
+    if (!stream) {
+        free(buffer);
+        return;
+    }
+
+    unsigned long long offset = 2;
+    size_t carried = 0;
+    while (offset < fileSize && !job->cancelled) {
+        unsigned long long base = offset - (offset % job->granularity);
+        unsigned long long remaining = fileSize - base;
+        size_t viewSize = (remaining < FINDINFILES_UTF16_CHUNK) ? (size_t)remaining : FINDINFILES_UTF16_CHUNK;
+        const char* view = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(base >> 32),
+                                                      (DWORD)(base & 0xFFFFFFFF), viewSize);
+        if (!view) {
+            break;
+        }
+        size_t length = viewSize - (size_t)(offset - base);
+        BOOL atEnd = (offset + length == fileSize);
+        size_t converted = UTF16StreamConvert(stream, view + (offset - base), length,
+                                              buffer + carried, capacity - carried, atEnd);
+        UnmapViewOfFile(view);
+        if (converted == (size_t)-1) {
+            break;
+        }
+        offset += length;
+        InterlockedExchangeAdd64(&job->bytesSearched, (LONG64)length);
+
+        size_t total = carried + converted;
+        size_t searchLength = total;
+        if (!atEnd) {
+            size_t lineEnd = total;
+            while (lineEnd > 0 && buffer[lineEnd - 1] != '\n') {
+                lineEnd--;
+            }
+            if (lineEnd > 0) {
+                searchLength = lineEnd;
+            } else if (total <= FINDINFILES_UTF16_CHUNK) {
+                searchLength = 0;
+            }
+        }
+        if (searchLength > 0) {
+            SearchView(worker, file, buffer, searchLength, !atEnd);
+        }
+        carried = total - searchLength;
+        memmove(buffer, buffer + searchLength, carried);
+    }
+
+    UTF16StreamRelease(stream);
+    free(buffer);
+}
+
+/* Search one file a view at a time. Files that look binary are skipped. */
+static void SearchFile(FindWorker* worker, const char* path)
+{
+    FindInFilesJob* job = worker->job;
+    LARGE_INTEGER size;
+    FileProgress file;
+
+    HANDLE handle = CreateFile(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+        CloseHandle(handle);
+        return;
+    }
+    HANDLE mapping = CreateFileMapping(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(handle);
+        return;
+    }
+
+    memset(&file, 0, sizeof(file));
+    file.path = path;
+    file.lineNumber = 1;
+
+    unsigned long long fileSize = (unsigned long long)size.QuadPart;
+    unsigned long long offset = 0;
+    BOOL searched = FALSE;
+    while (offset < fileSize && !job->cancelled) {
+        unsigned long long base = offset - (offset % job->granularity);
+        unsigned long long remaining = fileSize - base;
+        size_t viewSize = (remaining < FINDINFILES_VIEW_SIZE) ? (size_t)remaining : FINDINFILES_VIEW_SIZE;
+        const char* view = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(base >> 32),
+                                                      (DWORD)(base & 0xFFFFFFFF), viewSize);
+        if (!view) {
+            break;
+        }
+        const char* data = view + (offset - base);
+        size_t length = viewSize - (size_t)(offset - base);
+        BOOL atEnd = (offset + length == fileSize);
+
+        if (offset == 0) {
+            /* UTF-16 text is full of NULs so is looked for before the binary check */
+            const unsigned char* bom = (const unsigned char*)data;
+            if (length >= 2 && ((bom[0] == 0xFF && bom[1] == 0xFE) || (bom[0] == 0xFE && bom[1] == 0xFF))) {
+                BOOL bigEndian = (bom[0] == 0xFE);
+                UnmapViewOfFile(view);
+                SearchUTF16File(worker, &file, mapping, fileSize, bigEndian);
+                searched = TRUE;
+                break;
+            }
+            size_t sample = (length < FINDINFILES_BINARY_SAMPLE) ? length : FINDINFILES_BINARY_SAMPLE;
+            if (memchr(data, '\0', sample)) {
+                UnmapViewOfFile(view);
+                break;
+            }
+            searched = TRUE;
+        }
+
+        /* Stop the view at its last line end so no line is split between views. A line
+         * longer than a whole view is split - matches across the split are missed. */
+        if (!atEnd) {
+            size_t lineEnd = length;
+            while (lineEnd > 0 && data[lineEnd - 1] != '\n') {
+                lineEnd--;
+            }
+            if (lineEnd > 0) {
+                length = lineEnd;
+            }
+        }
+
+        SearchView(worker, &file, data, length, !atEnd);
+        UnmapViewOfFile(view);
+        offset += length;
+        InterlockedExchangeAdd64(&job->bytesSearched, (LONG64)length);
+    }
+
+    CloseHandle(mapping);
+    CloseHandle(handle);
+
+    if (searched) {
+        InterlockedIncrement64(&job->filesSearched);
+    }
+    if (file.matches > 0) {
+        InterlockedIncrement64(&job->filesMatched);
+        InterlockedExchangeAdd64(&job->matches, file.matches);
+        FlushResults(worker);
+    }
+}
+
+/* Search queued files until the end marker */
+static DWORD WINAPI FindWorkerThreadProc(LPVOID param)
+{
+    FindWorker* worker = (FindWorker*)param;
+    FindInFilesJob* job = worker->job;
+
+    for (;;) {
+        WaitForSingleObject(job->queued, INFINITE);
+        EnterCriticalSection(&job->lock);
+        QueuedFile* item = job->queueHead;
+        if (item) {
+            job->queueHead = item->next;
+            if (!job->queueHead) {
+                job->queueTail = NULL;
+            }
+        }
+        LeaveCriticalSection(&job->lock);
+
+        /* An empty queue after a wake up means the walk has ended */
+        if (!item) {
+            break;
+        }
+        ReleaseSemaphore(job->slots, 1, NULL);
+        if (!job->cancelled) {
+            SearchFile(worker, item->path);
+        }
+        free(item);
+    }
+    return 0;
+}
+
+static void QueueFile(FindInFilesJob* job, const char* path)
+{
+    QueuedFile* item = (QueuedFile*)malloc(sizeof(QueuedFile));
+    if (!item) {
+        return;
+    }
+    strcpy(item->path, path);
+    item->next = NULL;
+
+    /* Workers free places as they take files, even once cancelled */
+    WaitForSingleObject(job->slots, INFINITE);
+    EnterCriticalSection(&job->lock);
+    if (job->queueTail) {
+        job->queueTail->next = item;
+    } else {
+        job->queueHead = item;
+    }
+    job->queueTail = item;
+    LeaveCriticalSection(&job->lock);
+    ReleaseSemaphore(job->queued, 1, NULL);
+}
+
+/* Queue every included file under the folder. Links are not followed since they can
+ * lead back up the tree, and excluded names are skipped along with everything in them. */
+static void WalkFolders(FindInFilesJob* job)
+{
+    size_t capacity = 64;
+    size_t count = 0;
+    char** stack = (char**)malloc(sizeof(char*) * capacity);
+    char path[MAX_PATH];
+    WIN32_FIND_DATA findData;
+
+    if (!stack) {
+        return;
+    }
+    stack[count] = _strdup(job->options.folder);
+    if (stack[count]) {
+        count++;
+    }
+
+    while (count > 0) {
+        char* folder = stack[--count];
+        if (job->cancelled || snprintf(path, sizeof(path), "%s\\*", folder) >= (int)sizeof(path)) {
+            free(folder);
+            continue;
+        }
+
+        HANDLE find = FindFirstFileEx(path, FindExInfoBasic, &findData, FindExSearchNameMatch, NULL,
+                                      FIND_FIRST_EX_LARGE_FETCH);
+        if (find != INVALID_HANDLE_VALUE) {
+            do {
+                const char* name = findData.cFileName;
+                if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0 ||
+                    (findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) ||
+                    (job->options.exclude[0] && FindInFilesMatchPattern(name, job->options.exclude))) {
+                    continue;
+                }
+                if (snprintf(path, sizeof(path), "%s\\%s", folder, name) >= (int)sizeof(path)) {
+                    continue;
+                }
+                if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+                    if (count == capacity) {
+                        char** grown = (char**)realloc(stack, sizeof(char*) * capacity * 2);
+                        if (!grown) {
+                            continue;
+                        }
+                        stack = grown;
+                        capacity *= 2;
+                    }
+                    stack[count] = _strdup(path);
+                    if (stack[count]) {
+                        count++;
+                    }
+                } else if (FindInFilesMatchPattern(name, job->options.include)) {
+                    QueueFile(job, path);
+                }
+            } while (!job->cancelled && FindNextFile(find, &findData));
+            FindClose(find);
+        }
+        free(folder);
+    }
+    free(stack);
+}
+
+/* Walk the folders, then wait for the workers to finish the queue */
+static DWORD WINAPI FindInFilesThreadProc(LPVOID param)
+{
+    FindInFilesJob* job = (FindInFilesJob*)param;
+    HANDLE threads[FINDINFILES_MAX_THREADS];
+
+    WalkFolders(job);
+    ReleaseSemaphore(job->queued, job->workerCount, NULL);
+
+    for (int i = 0; i < job->workerCount; i++) {
+        threads[i] = job->workers[i].thread;
+    }
+    WaitForMultipleObjects((DWORD)job->workerCount, threads, TRUE, INFINITE);
+
+    QueryPerformanceCounter(&job->endTime);
+    InterlockedExchange(&job->finished, 1);
+    if (job->notifyWindow) {
+        PostMessage(job->notifyWindow, WM_FINDINFILES_DONE, (WPARAM)job->id, (LPARAM)job);
+    }
+    return 0;
+}
+
+static void FreeJob(FindInFilesJob* job)
+{
+    for (int i = 0; i < job->workerCount; i++) {
+        if (job->workers[i].thread) CloseHandle(job->workers[i].thread);
+        ByteSearchRelease(job->workers[i].search);
+        free(job->workers[i].output.data);
+    }
+    while (job->queueHead) {
+        QueuedFile* next = job->queueHead->next;
+        free(job->queueHead);
+        job->queueHead = next;
+    }
+    if (job->thread) CloseHandle(job->thread);
+    if (job->queued) CloseHandle(job->queued);
+    if (job->slots) CloseHandle(job->slots);
+    DeleteCriticalSection(&job->lock);
+    free(job->results.data);
+    free(job);
+}
+
+FindInFilesJob* StartFindInFiles(const FindInFilesOptions* options, HWND notifyWindow)
+{
+    SYSTEM_INFO si;
+
+    if (!options || !options->pattern[0] || !options->folder[0]) {
+        return NULL;
+    }
+
+    FindInFilesJob* job = (FindInFilesJob*)calloc(1, sizeof(FindInFilesJob));
+    if (!job) {
+        return NULL;
+    }
+    job->options = *options;
+    job->notifyWindow = notifyWindow;
+    job->id = InterlockedIncrement(&g_lastJobId);
+    InitializeCriticalSection(&job->lock);
+
+    /* "C:\" and "C:\src\" are walked as "C:" and "C:\src" */
+    size_t folderLength = strlen(job->options.folder);
+    while (folderLength > 1 && (job->options.folder[folderLength - 1] == '\\' || job->options.folder[folderLength - 1] == '/')) {
+        job->options.folder[--folderLength] = '\0';
+    }
+    if (!job->options.include[0]) {
+        strcpy(job->options.include, FINDINFILES_DEFAULT_INCLUDE);
+    }
+
+    GetSystemInfo(&si);
+    job->granularity = si.dwAllocationGranularity;
+    int threads = options->threads > 0 ? options->threads : (int)si.dwNumberOfProcessors;
+    if (threads < 1) threads = 1;
+    if (threads > FINDINFILES_MAX_THREADS) threads = FINDINFILES_MAX_THREADS;
+
+    /* Every worker gets its own searcher - an invalid pattern fails the first */
+    for (int i = 0; i < threads; i++) {
+        void* search = ByteSearchCreate(job->options.pattern, strlen(job->options.pattern), job->options.searchFlags);
+        if (!search) {
+            break;
+        }
+        job->workers[i].job = job;
+        job->workers[i].search = search;
+        job->workerCount++;
+    }
+    job->queued = CreateSemaphore(NULL, 0, FINDINFILES_QUEUE_LIMIT + FINDINFILES_MAX_THREADS, NULL);
+    job->slots = CreateSemaphore(NULL, FINDINFILES_QUEUE_LIMIT, FINDINFILES_QUEUE_LIMIT, NULL);
+    if (job->workerCount == 0 || !job->queued || !job->slots) {
+        FreeJob(job);
+        return NULL;
+    }
+
+    QueryPerformanceCounter(&job->startTime);
+    for (int i = 0; i < job->workerCount; i++) {
+        job->workers[i].thread = CreateThread(NULL, 0, FindWorkerThreadProc, &job->workers[i], 0, NULL);
+        if (!job->workers[i].thread) {
+            /* Carry on with the workers that did start */
+            for (int j = i; j < job->workerCount; j++) {
+                ByteSearchRelease(job->workers[j].search);
+                job->workers[j].search = NULL;
+            }
+            job->workerCount = i;
+            break;
+        }
+    }
+    if (job->workerCount > 0) {
+        job->thread = CreateThread(NULL, 0, FindInFilesThreadProc, job, 0, NULL);
+    }
+    if (!job->thread) {
+        InterlockedExchange(&job->cancelled, 1);
+        ReleaseSemaphore(job->queued, job->workerCount, NULL);
+        for (int i = 0; i < job->workerCount; i++) {
+            WaitForSingleObject(job->workers[i].thread, INFINITE);
+        }
+        FreeJob(job);
+        return NULL;
+    }
+    return job;
+}
+
+void CancelFindInFiles(FindInFilesJob* job)
+{
+    if (job) {
+        InterlockedExchange(&job->cancelled, 1);
+    }
+}
+
+LONG FindInFilesId(const FindInFilesJob* job)
+{
+    return job ? job->id : 0;
+}
+
+char* FindInFilesTakeResults(FindInFilesJob* job, size_t* length)
+{
+    char* results;
+
+    EnterCriticalSection(&job->lock);
+    results = job->results.data;
+    *length = job->results.length;
+    if (job->results.length == 0) {
+        results = NULL;
+    } else {
+        job->results.data = NULL;
+        job->results.length = 0;
+        job->results.capacity = 0;
+    }
+    LeaveCriticalSection(&job->lock);
+    return results;
+}
+
+BOOL WaitFindInFiles(FindInFilesJob* job, DWORD milliseconds)
+{
+    return WaitForSingleObject(job->thread, milliseconds) == WAIT_OBJECT_0;
+}
+
+void GetFindInFilesStats(FindInFilesJob* job, FindInFilesStats* stats)
+{
+    LARGE_INTEGER frequency, end;
+
+    stats->filesSearched = InterlockedCompareExchange64(&job->filesSearched, 0, 0);
+    stats->filesMatched = InterlockedCompareExchange64(&job->filesMatched, 0, 0);
+    stats->matches = InterlockedCompareExchange64(&job->matches, 0, 0);
+    stats->bytesSearched = InterlockedCompareExchange64(&job->bytesSearched, 0, 0);
+    stats->cancelled = job->cancelled != 0;
+
+    QueryPerformanceFrequency(&frequency);
+    if (job->finished) {
+        end = job->endTime;
+    } else {
+        QueryPerformanceCounter(&end);
+    }
+    stats->seconds = (double)(end.QuadPart - job->startTime.QuadPart) / (double)frequency.QuadPart;
+}
+
+void FinishFindInFiles(FindInFilesJob* job)
+{
+    if (job) {
+        WaitForSingleObject(job->thread, INFINITE);
+        FreeJob(job);
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Find in Files header for Notepad+
+ * Searches every file under a folder on worker threads, streaming the matching lines back
+ */
+
+#ifndef FINDINFILES_H
+#define FINDINFILES_H
+
+#include <windows.h>
+
+/* Files are mapped at most this much at a time, split at line ends (bytes) */
+#define FINDINFILES_VIEW_SIZE       (64 * 1024 * 1024)
+
+/* Files with a NUL byte in this much of their start are skipped as binary (bytes) - files
+ * starting with a UTF-16 byte order mark are searched as UTF-8, converted this much at a time */
+#define FINDINFILES_BINARY_SAMPLE   4096
+#define FINDINFILES_UTF16_CHUNK     (4 * 1024 * 1024)
+
+/* Matching lines longer than this are cut short in the results (bytes) */
+#define FINDINFILES_MAX_LINE        256
+
+/* A worker hands its results over once it has this much, or at the end of a file (bytes) */
+#define FINDINFILES_FLUSH_SIZE      (64 * 1024)
+
+/* Files found but not searched yet - the folder walk waits when this many are queued */
+#define FINDINFILES_QUEUE_LIMIT     4096
+
+/* Most worker threads a search uses */
+#define FINDINFILES_MAX_THREADS     32
+
+/* Default file name patterns */
+#define FINDINFILES_DEFAULT_INCLUDE "*.*"
+#define FINDINFILES_DEFAULT_EXCLUDE ".git;.svn;.hg;node_modules"
+
+/* Posted by a search - wParam is the search's id (see FindInFilesId), lParam the job.
+ * RESULTS is posted when results arrive while none are waiting to be taken; DONE once
+ * after every file has been searched or the search was cancelled. */
+#define WM_FINDINFILES_RESULTS      (WM_APP + 4)
+#define WM_FINDINFILES_DONE         (WM_APP + 5)
+
+typedef struct {
+    char folder[MAX_PATH];
+    char include[MAX_PATH];         /* File name patterns to search, separated by ';' */
+    char exclude[MAX_PATH];         /* File and folder name patterns to skip, separated by ';' */
+    char pattern[256];
+    int searchFlags;                /* SCFIND_MATCHCASE, SCFIND_WHOLEWORD, SCFIND_REGEXP, SCFIND_POSIX and SCFIND_LINEARREGEX */
+    int threads;                    /* Worker threads, 0 for one per processor */
+} FindInFilesOptions;
+
+typedef struct {
+    LONG64 filesSearched;
+    LONG64 filesMatched;
+    LONG64 matches;                 /* Matching lines */
+    LONG64 bytesSearched;
+    double seconds;                 /* Time taken so far, or in all once done */
+    BOOL cancelled;
+} FindInFilesStats;
+
+typedef struct FindInFilesJob FindInFilesJob;
+
+/* Start searching on background threads. Returns NULL for an empty or invalid pattern. */
+FindInFilesJob* StartFindInFiles(const FindInFilesOptions* options, HWND notifyWindow);
+
+/* Ask a search to stop - WM_FINDINFILES_DONE is still posted */
+void CancelFindInFiles(FindInFilesJob* job);
+
+/* Id sent as wParam of the search's notifications, unique for each search */
+LONG FindInFilesId(const FindInFilesJob* job);
+
+/* Take the results found since the last call, or NULL when none - free with free.
+ * Each file with matches is a line with its path followed by a line for each matching
+ * line: a tab, the line number, ": " and the line. A file may appear more than once. */
+char* FindInFilesTakeResults(FindInFilesJob* job, size_t* length);
+
+/* Wait until every file has been searched. Returns FALSE on timeout. */
+BOOL WaitFindInFiles(FindInFilesJob* job, DWORD milliseconds);
+
+void GetFindInFilesStats(FindInFilesJob* job, FindInFilesStats* stats);
+
+/* Wait for the search to end and free it */
+void FinishFindInFiles(FindInFilesJob* job);
+
+/* Whether a file name matches one of the ';' separated patterns, ignoring case.
+ * '*' matches any run of characters and '?' any one character. */
+BOOL FindInFilesMatchPattern(const char* name, const char* patterns);
+
+#endif /* FINDINFILES_H */
@@ -4,6 +4,8 @@
 
 #include <windows.h>
 #include <commctrl.h>
+#include <shlobj.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -13,12 +15,30 @@
 #include "Scintilla.h"
 #include "tabs.h"
 #include "themes.h"
+#include "findinfiles.h"
+#include "findresults.h"
+#include "incsearch.h"
+#include "largefile.h"
+
+/* Timer that runs the incremental search in steps, owned by the find dialog */
+#define IDT_INCREMENTAL_SEARCH 2006
 
 static FindReplaceState g_findReplace = {0};
 static char* g_searchHistory[MAX_SEARCH_HISTORY] = {0};
 static int g_searchHistoryCount = 0;
 static HBRUSH g_findDlgBgBrush = NULL;
 static HBRUSH g_replaceDlgBgBrush = NULL;
+static HBRUSH g_findInFilesDlgBgBrush = NULL;
+
+/* Find in Files - the options last searched with, the search running and where its results go */
+static FindInFilesOptions g_findInFiles = { "", FINDINFILES_DEFAULT_INCLUDE, FINDINFILES_DEFAULT_EXCLUDE, "", 0, 0 };
+static FindInFilesJob* g_findInFilesJob = NULL;
+static LONG g_findInFilesId = 0;
+static HWND g_findInFilesNotify = NULL;     /* Main window, which gets the search's messages */
+static HWND g_findInFilesResults = NULL;    /* Editor of the results tab */
+
+/* Search as you type in the find dialog */
+static IncrementalSearch* g_incrementalSearch = NULL;
 
 BOOL InitializeFindReplace(void)
 {
@@ -33,6 +53,9 @@ void CleanupFindReplace(void)
     }
     g_searchHistoryCount = 0;
     
+    FreeIncrementalSearch(g_incrementalSearch);
+    g_incrementalSearch = NULL;
+    
     if (g_findReplace.hwndFind) {
         DestroyWindow(g_findReplace.hwndFind);
         g_findReplace.hwndFind = NULL;
@@ -41,6 +64,100 @@ void CleanupFindReplace(void)
         DestroyWindow(g_findReplace.hwndReplace);
         g_findReplace.hwndReplace = NULL;
     }
+    if (g_findReplace.hwndFindInFiles) {
+        DestroyWindow(g_findReplace.hwndFindInFiles);
+        g_findReplace.hwndFindInFiles = NULL;
+    }
+    if (g_findInFilesJob) {
+        CancelFindInFiles(g_findInFilesJob);
+        FinishFindInFiles(g_findInFilesJob);
+        g_findInFilesJob = NULL;
+    }
+}
+
+static HWND GetCurrentEditor(void);
+static int GetSearchFlags(void);
+
+/* Put the search history, most recent first, in a find text combo box's list */
+static void FillSearchHistory(HWND combo)
+{
+    char text[MAX_FIND_TEXT_LENGTH];
+    if (!combo) return;
+    
+    /* Emptying the list empties the edit box too */
+    GetWindowText(combo, text, MAX_FIND_TEXT_LENGTH);
+    SendMessage(combo, CB_RESETCONTENT, 0, 0);
+    for (int i = 0; i < g_searchHistoryCount; i++) {
+        SendMessage(combo, CB_ADDSTRING, 0, (LPARAM)g_searchHistory[i]);
+    }
+    SetWindowText(combo, text);
+}
+
+/* Read the find text and options from the find dialog */
+static void ReadFindDialog(HWND hwnd)
+{
+    GetDlgItemText(hwnd, IDC_FIND_COMBO, g_findReplace.findText, MAX_FIND_TEXT_LENGTH);
+    
+    g_findReplace.flags &= ~0x0F;
+    if (IsDlgButtonChecked(hwnd, IDC_MATCH_CASE) == BST_CHECKED) g_findReplace.flags |= 0x01;
+    if (IsDlgButtonChecked(hwnd, IDC_WHOLE_WORD) == BST_CHECKED) g_findReplace.flags |= 0x02;
+    if (IsDlgButtonChecked(hwnd, IDC_REGEX) == BST_CHECKED) g_findReplace.flags |= 0x04;
+    if (IsDlgButtonChecked(hwnd, IDC_INCREMENTAL) == BST_CHECKED) g_findReplace.flags |= 0x08;
+    
+    g_findReplace.searchDirection = SEARCH_DIRECTION_DOWN;
+}
+
+/* Show how far the incremental search has got */
+static void UpdateIncrementalStatus(HWND hwnd)
+{
+    char status[64];
+    size_t count = IncrementalSearchCount(g_incrementalSearch);
+    if (g_findReplace.findText[0] == '\0') {
+        status[0] = '\0';
+    } else if (!IncrementalSearchIsComplete(g_incrementalSearch)) {
+        snprintf(status, sizeof(status), "Searching... %zu found so far.", count);
+    } else if (count == 0) {
+        snprintf(status, sizeof(status), "Cannot find the text specified.");
+    } else {
+        snprintf(status, sizeof(status), "%zu occurrence%s found.", count, count == 1 ? "" : "s");
+    }
+    SetDlgItemText(hwnd, IDC_FIND_COUNT, status);
+}
+
+/* Search for the text as it now stands, dropping the search for the text before */
+static void RunIncrementalSearch(HWND hwnd)
+{
+    HWND editor = GetCurrentEditor();
+    if (!editor) return;
+    if (!g_incrementalSearch) {
+        g_incrementalSearch = CreateIncrementalSearch();
+        if (!g_incrementalSearch) return;
+    }
+    
+    ReadFindDialog(hwnd);
+    if (IncrementalSearchUpdate(g_incrementalSearch, editor, g_findReplace.findText, GetSearchFlags())) {
+        KillTimer(hwnd, IDT_INCREMENTAL_SEARCH);
+    } else {
+        SetTimer(hwnd, IDT_INCREMENTAL_SEARCH, INCSEARCH_STEP_INTERVAL, NULL);
+    }
+    UpdateIncrementalStatus(hwnd);
+}
+
+/* Stop the incremental search and remove its highlights */
+static void StopIncrementalSearch(HWND hwnd)
+{
+    KillTimer(hwnd, IDT_INCREMENTAL_SEARCH);
+    IncrementalSearchCancel(g_incrementalSearch);
+}
+
+/* Hide the find dialog, keeping what was searched for as you typed */
+static void HideFindDialog(HWND hwnd)
+{
+    if (IsDlgButtonChecked(hwnd, IDC_INCREMENTAL) == BST_CHECKED) {
+        AddToSearchHistory(g_findReplace.findText);
+    }
+    StopIncrementalSearch(hwnd);
+    ShowWindow(hwnd, SW_HIDE);
 }
 
 /* Find dialog procedure */
@@ -50,34 +167,79 @@ static INT_PTR CALLBACK FindDialogProc(HWND hwnd, UINT msg, WPARAM wParam, LPARA
     switch (msg) {
         case WM_INITDIALOG:
             {
-                /* Set find text if available */
+                /* Set find text if available, with earlier searches in the list */
+                FillSearchHistory(GetDlgItem(hwnd, IDC_FIND_COMBO));
                 SetDlgItemText(hwnd, IDC_FIND_COMBO, g_findReplace.findText);
                 
                 /* Set checkboxes */
                 CheckDlgButton(hwnd, IDC_MATCH_CASE, (g_findReplace.flags & 0x01) ? BST_CHECKED : BST_UNCHECKED);
                 CheckDlgButton(hwnd, IDC_WHOLE_WORD, (g_findReplace.flags & 0x02) ? BST_CHECKED : BST_UNCHECKED);
+                CheckDlgButton(hwnd, IDC_REGEX, (g_findReplace.flags & 0x04) ? BST_CHECKED : BST_UNCHECKED);
+                CheckDlgButton(hwnd, IDC_INCREMENTAL, (g_findReplace.flags & 0x08) ? BST_CHECKED : BST_UNCHECKED);
                 
                 /* Focus on find text box */
                 SetFocus(GetDlgItem(hwnd, IDC_FIND_COMBO));
-                SendDlgItemMessage(hwnd, IDC_FIND_COMBO, EM_SETSEL, 0, -1);
+                SendDlgItemMessage(hwnd, IDC_FIND_COMBO, CB_SETEDITSEL, 0, MAKELPARAM(0, -1));
                 
                 return FALSE;
             }
             
+        case WM_TIMER:
+            if (wParam == IDT_INCREMENTAL_SEARCH) {
+                if (IncrementalSearchStep(g_incrementalSearch)) {
+                    KillTimer(hwnd, IDT_INCREMENTAL_SEARCH);
+                }
+                UpdateIncrementalStatus(hwnd);
+                return TRUE;
+            }
+            break;
+            
         case WM_COMMAND:
             switch (LOWORD(wParam)) {
+                case IDC_FIND_COMBO: /* Find text typed or picked from the history */
+                    if (HIWORD(wParam) == CBN_SELCHANGE) {
+                        /* The edit box only takes the picked text after this notification */
+                        HWND combo = GetDlgItem(hwnd, IDC_FIND_COMBO);
+                        LRESULT selected = SendMessage(combo, CB_GETCURSEL, 0, 0);
+                        if (selected == CB_ERR ||
+                            SendMessage(combo, CB_GETLBTEXTLEN, (WPARAM)selected, 0) >= MAX_FIND_TEXT_LENGTH) {
+                            return TRUE;
+                        }
+                        char text[MAX_FIND_TEXT_LENGTH];
+                        SendMessage(combo, CB_GETLBTEXT, (WPARAM)selected, (LPARAM)text);
+                        SetWindowText(combo, text);
+                    } else if (HIWORD(wParam) != CBN_EDITCHANGE) {
+                        break;
+                    }
+                    if (IsDlgButtonChecked(hwnd, IDC_INCREMENTAL) == BST_CHECKED) {
+                        RunIncrementalSearch(hwnd);
+                    }
+                    return TRUE;
+                    
+                case IDC_MATCH_CASE:
+                case IDC_WHOLE_WORD:
+                case IDC_REGEX:
+                    /* Options changed - search again with them */
+                    if (IsDlgButtonChecked(hwnd, IDC_INCREMENTAL) == BST_CHECKED) {
+                        RunIncrementalSearch(hwnd);
+                    }
+                    return TRUE;
+                    
+                case IDC_INCREMENTAL: /* Search as you type checkbox */
+                    if (IsDlgButtonChecked(hwnd, IDC_INCREMENTAL) == BST_CHECKED) {
+                        RunIncrementalSearch(hwnd);
+                    } else {
+                        ReadFindDialog(hwnd);
+                        StopIncrementalSearch(hwnd);
+                        SetDlgItemText(hwnd, IDC_FIND_COUNT, "");
+                    }
+                    return TRUE;
+                    
                 case IDC_FIND_NEXT: /* Find Next button */
                     {
-                        /* Get find text */
-                        GetDlgItemText(hwnd, IDC_FIND_COMBO, g_findReplace.findText, MAX_FIND_TEXT_LENGTH);
-                        
-                        /* Get flags */
-                        g_findReplace.flags = 0;
-                        if (IsDlgButtonChecked(hwnd, IDC_MATCH_CASE) == BST_CHECKED) g_findReplace.flags |= 0x01;
-                        if (IsDlgButtonChecked(hwnd, IDC_WHOLE_WORD) == BST_CHECKED) g_findReplace.flags |= 0x02;
-                        
-                        /* Set search direction */
-                        g_findReplace.searchDirection = SEARCH_DIRECTION_DOWN;
+                        ReadFindDialog(hwnd);
+                        StopIncrementalSearch(hwnd);
+                        AddToSearchHistory(g_findReplace.findText);
                         
                         /* Perform search */
                         if (!FindNext()) {
@@ -86,9 +248,23 @@ static INT_PTR CALLBACK FindDialogProc(HWND hwnd, UINT msg, WPARAM wParam, LPARA
                         return TRUE;
                     }
                     
+                case IDC_FIND_ALL: /* Find All button */
+                    {
+                        ReadFindDialog(hwnd);
+                        StopIncrementalSearch(hwnd);
+                        AddToSearchHistory(g_findReplace.findText);
+                        
+                        /* List every occurrence in the results panel - FindAllDone shows the count */
+                        SetDlgItemText(hwnd, IDC_FIND_COUNT, "Searching...");
+                        if (!FindAll()) {
+                            SetDlgItemText(hwnd, IDC_FIND_COUNT, "");
+                        }
+                        return TRUE;
+                    }
+                    
                 case IDCANCEL:
                 case IDC_CLOSE_BUTTON: /* Close button */
-                    ShowWindow(hwnd, SW_HIDE);
+                    HideFindDialog(hwnd);
                     return TRUE;
             }
             break;
@@ -112,10 +288,12 @@ static INT_PTR CALLBACK FindDialogProc(HWND hwnd, UINT msg, WPARAM wParam, LPARA
             break;
             
         case WM_CLOSE:
-            ShowWindow(hwnd, SW_HIDE);
+            HideFindDialog(hwnd);
             return TRUE;
             
         case WM_DESTROY:
+            KillTimer(hwnd, IDT_INCREMENTAL_SEARCH);
+            
             /* Clean up background brush */
             if (g_findDlgBgBrush) {
                 DeleteObject(g_findDlgBgBrush);
@@ -127,6 +305,20 @@ static INT_PTR CALLBACK FindDialogProc(HWND hwnd, UINT msg, WPARAM wParam, LPARA
     return FALSE;
 }
 
+/* Read the find and replace text and options from the replace dialog */
+static void ReadReplaceDialog(HWND hwnd)
+{
+    GetDlgItemText(hwnd, IDC_FIND_COMBO, g_findReplace.findText, MAX_FIND_TEXT_LENGTH);
+    GetDlgItemText(hwnd, IDC_REPLACE_COMBO, g_findReplace.replaceText, MAX_REPLACE_TEXT_LENGTH);
+    
+    g_findReplace.flags &= ~0x07;
+    if (IsDlgButtonChecked(hwnd, IDC_MATCH_CASE) == BST_CHECKED) g_findReplace.flags |= 0x01;
+    if (IsDlgButtonChecked(hwnd, IDC_WHOLE_WORD) == BST_CHECKED) g_findReplace.flags |= 0x02;
+    if (IsDlgButtonChecked(hwnd, IDC_REGEX) == BST_CHECKED) g_findReplace.flags |= 0x04;
+    
+    g_findReplace.searchDirection = SEARCH_DIRECTION_DOWN;
+}
+
 /* Replace dialog procedure */
 static INT_PTR CALLBACK ReplaceDialogProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
@@ -134,17 +326,19 @@ static INT_PTR CALLBACK ReplaceDialogProc(HWND hwnd, UINT msg, WPARAM wParam, LP
     switch (msg) {
         case WM_INITDIALOG:
             {
-                /* Set find and replace text if available */
+                /* Set find and replace text if available, with earlier searches in the list */
+                FillSearchHistory(GetDlgItem(hwnd, IDC_FIND_COMBO));
                 SetDlgItemText(hwnd, IDC_FIND_COMBO, g_findReplace.findText);
                 SetDlgItemText(hwnd, IDC_REPLACE_COMBO, g_findReplace.replaceText);
                 
                 /* Set checkboxes */
                 CheckDlgButton(hwnd, IDC_MATCH_CASE, (g_findReplace.flags & 0x01) ? BST_CHECKED : BST_UNCHECKED);
                 CheckDlgButton(hwnd, IDC_WHOLE_WORD, (g_findReplace.flags & 0x02) ? BST_CHECKED : BST_UNCHECKED);
+                CheckDlgButton(hwnd, IDC_REGEX, (g_findReplace.flags & 0x04) ? BST_CHECKED : BST_UNCHECKED);
                 
                 /* Focus on find text box */
                 SetFocus(GetDlgItem(hwnd, IDC_FIND_COMBO));
-                SendDlgItemMessage(hwnd, IDC_FIND_COMBO, EM_SETSEL, 0, -1);
+                SendDlgItemMessage(hwnd, IDC_FIND_COMBO, CB_SETEDITSEL, 0, MAKELPARAM(0, -1));
                 
                 return FALSE;
             }
@@ -153,17 +347,8 @@ static INT_PTR CALLBACK ReplaceDialogProc(HWND hwnd, UINT msg, WPARAM wParam, LP
             switch (LOWORD(wParam)) {
                 case IDC_FIND_NEXT: /* Find Next button */
                     {
-                        /* Get find text */
-                        GetDlgItemText(hwnd, IDC_FIND_COMBO, g_findReplace.findText, MAX_FIND_TEXT_LENGTH);
-                        GetDlgItemText(hwnd, IDC_REPLACE_COMBO, g_findReplace.replaceText, MAX_REPLACE_TEXT_LENGTH);
-                        
-                        /* Get flags */
-                        g_findReplace.flags = 0;
-                        if (IsDlgButtonChecked(hwnd, IDC_MATCH_CASE) == BST_CHECKED) g_findReplace.flags |= 0x01;
-                        if (IsDlgButtonChecked(hwnd, IDC_WHOLE_WORD) == BST_CHECKED) g_findReplace.flags |= 0x02;
-                        
-                        /* Set search direction */
-                        g_findReplace.searchDirection = SEARCH_DIRECTION_DOWN;
+                        ReadReplaceDialog(hwnd);
+                        AddToSearchHistory(g_findReplace.findText);
                         
                         /* Perform search */
                         if (!FindNext()) {
@@ -172,6 +357,28 @@ static INT_PTR CALLBACK ReplaceDialogProc(HWND hwnd, UINT msg, WPARAM wParam, LP
                         return TRUE;
                     }
                     
+                case IDC_REPLACE: /* Replace button */
+                    {
+                        ReadReplaceDialog(hwnd);
+                        Replace();
+                        return TRUE;
+                    }
+                    
+                case IDC_REPLACE_ALL: /* Replace All button */
+                    {
+                        char status[64];
+                        ReadReplaceDialog(hwnd);
+                        AddToSearchHistory(g_findReplace.findText);
+                        int replaced = ReplaceAll();
+                        if (replaced < 0) {
+                            snprintf(status, sizeof(status), "Invalid regular expression.");
+                        } else {
+                            snprintf(status, sizeof(status), "%d occurrence%s replaced.", replaced, replaced == 1 ? "" : "s");
+                        }
+                        SetDlgItemText(hwnd, IDC_FIND_COUNT, status);
+                        return TRUE;
+                    }
+                    
                 case IDCANCEL:
                 case IDC_CLOSE_BUTTON: /* Close button */
                     ShowWindow(hwnd, SW_HIDE);
@@ -229,7 +436,7 @@ static LPDLGTEMPLATE CreateFindReplaceTemplate(BOOL isReplace)
     *p++ = HIWORD(lStyle);
     *p++ = 0;          /* LOWORD (lExtendedStyle) */
     *p++ = 0;          /* HIWORD (lExtendedStyle) */
-    *p++ = isReplace ? 13 : 10;  /* NumberOfItems */
+    *p++ = isReplace ? 14 : 13;  /* NumberOfItems */
     *p++ = 10;         /* x */
     *p++ = 10;         /* y */
     *p++ = 280;        /* cx */
@@ -261,13 +468,13 @@ static LPDLGTEMPLATE CreateFindReplaceTemplate(BOOL isReplace)
     *p++ = 0;  /* No creation data */
     p = (PWORD)(((LONG_PTR)p + 3) & ~3);
     
-    /* Find text edit box */
-    lStyle = WS_CHILD | WS_VISIBLE | WS_BORDER | WS_TABSTOP | ES_LEFT | ES_AUTOHSCROLL;
+    /* Find text combo box, the search history in its list */
+    lStyle = WS_CHILD | WS_VISIBLE | WS_TABSTOP | WS_VSCROLL | CBS_DROPDOWN | CBS_AUTOHSCROLL;
     *p++ = LOWORD(lStyle); *p++ = HIWORD(lStyle);
     *p++ = 0; *p++ = 0;
-    *p++ = 60; *p++ = 8; *p++ = 150; *p++ = 14;
+    *p++ = 60; *p++ = 8; *p++ = 150; *p++ = 100;
     *p++ = 1001;
-    *p++ = 0xFFFF; *p++ = 0x0081;  /* Edit class */
+    *p++ = 0xFFFF; *p++ = 0x0085;  /* Combo box class */
     *p++ = 0;
     *p++ = 0;
     p = (PWORD)(((LONG_PTR)p + 3) & ~3);
@@ -321,6 +528,18 @@ static LPDLGTEMPLATE CreateFindReplaceTemplate(BOOL isReplace)
     *p++ = 0;
     p = (PWORD)(((LONG_PTR)p + 3) & ~3);
 
+    /* Regular expression checkbox */
+    lStyle = WS_CHILD | WS_VISIBLE | WS_TABSTOP | BS_AUTOCHECKBOX;
+    *p++ = LOWORD(lStyle); *p++ = HIWORD(lStyle);
+    *p++ = 0; *p++ = 0;
+    *p++ = 120; *p++ = isReplace ? 81 : 60; *p++ = 95; *p++ = 12;
+    *p++ = IDC_REGEX;
+    *p++ = 0xFFFF; *p++ = 0x0080;  /* Button class */
+    nchar = MultiByteToWideChar(CP_ACP, 0, "Regular expression", -1, (LPWSTR)p, 50);
+    p += nchar;
+    *p++ = 0;
+    p = (PWORD)(((LONG_PTR)p + 3) & ~3);
+
     /* Direction label */
     lStyle = WS_CHILD | WS_VISIBLE | SS_LEFT;
     *p++ = LOWORD(lStyle); *p++ = HIWORD(lStyle);
@@ -381,6 +600,32 @@ static LPDLGTEMPLATE CreateFindReplaceTemplate(BOOL isReplace)
     *p++ = 0;
     p = (PWORD)(((LONG_PTR)p + 3) & ~3);
 
+    if (!isReplace) {
+        /* Search as you type checkbox */
+        lStyle = WS_CHILD | WS_VISIBLE | WS_TABSTOP | BS_AUTOCHECKBOX;
+        *p++ = LOWORD(lStyle); *p++ = HIWORD(lStyle);
+        *p++ = 0; *p++ = 0;
+        *p++ = 5; *p++ = 60; *p++ = 100; *p++ = 12;
+        *p++ = IDC_INCREMENTAL;
+        *p++ = 0xFFFF; *p++ = 0x0080;  /* Button class */
+        nchar = MultiByteToWideChar(CP_ACP, 0, "Search as you type", -1, (LPWSTR)p, 50);
+        p += nchar;
+        *p++ = 0;
+        p = (PWORD)(((LONG_PTR)p + 3) & ~3);
+
+        /* Find All button */
+        lStyle = WS_CHILD | WS_VISIBLE | WS_TABSTOP | BS_PUSHBUTTON;
+        *p++ = LOWORD(lStyle); *p++ = HIWORD(lStyle);
+        *p++ = 0; *p++ = 0;
+        *p++ = 220; *p++ = 46; *p++ = 55; *p++ = 14;
+        *p++ = IDC_FIND_ALL;
+        *p++ = 0xFFFF; *p++ = 0x0080;  /* Button class */
+        nchar = MultiByteToWideChar(CP_ACP, 0, "Find All", -1, (LPWSTR)p, 50);
+        p += nchar;
+        *p++ = 0;
+        p = (PWORD)(((LONG_PTR)p + 3) & ~3);
+    }
+
     /* Status label */
     lStyle = WS_CHILD | WS_VISIBLE | SS_LEFT;
     *p++ = LOWORD(lStyle); *p++ = HIWORD(lStyle);
@@ -459,35 +704,504 @@ BOOL ShowReplaceDialog(HWND parent)
     return FALSE;
 }
 
-void CreateFindControls(HWND hwnd) { UNREFERENCED_PARAMETER(hwnd); }
-void CreateReplaceControls(HWND hwnd) { UNREFERENCED_PARAMETER(hwnd); }
+/* Add a control to an in-memory dialog template and return where the next one goes.
+ * classAtom is 0x0080 for a button, 0x0081 for an edit box, 0x0082 for a static and
+ * 0x0085 for a combo box. */
+static WORD* AddTemplateItem(WORD* p, DWORD style, short x, short y, short cx, short cy,
+                             WORD id, WORD classAtom, const char* text)
+{
+    *p++ = LOWORD(style); *p++ = HIWORD(style);
+    *p++ = 0; *p++ = 0;
+    *p++ = x; *p++ = y; *p++ = cx; *p++ = cy;
+    *p++ = id;
+    *p++ = 0xFFFF; *p++ = classAtom;
+    p += MultiByteToWideChar(CP_ACP, 0, text, -1, (LPWSTR)p, 64);
+    *p++ = 0;  /* No creation data */
+    return (PWORD)(((LONG_PTR)p + 3) & ~3);
+}
 
-BOOL FindNext(void)
+static LPDLGTEMPLATE CreateFindInFilesTemplate(void)
 {
-    if (g_findReplace.findText[0] == '\0') {
+    WORD *p, *pdlgtemplate;
+    int nchar;
+    DWORD lStyle;
+    const DWORD labelStyle = WS_CHILD | WS_VISIBLE | SS_LEFT;
+    const DWORD editStyle = WS_CHILD | WS_VISIBLE | WS_BORDER | WS_TABSTOP | ES_LEFT | ES_AUTOHSCROLL;
+    const DWORD checkStyle = WS_CHILD | WS_VISIBLE | WS_TABSTOP | BS_AUTOCHECKBOX;
+    const DWORD buttonStyle = WS_CHILD | WS_VISIBLE | WS_TABSTOP | BS_PUSHBUTTON;
+    
+    pdlgtemplate = p = (PWORD)GlobalAlloc(GMEM_ZEROINIT, 4096);
+    
+    /* DLGTEMPLATE header */
+    lStyle = DS_SETFONT | DS_MODALFRAME | DS_FIXEDSYS | WS_POPUP | WS_CAPTION | WS_SYSMENU | WS_VISIBLE;
+    *p++ = LOWORD(lStyle);
+    *p++ = HIWORD(lStyle);
+    *p++ = 0;          /* LOWORD (lExtendedStyle) */
+    *p++ = 0;          /* HIWORD (lExtendedStyle) */
+    *p++ = 16;         /* NumberOfItems */
+    *p++ = 10;         /* x */
+    *p++ = 10;         /* y */
+    *p++ = 300;        /* cx */
+    *p++ = 116;        /* cy */
+    *p++ = 0;          /* Menu */
+    *p++ = 0;          /* Class */
+    nchar = MultiByteToWideChar(CP_ACP, 0, "Find in Files", -1, (LPWSTR)p, 50);
+    p += nchar;
+    *p++ = 8;          /* Font size */
+    nchar = MultiByteToWideChar(CP_ACP, 0, "MS Shell Dlg", -1, (LPWSTR)p, 50);
+    p += nchar;
+    p = (PWORD)(((LONG_PTR)p + 3) & ~3);
+    
+    p = AddTemplateItem(p, labelStyle, 5, 10, 50, 10, 0xFFFF, 0x0082, "Find what:");
+    p = AddTemplateItem(p, editStyle, 60, 8, 170, 14, IDC_FIND_COMBO, 0x0081, "");
+    p = AddTemplateItem(p, labelStyle, 5, 28, 50, 10, 0xFFFF, 0x0082, "Directory:");
+    p = AddTemplateItem(p, editStyle, 60, 26, 150, 14, IDC_FIF_FOLDER, 0x0081, "");
+    p = AddTemplateItem(p, buttonStyle, 214, 26, 16, 14, IDC_FIF_BROWSE, 0x0080, "...");
+    p = AddTemplateItem(p, labelStyle, 5, 46, 50, 10, 0xFFFF, 0x0082, "Files:");
+    p = AddTemplateItem(p, editStyle, 60, 44, 170, 14, IDC_FIF_INCLUDE, 0x0081, "");
+    p = AddTemplateItem(p, labelStyle, 5, 64, 50, 10, 0xFFFF, 0x0082, "Exclude:");
+    p = AddTemplateItem(p, editStyle, 60, 62, 170, 14, IDC_FIF_EXCLUDE, 0x0081, "");
+    p = AddTemplateItem(p, checkStyle, 5, 82, 70, 12, IDC_MATCH_CASE, 0x0080, "Match case");
+    p = AddTemplateItem(p, checkStyle, 80, 82, 70, 12, IDC_WHOLE_WORD, 0x0080, "Whole word");
+    p = AddTemplateItem(p, checkStyle, 155, 82, 90, 12, IDC_FIF_REGEX, 0x0080, "Regular expression");
+    p = AddTemplateItem(p, WS_CHILD | WS_VISIBLE | WS_TABSTOP | BS_DEFPUSHBUTTON, 238, 8, 55, 14,
+                        IDC_FIF_FIND_ALL, 0x0080, "Find All");
+    p = AddTemplateItem(p, buttonStyle, 238, 26, 55, 14, IDC_FIF_STOP, 0x0080, "Stop");
+    p = AddTemplateItem(p, buttonStyle, 238, 44, 55, 14, IDC_CLOSE_BUTTON, 0x0080, "Close");
+    AddTemplateItem(p, labelStyle, 5, 100, 288, 10, IDC_FIND_COUNT, 0x0082, "");
+    
+    return (LPDLGTEMPLATE)pdlgtemplate;
+}
+
+/* Editor of the results tab if it is still open */
+static HWND GetFindInFilesResults(int* tabIndex)
+{
+    int tabCount = GetTabCount();
+    for (int i = 0; g_findInFilesResults && i < tabCount; i++) {
+        TabInfo* tab = GetTab(i);
+        if (tab && tab->editorHandle == g_findInFilesResults) {
+            if (tabIndex) *tabIndex = i;
+            return g_findInFilesResults;
+        }
+    }
+    g_findInFilesResults = NULL;
+    return NULL;
+}
+
+/* Add text to the end of the read-only results. The save point is moved along
+ * so the results tab never asks to be saved. */
+static void AppendFindInFilesResults(const char* text, size_t length)
+{
+    HWND editor = GetFindInFilesResults(NULL);
+    if (!editor || length == 0) {
+        return;
+    }
+    SendMessage(editor, SCI_SETREADONLY, 0, 0);
+    SendMessage(editor, SCI_APPENDTEXT, (WPARAM)length, (LPARAM)text);
+    SendMessage(editor, SCI_SETREADONLY, 1, 0);
+    SendMessage(editor, SCI_SETSAVEPOINT, 0, 0);
+}
+
+/* Empty the results tab, opening it first if needed */
+static BOOL OpenFindInFilesResults(void)
+{
+    int index = -1;
+    HWND editor = GetFindInFilesResults(&index);
+    
+    if (!editor) {
+        index = AddNewTab(NULL);
+        TabInfo* tab = (index >= 0) ? GetTab(index) : NULL;
+        if (!tab) {
+            return FALSE;
+        }
+        strcpy(tab->filePath, FINDINFILES_RESULTS_NAME);
+        UpdateTabDisplayName(index);
+        editor = g_findInFilesResults = tab->editorHandle;
+        SendMessage(editor, SCI_SETUNDOCOLLECTION, 0, 0);
+    }
+    SelectTab(index);
+    
+    SendMessage(editor, SCI_SETREADONLY, 0, 0);
+    SendMessage(editor, SCI_CLEARALL, 0, 0);
+    SendMessage(editor, SCI_SETREADONLY, 1, 0);
+    SendMessage(editor, SCI_SETSAVEPOINT, 0, 0);
+    return TRUE;
+}
+
+/* Show the progress of the running search, or how the last one ended */
+static void UpdateFindInFilesStatus(const FindInFilesStats* stats, BOOL done)
+{
+    char status[160];
+    if (!g_findReplace.hwndFindInFiles) {
+        return;
+    }
+    snprintf(status, sizeof(status), "%s%lld matching line%s in %lld of %lld files%s",
+             done ? "" : "Searching... ", (long long)stats->matches, stats->matches == 1 ? "" : "s",
+             (long long)stats->filesMatched, (long long)stats->filesSearched,
+             (done && stats->cancelled) ? " (stopped)" : ".");
+    SetDlgItemText(g_findReplace.hwndFindInFiles, IDC_FIND_COUNT, status);
+    EnableWindow(GetDlgItem(g_findReplace.hwndFindInFiles, IDC_FIF_STOP), !done);
+}
+
+/* Start searching with the options in the dialog, replacing any search still running */
+static void StartFindInFilesFromDialog(HWND hwnd)
+{
+    char title[MAX_PATH * 2 + 64];
+    
+    GetDlgItemText(hwnd, IDC_FIND_COMBO, g_findInFiles.pattern, sizeof(g_findInFiles.pattern));
+    GetDlgItemText(hwnd, IDC_FIF_FOLDER, g_findInFiles.folder, sizeof(g_findInFiles.folder));
+    GetDlgItemText(hwnd, IDC_FIF_INCLUDE, g_findInFiles.include, sizeof(g_findInFiles.include));
+    GetDlgItemText(hwnd, IDC_FIF_EXCLUDE, g_findInFiles.exclude, sizeof(g_findInFiles.exclude));
+    g_findInFiles.searchFlags = 0;
+    if (IsDlgButtonChecked(hwnd, IDC_MATCH_CASE) == BST_CHECKED) g_findInFiles.searchFlags |= SCFIND_MATCHCASE;
+    if (IsDlgButtonChecked(hwnd, IDC_WHOLE_WORD) == BST_CHECKED) g_findInFiles.searchFlags |= SCFIND_WHOLEWORD;
+    if (IsDlgButtonChecked(hwnd, IDC_FIF_REGEX) == BST_CHECKED) g_findInFiles.searchFlags |= SCFIND_REGEXP | SCFIND_LINEARREGEX;
+    
+    if (g_findInFiles.pattern[0] == '\0' || g_findInFiles.folder[0] == '\0') {
+        SetDlgItemText(hwnd, IDC_FIND_COUNT, "Enter the text to find and the directory to look in.");
+        return;
+    }
+    DWORD attributes = GetFileAttributes(g_findInFiles.folder);
+    if (attributes == INVALID_FILE_ATTRIBUTES || !(attributes & FILE_ATTRIBUTE_DIRECTORY)) {
+        SetDlgItemText(hwnd, IDC_FIND_COUNT, "The directory doesn't exist.");
+        return;
+    }
+    
+    if (g_findInFilesJob) {
+        CancelFindInFiles(g_findInFilesJob);
+        FinishFindInFiles(g_findInFilesJob);
+        g_findInFilesJob = NULL;
+    }
+    FindInFilesJob* job = StartFindInFiles(&g_findInFiles, g_findInFilesNotify);
+    if (!job) {
+        SetDlgItemText(hwnd, IDC_FIND_COUNT, (g_findInFiles.searchFlags & SCFIND_REGEXP) ?
+                       "Invalid regular expression." : "Couldn't start searching.");
+        return;
+    }
+    g_findInFilesJob = job;
+    g_findInFilesId = FindInFilesId(job);
+    AddToSearchHistory(g_findInFiles.pattern);
+    
+    if (OpenFindInFilesResults()) {
+        int length = snprintf(title, sizeof(title), "Find \"%s\" in %s (%s)\r\n", g_findInFiles.pattern,
+                              g_findInFiles.folder, g_findInFiles.include[0] ? g_findInFiles.include : FINDINFILES_DEFAULT_INCLUDE);
+        if (length > 0) {
+            AppendFindInFilesResults(title, strlen(title));
+        }
+    }
+    SetDlgItemText(hwnd, IDC_FIND_COUNT, "Searching...");
+    EnableWindow(GetDlgItem(hwnd, IDC_FIF_STOP), TRUE);
+}
+
+/* Let the user pick the directory to search */
+static void BrowseFindInFilesFolder(HWND hwnd)
+{
+    char folder[MAX_PATH];
+    BROWSEINFO bi;
+    
+    memset(&bi, 0, sizeof(bi));
+    bi.hwndOwner = hwnd;
+    bi.pszDisplayName = folder;
+    bi.lpszTitle = "Directory to search:";
+    bi.ulFlags = BIF_RETURNONLYFSDIRS | BIF_NEWDIALOGSTYLE;
+    
+    /* The new style folder dialog needs COM */
+    HRESULT hr = CoInitializeEx(NULL, COINIT_APARTMENTTHREADED);
+    LPITEMIDLIST pidl = SHBrowseForFolder(&bi);
+    if (pidl) {
+        if (SHGetPathFromIDList(pidl, folder)) {
+            SetDlgItemText(hwnd, IDC_FIF_FOLDER, folder);
+        }
+        CoTaskMemFree(pidl);
+    }
+    if (SUCCEEDED(hr)) {
+        CoUninitialize();
+    }
+}
+
+/* Find in Files dialog procedure */
+static INT_PTR CALLBACK FindInFilesDialogProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
+{
+    UNREFERENCED_PARAMETER(lParam);
+    switch (msg) {
+        case WM_INITDIALOG:
+            {
+                /* Search the directory of the current file by default */
+                if (g_findInFiles.folder[0] == '\0') {
+                    TabInfo* tab = GetTab(GetSelectedTab());
+                    if (tab && strncmp(tab->filePath, "New ", 4) != 0 && strrchr(tab->filePath, '\\')) {
+                        strncpy(g_findInFiles.folder, tab->filePath, MAX_PATH - 1);
+                        *strrchr(g_findInFiles.folder, '\\') = '\0';
+                    } else {
+                        GetCurrentDirectory(MAX_PATH, g_findInFiles.folder);
+                    }
+                }
+                SetDlgItemText(hwnd, IDC_FIND_COMBO, g_findReplace.findText[0] ? g_findReplace.findText : g_findInFiles.pattern);
+                SetDlgItemText(hwnd, IDC_FIF_FOLDER, g_findInFiles.folder);
+                SetDlgItemText(hwnd, IDC_FIF_INCLUDE, g_findInFiles.include);
+                SetDlgItemText(hwnd, IDC_FIF_EXCLUDE, g_findInFiles.exclude);
+                CheckDlgButton(hwnd, IDC_MATCH_CASE, (g_findInFiles.searchFlags & SCFIND_MATCHCASE) ? BST_CHECKED : BST_UNCHECKED);
+                CheckDlgButton(hwnd, IDC_WHOLE_WORD, (g_findInFiles.searchFlags & SCFIND_WHOLEWORD) ? BST_CHECKED : BST_UNCHECKED);
+                CheckDlgButton(hwnd, IDC_FIF_REGEX, (g_findInFiles.searchFlags & SCFIND_REGEXP) ? BST_CHECKED : BST_UNCHECKED);
+                EnableWindow(GetDlgItem(hwnd, IDC_FIF_STOP), g_findInFilesJob != NULL);
+                
+                SetFocus(GetDlgItem(hwnd, IDC_FIND_COMBO));
+                SendDlgItemMessage(hwnd, IDC_FIND_COMBO, EM_SETSEL, 0, -1);
+                return FALSE;
+            }
+            
+        case WM_COMMAND:
+            switch (LOWORD(wParam)) {
+                case IDC_FIF_FIND_ALL:
+                    StartFindInFilesFromDialog(hwnd);
+                    return TRUE;
+                    
+                case IDC_FIF_STOP:
+                    CancelFindInFiles(g_findInFilesJob);
+                    return TRUE;
+                    
+                case IDC_FIF_BROWSE:
+                    BrowseFindInFilesFolder(hwnd);
+                    return TRUE;
+                    
+                case IDCANCEL:
+                case IDC_CLOSE_BUTTON: /* Close button */
+                    ShowWindow(hwnd, SW_HIDE);
+                    return TRUE;
+            }
+            break;
+            
+        case WM_CTLCOLORSTATIC:
+            {
+                /* Theme-aware static control coloring */
+                ThemeColors* colors = GetThemeColors();
+                if (colors) {
+                    HDC hdcStatic = (HDC)wParam;
+                    SetTextColor(hdcStatic, colors->statusbarFg);
+                    SetBkColor(hdcStatic, colors->windowBg);
+                    
+                    if (!g_findInFilesDlgBgBrush) {
+                        g_findInFilesDlgBgBrush = CreateSolidBrush(colors->windowBg);
+                    }
+                    return (INT_PTR)g_findInFilesDlgBgBrush;
+                }
+            }
+            break;
+            
+        case WM_CLOSE:
+            ShowWindow(hwnd, SW_HIDE);
+            return TRUE;
+            
+        case WM_DESTROY:
+            if (g_findInFilesDlgBgBrush) {
+                DeleteObject(g_findInFilesDlgBgBrush);
+                g_findInFilesDlgBgBrush = NULL;
+            }
+            return TRUE;
+    }
+    
+    return FALSE;
+}
+
+BOOL ShowFindInFilesDialog(HWND parent)
+{
+    g_findInFilesNotify = parent;
+    if (g_findReplace.hwndFindInFiles) {
+        if (g_findReplace.findText[0]) {
+            SetDlgItemText(g_findReplace.hwndFindInFiles, IDC_FIND_COMBO, g_findReplace.findText);
+        }
+        ShowWindow(g_findReplace.hwndFindInFiles, SW_SHOW);
+        SetFocus(GetDlgItem(g_findReplace.hwndFindInFiles, IDC_FIND_COMBO));
+        return TRUE;
+    }
+
+    LPDLGTEMPLATE templ = CreateFindInFilesTemplate();
+    g_findReplace.hwndFindInFiles = CreateDialogIndirect(GetModuleHandle(NULL), templ, parent, FindInFilesDialogProc);
+    GlobalFree(templ);
+
+    if (g_findReplace.hwndFindInFiles) {
+        ShowWindow(g_findReplace.hwndFindInFiles, SW_SHOW);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/* Move the results found so far into the results tab - dropped if it was closed */
+static void TakeFindInFilesResults(void)
+{
+    size_t length = 0;
+    char* results = FindInFilesTakeResults(g_findInFilesJob, &length);
+    if (results) {
+        AppendFindInFilesResults(results, length);
+        free(results);
+    }
+}
+
+void FindInFilesResultsReady(WPARAM wParam, LPARAM lParam)
+{
+    FindInFilesStats stats;
+    
+    /* Ignore messages from a search that has been replaced */
+    if (!g_findInFilesJob || (LONG)wParam != g_findInFilesId || (FindInFilesJob*)lParam != g_findInFilesJob) {
+        return;
+    }
+    TakeFindInFilesResults();
+    GetFindInFilesStats(g_findInFilesJob, &stats);
+    UpdateFindInFilesStatus(&stats, FALSE);
+}
+
+void FindInFilesDone(WPARAM wParam, LPARAM lParam)
+{
+    FindInFilesStats stats;
+    char summary[160];
+    
+    if (!g_findInFilesJob || (LONG)wParam != g_findInFilesId || (FindInFilesJob*)lParam != g_findInFilesJob) {
+        return;
+    }
+    TakeFindInFilesResults();
+    GetFindInFilesStats(g_findInFilesJob, &stats);
+    FinishFindInFiles(g_findInFilesJob);
+    g_findInFilesJob = NULL;
+    
+    int length = snprintf(summary, sizeof(summary), "%lld matching line%s in %lld of %lld files, %.1f MB in %.2f s%s\r\n",
+                          (long long)stats.matches, stats.matches == 1 ? "" : "s", (long long)stats.filesMatched,
+                          (long long)stats.filesSearched, (double)stats.bytesSearched / (1024.0 * 1024.0), stats.seconds,
+                          stats.cancelled ? " - stopped" : "");
+    if (length > 0) {
+        AppendFindInFilesResults(summary, strlen(summary));
+    }
+    UpdateFindInFilesStatus(&stats, TRUE);
+}
+
+BOOL OpenFindInFilesResult(HWND editor, Sci_Position line)
+{
+    char text[MAX_PATH + 2];
+    struct Sci_TextRange tr;
+    
+    if (!editor || editor != GetFindInFilesResults(NULL)) {
         return FALSE;
     }
     
-    /* Get current tab */
-    int tabIndex = GetSelectedTab();
-    if (tabIndex < 0) {
+    /* Result lines are "\t<line number>: <text>" */
+    Sci_Position lineStart = (Sci_Position)SendMessage(editor, SCI_POSITIONFROMLINE, line, 0);
+    Sci_Position lineEnd = (Sci_Position)SendMessage(editor, SCI_GETLINEENDPOSITION, line, 0);
+    tr.chrg.cpMin = (Sci_PositionCR)lineStart;
+    tr.chrg.cpMax = (Sci_PositionCR)((lineEnd - lineStart < 24) ? lineEnd : lineStart + 24);
+    tr.lpstrText = text;
+    SendMessage(editor, SCI_GETTEXTRANGE, 0, (LPARAM)&tr);
+    char* end = NULL;
+    long lineNumber = (text[0] == '\t') ? strtol(text + 1, &end, 10) : 0;
+    if (lineNumber <= 0 || !end || *end != ':') {
         return FALSE;
     }
     
-    TabInfo* tab = GetTab(tabIndex);
-    if (!tab || !tab->editorHandle) {
+    /* The file is the closest line above that isn't a result */
+    Sci_Position header = line - 1;
+    while (header >= 0 && (char)SendMessage(editor, SCI_GETCHARAT, SendMessage(editor, SCI_POSITIONFROMLINE, header, 0), 0) == '\t') {
+        header--;
+    }
+    if (header < 0) {
+        return FALSE;
+    }
+    lineStart = (Sci_Position)SendMessage(editor, SCI_POSITIONFROMLINE, header, 0);
+    lineEnd = (Sci_Position)SendMessage(editor, SCI_GETLINEENDPOSITION, header, 0);
+    if (lineEnd - lineStart >= MAX_PATH) {
         return FALSE;
     }
+    tr.chrg.cpMin = (Sci_PositionCR)lineStart;
+    tr.chrg.cpMax = (Sci_PositionCR)lineEnd;
+    SendMessage(editor, SCI_GETTEXTRANGE, 0, (LPARAM)&tr);
     
-    HWND editor = tab->editorHandle;
+    /* Open the file, or go to its tab */
+    int index = -1;
+    int tabCount = GetTabCount();
+    for (int i = 0; i < tabCount; i++) {
+        TabInfo* tab = GetTab(i);
+        if (tab && _stricmp(tab->filePath, text) == 0) {
+            index = i;
+            break;
+        }
+    }
+    if (index < 0) {
+        if (GetFileAttributes(text) == INVALID_FILE_ATTRIBUTES) {
+            return FALSE;
+        }
+        index = AddNewTab(text);
+        if (index < 0) {
+            return FALSE;
+        }
+    }
+    SelectTab(index);
     
-    /* Set search flags */
+    TabInfo* tab = GetTab(index);
+    if (tab && tab->editorHandle) {
+        if (IsTabLoading(index)) {
+            /* Shown from there once the background load is done */
+            tab->sessionFirstLine = (int)(lineNumber - 1);
+        } else {
+            SendMessage(tab->editorHandle, SCI_ENSUREVISIBLEENFORCEPOLICY, lineNumber - 1, 0);
+            SendMessage(tab->editorHandle, SCI_GOTOLINE, lineNumber - 1, 0);
+        }
+        SetFocus(tab->editorHandle);
+    }
+    return TRUE;
+}
+
+void CreateFindControls(HWND hwnd) { UNREFERENCED_PARAMETER(hwnd); }
+void CreateReplaceControls(HWND hwnd) { UNREFERENCED_PARAMETER(hwnd); }
+
+/* Editor of the current tab */
+static HWND GetCurrentEditor(void)
+{
+    int tabIndex = GetSelectedTab();
+    if (tabIndex < 0) {
+        return NULL;
+    }
+    
+    TabInfo* tab = GetTab(tabIndex);
+    if (!tab || !tab->editorHandle) {
+        return NULL;
+    }
+    return tab->editorHandle;
+}
+
+/* Editor of the current tab, or NULL when there is nothing to search */
+static HWND GetSearchEditor(void)
+{
+    if (g_findReplace.findText[0] == '\0') {
+        return NULL;
+    }
+    return GetCurrentEditor();
+}
+
+/* Scintilla search flags for the current options. Regular expressions use the linear time
+ * engine so no pattern can take a search exponentially long. */
+static int GetSearchFlags(void)
+{
     int searchFlags = 0;
     if (g_findReplace.flags & 0x01) searchFlags |= SCFIND_MATCHCASE;
     if (g_findReplace.flags & 0x02) searchFlags |= SCFIND_WHOLEWORD;
-    if (g_findReplace.flags & 0x04) searchFlags |= SCFIND_REGEXP;
+    if (g_findReplace.flags & 0x04) searchFlags |= SCFIND_REGEXP | SCFIND_LINEARREGEX;
+    return searchFlags;
+}
+
+BOOL FindNext(void)
+{
+    HWND editor = GetSearchEditor();
+    if (!editor) {
+        return FALSE;
+    }
     
-    SendMessage(editor, SCI_SETSEARCHFLAGS, searchFlags, 0);
+    /* A large file is searched in the file rather than the page shown, in the background -
+     * the match is selected when the search ends */
+    LargeFile* largeFile = GetLargeFileForEditor(editor);
+    if (largeFile) {
+        return LargeFileFind(largeFile, g_findReplace.findText, GetSearchFlags(),
+                             g_findReplace.searchDirection == SEARCH_DIRECTION_DOWN) > 0;
+    }
+    
+    /* Set search flags */
+    SendMessage(editor, SCI_SETSEARCHFLAGS, GetSearchFlags(), 0);
     
     /* Get current position and selection */
     int currentPos = (int)SendMessage(editor, SCI_GETCURRENTPOS, 0, 0);
@@ -555,19 +1269,149 @@ BOOL FindPrevious(void)
     return result;
 }
 
-BOOL Replace(void) { return FALSE; }
-int ReplaceAll(void) { return 0; }
-int CountMatches(void) { return 0; }
+BOOL Replace(void)
+{
+    HWND editor = GetSearchEditor();
+    if (!editor || GetLargeFileForEditor(editor)) {
+        return FALSE;
+    }
+    
+    int searchFlags = GetSearchFlags();
+    SendMessage(editor, SCI_SETSEARCHFLAGS, searchFlags, 0);
+    
+    /* Replace the selection if it is an occurrence, then go on to the next one */
+    Sci_Position selStart = (Sci_Position)SendMessage(editor, SCI_GETSELECTIONSTART, 0, 0);
+    Sci_Position selEnd = (Sci_Position)SendMessage(editor, SCI_GETSELECTIONEND, 0, 0);
+    SendMessage(editor, SCI_SETTARGETRANGE, selStart, selEnd);
+    
+    BOOL replaced = FALSE;
+    Sci_Position pos = (Sci_Position)SendMessage(editor, SCI_SEARCHINTARGET, strlen(g_findReplace.findText),
+                                                 (LPARAM)g_findReplace.findText);
+    if (pos == selStart && (Sci_Position)SendMessage(editor, SCI_GETTARGETEND, 0, 0) == selEnd) {
+        SendMessage(editor, (searchFlags & SCFIND_REGEXP) ? SCI_REPLACETARGETRE : SCI_REPLACETARGET,
+                    (WPARAM)-1, (LPARAM)g_findReplace.replaceText);
+        Sci_Position end = (Sci_Position)SendMessage(editor, SCI_GETTARGETEND, 0, 0);
+        SendMessage(editor, SCI_SETSEL, end, end);
+        replaced = TRUE;
+    }
+    
+    FindNext();
+    return replaced;
+}
+
+int ReplaceAll(void)
+{
+    HWND editor = GetSearchEditor();
+    if (!editor || GetLargeFileForEditor(editor)) {
+        return 0;
+    }
+    
+    /* Scintilla finds every occurrence before replacing any, so replaced text is not
+     * searched again, and the replacements are undone as a single action */
+    SendMessage(editor, SCI_SETSEARCHFLAGS, GetSearchFlags(), 0);
+    SendMessage(editor, SCI_SETTARGETRANGE, 0, SendMessage(editor, SCI_GETLENGTH, 0, 0));
+    return (int)SendMessage(editor, SCI_REPLACEALLINTARGET, (WPARAM)g_findReplace.findText,
+                            (LPARAM)g_findReplace.replaceText);
+}
+
+int CountMatches(void)
+{
+    HWND editor = GetSearchEditor();
+    if (!editor) {
+        return 0;
+    }
+    
+    /* A large file is counted in the background and the count shown by FindAllDone */
+    LargeFile* largeFile = GetLargeFileForEditor(editor);
+    if (largeFile) {
+        return (LargeFileCountMatches(largeFile, g_findReplace.findText, GetSearchFlags()) < 0) ? -1 : 0;
+    }
+    
+    struct Sci_TextToFindAll fa;
+    fa.chrg.cpMin = 0;
+    fa.chrg.cpMax = (Sci_Position)SendMessage(editor, SCI_GETLENGTH, 0, 0);
+    fa.lpstrText = g_findReplace.findText;
+    fa.ranges = NULL;
+    fa.maxRanges = 0;
+    return (int)SendMessage(editor, SCI_FINDALL, GetSearchFlags(), (LPARAM)&fa);
+}
+
+BOOL FindAll(void)
+{
+    HWND editor = GetSearchEditor();
+    if (!editor) {
+        return FALSE;
+    }
+    
+    /* Matches are kept with the tab so the panel follows its edits and switches with it */
+    TabInfo* tab = GetTab(GetSelectedTab());
+    if (!tab->findResults) {
+        tab->findResults = CreateFindResults();
+        if (!tab->findResults) {
+            return FALSE;
+        }
+    }
+    ShowFindResultsPanel(TRUE);
+    BOOL searched = FindResultsSearch(tab->findResults, editor, g_findReplace.findText, GetSearchFlags());
+    UpdateFindResultsPanel();
+    return searched;
+}
+
+void FindAllDone(INT_PTR found)
+{
+    char status[64];
+    if (!g_findReplace.hwndFind) {
+        return;
+    }
+    if (found < 0) {
+        snprintf(status, sizeof(status), "Invalid regular expression.");
+    } else {
+        snprintf(status, sizeof(status), "%lld occurrence%s found.", (long long)found, found == 1 ? "" : "s");
+    }
+    SetDlgItemText(g_findReplace.hwndFind, IDC_FIND_COUNT, status);
+}
+
+void FindNextNotFound(HWND parent)
+{
+    /* Show it over the dialog the search was started from when that is still open */
+    HWND owner = parent;
+    if (g_findReplace.hwndFind && IsWindowVisible(g_findReplace.hwndFind)) {
+        owner = g_findReplace.hwndFind;
+    } else if (g_findReplace.hwndReplace && IsWindowVisible(g_findReplace.hwndReplace)) {
+        owner = g_findReplace.hwndReplace;
+    }
+    MessageBox(owner, "Cannot find the text specified.", "Find", MB_OK | MB_ICONINFORMATION);
+}
 
 void AddToSearchHistory(const char* text)
 {
     if (!text || text[0] == '\0') return;
-    for (int i = 0; i < g_searchHistoryCount; i++) {
-        if (strcmp(g_searchHistory[i], text) == 0) return;
+    
+    /* Most recent first - text searched for before moves back to the front */
+    int found = -1;
+    for (int i = 0; i < g_searchHistoryCount && found < 0; i++) {
+        if (strcmp(g_searchHistory[i], text) == 0) found = i;
     }
-    if (g_searchHistoryCount < MAX_SEARCH_HISTORY) {
-        g_searchHistory[g_searchHistoryCount++] = _strdup(text);
+    if (found == 0) return;
+    
+    char* entry;
+    if (found > 0) {
+        entry = g_searchHistory[found];
+    } else {
+        entry = _strdup(text);
+        if (!entry) return;
+        
+        /* A full history forgets its oldest search */
+        if (g_searchHistoryCount == MAX_SEARCH_HISTORY) {
+            free(g_searchHistory[--g_searchHistoryCount]);
+        }
+        found = g_searchHistoryCount++;
     }
+    memmove(&g_searchHistory[1], &g_searchHistory[0], (size_t)found * sizeof(char*));
+    g_searchHistory[0] = entry;
+    
+    FillSearchHistory(g_findReplace.hwndFind ? GetDlgItem(g_findReplace.hwndFind, IDC_FIND_COMBO) : NULL);
+    FillSearchHistory(g_findReplace.hwndReplace ? GetDlgItem(g_findReplace.hwndReplace, IDC_FIND_COMBO) : NULL);
 }
 
 void ClearSearchHistory(void)
@@ -576,6 +1420,9 @@ void ClearSearchHistory(void)
         if (g_searchHistory[i]) { free(g_searchHistory[i]); g_searchHistory[i] = NULL; }
     }
     g_searchHistoryCount = 0;
+    
+    FillSearchHistory(g_findReplace.hwndFind ? GetDlgItem(g_findReplace.hwndFind, IDC_FIND_COMBO) : NULL);
+    FillSearchHistory(g_findReplace.hwndReplace ? GetDlgItem(g_findReplace.hwndReplace, IDC_FIND_COMBO) : NULL);
 }
 
 const char* GetFindText(void) { return g_findReplace.findText; }
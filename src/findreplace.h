@@ -59,6 +59,38 @@ typedef sptr_t (*SciFnDirect)(sptr_t ptr, unsigned int iMessage, uptr_t wParam,
 #ifndef IDC_MARK_ALL
 #define IDC_MARK_ALL 1013
 #endif
+#ifndef IDC_FIND_ALL
+#define IDC_FIND_ALL 1022
+#endif
+#ifndef IDC_INCREMENTAL
+#define IDC_INCREMENTAL 1023
+#endif
+
+/* Find in Files dialog control IDs - the rest are shared with the find dialog */
+#ifndef IDC_FIF_FOLDER
+#define IDC_FIF_FOLDER 1015
+#endif
+#ifndef IDC_FIF_BROWSE
+#define IDC_FIF_BROWSE 1016
+#endif
+#ifndef IDC_FIF_INCLUDE
+#define IDC_FIF_INCLUDE 1017
+#endif
+#ifndef IDC_FIF_EXCLUDE
+#define IDC_FIF_EXCLUDE 1018
+#endif
+#ifndef IDC_FIF_REGEX
+#define IDC_FIF_REGEX 1019
+#endif
+#ifndef IDC_FIF_FIND_ALL
+#define IDC_FIF_FIND_ALL 1020
+#endif
+#ifndef IDC_FIF_STOP
+#define IDC_FIF_STOP 1021
+#endif
+
+/* Name of the tab Find in Files lists its results in */
+#define FINDINFILES_RESULTS_NAME "New Find Results"
 
 /* Search direction */
 typedef enum {
@@ -81,6 +113,7 @@ typedef struct {
     HWND hwndReplaceBtn;        /* Replace button */
     HWND hwndReplaceAll;        /* Replace All button */
     HWND hwndMarkAll;           /* Mark All button */
+    HWND hwndFindInFiles;       /* Find in Files dialog window */
     char findText[MAX_FIND_TEXT_LENGTH];
     char replaceText[MAX_REPLACE_TEXT_LENGTH];
     int flags;
@@ -94,6 +127,7 @@ void CleanupFindReplace(void);
 /* Dialog creation */
 BOOL ShowFindDialog(HWND parent);
 BOOL ShowReplaceDialog(HWND parent);
+BOOL ShowFindInFilesDialog(HWND parent);
 
 /* Control creation for dialogs */
 void CreateFindControls(HWND hwnd);
@@ -103,8 +137,26 @@ void CreateReplaceControls(HWND hwnd);
 BOOL FindNext(void);
 BOOL FindPrevious(void);
 BOOL Replace(void);
-int ReplaceAll(void);
-int CountMatches(void);
+int ReplaceAll(void);       /* Occurrences replaced, -1 for an invalid regular expression */
+int CountMatches(void);     /* Occurrences in the document, -1 for an invalid regular expression.
+                             * A large file is counted in the background - 0 is returned and the
+                             * count shown by FindAllDone. */
+BOOL FindAll(void);         /* Start listing the occurrences in the results panel - FALSE when nothing is searched */
+
+/* Show how many occurrences Find All listed, -1 for an invalid regular expression */
+void FindAllDone(INT_PTR found);
+
+/* Report a Find Next run in the background that found nothing - parent owns the message
+ * when no find dialog is open */
+void FindNextNotFound(HWND parent);
+
+/* Find in Files - WM_FINDINFILES_RESULTS and WM_FINDINFILES_DONE handlers */
+void FindInFilesResultsReady(WPARAM wParam, LPARAM lParam);
+void FindInFilesDone(WPARAM wParam, LPARAM lParam);
+
+/* Open the file and line of a Find in Files result line. Returns FALSE when editor
+ * isn't the results tab or the line isn't a result. */
+BOOL OpenFindInFilesResult(HWND editor, Sci_Position line);
 
 /* Search history */
 void AddToSearchHistory(const char* text);
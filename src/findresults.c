@@ -0,0 +1,1141 @@
+/*
+ * Find All results implementation for Notepad+
+ *
+ * Find Next steps through the matches of a search one at a time. Find All finds them
+ * all at once into a match index (see matchindex.c), a compact sorted list of match
+ * starts where match n is found in constant time, and lists them in a panel under
+ * the editor.
+ *
+ * The panel is a custom-drawn control like the tab bar and status bar. It only ever
+ * draws the rows on screen: each row's line number and text are fetched from the
+ * editor as it is painted, so ten million matches show as quickly as ten.
+ *
+ * The whole document is searched on a worker thread, over a copy of it taken with
+ * SCI_CREATESEARCHLOADER, so a search of a large file doesn't hold up the window and can be
+ * cancelled. Edits made meanwhile are noted and applied to the matches found when it ends.
+ *
+ * Edits move the matches after them straight away. The lines an edit touched are
+ * searched again from a timer, as a span that follows later edits the same way, so a
+ * burst of typing is searched once. Many edits at once, like a Replace All, mean the
+ * whole document is searched again instead of following each one.
+ */
+
+#include <windows.h>
+#include <windowsx.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "findresults.h"
+#include "matchindex.h"
+#include "findreplace.h"
+#include "Scintilla.h"
+#include "scintilla_bridge.h"
+#include "tabs.h"
+#include "themes.h"
+#include "window.h"
+
+/* Matches fetched per SCI_FINDALL call */
+#define FINDRESULTS_RANGES_CHUNK    4096
+
+/* Bytes of a piece table document copied for a search at a time */
+#define FINDRESULTS_COPY_CHUNK      (1024 * 1024)
+
+/* Text shown before a match that is far along its line (bytes) */
+#define FINDRESULTS_ROW_CONTEXT     60
+
+/* Longest text shown in a row (bytes) */
+#define FINDRESULTS_ROW_TEXT        400
+
+/* Window class name for the results panel */
+#define FINDRESULTS_CONTROL_CLASS_NAME "NotepadPlusFindResults"
+
+typedef struct FindResultsJob FindResultsJob;
+
+/* An edit made while the whole document was being searched - change is the length
+ * inserted, or minus the length deleted */
+typedef struct {
+    INT_PTR position;
+    INT_PTR change;
+} FindResultsEdit;
+
+struct FindResults {
+    MatchIndex* index;
+    char text[MAX_FIND_TEXT_LENGTH];  /* Text searched for, empty before the first search */
+    int searchFlags;
+    void* document;                   /* Scintilla document the matches belong to */
+    INT_PTR documentLength;           /* Its length as of the last change seen */
+    BOOL stale;                       /* Changes weren't followed - search the whole document again */
+    INT_PTR dirtyStart;               /* Lines changed since the last refresh, none when dirtyEnd <= dirtyStart */
+    INT_PTR dirtyEnd;
+    int edits;                        /* Changes followed since the last refresh */
+    size_t topRow;                    /* Match in the first row of the panel */
+    size_t selected;                  /* Match selected in the panel */
+    FindResultsJob* job;              /* Whole document search under way, NULL when there isn't one */
+    FindResultsEdit jobEdits[FINDRESULTS_MAX_EDITS];  /* Edits since it started */
+    int jobEditCount;
+    BOOL reportDone;                  /* Show the count in the find dialog when it ends */
+};
+
+/* Search of a copy of the whole document on a worker thread */
+struct FindResultsJob {
+    FindResultsJob* next;             /* Next unfinished job */
+    FindResults* results;             /* Results it's for, NULL once they don't want it */
+    HANDLE thread;
+    HWND notifyWindow;
+    void* loader;                     /* Copy of the document from SCI_CREATESEARCHLOADER */
+    char text[MAX_FIND_TEXT_LENGTH];
+    int searchFlags;
+    unsigned int threads;             /* Search threads, as the editor's SCI_GETSEARCHTHREADS */
+    volatile LONG cancelled;
+    MatchIndex* index;                /* Matches found, at positions in the copy */
+    INT_PTR found;                    /* Number found or LOADER_FIND_* */
+};
+
+/* Jobs whose WM_FINDRESULTS_DONE hasn't been handled yet */
+static FindResultsJob* g_findResultsJobs = NULL;
+
+/* Results panel state */
+typedef struct {
+    HWND hwnd;                        /* Panel window handle */
+    HWND parentWindow;                /* Parent window handle */
+    HFONT normalFont;                 /* Row font */
+    BOOL isVisible;                   /* Whether the panel is shown */
+    BOOL isCloseHovered;              /* Whether the close button is hovered */
+    int rowHeight;                    /* Height of the header and of each row */
+} FindResultsPanel;
+
+static FindResultsPanel g_findResultsPanel = {0};
+
+FindResults* CreateFindResults(void)
+{
+    FindResults* results = (FindResults*)calloc(1, sizeof(FindResults));
+    if (!results) {
+        return NULL;
+    }
+    results->index = CreateMatchIndex();
+    if (!results->index) {
+        free(results);
+        return NULL;
+    }
+    return results;
+}
+
+/* Stop the results' search - the job itself goes when its WM_FINDRESULTS_DONE is handled */
+static void CancelSearch(FindResults* results)
+{
+    if (results->job) {
+        InterlockedExchange(&results->job->cancelled, 1);
+        results->job->results = NULL;
+        results->job = NULL;
+    }
+}
+
+void FreeFindResults(FindResults* results)
+{
+    if (results) {
+        CancelSearch(results);
+        FreeMatchIndex(results->index);
+        free(results);
+    }
+}
+
+/* Add the matches from start to end to index. Returns how many were found or -1 for an
+ * invalid regular expression. Running out of memory ends the search early. */
+static INT_PTR FindRange(const FindResults* results, HWND editor, INT_PTR start, INT_PTR end, MatchIndex* index)
+{
+    struct Sci_CharacterRangeFull* ranges = (struct Sci_CharacterRangeFull*)malloc(
+        sizeof(struct Sci_CharacterRangeFull) * FINDRESULTS_RANGES_CHUNK);
+    if (!ranges) {
+        return 0;
+    }
+
+    struct Sci_TextToFindAll fa;
+    fa.chrg.cpMin = start;
+    fa.chrg.cpMax = end;
+    fa.lpstrText = results->text;
+    fa.ranges = ranges;
+    fa.maxRanges = FINDRESULTS_RANGES_CHUNK;
+
+    INT_PTR total = 0;
+    Sci_Position found;
+    do {
+        found = (Sci_Position)SendMessage(editor, SCI_FINDALL, results->searchFlags, (LPARAM)&fa);
+        if (found < 0) {
+            free(ranges);
+            return -1;
+        }
+        for (Sci_Position i = 0; i < found; i++) {
+            if (!MatchIndexAppend(index, ranges[i].cpMin)) {
+                free(ranges);
+                return total;
+            }
+            total++;
+        }
+        if (found > 0) {
+            /* Carry on after the last match, past it when it was empty */
+            struct Sci_CharacterRangeFull last = ranges[found - 1];
+            fa.chrg.cpMin = last.cpMax > last.cpMin ? last.cpMax :
+                            (Sci_Position)SendMessage(editor, SCI_POSITIONAFTER, last.cpMax, 0);
+        }
+    } while (found == FINDRESULTS_RANGES_CHUNK && fa.chrg.cpMin < end);
+
+    free(ranges);
+    return total;
+}
+
+static void FreeJob(FindResultsJob* job)
+{
+    if (job->thread) CloseHandle(job->thread);
+    LoaderRelease(job->loader);
+    FreeMatchIndex(job->index);
+    free(job);
+}
+
+/* Matches go into the job's index until memory runs out */
+static int AppendJobMatch(void* context, Sci_Position position)
+{
+    return MatchIndexAppend((MatchIndex*)context, position) ? 1 : 0;
+}
+
+static DWORD WINAPI FindResultsThreadProc(LPVOID param)
+{
+    FindResultsJob* job = (FindResultsJob*)param;
+    job->found = LoaderFindAll(job->loader, job->text, job->searchFlags, job->threads,
+                               &job->cancelled, AppendJobMatch, job->index);
+    PostMessage(job->notifyWindow, WM_FINDRESULTS_DONE, 0, (LPARAM)job);
+    return 0;
+}
+
+/* Copy a piece table document into a search loader a chunk at a time - reading it through
+ * SCI_GETRANGEPOINTER would join its pieces into a copy of the whole document first */
+static int CopyPiecesForSearch(HWND editor, void* loader, INT_PTR length)
+{
+    char* buffer = (char*)malloc(FINDRESULTS_COPY_CHUNK + 1);
+    if (!buffer) {
+        return LOADER_STATUS_BADALLOC;
+    }
+    int status = LOADER_STATUS_OK;
+    for (INT_PTR position = 0; position < length && status == LOADER_STATUS_OK; position += FINDRESULTS_COPY_CHUNK) {
+        struct Sci_TextRangeFull tr;
+        tr.chrg.cpMin = position;
+        tr.chrg.cpMax = (length - position > FINDRESULTS_COPY_CHUNK) ? position + FINDRESULTS_COPY_CHUNK : length;
+        tr.lpstrText = buffer;
+        SendMessage(editor, SCI_GETTEXTRANGEFULL, 0, (LPARAM)&tr);
+        status = LoaderAddData(loader, buffer, tr.chrg.cpMax - tr.chrg.cpMin);
+    }
+    free(buffer);
+    return status;
+}
+
+/* Copy the document into a search loader as it is now, reading either side of the gap
+ * so the copy doesn't move it */
+static void* CopyForSearch(HWND editor, INT_PTR length)
+{
+    void* loader = (void*)SendMessage(editor, SCI_CREATESEARCHLOADER, (WPARAM)length, 0);
+    if (!loader) {
+        return NULL;
+    }
+    int status = LOADER_STATUS_OK;
+    if (SendMessage(editor, SCI_GETDOCUMENTOPTIONS, 0, 0) & SC_DOCUMENTOPTION_TEXT_PIECES) {
+        status = CopyPiecesForSearch(editor, loader, length);
+    } else {
+        INT_PTR gap = (INT_PTR)SendMessage(editor, SCI_GETGAPPOSITION, 0, 0);
+        if (gap > 0) {
+            status = LoaderAddData(loader, (const char*)SendMessage(editor, SCI_GETRANGEPOINTER, 0, gap), gap);
+        }
+        if (status == LOADER_STATUS_OK && length > gap) {
+            status = LoaderAddData(loader, (const char*)SendMessage(editor, SCI_GETRANGEPOINTER, gap, length - gap),
+                                   length - gap);
+        }
+    }
+    if (status != LOADER_STATUS_OK) {
+        LoaderRelease(loader);
+        return NULL;
+    }
+    return loader;
+}
+
+/* Start searching a copy of the document on a worker thread */
+static BOOL StartSearch(FindResults* results, HWND editor)
+{
+    if (!g_findResultsPanel.parentWindow) {
+        return FALSE;
+    }
+    FindResultsJob* job = (FindResultsJob*)calloc(1, sizeof(FindResultsJob));
+    if (!job) {
+        return FALSE;
+    }
+    job->results = results;
+    job->notifyWindow = g_findResultsPanel.parentWindow;
+    strcpy(job->text, results->text);
+    job->searchFlags = results->searchFlags;
+    job->threads = (unsigned int)SendMessage(editor, SCI_GETSEARCHTHREADS, 0, 0);
+    job->index = CreateMatchIndex();
+    job->loader = job->index ? CopyForSearch(editor, results->documentLength) : NULL;
+    if (job->loader) {
+        job->thread = CreateThread(NULL, 0, FindResultsThreadProc, job, 0, NULL);
+    }
+    if (!job->thread) {
+        FreeJob(job);
+        return FALSE;
+    }
+    job->next = g_findResultsJobs;
+    g_findResultsJobs = job;
+    results->job = job;
+    results->jobEditCount = 0;
+    return TRUE;
+}
+
+/* Search the whole document again in place of the current matches. Searched here, rather
+ * than on a worker, only when the worker can't be started. */
+static void SearchDocument(FindResults* results, HWND editor)
+{
+    CancelSearch(results);
+    MatchIndexClear(results->index);
+    results->document = (void*)SendMessage(editor, SCI_GETDOCPOINTER, 0, 0);
+    results->documentLength = (INT_PTR)SendMessage(editor, SCI_GETLENGTH, 0, 0);
+    results->stale = FALSE;
+    results->dirtyStart = results->dirtyEnd = 0;
+    results->edits = 0;
+    if (!StartSearch(results, editor)) {
+        INT_PTR found = FindRange(results, editor, 0, results->documentLength, results->index);
+        if (results->reportDone) {
+            results->reportDone = FALSE;
+            FindAllDone(found);
+        }
+    }
+}
+
+BOOL FindResultsSearch(FindResults* results, HWND editor, const char* text, int searchFlags)
+{
+    if (!results || !editor || !text || strlen(text) >= MAX_FIND_TEXT_LENGTH) {
+        return FALSE;
+    }
+    strcpy(results->text, text);
+    results->searchFlags = searchFlags;
+    results->topRow = 0;
+    results->selected = 0;
+    results->reportDone = TRUE;
+    SearchDocument(results, editor);
+    return TRUE;
+}
+
+BOOL FindResultsIsSearching(const FindResults* results)
+{
+    return results && results->job;
+}
+
+/* Editor of the tab the results belong to */
+static HWND GetResultsEditor(const FindResults* results)
+{
+    int tabCount = GetTabCount();
+    for (int i = 0; i < tabCount; i++) {
+        TabInfo* tab = GetTab(i);
+        if (tab && tab->findResults == results) {
+            return tab->editorHandle;
+        }
+    }
+    return NULL;
+}
+
+/* Take a finished job off the list - FALSE when it isn't on it any more */
+static BOOL TakeJob(FindResultsJob* job)
+{
+    for (FindResultsJob** link = &g_findResultsJobs; *link; link = &(*link)->next) {
+        if (*link == job) {
+            *link = job->next;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* Start of the line holding position */
+static INT_PTR LineStartOf(HWND editor, INT_PTR position)
+{
+    INT_PTR line = (INT_PTR)SendMessage(editor, SCI_LINEFROMPOSITION, position, 0);
+    return (INT_PTR)SendMessage(editor, SCI_POSITIONFROMLINE, line, 0);
+}
+
+/* Start of the line after the one holding position, or the end of the document */
+static INT_PTR NextLineStartOf(HWND editor, INT_PTR position, INT_PTR documentLength)
+{
+    INT_PTR line = (INT_PTR)SendMessage(editor, SCI_LINEFROMPOSITION, position, 0);
+    INT_PTR lineCount = (INT_PTR)SendMessage(editor, SCI_GETLINECOUNT, 0, 0);
+    if (line + 1 >= lineCount) {
+        return documentLength;
+    }
+    return (INT_PTR)SendMessage(editor, SCI_POSITIONFROMLINE, line + 1, 0);
+}
+
+/* The matches are only valid for the document they were found in. A length that
+ * doesn't match means changes were missed, so the whole document is searched again. */
+static BOOL CheckDocument(FindResults* results, HWND editor)
+{
+    void* document = (void*)SendMessage(editor, SCI_GETDOCPOINTER, 0, 0);
+    INT_PTR documentLength = (INT_PTR)SendMessage(editor, SCI_GETLENGTH, 0, 0);
+    if (document != results->document || documentLength != results->documentLength) {
+        results->stale = TRUE;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* Put the matches a finished job found in place of the results' ones, moved by the edits made
+ * since the copy was taken. The lines those edits touched are still to be searched again. */
+static BOOL TakeJobMatches(FindResults* results, FindResultsJob* job)
+{
+    for (int i = 0; i < results->jobEditCount; i++) {
+        const FindResultsEdit* edit = &results->jobEdits[i];
+        INT_PTR end = edit->change > 0 ? edit->position : edit->position - edit->change;
+        if (!MatchIndexSplice(job->index, edit->position, end, edit->change, NULL, 0)) {
+            return FALSE;
+        }
+    }
+    MatchIndex* index = results->index;
+    results->index = job->index;
+    job->index = index;
+    return TRUE;
+}
+
+void FindResultsSearchDone(LPARAM lParam)
+{
+    FindResultsJob* job = (FindResultsJob*)lParam;
+    if (!TakeJob(job)) {
+        return;
+    }
+    WaitForSingleObject(job->thread, INFINITE);
+    FindResults* results = job->results;
+    HWND editor = results ? GetResultsEditor(results) : NULL;
+    if (results && editor) {
+        results->job = NULL;
+        BOOL invalid = job->found == LOADER_FIND_INVALID;
+        if (invalid) {
+            MatchIndexClear(results->index);
+            results->dirtyStart = results->dirtyEnd = 0;
+        } else if (results->stale || !CheckDocument(results, editor) || !TakeJobMatches(results, job)) {
+            /* The document changed too much to follow while it was searched */
+            results->stale = TRUE;
+        }
+        /* Search the lines edited meanwhile, or the whole document again when stale */
+        if (!invalid) {
+            FindResultsRefresh(results, editor);
+        }
+        if (results->reportDone && !results->job) {
+            results->reportDone = FALSE;
+            FindAllDone(invalid ? -1 : (INT_PTR)MatchIndexCount(results->index));
+        }
+        UpdateFindResultsPanel();
+    }
+    FreeJob(job);
+}
+
+void FinishAllFindResults(void)
+{
+    while (g_findResultsJobs) {
+        FindResultsJob* job = g_findResultsJobs;
+        g_findResultsJobs = job->next;
+        InterlockedExchange(&job->cancelled, 1);
+        WaitForSingleObject(job->thread, INFINITE);
+        if (job->results) {
+            job->results->job = NULL;
+        }
+        FreeJob(job);
+    }
+}
+
+void FindResultsNoteModification(FindResults* results, HWND editor, int modificationType,
+                                 INT_PTR position, INT_PTR length)
+{
+    if (!results || !editor || results->text[0] == '\0' || results->stale ||
+        !(modificationType & (SC_MOD_INSERTTEXT | SC_MOD_DELETETEXT))) {
+        return;
+    }
+    BOOL inserted = (modificationType & SC_MOD_INSERTTEXT) != 0;
+    results->documentLength += inserted ? length : -length;
+    if (!CheckDocument(results, editor)) {
+        return;
+    }
+    if (++results->edits > FINDRESULTS_MAX_EDITS) {
+        results->stale = TRUE;
+        return;
+    }
+    if (results->job) {
+        if (results->jobEditCount >= FINDRESULTS_MAX_EDITS) {
+            results->stale = TRUE;
+            return;
+        }
+        results->jobEdits[results->jobEditCount].position = position;
+        results->jobEdits[results->jobEditCount].change = inserted ? length : -length;
+        results->jobEditCount++;
+    }
+
+    /* Matches in deleted text go, the ones after the change move with the text */
+    INT_PTR changeEnd = inserted ? position : position + length;
+    if (!MatchIndexSplice(results->index, position, changeEnd, inserted ? length : -length, NULL, 0)) {
+        results->stale = TRUE;
+        return;
+    }
+
+    /* The lines changed before move with the text too */
+    if (results->dirtyEnd > results->dirtyStart) {
+        if (inserted) {
+            if (results->dirtyStart >= position) {
+                results->dirtyStart += length;
+            }
+            if (results->dirtyEnd > position) {
+                results->dirtyEnd += length;
+            }
+        } else {
+            results->dirtyStart = results->dirtyStart <= position ? results->dirtyStart :
+                                  (results->dirtyStart >= changeEnd ? results->dirtyStart - length : position);
+            results->dirtyEnd = results->dirtyEnd <= position ? results->dirtyEnd :
+                                (results->dirtyEnd >= changeEnd ? results->dirtyEnd - length : position);
+        }
+    }
+
+    /* Add the lines this change touched, which may join or split matches. A search for
+     * text typed into the find box can't cross a line end, so no match outside them can. */
+    INT_PTR start = LineStartOf(editor, position);
+    INT_PTR end = NextLineStartOf(editor, inserted ? position + length : position, results->documentLength);
+    if (results->dirtyEnd <= results->dirtyStart) {
+        results->dirtyStart = start;
+        results->dirtyEnd = end;
+    } else {
+        if (start < results->dirtyStart) {
+            results->dirtyStart = start;
+        }
+        if (end > results->dirtyEnd) {
+            results->dirtyEnd = end;
+        }
+    }
+}
+
+BOOL FindResultsRefresh(FindResults* results, HWND editor)
+{
+    if (!results || !editor || results->text[0] == '\0' || results->job) {
+        return FALSE;
+    }
+    /* A document replaced or changed without the changes being seen, as by a reload */
+    if (!results->stale) {
+        CheckDocument(results, editor);
+    }
+    if (results->stale) {
+        SearchDocument(results, editor);
+        return TRUE;
+    }
+    if (results->dirtyEnd <= results->dirtyStart) {
+        return FALSE;
+    }
+
+    /* Replace the matches in the changed lines with the ones found there now */
+    MatchIndex* found = CreateMatchIndex();
+    INT_PTR count = found ? FindRange(results, editor, results->dirtyStart, results->dirtyEnd, found) : -1;
+    INT_PTR* positions = count > 0 ? (INT_PTR*)malloc((size_t)count * sizeof(INT_PTR)) : NULL;
+    if (count < 0 || (count > 0 && !positions)) {
+        free(positions);
+        FreeMatchIndex(found);
+        SearchDocument(results, editor);
+        return TRUE;
+    }
+    for (INT_PTR i = 0; i < count; i++) {
+        positions[i] = MatchIndexAt(found, (size_t)i);
+    }
+    if (!MatchIndexSplice(results->index, results->dirtyStart, results->dirtyEnd, 0, positions, (size_t)count)) {
+        SearchDocument(results, editor);
+    } else {
+        results->dirtyStart = results->dirtyEnd = 0;
+        results->edits = 0;
+    }
+    free(positions);
+    FreeMatchIndex(found);
+    return TRUE;
+}
+
+size_t FindResultsCount(const FindResults* results)
+{
+    return results ? MatchIndexCount(results->index) : 0;
+}
+
+/* End of the match starting at position, or position when there isn't one there now */
+static INT_PTR MatchEnd(const FindResults* results, HWND editor, INT_PTR position, INT_PTR lineEnd)
+{
+    struct Sci_TextToFindFull ft;
+    ft.chrg.cpMin = position;
+    ft.chrg.cpMax = lineEnd;
+    ft.lpstrText = results->text;
+    if ((INT_PTR)SendMessage(editor, SCI_FINDTEXTFULL, results->searchFlags, (LPARAM)&ft) != position) {
+        return position;
+    }
+    return ft.chrgText.cpMax;
+}
+
+BOOL FindResultsGoTo(const FindResults* results, HWND editor, size_t n)
+{
+    if (!results || !editor || n >= MatchIndexCount(results->index)) {
+        return FALSE;
+    }
+    INT_PTR position = MatchIndexAt(results->index, n);
+    INT_PTR line = (INT_PTR)SendMessage(editor, SCI_LINEFROMPOSITION, position, 0);
+    INT_PTR lineEnd = (INT_PTR)SendMessage(editor, SCI_GETLINEENDPOSITION, line, 0);
+
+    SendMessage(editor, SCI_ENSUREVISIBLE, line, 0);
+    SendMessage(editor, SCI_SETSEL, position, MatchEnd(results, editor, position, lineEnd));
+    SendMessage(editor, SCI_SCROLLCARET, 0, 0);
+    return TRUE;
+}
+
+/* Results of the selected tab and its editor, NULL when it has none */
+static FindResults* GetShownResults(HWND* editor)
+{
+    int tabIndex = GetSelectedTab();
+    TabInfo* tab = tabIndex >= 0 ? GetTab(tabIndex) : NULL;
+    if (!tab || !tab->editorHandle || !tab->findResults) {
+        return NULL;
+    }
+    *editor = tab->editorHandle;
+    return tab->findResults;
+}
+
+/* Rows that fit in the panel below its header, counting a row cut off at the bottom */
+static size_t GetRowsOnScreen(BOOL partial)
+{
+    RECT rc;
+    GetClientRect(g_findResultsPanel.hwnd, &rc);
+    int height = rc.bottom - g_findResultsPanel.rowHeight;
+    if (height <= 0) {
+        return 0;
+    }
+    return (size_t)((height + (partial ? g_findResultsPanel.rowHeight - 1 : 0)) / g_findResultsPanel.rowHeight);
+}
+
+/* Keep the selection and first row inside the results and the selection on screen */
+static void ClampRows(FindResults* results, BOOL showSelected)
+{
+    size_t count = MatchIndexCount(results->index);
+    size_t rows = GetRowsOnScreen(FALSE);
+    if (rows == 0) {
+        rows = 1;
+    }
+    if (results->selected >= count) {
+        results->selected = count ? count - 1 : 0;
+    }
+    if (showSelected) {
+        if (results->selected < results->topRow) {
+            results->topRow = results->selected;
+        } else if (results->selected >= results->topRow + rows) {
+            results->topRow = results->selected - rows + 1;
+        }
+    }
+    size_t maxTop = count > rows ? count - rows : 0;
+    if (results->topRow > maxTop) {
+        results->topRow = maxTop;
+    }
+}
+
+/* Scroll bar range and position for the shown results */
+static void UpdateScrollBar(const FindResults* results)
+{
+    size_t count = results ? MatchIndexCount(results->index) : 0;
+    SCROLLINFO si;
+    si.cbSize = sizeof(SCROLLINFO);
+    si.fMask = SIF_RANGE | SIF_PAGE | SIF_POS;
+    si.nMin = 0;
+    si.nMax = count == 0 ? 0 : (count - 1 > INT_MAX ? INT_MAX : (int)(count - 1));
+    si.nPage = (UINT)GetRowsOnScreen(FALSE);
+    si.nPos = results ? (results->topRow > INT_MAX ? INT_MAX : (int)results->topRow) : 0;
+    SetScrollInfo(g_findResultsPanel.hwnd, SB_VERT, &si, TRUE);
+}
+
+void UpdateFindResultsPanel(void)
+{
+    if (!g_findResultsPanel.hwnd || !g_findResultsPanel.isVisible) {
+        return;
+    }
+    HWND editor = NULL;
+    FindResults* results = GetShownResults(&editor);
+    if (results) {
+        ClampRows(results, FALSE);
+    }
+    UpdateScrollBar(results);
+    InvalidateRect(g_findResultsPanel.hwnd, NULL, FALSE);
+}
+
+/* Select match n, show it in the editor and keep it on screen in the panel */
+static void SelectRow(FindResults* results, HWND editor, size_t n)
+{
+    results->selected = n;
+    ClampRows(results, TRUE);
+    FindResultsGoTo(results, editor, results->selected);
+    UpdateScrollBar(results);
+    InvalidateRect(g_findResultsPanel.hwnd, NULL, FALSE);
+}
+
+/* Initialize the results panel */
+BOOL InitializeFindResultsPanel(HWND parentWindow)
+{
+    WNDCLASSEX wc;
+
+    memset(&g_findResultsPanel, 0, sizeof(FindResultsPanel));
+    g_findResultsPanel.parentWindow = parentWindow;
+
+    /* Register results panel window class */
+    wc.cbSize = sizeof(WNDCLASSEX);
+    wc.style = CS_HREDRAW | CS_VREDRAW | CS_DBLCLKS;
+    wc.lpfnWndProc = FindResultsPanelWndProc;
+    wc.cbClsExtra = 0;
+    wc.cbWndExtra = sizeof(FindResultsPanel*);
+    wc.hInstance = GetModuleHandle(NULL);
+    wc.hIcon = NULL;
+    wc.hCursor = LoadCursor(NULL, IDC_ARROW);
+    wc.hbrBackground = NULL;
+    wc.lpszMenuName = NULL;
+    wc.lpszClassName = FINDRESULTS_CONTROL_CLASS_NAME;
+    wc.hIconSm = NULL;
+
+    if (!RegisterClassEx(&wc)) {
+        return FALSE;
+    }
+
+    /* Create the panel hidden - Find All shows it */
+    g_findResultsPanel.hwnd = CreateWindowEx(
+        0,
+        FINDRESULTS_CONTROL_CLASS_NAME,
+        "",
+        WS_CHILD | WS_CLIPSIBLINGS | WS_VSCROLL,
+        0, 0, 0, 0,
+        parentWindow,
+        NULL,
+        GetModuleHandle(NULL),
+        NULL
+    );
+
+    if (!g_findResultsPanel.hwnd) {
+        return FALSE;
+    }
+
+    /* Store panel pointer in window data */
+    SetWindowLongPtr(g_findResultsPanel.hwnd, 0, (LONG_PTR)&g_findResultsPanel);
+
+    /* Rows are as high as the font with a little room around it */
+    g_findResultsPanel.normalFont = (HFONT)GetStockObject(DEFAULT_GUI_FONT);
+    HDC hdc = GetDC(g_findResultsPanel.hwnd);
+    HFONT oldFont = SelectObject(hdc, g_findResultsPanel.normalFont);
+    TEXTMETRIC tm;
+    GetTextMetrics(hdc, &tm);
+    SelectObject(hdc, oldFont);
+    ReleaseDC(g_findResultsPanel.hwnd, hdc);
+    g_findResultsPanel.rowHeight = tm.tmHeight + 4;
+    if (g_findResultsPanel.rowHeight < CLOSE_BUTTON_SIZE + 2) {
+        g_findResultsPanel.rowHeight = CLOSE_BUTTON_SIZE + 2;
+    }
+
+    return TRUE;
+}
+
+/* Cleanup the results panel */
+void CleanupFindResultsPanel(void)
+{
+    if (g_findResultsPanel.hwnd) {
+        DestroyWindow(g_findResultsPanel.hwnd);
+    }
+
+    UnregisterClass(FINDRESULTS_CONTROL_CLASS_NAME, GetModuleHandle(NULL));
+
+    memset(&g_findResultsPanel, 0, sizeof(FindResultsPanel));
+}
+
+void ShowFindResultsPanel(BOOL show)
+{
+    if (!g_findResultsPanel.hwnd || g_findResultsPanel.isVisible == show) {
+        return;
+    }
+    g_findResultsPanel.isVisible = show;
+    ShowWindow(g_findResultsPanel.hwnd, show ? SW_SHOW : SW_HIDE);
+    HandleWindowResize(0, 0);
+    UpdateFindResultsPanel();
+}
+
+BOOL IsFindResultsPanelVisible(void)
+{
+    return g_findResultsPanel.isVisible;
+}
+
+void ResizeFindResultsPanel(int width, int yPosition)
+{
+    if (g_findResultsPanel.hwnd) {
+        SetWindowPos(g_findResultsPanel.hwnd, NULL, 0, yPosition, width, GetFindResultsPanelHeight(),
+                     SWP_NOZORDER | SWP_NOACTIVATE);
+    }
+}
+
+int GetFindResultsPanelHeight(void)
+{
+    return FINDRESULTS_PANEL_HEIGHT;
+}
+
+/* Close button position in the header */
+static void GetCloseButtonRect(RECT* rect)
+{
+    RECT rc;
+    GetClientRect(g_findResultsPanel.hwnd, &rc);
+    rect->left = rc.right - CLOSE_BUTTON_SIZE - 4;
+    rect->top = (g_findResultsPanel.rowHeight - CLOSE_BUTTON_SIZE) / 2;
+    rect->right = rect->left + CLOSE_BUTTON_SIZE;
+    rect->bottom = rect->top + CLOSE_BUTTON_SIZE;
+}
+
+/* Draw UTF-8 text and return how wide it was */
+static int DrawUtf8Text(HDC hdc, int x, int y, const char* text, int length)
+{
+    WCHAR wide[FINDRESULTS_ROW_TEXT + MAX_FIND_TEXT_LENGTH + 64];
+    int wideLength = length > 0 ? MultiByteToWideChar(CP_UTF8, 0, text, length, wide,
+                                                      (int)(sizeof(wide) / sizeof(wide[0]))) : 0;
+    if (wideLength <= 0) {
+        return 0;
+    }
+    SIZE size;
+    TextOutW(hdc, x, y, wide, wideLength);
+    GetTextExtentPoint32W(hdc, wide, wideLength, &size);
+    return size.cx;
+}
+
+/* Draw the header: what was searched for, how many matches and the close button */
+static void DrawHeader(HDC hdc, const RECT* rect, const FindResults* results)
+{
+    ThemeColors* colors = GetThemeColors();
+    RECT header = { rect->left, rect->top, rect->right, rect->top + g_findResultsPanel.rowHeight };
+
+    HBRUSH bgBrush = CreateSolidBrush(colors->statusbarBg);
+    FillRect(hdc, &header, bgBrush);
+    DeleteObject(bgBrush);
+
+    HPEN borderPen = CreatePen(PS_SOLID, 1, colors->statusbarBorder);
+    HPEN oldPen = SelectObject(hdc, borderPen);
+    MoveToEx(hdc, header.left, header.top, NULL);
+    LineTo(hdc, header.right, header.top);
+    MoveToEx(hdc, header.left, header.bottom - 1, NULL);
+    LineTo(hdc, header.right, header.bottom - 1);
+    SelectObject(hdc, oldPen);
+    DeleteObject(borderPen);
+
+    char title[MAX_FIND_TEXT_LENGTH + 96];
+    if (results && results->text[0]) {
+        size_t count = MatchIndexCount(results->index);
+        snprintf(title, sizeof(title), "Find All: \"%s\" - %llu match%s%s", results->text,
+                 (unsigned long long)count, count == 1 ? "" : "es",
+                 results->job ? " (searching)" :
+                 (results->stale || results->dirtyEnd > results->dirtyStart) ? " (updating)" : "");
+    } else {
+        snprintf(title, sizeof(title), "Find All: no results for this document");
+    }
+    SetTextColor(hdc, colors->statusbarFg);
+    SetBkMode(hdc, TRANSPARENT);
+    DrawUtf8Text(hdc, header.left + 6, header.top + 2, title, (int)strlen(title));
+
+    RECT closeRect;
+    GetCloseButtonRect(&closeRect);
+    DrawCloseButton(hdc, closeRect.left, closeRect.top, g_findResultsPanel.isCloseHovered, TRUE);
+}
+
+/* Draw the row of match n: its line number, then the line with the match marked */
+static void DrawRow(HDC hdc, const RECT* row, const FindResults* results, HWND editor, size_t n,
+                    int gutterWidth, BOOL isSelected)
+{
+    ThemeColors* colors = GetThemeColors();
+    HBRUSH bgBrush = CreateSolidBrush(isSelected ? colors->editorCaretLineBg : colors->editorBg);
+    FillRect(hdc, row, bgBrush);
+    DeleteObject(bgBrush);
+
+    INT_PTR position = MatchIndexAt(results->index, n);
+    INT_PTR line = (INT_PTR)SendMessage(editor, SCI_LINEFROMPOSITION, position, 0);
+    INT_PTR lineStart = (INT_PTR)SendMessage(editor, SCI_POSITIONFROMLINE, line, 0);
+    INT_PTR lineEnd = (INT_PTR)SendMessage(editor, SCI_GETLINEENDPOSITION, line, 0);
+    int y = row->top + 2;
+
+    char number[32];
+    snprintf(number, sizeof(number), "%lld:", (long long)line + 1);
+    SetBkMode(hdc, TRANSPARENT);
+    SetTextColor(hdc, colors->editorLineNumFg);
+    TextOut(hdc, row->left + 6, y, number, (int)strlen(number));
+
+    /* Only the part of a long line around the match, starting on a character */
+    INT_PTR textStart = lineStart;
+    if (position - lineStart > FINDRESULTS_ROW_CONTEXT) {
+        textStart = (INT_PTR)SendMessage(editor, SCI_POSITIONBEFORE, position - FINDRESULTS_ROW_CONTEXT + 1, 0);
+    }
+    INT_PTR textEnd = lineEnd;
+    if (textEnd - textStart > FINDRESULTS_ROW_TEXT) {
+        textEnd = (INT_PTR)SendMessage(editor, SCI_POSITIONBEFORE, textStart + FINDRESULTS_ROW_TEXT + 1, 0);
+    }
+    INT_PTR matchEnd = MatchEnd(results, editor, position, lineEnd);
+    if (matchEnd > textEnd) {
+        matchEnd = textEnd;
+    }
+    if (position > textEnd) {
+        return;
+    }
+
+    char text[FINDRESULTS_ROW_TEXT + 1];
+    struct Sci_TextRangeFull tr;
+    tr.chrg.cpMin = textStart;
+    tr.chrg.cpMax = textEnd;
+    tr.lpstrText = text;
+    SendMessage(editor, SCI_GETTEXTRANGEFULL, 0, (LPARAM)&tr);
+    int length = (int)(textEnd - textStart);
+    for (int i = 0; i < length; i++) {
+        if ((unsigned char)text[i] < ' ') {
+            text[i] = ' ';
+        }
+    }
+
+    /* Leading indentation takes up room without telling anything */
+    int skip = 0;
+    if (textStart == lineStart) {
+        while (skip < (int)(position - textStart) && text[skip] == ' ') {
+            skip++;
+        }
+    }
+    int matchOffset = (int)(position - textStart);
+    int matchLength = (int)(matchEnd - position);
+
+    int x = row->left + gutterWidth;
+    SetTextColor(hdc, colors->editorFg);
+    x += DrawUtf8Text(hdc, x, y, text + skip, matchOffset - skip);
+    if (matchLength > 0) {
+        SetBkMode(hdc, OPAQUE);
+        SetBkColor(hdc, colors->editorSelBg);
+        SetTextColor(hdc, colors->editorSelFg);
+        x += DrawUtf8Text(hdc, x, y, text + matchOffset, matchLength);
+        SetBkMode(hdc, TRANSPARENT);
+        SetTextColor(hdc, colors->editorFg);
+    }
+    DrawUtf8Text(hdc, x, y, text + matchOffset + matchLength, length - matchOffset - matchLength);
+}
+
+/* Draw the panel - only the rows on screen are drawn however many matches there are */
+static void DrawFindResultsPanel(HDC hdc, const RECT* rect)
+{
+    ThemeColors* colors = GetThemeColors();
+    HWND editor = NULL;
+    FindResults* results = GetShownResults(&editor);
+
+    HBRUSH bgBrush = CreateSolidBrush(colors->editorBg);
+    FillRect(hdc, rect, bgBrush);
+    DeleteObject(bgBrush);
+
+    HFONT oldFont = SelectObject(hdc, g_findResultsPanel.normalFont);
+    DrawHeader(hdc, rect, results);
+
+    size_t count = results ? MatchIndexCount(results->index) : 0;
+    if (count > 0) {
+        /* Line numbers get room for the document's last line */
+        char widest[32];
+        SIZE size;
+        snprintf(widest, sizeof(widest), "%lld: ", (long long)SendMessage(editor, SCI_GETLINECOUNT, 0, 0));
+        GetTextExtentPoint32(hdc, widest, (int)strlen(widest), &size);
+        int gutterWidth = size.cx + 12;
+
+        size_t rows = GetRowsOnScreen(TRUE);
+        for (size_t i = 0; i < rows && results->topRow + i < count; i++) {
+            size_t n = results->topRow + i;
+            RECT row;
+            row.left = rect->left;
+            row.right = rect->right;
+            row.top = rect->top + g_findResultsPanel.rowHeight * (int)(i + 1);
+            row.bottom = row.top + g_findResultsPanel.rowHeight;
+            DrawRow(hdc, &row, results, editor, n, gutterWidth, n == results->selected);
+        }
+    }
+
+    SelectObject(hdc, oldFont);
+}
+
+/* Scroll so match top is in the first row */
+static void ScrollToRow(FindResults* results, size_t top)
+{
+    results->topRow = top;
+    ClampRows(results, FALSE);
+    UpdateScrollBar(results);
+    InvalidateRect(g_findResultsPanel.hwnd, NULL, FALSE);
+}
+
+/* Match in the row at y, FALSE in the header or below the last match */
+static BOOL HitTestRow(const FindResults* results, int y, size_t* n)
+{
+    if (!results || y < g_findResultsPanel.rowHeight) {
+        return FALSE;
+    }
+    size_t row = results->topRow + (size_t)((y - g_findResultsPanel.rowHeight) / g_findResultsPanel.rowHeight);
+    if (row >= MatchIndexCount(results->index)) {
+        return FALSE;
+    }
+    *n = row;
+    return TRUE;
+}
+
+/* Results panel window procedure */
+LRESULT CALLBACK FindResultsPanelWndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    HWND editor = NULL;
+    FindResults* results = GetShownResults(&editor);
+
+    switch (uMsg) {
+        case WM_PAINT:
+            {
+                PAINTSTRUCT ps;
+                HDC hdc = BeginPaint(hwnd, &ps);
+                RECT rc;
+                GetClientRect(hwnd, &rc);
+
+                /* Drawn off screen first so scrolling through rows doesn't flicker */
+                HDC memDC = CreateCompatibleDC(hdc);
+                HBITMAP bitmap = CreateCompatibleBitmap(hdc, rc.right, rc.bottom);
+                HBITMAP oldBitmap = SelectObject(memDC, bitmap);
+                DrawFindResultsPanel(memDC, &rc);
+                BitBlt(hdc, 0, 0, rc.right, rc.bottom, memDC, 0, 0, SRCCOPY);
+                SelectObject(memDC, oldBitmap);
+                DeleteObject(bitmap);
+                DeleteDC(memDC);
+
+                EndPaint(hwnd, &ps);
+                return 0;
+            }
+
+        case WM_VSCROLL:
+            if (results) {
+                size_t page = GetRowsOnScreen(FALSE);
+                size_t top = results->topRow;
+                switch (LOWORD(wParam)) {
+                    case SB_LINEUP:     top = top > 0 ? top - 1 : 0; break;
+                    case SB_LINEDOWN:   top++; break;
+                    case SB_PAGEUP:     top = top > page ? top - page : 0; break;
+                    case SB_PAGEDOWN:   top += page; break;
+                    case SB_TOP:        top = 0; break;
+                    case SB_BOTTOM:     top = MatchIndexCount(results->index); break;
+                    case SB_THUMBTRACK:
+                    case SB_THUMBPOSITION:
+                        {
+                            /* The 16-bit position in wParam isn't enough for long lists */
+                            SCROLLINFO si;
+                            si.cbSize = sizeof(SCROLLINFO);
+                            si.fMask = SIF_TRACKPOS;
+                            GetScrollInfo(hwnd, SB_VERT, &si);
+                            top = (size_t)si.nTrackPos;
+                        }
+                        break;
+                }
+                ScrollToRow(results, top);
+            }
+            return 0;
+
+        case WM_MOUSEWHEEL:
+            if (results) {
+                int lines = -GET_WHEEL_DELTA_WPARAM(wParam) * 3 / WHEEL_DELTA;
+                size_t top = results->topRow;
+                if (lines < 0) {
+                    top = top > (size_t)-lines ? top - (size_t)-lines : 0;
+                } else {
+                    top += (size_t)lines;
+                }
+                ScrollToRow(results, top);
+            }
+            return 0;
+
+        case WM_KEYDOWN:
+            if (wParam == VK_ESCAPE) {
+                ShowFindResultsPanel(FALSE);
+                if (editor) {
+                    SetFocus(editor);
+                }
+                return 0;
+            }
+            if (results && MatchIndexCount(results->index) > 0) {
+                size_t count = MatchIndexCount(results->index);
+                size_t page = GetRowsOnScreen(FALSE);
+                size_t n = results->selected;
+                switch (wParam) {
+                    case VK_UP:     n = n > 0 ? n - 1 : 0; break;
+                    case VK_DOWN:   n = n + 1 < count ? n + 1 : n; break;
+                    case VK_PRIOR:  n = n > page ? n - page : 0; break;
+                    case VK_NEXT:   n = n + page < count ? n + page : count - 1; break;
+                    case VK_HOME:   n = 0; break;
+                    case VK_END:    n = count - 1; break;
+                    case VK_RETURN:
+                        FindResultsGoTo(results, editor, results->selected);
+                        SetFocus(editor);
+                        return 0;
+                    default:
+                        return 0;
+                }
+                SelectRow(results, editor, n);
+            }
+            return 0;
+
+        case WM_LBUTTONDOWN:
+        case WM_LBUTTONDBLCLK:
+            {
+                int x = GET_X_LPARAM(lParam);
+                int y = GET_Y_LPARAM(lParam);
+                RECT closeRect;
+                POINT pt = { x, y };
+                size_t n;
+                GetCloseButtonRect(&closeRect);
+                SetFocus(hwnd);
+                if (PtInRect(&closeRect, pt)) {
+                    ShowFindResultsPanel(FALSE);
+                    if (editor) {
+                        SetFocus(editor);
+                    }
+                } else if (HitTestRow(results, y, &n)) {
+                    SelectRow(results, editor, n);
+                    /* A double-click goes on to edit at the match */
+                    if (uMsg == WM_LBUTTONDBLCLK) {
+                        SetFocus(editor);
+                    }
+                }
+                return 0;
+            }
+
+        case WM_MOUSEMOVE:
+            {
+                RECT closeRect;
+                POINT pt = { GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };
+                GetCloseButtonRect(&closeRect);
+                BOOL hovered = PtInRect(&closeRect, pt);
+                if (hovered != g_findResultsPanel.isCloseHovered) {
+                    g_findResultsPanel.isCloseHovered = hovered;
+                    InvalidateRect(hwnd, &closeRect, FALSE);
+                    if (hovered) {
+                        TRACKMOUSEEVENT tme;
+                        tme.cbSize = sizeof(TRACKMOUSEEVENT);
+                        tme.dwFlags = TME_LEAVE;
+                        tme.hwndTrack = hwnd;
+                        tme.dwHoverTime = 0;
+                        TrackMouseEvent(&tme);
+                    }
+                }
+                return 0;
+            }
+
+        case WM_MOUSELEAVE:
+            if (g_findResultsPanel.isCloseHovered) {
+                RECT closeRect;
+                GetCloseButtonRect(&closeRect);
+                g_findResultsPanel.isCloseHovered = FALSE;
+                InvalidateRect(hwnd, &closeRect, FALSE);
+            }
+            return 0;
+
+        case WM_SIZE:
+            UpdateFindResultsPanel();
+            return 0;
+
+        case WM_ERASEBKGND:
+            return 1;  /* Handle in WM_PAINT */
+
+        default:
+            return DefWindowProc(hwnd, uMsg, wParam, lParam);
+    }
+}
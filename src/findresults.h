@@ -0,0 +1,79 @@
+/*
+ * Find All results header for Notepad+
+ * Every match of a search in a document, kept up to date as it is edited, and the
+ * panel under the editor that lists them
+ */
+
+#ifndef FINDRESULTS_H
+#define FINDRESULTS_H
+
+#include <windows.h>
+
+/* Height of the results panel (pixels) */
+#define FINDRESULTS_PANEL_HEIGHT        180
+
+/* Interval after an edit before the lines it touched are searched again (milliseconds) */
+#define FINDRESULTS_REFRESH_INTERVAL    100
+
+/* Edits followed one by one between refreshes - after more the whole document is searched again */
+#define FINDRESULTS_MAX_EDITS           64
+
+/* Posted when a search of the whole document on a worker thread ends - lParam is the search */
+#define WM_FINDRESULTS_DONE             (WM_APP + 8)
+
+typedef struct FindResults FindResults;
+
+/* Results creation - new results have no search and no matches */
+FindResults* CreateFindResults(void);
+void FreeFindResults(FindResults* results);
+
+/* Find every match of text in an editor's document in place of the previous results.
+ * A copy of the document is searched on a worker thread - the matches appear, and FindAllDone
+ * is called with their number or -1 for an invalid regular expression, when it ends.
+ * Returns FALSE when nothing was searched. */
+BOOL FindResultsSearch(FindResults* results, HWND editor, const char* text, int searchFlags);
+
+/* Whether the whole document is being searched */
+BOOL FindResultsIsSearching(const FindResults* results);
+
+/* WM_FINDRESULTS_DONE handler - ignores searches cancelled since posting */
+void FindResultsSearchDone(LPARAM lParam);
+
+/* Cancel every search still running and wait for it - call before the window goes away */
+void FinishAllFindResults(void);
+
+/* Keep the results in step with the document - call for every SCN_MODIFIED of the editor
+ * with SC_MOD_INSERTTEXT or SC_MOD_DELETETEXT. Matches after the change move with the
+ * text straight away, the lines it touched are left to FindResultsRefresh. */
+void FindResultsNoteModification(FindResults* results, HWND editor, int modificationType,
+                                 INT_PTR position, INT_PTR length);
+
+/* Search the lines changed since the last refresh again, or the whole document when
+ * there were too many changes to follow. Returns TRUE when anything was searched. */
+BOOL FindResultsRefresh(FindResults* results, HWND editor);
+
+/* Number of matches */
+size_t FindResultsCount(const FindResults* results);
+
+/* Select match n in the editor and scroll it into view */
+BOOL FindResultsGoTo(const FindResults* results, HWND editor, size_t n);
+
+/* Results panel initialization and cleanup - the panel starts hidden */
+BOOL InitializeFindResultsPanel(HWND parentWindow);
+void CleanupFindResultsPanel(void);
+
+/* Results panel visibility - showing or hiding it lays out the main window again */
+void ShowFindResultsPanel(BOOL show);
+BOOL IsFindResultsPanelVisible(void);
+
+/* Layout and sizing */
+void ResizeFindResultsPanel(int width, int yPosition);
+int GetFindResultsPanelHeight(void);
+
+/* Show the selected tab's results - call when they change or another tab is selected */
+void UpdateFindResultsPanel(void);
+
+/* Results panel window procedure (for custom control) */
+LRESULT CALLBACK FindResultsPanelWndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
+#endif /* FINDRESULTS_H */
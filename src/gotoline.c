@@ -9,6 +9,7 @@
 #include "tabs.h"
 #include "Scintilla.h"
 #include "themes.h"
+#include "largefile.h"
 
 /* Dialog window class */
 #define GOTOLINE_CLASS_NAME "NotepadPlusGoToLineDialog"
@@ -31,7 +32,7 @@ static HWND g_labelHwnd = NULL;
 static HWND g_okButton = NULL;
 static HWND g_cancelButton = NULL;
 static HWND g_editorHandle = NULL;
-static int g_totalLines = 0;
+static long long g_totalLines = 0;
 static WNDPROC g_origEditProc = NULL;
 static HBRUSH g_dialogBgBrush = NULL;
 
@@ -71,11 +72,17 @@ static LRESULT CALLBACK GoToLineWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPAR
                         char lineStr[32];
                         GetWindowText(g_editHwnd, lineStr, sizeof(lineStr));
                         
-                        int lineNum = atoi(lineStr);
+                        long long lineNum = _strtoi64(lineStr, NULL, 10);
+                        
+                        /* A large file's lines can be gone to as far as indexing has got */
+                        LargeFile* largeFile = GetLargeFileForEditor(g_editorHandle);
+                        if (largeFile) {
+                            g_totalLines = LargeFileLinesIndexed(largeFile, NULL);
+                        }
                         
                         if (lineNum < 1 || lineNum > g_totalLines) {
                             char msg[100];
-                            sprintf(msg, "Please enter a line number between 1 and %d", g_totalLines);
+                            sprintf(msg, "Please enter a line number between 1 and %lld", g_totalLines);
                             MessageBox(hwnd, msg, "Go To Line", MB_OK | MB_ICONWARNING);
                             SetFocus(g_editHwnd);
                             SendMessage(g_editHwnd, EM_SETSEL, 0, -1);
@@ -83,8 +90,11 @@ static LRESULT CALLBACK GoToLineWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPAR
                         }
                         
                         /* Go to the line */
-                        if (g_editorHandle) {
-                            SendMessage(g_editorHandle, SCI_GOTOLINE, lineNum - 1, 0);
+                        if (largeFile) {
+                            LargeFileGoToLine(largeFile, lineNum - 1);
+                            SetFocus(g_editorHandle);
+                        } else if (g_editorHandle) {
+                            SendMessage(g_editorHandle, SCI_GOTOLINE, (WPARAM)(lineNum - 1), 0);
                             SendMessage(g_editorHandle, SCI_SCROLLCARET, 0, 0);
                             /* Set focus back to the editor */
                             SetFocus(g_editorHandle);
@@ -221,12 +231,24 @@ BOOL ShowGoToLineDialog(HWND parent, HWND editorHandle)
     /* Store editor handle */
     g_editorHandle = editorHandle;
     
-    /* Get total lines */
-    g_totalLines = (int)SendMessage(editorHandle, SCI_GETLINECOUNT, 0, 0);
+    /* Get total lines - a large file's are estimated until indexing is done */
+    LargeFile* largeFile = GetLargeFileForEditor(editorHandle);
+    long long estimatedLines = 0;
+    if (largeFile) {
+        g_totalLines = LargeFileLinesIndexed(largeFile, &estimatedLines);
+    } else {
+        g_totalLines = (int)SendMessage(editorHandle, SCI_GETLINECOUNT, 0, 0);
+        estimatedLines = g_totalLines;
+    }
     
     /* Get current line */
-    int currentPos = (int)SendMessage(editorHandle, SCI_GETCURRENTPOS, 0, 0);
-    int currentLine = (int)SendMessage(editorHandle, SCI_LINEFROMPOSITION, currentPos, 0);
+    long long currentLine;
+    if (largeFile) {
+        currentLine = LargeFileCaretLine(largeFile);
+    } else {
+        int currentPos = (int)SendMessage(editorHandle, SCI_GETCURRENTPOS, 0, 0);
+        currentLine = (int)SendMessage(editorHandle, SCI_LINEFROMPOSITION, currentPos, 0);
+    }
     
     /* Get parent window position to center dialog */
     RECT parentRect;
@@ -259,7 +281,11 @@ BOOL ShowGoToLineDialog(HWND parent, HWND editorHandle)
     
     /* Create label */
     char labelText[100];
-    sprintf(labelText, "Line number (1 - %d):", g_totalLines);
+    if (estimatedLines != g_totalLines) {
+        sprintf(labelText, "Line number (1 - %lld of about %lld):", g_totalLines, estimatedLines);
+    } else {
+        sprintf(labelText, "Line number (1 - %lld):", g_totalLines);
+    }
     
     g_labelHwnd = CreateWindowEx(
         0,
@@ -292,9 +318,11 @@ BOOL ShowGoToLineDialog(HWND parent, HWND editorHandle)
     g_origEditProc = (WNDPROC)SetWindowLongPtr(g_editHwnd, GWLP_WNDPROC, (LONG_PTR)EditSubclassProc);
     
     /* Set current line in edit box */
-    char lineStr[32];
-    sprintf(lineStr, "%d", currentLine + 1);
-    SetWindowText(g_editHwnd, lineStr);
+    if (currentLine >= 0) {
+        char lineStr[32];
+        sprintf(lineStr, "%lld", currentLine + 1);
+        SetWindowText(g_editHwnd, lineStr);
+    }
     
     /* Calculate button positions */
     int buttonY = MARGIN + LABEL_HEIGHT + 5 + EDIT_HEIGHT + 15;
@@ -0,0 +1,439 @@
+/*
+ * Incremental search implementation for Notepad+
+ *
+ * With "Search as you type" on, every keystroke in the Find dialog searches for the
+ * text as it now stands. A keystroke only waits for the first match near the caret
+ * and for the matches on screen, which takes the same time however large the file
+ * is. Counting the rest is done in steps from a timer, a few hundred kilobytes at a
+ * time, and a step stops as soon as input is waiting - the next keystroke replaces
+ * the search and the work left for the old text is dropped.
+ *
+ * Typing usually makes the text longer. When the new text starts with the previous
+ * text, every match of the new text starts where a match of the previous text could,
+ * so once a search has finished its matches are all the next one checks. That only
+ * holds while the document is unchanged, and when the previous text can't overlap
+ * itself - a search for "aa" in "aaa" keeps the match at 0 and skips the one at 1,
+ * and "aab" matches at 1. Regular expressions and whole word searches are always
+ * run from scratch.
+ */
+
+#include <windows.h>
+#include <stdlib.h>
+#include <string.h>
+#include "incsearch.h"
+#include "matchindex.h"
+#include "findreplace.h"
+#include "Scintilla.h"
+
+/* Indicator for matches of the incremental search */
+#define INDICATOR_INCREMENTAL_SEARCH 9
+
+/* Matches fetched per SCI_FINDALL call */
+#define INCSEARCH_RANGES_CHUNK 1024
+
+struct IncrementalSearch {
+    HWND editor;                      /* Editor searched, NULL before the first search */
+    char text[MAX_FIND_TEXT_LENGTH];  /* Text searched for */
+    size_t textLength;
+    int searchFlags;
+    void* document;                   /* Document and undo position the matches belong to */
+    INT_PTR documentLength;
+    INT_PTR undoCurrent;
+    INT_PTR anchor;                   /* Selection start when the search began */
+    BOOL selected;                    /* A match from the anchor on has been selected */
+    BOOL complete;
+    MatchIndex* matches;              /* Matches found so far, in document order */
+    MatchIndex* candidates;           /* Previous text's matches to check, NULL when scanning */
+    size_t nextCandidate;
+    INT_PTR lastEnd;                  /* End of the last match kept from the candidates */
+    INT_PTR scanPosition;             /* Where scanning carries on */
+};
+
+IncrementalSearch* CreateIncrementalSearch(void)
+{
+    IncrementalSearch* search = (IncrementalSearch*)calloc(1, sizeof(IncrementalSearch));
+    if (!search) {
+        return NULL;
+    }
+    search->matches = CreateMatchIndex();
+    if (!search->matches) {
+        free(search);
+        return NULL;
+    }
+    search->complete = TRUE;
+    return search;
+}
+
+void FreeIncrementalSearch(IncrementalSearch* search)
+{
+    if (search) {
+        FreeMatchIndex(search->matches);
+        FreeMatchIndex(search->candidates);
+        free(search);
+    }
+}
+
+static void ApplyIndicatorStyle(HWND editor)
+{
+    SendMessage(editor, SCI_INDICSETSTYLE, INDICATOR_INCREMENTAL_SEARCH, INDIC_ROUNDBOX);
+    SendMessage(editor, SCI_INDICSETFORE, INDICATOR_INCREMENTAL_SEARCH, RGB(255, 150, 0));
+    SendMessage(editor, SCI_INDICSETALPHA, INDICATOR_INCREMENTAL_SEARCH, 90);
+    SendMessage(editor, SCI_INDICSETOUTLINEALPHA, INDICATOR_INCREMENTAL_SEARCH, 200);
+    SendMessage(editor, SCI_INDICSETUNDER, INDICATOR_INCREMENTAL_SEARCH, TRUE);
+}
+
+static void ClearHighlights(HWND editor)
+{
+    if (editor && IsWindow(editor)) {
+        SendMessage(editor, SCI_SETINDICATORCURRENT, INDICATOR_INCREMENTAL_SEARCH, 0);
+        SendMessage(editor, SCI_INDICATORCLEARRANGE, 0, SendMessage(editor, SCI_GETLENGTH, 0, 0));
+    }
+}
+
+/* Whether the editor still holds the text the matches were found in */
+static BOOL SameDocument(const IncrementalSearch* search)
+{
+    return (void*)SendMessage(search->editor, SCI_GETDOCPOINTER, 0, 0) == search->document &&
+           (INT_PTR)SendMessage(search->editor, SCI_GETLENGTH, 0, 0) == search->documentLength &&
+           (INT_PTR)SendMessage(search->editor, SCI_GETUNDOCURRENT, 0, 0) == search->undoCurrent;
+}
+
+static void NoteDocument(IncrementalSearch* search)
+{
+    search->document = (void*)SendMessage(search->editor, SCI_GETDOCPOINTER, 0, 0);
+    search->documentLength = (INT_PTR)SendMessage(search->editor, SCI_GETLENGTH, 0, 0);
+    search->undoCurrent = (INT_PTR)SendMessage(search->editor, SCI_GETUNDOCURRENT, 0, 0);
+}
+
+static int FoldAscii(unsigned char c)
+{
+    return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+/* Whether two matches of text can overlap: some start of it is also an end of it.
+ * Without case folding that can't be told for other than ASCII, so the answer is yes. */
+static BOOL CanOverlap(const char* text, size_t length, BOOL matchCase)
+{
+    for (size_t i = 0; i < length; i++) {
+        if (!matchCase && (unsigned char)text[i] >= 0x80) {
+            return TRUE;
+        }
+    }
+    for (size_t border = 1; border < length; border++) {
+        const char* end = text + length - border;
+        size_t i = 0;
+        while (i < border && (matchCase ? text[i] == end[i] :
+               FoldAscii((unsigned char)text[i]) == FoldAscii((unsigned char)end[i]))) {
+            i++;
+        }
+        if (i == border) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* Whether text can be searched for among the matches of the finished search */
+static BOOL CanRefine(const IncrementalSearch* search, HWND editor, const char* text, int searchFlags)
+{
+    return search->complete && search->textLength > 0 && search->editor == editor &&
+           searchFlags == search->searchFlags &&
+           !(searchFlags & (SCFIND_REGEXP | SCFIND_WHOLEWORD | SCFIND_WORDSTART)) &&
+           strlen(text) > search->textLength && strncmp(text, search->text, search->textLength) == 0 &&
+           !CanOverlap(search->text, search->textLength, (searchFlags & SCFIND_MATCHCASE) != 0) &&
+           SameDocument(search);
+}
+
+/* Search from start to end, returning the first match or -1 */
+static INT_PTR Find(const IncrementalSearch* search, INT_PTR start, INT_PTR end, INT_PTR* matchEnd)
+{
+    struct Sci_TextToFindFull ft;
+    ft.chrg.cpMin = start;
+    ft.chrg.cpMax = end;
+    ft.lpstrText = search->text;
+    INT_PTR found = (INT_PTR)SendMessage(search->editor, SCI_FINDTEXTFULL, search->searchFlags, (LPARAM)&ft);
+    if (found >= 0) {
+        *matchEnd = ft.chrgText.cpMax;
+    }
+    return found;
+}
+
+static void Select(IncrementalSearch* search, INT_PTR start, INT_PTR end)
+{
+    SendMessage(search->editor, SCI_SETSEL, start, end);
+    SendMessage(search->editor, SCI_SCROLLCARET, 0, 0);
+    search->selected = TRUE;
+}
+
+/* Select the first match from the anchor on once one turns up */
+static void NoteMatch(IncrementalSearch* search, INT_PTR start, INT_PTR end)
+{
+    if (!search->selected && start >= search->anchor) {
+        Select(search, start, end);
+    }
+}
+
+/* Highlight the matches on the lines shown in the editor */
+static void HighlightVisible(const IncrementalSearch* search)
+{
+    HWND editor = search->editor;
+    INT_PTR firstVisible = (INT_PTR)SendMessage(editor, SCI_GETFIRSTVISIBLELINE, 0, 0);
+    INT_PTR linesOnScreen = (INT_PTR)SendMessage(editor, SCI_LINESONSCREEN, 0, 0);
+    INT_PTR firstLine = (INT_PTR)SendMessage(editor, SCI_DOCLINEFROMVISIBLE, firstVisible, 0);
+    INT_PTR lastLine = (INT_PTR)SendMessage(editor, SCI_DOCLINEFROMVISIBLE, firstVisible + linesOnScreen + 1, 0);
+    INT_PTR start = (INT_PTR)SendMessage(editor, SCI_POSITIONFROMLINE, firstLine, 0);
+    INT_PTR end = (INT_PTR)SendMessage(editor, SCI_GETLINEENDPOSITION, lastLine, 0);
+    if (start < 0 || end <= start) {
+        return;
+    }
+
+    struct Sci_CharacterRangeFull ranges[INCSEARCH_RANGES_CHUNK];
+    struct Sci_TextToFindAll fa;
+    fa.chrg.cpMin = start;
+    fa.chrg.cpMax = end;
+    fa.lpstrText = search->text;
+    fa.ranges = ranges;
+    fa.maxRanges = INCSEARCH_RANGES_CHUNK;
+    Sci_Position found = (Sci_Position)SendMessage(editor, SCI_FINDALL, search->searchFlags, (LPARAM)&fa);
+
+    ApplyIndicatorStyle(editor);
+    SendMessage(editor, SCI_SETINDICATORCURRENT, INDICATOR_INCREMENTAL_SEARCH, 0);
+    for (Sci_Position i = 0; i < found; i++) {
+        SendMessage(editor, SCI_INDICATORFILLRANGE, ranges[i].cpMin, ranges[i].cpMax - ranges[i].cpMin);
+    }
+}
+
+/* Start again from the whole document, the candidates or the document being unusable */
+static void Restart(IncrementalSearch* search)
+{
+    MatchIndexClear(search->matches);
+    FreeMatchIndex(search->candidates);
+    search->candidates = NULL;
+    search->nextCandidate = 0;
+    search->lastEnd = 0;
+    search->scanPosition = 0;
+    NoteDocument(search);
+}
+
+BOOL IncrementalSearchUpdate(IncrementalSearch* search, HWND editor, const char* text, int searchFlags)
+{
+    if (!search || !editor || !text) {
+        return TRUE;
+    }
+
+    ClearHighlights(search->editor);
+    if (editor != search->editor) {
+        ClearHighlights(editor);
+    }
+
+    /* Keep the finished search's matches when the new text can be found among them */
+    MatchIndex* candidates = NULL;
+    if (CanRefine(search, editor, text, searchFlags)) {
+        MatchIndex* matches = CreateMatchIndex();
+        if (matches) {
+            candidates = search->matches;
+            search->matches = matches;
+        }
+    }
+
+    search->editor = editor;
+    strncpy(search->text, text, MAX_FIND_TEXT_LENGTH - 1);
+    search->text[MAX_FIND_TEXT_LENGTH - 1] = '\0';
+    search->textLength = strlen(search->text);
+    search->searchFlags = searchFlags;
+    search->anchor = (INT_PTR)SendMessage(editor, SCI_GETSELECTIONSTART, 0, 0);
+    search->selected = FALSE;
+    Restart(search);
+    search->candidates = candidates;
+    search->complete = search->textLength == 0;
+    if (search->complete) {
+        SendMessage(editor, SCI_SETEMPTYSELECTION, search->anchor, 0);
+        return TRUE;
+    }
+
+    /* The first match near the anchor, so the editor moves to it with this keystroke */
+    INT_PTR end = search->anchor + INCSEARCH_FIRST_WINDOW;
+    INT_PTR matchEnd = 0;
+    INT_PTR found = Find(search, search->anchor, end < search->documentLength ? end : search->documentLength, &matchEnd);
+    if (found >= 0) {
+        Select(search, found, matchEnd);
+    } else {
+        SendMessage(editor, SCI_SETEMPTYSELECTION, search->anchor, 0);
+    }
+    HighlightVisible(search);
+    return FALSE;
+}
+
+/* Scan the next chunk of the document, ending it at a line start */
+static void ScanPart(IncrementalSearch* search)
+{
+    INT_PTR end = search->scanPosition + INCSEARCH_SCAN_CHUNK;
+    if (end >= search->documentLength) {
+        end = search->documentLength;
+    } else {
+        INT_PTR line = (INT_PTR)SendMessage(search->editor, SCI_LINEFROMPOSITION, end, 0);
+        INT_PTR lineStart = (INT_PTR)SendMessage(search->editor, SCI_POSITIONFROMLINE, line + 1, 0);
+        end = lineStart > end ? lineStart : search->documentLength;
+    }
+
+    struct Sci_CharacterRangeFull ranges[INCSEARCH_RANGES_CHUNK];
+    struct Sci_TextToFindAll fa;
+    fa.chrg.cpMin = search->scanPosition;
+    fa.chrg.cpMax = end;
+    fa.lpstrText = search->text;
+    fa.ranges = ranges;
+    fa.maxRanges = INCSEARCH_RANGES_CHUNK;
+
+    Sci_Position found;
+    do {
+        found = (Sci_Position)SendMessage(search->editor, SCI_FINDALL, search->searchFlags, (LPARAM)&fa);
+        if (found < 0) {
+            /* Invalid regular expression - there is nothing to find */
+            search->complete = TRUE;
+            return;
+        }
+        for (Sci_Position i = 0; i < found; i++) {
+            if (!MatchIndexAppend(search->matches, ranges[i].cpMin)) {
+                search->complete = TRUE;
+                return;
+            }
+            NoteMatch(search, ranges[i].cpMin, ranges[i].cpMax);
+        }
+        if (found > 0) {
+            /* Carry on after the last match, past it when it was empty */
+            struct Sci_CharacterRangeFull last = ranges[found - 1];
+            fa.chrg.cpMin = last.cpMax > last.cpMin ? last.cpMax :
+                            (Sci_Position)SendMessage(search->editor, SCI_POSITIONAFTER, last.cpMax, 0);
+        }
+    } while (found == INCSEARCH_RANGES_CHUNK && fa.chrg.cpMin < end);
+
+    search->scanPosition = end;
+    search->complete = end >= search->documentLength;
+}
+
+/* Where a match of the text starting at position ends, or -1 when none starts there */
+static INT_PTR MatchAt(const IncrementalSearch* search, INT_PTR position)
+{
+    size_t length = search->textLength;
+    if (position + (INT_PTR)length > search->documentLength) {
+        return -1;
+    }
+
+    /* Compare the bytes directly when the answer doesn't depend on case folding rules */
+    const unsigned char* bytes = (const unsigned char*)SendMessage(search->editor, SCI_GETRANGEPOINTER,
+                                                                   position, (LPARAM)length);
+    if (bytes) {
+        if (search->searchFlags & SCFIND_MATCHCASE) {
+            return memcmp(bytes, search->text, length) == 0 ? position + (INT_PTR)length : -1;
+        }
+        size_t i = 0;
+        while (i < length && bytes[i] < 0x80) {
+            if (FoldAscii(bytes[i]) != FoldAscii((unsigned char)search->text[i])) {
+                return -1;
+            }
+            i++;
+        }
+        if (i == length) {
+            return position + (INT_PTR)length;
+        }
+    }
+
+    /* A case folded match can be up to three times as long as the text */
+    INT_PTR end = position + 3 * (INT_PTR)length + 3;
+    INT_PTR matchEnd = 0;
+    INT_PTR found = Find(search, position, end < search->documentLength ? end : search->documentLength, &matchEnd);
+    return found == position ? matchEnd : -1;
+}
+
+/* Check the next chunk of the previous text's matches */
+static void FilterPart(IncrementalSearch* search)
+{
+    size_t count = MatchIndexCount(search->candidates);
+    size_t last = search->nextCandidate + INCSEARCH_FILTER_CHUNK;
+    if (last > count) {
+        last = count;
+    }
+    for (size_t n = search->nextCandidate; n < last; n++) {
+        INT_PTR position = MatchIndexAt(search->candidates, n);
+        if (position < search->lastEnd) {
+            continue;
+        }
+        INT_PTR end = MatchAt(search, position);
+        if (end >= 0) {
+            if (!MatchIndexAppend(search->matches, position)) {
+                search->complete = TRUE;
+                return;
+            }
+            search->lastEnd = end;
+            NoteMatch(search, position, end);
+        }
+    }
+    search->nextCandidate = last;
+    if (last == count) {
+        FreeMatchIndex(search->candidates);
+        search->candidates = NULL;
+        search->complete = TRUE;
+    }
+}
+
+BOOL IncrementalSearchStep(IncrementalSearch* search)
+{
+    if (!search || search->complete) {
+        return TRUE;
+    }
+
+    /* The document changed under the search - the matches so far may be wrong */
+    if (!IsWindow(search->editor)) {
+        IncrementalSearchCancel(search);
+        return TRUE;
+    }
+    if (!SameDocument(search)) {
+        Restart(search);
+    }
+
+    for (int part = 0; part < INCSEARCH_STEP_PARTS && !search->complete; part++) {
+        /* Let waiting input through - a keystroke will usually replace this search */
+        if (part > 0 && HIWORD(GetQueueStatus(QS_KEY | QS_MOUSEBUTTON))) {
+            break;
+        }
+        if (search->candidates) {
+            FilterPart(search);
+        } else {
+            ScanPart(search);
+        }
+    }
+
+    /* Nothing from the anchor to the end of the document, so wrap round to the first match */
+    if (search->complete && !search->selected && MatchIndexCount(search->matches) > 0) {
+        INT_PTR start = MatchIndexAt(search->matches, 0);
+        INT_PTR end = start;
+        Find(search, start, search->documentLength, &end);
+        Select(search, start, end);
+        HighlightVisible(search);
+    }
+    return search->complete;
+}
+
+void IncrementalSearchCancel(IncrementalSearch* search)
+{
+    if (!search) {
+        return;
+    }
+    ClearHighlights(search->editor);
+    MatchIndexClear(search->matches);
+    FreeMatchIndex(search->candidates);
+    search->candidates = NULL;
+    search->text[0] = '\0';
+    search->textLength = 0;
+    search->complete = TRUE;
+}
+
+size_t IncrementalSearchCount(const IncrementalSearch* search)
+{
+    return search ? MatchIndexCount(search->matches) : 0;
+}
+
+BOOL IncrementalSearchIsComplete(const IncrementalSearch* search)
+{
+    return !search || search->complete;
+}
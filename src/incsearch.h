@@ -0,0 +1,52 @@
+/*
+ * Incremental search header for Notepad+
+ * Searches as the find text is typed, cancelling the search for the text before
+ */
+
+#ifndef INCSEARCH_H
+#define INCSEARCH_H
+
+#include <windows.h>
+
+/* Text searched for the first match before a keystroke returns (bytes) */
+#define INCSEARCH_FIRST_WINDOW      (1024 * 1024)
+
+/* Text searched per part of a step, input is checked for between parts (bytes) */
+#define INCSEARCH_SCAN_CHUNK        (512 * 1024)
+
+/* Matches of the previous text checked per part of a step */
+#define INCSEARCH_FILTER_CHUNK      16384
+
+/* Parts per step, when no input arrives first */
+#define INCSEARCH_STEP_PARTS        16
+
+/* Interval between steps while a search is running (milliseconds) */
+#define INCSEARCH_STEP_INTERVAL     10
+
+typedef struct IncrementalSearch IncrementalSearch;
+
+/* A new incremental search has no text and nothing to do */
+IncrementalSearch* CreateIncrementalSearch(void);
+void FreeIncrementalSearch(IncrementalSearch* search);
+
+/* Search an editor's document for text in place of the previous text, cancelling the
+ * search for it. The first match from the selection start on within INCSEARCH_FIRST_WINDOW
+ * is selected and the matches on screen highlighted straight away, so the editor shows the
+ * new text at once. Counting the rest is left to IncrementalSearchStep - when the new
+ * text extends the previous one and that search had finished, only its matches are
+ * checked again instead of the whole document. Returns TRUE when nothing is left to do. */
+BOOL IncrementalSearchUpdate(IncrementalSearch* search, HWND editor, const char* text, int searchFlags);
+
+/* Carry on with the search, stopping early when input is waiting. Once it finishes without
+ * a match from the selection start on, the first match in the document is selected.
+ * Returns TRUE when the search is complete. */
+BOOL IncrementalSearchStep(IncrementalSearch* search);
+
+/* Stop searching, forget the matches and remove the highlights */
+void IncrementalSearchCancel(IncrementalSearch* search);
+
+/* Matches found so far and whether that is all of them */
+size_t IncrementalSearchCount(const IncrementalSearch* search);
+BOOL IncrementalSearchIsComplete(const IncrementalSearch* search);
+
+#endif /* INCSEARCH_H */
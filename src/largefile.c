@@ -0,0 +1,1025 @@
+/*
+ * Large file viewer implementation for Notepad+
+ *
+ * Loading a file builds a document holding all its text, plus its line starts, styles and
+ * undo history, which for logs of tens of gigabytes is more memory than there is. Such files
+ * are instead shown one page at a time: the file is memory mapped and the editor shows a
+ * read-only document holding about LARGEFILE_PAGE_SIZE bytes of it. When the view comes near
+ * either end of the page, a new page is shown around it. Pages are built with a loader
+ * straight from the mapped view and keep no styles, undo or change history, so the memory
+ * used depends on the page and not the file.
+ *
+ * Line numbers come from a sparse line index built on a worker thread, which keeps the file
+ * offset of every LARGEFILE_INDEX_STEP-th line. The line of an offset, or the offset of a line,
+ * is found from the nearest indexed line and a scan of at most that many lines. Until
+ * indexing reaches a part of the file its lines are unknown, and the line number margin is
+ * hidden while the page is in such a part.
+ *
+ * Searches run over the mapping itself rather than the page, one chunk at a time, on a worker
+ * thread with its own mapping so the window stays responsive. Escape or a click on the progress
+ * pane cancels them.
+ * UTF-8 and ANSI text is shown as it is in the file so file offsets are page positions plus
+ * the page start. UTF-16 files would need converting, so they are loaded normally instead.
+ */
+
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "largefile.h"
+#include "tabs.h"
+#include "statusbar.h"
+#include "Scintilla.h"
+#include "scintilla_bridge.h"
+#include "findreplace.h"
+
+struct LargeFile {
+    HWND editor;
+    HWND notifyWindow;
+    char filePath[MAX_PATH];
+    MappedFile file;                  /* Mapping used on the UI thread - the worker maps its own */
+    unsigned long long dataStart;     /* Offset of the text, after any byte order mark */
+    char lineEnd;                     /* Byte ending each line - '\r' for CR line ends, '\n' otherwise */
+    int codePage;                     /* Scintilla code page of the text */
+    /* Page shown - [pageStart, pageEnd) of the file */
+    BOOL pageShown;
+    unsigned long long pageStart;
+    unsigned long long pageEnd;
+    long long pageLine;               /* Line pageStart is on, -1 while not indexed */
+    int hiddenMarginWidth;            /* Width of the line number margin while hidden, otherwise 0 */
+    BOOL pagePending;                 /* WM_LARGEFILE_PAGE posted and not handled yet */
+    BOOL pageStuck;                   /* The last new page left the view near the same end - a line
+                                       * longer than the page margin, so don't ask for another */
+    /* Line index - written by the worker, read on the UI thread */
+    unsigned long long** samples;     /* Blocks of LARGEFILE_INDEX_BLOCK line starts */
+    size_t blockCount;
+    volatile LONG64 sampleCount;
+    volatile LONG64 indexedLineEnds;  /* Line ends before indexedBytes */
+    volatile LONG64 indexedBytes;     /* Offset indexing has reached */
+    volatile LONG indexDone;
+    volatile LONG cancelled;
+    int indexPercent;                 /* Worker only - last percentage posted */
+    HANDLE thread;
+};
+
+/* A search of a viewer's file, run on a worker through its own mapping. One search runs at a
+ * time - starting another or closing the viewer stops it. */
+typedef struct {
+    LargeFile* largeFile;
+    HANDLE thread;
+    void* search;                     /* ByteSearch of the text */
+    BOOL counting;                    /* Count the matches rather than find the next one */
+    BOOL forward;
+    unsigned long long selStart;      /* Selection when the search started - file offsets */
+    unsigned long long selEnd;
+    unsigned long long searched;      /* Worker only - bytes searched so far */
+    volatile LONG percent;            /* Last percentage posted */
+    volatile LONG cancelled;
+    volatile LONG done;
+    /* Results - read once done */
+    int found;                        /* 1 when found, 0 when not, -1 when cancelled */
+    unsigned long long matchStart;
+    unsigned long long matchEnd;
+    long long count;                  /* Matches counted, -1 when cancelled or unreadable */
+} LargeFileSearch;
+
+/* Search running or finished without WM_LARGEFILE_SEARCH handled yet */
+static LargeFileSearch* g_largeFileSearch = NULL;
+
+/* Read a count the worker updates */
+static LONG64 ReadShared(volatile LONG64* value)
+{
+    return InterlockedCompareExchange64(value, 0, 0);
+}
+
+/* Start of line number sample * LARGEFILE_INDEX_STEP - sample must be below sampleCount */
+static unsigned long long GetSample(LargeFile* largeFile, LONG64 sample)
+{
+    return largeFile->samples[sample / LARGEFILE_INDEX_BLOCK][sample % LARGEFILE_INDEX_BLOCK];
+}
+
+/* Add the start of the next sampled line - worker only once indexing has started */
+static BOOL AddSample(LargeFile* largeFile, unsigned long long offset)
+{
+    LONG64 count = largeFile->sampleCount;
+    size_t block = (size_t)(count / LARGEFILE_INDEX_BLOCK);
+    if (block >= largeFile->blockCount) {
+        return FALSE;
+    }
+    if (!largeFile->samples[block]) {
+        largeFile->samples[block] = (unsigned long long*)malloc(LARGEFILE_INDEX_BLOCK * sizeof(unsigned long long));
+        if (!largeFile->samples[block]) {
+            return FALSE;
+        }
+    }
+    largeFile->samples[block][count % LARGEFILE_INDEX_BLOCK] = offset;
+
+    /* The start has to be written before the count that makes it visible */
+    InterlockedExchange64(&largeFile->sampleCount, count + 1);
+    return TRUE;
+}
+
+/* Worker thread for the line index - reads the file through its own mapping */
+static DWORD WINAPI LargeFileIndexThreadProc(LPVOID param)
+{
+    LargeFile* largeFile = (LargeFile*)param;
+    unsigned long long end = largeFile->file.size;
+    unsigned long long offset = largeFile->dataStart;
+    LONG64 lineEnds = 0;
+    MappedFile mf;
+
+    if (OpenMappedFile(&mf, largeFile->filePath)) {
+        mf.viewLimit = LARGEFILE_VIEW_SIZE;
+        BOOL indexing = TRUE;
+        while (indexing && offset < end && !largeFile->cancelled) {
+            size_t length = (end - offset < LARGEFILE_SCAN_CHUNK) ? (size_t)(end - offset) : LARGEFILE_SCAN_CHUNK;
+            const char* data = MapFileRange(&mf, offset, length);
+            if (!data) {
+                break;
+            }
+
+            const char* p = data;
+            const char* limit = data + length;
+            LONG64 chunkLineEnds = lineEnds;
+            while ((p = (const char*)memchr(p, largeFile->lineEnd, limit - p)) != NULL) {
+                p++;
+                chunkLineEnds++;
+                if (chunkLineEnds % LARGEFILE_INDEX_STEP == 0 && !AddSample(largeFile, offset + (p - data))) {
+                    /* Out of memory - what is indexed so far stays usable */
+                    indexing = FALSE;
+                    break;
+                }
+            }
+            if (!indexing) {
+                break;
+            }
+
+            lineEnds = chunkLineEnds;
+            offset += length;
+            InterlockedExchange64(&largeFile->indexedLineEnds, lineEnds);
+            InterlockedExchange64(&largeFile->indexedBytes, (LONG64)offset);
+
+            int percent = (int)((offset - largeFile->dataStart) * 100 / (end - largeFile->dataStart));
+            if (percent != largeFile->indexPercent) {
+                largeFile->indexPercent = percent;
+                PostMessage(largeFile->notifyWindow, WM_LARGEFILE_INDEX, 0, (LPARAM)largeFile);
+            }
+        }
+        CloseMappedFile(&mf);
+    }
+
+    if (offset >= end) {
+        InterlockedExchange(&largeFile->indexDone, 1);
+    }
+    PostMessage(largeFile->notifyWindow, WM_LARGEFILE_INDEX, 0, (LPARAM)largeFile);
+    return 0;
+}
+
+/* Line ends in [from, to) of the file, -1 if it can't be read */
+static long long CountLineEnds(LargeFile* largeFile, unsigned long long from, unsigned long long to)
+{
+    long long count = 0;
+    while (from < to) {
+        size_t length = (to - from < LARGEFILE_SCAN_CHUNK) ? (size_t)(to - from) : LARGEFILE_SCAN_CHUNK;
+        const char* data = MapFileRange(&largeFile->file, from, length);
+        if (!data) {
+            return -1;
+        }
+        const char* limit = data + length;
+        for (const char* p = data; (p = (const char*)memchr(p, largeFile->lineEnd, limit - p)) != NULL; p++) {
+            count++;
+        }
+        from += length;
+    }
+    return count;
+}
+
+/* Line a file offset is on, -1 when indexing hasn't got that far */
+static long long LineAtOffset(LargeFile* largeFile, unsigned long long offset)
+{
+    if (offset > (unsigned long long)ReadShared(&largeFile->indexedBytes)) {
+        return -1;
+    }
+
+    /* Last sampled line starting at or before offset */
+    LONG64 low = 0;
+    LONG64 high = ReadShared(&largeFile->sampleCount) - 1;
+    while (low < high) {
+        LONG64 mid = (low + high + 1) / 2;
+        if (GetSample(largeFile, mid) <= offset) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+
+    long long lineEnds = CountLineEnds(largeFile, GetSample(largeFile, low), offset);
+    return (lineEnds < 0) ? -1 : low * LARGEFILE_INDEX_STEP + lineEnds;
+}
+
+/* File offset of the start of a line, FALSE when indexing hasn't reached it */
+static BOOL LineStartOffset(LargeFile* largeFile, long long line, unsigned long long* offset)
+{
+    if (line < 0 || line > ReadShared(&largeFile->indexedLineEnds) ||
+        line / LARGEFILE_INDEX_STEP >= ReadShared(&largeFile->sampleCount)) {
+        return FALSE;
+    }
+
+    unsigned long long position = GetSample(largeFile, line / LARGEFILE_INDEX_STEP);
+    long long remaining = line % LARGEFILE_INDEX_STEP;
+    while (remaining > 0) {
+        unsigned long long left = largeFile->file.size - position;
+        size_t length = (left < LARGEFILE_SCAN_CHUNK) ? (size_t)left : LARGEFILE_SCAN_CHUNK;
+        const char* data = (length > 0) ? MapFileRange(&largeFile->file, position, length) : NULL;
+        if (!data) {
+            return FALSE;
+        }
+        const char* p = data;
+        const char* limit = data + length;
+        while (remaining > 0 && (p = (const char*)memchr(p, largeFile->lineEnd, limit - p)) != NULL) {
+            p++;
+            remaining--;
+        }
+        position += (remaining > 0) ? length : (size_t)(p - data);
+    }
+    *offset = position;
+    return TRUE;
+}
+
+/* Move an offset back to the start of a UTF-8 character so a page doesn't split one.
+ * mf is the mapping of the thread calling - the viewer's own one on the UI thread. */
+static unsigned long long CharBoundary(LargeFile* largeFile, MappedFile* mf, unsigned long long offset)
+{
+    if (largeFile->codePage != SC_CP_UTF8 || offset >= largeFile->file.size) {
+        return offset;
+    }
+    unsigned long long start = (offset - largeFile->dataStart > 3) ? offset - 3 : largeFile->dataStart;
+    const char* data = MapFileRange(mf, start, (size_t)(offset - start + 1));
+    if (!data) {
+        return offset;
+    }
+    for (unsigned long long position = offset; position >= start; position--) {
+        if (((unsigned char)data[position - start] & 0xC0) != 0x80) {
+            return position;
+        }
+        if (position == start) {
+            break;
+        }
+    }
+    return offset;
+}
+
+/* Start of the line offset is on, or offset itself when that line started more than a quarter
+ * of a page earlier - such long lines are cut at a character boundary */
+static unsigned long long LineStartBefore(LargeFile* largeFile, MappedFile* mf, unsigned long long offset)
+{
+    unsigned long long limit = (offset - largeFile->dataStart > LARGEFILE_PAGE_SIZE / 4) ?
+                               offset - LARGEFILE_PAGE_SIZE / 4 : largeFile->dataStart;
+    if (offset > limit) {
+        const char* data = MapFileRange(mf, limit, (size_t)(offset - limit));
+        if (data) {
+            for (const char* p = data + (offset - limit); p > data; p--) {
+                if (p[-1] == largeFile->lineEnd) {
+                    return limit + (p - data);
+                }
+            }
+        }
+    }
+    return (limit == largeFile->dataStart) ? limit : CharBoundary(largeFile, mf, offset);
+}
+
+/* End of the page starting at start - after the last line end in the page, or cut like a
+ * long line when the last eighth of the page has no line end */
+static unsigned long long PageEndAfter(LargeFile* largeFile, unsigned long long start)
+{
+    if (largeFile->file.size - start <= LARGEFILE_PAGE_SIZE) {
+        return largeFile->file.size;
+    }
+    unsigned long long limit = start + LARGEFILE_PAGE_SIZE;
+    unsigned long long low = limit - LARGEFILE_PAGE_SIZE / 8;
+    const char* data = MapFileRange(&largeFile->file, low, (size_t)(limit - low));
+    if (data) {
+        for (const char* p = data + (limit - low); p > data; p--) {
+            if (p[-1] == largeFile->lineEnd) {
+                return low + (p - data);
+            }
+        }
+    }
+    return CharBoundary(largeFile, &largeFile->file, limit);
+}
+
+/* Number the page's lines as lines of the file, widening the margin for their digits.
+ * The margin is hidden while the page's line isn't known. */
+static void UpdateLineNumbers(LargeFile* largeFile)
+{
+    HWND editor = largeFile->editor;
+    int width = (int)SendMessage(editor, SCI_GETMARGINWIDTHN, 0, 0);
+
+    if (largeFile->pageLine < 0) {
+        if (width > 0) {
+            largeFile->hiddenMarginWidth = width;
+            SendMessage(editor, SCI_SETMARGINWIDTHN, 0, 0);
+        }
+        return;
+    }
+
+    if (largeFile->hiddenMarginWidth > 0) {
+        width = largeFile->hiddenMarginWidth;
+        largeFile->hiddenMarginWidth = 0;
+    }
+    SendMessage(editor, SCI_SETLINENUMBEROFFSET, (WPARAM)largeFile->pageLine, 0);
+    if (width > 0) {
+        char widest[32];
+        long long lastLine = largeFile->pageLine + SendMessage(editor, SCI_GETLINECOUNT, 0, 0);
+        int length = snprintf(widest, sizeof(widest), "_%lld", lastLine);
+        memset(widest + 1, '9', length - 1);
+        int needed = (int)SendMessage(editor, SCI_TEXTWIDTH, STYLE_LINENUMBER, (LPARAM)widest);
+        SendMessage(editor, SCI_SETMARGINWIDTHN, 0, (needed > width) ? needed : width);
+    }
+}
+
+/* Replace the editor's document with one holding [start, end) of the file */
+static BOOL LoadPage(LargeFile* largeFile, unsigned long long start, unsigned long long end)
+{
+    HWND editor = largeFile->editor;
+    size_t length = (size_t)(end - start);
+    const char* data = NULL;
+
+    if (length > 0) {
+        data = MapFileRange(&largeFile->file, start, length);
+        if (!data) {
+            return FALSE;
+        }
+    }
+
+    /* Pages are never edited or styled - loader documents collect no undo and these keep
+     * no styles either */
+    void* loader = (void*)SendMessage(editor, SCI_CREATELOADER, length, SC_DOCUMENTOPTION_STYLES_NONE);
+    if (!loader) {
+        return FALSE;
+    }
+    if (length > 0 && LoaderAddData(loader, data, (Sci_Position)length) != LOADER_STATUS_OK) {
+        LoaderRelease(loader);
+        return FALSE;
+    }
+
+    /* Tab width belongs to the document, carry it over from the page being replaced */
+    int tabWidth = (int)SendMessage(editor, SCI_GETTABWIDTH, 0, 0);
+
+    void* document = LoaderConvertToDocument(loader);
+    SendMessage(editor, SCI_SETDOCPOINTER, 0, (LPARAM)document);
+    SendMessage(editor, SCI_RELEASEDOCUMENT, 0, (LPARAM)document);
+
+    SendMessage(editor, SCI_SETCODEPAGE, largeFile->codePage, 0);
+    SendMessage(editor, SCI_SETTABWIDTH, tabWidth, 0);
+    SendMessage(editor, SCI_SETREADONLY, 1, 0);
+
+    largeFile->pageShown = TRUE;
+    largeFile->pageStart = start;
+    largeFile->pageEnd = end;
+    largeFile->pageLine = LineAtOffset(largeFile, start);
+    UpdateLineNumbers(largeFile);
+    return TRUE;
+}
+
+/* Show the page with offset about halfway down it, or the first or last page near the ends */
+static BOOL ShowPageAround(LargeFile* largeFile, unsigned long long offset)
+{
+    unsigned long long size = largeFile->file.size;
+    unsigned long long start = (offset - largeFile->dataStart > LARGEFILE_PAGE_SIZE / 2) ?
+                               offset - LARGEFILE_PAGE_SIZE / 2 : largeFile->dataStart;
+    BOOL lastPage = (size - start <= LARGEFILE_PAGE_SIZE);
+    if (lastPage) {
+        start = (size - largeFile->dataStart > LARGEFILE_PAGE_SIZE) ? size - LARGEFILE_PAGE_SIZE : largeFile->dataStart;
+    }
+    start = LineStartBefore(largeFile, &largeFile->file, start);
+
+    /* Moving the start back to a line start mustn't lose the end of the file */
+    unsigned long long end = lastPage ? size : PageEndAfter(largeFile, start);
+    if (largeFile->pageShown && start == largeFile->pageStart && end == largeFile->pageEnd) {
+        return TRUE;
+    }
+    return LoadPage(largeFile, start, end);
+}
+
+/* Whether offset is on the page and not within LARGEFILE_PAGE_MARGIN of an end of the page
+ * that isn't an end of the file */
+static BOOL IsWellInPage(LargeFile* largeFile, unsigned long long offset)
+{
+    if (!largeFile->pageShown || offset < largeFile->pageStart || offset > largeFile->pageEnd) {
+        return FALSE;
+    }
+    if (largeFile->pageStart > largeFile->dataStart && offset - largeFile->pageStart < LARGEFILE_PAGE_MARGIN) {
+        return FALSE;
+    }
+    if (largeFile->pageEnd < largeFile->file.size && largeFile->pageEnd - offset < LARGEFILE_PAGE_MARGIN) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* File offsets of the starts of the first line and the end of the last line on screen */
+static void GetViewRange(LargeFile* largeFile, unsigned long long* top, unsigned long long* bottom)
+{
+    HWND editor = largeFile->editor;
+    LRESULT firstVisible = SendMessage(editor, SCI_GETFIRSTVISIBLELINE, 0, 0);
+    LRESULT linesOnScreen = SendMessage(editor, SCI_LINESONSCREEN, 0, 0);
+    LRESULT lineCount = SendMessage(editor, SCI_GETLINECOUNT, 0, 0);
+    LRESULT firstLine = SendMessage(editor, SCI_DOCLINEFROMVISIBLE, firstVisible, 0);
+    LRESULT lastLine = SendMessage(editor, SCI_DOCLINEFROMVISIBLE, firstVisible + linesOnScreen, 0);
+    if (lastLine >= lineCount) {
+        lastLine = lineCount - 1;
+    }
+    *top = largeFile->pageStart + SendMessage(editor, SCI_POSITIONFROMLINE, firstLine, 0);
+    *bottom = largeFile->pageStart + SendMessage(editor, SCI_GETLINEENDPOSITION, lastLine, 0);
+}
+
+/* Whether the view is within LARGEFILE_PAGE_MARGIN of an end of the page that isn't an end
+ * of the file */
+static BOOL IsViewNearPageEnd(LargeFile* largeFile)
+{
+    unsigned long long top, bottom;
+    GetViewRange(largeFile, &top, &bottom);
+    return (largeFile->pageStart > largeFile->dataStart && top - largeFile->pageStart < LARGEFILE_PAGE_MARGIN) ||
+           (largeFile->pageEnd < largeFile->file.size && largeFile->pageEnd - bottom < LARGEFILE_PAGE_MARGIN);
+}
+
+/* Whether a viewer is still open - messages posted for it may arrive after it was closed */
+static BOOL IsLargeFileOpen(LargeFile* largeFile)
+{
+    int count = GetTabCount();
+    for (int i = 0; i < count; i++) {
+        TabInfo* tab = GetTab(i);
+        if (tab && tab->largeFile == largeFile) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+LargeFile* GetLargeFileForEditor(HWND editor)
+{
+    int count = GetTabCount();
+    for (int i = 0; i < count; i++) {
+        TabInfo* tab = GetTab(i);
+        if (tab && tab->editorHandle == editor) {
+            return tab->largeFile;
+        }
+    }
+    return NULL;
+}
+
+/* Scintilla only takes the double byte ANSI code pages - for the rest, single byte code
+ * page 0 shows the text in the system code page */
+static int AnsiCodePage(void)
+{
+    UINT codePage = GetACP();
+    if (codePage == 932 || codePage == 936 || codePage == 949 || codePage == 950 || codePage == 1361) {
+        return (int)codePage;
+    }
+    return 0;
+}
+
+LargeFile* OpenLargeFile(HWND editor, const char* filePath, HWND notifyWindow, FileInfo* info)
+{
+    if (!editor || !filePath || !notifyWindow) {
+        return NULL;
+    }
+
+    LargeFile* largeFile = (LargeFile*)calloc(1, sizeof(LargeFile));
+    if (!largeFile) {
+        return NULL;
+    }
+    largeFile->editor = editor;
+    largeFile->notifyWindow = notifyWindow;
+    strncpy(largeFile->filePath, filePath, MAX_PATH - 1);
+    largeFile->pageLine = -1;
+
+    if (!OpenMappedFile(&largeFile->file, filePath)) {
+        free(largeFile);
+        return NULL;
+    }
+    largeFile->file.viewLimit = LARGEFILE_VIEW_SIZE;
+    unsigned long long size = largeFile->file.size;
+
+    /* Detect the encoding and line ends from the start of the file, cut after a line end so
+     * the sample doesn't end part way through a character */
+    size_t sampleSize = (size < FILELOAD_DETECT_SAMPLE) ? (size_t)size : FILELOAD_DETECT_SAMPLE;
+    const char* sample = (sampleSize > 0) ? MapFileRange(&largeFile->file, 0, sampleSize) : NULL;
+    if (!sample) {
+        FreeLargeFile(largeFile);
+        return NULL;
+    }
+    size_t detectSize = sampleSize;
+    if (sampleSize < size) {
+        while (detectSize > 0 && sample[detectSize - 1] != '\n' && sample[detectSize - 1] != '\r') {
+            detectSize--;
+        }
+        if (detectSize == 0) {
+            detectSize = sampleSize;
+        }
+    }
+    BOOL hasBOM = FALSE;
+    int encoding = DetectFileEncodingFromData(sample, detectSize, &hasBOM);
+    if (encoding == ENCODING_UTF16_LE || encoding == ENCODING_UTF16_BE) {
+        FreeLargeFile(largeFile);
+        return NULL;
+    }
+    int lineEnding = DetectLineEndingFromData(sample, detectSize);
+    largeFile->dataStart = hasBOM ? 3 : 0;
+    largeFile->lineEnd = (lineEnding == LINEEND_CR) ? '\r' : '\n';
+    largeFile->codePage = (encoding == ENCODING_ANSI) ? AnsiCodePage() : SC_CP_UTF8;
+
+    /* Room for the start of every LARGEFILE_INDEX_STEP-th line even if every byte ended a line -
+     * the blocks themselves are only allocated as indexing reaches them */
+    largeFile->blockCount = (size_t)(((size - largeFile->dataStart) / LARGEFILE_INDEX_STEP + 1) / LARGEFILE_INDEX_BLOCK) + 1;
+    largeFile->samples = (unsigned long long**)calloc(largeFile->blockCount, sizeof(unsigned long long*));
+    if (!largeFile->samples || !AddSample(largeFile, largeFile->dataStart)) {
+        FreeLargeFile(largeFile);
+        return NULL;
+    }
+    largeFile->indexedBytes = (LONG64)largeFile->dataStart;
+
+    SendMessage(editor, SCI_SETCHANGEHISTORY, SC_CHANGE_HISTORY_DISABLED, 0);
+    if (!ShowPageAround(largeFile, largeFile->dataStart)) {
+        FreeLargeFile(largeFile);
+        return NULL;
+    }
+
+    /* Without the index the file can still be read - only line numbers and going to a line
+     * are lost */
+    largeFile->thread = CreateThread(NULL, 0, LargeFileIndexThreadProc, largeFile, 0, NULL);
+
+    if (info) {
+        strncpy(info->filePath, filePath, MAX_PATH - 1);
+        info->filePath[MAX_PATH - 1] = '\0';
+        info->encoding = encoding;
+        info->lineEnding = lineEnding;
+        info->hasBOM = hasBOM;
+        DWORD attributes = GetFileAttributes(filePath);
+        info->isReadOnly = (attributes != INVALID_FILE_ATTRIBUTES) && (attributes & FILE_ATTRIBUTE_READONLY);
+        info->fileSize = size;
+    }
+    return largeFile;
+}
+
+static void FreeSearch(LargeFileSearch* job)
+{
+    if (job->thread) CloseHandle(job->thread);
+    ByteSearchRelease(job->search);
+    free(job);
+}
+
+void FinishLargeFileSearch(void)
+{
+    LargeFileSearch* job = g_largeFileSearch;
+    if (!job) {
+        return;
+    }
+    g_largeFileSearch = NULL;
+    InterlockedExchange(&job->cancelled, 1);
+    WaitForSingleObject(job->thread, INFINITE);
+    HideStatusBarProgress();
+    FreeSearch(job);
+}
+
+/* Stops indexing and searching and waits for the workers - the editor keeps showing the last page */
+void FreeLargeFile(LargeFile* largeFile)
+{
+    if (!largeFile) {
+        return;
+    }
+    if (g_largeFileSearch && g_largeFileSearch->largeFile == largeFile) {
+        FinishLargeFileSearch();
+    }
+    if (largeFile->thread) {
+        InterlockedExchange(&largeFile->cancelled, 1);
+        WaitForSingleObject(largeFile->thread, INFINITE);
+        CloseHandle(largeFile->thread);
+    }
+    if (largeFile->samples) {
+        for (size_t i = 0; i < largeFile->blockCount; i++) {
+            free(largeFile->samples[i]);
+        }
+        free(largeFile->samples);
+    }
+    CloseMappedFile(&largeFile->file);
+    free(largeFile);
+}
+
+void UpdateLargeFileStatus(LargeFile* largeFile)
+{
+    HWND editor = largeFile->editor;
+    LRESULT pos = SendMessage(editor, SCI_GETCURRENTPOS, 0, 0);
+    LRESULT line = SendMessage(editor, SCI_LINEFROMPOSITION, pos, 0);
+    LRESULT lineStart = SendMessage(editor, SCI_POSITIONFROMLINE, line, 0);
+
+    UpdateCursorPosition((largeFile->pageLine < 0) ? -1 : largeFile->pageLine + line, pos - lineStart);
+    UpdateFilePosition((long long)(largeFile->pageStart - largeFile->dataStart) + pos);
+}
+
+/* Whether the selected tab shows this viewer */
+static BOOL IsLargeFileSelected(LargeFile* largeFile)
+{
+    TabInfo* tab = GetTab(GetSelectedTab());
+    return tab && tab->largeFile == largeFile;
+}
+
+void LargeFileIndexed(LargeFile* largeFile)
+{
+    if (!IsLargeFileOpen(largeFile) || largeFile->pageLine >= 0) {
+        return;
+    }
+    largeFile->pageLine = LineAtOffset(largeFile, largeFile->pageStart);
+    if (largeFile->pageLine >= 0) {
+        UpdateLineNumbers(largeFile);
+        if (IsLargeFileSelected(largeFile)) {
+            UpdateLargeFileStatus(largeFile);
+        }
+    }
+}
+
+void LargeFileUpdateView(LargeFile* largeFile)
+{
+    /* SCN_UPDATEUI comes while painting, when the document can't be replaced */
+    if (!largeFile || largeFile->pagePending) {
+        return;
+    }
+    if (!IsViewNearPageEnd(largeFile)) {
+        largeFile->pageStuck = FALSE;
+    } else if (!largeFile->pageStuck) {
+        largeFile->pagePending = TRUE;
+        PostMessage(largeFile->notifyWindow, WM_LARGEFILE_PAGE, 0, (LPARAM)largeFile);
+    }
+}
+
+/* Put the view back on the same text once a new page is shown. A selection reaching off the
+ * page is cut at the page, and a caret off the page moves to the top of the view. */
+static void RestoreView(LargeFile* largeFile, unsigned long long top, unsigned long long anchor,
+                        unsigned long long caret, LRESULT xOffset)
+{
+    HWND editor = largeFile->editor;
+    if (caret < largeFile->pageStart || caret > largeFile->pageEnd) {
+        anchor = caret = top;
+    }
+    if (anchor < largeFile->pageStart) {
+        anchor = largeFile->pageStart;
+    } else if (anchor > largeFile->pageEnd) {
+        anchor = largeFile->pageEnd;
+    }
+    SendMessage(editor, SCI_SETANCHOR, (WPARAM)(anchor - largeFile->pageStart), 0);
+    SendMessage(editor, SCI_SETCURRENTPOS, (WPARAM)(caret - largeFile->pageStart), 0);
+
+    LRESULT line = SendMessage(editor, SCI_LINEFROMPOSITION, (WPARAM)(top - largeFile->pageStart), 0);
+    SendMessage(editor, SCI_SETFIRSTVISIBLELINE, SendMessage(editor, SCI_VISIBLEFROMDOCLINE, line, 0), 0);
+    SendMessage(editor, SCI_SETXOFFSET, xOffset, 0);
+}
+
+void LargeFileMovePage(LargeFile* largeFile)
+{
+    if (!IsLargeFileOpen(largeFile)) {
+        return;
+    }
+    largeFile->pagePending = FALSE;
+    if (!IsViewNearPageEnd(largeFile)) {
+        return;
+    }
+
+    HWND editor = largeFile->editor;
+    unsigned long long top, bottom;
+    GetViewRange(largeFile, &top, &bottom);
+    unsigned long long anchor = largeFile->pageStart + SendMessage(editor, SCI_GETANCHOR, 0, 0);
+    unsigned long long caret = largeFile->pageStart + SendMessage(editor, SCI_GETCURRENTPOS, 0, 0);
+    LRESULT xOffset = SendMessage(editor, SCI_GETXOFFSET, 0, 0);
+
+    if (ShowPageAround(largeFile, top)) {
+        RestoreView(largeFile, top, anchor, caret, xOffset);
+    }
+    largeFile->pageStuck = IsViewNearPageEnd(largeFile);
+    if (IsLargeFileSelected(largeFile)) {
+        UpdateLargeFileStatus(largeFile);
+    }
+}
+
+/* Select [start, end) of the file and scroll to it, showing a new page first unless the
+ * range is well inside this one */
+static void SelectFileRange(LargeFile* largeFile, unsigned long long start, unsigned long long end)
+{
+    if (!IsWellInPage(largeFile, start) || !IsWellInPage(largeFile, end)) {
+        ShowPageAround(largeFile, start);
+    }
+    if (end > largeFile->pageEnd) {
+        end = largeFile->pageEnd;
+    }
+    SendMessage(largeFile->editor, SCI_SETSEL, (WPARAM)(start - largeFile->pageStart), (LPARAM)(end - largeFile->pageStart));
+    SendMessage(largeFile->editor, SCI_SCROLLCARET, 0, 0);
+    largeFile->pageStuck = FALSE;
+    if (IsLargeFileSelected(largeFile)) {
+        UpdateLargeFileStatus(largeFile);
+    }
+}
+
+BOOL LargeFileKeyDown(HWND editor, WPARAM key)
+{
+    if ((key != VK_HOME && key != VK_END) || !(GetKeyState(VK_CONTROL) & 0x8000) ||
+        (GetKeyState(VK_SHIFT) & 0x8000) || (GetKeyState(VK_MENU) & 0x8000)) {
+        return FALSE;
+    }
+    LargeFile* largeFile = GetLargeFileForEditor(editor);
+    if (!largeFile) {
+        return FALSE;
+    }
+    unsigned long long offset = (key == VK_HOME) ? largeFile->dataStart : largeFile->file.size;
+    SelectFileRange(largeFile, offset, offset);
+    return TRUE;
+}
+
+long long LargeFileLinesIndexed(LargeFile* largeFile, long long* estimate)
+{
+    long long lines = ReadShared(&largeFile->indexedLineEnds) + 1;
+    if (estimate) {
+        unsigned long long indexed = (unsigned long long)ReadShared(&largeFile->indexedBytes) - largeFile->dataStart;
+        unsigned long long total = largeFile->file.size - largeFile->dataStart;
+        if (largeFile->indexDone || indexed == 0) {
+            *estimate = lines;
+        } else {
+            *estimate = (long long)((double)(lines - 1) * total / indexed) + 1;
+        }
+    }
+    return lines;
+}
+
+long long LargeFileCaretLine(LargeFile* largeFile)
+{
+    if (largeFile->pageLine < 0) {
+        return -1;
+    }
+    LRESULT pos = SendMessage(largeFile->editor, SCI_GETCURRENTPOS, 0, 0);
+    return largeFile->pageLine + SendMessage(largeFile->editor, SCI_LINEFROMPOSITION, pos, 0);
+}
+
+BOOL LargeFileGoToLine(LargeFile* largeFile, long long line)
+{
+    unsigned long long offset;
+    if (!LineStartOffset(largeFile, line, &offset)) {
+        return FALSE;
+    }
+    SelectFileRange(largeFile, offset, offset);
+    return TRUE;
+}
+
+/* End of a chunk to search starting at start - LARGEFILE_SCAN_CHUNK on at most, after a line
+ * end so a regular expression sees whole lines, or cut like a long line */
+static unsigned long long ChunkEndAfter(LargeFile* largeFile, MappedFile* mf, unsigned long long start,
+                                        unsigned long long to)
+{
+    if (to - start <= LARGEFILE_SCAN_CHUNK) {
+        return to;
+    }
+    unsigned long long limit = start + LARGEFILE_SCAN_CHUNK;
+    unsigned long long low = limit - LARGEFILE_SCAN_CHUNK / 2;
+    const char* data = MapFileRange(mf, low, (size_t)(limit - low));
+    if (data) {
+        for (const char* p = data + (limit - low); p > data; p--) {
+            if (p[-1] == largeFile->lineEnd) {
+                return low + (p - data);
+            }
+        }
+    }
+    return CharBoundary(largeFile, mf, limit);
+}
+
+/* Start of a chunk to search ending at end - the mirror of ChunkEndAfter */
+static unsigned long long ChunkStartBefore(LargeFile* largeFile, MappedFile* mf, unsigned long long end,
+                                           unsigned long long from)
+{
+    if (end - from <= LARGEFILE_SCAN_CHUNK) {
+        return from;
+    }
+    unsigned long long start = end - LARGEFILE_SCAN_CHUNK;
+    const char* data = MapFileRange(mf, start, LARGEFILE_SCAN_CHUNK / 2);
+    if (data) {
+        const char* p = (const char*)memchr(data, largeFile->lineEnd, LARGEFILE_SCAN_CHUNK / 2);
+        if (p) {
+            return start + (p - data) + 1;
+        }
+    }
+    return CharBoundary(largeFile, mf, start);
+}
+
+/* Count a searched chunk towards the progress shown, posting WM_LARGEFILE_SEARCH as each
+ * percent of the file is searched. Returns FALSE once the search is cancelled. */
+static BOOL SearchProgress(LargeFileSearch* job, size_t length)
+{
+    LargeFile* largeFile = job->largeFile;
+    job->searched += length;
+    LONG percent = (LONG)(job->searched * 100 / (largeFile->file.size - largeFile->dataStart + 1));
+    if (percent != job->percent) {
+        InterlockedExchange(&job->percent, percent);
+        PostMessage(largeFile->notifyWindow, WM_LARGEFILE_SEARCH, 0, (LPARAM)job);
+    }
+    return !job->cancelled;
+}
+
+/* First match in [from, to) of the file. Returns 1 when found, 0 when not, -1 when cancelled. */
+static int FindForward(LargeFileSearch* job, MappedFile* mf, unsigned long long from, unsigned long long to)
+{
+    LargeFile* largeFile = job->largeFile;
+    /* Start at the line start so a regular expression sees the line from its start */
+    unsigned long long chunkStart = LineStartBefore(largeFile, mf, from);
+    while (chunkStart < to) {
+        unsigned long long chunkEnd = ChunkEndAfter(largeFile, mf, chunkStart, to);
+        size_t length = (size_t)(chunkEnd - chunkStart);
+        const char* data = MapFileRange(mf, chunkStart, length);
+        if (!data) {
+            return 0;
+        }
+        size_t start = (from > chunkStart) ? (size_t)(from - chunkStart) : 0;
+        size_t ms, me;
+        if (ByteSearchFind(job->search, data, length, start, &ms, &me)) {
+            job->matchStart = chunkStart + ms;
+            job->matchEnd = chunkStart + me;
+            return 1;
+        }
+        chunkStart = chunkEnd;
+        if (!SearchProgress(job, length)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Last match in [from, to) of the file. Returns 1 when found, 0 when not, -1 when cancelled. */
+static int FindBackward(LargeFileSearch* job, MappedFile* mf, unsigned long long from, unsigned long long to)
+{
+    LargeFile* largeFile = job->largeFile;
+    unsigned long long chunkEnd = to;
+    while (chunkEnd > from) {
+        unsigned long long chunkStart = ChunkStartBefore(largeFile, mf, chunkEnd, from);
+        size_t length = (size_t)(chunkEnd - chunkStart);
+        const char* data = MapFileRange(mf, chunkStart, length);
+        if (!data) {
+            return 0;
+        }
+        BOOL found = FALSE;
+        size_t position = 0;
+        size_t ms, me;
+        while (position <= length && ByteSearchFind(job->search, data, length, position, &ms, &me)) {
+            found = TRUE;
+            job->matchStart = chunkStart + ms;
+            job->matchEnd = chunkStart + me;
+            position = (me > ms) ? me : ms + 1;
+        }
+        if (found) {
+            return 1;
+        }
+        chunkEnd = chunkStart;
+        if (!SearchProgress(job, length)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Matches in the whole file, -1 when cancelled or the file can't be read */
+static long long CountAll(LargeFileSearch* job, MappedFile* mf)
+{
+    LargeFile* largeFile = job->largeFile;
+    long long count = 0;
+    unsigned long long chunkStart = largeFile->dataStart;
+    while (chunkStart < largeFile->file.size) {
+        unsigned long long chunkEnd = ChunkEndAfter(largeFile, mf, chunkStart, largeFile->file.size);
+        size_t length = (size_t)(chunkEnd - chunkStart);
+        const char* data = MapFileRange(mf, chunkStart, length);
+        if (!data) {
+            return -1;
+        }
+        size_t position = 0;
+        size_t ms, me;
+        while (position <= length && ByteSearchFind(job->search, data, length, position, &ms, &me)) {
+            count++;
+            position = (me > ms) ? me : ms + 1;
+        }
+        chunkStart = chunkEnd;
+        if (!SearchProgress(job, length)) {
+            return -1;
+        }
+    }
+    return count;
+}
+
+/* Worker thread for a search - reads the file through its own mapping and posts
+ * WM_LARGEFILE_SEARCH once done */
+static DWORD WINAPI LargeFileSearchThreadProc(LPVOID param)
+{
+    LargeFileSearch* job = (LargeFileSearch*)param;
+    LargeFile* largeFile = job->largeFile;
+    unsigned long long size = largeFile->file.size;
+    MappedFile mf;
+
+    job->found = 0;
+    job->count = -1;
+    if (OpenMappedFile(&mf, largeFile->filePath)) {
+        mf.viewLimit = LARGEFILE_VIEW_SIZE;
+        if (job->counting) {
+            job->count = CountAll(job, &mf);
+        } else if (job->forward) {
+            job->found = FindForward(job, &mf, job->selEnd, size);
+            if (job->found == 0) {
+                job->found = FindForward(job, &mf, largeFile->dataStart, job->selEnd);
+            }
+        } else {
+            job->found = FindBackward(job, &mf, largeFile->dataStart, job->selStart);
+            if (job->found == 0) {
+                job->found = FindBackward(job, &mf, job->selStart, size);
+            }
+        }
+        CloseMappedFile(&mf);
+    }
+
+    InterlockedExchange(&job->done, 1);
+    PostMessage(largeFile->notifyWindow, WM_LARGEFILE_SEARCH, 0, (LPARAM)job);
+    return 0;
+}
+
+/* Start a search of the whole file on a worker, stopping any search already running */
+static int StartSearch(LargeFile* largeFile, const char* text, int searchFlags, BOOL counting, BOOL forward)
+{
+    void* search = ByteSearchCreate(text, strlen(text), searchFlags);
+    if (!search) {
+        return -1;
+    }
+    FinishLargeFileSearch();
+
+    LargeFileSearch* job = (LargeFileSearch*)calloc(1, sizeof(LargeFileSearch));
+    if (!job) {
+        ByteSearchRelease(search);
+        return 0;
+    }
+    HWND editor = largeFile->editor;
+    job->largeFile = largeFile;
+    job->search = search;
+    job->counting = counting;
+    job->forward = forward;
+    job->selStart = largeFile->pageStart + SendMessage(editor, SCI_GETSELECTIONSTART, 0, 0);
+    job->selEnd = largeFile->pageStart + SendMessage(editor, SCI_GETSELECTIONEND, 0, 0);
+    job->percent = -1;
+    job->thread = CreateThread(NULL, 0, LargeFileSearchThreadProc, job, 0, NULL);
+    if (!job->thread) {
+        FreeSearch(job);
+        return 0;
+    }
+    g_largeFileSearch = job;
+    ShowStatusBarProgress("Searching... (Esc or click to cancel)", 0);
+    return 1;
+}
+
+int LargeFileFind(LargeFile* largeFile, const char* text, int searchFlags, BOOL forward)
+{
+    return StartSearch(largeFile, text, searchFlags, FALSE, forward);
+}
+
+int LargeFileCountMatches(LargeFile* largeFile, const char* text, int searchFlags)
+{
+    return StartSearch(largeFile, text, searchFlags, TRUE, TRUE);
+}
+
+void LargeFileSearched(LPARAM lParam)
+{
+    /* Progress of a search since replaced, or one already handled */
+    LargeFileSearch* job = (LargeFileSearch*)lParam;
+    if (job != g_largeFileSearch) {
+        return;
+    }
+    if (!job->done) {
+        char text[64];
+        snprintf(text, sizeof(text), "Searching... %d%% (Esc or click to cancel)", (int)job->percent);
+        ShowStatusBarProgress(text, (int)job->percent);
+        return;
+    }
+
+    g_largeFileSearch = NULL;
+    WaitForSingleObject(job->thread, INFINITE);
+    HideStatusBarProgress();
+    if (!job->cancelled) {
+        if (job->counting) {
+            if (job->count >= 0) {
+                FindAllDone((INT_PTR)job->count);
+            }
+        } else if (job->found > 0) {
+            SelectFileRange(job->largeFile, job->matchStart, job->matchEnd);
+        } else if (job->found == 0) {
+            FindNextNotFound(job->largeFile->notifyWindow);
+        }
+    }
+    FreeSearch(job);
+}
+
+BOOL CancelLargeFileSearch(void)
+{
+    if (!g_largeFileSearch || g_largeFileSearch->cancelled) {
+        return FALSE;
+    }
+    InterlockedExchange(&g_largeFileSearch->cancelled, 1);
+    return TRUE;
+}
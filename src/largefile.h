@@ -0,0 +1,89 @@
+/*
+ * Large file viewer header for Notepad+
+ * Shows files too large to load a page at a time, read-only, straight from a file mapping
+ */
+
+#ifndef LARGEFILE_H
+#define LARGEFILE_H
+
+#include <windows.h>
+#include "fileops.h"
+
+/* Files at least this large open in the viewer instead of being loaded (bytes) */
+#define LARGEFILE_SIZE              (1024ULL * 1024 * 1024)
+
+/* Text shown at a time - a new page is shown around the view when it comes within
+ * LARGEFILE_PAGE_MARGIN of either end of the page (bytes) */
+#define LARGEFILE_PAGE_SIZE         (1024 * 1024)
+#define LARGEFILE_PAGE_MARGIN       (64 * 1024)
+
+/* The line index keeps the start of every LARGEFILE_INDEX_STEP-th line - the lines between are
+ * found by scanning on from the nearest one. Starts are kept in blocks of LARGEFILE_INDEX_BLOCK. */
+#define LARGEFILE_INDEX_STEP        1024
+#define LARGEFILE_INDEX_BLOCK       65536
+
+/* The file is mapped LARGEFILE_VIEW_SIZE bytes at a time so the memory used doesn't grow with
+ * the file; searches and the line index read it LARGEFILE_SCAN_CHUNK bytes at a time */
+#define LARGEFILE_VIEW_SIZE         (4 * 1024 * 1024)
+#define LARGEFILE_SCAN_CHUNK        (2 * 1024 * 1024)
+
+/* Viewer notifications - lParam is the LargeFile. INDEX is posted as each percent of the file is
+ * indexed and when indexing ends, PAGE when the view has come near an end of the page.
+ * SEARCH is posted the same way for a search, with lParam identifying the search. */
+#define WM_LARGEFILE_INDEX          (WM_APP + 6)
+#define WM_LARGEFILE_PAGE           (WM_APP + 7)
+#define WM_LARGEFILE_SEARCH         (WM_APP + 9)
+
+typedef struct LargeFile LargeFile;
+
+/* Show a file in an editor a page at a time and start indexing its lines on a worker thread.
+ * Fills info like LoadFileIntoEditor. Returns NULL when the file can't be opened or is UTF-16,
+ * which can't be shown from the mapping as it is. */
+LargeFile* OpenLargeFile(HWND editor, const char* filePath, HWND notifyWindow, FileInfo* info);
+void FreeLargeFile(LargeFile* largeFile);
+
+/* The viewer an editor shows, NULL for an editor with a normal document */
+LargeFile* GetLargeFileForEditor(HWND editor);
+
+/* WM_LARGEFILE_INDEX and WM_LARGEFILE_PAGE handlers - ignore viewers closed since posting */
+void LargeFileIndexed(LargeFile* largeFile);
+void LargeFileMovePage(LargeFile* largeFile);
+
+/* Call for every SCN_UPDATEUI of the editor - asks for a new page when the view nears an end */
+void LargeFileUpdateView(LargeFile* largeFile);
+
+/* Show the caret's line, column and file offset in the status bar */
+void UpdateLargeFileStatus(LargeFile* largeFile);
+
+/* Handle Ctrl+Home and Ctrl+End for an editor showing a large file, which go to the start and
+ * end of the file rather than of the page. Returns TRUE when the key was handled. */
+BOOL LargeFileKeyDown(HWND editor, WPARAM key);
+
+/* Line the caret is on, -1 while indexing hasn't reached it */
+long long LargeFileCaretLine(LargeFile* largeFile);
+
+/* Lines that can be gone to - all of them once indexing is done. *estimate is set to the
+ * expected line count while indexing and to the line count after. */
+long long LargeFileLinesIndexed(LargeFile* largeFile, long long* estimate);
+BOOL LargeFileGoToLine(LargeFile* largeFile, long long line);
+
+/* Start searching the whole file from the selection on a worker thread, wrapping around,
+ * stopping any search already running. searchFlags are SCFIND_* flags. The match is selected
+ * once found, or FindNextNotFound called when there is none.
+ * Returns 1 when the search started, 0 when it couldn't, -1 for an invalid pattern. */
+int LargeFileFind(LargeFile* largeFile, const char* text, int searchFlags, BOOL forward);
+
+/* Start counting the matches in the whole file like LargeFileFind - the count is shown
+ * through FindAllDone */
+int LargeFileCountMatches(LargeFile* largeFile, const char* text, int searchFlags);
+
+/* WM_LARGEFILE_SEARCH handler - shows the search's progress in the status bar, then its result */
+void LargeFileSearched(LPARAM lParam);
+
+/* Cancel the running search, for Escape and the progress pane. Returns FALSE when there is none. */
+BOOL CancelLargeFileSearch(void);
+
+/* Stop the running search and wait for its worker */
+void FinishLargeFileSearch(void);
+
+#endif /* LARGEFILE_H */
@@ -98,460 +98,2381 @@ static const char* g_VerilogKeywords =
 static const char* g_VhdlKeywords =
     "abs access after alias all and architecture array assert attribute begin block body buffer bus case component configuration constant disconnect downto else elsif end entity exit file for function generate generic group guarded if impure in inertial inout is label library linkage literal loop map mod nand new next nor not null of on open or others out package port postponed procedure process pure range record register reject rem report return rol ror select severity signal shared sla sll sra srl subtype then to transport type unaffected units until use variable wait when while with xnor xor";
 
-/* Extension to LanguageType mapping - generated from GitHub Linguist */
-const ExtensionMapping g_extensionMappings[] = {
-    {".4dform", LANG_JSON},
-    {".4dproject", LANG_JSON},
-    {"._coffee", LANG_COFFEESCRIPT},
-    {"._js", LANG_JAVASCRIPT},
-    {".a51", LANG_ASSEMBLY},
-    {".ada", LANG_ADA},
-    {".adb", LANG_ADA},
-    {".adml", LANG_XML},
-    {".admx", LANG_XML},
-    {".adp", LANG_TCL},
-    {".ads", LANG_ADA},
-    {".al", LANG_PERL},
-    {".ant", LANG_XML},
-    {".app", LANG_ERLANG},
-    {".app.src", LANG_ERLANG},
-    {".asm", LANG_ASSEMBLY},
-    {".aux", LANG_TEX},
-    {".avsc", LANG_JSON},
-    {".axaml", LANG_XML},
-    {".axml", LANG_XML},
-    {".bash", LANG_SHELL},
-    {".bat", LANG_BATCHFILE},
-    {".bats", LANG_SHELL},
-    {".bb", LANG_CLOJURE},
-    {".bbx", LANG_TEX},
-    {".bones", LANG_JAVASCRIPT},
-    {".boot", LANG_CLOJURE},
-    {".builder", LANG_RUBY},
-    {".builds", LANG_XML},
-    {".c", LANG_C},
-    {".c++", LANG_CPP},
-    {".cake", LANG_COFFEESCRIPT},
-    {".cats", LANG_C},
-    {".cbl", LANG_COBOL},
-    {".cbx", LANG_TEX},
-    {".cc", LANG_CPP},
-    {".ccp", LANG_COBOL},
-    {".ccproj", LANG_XML},
-    {".ccxml", LANG_XML},
-    {".cfg", LANG_INI},
-    {".cgi", LANG_SHELL},
-    {".cjs", LANG_JAVASCRIPT},
-    {".cjsx", LANG_COFFEESCRIPT},
-    {".cl2", LANG_CLOJURE},
-    {".clixml", LANG_XML},
-    {".clj", LANG_CLOJURE},
-    {".cljc", LANG_CLOJURE},
-    {".cljs", LANG_CLOJURE},
-    {".cljs.hl", LANG_CLOJURE},
-    {".cljscm", LANG_CLOJURE},
-    {".cljx", LANG_CLOJURE},
-    {".cls", LANG_TEX},
-    {".cmake", LANG_CMAKE},
-    {".cmake.in", LANG_CMAKE},
-    {".cmd", LANG_BATCHFILE},
-    {".cnf", LANG_INI},
-    {".cob", LANG_COBOL},
-    {".cobol", LANG_COBOL},
-    {".coffee", LANG_COFFEESCRIPT},
-    {".command", LANG_SHELL},
-    {".containerfile", LANG_DOCKERFILE},
-    {".cp", LANG_CPP},
-    {".cpp", LANG_CPP},
-    {".cppm", LANG_CPP},
-    {".cproject", LANG_XML},
-    {".cpy", LANG_COBOL},
-    {".cs", LANG_CS},
-    {".cs.pp", LANG_CS},
-    {".cscfg", LANG_XML},
-    {".csdef", LANG_XML},
-    {".csl", LANG_XML},
-    {".csproj", LANG_XML},
-    {".css", LANG_CSS},
-    {".csv", LANG_CSV},
-    {".csx", LANG_CS},
-    {".ct", LANG_XML},
-    {".cts", LANG_TYPESCRIPT},
-    {".cxx", LANG_CPP},
-    {".d", LANG_MAKEFILE},
-    {".dart", LANG_DART},
-    {".ddl", LANG_SQL},
-    {".depproj", LANG_XML},
-    {".dfm", LANG_PASCAL},
-    {".di", LANG_D},
-    {".diff", LANG_DIFF},
-    {".dita", LANG_XML},
-    {".ditamap", LANG_XML},
-    {".ditaval", LANG_XML},
-    {".dll.config", LANG_XML},
-    {".dockerfile", LANG_DOCKERFILE},
-    {".dof", LANG_INI},
-    {".dotsettings", LANG_XML},
-    {".dpr", LANG_PASCAL},
-    {".dtx", LANG_TEX},
-    {".eliom", LANG_OCAML},
-    {".eliomi", LANG_OCAML},
-    {".erl", LANG_ERLANG},
-    {".es", LANG_JAVASCRIPT},
-    {".es6", LANG_JAVASCRIPT},
-    {".escript", LANG_ERLANG},
-    {".ex", LANG_ELIXIR},
-    {".exs", LANG_ELIXIR},
-    {".eye", LANG_RUBY},
-    {".f", LANG_FORTRAN},
-    {".f77", LANG_FORTRAN},
-    {".fcgi", LANG_SHELL},
-    {".filters", LANG_XML},
-    {".for", LANG_FORTRAN},
-    {".fpp", LANG_FORTRAN},
-    {".frag", LANG_JAVASCRIPT},
-    {".frm", LANG_INI},
-    {".fs", LANG_FS},
-    {".fsi", LANG_FS},
-    {".fsproj", LANG_XML},
-    {".fsx", LANG_FS},
-    {".fun", LANG_STANDARD_ML},
-    {".fxml", LANG_XML},
-    {".gemspec", LANG_RUBY},
-    {".geojson", LANG_JSON},
-    {".glade", LANG_XML},
-    {".gltf", LANG_JSON},
-    {".gml", LANG_XML},
-    {".gmx", LANG_XML},
-    {".go", LANG_GO},
-    {".god", LANG_RUBY},
-    {".gpx", LANG_XML},
-    {".gql", LANG_GRAPHQL},
-    {".graphql", LANG_GRAPHQL},
-    {".graphqls", LANG_GRAPHQL},
-    {".grxml", LANG_XML},
-    {".gs", LANG_JAVASCRIPT},
-    {".gst", LANG_XML},
-    {".gyp", LANG_PYTHON},
-    {".gypi", LANG_PYTHON},
-    {".h", LANG_OBJECTIVE_C},
-    {".h++", LANG_CPP},
-    {".h.in", LANG_C},
-    {".har", LANG_JSON},
-    {".hh", LANG_CPP},
-    {".hic", LANG_CLOJURE},
-    {".hpp", LANG_CPP},
-    {".hrl", LANG_ERLANG},
-    {".hs", LANG_HASKELL},
-    {".hs-boot", LANG_HASKELL},
-    {".hsc", LANG_HASKELL},
-    {".hta", LANG_HTML},
-    {".htm", LANG_HTML},
-    {".html", LANG_HTML},
-    {".html.hl", LANG_HTML},
-    {".http", LANG_HTTP},
-    {".hxx", LANG_CPP},
-    {".hzp", LANG_XML},
-    {".i", LANG_ASSEMBLY},
-    {".ice", LANG_JSON},
-    {".iced", LANG_COFFEESCRIPT},
-    {".idc", LANG_C},
-    {".iml", LANG_XML},
-    {".inc", LANG_SQL},
-    {".ini", LANG_INI},
-    {".inl", LANG_CPP},
-    {".ino", LANG_CPP},
-    {".ins", LANG_TEX},
-    {".ipp", LANG_CPP},
-    {".ivy", LANG_XML},
-    {".ixx", LANG_CPP},
-    {".jake", LANG_JAVASCRIPT},
-    {".jav", LANG_JAVA},
-    {".java", LANG_JAVA},
-    {".javascript", LANG_JAVASCRIPT},
-    {".jbuilder", LANG_RUBY},
-    {".jelly", LANG_XML},
-    {".jl", LANG_JULIA},
-    {".js", LANG_JAVASCRIPT},
-    {".jsb", LANG_JAVASCRIPT},
-    {".jscad", LANG_JAVASCRIPT},
-    {".jsfl", LANG_JAVASCRIPT},
-    {".jsh", LANG_JAVA},
-    {".jslib", LANG_JAVASCRIPT},
-    {".jsm", LANG_JAVASCRIPT},
-    {".json", LANG_JSON},
-    {".json-tmlanguage", LANG_JSON},
-    {".json.example", LANG_JSON},
-    {".jsonl", LANG_JSON},
-    {".jspre", LANG_JAVASCRIPT},
-    {".jsproj", LANG_XML},
-    {".jss", LANG_JAVASCRIPT},
-    {".jsx", LANG_JAVASCRIPT},
-    {".kml", LANG_XML},
-    {".kojo", LANG_SCALA},
-    {".ksh", LANG_SHELL},
-    {".kt", LANG_KOTLIN},
-    {".ktm", LANG_KOTLIN},
-    {".kts", LANG_KOTLIN},
-    {".launch", LANG_XML},
-    {".lbx", LANG_TEX},
-    {".lektorproject", LANG_INI},
-    {".less", LANG_LESS},
-    {".linq", LANG_CS},
-    {".livemd", LANG_MARKDOWN},
-    {".lmi", LANG_PYTHON},
-    {".lpr", LANG_PASCAL},
-    {".ltx", LANG_TEX},
-    {".lua", LANG_LUA},
-    {".m", LANG_OBJECTIVE_C},
-    {".mak", LANG_MAKEFILE},
-    {".make", LANG_MAKEFILE},
-    {".makefile", LANG_MAKEFILE},
-    {".markdown", LANG_MARKDOWN},
-    {".matlab", LANG_MATLAB},
-    {".mcmeta", LANG_JSON},
-    {".md", LANG_MARKDOWN},
-    {".mdown", LANG_MARKDOWN},
-    {".mdpolicy", LANG_XML},
-    {".mdwn", LANG_MARKDOWN},
-    {".mir", LANG_YAML},
-    {".mjml", LANG_XML},
-    {".mjs", LANG_JAVASCRIPT},
-    {".mk", LANG_MAKEFILE},
-    {".mkd", LANG_MARKDOWN},
-    {".mkdn", LANG_MARKDOWN},
-    {".mkdown", LANG_MARKDOWN},
-    {".mkfile", LANG_MAKEFILE},
-    {".mkii", LANG_TEX},
-    {".mkiv", LANG_TEX},
-    {".mkvi", LANG_TEX},
-    {".ml", LANG_STANDARD_ML},
-    {".ml4", LANG_OCAML},
-    {".mli", LANG_OCAML},
-    {".mll", LANG_OCAML},
-    {".mly", LANG_OCAML},
-    {".mm", LANG_XML},
-    {".mod", LANG_XML},
-    {".mojo", LANG_XML},
-    {".mspec", LANG_RUBY},
-    {".mts", LANG_TYPESCRIPT},
-    {".mxml", LANG_XML},
-    {".mysql", LANG_SQL},
-    {".nas", LANG_ASSEMBLY},
-    {".nasm", LANG_ASSEMBLY},
-    {".natvis", LANG_XML},
-    {".ncl", LANG_XML},
-    {".ndproj", LANG_XML},
-    {".nim", LANG_NIM},
-    {".nim.cfg", LANG_NIM},
-    {".nimble", LANG_NIM},
-    {".nimrod", LANG_NIM},
-    {".nims", LANG_NIM},
-    {".njs", LANG_JAVASCRIPT},
-    {".nproj", LANG_XML},
-    {".nse", LANG_LUA},
-    {".nuspec", LANG_XML},
-    {".odd", LANG_XML},
-    {".osm", LANG_XML},
-    {".p8", LANG_LUA},
-    {".pac", LANG_JAVASCRIPT},
-    {".pas", LANG_PASCAL},
-    {".pascal", LANG_PASCAL},
-    {".patch", LANG_DIFF},
-    {".pd_lua", LANG_LUA},
-    {".perl", LANG_PERL},
-    {".ph", LANG_PERL},
-    {".pkgproj", LANG_XML},
-    {".pl", LANG_PERL},
-    {".pluginspec", LANG_XML},
-    {".plx", LANG_PERL},
-    {".pm", LANG_PERL},
-    {".podspec", LANG_RUBY},
-    {".pp", LANG_PASCAL},
-    {".prawn", LANG_RUBY},
-    {".prc", LANG_SQL},
-    {".prefs", LANG_INI},
-    {".pro", LANG_INI},
-    {".proj", LANG_XML},
-    {".properties", LANG_INI},
-    {".props", LANG_XML},
-    {".ps1", LANG_POWERSHELL},
-    {".ps1xml", LANG_XML},
-    {".psc1", LANG_XML},
-    {".psd1", LANG_POWERSHELL},
-    {".psgi", LANG_PERL},
-    {".psm1", LANG_POWERSHELL},
-    {".pt", LANG_XML},
-    {".pubxml", LANG_XML},
-    {".py", LANG_PYTHON},
-    {".py3", LANG_PYTHON},
-    {".pyde", LANG_PYTHON},
-    {".pyi", LANG_PYTHON},
-    {".pyp", LANG_PYTHON},
-    {".pyt", LANG_PYTHON},
-    {".pyw", LANG_PYTHON},
-    {".qhelp", LANG_XML},
-    {".r", LANG_R},
-    {".rabl", LANG_RUBY},
-    {".rake", LANG_RUBY},
-    {".rb", LANG_RUBY},
-    {".rbi", LANG_RUBY},
-    {".rbuild", LANG_RUBY},
-    {".rbw", LANG_RUBY},
-    {".rbx", LANG_RUBY},
-    {".rbxs", LANG_LUA},
-    {".rd", LANG_R},
-    {".rdf", LANG_XML},
-    {".re", LANG_CPP},
-    {".reek", LANG_YAML},
-    {".reg", LANG_WINDOWS_REGISTRY},
-    {".res", LANG_XML},
-    {".rest", LANG_RESTRUCTUREDTEXT},
-    {".rest.txt", LANG_RESTRUCTUREDTEXT},
-    {".resx", LANG_XML},
-    {".rockspec", LANG_LUA},
-    {".ronn", LANG_MARKDOWN},
-    {".rpy", LANG_PYTHON},
-    {".rs", LANG_XML},
-    {".rs.in", LANG_RUST},
-    {".rss", LANG_XML},
-    {".rst", LANG_RESTRUCTUREDTEXT},
-    {".rst.txt", LANG_RESTRUCTUREDTEXT},
-    {".rsx", LANG_R},
-    {".ru", LANG_RUBY},
-    {".ruby", LANG_RUBY},
-    {".rviz", LANG_YAML},
-    {".s", LANG_ASSEMBLY},
-    {".sarif", LANG_JSON},
-    {".sass", LANG_SASS},
-    {".sbatch", LANG_SHELL},
-    {".sbt", LANG_SCALA},
-    {".sc", LANG_SCALA},
-    {".scala", LANG_SCALA},
-    {".scd", LANG_MARKDOWN},
-    {".sch", LANG_XML},
-    {".scss", LANG_SCSS},
-    {".scxml", LANG_XML},
-    {".sdc", LANG_TCL},
-    {".sfproj", LANG_XML},
-    {".sh", LANG_SHELL},
-    {".sh.in", LANG_SHELL},
-    {".shproj", LANG_XML},
-    {".sig", LANG_STANDARD_ML},
-    {".sjs", LANG_JAVASCRIPT},
-    {".slnx", LANG_XML},
-    {".slurm", LANG_SHELL},
-    {".sml", LANG_STANDARD_ML},
-    {".spec", LANG_RUBY},
-    {".sql", LANG_SQL},
-    {".srdf", LANG_XML},
-    {".ssjs", LANG_JAVASCRIPT},
-    {".storyboard", LANG_XML},
-    {".sty", LANG_TEX},
-    {".sublime-snippet", LANG_XML},
-    {".sublime-syntax", LANG_YAML},
-    {".sw", LANG_XML},
-    {".swift", LANG_SWIFT},
-    {".syntax", LANG_YAML},
-    {".t", LANG_PERL},
-    {".tab", LANG_SQL},
-    {".tac", LANG_PYTHON},
-    {".tact", LANG_JSON},
-    {".targets", LANG_XML},
-    {".tcc", LANG_CPP},
-    {".tcl", LANG_TCL},
-    {".tcl.in", LANG_TCL},
-    {".tex", LANG_TEX},
-    {".tfstate", LANG_JSON},
-    {".tfstate.backup", LANG_JSON},
-    {".thor", LANG_RUBY},
-    {".tm", LANG_TCL},
-    {".tml", LANG_XML},
-    {".tmux", LANG_SHELL},
-    {".toc", LANG_TEX},
-    {".toml", LANG_TOML},
-    {".toml.example", LANG_TOML},
-    {".tool", LANG_SHELL},
-    {".topojson", LANG_JSON},
-    {".tpp", LANG_CPP},
-    {".trigger", LANG_SHELL},
-    {".ts", LANG_TYPESCRIPT},
-    {".tsv", LANG_TSV},
-    {".tsx", LANG_TYPESCRIPT},
-    {".txx", LANG_CPP},
-    {".typ", LANG_XML},
-    {".udf", LANG_SQL},
-    {".ui", LANG_XML},
-    {".urdf", LANG_XML},
-    {".url", LANG_INI},
-    {".ux", LANG_XML},
-    {".v", LANG_VERILOG},
-    {".vbproj", LANG_XML},
-    {".vcf", LANG_TSV},
-    {".vcxproj", LANG_XML},
-    {".veo", LANG_VERILOG},
-    {".vhd", LANG_VHDL},
-    {".vhdl", LANG_VHDL},
-    {".vhf", LANG_VHDL},
-    {".vhi", LANG_VHDL},
-    {".vho", LANG_VHDL},
-    {".vhs", LANG_VHDL},
-    {".vht", LANG_VHDL},
-    {".vhw", LANG_VHDL},
-    {".viw", LANG_SQL},
-    {".vsixmanifest", LANG_XML},
-    {".vssettings", LANG_XML},
-    {".vstemplate", LANG_XML},
-    {".vxml", LANG_XML},
-    {".watchr", LANG_RUBY},
-    {".webapp", LANG_JSON},
-    {".webmanifest", LANG_JSON},
-    {".wixproj", LANG_XML},
-    {".wlua", LANG_LUA},
-    {".workbook", LANG_MARKDOWN},
-    {".workflow", LANG_XML},
-    {".wsdl", LANG_XML},
-    {".wsf", LANG_XML},
-    {".wsgi", LANG_PYTHON},
-    {".wxi", LANG_XML},
-    {".wxl", LANG_XML},
-    {".wxs", LANG_XML},
-    {".x3d", LANG_XML},
-    {".xacro", LANG_XML},
-    {".xaml", LANG_XML},
-    {".xdc", LANG_TCL},
-    {".xht", LANG_HTML},
-    {".xhtml", LANG_HTML},
-    {".xib", LANG_XML},
-    {".xlf", LANG_XML},
-    {".xliff", LANG_XML},
-    {".xmi", LANG_XML},
-    {".xml", LANG_XML},
-    {".xml.dist", LANG_XML},
-    {".xmp", LANG_XML},
-    {".xproj", LANG_XML},
-    {".xpy", LANG_PYTHON},
-    {".xrl", LANG_ERLANG},
-    {".xsd", LANG_XML},
-    {".xsjs", LANG_JAVASCRIPT},
-    {".xsjslib", LANG_JAVASCRIPT},
-    {".xspec", LANG_XML},
-    {".xul", LANG_XML},
-    {".yaml", LANG_YAML},
-    {".yaml-tmlanguage", LANG_YAML},
-    {".yaml.sed", LANG_YAML},
-    {".yml", LANG_YAML},
-    {".yml.mysql", LANG_YAML},
-    {".yrl", LANG_ERLANG},
-    {".yy", LANG_JSON},
-    {".yyp", LANG_JSON},
-    {".zcml", LANG_XML},
-    {".zig", LANG_ZIG},
-    {".zig.zon", LANG_ZIG},
-    {".zsh", LANG_SHELL},
-    {".zsh-theme", LANG_SHELL},
+/* Extension, file name, interpreter and alias to LanguageType perfect hash - generated from GitHub Linguist */
+const LanguageKey g_languageKeys[LANGUAGE_KEY_TABLE_SIZE] = {
+    [3] = {"coffee", 6, LANGUAGE_KEY_ALIAS, LANG_COFFEESCRIPT},
+    [4] = {".diff", 5, LANGUAGE_KEY_EXTENSION, LANG_DIFF},
+    [6] = {".xht", 4, LANGUAGE_KEY_EXTENSION, LANG_HTML},
+    [7] = {"zlogout", 7, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [8] = {".builds", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [10] = {"bun", 3, LANGUAGE_KEY_INTERPRETER, LANG_TYPESCRIPT},
+    [12] = {".mojo", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [13] = {".sarif", 6, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [14] = {".prc", 4, LANGUAGE_KEY_EXTENSION, LANG_SQL},
+    [15] = {"c", 1, LANGUAGE_KEY_ALIAS, LANG_C},
+    [17] = {".bat", 4, LANGUAGE_KEY_EXTENSION, LANG_BATCHFILE},
+    [18] = {"ash", 3, LANGUAGE_KEY_INTERPRETER, LANG_SHELL},
+    [23] = {".hxx", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [24] = {".pro", 4, LANGUAGE_KEY_EXTENSION, LANG_INI},
+    [26] = {"mvnw", 4, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [28] = {".rs.in", 6, LANGUAGE_KEY_EXTENSION, LANG_RUST},
+    [29] = {"mavenfile", 9, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [32] = {".inl", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [33] = {"shell-script", 12, LANGUAGE_KEY_ALIAS, LANG_SHELL},
+    [37] = {".hic", 4, LANGUAGE_KEY_EXTENSION, LANG_CLOJURE},
+    [40] = {".rbx", 4, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [43] = {"mvnw.cmd", 8, LANGUAGE_KEY_FILENAME, LANG_BATCHFILE},
+    [45] = {".zshrc", 6, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [48] = {".rbxs", 5, LANGUAGE_KEY_EXTENSION, LANG_LUA},
+    [49] = {".json-tmlanguage", 16, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [52] = {"powershell", 10, LANGUAGE_KEY_ALIAS, LANG_POWERSHELL},
+    [53] = {".r", 2, LANGUAGE_KEY_EXTENSION, LANG_R},
+    [54] = {".cts", 4, LANGUAGE_KEY_EXTENSION, LANG_TYPESCRIPT},
+    [55] = {"elixir", 6, LANGUAGE_KEY_ALIAS, LANG_ELIXIR},
+    [61] = {"xhtml", 5, LANGUAGE_KEY_ALIAS, LANG_HTML},
+    [65] = {".jelly", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [68] = {".hzp", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [69] = {".tfstate.backup", 15, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [71] = {".fcgi", 5, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [72] = {"fastfile", 8, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [74] = {"buildozer.spec", 14, LANGUAGE_KEY_FILENAME, LANG_INI},
+    [84] = {".scd", 4, LANGUAGE_KEY_EXTENSION, LANG_MARKDOWN},
+    [85] = {"cpanfile", 8, LANGUAGE_KEY_FILENAME, LANG_PERL},
+    [86] = {".scala", 6, LANGUAGE_KEY_EXTENSION, LANG_SCALA},
+    [87] = {".livemd", 7, LANGUAGE_KEY_EXTENSION, LANG_MARKDOWN},
+    [90] = {".hrl", 4, LANGUAGE_KEY_EXTENSION, LANG_ERLANG},
+    [91] = {".swift", 6, LANGUAGE_KEY_EXTENSION, LANG_SWIFT},
+    [94] = {".markdown", 9, LANGUAGE_KEY_EXTENSION, LANG_MARKDOWN},
+    [96] = {"sconscript", 10, LANGUAGE_KEY_FILENAME, LANG_PYTHON},
+    [101] = {".zig", 4, LANGUAGE_KEY_EXTENSION, LANG_ZIG},
+    [108] = {"perl", 4, LANGUAGE_KEY_ALIAS, LANG_PERL},
+    [119] = {"glide.lock", 10, LANGUAGE_KEY_FILENAME, LANG_YAML},
+    [121] = {".vcxproj", 8, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [125] = {"rake", 4, LANGUAGE_KEY_ALIAS, LANG_RUBY},
+    [126] = {".tmux.conf", 10, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [127] = {"zsh", 3, LANGUAGE_KEY_INTERPRETER, LANG_SHELL},
+    [128] = {".sjs", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [129] = {"coffee-script", 13, LANGUAGE_KEY_ALIAS, LANG_COFFEESCRIPT},
+    [130] = {"cmakelists.txt", 14, LANGUAGE_KEY_FILENAME, LANG_CMAKE},
+    [131] = {".mkdown", 7, LANGUAGE_KEY_EXTENSION, LANG_MARKDOWN},
+    [132] = {".wsdl", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [134] = {"containerfile", 13, LANGUAGE_KEY_ALIAS, LANG_DOCKERFILE},
+    [139] = {".cats", 5, LANGUAGE_KEY_EXTENSION, LANG_C},
+    [140] = {".kshrc", 6, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [148] = {".targets", 8, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [152] = {"citation.cff", 12, LANGUAGE_KEY_FILENAME, LANG_YAML},
+    [154] = {"makefile.frag", 13, LANGUAGE_KEY_FILENAME, LANG_MAKEFILE},
+    [155] = {".cljs", 5, LANGUAGE_KEY_EXTENSION, LANG_CLOJURE},
+    [156] = {"kshrc", 5, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [160] = {".zsh-theme", 10, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [161] = {"shell", 5, LANGUAGE_KEY_ALIAS, LANG_SHELL},
+    [163] = {"nasm", 4, LANGUAGE_KEY_ALIAS, LANG_ASSEMBLY},
+    [164] = {".adb", 4, LANGUAGE_KEY_EXTENSION, LANG_ADA},
+    [165] = {".vhs", 4, LANGUAGE_KEY_EXTENSION, LANG_VHDL},
+    [169] = {".watchmanconfig", 15, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [173] = {".mkd", 4, LANGUAGE_KEY_EXTENSION, LANG_MARKDOWN},
+    [175] = {"js", 2, LANGUAGE_KEY_INTERPRETER, LANG_JAVASCRIPT},
+    [177] = {"java", 4, LANGUAGE_KEY_ALIAS, LANG_JAVA},
+    [178] = {"podfile", 7, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [179] = {"python", 6, LANGUAGE_KEY_INTERPRETER, LANG_PYTHON},
+    [183] = {".tcl", 4, LANGUAGE_KEY_EXTENSION, LANG_TCL},
+    [184] = {".mkfile", 7, LANGUAGE_KEY_EXTENSION, LANG_MAKEFILE},
+    [185] = {".boot", 5, LANGUAGE_KEY_EXTENSION, LANG_CLOJURE},
+    [187] = {".veo", 4, LANGUAGE_KEY_EXTENSION, LANG_VERILOG},
+    [188] = {"ts-node", 7, LANGUAGE_KEY_INTERPRETER, LANG_TYPESCRIPT},
+    [190] = {".vhf", 4, LANGUAGE_KEY_EXTENSION, LANG_VHDL},
+    [194] = {"module.bazel.lock", 17, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [198] = {".vho", 4, LANGUAGE_KEY_EXTENSION, LANG_VHDL},
+    [202] = {".cfg", 4, LANGUAGE_KEY_EXTENSION, LANG_INI},
+    [203] = {".xacro", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [204] = {".bb", 3, LANGUAGE_KEY_EXTENSION, LANG_CLOJURE},
+    [206] = {"objectpascal", 12, LANGUAGE_KEY_ALIAS, LANG_PASCAL},
+    [209] = {"dosini", 6, LANGUAGE_KEY_ALIAS, LANG_INI},
+    [210] = {"dockerfile", 10, LANGUAGE_KEY_FILENAME, LANG_DOCKERFILE},
+    [211] = {"meson.build", 11, LANGUAGE_KEY_FILENAME, LANG_MESON},
+    [212] = {".csl", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [213] = {".cxx", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [216] = {".cmake", 6, LANGUAGE_KEY_EXTENSION, LANG_CMAKE},
+    [217] = {".srdf", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [218] = {".cobol", 6, LANGUAGE_KEY_EXTENSION, LANG_COBOL},
+    [224] = {"julia", 5, LANGUAGE_KEY_ALIAS, LANG_JULIA},
+    [233] = {"udiff", 5, LANGUAGE_KEY_ALIAS, LANG_DIFF},
+    [234] = {"yaml", 4, LANGUAGE_KEY_ALIAS, LANG_YAML},
+    [235] = {".ssjs", 5, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [237] = {"tsv", 3, LANGUAGE_KEY_ALIAS, LANG_TSV},
+    [238] = {".xpy", 4, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [239] = {".fsi", 4, LANGUAGE_KEY_EXTENSION, LANG_FS},
+    [240] = {".filters", 8, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [241] = {".dart", 5, LANGUAGE_KEY_EXTENSION, LANG_DART},
+    [242] = {".p8", 3, LANGUAGE_KEY_EXTENSION, LANG_LUA},
+    [243] = {".psgi", 5, LANGUAGE_KEY_EXTENSION, LANG_PERL},
+    [245] = {".cgi", 4, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [247] = {".frm", 4, LANGUAGE_KEY_EXTENSION, LANG_INI},
+    [250] = {".rest", 5, LANGUAGE_KEY_EXTENSION, LANG_RESTRUCTUREDTEXT},
+    [252] = {"rb", 2, LANGUAGE_KEY_ALIAS, LANG_RUBY},
+    [253] = {".cls", 4, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [254] = {"hosts", 5, LANGUAGE_KEY_FILENAME, LANG_INI},
+    [259] = {".tm", 3, LANGUAGE_KEY_EXTENSION, LANG_TCL},
+    [260] = {".csx", 4, LANGUAGE_KEY_EXTENSION, LANG_CS},
+    [261] = {".nas", 4, LANGUAGE_KEY_EXTENSION, LANG_ASSEMBLY},
+    [263] = {"xdc", 3, LANGUAGE_KEY_ALIAS, LANG_TCL},
+    [264] = {"owh", 3, LANGUAGE_KEY_FILENAME, LANG_TCL},
+    [266] = {".xsession", 9, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [270] = {"contents.lr", 11, LANGUAGE_KEY_FILENAME, LANG_MARKDOWN},
+    [273] = {".s", 2, LANGUAGE_KEY_EXTENSION, LANG_ASSEMBLY},
+    [274] = {".clj", 4, LANGUAGE_KEY_EXTENSION, LANG_CLOJURE},
+    [275] = {".xml.dist", 9, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [277] = {".vhw", 4, LANGUAGE_KEY_EXTENSION, LANG_VHDL},
+    [280] = {".slnx", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [286] = {".ph", 3, LANGUAGE_KEY_EXTENSION, LANG_PERL},
+    [287] = {".gst", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [288] = {".mk", 3, LANGUAGE_KEY_EXTENSION, LANG_MAKEFILE},
+    [292] = {".pas", 4, LANGUAGE_KEY_EXTENSION, LANG_PASCAL},
+    [294] = {"fortran", 7, LANGUAGE_KEY_ALIAS, LANG_FORTRAN},
+    [299] = {"perl", 4, LANGUAGE_KEY_INTERPRETER, LANG_PERL},
+    [301] = {"latex", 5, LANGUAGE_KEY_ALIAS, LANG_TEX},
+    [305] = {"tsx", 3, LANGUAGE_KEY_INTERPRETER, LANG_TYPESCRIPT},
+    [306] = {".tpp", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [311] = {".m", 2, LANGUAGE_KEY_EXTENSION, LANG_OBJECTIVE_C},
+    [313] = {".lmi", 4, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [316] = {".cpp", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [318] = {"pandoc", 6, LANGUAGE_KEY_ALIAS, LANG_MARKDOWN},
+    [319] = {".lpr", 4, LANGUAGE_KEY_EXTENSION, LANG_PASCAL},
+    [321] = {"bash_logout", 11, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [323] = {"zshenv", 6, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [326] = {"rebar.lock", 10, LANGUAGE_KEY_FILENAME, LANG_ERLANG},
+    [327] = {"deno.lock", 9, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [328] = {".mkdn", 5, LANGUAGE_KEY_EXTENSION, LANG_MARKDOWN},
+    [331] = {".erl", 4, LANGUAGE_KEY_EXTENSION, LANG_ERLANG},
+    [332] = {".htmlhintrc", 11, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [338] = {"csv", 3, LANGUAGE_KEY_ALIAS, LANG_CSV},
+    [340] = {"bun.lock", 8, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [347] = {"wscript", 7, LANGUAGE_KEY_FILENAME, LANG_PYTHON},
+    [348] = {"objc", 4, LANGUAGE_KEY_ALIAS, LANG_OBJECTIVE_C},
+    [351] = {".ml", 3, LANGUAGE_KEY_EXTENSION, LANG_STANDARD_ML},
+    [353] = {".vhdl", 5, LANGUAGE_KEY_EXTENSION, LANG_VHDL},
+    [357] = {"rexfile", 7, LANGUAGE_KEY_FILENAME, LANG_PERL},
+    [359] = {"yarn.lock", 9, LANGUAGE_KEY_FILENAME, LANG_YAML},
+    [360] = {".cscfg", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [361] = {".viw", 4, LANGUAGE_KEY_EXTENSION, LANG_SQL},
+    [362] = {".command", 8, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [363] = {".geojson", 8, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [364] = {".xrl", 4, LANGUAGE_KEY_EXTENSION, LANG_ERLANG},
+    [368] = {".jbuilder", 9, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [370] = {".ada", 4, LANGUAGE_KEY_EXTENSION, LANG_ADA},
+    [372] = {".prefs", 6, LANGUAGE_KEY_EXTENSION, LANG_INI},
+    [375] = {".sbt", 4, LANGUAGE_KEY_EXTENSION, LANG_SCALA},
+    [379] = {".sh", 3, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [381] = {".simplecov", 10, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [383] = {"rusthon", 7, LANGUAGE_KEY_ALIAS, LANG_PYTHON},
+    [387] = {".rake", 5, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [390] = {"appraisals", 10, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [394] = {".jl", 3, LANGUAGE_KEY_EXTENSION, LANG_JULIA},
+    [396] = {"uv", 2, LANGUAGE_KEY_INTERPRETER, LANG_PYTHON},
+    [397] = {".pp", 3, LANGUAGE_KEY_EXTENSION, LANG_PASCAL},
+    [399] = {".webmanifest", 12, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [401] = {".py", 3, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [413] = {"sml", 3, LANGUAGE_KEY_ALIAS, LANG_STANDARD_ML},
+    [419] = {".4dform", 7, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [420] = {".pyi", 4, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [421] = {".webapp", 7, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [422] = {".4dproject", 10, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [423] = {".for", 4, LANGUAGE_KEY_EXTENSION, LANG_FORTRAN},
+    [424] = {"julia", 5, LANGUAGE_KEY_INTERPRETER, LANG_JULIA},
+    [427] = {".txx", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [428] = {".ts", 3, LANGUAGE_KEY_EXTENSION, LANG_TYPESCRIPT},
+    [430] = {"emakefile", 9, LANGUAGE_KEY_FILENAME, LANG_ERLANG},
+    [431] = {"posh", 4, LANGUAGE_KEY_ALIAS, LANG_POWERSHELL},
+    [432] = {".exs", 4, LANGUAGE_KEY_EXTENSION, LANG_ELIXIR},
+    [435] = {"puppetfile", 10, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [436] = {".depproj", 8, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [437] = {"berksfile", 9, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [439] = {"typescript", 10, LANGUAGE_KEY_ALIAS, LANG_TYPESCRIPT},
+    [441] = {"pascal", 6, LANGUAGE_KEY_ALIAS, LANG_PASCAL},
+    [444] = {".gpx", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [447] = {".pyw", 4, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [450] = {"less", 4, LANGUAGE_KEY_ALIAS, LANG_LESS},
+    [451] = {".flaskenv", 9, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [452] = {".csdef", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [457] = {"zprofile", 8, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [462] = {"vagrantfile", 11, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [465] = {".tcl.in", 7, LANGUAGE_KEY_EXTENSION, LANG_TCL},
+    [468] = {".c", 2, LANGUAGE_KEY_EXTENSION, LANG_C},
+    [469] = {".h", 2, LANGUAGE_KEY_EXTENSION, LANG_OBJECTIVE_C},
+    [472] = {"bash", 4, LANGUAGE_KEY_INTERPRETER, LANG_SHELL},
+    [478] = {"runhugs", 7, LANGUAGE_KEY_INTERPRETER, LANG_HASKELL},
+    [479] = {"sdc", 3, LANGUAGE_KEY_ALIAS, LANG_TCL},
+    [480] = {".spec", 5, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [487] = {".less", 5, LANGUAGE_KEY_EXTENSION, LANG_LESS},
+    [488] = {"ada95", 5, LANGUAGE_KEY_ALIAS, LANG_ADA},
+    [490] = {"starfield", 9, LANGUAGE_KEY_FILENAME, LANG_TCL},
+    [494] = {"mksh", 4, LANGUAGE_KEY_INTERPRETER, LANG_SHELL},
+    [496] = {".make", 5, LANGUAGE_KEY_EXTENSION, LANG_MAKEFILE},
+    [497] = {".fsx", 4, LANGUAGE_KEY_EXTENSION, LANG_FS},
+    [499] = {".trigger", 8, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [505] = {"buildfile", 9, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [510] = {".re", 3, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [516] = {".all-contributorsrc", 19, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [517] = {".t", 2, LANGUAGE_KEY_EXTENSION, LANG_PERL},
+    [520] = {"scala", 5, LANGUAGE_KEY_ALIAS, LANG_SCALA},
+    [525] = {"makefile.pl", 11, LANGUAGE_KEY_FILENAME, LANG_PERL},
+    [527] = {"gjs", 3, LANGUAGE_KEY_INTERPRETER, LANG_JAVASCRIPT},
+    [531] = {".bashrc", 7, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [533] = {".wsf", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [535] = {"erlang", 6, LANGUAGE_KEY_ALIAS, LANG_ERLANG},
+    [540] = {".h.in", 5, LANGUAGE_KEY_EXTENSION, LANG_C},
+    [547] = {".zshenv", 7, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [551] = {".xml", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [552] = {".toc", 4, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [554] = {".jake", 5, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [556] = {"js", 2, LANGUAGE_KEY_ALIAS, LANG_JAVASCRIPT},
+    [557] = {"rs", 2, LANGUAGE_KEY_ALIAS, LANG_RUST},
+    [562] = {".tab", 4, LANGUAGE_KEY_EXTENSION, LANG_SQL},
+    [563] = {".cake", 5, LANGUAGE_KEY_EXTENSION, LANG_COFFEESCRIPT},
+    [564] = {".xinitrc", 8, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [565] = {"verilog", 7, LANGUAGE_KEY_ALIAS, LANG_VERILOG},
+    [566] = {".vbproj", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [567] = {"pwsh", 4, LANGUAGE_KEY_ALIAS, LANG_POWERSHELL},
+    [569] = {"makefile.boot", 13, LANGUAGE_KEY_FILENAME, LANG_MAKEFILE},
+    [572] = {"objective-c++", 13, LANGUAGE_KEY_ALIAS, LANG_OBJECTIVE_CPP},
+    [578] = {".storyboard", 11, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [580] = {"matlab", 6, LANGUAGE_KEY_ALIAS, LANG_MATLAB},
+    [581] = {"nodejs", 6, LANGUAGE_KEY_INTERPRETER, LANG_JAVASCRIPT},
+    [582] = {".fs", 3, LANGUAGE_KEY_EXTENSION, LANG_FS},
+    [583] = {"flake.lock", 10, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [589] = {".bats", 5, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [590] = {".mts", 4, LANGUAGE_KEY_EXTENSION, LANG_TYPESCRIPT},
+    [598] = {".jsm", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [600] = {"cperl", 5, LANGUAGE_KEY_INTERPRETER, LANG_PERL},
+    [601] = {"deliverfile", 11, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [602] = {".hs-boot", 8, LANGUAGE_KEY_EXTENSION, LANG_HASKELL},
+    [603] = {"zsh", 3, LANGUAGE_KEY_ALIAS, LANG_SHELL},
+    [606] = {".containerfile", 14, LANGUAGE_KEY_EXTENSION, LANG_DOCKERFILE},
+    [610] = {"package.resolved", 16, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [611] = {"mf", 2, LANGUAGE_KEY_ALIAS, LANG_MAKEFILE},
+    [613] = {"r", 1, LANGUAGE_KEY_ALIAS, LANG_R},
+    [615] = {"python2", 7, LANGUAGE_KEY_INTERPRETER, LANG_PYTHON},
+    [616] = {".ditaval", 8, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [626] = {"pypy", 4, LANGUAGE_KEY_INTERPRETER, LANG_PYTHON},
+    [627] = {".tcc", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [628] = {"rakefile", 8, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [630] = {"f#", 2, LANGUAGE_KEY_ALIAS, LANG_FS},
+    [631] = {".tsv", 4, LANGUAGE_KEY_EXTENSION, LANG_TSV},
+    [637] = {"python3", 7, LANGUAGE_KEY_INTERPRETER, LANG_PYTHON},
+    [641] = {".sdc", 4, LANGUAGE_KEY_EXTENSION, LANG_TCL},
+    [642] = {".cl2", 4, LANGUAGE_KEY_EXTENSION, LANG_CLOJURE},
+    [644] = {".vsixmanifest", 13, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [646] = {".yml", 4, LANGUAGE_KEY_EXTENSION, LANG_YAML},
+    [651] = {"xsd", 3, LANGUAGE_KEY_ALIAS, LANG_XML},
+    [653] = {".mdwn", 5, LANGUAGE_KEY_EXTENSION, LANG_MARKDOWN},
+    [654] = {"login", 5, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [656] = {".tsx", 4, LANGUAGE_KEY_EXTENSION, LANG_TYPESCRIPT},
+    [658] = {".rst.txt", 8, LANGUAGE_KEY_EXTENSION, LANG_RESTRUCTUREDTEXT},
+    [659] = {".dpr", 4, LANGUAGE_KEY_EXTENSION, LANG_PASCAL},
+    [660] = {"makefile.inc", 12, LANGUAGE_KEY_FILENAME, LANG_MAKEFILE},
+    [662] = {"bsdmakefile", 11, LANGUAGE_KEY_FILENAME, LANG_MAKEFILE},
+    [668] = {".gml", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [670] = {"rc", 2, LANGUAGE_KEY_INTERPRETER, LANG_SHELL},
+    [671] = {"rust", 4, LANGUAGE_KEY_ALIAS, LANG_RUST},
+    [674] = {"guardfile", 9, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [679] = {".osm", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [680] = {".mysql", 6, LANGUAGE_KEY_EXTENSION, LANG_SQL},
+    [687] = {"thorfile", 8, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [690] = {".scss", 5, LANGUAGE_KEY_EXTENSION, LANG_SCSS},
+    [694] = {"v8", 2, LANGUAGE_KEY_INTERPRETER, LANG_JAVASCRIPT},
+    [695] = {".nimrod", 7, LANGUAGE_KEY_EXTENSION, LANG_NIM},
+    [697] = {"gradlew", 7, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [698] = {".dotsettings", 12, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [699] = {".prawn", 6, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [701] = {".jav", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVA},
+    [708] = {".asm", 4, LANGUAGE_KEY_EXTENSION, LANG_ASSEMBLY},
+    [711] = {".tern-project", 13, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [713] = {".mli", 4, LANGUAGE_KEY_EXTENSION, LANG_OCAML},
+    [716] = {".xlf", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [718] = {".gql", 4, LANGUAGE_KEY_EXTENSION, LANG_GRAPHQL},
+    [719] = {".adp", 4, LANGUAGE_KEY_EXTENSION, LANG_TCL},
+    [720] = {"sh", 2, LANGUAGE_KEY_ALIAS, LANG_SHELL},
+    [726] = {"c++", 3, LANGUAGE_KEY_ALIAS, LANG_CPP},
+    [729] = {"xml", 3, LANGUAGE_KEY_ALIAS, LANG_XML},
+    [730] = {"zlogin", 6, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [731] = {"batch", 5, LANGUAGE_KEY_ALIAS, LANG_BATCHFILE},
+    [732] = {".flake8", 7, LANGUAGE_KEY_FILENAME, LANG_INI},
+    [737] = {"c#", 2, LANGUAGE_KEY_ALIAS, LANG_CS},
+    [741] = {".html", 5, LANGUAGE_KEY_EXTENSION, LANG_HTML},
+    [751] = {"javascript", 10, LANGUAGE_KEY_ALIAS, LANG_JAVASCRIPT},
+    [752] = {".typ", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [754] = {".cob", 4, LANGUAGE_KEY_EXTENSION, LANG_COBOL},
+    [755] = {"gnumakefile", 11, LANGUAGE_KEY_FILENAME, LANG_MAKEFILE},
+    [756] = {"sconstruct", 10, LANGUAGE_KEY_FILENAME, LANG_PYTHON},
+    [757] = {".sw", 3, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [758] = {"md", 2, LANGUAGE_KEY_ALIAS, LANG_MARKDOWN},
+    [762] = {".classpath", 10, LANGUAGE_KEY_FILENAME, LANG_XML},
+    [763] = {".topojson", 9, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [766] = {"cobol", 5, LANGUAGE_KEY_ALIAS, LANG_COBOL},
+    [767] = {".glade", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [769] = {".mll", 4, LANGUAGE_KEY_EXTENSION, LANG_OCAML},
+    [770] = {".cs.pp", 6, LANGUAGE_KEY_EXTENSION, LANG_CS},
+    [771] = {"swift", 5, LANGUAGE_KEY_ALIAS, LANG_SWIFT},
+    [772] = {"zshrc", 5, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [773] = {".ads", 4, LANGUAGE_KEY_EXTENSION, LANG_ADA},
+    [779] = {".sbatch", 7, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [780] = {".ksh", 4, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [784] = {".gyp", 4, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [787] = {".ddl", 4, LANGUAGE_KEY_EXTENSION, LANG_SQL},
+    [788] = {".arcconfig", 10, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [790] = {".natvis", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [791] = {".mcmeta", 7, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [792] = {"ruby", 4, LANGUAGE_KEY_ALIAS, LANG_RUBY},
+    [795] = {".reg", 4, LANGUAGE_KEY_EXTENSION, LANG_WINDOWS_REGISTRY},
+    [799] = {".jsb", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [800] = {".xhtml", 6, LANGUAGE_KEY_EXTENSION, LANG_HTML},
+    [801] = {".tac", 4, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [805] = {"containerfile", 13, LANGUAGE_KEY_FILENAME, LANG_DOCKERFILE},
+    [814] = {".makefile", 9, LANGUAGE_KEY_EXTENSION, LANG_MAKEFILE},
+    [821] = {"rebar.config", 12, LANGUAGE_KEY_FILENAME, LANG_ERLANG},
+    [824] = {".zlogout", 8, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [829] = {".vstemplate", 11, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [834] = {".ruby", 5, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [836] = {"makefile.wat", 12, LANGUAGE_KEY_FILENAME, LANG_MAKEFILE},
+    [837] = {"asm", 3, LANGUAGE_KEY_ALIAS, LANG_ASSEMBLY},
+    [838] = {".cp", 3, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [840] = {".mm", 3, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [843] = {"9fs", 3, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [844] = {".zsh", 4, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [848] = {".rbi", 4, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [851] = {".workbook", 9, LANGUAGE_KEY_EXTENSION, LANG_MARKDOWN},
+    [857] = {"objectivec++", 12, LANGUAGE_KEY_ALIAS, LANG_OBJECTIVE_CPP},
+    [858] = {".reek", 5, LANGUAGE_KEY_EXTENSION, LANG_YAML},
+    [860] = {".pl", 3, LANGUAGE_KEY_EXTENSION, LANG_PERL},
+    [862] = {"cshrc", 5, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [863] = {".gypi", 5, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [864] = {".dtx", 4, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [865] = {"nuget.config", 12, LANGUAGE_KEY_FILENAME, LANG_XML},
+    [868] = {".pm", 3, LANGUAGE_KEY_EXTENSION, LANG_PERL},
+    [869] = {"jakefile", 8, LANGUAGE_KEY_FILENAME, LANG_JAVASCRIPT},
+    [872] = {"clojure", 7, LANGUAGE_KEY_ALIAS, LANG_CLOJURE},
+    [873] = {".bbx", 4, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [874] = {"profile", 7, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [876] = {"haskell", 7, LANGUAGE_KEY_ALIAS, LANG_HASKELL},
+    [877] = {".sublime-snippet", 16, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [879] = {".ps1xml", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [887] = {"jruby", 5, LANGUAGE_KEY_ALIAS, LANG_RUBY},
+    [889] = {"topojson", 8, LANGUAGE_KEY_ALIAS, LANG_JSON},
+    [890] = {"toml", 4, LANGUAGE_KEY_ALIAS, LANG_TOML},
+    [892] = {".yaml", 5, LANGUAGE_KEY_EXTENSION, LANG_YAML},
+    [893] = {".cnf", 4, LANGUAGE_KEY_EXTENSION, LANG_INI},
+    [895] = {".csv", 4, LANGUAGE_KEY_EXTENSION, LANG_CSV},
+    [896] = {".javascript", 11, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [898] = {".ivy", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [899] = {".envrc", 6, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [901] = {"node", 4, LANGUAGE_KEY_ALIAS, LANG_JAVASCRIPT},
+    [903] = {".mdown", 6, LANGUAGE_KEY_EXTENSION, LANG_MARKDOWN},
+    [905] = {".pluginspec", 11, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [910] = {"app.config", 10, LANGUAGE_KEY_FILENAME, LANG_XML},
+    [912] = {".rdf", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [915] = {"octave", 6, LANGUAGE_KEY_ALIAS, LANG_MATLAB},
+    [918] = {".escript", 8, LANGUAGE_KEY_EXTENSION, LANG_ERLANG},
+    [920] = {".dita", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [921] = {"geojson", 7, LANGUAGE_KEY_ALIAS, LANG_JSON},
+    [922] = {"gemfile", 7, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [923] = {"dart", 4, LANGUAGE_KEY_INTERPRETER, LANG_DART},
+    [924] = {".http", 5, LANGUAGE_KEY_EXTENSION, LANG_HTTP},
+    [926] = {"lua", 3, LANGUAGE_KEY_ALIAS, LANG_LUA},
+    [928] = {".iced", 5, LANGUAGE_KEY_EXTENSION, LANG_COFFEESCRIPT},
+    [929] = {"pixi.lock", 9, LANGUAGE_KEY_FILENAME, LANG_YAML},
+    [934] = {".hsc", 4, LANGUAGE_KEY_EXTENSION, LANG_HASKELL},
+    [936] = {"xsession", 8, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [940] = {".xmp", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [941] = {"deno", 4, LANGUAGE_KEY_INTERPRETER, LANG_TYPESCRIPT},
+    [949] = {"json", 4, LANGUAGE_KEY_ALIAS, LANG_JSON},
+    [952] = {".auto-changelog", 15, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [954] = {".yml.mysql", 10, LANGUAGE_KEY_EXTENSION, LANG_YAML},
+    [955] = {".frag", 5, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [956] = {".ronn", 5, LANGUAGE_KEY_EXTENSION, LANG_MARKDOWN},
+    [959] = {".jslib", 6, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [960] = {".f", 2, LANGUAGE_KEY_EXTENSION, LANG_FORTRAN},
+    [961] = {"expr-dist", 9, LANGUAGE_KEY_FILENAME, LANG_R},
+    [962] = {".i", 2, LANGUAGE_KEY_EXTENSION, LANG_ASSEMBLY},
+    [964] = {".pryrc", 6, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [971] = {".wlua", 5, LANGUAGE_KEY_EXTENSION, LANG_LUA},
+    [973] = {".ru", 3, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [974] = {"v8-shell", 8, LANGUAGE_KEY_INTERPRETER, LANG_JAVASCRIPT},
+    [975] = {"web.release.config", 18, LANGUAGE_KEY_FILENAME, LANG_XML},
+    [977] = {"macruby", 7, LANGUAGE_KEY_INTERPRETER, LANG_RUBY},
+    [979] = {".java", 5, LANGUAGE_KEY_EXTENSION, LANG_JAVA},
+    [983] = {".xproj", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [990] = {".clangd", 7, LANGUAGE_KEY_FILENAME, LANG_YAML},
+    [991] = {".tfstate", 8, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [992] = {"qjs", 3, LANGUAGE_KEY_INTERPRETER, LANG_JAVASCRIPT},
+    [998] = {"dart", 4, LANGUAGE_KEY_ALIAS, LANG_DART},
+    [1004] = {".scxml", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1005] = {"lua", 3, LANGUAGE_KEY_INTERPRETER, LANG_LUA},
+    [1008] = {"tex", 3, LANGUAGE_KEY_ALIAS, LANG_TEX},
+    [1009] = {"make", 4, LANGUAGE_KEY_ALIAS, LANG_MAKEFILE},
+    [1013] = {".kts", 4, LANGUAGE_KEY_EXTENSION, LANG_KOTLIN},
+    [1015] = {"sh", 2, LANGUAGE_KEY_INTERPRETER, LANG_SHELL},
+    [1020] = {".tact", 5, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [1022] = {".jss", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1025] = {".mod", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1028] = {"makefile.in", 11, LANGUAGE_KEY_FILENAME, LANG_MAKEFILE},
+    [1032] = {"luajit", 6, LANGUAGE_KEY_INTERPRETER, LANG_LUA},
+    [1035] = {".props", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1037] = {"ocamlrun", 8, LANGUAGE_KEY_INTERPRETER, LANG_OCAML},
+    [1041] = {".rbuild", 7, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [1043] = {".wixproj", 8, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1044] = {".cproject", 9, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1046] = {".html.hl", 8, LANGUAGE_KEY_EXTENSION, LANG_HTML},
+    [1047] = {".al", 3, LANGUAGE_KEY_EXTENSION, LANG_PERL},
+    [1048] = {"deps", 4, LANGUAGE_KEY_FILENAME, LANG_PYTHON},
+    [1050] = {".dfm", 4, LANGUAGE_KEY_EXTENSION, LANG_PASCAL},
+    [1051] = {".mkii", 5, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [1052] = {"instantfpc", 10, LANGUAGE_KEY_INTERPRETER, LANG_PASCAL},
+    [1053] = {"nim.cfg", 7, LANGUAGE_KEY_FILENAME, LANG_NIM},
+    [1055] = {".zprofile", 9, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1057] = {"zig", 3, LANGUAGE_KEY_ALIAS, LANG_ZIG},
+    [1060] = {".json.example", 13, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [1062] = {"objective-c", 11, LANGUAGE_KEY_ALIAS, LANG_OBJECTIVE_C},
+    [1064] = {".linq", 5, LANGUAGE_KEY_EXTENSION, LANG_CS},
+    [1066] = {".pyde", 5, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [1069] = {".vcf", 4, LANGUAGE_KEY_EXTENSION, LANG_TSV},
+    [1070] = {"ocamlscript", 11, LANGUAGE_KEY_INTERPRETER, LANG_OCAML},
+    [1071] = {".app.src", 8, LANGUAGE_KEY_EXTENSION, LANG_ERLANG},
+    [1075] = {".fxml", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1087] = {"tcl", 3, LANGUAGE_KEY_ALIAS, LANG_TCL},
+    [1088] = {"golang", 6, LANGUAGE_KEY_ALIAS, LANG_GO},
+    [1092] = {".nim", 4, LANGUAGE_KEY_EXTENSION, LANG_NIM},
+    [1095] = {".cljscm", 7, LANGUAGE_KEY_EXTENSION, LANG_CLOJURE},
+    [1096] = {".har", 4, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [1098] = {"brewfile", 8, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [1099] = {"makefile", 8, LANGUAGE_KEY_FILENAME, LANG_MAKEFILE},
+    [1102] = {"jruby", 5, LANGUAGE_KEY_INTERPRETER, LANG_RUBY},
+    [1104] = {".wxs", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1107] = {".cjsx", 5, LANGUAGE_KEY_EXTENSION, LANG_COFFEESCRIPT},
+    [1110] = {".nimble", 7, LANGUAGE_KEY_EXTENSION, LANG_NIM},
+    [1113] = {".xib", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1114] = {"cperl", 5, LANGUAGE_KEY_ALIAS, LANG_PERL},
+    [1115] = {"cargo.toml.orig", 15, LANGUAGE_KEY_FILENAME, LANG_TOML},
+    [1117] = {".app", 4, LANGUAGE_KEY_EXTENSION, LANG_ERLANG},
+    [1120] = {"objectivec", 10, LANGUAGE_KEY_ALIAS, LANG_OBJECTIVE_C},
+    [1121] = {".matlab", 7, LANGUAGE_KEY_EXTENSION, LANG_MATLAB},
+    [1122] = {".pkgproj", 8, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1124] = {".ixx", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [1129] = {".graphql", 8, LANGUAGE_KEY_EXTENSION, LANG_GRAPHQL},
+    [1132] = {"d", 1, LANGUAGE_KEY_ALIAS, LANG_D},
+    [1135] = {"bash_profile", 12, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1138] = {".ccxml", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1143] = {".xdc", 4, LANGUAGE_KEY_EXTENSION, LANG_TCL},
+    [1144] = {".patch", 6, LANGUAGE_KEY_EXTENSION, LANG_DIFF},
+    [1151] = {".hs", 3, LANGUAGE_KEY_EXTENSION, LANG_HASKELL},
+    [1152] = {"d8", 2, LANGUAGE_KEY_INTERPRETER, LANG_JAVASCRIPT},
+    [1154] = {".kojo", 5, LANGUAGE_KEY_EXTENSION, LANG_SCALA},
+    [1155] = {".ipp", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [1156] = {".watchr", 7, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [1159] = {"._coffee", 8, LANGUAGE_KEY_EXTENSION, LANG_COFFEESCRIPT},
+    [1164] = {".cmd", 4, LANGUAGE_KEY_EXTENSION, LANG_BATCHFILE},
+    [1169] = {".gemrc", 6, LANGUAGE_KEY_FILENAME, LANG_YAML},
+    [1170] = {".jsonl", 6, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [1171] = {".rpy", 4, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [1172] = {".lua", 4, LANGUAGE_KEY_EXTENSION, LANG_LUA},
+    [1173] = {".syntax", 7, LANGUAGE_KEY_EXTENSION, LANG_YAML},
+    [1179] = {".iml", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1181] = {"gradlew.bat", 11, LANGUAGE_KEY_FILENAME, LANG_BATCHFILE},
+    [1182] = {".axaml", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1183] = {".cbx", 4, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [1185] = {"sarif", 5, LANGUAGE_KEY_ALIAS, LANG_JSON},
+    [1187] = {"kotlin", 6, LANGUAGE_KEY_ALIAS, LANG_KOTLIN},
+    [1188] = {".rabl", 5, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [1191] = {".mkiv", 5, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [1192] = {"coffee", 6, LANGUAGE_KEY_INTERPRETER, LANG_COFFEESCRIPT},
+    [1193] = {".xliff", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1195] = {"makefile.am", 11, LANGUAGE_KEY_FILENAME, LANG_MAKEFILE},
+    [1196] = {"pdksh", 5, LANGUAGE_KEY_INTERPRETER, LANG_SHELL},
+    [1198] = {"meson", 5, LANGUAGE_KEY_ALIAS, LANG_MESON},
+    [1204] = {"obj-c++", 7, LANGUAGE_KEY_ALIAS, LANG_OBJECTIVE_CPP},
+    [1207] = {"pipfile", 7, LANGUAGE_KEY_FILENAME, LANG_TOML},
+    [1210] = {".rsx", 4, LANGUAGE_KEY_EXTENSION, LANG_R},
+    [1211] = {".cc", 3, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [1213] = {"tab-seperated values", 20, LANGUAGE_KEY_ALIAS, LANG_TSV},
+    [1214] = {".yaml.sed", 9, LANGUAGE_KEY_EXTENSION, LANG_YAML},
+    [1221] = {"capfile", 7, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [1223] = {".latexmkrc", 10, LANGUAGE_KEY_FILENAME, LANG_PERL},
+    [1224] = {".sql", 4, LANGUAGE_KEY_EXTENSION, LANG_SQL},
+    [1227] = {".cmake.in", 9, LANGUAGE_KEY_EXTENSION, LANG_CMAKE},
+    [1228] = {".project", 8, LANGUAGE_KEY_FILENAME, LANG_XML},
+    [1232] = {".ps1", 4, LANGUAGE_KEY_EXTENSION, LANG_POWERSHELL},
+    [1242] = {".admx", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1244] = {".workflow", 9, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1248] = {"web.debug.config", 16, LANGUAGE_KEY_FILENAME, LANG_XML},
+    [1250] = {".vht", 4, LANGUAGE_KEY_EXTENSION, LANG_VHDL},
+    [1257] = {".podspec", 8, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [1258] = {".urdf", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1265] = {".nycrc", 6, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [1266] = {".xsd", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1267] = {"riemann.config", 14, LANGUAGE_KEY_FILENAME, LANG_CLOJURE},
+    [1269] = {"macruby", 7, LANGUAGE_KEY_ALIAS, LANG_RUBY},
+    [1270] = {"python", 6, LANGUAGE_KEY_ALIAS, LANG_PYTHON},
+    [1271] = {"ada2005", 7, LANGUAGE_KEY_ALIAS, LANG_ADA},
+    [1272] = {".aux", 4, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [1281] = {".wsgi", 5, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [1286] = {"bat", 3, LANGUAGE_KEY_ALIAS, LANG_BATCHFILE},
+    [1287] = {".launch", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1288] = {".bash_history", 13, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1289] = {".a51", 4, LANGUAGE_KEY_EXTENSION, LANG_ASSEMBLY},
+    [1293] = {"make", 4, LANGUAGE_KEY_INTERPRETER, LANG_MAKEFILE},
+    [1297] = {".bash_functions", 15, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1299] = {".ml4", 4, LANGUAGE_KEY_EXTENSION, LANG_OCAML},
+    [1302] = {".cbl", 4, LANGUAGE_KEY_EXTENSION, LANG_COBOL},
+    [1304] = {".csproj", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1307] = {"less-css", 8, LANGUAGE_KEY_ALIAS, LANG_LESS},
+    [1317] = {".ccp", 4, LANGUAGE_KEY_EXTENSION, LANG_COBOL},
+    [1319] = {"dlang", 5, LANGUAGE_KEY_ALIAS, LANG_D},
+    [1320] = {"pkgbuild", 8, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1324] = {"wsdl", 4, LANGUAGE_KEY_ALIAS, LANG_XML},
+    [1326] = {".login", 6, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1327] = {".jsproj", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1333] = {".psm1", 5, LANGUAGE_KEY_EXTENSION, LANG_POWERSHELL},
+    [1334] = {".inc", 4, LANGUAGE_KEY_EXTENSION, LANG_SQL},
+    [1335] = {".imgbotconfig", 13, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [1338] = {".fun", 4, LANGUAGE_KEY_EXTENSION, LANG_STANDARD_ML},
+    [1339] = {".f77", 4, LANGUAGE_KEY_EXTENSION, LANG_FORTRAN},
+    [1340] = {".nims", 5, LANGUAGE_KEY_EXTENSION, LANG_NIM},
+    [1341] = {".graphqls", 9, LANGUAGE_KEY_EXTENSION, LANG_GRAPHQL},
+    [1343] = {"rscript", 7, LANGUAGE_KEY_ALIAS, LANG_R},
+    [1344] = {".mspec", 6, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [1347] = {"bash", 4, LANGUAGE_KEY_ALIAS, LANG_SHELL},
+    [1349] = {".pylintrc", 9, LANGUAGE_KEY_FILENAME, LANG_INI},
+    [1350] = {"rbx", 3, LANGUAGE_KEY_INTERPRETER, LANG_RUBY},
+    [1353] = {".pac", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1358] = {"rhino", 5, LANGUAGE_KEY_INTERPRETER, LANG_JAVASCRIPT},
+    [1359] = {".pyp", 4, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [1360] = {"jsonl", 5, LANGUAGE_KEY_ALIAS, LANG_JSON},
+    [1363] = {".tmux", 5, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [1367] = {".xsjslib", 8, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1368] = {".ux", 3, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1372] = {".gmx", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1373] = {".rst", 4, LANGUAGE_KEY_EXTENSION, LANG_RESTRUCTUREDTEXT},
+    [1374] = {".md", 3, LANGUAGE_KEY_EXTENSION, LANG_MARKDOWN},
+    [1378] = {".irbrc", 6, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [1379] = {"escript", 7, LANGUAGE_KEY_INTERPRETER, LANG_ERLANG},
+    [1381] = {".v", 2, LANGUAGE_KEY_EXTENSION, LANG_VERILOG},
+    [1384] = {".mir", 4, LANGUAGE_KEY_EXTENSION, LANG_YAML},
+    [1385] = {"cargo.lock", 10, LANGUAGE_KEY_FILENAME, LANG_TOML},
+    [1386] = {"rscript", 7, LANGUAGE_KEY_INTERPRETER, LANG_R},
+    [1387] = {".xul", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1389] = {".mjs", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1397] = {"cakefile", 8, LANGUAGE_KEY_FILENAME, LANG_COFFEESCRIPT},
+    [1398] = {".bash_aliases", 13, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1399] = {"delphi", 6, LANGUAGE_KEY_ALIAS, LANG_PASCAL},
+    [1400] = {"markdown", 8, LANGUAGE_KEY_ALIAS, LANG_MARKDOWN},
+    [1401] = {".sty", 4, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [1406] = {"mix.lock", 8, LANGUAGE_KEY_FILENAME, LANG_ELIXIR},
+    [1407] = {".lektorproject", 14, LANGUAGE_KEY_EXTENSION, LANG_INI},
+    [1408] = {".htm", 4, LANGUAGE_KEY_EXTENSION, LANG_HTML},
+    [1411] = {"python3", 7, LANGUAGE_KEY_ALIAS, LANG_PYTHON},
+    [1412] = {"rake", 4, LANGUAGE_KEY_INTERPRETER, LANG_RUBY},
+    [1416] = {".js", 3, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1417] = {".tool", 5, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [1420] = {"scala", 5, LANGUAGE_KEY_INTERPRETER, LANG_SCALA},
+    [1421] = {".ndproj", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1429] = {".eliomi", 7, LANGUAGE_KEY_EXTENSION, LANG_OCAML},
+    [1431] = {".lbx", 4, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [1433] = {".jsfl", 5, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1436] = {"restructuredtext", 16, LANGUAGE_KEY_ALIAS, LANG_RESTRUCTUREDTEXT},
+    [1438] = {".coffee", 7, LANGUAGE_KEY_EXTENSION, LANG_COFFEESCRIPT},
+    [1440] = {".x3d", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1441] = {".jsh", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVA},
+    [1442] = {".cljx", 5, LANGUAGE_KEY_EXTENSION, LANG_CLOJURE},
+    [1444] = {"composer.lock", 13, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [1446] = {".vssettings", 11, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1447] = {".xaml", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1448] = {".sh.in", 6, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [1455] = {".ini", 4, LANGUAGE_KEY_EXTENSION, LANG_INI},
+    [1456] = {".psd1", 5, LANGUAGE_KEY_EXTENSION, LANG_POWERSHELL},
+    [1459] = {".nproj", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1460] = {".dll.config", 11, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1472] = {"dangerfile", 10, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [1475] = {"packages.config", 15, LANGUAGE_KEY_FILENAME, LANG_XML},
+    [1476] = {".tern-config", 12, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [1477] = {".thor", 5, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [1482] = {"sql", 3, LANGUAGE_KEY_ALIAS, LANG_SQL},
+    [1486] = {"cake", 4, LANGUAGE_KEY_ALIAS, LANG_CS},
+    [1488] = {".sublime-syntax", 15, LANGUAGE_KEY_EXTENSION, LANG_YAML},
+    [1489] = {".clixml", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1493] = {".avsc", 5, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [1495] = {".profile", 8, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1498] = {".fsproj", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1502] = {".sfproj", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1507] = {".mak", 4, LANGUAGE_KEY_EXTENSION, LANG_MAKEFILE},
+    [1509] = {".jsx", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1512] = {".xsjs", 5, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1516] = {".pd_lua", 7, LANGUAGE_KEY_EXTENSION, LANG_LUA},
+    [1520] = {".dockerfile", 11, LANGUAGE_KEY_EXTENSION, LANG_DOCKERFILE},
+    [1521] = {"rbx", 3, LANGUAGE_KEY_ALIAS, LANG_RUBY},
+    [1523] = {".jscad", 6, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1525] = {".rs", 3, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1529] = {".kml", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1533] = {"rust-script", 11, LANGUAGE_KEY_INTERPRETER, LANG_RUST},
+    [1536] = {".njs", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1543] = {".sc", 3, LANGUAGE_KEY_EXTENSION, LANG_SCALA},
+    [1544] = {"py", 2, LANGUAGE_KEY_INTERPRETER, LANG_PYTHON},
+    [1546] = {"._js", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1547] = {".ktm", 4, LANGUAGE_KEY_EXTENSION, LANG_KOTLIN},
+    [1549] = {".adml", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1550] = {"obj-c", 5, LANGUAGE_KEY_ALIAS, LANG_OBJECTIVE_C},
+    [1552] = {".rprofile", 9, LANGUAGE_KEY_FILENAME, LANG_R},
+    [1558] = {".yrl", 4, LANGUAGE_KEY_EXTENSION, LANG_ERLANG},
+    [1559] = {"kbuild", 6, LANGUAGE_KEY_FILENAME, LANG_MAKEFILE},
+    [1562] = {".pt", 3, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1563] = {".sml", 4, LANGUAGE_KEY_EXTENSION, LANG_STANDARD_ML},
+    [1565] = {".res", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1566] = {".vhi", 4, LANGUAGE_KEY_EXTENSION, LANG_VHDL},
+    [1567] = {".ui", 3, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1568] = {".cproject", 9, LANGUAGE_KEY_FILENAME, LANG_XML},
+    [1569] = {"assembly", 8, LANGUAGE_KEY_ALIAS, LANG_ASSEMBLY},
+    [1574] = {"csharp", 6, LANGUAGE_KEY_ALIAS, LANG_CS},
+    [1578] = {"standard-ml", 11, LANGUAGE_KEY_ALIAS, LANG_STANDARD_ML},
+    [1580] = {".cs", 3, LANGUAGE_KEY_EXTENSION, LANG_CS},
+    [1585] = {"http", 4, LANGUAGE_KEY_ALIAS, LANG_HTTP},
+    [1586] = {"web.config", 10, LANGUAGE_KEY_FILENAME, LANG_XML},
+    [1587] = {".psc1", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1591] = {".nse", 4, LANGUAGE_KEY_EXTENSION, LANG_LUA},
+    [1593] = {".go", 3, LANGUAGE_KEY_EXTENSION, LANG_GO},
+    [1594] = {".pubxml", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1601] = {"pipfile.lock", 12, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [1606] = {".ltx", 4, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [1612] = {".gemspec", 8, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [1618] = {".properties", 11, LANGUAGE_KEY_EXTENSION, LANG_INI},
+    [1627] = {".qhelp", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1628] = {".di", 3, LANGUAGE_KEY_EXTENSION, LANG_D},
+    [1630] = {".cshrc", 6, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1632] = {"ksh", 3, LANGUAGE_KEY_INTERPRETER, LANG_SHELL},
+    [1635] = {"settings.stylecop", 17, LANGUAGE_KEY_FILENAME, LANG_XML},
+    [1640] = {"xinitrc", 7, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1643] = {"tmux.conf", 9, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1644] = {".toml", 5, LANGUAGE_KEY_EXTENSION, LANG_TOML},
+    [1645] = {".sass", 5, LANGUAGE_KEY_EXTENSION, LANG_SASS},
+    [1646] = {"pdm.lock", 8, LANGUAGE_KEY_FILENAME, LANG_TOML},
+    [1651] = {".mkvi", 5, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [1652] = {"runhaskell", 10, LANGUAGE_KEY_INTERPRETER, LANG_HASKELL},
+    [1656] = {"cmake", 5, LANGUAGE_KEY_ALIAS, LANG_CMAKE},
+    [1657] = {".xmi", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1658] = {".bash_logout", 12, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1662] = {".h++", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [1663] = {".wxi", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1664] = {"ts", 2, LANGUAGE_KEY_ALIAS, LANG_TYPESCRIPT},
+    [1665] = {"elixir", 6, LANGUAGE_KEY_INTERPRETER, LANG_ELIXIR},
+    [1666] = {".yyp", 4, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [1670] = {"jarfile", 7, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [1677] = {"chakra", 6, LANGUAGE_KEY_INTERPRETER, LANG_JAVASCRIPT},
+    [1678] = {".ins", 4, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [1680] = {".ct", 3, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1682] = {".cppm", 5, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [1685] = {".rviz", 5, LANGUAGE_KEY_EXTENSION, LANG_YAML},
+    [1688] = {".udf", 4, LANGUAGE_KEY_EXTENSION, LANG_SQL},
+    [1692] = {".eye", 4, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [1697] = {"steepfile", 9, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [1701] = {".vxml", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1704] = {"bsdmake", 7, LANGUAGE_KEY_ALIAS, LANG_MAKEFILE},
+    [1708] = {".eliom", 6, LANGUAGE_KEY_EXTENSION, LANG_OCAML},
+    [1709] = {".shproj", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1711] = {".clang-tidy", 11, LANGUAGE_KEY_FILENAME, LANG_YAML},
+    [1713] = {".es", 3, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1716] = {"man", 3, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1717] = {".xspec", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1719] = {"coffeescript", 12, LANGUAGE_KEY_ALIAS, LANG_COFFEESCRIPT},
+    [1720] = {"node", 4, LANGUAGE_KEY_INTERPRETER, LANG_JAVASCRIPT},
+    [1722] = {"envrc", 5, LANGUAGE_KEY_ALIAS, LANG_SHELL},
+    [1723] = {"bashrc", 6, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1725] = {".vhd", 4, LANGUAGE_KEY_EXTENSION, LANG_VHDL},
+    [1726] = {".perl", 5, LANGUAGE_KEY_EXTENSION, LANG_PERL},
+    [1731] = {"graphql", 7, LANGUAGE_KEY_ALIAS, LANG_GRAPHQL},
+    [1732] = {"rss", 3, LANGUAGE_KEY_ALIAS, LANG_XML},
+    [1733] = {".sig", 4, LANGUAGE_KEY_EXTENSION, LANG_STANDARD_ML},
+    [1741] = {".sch", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1742] = {".mdpolicy", 9, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1743] = {".gs", 3, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1744] = {"fsharp", 6, LANGUAGE_KEY_ALIAS, LANG_FS},
+    [1749] = {"pwsh", 4, LANGUAGE_KEY_INTERPRETER, LANG_POWERSHELL},
+    [1751] = {".cljc", 5, LANGUAGE_KEY_EXTENSION, LANG_CLOJURE},
+    [1754] = {".bash_profile", 13, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1755] = {".ditamap", 8, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1756] = {"makefile", 8, LANGUAGE_KEY_ALIAS, LANG_MAKEFILE},
+    [1762] = {".mly", 4, LANGUAGE_KEY_EXTENSION, LANG_OCAML},
+    [1763] = {".nuspec", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1769] = {".hta", 4, LANGUAGE_KEY_EXTENSION, LANG_HTML},
+    [1770] = {"runghc", 6, LANGUAGE_KEY_INTERPRETER, LANG_HASKELL},
+    [1771] = {"mkfile", 6, LANGUAGE_KEY_FILENAME, LANG_MAKEFILE},
+    [1774] = {".es6", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1778] = {"snapfile", 8, LANGUAGE_KEY_FILENAME, LANG_RUBY},
+    [1782] = {"uv.lock", 7, LANGUAGE_KEY_FILENAME, LANG_TOML},
+    [1785] = {".bash", 5, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [1786] = {".nim.cfg", 8, LANGUAGE_KEY_EXTENSION, LANG_NIM},
+    [1794] = {"dosbatch", 8, LANGUAGE_KEY_ALIAS, LANG_BATCHFILE},
+    [1800] = {"diff", 4, LANGUAGE_KEY_ALIAS, LANG_DIFF},
+    [1804] = {".fpp", 4, LANGUAGE_KEY_EXTENSION, LANG_FORTRAN},
+    [1809] = {"tclsh", 5, LANGUAGE_KEY_INTERPRETER, LANG_TCL},
+    [1812] = {".toml.example", 13, LANGUAGE_KEY_EXTENSION, LANG_TOML},
+    [1813] = {"ack", 3, LANGUAGE_KEY_FILENAME, LANG_PERL},
+    [1814] = {".buckconfig", 11, LANGUAGE_KEY_FILENAME, LANG_INI},
+    [1815] = {"nim", 3, LANGUAGE_KEY_ALIAS, LANG_NIM},
+    [1817] = {"pylintrc", 8, LANGUAGE_KEY_FILENAME, LANG_INI},
+    [1822] = {".ant", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1824] = {"vhdl", 4, LANGUAGE_KEY_ALIAS, LANG_VHDL},
+    [1826] = {".yy", 3, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [1829] = {".god", 4, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [1832] = {".kt", 3, LANGUAGE_KEY_EXTENSION, LANG_KOTLIN},
+    [1835] = {".axml", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1836] = {"vlcrc", 5, LANGUAGE_KEY_FILENAME, LANG_INI},
+    [1837] = {".mjml", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1838] = {"html", 4, LANGUAGE_KEY_ALIAS, LANG_HTML},
+    [1843] = {".idc", 4, LANGUAGE_KEY_EXTENSION, LANG_C},
+    [1846] = {"objc++", 6, LANGUAGE_KEY_ALIAS, LANG_OBJECTIVE_CPP},
+    [1847] = {".tml", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1850] = {"wish", 4, LANGUAGE_KEY_INTERPRETER, LANG_TCL},
+    [1852] = {".rd", 3, LANGUAGE_KEY_EXTENSION, LANG_R},
+    [1858] = {"batchfile", 9, LANGUAGE_KEY_ALIAS, LANG_BATCHFILE},
+    [1859] = {".pascal", 7, LANGUAGE_KEY_EXTENSION, LANG_PASCAL},
+    [1860] = {".bones", 6, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1863] = {"meson_options.txt", 17, LANGUAGE_KEY_FILENAME, LANG_MESON},
+    [1865] = {"makefile.sco", 12, LANGUAGE_KEY_FILENAME, LANG_MAKEFILE},
+    [1867] = {".jspre", 6, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1870] = {"ini", 3, LANGUAGE_KEY_ALIAS, LANG_INI},
+    [1872] = {"gopkg.lock", 10, LANGUAGE_KEY_FILENAME, LANG_TOML},
+    [1875] = {".resx", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1879] = {".mxml", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1881] = {".cpy", 4, LANGUAGE_KEY_EXTENSION, LANG_COBOL},
+    [1883] = {"ocaml", 5, LANGUAGE_KEY_ALIAS, LANG_OCAML},
+    [1884] = {".wxl", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1886] = {".proj", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1890] = {"rst", 3, LANGUAGE_KEY_ALIAS, LANG_RESTRUCTUREDTEXT},
+    [1891] = {".rockspec", 9, LANGUAGE_KEY_EXTENSION, LANG_LUA},
+    [1892] = {".hh", 3, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [1893] = {".py3", 4, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [1895] = {".plx", 4, LANGUAGE_KEY_EXTENSION, LANG_PERL},
+    [1898] = {"dash", 4, LANGUAGE_KEY_INTERPRETER, LANG_SHELL},
+    [1900] = {"yml", 3, LANGUAGE_KEY_ALIAS, LANG_YAML},
+    [1901] = {".ino", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [1902] = {"css", 3, LANGUAGE_KEY_ALIAS, LANG_CSS},
+    [1905] = {".rbw", 4, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [1907] = {".odd", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1909] = {".ncl", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1910] = {".css", 4, LANGUAGE_KEY_EXTENSION, LANG_CSS},
+    [1912] = {".c++", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [1913] = {"latexmkrc", 9, LANGUAGE_KEY_FILENAME, LANG_PERL},
+    [1921] = {".yaml-tmlanguage", 16, LANGUAGE_KEY_EXTENSION, LANG_YAML},
+    [1924] = {"dockerfile", 10, LANGUAGE_KEY_ALIAS, LANG_DOCKERFILE},
+    [1930] = {"cpp", 3, LANGUAGE_KEY_ALIAS, LANG_CPP},
+    [1931] = {".zcml", 5, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1935] = {"ocaml", 5, LANGUAGE_KEY_INTERPRETER, LANG_OCAML},
+    [1938] = {".d", 2, LANGUAGE_KEY_EXTENSION, LANG_MAKEFILE},
+    [1941] = {"go", 2, LANGUAGE_KEY_ALIAS, LANG_GO},
+    [1942] = {"tcc", 3, LANGUAGE_KEY_INTERPRETER, LANG_C},
+    [1946] = {".nasm", 5, LANGUAGE_KEY_EXTENSION, LANG_ASSEMBLY},
+    [1948] = {"ruby", 4, LANGUAGE_KEY_INTERPRETER, LANG_RUBY},
+    [1953] = {".json", 5, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [1959] = {".dof", 4, LANGUAGE_KEY_EXTENSION, LANG_INI},
+    [1960] = {".clang-format", 13, LANGUAGE_KEY_FILENAME, LANG_YAML},
+    [1962] = {".rss", 4, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [1963] = {".tex", 4, LANGUAGE_KEY_EXTENSION, LANG_TEX},
+    [1966] = {".builder", 8, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [1968] = {"sass", 4, LANGUAGE_KEY_ALIAS, LANG_SASS},
+    [1970] = {".cljs.hl", 8, LANGUAGE_KEY_EXTENSION, LANG_CLOJURE},
+    [1972] = {".ice", 4, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [1975] = {".url", 4, LANGUAGE_KEY_EXTENSION, LANG_INI},
+    [1977] = {".hpp", 4, LANGUAGE_KEY_EXTENSION, LANG_CPP},
+    [1979] = {".slurm", 6, LANGUAGE_KEY_EXTENSION, LANG_SHELL},
+    [1980] = {"mcmod.info", 10, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [1988] = {"cakescript", 10, LANGUAGE_KEY_ALIAS, LANG_CS},
+    [1989] = {"bash_aliases", 12, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [1990] = {"winbatch", 8, LANGUAGE_KEY_ALIAS, LANG_BATCHFILE},
+    [1991] = {".c8rc", 5, LANGUAGE_KEY_FILENAME, LANG_JSON},
+    [1992] = {".cjs", 4, LANGUAGE_KEY_EXTENSION, LANG_JAVASCRIPT},
+    [1994] = {".luacheckrc", 11, LANGUAGE_KEY_FILENAME, LANG_LUA},
+    [1996] = {".zig.zon", 8, LANGUAGE_KEY_EXTENSION, LANG_ZIG},
+    [2001] = {".rb", 3, LANGUAGE_KEY_EXTENSION, LANG_RUBY},
+    [2005] = {".gltf", 5, LANGUAGE_KEY_EXTENSION, LANG_JSON},
+    [2009] = {"ada", 3, LANGUAGE_KEY_ALIAS, LANG_ADA},
+    [2011] = {"scss", 4, LANGUAGE_KEY_ALIAS, LANG_SCSS},
+    [2018] = {".zlogin", 7, LANGUAGE_KEY_FILENAME, LANG_SHELL},
+    [2023] = {".gclient", 8, LANGUAGE_KEY_FILENAME, LANG_PYTHON},
+    [2024] = {".pyt", 4, LANGUAGE_KEY_EXTENSION, LANG_PYTHON},
+    [2025] = {".ex", 3, LANGUAGE_KEY_EXTENSION, LANG_ELIXIR},
+    [2026] = {"bb", 2, LANGUAGE_KEY_INTERPRETER, LANG_CLOJURE},
+    [2030] = {"splus", 5, LANGUAGE_KEY_ALIAS, LANG_R},
+    [2032] = {".rest.txt", 9, LANGUAGE_KEY_EXTENSION, LANG_RESTRUCTUREDTEXT},
+    [2033] = {".grxml", 6, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [2035] = {".ccproj", 7, LANGUAGE_KEY_EXTENSION, LANG_XML},
+    [2037] = {".coveragerc", 11, LANGUAGE_KEY_FILENAME, LANG_INI},
+    [2041] = {"poetry.lock", 11, LANGUAGE_KEY_FILENAME, LANG_TOML},
+    [2042] = {"pypy3", 5, LANGUAGE_KEY_INTERPRETER, LANG_PYTHON},
+    [2044] = {"rebar.config.lock", 17, LANGUAGE_KEY_FILENAME, LANG_ERLANG},
 };
 
+/* Second hash seed of each bucket */
+static const unsigned short g_languageKeySeeds[LANGUAGE_KEY_BUCKET_COUNT] = {
+    1, 1, 2, 1, 6, 1, 1, 1, 1, 0, 5, 1, 0, 1, 2, 3,
+    1, 0, 0, 2, 0, 1, 1, 1, 1, 2, 2, 1, 0, 1, 1, 3,
+    0, 1, 1, 1, 1, 3, 2, 1, 2, 0, 1, 1, 1, 3, 0, 2,
+    0, 1, 0, 1, 1, 0, 0, 2, 3, 1, 1, 1, 1, 1, 2, 1,
+    4, 1, 2, 1, 1, 1, 0, 2, 3, 0, 3, 1, 1, 1, 0, 2,
+    1, 1, 2, 2, 1, 1, 1, 2, 0, 0, 1, 3, 1, 1, 2, 1,
+    4, 1, 2, 0, 1, 2, 1, 1, 4, 1, 1, 1, 1, 1, 0, 0,
+    1, 1, 2, 1, 3, 0, 1, 1, 2, 1, 1, 1, 1, 1, 2, 2,
+    5, 0, 1, 1, 2, 1, 1, 1, 1, 0, 2, 1, 1, 2, 0, 1,
+    1, 1, 1, 1, 3, 1, 1, 2, 1, 1, 0, 0, 0, 2, 1, 1,
+    1, 1, 0, 1, 2, 2, 1, 3, 0, 1, 3, 1, 2, 0, 1, 0,
+    1, 1, 1, 1, 2, 1, 1, 0, 0, 1, 1, 1, 1, 1, 1, 1,
+    3, 2, 1, 1, 1, 2, 1, 0, 1, 5, 0, 1, 1, 0, 0, 3,
+    1, 1, 1, 1, 0, 2, 0, 1, 1, 0, 0, 1, 1, 1, 1, 1,
+    2, 0, 3, 1, 1, 1, 0, 1, 3, 2, 2, 5, 1, 1, 0, 1,
+    1, 2, 0, 0, 0, 3, 1, 1, 1, 0, 2, 0, 1, 2, 1, 1,
+    0, 0, 1, 1, 1, 1, 6, 3, 1, 1, 1, 1, 0, 1, 1, 2,
+    3, 2, 2, 0, 1, 3, 2, 1, 0, 0, 1, 0, 2, 1, 2, 1,
+    2, 3, 1, 2, 2, 2, 1, 1, 2, 0, 3, 0, 3, 0, 1, 1,
+    1, 0, 1, 1, 1, 1, 1, 0, 1, 2, 1, 3, 0, 0, 1, 1,
+    1, 1, 1, 0, 1, 0, 4, 0, 1, 1, 4, 1, 1, 1, 1, 2,
+    1, 1, 1, 2, 1, 1, 1, 1, 1, 0, 0, 3, 0, 2, 2, 0,
+    1, 0, 1, 2, 0, 1, 1, 4, 1, 1, 1, 1, 1, 1, 2, 1,
+    0, 1, 1, 0, 2, 1, 0, 1, 1, 1, 4, 0, 2, 0, 1, 1,
+    2, 0, 1, 3, 1, 0, 6, 0, 1, 0, 1, 1, 1, 0, 3, 1,
+    1, 1, 1, 0, 1, 0, 2, 1, 1, 1, 1, 2, 2, 1, 0, 1,
+    1, 3, 4, 0, 0, 0, 1, 3, 1, 2, 1, 1, 1, 1, 1, 1,
+    1, 1, 3, 1, 0, 2, 0, 1, 1, 0, 1, 1, 0, 1, 1, 1,
+    6, 0, 6, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 2, 1, 0,
+    1, 1, 1, 0, 1, 1, 0, 0, 1, 4, 3, 0, 0, 0, 1, 1,
+    2, 1, 0, 0, 0, 0, 0, 2, 0, 0, 1, 1, 1, 3, 2, 1,
+    1, 3, 2, 1, 1, 1, 0, 1, 2, 0, 7, 0, 1, 0, 1, 2,
+};
+
+/* Must match language_key_hash in tools/generate_lexer_code.py */
+static unsigned int LanguageKeyHash(LanguageKeyKind kind, const char* key, size_t length) {
+    unsigned int hash = (2166136261u ^ (unsigned int)kind) * 16777619u;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)key[i];
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash;
+}
+
+/* Must match language_key_mix in tools/generate_lexer_code.py */
+static unsigned int LanguageKeyMix(unsigned int hash, unsigned int seed) {
+    hash ^= seed * 0x9E3779B9u;
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+LanguageType LookupLanguageKey(LanguageKeyKind kind, const char* key, size_t length) {
+    if (!key || length == 0 || length > LANGUAGE_KEY_MAX_LENGTH) {
+        return LANG_NONE;
+    }
+    unsigned int hash = LanguageKeyHash(kind, key, length);
+    unsigned int bucket = LanguageKeyMix(hash, 0) & (LANGUAGE_KEY_BUCKET_COUNT - 1);
+    unsigned int slot = LanguageKeyMix(hash, g_languageKeySeeds[bucket]) & (LANGUAGE_KEY_TABLE_SIZE - 1);
+    const LanguageKey* entry = &g_languageKeys[slot];
+    if (!entry->key || entry->kind != kind || entry->length != length) {
+        return LANG_NONE;
+    }
+    for (size_t i = 0; i < length; i++) {
+        char c = key[i];
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        if (c != entry->key[i]) {
+            return LANG_NONE;
+        }
+    }
+    return entry->language;
+}
+
+/* Content sniffing keywords - weighted by how few languages share each one */
+const SniffScore g_sniffScores[SNIFF_SCORE_COUNT] = {
+    {LANG_C, 391},
+    {LANG_CPP, 391},
+    {LANG_C, 491},
+    {LANG_C, 491},
+    {LANG_C, 491},
+    {LANG_C, 391},
+    {LANG_CPP, 391},
+    {LANG_C, 491},
+    {LANG_PYTHON, 491},
+    {LANG_PYTHON, 491},
+    {LANG_PYTHON, 491},
+    {LANG_C, 491},
+    {LANG_ADA, 491},
+    {LANG_ADA, 391},
+    {LANG_VHDL, 391},
+    {LANG_ADA, 258},
+    {LANG_CS, 258},
+    {LANG_JAVA, 258},
+    {LANG_JULIA, 258},
+    {LANG_SCALA, 258},
+    {LANG_ADA, 491},
+    {LANG_ADA, 391},
+    {LANG_VHDL, 391},
+    {LANG_RUBY, 391},
+    {LANG_VHDL, 391},
+    {LANG_ADA, 491},
+    {LANG_FORTRAN, 491},
+    {LANG_SQL, 491},
+    {LANG_VERILOG, 491},
+    {LANG_CPP, 491},
+    {LANG_ERLANG, 491},
+    {LANG_VHDL, 491},
+    {LANG_ADA, 332},
+    {LANG_PASCAL, 332},
+    {LANG_VHDL, 332},
+    {LANG_CPP, 491},
+    {LANG_DART, 291},
+    {LANG_JAVA, 291},
+    {LANG_PYTHON, 291},
+    {LANG_VHDL, 291},
+    {LANG_VERILOG, 491},
+    {LANG_DART, 332},
+    {LANG_JAVASCRIPT, 332},
+    {LANG_PYTHON, 332},
+    {LANG_RUBY, 491},
+    {LANG_RUBY, 491},
+    {LANG_VHDL, 491},
+    {LANG_C, 391},
+    {LANG_CPP, 391},
+    {LANG_VERILOG, 491},
+    {LANG_SQL, 491},
+    {LANG_DART, 332},
+    {LANG_JAVASCRIPT, 332},
+    {LANG_PYTHON, 332},
+    {LANG_ERLANG, 491},
+    {LANG_CS, 491},
+    {LANG_ADA, 191},
+    {LANG_ERLANG, 191},
+    {LANG_PASCAL, 191},
+    {LANG_PERL, 191},
+    {LANG_POWERSHELL, 191},
+    {LANG_RUBY, 191},
+    {LANG_VHDL, 191},
+    {LANG_VERILOG, 191},
+    {LANG_CPP, 491},
+    {LANG_CPP, 491},
+    {LANG_ERLANG, 491},
+    {LANG_CS, 391},
+    {LANG_CPP, 391},
+    {LANG_JAVA, 491},
+    {LANG_ERLANG, 491},
+    {LANG_C, 82},
+    {LANG_CS, 82},
+    {LANG_CPP, 82},
+    {LANG_DART, 82},
+    {LANG_GO, 82},
+    {LANG_JAVA, 82},
+    {LANG_JAVASCRIPT, 82},
+    {LANG_JULIA, 82},
+    {LANG_KOTLIN, 82},
+    {LANG_LUA, 82},
+    {LANG_MATLAB, 82},
+    {LANG_POWERSHELL, 82},
+    {LANG_PYTHON, 82},
+    {LANG_R, 82},
+    {LANG_RUBY, 82},
+    {LANG_RUST, 82},
+    {LANG_SWIFT, 82},
+    {LANG_ERLANG, 491},
+    {LANG_ERLANG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VHDL, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VHDL, 491},
+    {LANG_ERLANG, 491},
+    {LANG_CS, 391},
+    {LANG_JAVA, 391},
+    {LANG_C, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_CS, 145},
+    {LANG_CPP, 145},
+    {LANG_DART, 145},
+    {LANG_ERLANG, 145},
+    {LANG_JAVA, 145},
+    {LANG_JAVASCRIPT, 145},
+    {LANG_JULIA, 145},
+    {LANG_MATLAB, 145},
+    {LANG_POWERSHELL, 145},
+    {LANG_SCALA, 145},
+    {LANG_SWIFT, 145},
+    {LANG_VERILOG, 491},
+    {LANG_CPP, 491},
+    {LANG_MAKEFILE, 491},
+    {LANG_GO, 491},
+    {LANG_C, 291},
+    {LANG_CS, 291},
+    {LANG_CPP, 291},
+    {LANG_JAVA, 291},
+    {LANG_FORTRAN, 491},
+    {LANG_CS, 491},
+    {LANG_PERL, 491},
+    {LANG_CS, 121},
+    {LANG_CPP, 121},
+    {LANG_DART, 121},
+    {LANG_HASKELL, 121},
+    {LANG_JAVA, 121},
+    {LANG_JAVASCRIPT, 121},
+    {LANG_KOTLIN, 121},
+    {LANG_PASCAL, 121},
+    {LANG_POWERSHELL, 121},
+    {LANG_PYTHON, 121},
+    {LANG_RUBY, 121},
+    {LANG_SCALA, 121},
+    {LANG_SWIFT, 121},
+    {LANG_MATLAB, 491},
+    {LANG_VERILOG, 491},
+    {LANG_FORTRAN, 491},
+    {LANG_CPP, 491},
+    {LANG_VHDL, 491},
+    {LANG_ERLANG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VHDL, 491},
+    {LANG_JAVASCRIPT, 491},
+    {LANG_C, 158},
+    {LANG_CS, 158},
+    {LANG_CPP, 158},
+    {LANG_DART, 158},
+    {LANG_GO, 158},
+    {LANG_JAVA, 158},
+    {LANG_JAVASCRIPT, 158},
+    {LANG_JULIA, 158},
+    {LANG_PASCAL, 158},
+    {LANG_RUST, 158},
+    {LANG_CPP, 491},
+    {LANG_ADA, 391},
+    {LANG_VHDL, 391},
+    {LANG_CPP, 491},
+    {LANG_PASCAL, 491},
+    {LANG_C, 110},
+    {LANG_CS, 110},
+    {LANG_CPP, 110},
+    {LANG_DART, 110},
+    {LANG_GO, 110},
+    {LANG_JAVA, 110},
+    {LANG_JAVASCRIPT, 110},
+    {LANG_JULIA, 110},
+    {LANG_KOTLIN, 110},
+    {LANG_MATLAB, 110},
+    {LANG_POWERSHELL, 110},
+    {LANG_PYTHON, 110},
+    {LANG_RUST, 110},
+    {LANG_SWIFT, 110},
+    {LANG_SHELL, 491},
+    {LANG_SQL, 491},
+    {LANG_CPP, 491},
+    {LANG_RUST, 491},
+    {LANG_SQL, 491},
+    {LANG_FORTRAN, 491},
+    {LANG_VERILOG, 491},
+    {LANG_JAVASCRIPT, 491},
+    {LANG_CS, 491},
+    {LANG_ADA, 491},
+    {LANG_CLOJURE, 291},
+    {LANG_PYTHON, 291},
+    {LANG_RUBY, 291},
+    {LANG_SCALA, 291},
+    {LANG_GO, 391},
+    {LANG_SWIFT, 391},
+    {LANG_POWERSHELL, 491},
+    {LANG_CLOJURE, 491},
+    {LANG_CLOJURE, 491},
+    {LANG_VERILOG, 491},
+    {LANG_CLOJURE, 491},
+    {LANG_CLOJURE, 491},
+    {LANG_CLOJURE, 491},
+    {LANG_CLOJURE, 491},
+    {LANG_PYTHON, 491},
+    {LANG_ADA, 491},
+    {LANG_CS, 491},
+    {LANG_CPP, 332},
+    {LANG_JAVASCRIPT, 332},
+    {LANG_SQL, 332},
+    {LANG_ADA, 491},
+    {LANG_HASKELL, 491},
+    {LANG_VERILOG, 491},
+    {LANG_PASCAL, 491},
+    {LANG_ADA, 491},
+    {LANG_FORTRAN, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VHDL, 491},
+    {LANG_SQL, 491},
+    {LANG_ERLANG, 391},
+    {LANG_PASCAL, 391},
+    {LANG_JAVASCRIPT, 491},
+    {LANG_SHELL, 491},
+    {LANG_CLOJURE, 491},
+    {LANG_CLOJURE, 491},
+    {LANG_C, 291},
+    {LANG_CS, 291},
+    {LANG_CPP, 291},
+    {LANG_JAVA, 291},
+    {LANG_PASCAL, 391},
+    {LANG_VHDL, 391},
+    {LANG_SQL, 491},
+    {LANG_RUST, 491},
+    {LANG_CPP, 491},
+    {LANG_POWERSHELL, 491},
+    {LANG_SHELL, 491},
+    {LANG_VERILOG, 491},
+    {LANG_PYTHON, 391},
+    {LANG_SHELL, 391},
+    {LANG_ADA, 26},
+    {LANG_C, 26},
+    {LANG_CS, 26},
+    {LANG_CPP, 26},
+    {LANG_DART, 26},
+    {LANG_GO, 26},
+    {LANG_HASKELL, 26},
+    {LANG_JAVA, 26},
+    {LANG_JAVASCRIPT, 26},
+    {LANG_JULIA, 26},
+    {LANG_KOTLIN, 26},
+    {LANG_LUA, 26},
+    {LANG_MATLAB, 26},
+    {LANG_PASCAL, 26},
+    {LANG_PERL, 26},
+    {LANG_POWERSHELL, 26},
+    {LANG_PYTHON, 26},
+    {LANG_R, 26},
+    {LANG_RUBY, 26},
+    {LANG_RUST, 26},
+    {LANG_SCALA, 26},
+    {LANG_SHELL, 26},
+    {LANG_SWIFT, 26},
+    {LANG_VHDL, 26},
+    {LANG_VERILOG, 26},
+    {LANG_JULIA, 291},
+    {LANG_LUA, 291},
+    {LANG_MATLAB, 291},
+    {LANG_POWERSHELL, 291},
+    {LANG_ADA, 291},
+    {LANG_PERL, 291},
+    {LANG_RUBY, 291},
+    {LANG_VHDL, 291},
+    {LANG_ADA, 132},
+    {LANG_ERLANG, 132},
+    {LANG_FORTRAN, 132},
+    {LANG_JULIA, 132},
+    {LANG_LUA, 132},
+    {LANG_MATLAB, 132},
+    {LANG_PASCAL, 132},
+    {LANG_PERL, 132},
+    {LANG_POWERSHELL, 132},
+    {LANG_RUBY, 132},
+    {LANG_VHDL, 132},
+    {LANG_VERILOG, 132},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_MAKEFILE, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_MAKEFILE, 491},
+    {LANG_CPP, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_RUBY, 491},
+    {LANG_VHDL, 491},
+    {LANG_C, 210},
+    {LANG_CS, 210},
+    {LANG_CPP, 210},
+    {LANG_DART, 210},
+    {LANG_JAVA, 210},
+    {LANG_RUST, 210},
+    {LANG_SWIFT, 210},
+    {LANG_FORTRAN, 491},
+    {LANG_SHELL, 491},
+    {LANG_PASCAL, 391},
+    {LANG_PYTHON, 391},
+    {LANG_ADA, 491},
+    {LANG_ADA, 291},
+    {LANG_POWERSHELL, 291},
+    {LANG_SHELL, 291},
+    {LANG_VHDL, 291},
+    {LANG_CS, 391},
+    {LANG_CPP, 391},
+    {LANG_CPP, 291},
+    {LANG_JAVASCRIPT, 291},
+    {LANG_JULIA, 291},
+    {LANG_SHELL, 291},
+    {LANG_JAVASCRIPT, 491},
+    {LANG_DART, 291},
+    {LANG_JAVA, 291},
+    {LANG_JAVASCRIPT, 291},
+    {LANG_SCALA, 291},
+    {LANG_SWIFT, 491},
+    {LANG_C, 291},
+    {LANG_CS, 291},
+    {LANG_CPP, 291},
+    {LANG_RUST, 291},
+    {LANG_GO, 391},
+    {LANG_SWIFT, 391},
+    {LANG_CS, 145},
+    {LANG_CPP, 145},
+    {LANG_DART, 145},
+    {LANG_KOTLIN, 145},
+    {LANG_LUA, 145},
+    {LANG_PYTHON, 145},
+    {LANG_R, 145},
+    {LANG_RUBY, 145},
+    {LANG_RUST, 145},
+    {LANG_SCALA, 145},
+    {LANG_SWIFT, 145},
+    {LANG_SHELL, 491},
+    {LANG_CPP, 291},
+    {LANG_DART, 291},
+    {LANG_JAVA, 291},
+    {LANG_SCALA, 291},
+    {LANG_CS, 491},
+    {LANG_C, 291},
+    {LANG_CS, 291},
+    {LANG_CPP, 291},
+    {LANG_JAVA, 291},
+    {LANG_GO, 491},
+    {LANG_RUST, 491},
+    {LANG_VERILOG, 491},
+    {LANG_CS, 332},
+    {LANG_PERL, 332},
+    {LANG_POWERSHELL, 332},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_SCALA, 491},
+    {LANG_C, 491},
+    {LANG_C, 491},
+    {LANG_CPP, 491},
+    {LANG_ERLANG, 391},
+    {LANG_KOTLIN, 391},
+    {LANG_GO, 391},
+    {LANG_SWIFT, 391},
+    {LANG_ADA, 132},
+    {LANG_FORTRAN, 132},
+    {LANG_JAVASCRIPT, 132},
+    {LANG_JULIA, 132},
+    {LANG_LUA, 132},
+    {LANG_MATLAB, 132},
+    {LANG_PASCAL, 132},
+    {LANG_POWERSHELL, 132},
+    {LANG_R, 132},
+    {LANG_SHELL, 132},
+    {LANG_VHDL, 132},
+    {LANG_VERILOG, 132},
+    {LANG_VHDL, 391},
+    {LANG_VERILOG, 391},
+    {LANG_ADA, 391},
+    {LANG_VHDL, 391},
+    {LANG_VERILOG, 491},
+    {LANG_DART, 391},
+    {LANG_POWERSHELL, 391},
+    {LANG_JULIA, 332},
+    {LANG_MATLAB, 332},
+    {LANG_PYTHON, 332},
+    {LANG_GO, 491},
+    {LANG_ADA, 174},
+    {LANG_C, 174},
+    {LANG_CS, 174},
+    {LANG_CPP, 174},
+    {LANG_GO, 174},
+    {LANG_JAVA, 174},
+    {LANG_LUA, 174},
+    {LANG_PASCAL, 174},
+    {LANG_PERL, 174},
+    {LANG_SWIFT, 491},
+    {LANG_VHDL, 491},
+    {LANG_SQL, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_POWERSHELL, 491},
+    {LANG_MAKEFILE, 491},
+    {LANG_MAKEFILE, 491},
+    {LANG_MAKEFILE, 491},
+    {LANG_MAKEFILE, 491},
+    {LANG_VERILOG, 491},
+    {LANG_RUST, 491},
+    {LANG_PASCAL, 491},
+    {LANG_DART, 391},
+    {LANG_JAVA, 391},
+    {LANG_CS, 332},
+    {LANG_FORTRAN, 332},
+    {LANG_SCALA, 332},
+    {LANG_CLOJURE, 158},
+    {LANG_DART, 158},
+    {LANG_GO, 158},
+    {LANG_HASKELL, 158},
+    {LANG_JAVA, 158},
+    {LANG_JAVASCRIPT, 158},
+    {LANG_JULIA, 158},
+    {LANG_PYTHON, 158},
+    {LANG_SCALA, 158},
+    {LANG_SWIFT, 158},
+    {LANG_VHDL, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VHDL, 491},
+    {LANG_R, 491},
+    {LANG_HASKELL, 491},
+    {LANG_HASKELL, 491},
+    {LANG_HASKELL, 491},
+    {LANG_PASCAL, 491},
+    {LANG_SWIFT, 491},
+    {LANG_VERILOG, 491},
+    {LANG_C, 391},
+    {LANG_CPP, 391},
+    {LANG_POWERSHELL, 491},
+    {LANG_SQL, 491},
+    {LANG_VHDL, 391},
+    {LANG_VERILOG, 391},
+    {LANG_VERILOG, 491},
+    {LANG_SQL, 491},
+    {LANG_HASKELL, 391},
+    {LANG_VERILOG, 391},
+    {LANG_JAVA, 391},
+    {LANG_JAVASCRIPT, 391},
+    {LANG_C, 291},
+    {LANG_CS, 291},
+    {LANG_CPP, 291},
+    {LANG_JAVA, 291},
+    {LANG_FORTRAN, 391},
+    {LANG_SQL, 391},
+    {LANG_ADA, 210},
+    {LANG_CS, 210},
+    {LANG_DART, 210},
+    {LANG_GO, 210},
+    {LANG_JAVA, 210},
+    {LANG_KOTLIN, 210},
+    {LANG_PASCAL, 210},
+    {LANG_CS, 391},
+    {LANG_SWIFT, 391},
+    {LANG_LUA, 491},
+    {LANG_SQL, 391},
+    {LANG_VERILOG, 391},
+    {LANG_SQL, 491},
+    {LANG_PYTHON, 491},
+    {LANG_VERILOG, 491},
+    {LANG_SCALA, 491},
+    {LANG_MAKEFILE, 491},
+    {LANG_PYTHON, 491},
+    {LANG_CLOJURE, 210},
+    {LANG_ERLANG, 210},
+    {LANG_HASKELL, 210},
+    {LANG_JAVASCRIPT, 210},
+    {LANG_JULIA, 210},
+    {LANG_RUST, 210},
+    {LANG_SWIFT, 210},
+    {LANG_VERILOG, 491},
+    {LANG_ADA, 491},
+    {LANG_VHDL, 491},
+    {LANG_VHDL, 491},
+    {LANG_JULIA, 291},
+    {LANG_LUA, 291},
+    {LANG_PERL, 291},
+    {LANG_SHELL, 291},
+    {LANG_VERILOG, 491},
+    {LANG_CS, 491},
+    {LANG_FORTRAN, 491},
+    {LANG_C, 291},
+    {LANG_CS, 291},
+    {LANG_CPP, 291},
+    {LANG_JAVA, 291},
+    {LANG_ADA, 291},
+    {LANG_CLOJURE, 291},
+    {LANG_RUST, 291},
+    {LANG_VHDL, 291},
+    {LANG_JULIA, 491},
+    {LANG_VERILOG, 491},
+    {LANG_C, 491},
+    {LANG_RUST, 391},
+    {LANG_SCALA, 391},
+    {LANG_SQL, 491},
+    {LANG_VERILOG, 491},
+    {LANG_C, 491},
+    {LANG_SQL, 491},
+    {LANG_ADA, 291},
+    {LANG_PASCAL, 291},
+    {LANG_RUST, 291},
+    {LANG_VHDL, 291},
+    {LANG_FORTRAN, 232},
+    {LANG_HASKELL, 232},
+    {LANG_JAVASCRIPT, 232},
+    {LANG_JULIA, 232},
+    {LANG_RUBY, 232},
+    {LANG_VERILOG, 232},
+    {LANG_RUST, 491},
+    {LANG_RUST, 491},
+    {LANG_CPP, 491},
+    {LANG_PERL, 491},
+    {LANG_R, 491},
+    {LANG_CS, 391},
+    {LANG_CPP, 391},
+    {LANG_R, 491},
+    {LANG_VHDL, 391},
+    {LANG_VERILOG, 391},
+    {LANG_JAVA, 491},
+    {LANG_VERILOG, 491},
+    {LANG_HASKELL, 491},
+    {LANG_LUA, 332},
+    {LANG_RUBY, 332},
+    {LANG_SWIFT, 332},
+    {LANG_VERILOG, 491},
+    {LANG_CPP, 491},
+    {LANG_FORTRAN, 391},
+    {LANG_PYTHON, 391},
+    {LANG_VHDL, 391},
+    {LANG_VERILOG, 391},
+    {LANG_VERILOG, 491},
+    {LANG_CPP, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_CLOJURE, 491},
+    {LANG_ADA, 174},
+    {LANG_C, 174},
+    {LANG_CS, 174},
+    {LANG_DART, 174},
+    {LANG_KOTLIN, 174},
+    {LANG_R, 174},
+    {LANG_SQL, 174},
+    {LANG_SCALA, 174},
+    {LANG_VHDL, 174},
+    {LANG_CPP, 491},
+    {LANG_CS, 258},
+    {LANG_KOTLIN, 258},
+    {LANG_PASCAL, 258},
+    {LANG_POWERSHELL, 258},
+    {LANG_SCALA, 258},
+    {LANG_CS, 332},
+    {LANG_CPP, 332},
+    {LANG_DART, 332},
+    {LANG_RUST, 491},
+    {LANG_CPP, 491},
+    {LANG_ERLANG, 491},
+    {LANG_MATLAB, 491},
+    {LANG_PERL, 491},
+    {LANG_SQL, 491},
+    {LANG_POWERSHELL, 391},
+    {LANG_VERILOG, 391},
+    {LANG_CS, 332},
+    {LANG_CPP, 332},
+    {LANG_SCALA, 332},
+    {LANG_ADA, 491},
+    {LANG_ADA, 210},
+    {LANG_GO, 210},
+    {LANG_JAVA, 210},
+    {LANG_KOTLIN, 210},
+    {LANG_PERL, 210},
+    {LANG_SCALA, 210},
+    {LANG_VHDL, 210},
+    {LANG_PASCAL, 491},
+    {LANG_LUA, 491},
+    {LANG_POWERSHELL, 491},
+    {LANG_POWERSHELL, 491},
+    {LANG_FORTRAN, 391},
+    {LANG_VERILOG, 391},
+    {LANG_CS, 491},
+    {LANG_MATLAB, 491},
+    {LANG_DART, 491},
+    {LANG_PYTHON, 491},
+    {LANG_MATLAB, 491},
+    {LANG_MAKEFILE, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VHDL, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VHDL, 491},
+    {LANG_ADA, 491},
+    {LANG_SQL, 491},
+    {LANG_VERILOG, 491},
+    {LANG_PERL, 391},
+    {LANG_PYTHON, 391},
+    {LANG_C, 491},
+    {LANG_GO, 391},
+    {LANG_RUST, 391},
+    {LANG_ADA, 232},
+    {LANG_CS, 232},
+    {LANG_CPP, 232},
+    {LANG_JAVA, 232},
+    {LANG_SCALA, 232},
+    {LANG_SWIFT, 232},
+    {LANG_ADA, 332},
+    {LANG_PASCAL, 332},
+    {LANG_VHDL, 332},
+    {LANG_POWERSHELL, 391},
+    {LANG_VHDL, 391},
+    {LANG_FORTRAN, 391},
+    {LANG_PASCAL, 391},
+    {LANG_PASCAL, 491},
+    {LANG_ADA, 258},
+    {LANG_CS, 258},
+    {LANG_CPP, 258},
+    {LANG_JAVA, 258},
+    {LANG_SCALA, 258},
+    {LANG_SWIFT, 491},
+    {LANG_JAVASCRIPT, 491},
+    {LANG_RUST, 491},
+    {LANG_CS, 291},
+    {LANG_CPP, 291},
+    {LANG_JAVA, 291},
+    {LANG_SWIFT, 291},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VHDL, 491},
+    {LANG_RUBY, 491},
+    {LANG_ERLANG, 491},
+    {LANG_JULIA, 491},
+    {LANG_PERL, 491},
+    {LANG_ADA, 332},
+    {LANG_PASCAL, 332},
+    {LANG_PYTHON, 332},
+    {LANG_VERILOG, 491},
+    {LANG_CS, 391},
+    {LANG_SHELL, 391},
+    {LANG_FORTRAN, 391},
+    {LANG_VERILOG, 391},
+    {LANG_VERILOG, 491},
+    {LANG_ERLANG, 491},
+    {LANG_CLOJURE, 491},
+    {LANG_PERL, 391},
+    {LANG_RUBY, 391},
+    {LANG_CS, 391},
+    {LANG_RUST, 391},
+    {LANG_VERILOG, 491},
+    {LANG_C, 332},
+    {LANG_CPP, 332},
+    {LANG_VHDL, 332},
+    {LANG_CPP, 491},
+    {LANG_VHDL, 491},
+    {LANG_ADA, 332},
+    {LANG_ERLANG, 332},
+    {LANG_VHDL, 332},
+    {LANG_ADA, 491},
+    {LANG_LUA, 258},
+    {LANG_PASCAL, 258},
+    {LANG_R, 258},
+    {LANG_SWIFT, 258},
+    {LANG_VERILOG, 258},
+    {LANG_ADA, 491},
+    {LANG_CLOJURE, 258},
+    {LANG_JAVASCRIPT, 258},
+    {LANG_LUA, 258},
+    {LANG_PERL, 258},
+    {LANG_RUBY, 258},
+    {LANG_RUBY, 491},
+    {LANG_C, 491},
+    {LANG_DART, 491},
+    {LANG_RUBY, 491},
+    {LANG_ADA, 58},
+    {LANG_C, 58},
+    {LANG_CS, 58},
+    {LANG_CPP, 58},
+    {LANG_DART, 58},
+    {LANG_GO, 58},
+    {LANG_JAVA, 58},
+    {LANG_JAVASCRIPT, 58},
+    {LANG_JULIA, 58},
+    {LANG_KOTLIN, 58},
+    {LANG_LUA, 58},
+    {LANG_MATLAB, 58},
+    {LANG_PERL, 58},
+    {LANG_POWERSHELL, 58},
+    {LANG_PYTHON, 58},
+    {LANG_RUBY, 58},
+    {LANG_RUST, 58},
+    {LANG_SCALA, 58},
+    {LANG_SWIFT, 58},
+    {LANG_VHDL, 58},
+    {LANG_ADA, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VHDL, 491},
+    {LANG_VHDL, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_FORTRAN, 491},
+    {LANG_CS, 491},
+    {LANG_VERILOG, 491},
+    {LANG_CS, 391},
+    {LANG_SCALA, 391},
+    {LANG_ADA, 258},
+    {LANG_GO, 258},
+    {LANG_SQL, 258},
+    {LANG_SHELL, 258},
+    {LANG_VHDL, 258},
+    {LANG_PYTHON, 291},
+    {LANG_RUBY, 291},
+    {LANG_RUST, 291},
+    {LANG_SWIFT, 291},
+    {LANG_ADA, 491},
+    {LANG_VHDL, 491},
+    {LANG_VHDL, 491},
+    {LANG_CPP, 491},
+    {LANG_SHELL, 491},
+    {LANG_PASCAL, 491},
+    {LANG_C, 291},
+    {LANG_CS, 291},
+    {LANG_CPP, 291},
+    {LANG_JAVA, 291},
+    {LANG_VERILOG, 491},
+    {LANG_PASCAL, 491},
+    {LANG_VHDL, 491},
+    {LANG_C, 332},
+    {LANG_CPP, 332},
+    {LANG_VERILOG, 332},
+    {LANG_C, 491},
+    {LANG_C, 332},
+    {LANG_CS, 332},
+    {LANG_CPP, 332},
+    {LANG_VHDL, 491},
+    {LANG_VHDL, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_MATLAB, 491},
+    {LANG_C, 491},
+    {LANG_VHDL, 491},
+    {LANG_VHDL, 491},
+    {LANG_CS, 491},
+    {LANG_C, 210},
+    {LANG_CS, 210},
+    {LANG_CPP, 210},
+    {LANG_DART, 210},
+    {LANG_JAVA, 210},
+    {LANG_RUST, 210},
+    {LANG_SWIFT, 210},
+    {LANG_CPP, 491},
+    {LANG_CPP, 491},
+    {LANG_C, 491},
+    {LANG_C, 491},
+    {LANG_PERL, 491},
+    {LANG_JAVA, 491},
+    {LANG_CS, 391},
+    {LANG_CPP, 391},
+    {LANG_C, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_C, 210},
+    {LANG_CS, 210},
+    {LANG_CPP, 210},
+    {LANG_GO, 210},
+    {LANG_JULIA, 210},
+    {LANG_RUST, 210},
+    {LANG_SWIFT, 210},
+    {LANG_PERL, 491},
+    {LANG_FORTRAN, 491},
+    {LANG_SWIFT, 491},
+    {LANG_ADA, 391},
+    {LANG_VHDL, 391},
+    {LANG_SQL, 491},
+    {LANG_DART, 191},
+    {LANG_JAVA, 191},
+    {LANG_JAVASCRIPT, 191},
+    {LANG_KOTLIN, 191},
+    {LANG_RUBY, 191},
+    {LANG_RUST, 191},
+    {LANG_SCALA, 191},
+    {LANG_SWIFT, 191},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_C, 158},
+    {LANG_CS, 158},
+    {LANG_CPP, 158},
+    {LANG_DART, 158},
+    {LANG_GO, 158},
+    {LANG_JAVA, 158},
+    {LANG_JAVASCRIPT, 158},
+    {LANG_MATLAB, 158},
+    {LANG_POWERSHELL, 158},
+    {LANG_SWIFT, 158},
+    {LANG_DART, 491},
+    {LANG_ADA, 391},
+    {LANG_JAVA, 391},
+    {LANG_SQL, 391},
+    {LANG_VERILOG, 391},
+    {LANG_ADA, 491},
+    {LANG_ADA, 391},
+    {LANG_VERILOG, 391},
+    {LANG_CPP, 491},
+    {LANG_ADA, 491},
+    {LANG_ADA, 210},
+    {LANG_HASKELL, 210},
+    {LANG_LUA, 210},
+    {LANG_PASCAL, 210},
+    {LANG_RUBY, 210},
+    {LANG_SHELL, 210},
+    {LANG_VHDL, 210},
+    {LANG_CS, 174},
+    {LANG_CPP, 174},
+    {LANG_DART, 174},
+    {LANG_JAVA, 174},
+    {LANG_JAVASCRIPT, 174},
+    {LANG_KOTLIN, 174},
+    {LANG_POWERSHELL, 174},
+    {LANG_SCALA, 174},
+    {LANG_SWIFT, 174},
+    {LANG_JAVA, 491},
+    {LANG_RUST, 391},
+    {LANG_SCALA, 391},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_JAVA, 491},
+    {LANG_POWERSHELL, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_CS, 145},
+    {LANG_CPP, 145},
+    {LANG_DART, 145},
+    {LANG_KOTLIN, 145},
+    {LANG_LUA, 145},
+    {LANG_PYTHON, 145},
+    {LANG_R, 145},
+    {LANG_RUBY, 145},
+    {LANG_RUST, 145},
+    {LANG_SCALA, 145},
+    {LANG_SWIFT, 145},
+    {LANG_CS, 110},
+    {LANG_CPP, 110},
+    {LANG_DART, 110},
+    {LANG_ERLANG, 110},
+    {LANG_JAVA, 110},
+    {LANG_JAVASCRIPT, 110},
+    {LANG_JULIA, 110},
+    {LANG_KOTLIN, 110},
+    {LANG_MATLAB, 110},
+    {LANG_PASCAL, 110},
+    {LANG_POWERSHELL, 110},
+    {LANG_PYTHON, 110},
+    {LANG_SCALA, 110},
+    {LANG_SWIFT, 110},
+    {LANG_C, 332},
+    {LANG_CPP, 332},
+    {LANG_DART, 332},
+    {LANG_CPP, 491},
+    {LANG_CPP, 491},
+    {LANG_CS, 391},
+    {LANG_JAVASCRIPT, 391},
+    {LANG_CS, 491},
+    {LANG_CS, 491},
+    {LANG_VHDL, 491},
+    {LANG_CS, 491},
+    {LANG_RUBY, 491},
+    {LANG_JAVASCRIPT, 491},
+    {LANG_C, 332},
+    {LANG_CPP, 332},
+    {LANG_SQL, 332},
+    {LANG_CPP, 491},
+    {LANG_VHDL, 491},
+    {LANG_PERL, 391},
+    {LANG_RUBY, 391},
+    {LANG_CS, 391},
+    {LANG_RUST, 391},
+    {LANG_SHELL, 491},
+    {LANG_C, 391},
+    {LANG_CPP, 391},
+    {LANG_SQL, 491},
+    {LANG_PASCAL, 491},
+    {LANG_CS, 491},
+    {LANG_CS, 332},
+    {LANG_CPP, 332},
+    {LANG_JULIA, 332},
+    {LANG_VERILOG, 491},
+    {LANG_KOTLIN, 391},
+    {LANG_SCALA, 391},
+    {LANG_SQL, 491},
+    {LANG_DART, 210},
+    {LANG_GO, 210},
+    {LANG_JAVASCRIPT, 210},
+    {LANG_KOTLIN, 210},
+    {LANG_PASCAL, 210},
+    {LANG_SCALA, 210},
+    {LANG_SWIFT, 210},
+    {LANG_SQL, 491},
+    {LANG_VHDL, 491},
+    {LANG_RUST, 491},
+    {LANG_CPP, 491},
+    {LANG_VERILOG, 491},
+    {LANG_CS, 391},
+    {LANG_CPP, 391},
+    {LANG_C, 232},
+    {LANG_CS, 232},
+    {LANG_CPP, 232},
+    {LANG_DART, 232},
+    {LANG_JAVA, 232},
+    {LANG_JAVASCRIPT, 232},
+    {LANG_C, 291},
+    {LANG_CS, 291},
+    {LANG_CPP, 291},
+    {LANG_JAVA, 291},
+    {LANG_VERILOG, 491},
+    {LANG_PERL, 491},
+    {LANG_CPP, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_JAVASCRIPT, 491},
+    {LANG_VERILOG, 491},
+    {LANG_VERILOG, 491},
+    {LANG_POWERSHELL, 491},
+    {LANG_POWERSHELL, 491},
+    {LANG_VHDL, 391},
+    {LANG_VERILOG, 391},
+    {LANG_ADA, 232},
+    {LANG_CPP, 232},
+    {LANG_ERLANG, 232},
+    {LANG_PASCAL, 232},
+    {LANG_VHDL, 232},
+    {LANG_VERILOG, 232},
+    {LANG_CPP, 491},
+    {LANG_DART, 258},
+    {LANG_JAVASCRIPT, 258},
+    {LANG_PYTHON, 258},
+    {LANG_RUBY, 258},
+    {LANG_SCALA, 258},
+};
+
+const SniffToken g_sniffTokens[SNIFF_TOKEN_TABLE_SIZE] = {
+    [0] = {"div", 3, 2, 213},
+    [5] = {"nan", 3, 1, 522},
+    [6] = {"genvar", 6, 1, 379},
+    [10] = {"ref", 3, 2, 653},
+    [11] = {"module", 6, 6, 509},
+    [15] = {"self", 4, 4, 718},
+    [20] = {"fmt", 3, 1, 347},
+    [21] = {"primitive", 9, 1, 597},
+    [24] = {"units", 5, 1, 885},
+    [26] = {"bsr", 3, 1, 89},
+    [27] = {"redo", 4, 2, 651},
+    [28] = {"base", 4, 1, 55},
+    [29] = {"bitand", 6, 1, 64},
+    [32] = {"separate", 8, 1, 722},
+    [35] = {"bor", 3, 1, 70},
+    [41] = {"trap", 4, 1, 836},
+    [42] = {"static", 6, 7, 752},
+    [46] = {"true", 4, 11, 843},
+    [47] = {"inf", 3, 1, 427},
+    [49] = {"terminate", 9, 1, 812},
+    [50] = {"friend", 6, 1, 358},
+    [53] = {"inout", 5, 2, 438},
+    [54] = {"struct", 6, 7, 770},
+    [59] = {"scalared", 8, 1, 710},
+    [61] = {"disable", 7, 1, 210},
+    [62] = {"volatile", 8, 4, 923},
+    [63] = {"transient", 9, 1, 835},
+    [64] = {"or_eq", 5, 1, 561},
+    [65] = {"bufif1", 6, 1, 93},
+    [66] = {"band", 4, 1, 54},
+    [67] = {"pairs", 5, 1, 580},
+    [68] = {"dyn", 3, 1, 226},
+    [69] = {"del", 3, 1, 198},
+    [70] = {"reverse", 7, 1, 700},
+    [71] = {"pullup", 6, 1, 632},
+    [76] = {"inlinescript", 12, 1, 436},
+    [78] = {"#ifdef", 6, 1, 3},
+    [79] = {"catch", 5, 11, 101},
+    [81] = {"sync", 4, 1, 803},
+    [82] = {"export", 6, 4, 310},
+    [83] = {"otherwise", 9, 1, 563},
+    [84] = {"real", 4, 2, 646},
+    [86] = {"infixr", 6, 1, 430},
+    [88] = {"using", 5, 3, 896},
+    [91] = {"forever", 7, 1, 353},
+    [92] = {"wand", 4, 1, 927},
+    [94] = {"assert", 6, 4, 36},
+    [95] = {"andalso", 7, 1, 30},
+    [96] = {"rpmos", 5, 1, 704},
+    [99] = {"void", 4, 6, 917},
+    [100] = {"our", 3, 1, 564},
+    [102] = {"undef", 5, 1, 879},
+    [103] = {"dimension", 9, 1, 209},
+    [104] = {"chan", 4, 1, 115},
+    [107] = {"sra", 3, 1, 749},
+    [108] = {"byte", 4, 2, 96},
+    [109] = {"guarded", 7, 1, 396},
+    [110] = {"repeat", 6, 5, 665},
+    [111] = {"dynamic_cast", 12, 1, 227},
+    [112] = {"variable", 8, 1, 911},
+    [113] = {"large", 5, 1, 466},
+    [114] = {"len", 3, 1, 469},
+    [115] = {"prototype", 9, 1, 623},
+    [116] = {"crate", 5, 1, 177},
+    [117] = {"endtable", 8, 1, 288},
+    [119] = {"quote", 5, 1, 638},
+    [120] = {"disconnect", 10, 1, 211},
+    [122] = {"overriding", 10, 1, 571},
+    [125] = {"unset", 5, 1, 890},
+    [126] = {"ldflags", 7, 1, 468},
+    [127] = {"specify", 7, 1, 745},
+    [128] = {"shared", 6, 1, 724},
+    [130] = {"wchar_t", 7, 1, 929},
+    [132] = {"rethrow", 7, 1, 678},
+    [133] = {"tran", 4, 1, 832},
+    [135] = {"const_cast", 10, 1, 155},
+    [136] = {"inline", 6, 2, 434},
+    [137] = {"try", 3, 14, 854},
+    [138] = {"end", 3, 12, 266},
+    [140] = {"deassign", 8, 1, 180},
+    [142] = {"cell", 4, 1, 112},
+    [143] = {"sizeof", 6, 3, 739},
+    [144] = {"ifeq", 4, 1, 402},
+    [145] = {"params", 6, 1, 585},
+    [147] = {"calloc", 6, 1, 98},
+    [151] = {"ror", 3, 1, 703},
+    [153] = {"false", 5, 11, 326},
+    [155] = {"reinterpret_cast", 16, 1, 659},
+    [157] = {"endtask", 7, 1, 289},
+    [159] = {"medium", 6, 1, 502},
+    [160] = {"const", 5, 10, 145},
+    [162] = {"generate", 8, 2, 375},
+    [163] = {"uwire", 5, 1, 899},
+    [166] = {"not_eq", 6, 1, 538},
+    [168] = {"defer", 5, 2, 188},
+    [169] = {"cflags", 6, 1, 114},
+    [170] = {"string", 6, 2, 765},
+    [175] = {"get", 3, 2, 380},
+    [177] = {"int", 3, 4, 446},
+    [178] = {"func", 4, 2, 361},
+    [179] = {"__name__", 8, 1, 10},
+    [180] = {"architecture", 12, 1, 31},
+    [182] = {"defstruct", 9, 1, 196},
+    [186] = {"liblist", 7, 1, 477},
+    [188] = {"pragma", 6, 1, 595},
+    [190] = {"typeid", 6, 1, 871},
+    [195] = {"endspecify", 10, 1, 287},
+    [199] = {"sla", 3, 1, 742},
+    [200] = {"var", 3, 7, 903},
+    [203] = {"config", 6, 1, 142},
+    [206] = {"option", 6, 1, 560},
+    [208] = {"interface", 9, 7, 452},
+    [209] = {"shared_ptr", 10, 1, 725},
+    [210] = {"pure", 4, 1, 635},
+    [216] = {"deallocate", 10, 1, 179},
+    [218] = {"supply1", 7, 1, 792},
+    [219] = {"table", 5, 2, 806},
+    [220] = {"loop", 4, 4, 492},
+    [224] = {"__main__", 8, 1, 9},
+    [227] = {"tranif0", 7, 1, 833},
+    [230] = {"lazy", 4, 1, 467},
+    [237] = {"mod", 3, 4, 505},
+    [241] = {"severity", 8, 1, 723},
+    [244] = {"generic", 7, 2, 377},
+    [245] = {"impure", 6, 1, 423},
+    [246] = {"abort", 5, 1, 12},
+    [247] = {"memcpy", 6, 1, 503},
+    [248] = {"notif1", 6, 1, 540},
+    [250] = {"equivalence", 11, 1, 299},
+    [253] = {"synchronized", 12, 2, 804},
+    [255] = {"pulsestyle_ondetect", 19, 1, 633},
+    [256] = {"elif", 4, 2, 231},
+    [257] = {"cout", 4, 1, 176},
+    [260] = {"fork", 4, 1, 354},
+    [262] = {"defprotocol", 11, 1, 194},
+    [263] = {"part", 4, 1, 587},
+    [264] = {"uint", 4, 1, 875},
+    [267] = {"dynamicparam", 12, 1, 228},
+    [268] = {"tranif1", 7, 1, 834},
+    [269] = {"class", 5, 13, 123},
+    [270] = {"constexpr", 9, 1, 158},
+    [271] = {"param", 5, 1, 582},
+    [277] = {"edge", 4, 1, 230},
+    [280] = {"na", 2, 1, 519},
+    [287] = {"delay", 5, 1, 199},
+    [289] = {"signal", 6, 1, 734},
+    [290] = {"triand", 6, 1, 840},
+    [291] = {"cond", 4, 1, 141},
+    [293] = {"stdio", 5, 1, 761},
+    [294] = {"#ifndef", 7, 1, 4},
+    [295] = {"raise", 5, 3, 640},
+    [296] = {"declare", 7, 1, 183},
+    [297] = {"debugger", 8, 1, 181},
+    [303] = {"#define", 7, 2, 0},
+    [310] = {"window", 6, 1, 932},
+    [311] = {"inner", 5, 1, 437},
+    [312] = {"goto", 4, 9, 386},
+    [314] = {"parfor", 6, 1, 586},
+    [317] = {"ensure", 6, 1, 290},
+    [318] = {"elsif", 5, 4, 262},
+    [321] = {"process", 7, 2, 612},
+    [324] = {"trior", 5, 1, 841},
+    [327] = {"asm", 3, 1, 35},
+    [328] = {"subtype", 7, 2, 780},
+    [330] = {"fi", 2, 1, 337},
+    [336] = {"strong1", 7, 1, 769},
+    [338] = {"fallthrough", 11, 2, 324},
+    [339] = {"document", 8, 1, 215},
+    [341] = {"vec", 3, 1, 912},
+    [342] = {"break", 5, 17, 71},
+    [345] = {"drop", 4, 1, 225},
+    [346] = {"endfunction", 11, 1, 281},
+    [347] = {"srl", 3, 1, 750},
+    [348] = {"trait", 5, 2, 830},
+    [351] = {"unsafe", 6, 2, 888},
+    [353] = {"val", 3, 2, 900},
+    [354] = {"unsigned", 8, 2, 891},
+    [355] = {"pub", 3, 1, 624},
+    [358] = {"defparam", 8, 1, 193},
+    [359] = {"tagged", 6, 1, 808},
+    [361] = {"procedure", 9, 3, 609},
+    [363] = {"sub", 3, 1, 777},
+    [364] = {"phony", 5, 1, 590},
+    [365] = {"else", 4, 25, 233},
+    [366] = {"defmacro", 8, 1, 191},
+    [369] = {"tri0", 4, 1, 838},
+    [371] = {"destructor", 10, 1, 207},
+    [375] = {"parameter", 9, 2, 583},
+    [378] = {"alter", 5, 1, 27},
+    [380] = {"extension", 9, 1, 319},
+    [382] = {"shr", 3, 1, 733},
+    [384] = {"highz1", 6, 1, 399},
+    [386] = {"throw", 5, 9, 820},
+    [387] = {"rescue", 6, 1, 676},
+    [388] = {"undefined", 9, 1, 880},
+    [390] = {"alias", 5, 2, 23},
+    [391] = {"cmos", 4, 1, 137},
+    [392] = {"doseq", 5, 1, 217},
+    [397] = {"common", 6, 1, 138},
+    [401] = {"unless", 6, 2, 886},
+    [405] = {"qw", 2, 1, 639},
+    [408] = {"dotimes", 7, 1, 218},
+    [411] = {"exit", 4, 4, 304},
+    [414] = {"nil", 3, 3, 528},
+    [416] = {"aliased", 7, 1, 25},
+    [421] = {"pulsestyle_onevent", 18, 1, 634},
+    [422] = {"weak1", 5, 1, 931},
+    [423] = {"sealed", 6, 2, 711},
+    [424] = {"buffer", 6, 1, 91},
+    [427] = {"accept", 6, 1, 20},
+    [429] = {"ushort", 6, 1, 895},
+    [432] = {"sprintf", 7, 1, 748},
+    [436] = {"#pragma", 7, 1, 7},
+    [437] = {"parallel", 8, 1, 581},
+    [440] = {"constructor", 11, 1, 159},
+    [445] = {"deriving", 8, 1, 205},
+    [446] = {"double", 6, 4, 219},
+    [447] = {"bitor", 5, 1, 65},
+    [452] = {"except", 6, 2, 301},
+    [456] = {"create", 6, 1, 178},
+    [458] = {"global", 6, 3, 382},
+    [461] = {"subscript", 9, 1, 779},
+    [465] = {"import", 6, 10, 413},
+    [466] = {"constant", 8, 2, 156},
+    [467] = {"lock", 4, 1, 486},
+    [468] = {"values", 6, 1, 902},
+    [472] = {"pull0", 5, 1, 629},
+    [473] = {"virtual", 7, 2, 915},
+    [476] = {"begin", 5, 8, 56},
+    [477] = {"exports", 7, 1, 314},
+    [478] = {"forsome", 7, 1, 355},
+    [481] = {"nand", 4, 2, 523},
+    [485] = {"key", 3, 1, 464},
+    [486] = {"inherited", 9, 1, 431},
+    [488] = {"move", 4, 1, 515},
+    [492] = {"join", 4, 2, 462},
+    [496] = {"notif0", 6, 1, 539},
+    [497] = {"highz0", 6, 1, 398},
+    [498] = {"rtran", 5, 1, 705},
+    [505] = {"bnot", 4, 1, 66},
+    [507] = {"digits", 6, 1, 208},
+    [508] = {"coproc", 6, 1, 174},
+    [510] = {"local", 5, 4, 481},
+    [511] = {"_bool", 5, 1, 11},
+    [515] = {"warnings", 8, 1, 928},
+    [518] = {"abstract", 8, 5, 15},
+    [520] = {"ifndef", 6, 1, 403},
+    [522] = {"sll", 3, 1, 743},
+    [525] = {"namespace", 9, 2, 520},
+    [526] = {"def", 3, 4, 184},
+    [528] = {"select", 6, 5, 713},
+    [529] = {"insert", 6, 1, 441},
+    [530] = {"having", 6, 1, 397},
+    [531] = {"realtime", 8, 1, 648},
+    [534] = {"write", 5, 1, 936},
+    [537] = {"attr_reader", 11, 1, 45},
+    [538] = {"force", 5, 1, 349},
+    [540] = {"cerr", 4, 1, 113},
+    [541] = {"function", 8, 12, 363},
+    [542] = {"max", 3, 1, 501},
+    [543] = {"require", 7, 5, 671},
+    [544] = {"infixl", 6, 1, 429},
+    [546] = {"design", 6, 1, 206},
+    [548] = {"throws", 6, 1, 829},
+    [550] = {"define", 6, 1, 190},
+    [556] = {"retry", 5, 1, 679},
+    [559] = {"instance", 8, 2, 442},
+    [560] = {"size_t", 6, 1, 738},
+    [561] = {"vectored", 8, 1, 914},
+    [563] = {"internal", 8, 2, 459},
+    [564] = {"pass", 4, 1, 588},
+    [565] = {"operator", 8, 3, 557},
+    [568] = {"__init__", 8, 1, 8},
+    [571] = {"receive", 7, 1, 649},
+    [575] = {"ipairs", 6, 1, 461},
+    [577] = {"query", 5, 1, 637},
+    [579] = {"posedge", 7, 1, 593},
+    [581] = {"fn", 2, 1, 348},
+    [582] = {"signed", 6, 3, 735},
+    [584] = {"static_cast", 11, 1, 759},
+    [585] = {"reject", 6, 1, 660},
+    [587] = {"assign", 6, 1, 40},
+    [589] = {"min", 3, 1, 504},
+    [590] = {"typename", 8, 1, 872},
+    [594] = {"rol", 3, 1, 702},
+    [595] = {"guard", 5, 1, 395},
+    [596] = {"enum", 4, 7, 292},
+    [597] = {"object", 6, 5, 552},
+    [600] = {"tri1", 4, 1, 839},
+    [602] = {"rcmos", 5, 1, 643},
+    [603] = {"infix", 5, 1, 428},
+    [606] = {"ns", 2, 1, 541},
+    [611] = {"nor", 3, 2, 535},
+    [614] = {"recur", 5, 1, 650},
+    [615] = {"noshowcancelled", 15, 1, 537},
+    [618] = {"workflow", 8, 1, 935},
+    [619] = {"wor", 3, 1, 934},
+    [624] = {"puts", 4, 1, 636},
+    [626] = {"rtranif0", 8, 1, 706},
+    [628] = {"typeof", 6, 2, 873},
+    [629] = {"explicit", 8, 2, 308},
+    [630] = {"protected", 9, 5, 617},
+    [631] = {"primary", 7, 1, 596},
+    [633] = {"output", 6, 2, 566},
+    [635] = {"and_eq", 6, 1, 29},
+    [636] = {"inertial", 8, 1, 426},
+    [637] = {"printf", 6, 1, 600},
+    [639] = {"typedef", 7, 3, 868},
+    [640] = {"native", 6, 1, 525},
+    [645] = {"postponed", 9, 1, 594},
+    [646] = {"host", 4, 1, 400},
+    [647] = {"rtranif1", 8, 1, 707},
+    [653] = {"bsl", 3, 1, 88},
+    [654] = {"wire", 4, 1, 933},
+    [657] = {"std", 3, 1, 760},
+    [658] = {"limited", 7, 1, 478},
+    [659] = {"linkage", 7, 1, 479},
+    [660] = {"literal", 7, 1, 480},
+    [662] = {"count", 5, 1, 175},
+    [664] = {"access", 6, 2, 21},
+    [666] = {"echo", 4, 1, 229},
+    [667] = {"update", 6, 1, 893},
+    [669] = {"my", 2, 1, 518},
+    [671] = {"extends", 7, 4, 315},
+    [673] = {"endl", 4, 1, 284},
+    [675] = {"macro", 5, 1, 496},
+    [676] = {"save", 4, 1, 708},
+    [677] = {"unique_ptr", 10, 1, 884},
+    [679] = {"switch", 6, 10, 793},
+    [681] = {"async", 5, 3, 41},
+    [682] = {"distinct", 8, 1, 212},
+    [683] = {"fun", 3, 2, 359},
+    [684] = {"tri", 3, 1, 837},
+    [685] = {"strictfp", 8, 1, 764},
+    [686] = {"console", 7, 1, 144},
+    [688] = {"varchar", 7, 1, 910},
+    [689] = {"ifnone", 6, 1, 405},
+    [692] = {"decimal", 7, 1, 182},
+    [693] = {"bufif0", 6, 1, 92},
+    [694] = {"entity", 6, 1, 291},
+    [696] = {"endmodule", 9, 1, 285},
+    [697] = {"configuration", 13, 1, 143},
+    [700] = {"extern", 6, 4, 320},
+    [703] = {"package", 7, 7, 572},
+    [706] = {"defrecord", 9, 1, 195},
+    [707] = {"match", 5, 2, 499},
+    [710] = {"specparam", 9, 1, 746},
+    [718] = {"short", 5, 4, 728},
+    [721] = {"automatic", 9, 1, 49},
+    [724] = {"xor_eq", 6, 1, 945},
+    [726] = {"input", 5, 1, 440},
+    [727] = {"then", 4, 7, 813},
+    [730] = {"abs", 3, 2, 13},
+    [731] = {"chomp", 5, 1, 122},
+    [732] = {"override", 8, 3, 568},
+    [733] = {"implements", 10, 2, 408},
+    [734] = {"super", 5, 8, 783},
+    [735] = {"renames", 7, 1, 664},
+    [736] = {"reg", 3, 1, 655},
+    [737] = {"sbyte", 5, 1, 709},
+    [739] = {"strlen", 6, 1, 767},
+    [740] = {"classdef", 8, 1, 136},
+    [741] = {"showcancelled", 13, 1, 732},
+    [742] = {"spmd", 4, 1, 747},
+    [744] = {"vector", 6, 1, 913},
+    [745] = {"outer", 5, 1, 565},
+    [749] = {"xnor", 4, 2, 937},
+    [750] = {"boolean", 7, 1, 69},
+    [753] = {"restrict", 8, 1, 677},
+    [754] = {"stdlib", 6, 1, 762},
+    [755] = {"orelse", 6, 1, 562},
+    [756] = {"public", 6, 4, 625},
+    [758] = {"strong0", 7, 1, 768},
+    [759] = {"#endif", 6, 1, 2},
+    [760] = {"pmos", 4, 1, 591},
+    [762] = {"rem", 3, 3, 661},
+    [765] = {"bool", 4, 2, 67},
+    [772] = {"impl", 4, 1, 406},
+    [776] = {"delta", 5, 1, 204},
+    [777] = {"register", 8, 3, 656},
+    [779] = {"program", 7, 2, 614},
+    [782] = {"array", 5, 3, 32},
+    [783] = {"shift", 5, 1, 726},
+    [786] = {"casex", 5, 1, 99},
+    [787] = {"port", 4, 1, 592},
+    [791] = {"#include", 8, 2, 5},
+    [796] = {"endef", 5, 1, 280},
+    [800] = {"shl", 3, 1, 727},
+    [801] = {"readonly", 8, 2, 644},
+    [803] = {"await", 5, 3, 51},
+    [804] = {"auto", 4, 2, 47},
+    [809] = {"negedge", 7, 1, 526},
+    [810] = {"allocate", 8, 1, 26},
+    [811] = {"continue", 8, 14, 160},
+    [812] = {"localparam", 10, 1, 485},
+    [817] = {"noexcept", 8, 1, 532},
+    [819] = {"unaffected", 10, 1, 877},
+    [821] = {"newtype", 7, 1, 527},
+    [823] = {"include", 7, 1, 425},
+    [824] = {"protocol", 8, 1, 622},
+    [826] = {"avg", 3, 1, 50},
+    [831] = {"endconfig", 9, 1, 279},
+    [833] = {"pulldown", 8, 1, 631},
+    [834] = {"character", 9, 1, 120},
+    [839] = {"requeue", 7, 1, 670},
+    [849] = {"endcase", 7, 1, 278},
+    [851] = {"xor", 3, 6, 939},
+    [852] = {"elseif", 6, 4, 258},
+    [853] = {"ifdef", 5, 1, 401},
+    [856] = {"ulong", 5, 1, 876},
+    [859] = {"go", 2, 1, 385},
+    [860] = {"foreach", 7, 3, 350},
+    [861] = {"mut", 3, 1, 516},
+    [863] = {"char", 4, 4, 116},
+    [865] = {"fixed", 5, 1, 342},
+    [871] = {"print", 5, 2, 598},
+    [872] = {"stackalloc", 10, 1, 751},
+    [874] = {"implementation", 14, 1, 407},
+    [875] = {"bxor", 4, 1, 95},
+    [879] = {"checked", 7, 1, 121},
+    [880] = {"mutable", 7, 1, 517},
+    [882] = {"compl", 5, 1, 139},
+    [884] = {"init", 4, 1, 432},
+    [888] = {"defn", 4, 1, 192},
+    [889] = {"buf", 3, 1, 90},
+    [890] = {"macromodule", 11, 1, 497},
+    [892] = {"subroutine", 10, 1, 778},
+    [897] = {"free", 4, 1, 357},
+    [898] = {"attribute", 9, 1, 46},
+    [901] = {"pull1", 5, 1, 630},
+    [902] = {"integer", 7, 2, 450},
+    [905] = {"delegate", 8, 1, 200},
+    [906] = {"endgenerate", 11, 1, 282},
+    [909] = {"property", 8, 1, 616},
+    [911] = {"yield", 5, 5, 946},
+    [914] = {"delete", 6, 3, 201},
+    [915] = {"sum", 3, 1, 782},
+    [916] = {"nullptr", 7, 1, 551},
+    [918] = {"weak0", 5, 1, 930},
+    [919] = {"logical", 7, 1, 487},
+    [921] = {"template", 8, 1, 811},
+    [922] = {"strict", 6, 1, 763},
+    [924] = {"component", 9, 1, 140},
+    [925] = {"union", 5, 3, 881},
+    [927] = {"float", 5, 4, 343},
+    [930] = {"nmos", 4, 1, 531},
+    [933] = {"rnmos", 5, 1, 701},
+    [938] = {"ifneq", 5, 1, 404},
+    [940] = {"done", 4, 1, 216},
+    [941] = {"esac", 4, 1, 300},
+    [942] = {"let", 3, 7, 470},
+    [953] = {"endprimitive", 12, 1, 286},
+    [954] = {"fprintf", 7, 1, 356},
+    [955] = {"incdir", 6, 1, 424},
+    [957] = {"uses", 4, 1, 894},
+    [958] = {"implicit", 8, 3, 410},
+    [959] = {"downto", 6, 2, 223},
+    [960] = {"attr_accessor", 13, 1, 44},
+    [961] = {"bus", 3, 1, 94},
+    [962] = {"println", 7, 2, 601},
+    [964] = {"private", 7, 6, 603},
+    [967] = {"deftype", 7, 1, 197},
+    [969] = {"always", 6, 1, 28},
+    [970] = {"supply0", 7, 1, 791},
+    [975] = {"malloc", 6, 1, 498},
+    [976] = {"final", 5, 4, 338},
+    [977] = {"return", 6, 20, 680},
+    [979] = {"lambda", 6, 1, 465},
+    [980] = {"endif", 5, 1, 283},
+    [981] = {"casez", 5, 1, 100},
+    [982] = {"packed", 6, 1, 579},
+    [983] = {"instanceof", 10, 2, 444},
+    [984] = {"unchecked", 9, 1, 878},
+    [989] = {"small", 5, 1, 744},
+    [993] = {"exception", 9, 1, 303},
+    [994] = {"initial", 7, 1, 433},
+    [995] = {"long", 4, 4, 488},
+    [1003] = {"null", 4, 9, 542},
+    [1006] = {"trireg", 6, 1, 842},
+    [1017] = {"task", 4, 2, 809},
+    [1020] = {"persistent", 10, 1, 589},
+    [1023] = {"none", 4, 2, 533},
+};
+
+static const unsigned short g_sniffTokenSeeds[SNIFF_TOKEN_BUCKET_COUNT] = {
+    1, 3, 1, 4, 0, 1, 2, 0, 1, 0, 1, 2, 1, 0, 1, 2,
+    3, 2, 2, 1, 5, 2, 1, 0, 0, 2, 1, 1, 1, 1, 0, 3,
+    1, 0, 0, 0, 1, 2, 1, 3, 2, 1, 1, 2, 1, 4, 0, 1,
+    3, 1, 1, 1, 1, 4, 1, 1, 2, 4, 0, 1, 1, 2, 1, 2,
+    1, 0, 1, 2, 2, 1, 3, 2, 0, 2, 1, 0, 2, 1, 1, 0,
+    4, 1, 2, 1, 1, 3, 0, 1, 1, 3, 2, 4, 0, 3, 4, 1,
+    4, 2, 1, 1, 0, 5, 1, 5, 2, 1, 9, 2, 5, 1, 0, 1,
+    1, 1, 1, 2, 3, 4, 2, 3, 2, 1, 1, 1, 3, 1, 1, 1,
+    1, 2, 1, 1, 1, 0, 0, 1, 3, 1, 2, 1, 2, 2, 3, 1,
+    2, 1, 1, 1, 1, 2, 2, 1, 3, 1, 0, 2, 2, 3, 4, 6,
+    1, 0, 1, 1, 1, 0, 1, 3, 4, 1, 0, 1, 1, 1, 7, 3,
+    1, 2, 1, 1, 3, 1, 1, 1, 0, 2, 1, 2, 2, 1, 3, 4,
+    2, 0, 1, 1, 1, 1, 2, 2, 1, 2, 1, 2, 1, 2, 1, 4,
+    0, 1, 1, 1, 2, 0, 2, 1, 1, 1, 3, 4, 1, 1, 0, 7,
+    5, 1, 5, 0, 1, 3, 3, 1, 1, 1, 2, 0, 3, 3, 1, 2,
+    1, 1, 1, 0, 0, 2, 2, 0, 2, 2, 2, 4, 1, 5, 1, 2,
+};
+
+const SniffToken* LookupSniffToken(const char* word, size_t length) {
+    if (length == 0 || length > SNIFF_TOKEN_MAX_LENGTH) {
+        return NULL;
+    }
+    unsigned int hash = LanguageKeyHash(LANGUAGE_KEY_SNIFF_TOKEN, word, length);
+    unsigned int bucket = LanguageKeyMix(hash, 0) & (SNIFF_TOKEN_BUCKET_COUNT - 1);
+    unsigned int slot = LanguageKeyMix(hash, g_sniffTokenSeeds[bucket]) & (SNIFF_TOKEN_TABLE_SIZE - 1);
+    const SniffToken* entry = &g_sniffTokens[slot];
+    if (!entry->word || entry->length != length) {
+        return NULL;
+    }
+    for (size_t i = 0; i < length; i++) {
+        char c = word[i];
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        if (c != entry->word[i]) {
+            return NULL;
+        }
+    }
+    return entry;
+}
+
 /* LanguageType to lexer configuration mapping */
 const LexerConfig g_lexerConfigs[] = {
     {LANG_ADA, "ada", "abort abs abstract accept access aliased all and array at begin body case constant declare delay delta digits do else elsif end entry exception exit for function generic goto if in interface is limited loop mod new not null of or others out overriding package pragma private procedure protected raise range record rem renames requeue return reverse select separate some subtype synchronized tagged task terminate then type until use when while with xor", NULL},
@@ -86,10 +86,32 @@ typedef enum {
 
 
 /* External declarations for generated data structures */
+typedef enum {
+    LANGUAGE_KEY_EXTENSION,   /* Extension with its dot, e.g. ".py" */
+    LANGUAGE_KEY_FILENAME,    /* Whole file name, e.g. "Makefile" */
+    LANGUAGE_KEY_INTERPRETER, /* Program named by a shebang line, e.g. "python3" */
+    LANGUAGE_KEY_ALIAS,       /* Language name or alias used in modelines, e.g. "sh" */
+    LANGUAGE_KEY_SNIFF_TOKEN  /* Keyword counted by content sniffing - see LookupSniffToken */
+} LanguageKeyKind;
+
 typedef struct {
-    const char* extension;
-    LanguageType language;
-} ExtensionMapping;
+    const char* key;          /* Lowercase, NULL for an empty slot */
+    unsigned char length;
+    unsigned char kind;       /* LanguageKeyKind */
+    unsigned short language;  /* LanguageType */
+} LanguageKey;
+
+typedef struct {
+    const char* word;         /* Lowercase, NULL for an empty slot */
+    unsigned char length;
+    unsigned char scoreCount; /* Languages the word scores for */
+    unsigned short firstScore; /* Index of the first in g_sniffScores */
+} SniffToken;
+
+typedef struct {
+    unsigned short language;  /* LanguageType */
+    unsigned short weight;
+} SniffScore;
 
 typedef struct {
     LanguageType language;
@@ -98,16 +120,33 @@ typedef struct {
     const char* keywords2;
 } LexerConfig;
 
-extern const ExtensionMapping g_extensionMappings[];
+extern const LanguageKey g_languageKeys[];
+extern const SniffToken g_sniffTokens[];
+extern const SniffScore g_sniffScores[];
 extern const LexerConfig g_lexerConfigs[];
 extern const char* g_fileFilters;
 
 /* Array size constants */
-#define EXTENSION_MAPPING_COUNT 450
+#define LANGUAGE_KEY_COUNT 806
+#define LANGUAGE_KEY_TABLE_SIZE 2048
+#define LANGUAGE_KEY_BUCKET_COUNT 512
+#define LANGUAGE_KEY_MAX_LENGTH 20
+#define SNIFF_TOKEN_COUNT 482
+#define SNIFF_TOKEN_TABLE_SIZE 1024
+#define SNIFF_TOKEN_BUCKET_COUNT 256
+#define SNIFF_TOKEN_MAX_LENGTH 19
+#define SNIFF_SCORE_COUNT 951
 #define LEXER_CONFIG_COUNT 66
 
 /* Function declarations for generated code */
 const char* GetLanguageName(LanguageType language);
 const char* GetLanguageShortName(LanguageType language);
 
+/* Language of an extension, file name or interpreter in O(1), ignoring ASCII case.
+ * Returns LANG_NONE when the key is not known. */
+LanguageType LookupLanguageKey(LanguageKeyKind kind, const char* key, size_t length);
+
+/* Sniffing statistics of a word, ignoring ASCII case. Returns NULL for a word that isn't scored. */
+const SniffToken* LookupSniffToken(const char* word, size_t length);
+
 #endif /* LEXER_MAPPINGS_GENERATED_H */
@@ -66,14 +66,21 @@ FILE* g_profileFile = NULL;
 #include "gotoline.h"
 #include "preferences.h"
 #include "shellintegrate.h"
+#include "autosave.h"
+#include "wordindex.h"
+#include "occurrences.h"
+#include "findresults.h"
+#include "findinfiles.h"
+#include "largefile.h"
 #include <dwmapi.h>
 #include <uxtheme.h>
 
-/* Indicator for word highlighting */
-#define INDICATOR_WORD_HIGHLIGHT 8
-
 /* Auto-save timer ID */
 #define IDT_AUTOSAVE_TIMER 2001
+#define IDT_SESSION_AUTOSAVE_TIMER 2002
+#define IDT_WORDINDEX_TIMER 2003
+#define IDT_OCCURRENCES_TIMER 2004
+#define IDT_FINDRESULTS_TIMER 2005
 
 /* Application instance handle */
 HINSTANCE g_hInstance = NULL;
@@ -217,6 +224,9 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     
     PROFILE_MARK("StatusBar init");
     
+    /* Find All results panel - without it Find All still counts the matches */
+    InitializeFindResultsPanel(g_hMainWindow);
+    
     /* Initialize split view */
     if (!InitializeSplitView(g_hMainWindow)) {
         MessageBox(NULL, "Failed to initialize split view", "Error", MB_ICONERROR | MB_OK);
@@ -229,6 +239,9 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     
     PROFILE_MARK("SplitView init");
     
+    /* Autosave writes on its own thread - without it autosave still works, just on this one */
+    InitializeAutosave(g_hMainWindow);
+    
     /* Apply theme to editors BEFORE restoring session */
     ApplyThemeToAllEditors();
     
@@ -248,6 +261,11 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     
     /* Main message loop */
     while (GetMessage(&msg, NULL, 0, 0)) {
+        /* Escape stops a search of a large file before a dialog takes it to close itself */
+        if (msg.message == WM_KEYDOWN && msg.wParam == VK_ESCAPE && CancelLargeFileSearch()) {
+            continue;
+        }
+
         /* Handle find/replace modeless dialogs */
         FindReplaceState* frState = GetFindReplaceState();
         if (frState->hwndFind && IsWindow(frState->hwndFind) && IsDialogMessage(frState->hwndFind, &msg)) {
@@ -256,6 +274,14 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         if (frState->hwndReplace && IsWindow(frState->hwndReplace) && IsDialogMessage(frState->hwndReplace, &msg)) {
             continue;
         }
+        if (frState->hwndFindInFiles && IsWindow(frState->hwndFindInFiles) && IsDialogMessage(frState->hwndFindInFiles, &msg)) {
+            continue;
+        }
+
+        /* Ctrl+Home and Ctrl+End go to the ends of a large file, not of the page shown */
+        if (msg.message == WM_KEYDOWN && LargeFileKeyDown(msg.hwnd, msg.wParam)) {
+            continue;
+        }
 
         /* Handle keyboard shortcuts */
         if (!TranslateAccelerator(g_hMainWindow, g_hAccel, &msg)) {
@@ -265,12 +291,14 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     }
     
     /* Cleanup */
+    CleanupAutosave();
     CleanupSession();
     CleanupConfig();
     CleanupFindReplace();
     CleanupSyntax();
     CleanupTheme();
     CleanupSplitView();
+    CleanupFindResultsPanel();
     CleanupStatusBar();
     CleanupToolbar();
     CleanupTabs();
@@ -279,39 +307,6 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     return (int)msg.wParam;
 }
 
-/* Helper function to highlight all occurrences of a word */
-static void HighlightWordOccurrences(HWND editor, const char* word, int wordLen)
-{
-    if (!editor || !word || wordLen <= 0) return;
-    
-    /* Clear previous highlights */
-    SendMessage(editor, SCI_SETINDICATORCURRENT, INDICATOR_WORD_HIGHLIGHT, 0);
-    int docLen = (int)SendMessage(editor, SCI_GETLENGTH, 0, 0);
-    SendMessage(editor, SCI_INDICATORCLEARRANGE, 0, docLen);
-    
-    /* Set indicator style */
-    SendMessage(editor, SCI_INDICSETSTYLE, INDICATOR_WORD_HIGHLIGHT, INDIC_ROUNDBOX);
-    SendMessage(editor, SCI_INDICSETFORE, INDICATOR_WORD_HIGHLIGHT, RGB(255, 255, 0));
-    SendMessage(editor, SCI_INDICSETALPHA, INDICATOR_WORD_HIGHLIGHT, 100);
-    SendMessage(editor, SCI_INDICSETOUTLINEALPHA, INDICATOR_WORD_HIGHLIGHT, 200);
-    SendMessage(editor, SCI_INDICSETUNDER, INDICATOR_WORD_HIGHLIGHT, TRUE);
-    
-    /* Search for all occurrences */
-    SendMessage(editor, SCI_SETTARGETSTART, 0, 0);
-    SendMessage(editor, SCI_SETTARGETEND, docLen, 0);
-    SendMessage(editor, SCI_SETSEARCHFLAGS, SCFIND_WHOLEWORD, 0);
-    
-    int pos;
-    while ((pos = (int)SendMessage(editor, SCI_SEARCHINTARGET, wordLen, (LPARAM)word)) >= 0) {
-        /* Highlight this occurrence */
-        SendMessage(editor, SCI_INDICATORFILLRANGE, pos, wordLen);
-        
-        /* Move target to search for next occurrence */
-        SendMessage(editor, SCI_SETTARGETSTART, pos + wordLen, 0);
-        SendMessage(editor, SCI_SETTARGETEND, docLen, 0);
-    }
-}
-
 /*
  * Main window procedure
  */
@@ -397,6 +392,49 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                 DragFinish(hDrop);
                 return 0;
             }
+        case WM_FILELOAD_PROGRESS:
+            /* Posted by background file loads as each percent of the file is read */
+            UpdateTabLoadProgress((FileLoadJob*)lParam);
+            return 0;
+            
+        case WM_AUTOSAVE_FAILED:
+            AutosaveFailed((char*)lParam);
+            return 0;
+            
+        case WM_FILELOAD_DONE:
+            /* Background file load finished, failed or was cancelled */
+            CompleteTabLoad((FileLoadJob*)lParam);
+            return 0;
+            
+        case WM_FINDINFILES_RESULTS:
+            /* Find in Files has matching lines to add to its results */
+            FindInFilesResultsReady(wParam, lParam);
+            return 0;
+            
+        case WM_FINDINFILES_DONE:
+            FindInFilesDone(wParam, lParam);
+            return 0;
+            
+        case WM_FINDRESULTS_DONE:
+            /* Find All has searched the whole document */
+            FindResultsSearchDone(lParam);
+            return 0;
+            
+        case WM_LARGEFILE_INDEX:
+            /* Indexing a large file's lines has got further or ended */
+            LargeFileIndexed((LargeFile*)lParam);
+            return 0;
+            
+        case WM_LARGEFILE_PAGE:
+            /* The view of a large file is near an end of the page shown */
+            LargeFileMovePage((LargeFile*)lParam);
+            return 0;
+            
+        case WM_LARGEFILE_SEARCH:
+            /* A search of a large file has got further or ended */
+            LargeFileSearched(lParam);
+            return 0;
+            
         case WM_DESTROY:
             /* Handle window destruction */
             DragAcceptFiles(hWnd, FALSE);
@@ -411,16 +449,49 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                 if (nmhdr->code == SCN_MODIFIED) {
                     SCNotification* scn = (SCNotification*)lParam;
                     
-                    /* Check if content was modified */
-                    if (scn->modificationType & (SC_MOD_INSERTTEXT | SC_MOD_DELETETEXT)) {
+                    /* Check if content was modified, or is about to be */
+                    if (scn->modificationType & (SC_MOD_INSERTTEXT | SC_MOD_DELETETEXT |
+                                                 SC_MOD_BEFOREINSERT | SC_MOD_BEFOREDELETE)) {
+                        BOOL changed = (scn->modificationType & (SC_MOD_INSERTTEXT | SC_MOD_DELETETEXT)) != 0;
                         /* Find which tab owns this editor */
                         int tabCount = GetTabCount();
                         for (int i = 0; i < tabCount; i++) {
                             TabInfo* tab = GetTab(i);
                             if (tab && tab->editorHandle == nmhdr->hwndFrom) {
-                                SetTabModified(i, TRUE);
-                                /* Update Save button state */
-                                EnableToolbarButton(ID_FILE_SAVE, TRUE);
+                                /* Keep the word completion index in step, or drop it once completion is off */
+                                if (tab->wordIndex) {
+                                    if (IsWordAutocompleteEnabled()) {
+                                        WordIndexNoteModification(tab->wordIndex, tab->editorHandle, scn->modificationType,
+                                                                  scn->position, scn->length);
+                                        if (!WordIndexIsComplete(tab->wordIndex)) {
+                                            SetTimer(hWnd, IDT_WORDINDEX_TIMER, WORDINDEX_SCAN_INTERVAL, NULL);
+                                        }
+                                    } else {
+                                        FreeWordIndex(tab->wordIndex);
+                                        tab->wordIndex = NULL;
+                                    }
+                                }
+                                /* Highlights move with the text, the lines changed are searched again */
+                                if (tab->occurrences && changed) {
+                                    OccurrenceHighlightNoteModification(tab->occurrences, tab->editorHandle,
+                                                                        scn->modificationType, scn->position, scn->length);
+                                    if (!OccurrenceHighlightIsComplete(tab->occurrences)) {
+                                        SetTimer(hWnd, IDT_OCCURRENCES_TIMER, OCCURRENCES_SCAN_INTERVAL, NULL);
+                                    }
+                                }
+                                /* Find All matches move with the text, the lines changed are searched again */
+                                if (tab->findResults && changed) {
+                                    FindResultsNoteModification(tab->findResults, tab->editorHandle,
+                                                                scn->modificationType, scn->position, scn->length);
+                                    SetTimer(hWnd, IDT_FINDRESULTS_TIMER, FINDRESULTS_REFRESH_INTERVAL, NULL);
+                                }
+                                if (changed) {
+                                    SetTabModified(i, TRUE);
+                                    /* Captured by the next autosave */
+                                    AutosaveNoteEdit(tab, scn->modificationType, scn->position, scn->length);
+                                    /* Update Save button state */
+                                    EnableToolbarButton(ID_FILE_SAVE, TRUE);
+                                }
                                 break;
                             }
                         }
@@ -448,9 +519,11 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                         }
                     }
                 } else if (nmhdr->code == SCN_DOUBLECLICK) {
-                    /* Double-click - highlight all occurrences of word under cursor */
+                    /* Double-click on a Find in Files result opens it, anywhere else
+                     * highlights all occurrences of the word under the cursor */
+                    SCNotification* scn = (SCNotification*)lParam;
                     AppConfig* cfg = GetConfig();
-                    if (cfg && cfg->highlightMatchingWords) {
+                    if (!OpenFindInFilesResult(nmhdr->hwndFrom, scn->line) && cfg && cfg->highlightMatchingWords) {
                         HWND editor = nmhdr->hwndFrom;
                         
                         /* Get word at cursor position */
@@ -467,7 +540,20 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                             tr.lpstrText = word;
                             SendMessage(editor, SCI_GETTEXTRANGE, 0, (LPARAM)&tr);
                             
-                            HighlightWordOccurrences(editor, word, wordLen);
+                            /* The lines on screen are highlighted now, the rest from a timer */
+                            int tabCount = GetTabCount();
+                            for (int i = 0; i < tabCount; i++) {
+                                TabInfo* tab = GetTab(i);
+                                if (tab && (tab->editorHandle == editor || tab->secondaryEditorHandle == editor)) {
+                                    if (!tab->occurrences) {
+                                        tab->occurrences = CreateOccurrenceHighlight();
+                                    }
+                                    if (tab->occurrences && !HighlightOccurrences(tab->occurrences, editor, word, wordLen)) {
+                                        SetTimer(hWnd, IDT_OCCURRENCES_TIMER, OCCURRENCES_SCAN_INTERVAL, NULL);
+                                    }
+                                    break;
+                                }
+                            }
                         }
                     }
                 } else if (nmhdr->code == SCN_CHARADDED) {
@@ -478,6 +564,14 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                         for (int i = 0; i < tabCount; i++) {
                             TabInfo* tab = GetTab(i);
                             if (tab && tab->editorHandle == nmhdr->hwndFrom) {
+                                /* The document's words are indexed from the first completion on */
+                                if (!tab->wordIndex) {
+                                    tab->wordIndex = CreateWordIndex();
+                                    if (tab->wordIndex && !WordIndexScan(tab->wordIndex, tab->editorHandle)) {
+                                        SetTimer(hWnd, IDT_WORDINDEX_TIMER, WORDINDEX_SCAN_INTERVAL, NULL);
+                                    }
+                                }
+                                
                                 /* Trigger autocomplete through direct Scintilla API */
                                 SciFnDirect sciFn = (SciFnDirect)SendMessage(tab->editorHandle, SCI_GETDIRECTFUNCTION, 0, 0);
                                 sptr_t sciPtr = SendMessage(tab->editorHandle, SCI_GETDIRECTPOINTER, 0, 0);
@@ -490,7 +584,7 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                                     
                                     /* Trigger if we've typed at least 2 characters */
                                     if (charsTyped >= 2) {
-                                        TriggerWordAutocompleteForEditor(tab->editorHandle);
+                                        TriggerWordAutocompleteForEditor(tab->editorHandle, tab->wordIndex);
                                     }
                                 }
                                 break;
@@ -506,9 +600,21 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                     int col = pos - lineStart;
                     int zoomLevel = (int)SendMessage(editor, SCI_GETZOOM, 0, 0);
                     
-                    UpdateCursorPosition(line, col);
-                    UpdateFilePosition(pos);
+                    /* A large file shows positions in the file, and moves its page with the view */
+                    LargeFile* largeFile = GetLargeFileForEditor(editor);
+                    if (largeFile) {
+                        UpdateLargeFileStatus(largeFile);
+                        LargeFileUpdateView(largeFile);
+                    } else {
+                        UpdateCursorPosition(line, col);
+                        UpdateFilePosition(pos);
+                    }
                     UpdateZoomLevel(zoomLevel);
+                    UpdateUndoMemory((size_t)SendMessage(editor, SCI_GETUNDOMEMORY, 0, 0),
+                                     (BOOL)SendMessage(editor, SCI_GETUNDOSPILLFAILED, 0, 0));
+                } else if (nmhdr->code == SCN_PAINTED) {
+                    /* Editor painted - used by file load profiling for time to first paint */
+                    ReportFileLoadPainted(nmhdr->hwndFrom);
                 }
             }
             return 0;
@@ -625,6 +731,13 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                     }
                     break;
                     
+                case ID_FILE_CANCELLOAD:
+                    /* Sent by the status bar progress pane, which shows a load or else a search */
+                    if (!CancelTabLoad(GetSelectedTab())) {
+                        CancelLargeFileSearch();
+                    }
+                    break;
+                    
                 case ID_FILE_RECENTFILES:
                     /* Handled by recent file IDs */
                     break;
@@ -821,6 +934,10 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                     ShowReplaceDialog(hWnd);
                     break;
                     
+                case ID_EDIT_FINDINFILES:
+                    ShowFindInFilesDialog(hWnd);
+                    break;
+                    
                 /* Common line operations */
                 case ID_EDIT_DUPLICATE_LINE:
                     {
@@ -1554,6 +1671,8 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                             if (tab && tab->editorHandle) {
                                 tab->changeHistoryEnabled = !tab->changeHistoryEnabled;
                                 EnableChangeHistory(tab->editorHandle, tab->changeHistoryEnabled);
+                                /* The undo history was emptied - autosave needs a new checkpoint */
+                                tab->autosaveBase = FALSE;
                                 SetToolbarButtonToggled(ID_VIEW_CHANGEHISTORY, tab->changeHistoryEnabled);
                             }
                         }
@@ -1819,6 +1938,46 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                         }
                     }
                 }
+            } else if (wParam == IDT_SESSION_AUTOSAVE_TIMER) {
+                /* Keep unsaved edits on disk in case the session doesn't end normally */
+                UpdateSessionJournal();
+            } else if (wParam == IDT_WORDINDEX_TIMER) {
+                /* Index the next part of documents whose words aren't all indexed yet */
+                BOOL pending = FALSE;
+                int tabCount = GetTabCount();
+                for (int i = 0; i < tabCount; i++) {
+                    TabInfo* tab = GetTab(i);
+                    if (tab && tab->wordIndex && !WordIndexScan(tab->wordIndex, tab->editorHandle)) {
+                        pending = TRUE;
+                    }
+                }
+                if (!pending) {
+                    KillTimer(hWnd, IDT_WORDINDEX_TIMER);
+                }
+            } else if (wParam == IDT_OCCURRENCES_TIMER) {
+                /* Highlight the next part of documents with occurrences still to find */
+                BOOL pending = FALSE;
+                int tabCount = GetTabCount();
+                for (int i = 0; i < tabCount; i++) {
+                    TabInfo* tab = GetTab(i);
+                    if (tab && tab->occurrences && !OccurrenceHighlightScan(tab->occurrences, tab->editorHandle)) {
+                        pending = TRUE;
+                    }
+                }
+                if (!pending) {
+                    KillTimer(hWnd, IDT_OCCURRENCES_TIMER);
+                }
+            } else if (wParam == IDT_FINDRESULTS_TIMER) {
+                /* Edits have paused - search the lines they changed for Find All matches */
+                KillTimer(hWnd, IDT_FINDRESULTS_TIMER);
+                int tabCount = GetTabCount();
+                for (int i = 0; i < tabCount; i++) {
+                    TabInfo* tab = GetTab(i);
+                    if (tab && tab->findResults) {
+                        FindResultsRefresh(tab->findResults, tab->editorHandle);
+                    }
+                }
+                UpdateFindResultsPanel();
             }
             return 0;
             
@@ -1827,8 +1986,17 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                 /* Save session before closing (this includes unsaved documents as temp files) */
                 SaveSession();
                 
-                /* Kill auto-save timer */
+                /* Stop background loads and searches before the window they post to goes away */
+                FinishAllTabLoads();
+                FinishAllFindResults();
+                FinishLargeFileSearch();
+                
+                /* Kill auto-save timers */
                 KillTimer(hWnd, IDT_AUTOSAVE_TIMER);
+                KillTimer(hWnd, IDT_SESSION_AUTOSAVE_TIMER);
+                KillTimer(hWnd, IDT_WORDINDEX_TIMER);
+                KillTimer(hWnd, IDT_OCCURRENCES_TIMER);
+                KillTimer(hWnd, IDT_FINDRESULTS_TIMER);
                 
                 /* Proceed with window destruction - no save prompt */
                 DestroyWindow(hWnd);
@@ -1879,6 +2047,11 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                     SetTimer(hWnd, IDT_AUTOSAVE_TIMER, cfg->autoSaveInterval * 1000, NULL);
                 }
                 
+                /* Capture unsaved edits for the session as they are made */
+                if (cfg && cfg->restoreSession) {
+                    SetTimer(hWnd, IDT_SESSION_AUTOSAVE_TIMER, AUTOSAVE_INTERVAL, NULL);
+                }
+                
                 PROFILE_MARK("Startup complete (total)");
                 PROFILE_CLOSE();
             }
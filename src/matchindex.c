@@ -0,0 +1,228 @@
+/*
+ * Match index implementation for Notepad+
+ *
+ * Find All can turn up millions of matches, and the results panel has to go straight
+ * to any one of them. Holding a start and end for each match takes 16 bytes a match
+ * on 64-bit builds, so instead matches are kept in blocks of MATCHINDEX_BLOCK_SIZE:
+ * the first position of a block is stored in full and every match as its 32-bit
+ * distance from it. That is a little over 4 bytes a match, and match n is still found
+ * with two array reads. Match lengths aren't kept at all - the results panel finds a
+ * match again from its start when it needs the end.
+ *
+ * An edit that moves text by delta adds delta to the first position of each block
+ * after the edit and rewrites only the block or blocks the edit falls in. When an edit
+ * adds or removes matches the numbers of all later matches change, so the index from
+ * the edit on is rebuilt - still a single pass, and only needed when the number of
+ * matches changes.
+ */
+
+#include <windows.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "matchindex.h"
+
+struct MatchIndex {
+    INT_PTR* bases;                   /* Position of the first match of each block */
+    unsigned int* offsets;            /* Each match's distance from the first match of its block */
+    size_t count;
+    size_t capacity;                  /* Matches there is room for, a whole number of blocks */
+};
+
+MatchIndex* CreateMatchIndex(void)
+{
+    return (MatchIndex*)calloc(1, sizeof(MatchIndex));
+}
+
+void FreeMatchIndex(MatchIndex* index)
+{
+    if (index) {
+        free(index->bases);
+        free(index->offsets);
+        free(index);
+    }
+}
+
+void MatchIndexClear(MatchIndex* index)
+{
+    free(index->bases);
+    free(index->offsets);
+    memset(index, 0, sizeof(MatchIndex));
+}
+
+/* Make room for at least capacity matches */
+static BOOL Reserve(MatchIndex* index, size_t capacity)
+{
+    capacity = (capacity + MATCHINDEX_BLOCK_SIZE - 1) & ~(size_t)(MATCHINDEX_BLOCK_SIZE - 1);
+    if (capacity <= index->capacity) {
+        return TRUE;
+    }
+    unsigned int* offsets = (unsigned int*)realloc(index->offsets, capacity * sizeof(unsigned int));
+    if (!offsets) {
+        return FALSE;
+    }
+    index->offsets = offsets;
+    INT_PTR* bases = (INT_PTR*)realloc(index->bases, (capacity >> MATCHINDEX_BLOCK_SHIFT) * sizeof(INT_PTR));
+    if (!bases) {
+        return FALSE;
+    }
+    index->bases = bases;
+    index->capacity = capacity;
+    return TRUE;
+}
+
+/* Distance of position from base, FALSE when it doesn't fit an offset */
+static BOOL Offset(INT_PTR base, INT_PTR position, unsigned int* offset)
+{
+    INT_PTR distance = position - base;
+    if (distance < 0 || (unsigned long long)distance > UINT_MAX) {
+        return FALSE;
+    }
+    *offset = (unsigned int)distance;
+    return TRUE;
+}
+
+BOOL MatchIndexAppend(MatchIndex* index, INT_PTR position)
+{
+    if (index->count == index->capacity &&
+        !Reserve(index, index->capacity ? index->capacity * 2 : 16 * MATCHINDEX_BLOCK_SIZE)) {
+        return FALSE;
+    }
+    size_t block = index->count >> MATCHINDEX_BLOCK_SHIFT;
+    if ((index->count & (MATCHINDEX_BLOCK_SIZE - 1)) == 0) {
+        index->bases[block] = position;
+        index->offsets[index->count] = 0;
+    } else if (!Offset(index->bases[block], position, &index->offsets[index->count])) {
+        return FALSE;
+    }
+    index->count++;
+    return TRUE;
+}
+
+size_t MatchIndexCount(const MatchIndex* index)
+{
+    return index ? index->count : 0;
+}
+
+INT_PTR MatchIndexAt(const MatchIndex* index, size_t n)
+{
+    return index->bases[n >> MATCHINDEX_BLOCK_SHIFT] + (INT_PTR)index->offsets[n];
+}
+
+size_t MatchIndexLowerBound(const MatchIndex* index, INT_PTR position)
+{
+    if (index->count == 0 || index->bases[0] >= position) {
+        return 0;
+    }
+
+    /* The last block that starts before position... */
+    size_t low = 0;
+    size_t high = (index->count + MATCHINDEX_BLOCK_SIZE - 1) >> MATCHINDEX_BLOCK_SHIFT;
+    while (high - low > 1) {
+        size_t middle = low + (high - low) / 2;
+        if (index->bases[middle] < position) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    /* ...then the first of its matches at or after position, or the next block's first */
+    INT_PTR base = index->bases[low];
+    size_t first = (low << MATCHINDEX_BLOCK_SHIFT) + 1;
+    size_t last = (low + 1) << MATCHINDEX_BLOCK_SHIFT;
+    if (last > index->count) {
+        last = index->count;
+    }
+    while (first < last) {
+        size_t middle = first + (last - first) / 2;
+        if (base + (INT_PTR)index->offsets[middle] < position) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+/* Splice without a change in the number of matches: the blocks from the first match
+ * replaced up to the one holding the first match moved are rewritten in place */
+static BOOL Rewrite(MatchIndex* index, size_t first, size_t last, INT_PTR delta, const INT_PTR* positions)
+{
+    if (first == index->count) {
+        return TRUE;
+    }
+    size_t blockCount = (index->count + MATCHINDEX_BLOCK_SIZE - 1) >> MATCHINDEX_BLOCK_SHIFT;
+    size_t firstBlock = first >> MATCHINDEX_BLOCK_SHIFT;
+    size_t lastBlock = (last < index->count ? last : index->count - 1) >> MATCHINDEX_BLOCK_SHIFT;
+    INT_PTR block[MATCHINDEX_BLOCK_SIZE];
+
+    for (size_t b = firstBlock; b <= lastBlock; b++) {
+        size_t begin = b << MATCHINDEX_BLOCK_SHIFT;
+        size_t end = begin + MATCHINDEX_BLOCK_SIZE < index->count ? begin + MATCHINDEX_BLOCK_SIZE : index->count;
+        for (size_t i = begin; i < end; i++) {
+            if (i < first) {
+                block[i - begin] = MatchIndexAt(index, i);
+            } else if (i < last) {
+                block[i - begin] = positions[i - first];
+            } else {
+                block[i - begin] = MatchIndexAt(index, i) + delta;
+            }
+        }
+        index->bases[b] = block[0];
+        for (size_t i = begin; i < end; i++) {
+            if (!Offset(block[0], block[i - begin], &index->offsets[i])) {
+                MatchIndexClear(index);
+                return FALSE;
+            }
+        }
+    }
+
+    for (size_t b = lastBlock + 1; b < blockCount; b++) {
+        index->bases[b] += delta;
+    }
+    return TRUE;
+}
+
+/* Splice that adds or removes matches: the blocks before the first match replaced are
+ * copied as they are and the rest appended again one match at a time */
+static BOOL Rebuild(MatchIndex* index, size_t first, size_t last, INT_PTR delta,
+                    const INT_PTR* positions, size_t count)
+{
+    MatchIndex rebuilt = {0};
+    size_t kept = (first >> MATCHINDEX_BLOCK_SHIFT) << MATCHINDEX_BLOCK_SHIFT;
+    BOOL ok = Reserve(&rebuilt, index->count - (last - first) + count);
+    if (ok && kept > 0) {
+        memcpy(rebuilt.offsets, index->offsets, kept * sizeof(unsigned int));
+        memcpy(rebuilt.bases, index->bases, (kept >> MATCHINDEX_BLOCK_SHIFT) * sizeof(INT_PTR));
+        rebuilt.count = kept;
+    }
+    for (size_t i = kept; ok && i < first; i++) {
+        ok = MatchIndexAppend(&rebuilt, MatchIndexAt(index, i));
+    }
+    for (size_t i = 0; ok && i < count; i++) {
+        ok = MatchIndexAppend(&rebuilt, positions[i]);
+    }
+    for (size_t i = last; ok && i < index->count; i++) {
+        ok = MatchIndexAppend(&rebuilt, MatchIndexAt(index, i) + delta);
+    }
+
+    MatchIndexClear(index);
+    if (!ok) {
+        MatchIndexClear(&rebuilt);
+        return FALSE;
+    }
+    *index = rebuilt;
+    return TRUE;
+}
+
+BOOL MatchIndexSplice(MatchIndex* index, INT_PTR start, INT_PTR end, INT_PTR delta,
+                      const INT_PTR* positions, size_t count)
+{
+    size_t first = MatchIndexLowerBound(index, start);
+    size_t last = MatchIndexLowerBound(index, end);
+    if (last - first == count) {
+        return Rewrite(index, first, last, delta, positions);
+    }
+    return Rebuild(index, first, last, delta, positions, count);
+}
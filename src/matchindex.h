@@ -0,0 +1,42 @@
+/*
+ * Match index header for Notepad+
+ * Compact sorted list of match positions with constant time access by match number
+ */
+
+#ifndef MATCHINDEX_H
+#define MATCHINDEX_H
+
+#include <windows.h>
+
+/* Matches per block - each block stores its first position in full and the rest as
+ * 32-bit distances from it */
+#define MATCHINDEX_BLOCK_SHIFT      6
+#define MATCHINDEX_BLOCK_SIZE       (1 << MATCHINDEX_BLOCK_SHIFT)
+
+typedef struct MatchIndex MatchIndex;
+
+/* Index creation - a new index is empty */
+MatchIndex* CreateMatchIndex(void);
+void FreeMatchIndex(MatchIndex* index);
+void MatchIndexClear(MatchIndex* index);
+
+/* Add a match after the last one, position must not be before it. Returns FALSE when out
+ * of memory or when the position is 4 GB or more past the first match of its block. */
+BOOL MatchIndexAppend(MatchIndex* index, INT_PTR position);
+
+/* Number of matches and the position of match n, which must be less than the count */
+size_t MatchIndexCount(const MatchIndex* index);
+INT_PTR MatchIndexAt(const MatchIndex* index, size_t n);
+
+/* Number of the first match at or after position, the count when there is none */
+size_t MatchIndexLowerBound(const MatchIndex* index, INT_PTR position);
+
+/* Follow an edit of the text the matches were found in: the matches from start up to end
+ * are removed, the ones from end on move by delta and positions, sorted and already moved,
+ * take the place of the removed ones. Only the blocks from the first removed match on are
+ * rewritten when the count stays the same, otherwise the rest of the index is rebuilt.
+ * Returns FALSE when that fails as MatchIndexAppend can, leaving the index empty. */
+BOOL MatchIndexSplice(MatchIndex* index, INT_PTR start, INT_PTR end, INT_PTR delta,
+                      const INT_PTR* positions, size_t count);
+
+#endif /* MATCHINDEX_H */
@@ -0,0 +1,343 @@
+/*
+ * Occurrence highlighting implementation for Notepad+
+ *
+ * Highlighting a word used to clear and search the whole document at once, which for a
+ * common identifier in a large file held up the UI. Instead the lines on screen are
+ * searched straight away and the rest of the document is searched in chunks from a timer.
+ *
+ * The highlights themselves are kept by Scintilla as indicator runs, which move with the
+ * text as it is edited. So after an edit only the lines the edit touched have to be
+ * searched again. The parts of the document still to search are kept as a sorted list
+ * of separate ranges that is adjusted for each edit in the same way.
+ */
+
+#include <windows.h>
+#include <stdlib.h>
+#include <string.h>
+#include "occurrences.h"
+#include "Scintilla.h"
+
+/* Indicator for word highlighting */
+#define INDICATOR_WORD_HIGHLIGHT 8
+
+/* Occurrences fetched per SCI_FINDALL call */
+#define OCCURRENCES_RANGES_CHUNK 4096
+
+typedef struct {
+    INT_PTR start;
+    INT_PTR end;
+} PendingRange;
+
+struct OccurrenceHighlight {
+    char word[OCCURRENCES_MAX_WORD];
+    int wordLength;                   /* 0 when nothing is highlighted */
+    void* document;                   /* Scintilla document the highlights belong to */
+    INT_PTR documentLength;           /* Its length as of the last change seen */
+    PendingRange* pending;            /* Ranges still to search, sorted and separate */
+    size_t pendingCount;
+    size_t pendingCapacity;
+};
+
+OccurrenceHighlight* CreateOccurrenceHighlight(void)
+{
+    return (OccurrenceHighlight*)calloc(1, sizeof(OccurrenceHighlight));
+}
+
+void FreeOccurrenceHighlight(OccurrenceHighlight* highlight)
+{
+    if (highlight) {
+        free(highlight->pending);
+        free(highlight);
+    }
+}
+
+/* Add start..end to the ranges still to search, joining it with any it overlaps or meets */
+static BOOL AddPending(OccurrenceHighlight* highlight, INT_PTR start, INT_PTR end)
+{
+    if (end <= start) {
+        return TRUE;
+    }
+    size_t first = 0;
+    while (first < highlight->pendingCount && highlight->pending[first].end < start) {
+        first++;
+    }
+    size_t last = first;
+    while (last < highlight->pendingCount && highlight->pending[last].start <= end) {
+        if (highlight->pending[last].start < start) {
+            start = highlight->pending[last].start;
+        }
+        if (highlight->pending[last].end > end) {
+            end = highlight->pending[last].end;
+        }
+        last++;
+    }
+    if (first == last) {
+        if (highlight->pendingCount == highlight->pendingCapacity) {
+            size_t capacity = highlight->pendingCapacity ? highlight->pendingCapacity * 2 : 16;
+            PendingRange* grown = (PendingRange*)realloc(highlight->pending, capacity * sizeof(PendingRange));
+            if (!grown) {
+                return FALSE;
+            }
+            highlight->pending = grown;
+            highlight->pendingCapacity = capacity;
+        }
+        memmove(&highlight->pending[first + 1], &highlight->pending[first],
+                (highlight->pendingCount - first) * sizeof(PendingRange));
+        highlight->pendingCount++;
+    } else if (last - first > 1) {
+        memmove(&highlight->pending[first + 1], &highlight->pending[last],
+                (highlight->pendingCount - last) * sizeof(PendingRange));
+        highlight->pendingCount -= last - first - 1;
+    }
+    highlight->pending[first].start = start;
+    highlight->pending[first].end = end;
+    return TRUE;
+}
+
+/* Take start..end out of the ranges still to search */
+static void RemovePending(OccurrenceHighlight* highlight, INT_PTR start, INT_PTR end)
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < highlight->pendingCount; i++) {
+        PendingRange range = highlight->pending[i];
+        if (range.start < start && range.end > end) {
+            /* Splits the range in two. No other range overlaps start..end so none were
+             * dropped before this one. Without memory the part after is given up. */
+            highlight->pending[i].end = start;
+            AddPending(highlight, end, range.end);
+            return;
+        }
+        if (range.end <= start || range.start >= end) {
+            highlight->pending[kept++] = range;
+        } else if (range.start < start) {
+            highlight->pending[kept].start = range.start;
+            highlight->pending[kept++].end = start;
+        } else if (range.end > end) {
+            highlight->pending[kept].start = end;
+            highlight->pending[kept++].end = range.end;
+        }
+    }
+    highlight->pendingCount = kept;
+}
+
+/* The whole document is left to search */
+static void ResetPending(OccurrenceHighlight* highlight, INT_PTR documentLength)
+{
+    highlight->pendingCount = 0;
+    AddPending(highlight, 0, documentLength);
+}
+
+static void ApplyIndicatorStyle(HWND editor)
+{
+    SendMessage(editor, SCI_INDICSETSTYLE, INDICATOR_WORD_HIGHLIGHT, INDIC_ROUNDBOX);
+    SendMessage(editor, SCI_INDICSETFORE, INDICATOR_WORD_HIGHLIGHT, RGB(255, 255, 0));
+    SendMessage(editor, SCI_INDICSETALPHA, INDICATOR_WORD_HIGHLIGHT, 100);
+    SendMessage(editor, SCI_INDICSETOUTLINEALPHA, INDICATOR_WORD_HIGHLIGHT, 200);
+    SendMessage(editor, SCI_INDICSETUNDER, INDICATOR_WORD_HIGHLIGHT, TRUE);
+}
+
+/* Replace the highlights in start..end with the occurrences found there. Both ends are
+ * at line starts or just after a word so no occurrence crosses them. */
+static void SearchRange(OccurrenceHighlight* highlight, HWND editor, INT_PTR start, INT_PTR end)
+{
+    SendMessage(editor, SCI_SETINDICATORCURRENT, INDICATOR_WORD_HIGHLIGHT, 0);
+    SendMessage(editor, SCI_INDICATORCLEARRANGE, start, end - start);
+
+    struct Sci_CharacterRangeFull* ranges = (struct Sci_CharacterRangeFull*)malloc(
+        sizeof(struct Sci_CharacterRangeFull) * OCCURRENCES_RANGES_CHUNK);
+    if (!ranges) {
+        RemovePending(highlight, start, end);
+        return;
+    }
+
+    struct Sci_TextToFindAll fa;
+    fa.chrg.cpMin = start;
+    fa.chrg.cpMax = end;
+    fa.lpstrText = highlight->word;
+    fa.ranges = ranges;
+    fa.maxRanges = OCCURRENCES_RANGES_CHUNK;
+
+    Sci_Position found;
+    do {
+        found = (Sci_Position)SendMessage(editor, SCI_FINDALL, SCFIND_WHOLEWORD, (LPARAM)&fa);
+        for (Sci_Position i = 0; i < found; i++) {
+            SendMessage(editor, SCI_INDICATORFILLRANGE, ranges[i].cpMin, ranges[i].cpMax - ranges[i].cpMin);
+        }
+        if (found > 0) {
+            fa.chrg.cpMin = ranges[found - 1].cpMax;
+        }
+    } while (found == OCCURRENCES_RANGES_CHUNK);
+
+    free(ranges);
+    RemovePending(highlight, start, end);
+}
+
+/* Start of the line holding position */
+static INT_PTR LineStartOf(HWND editor, INT_PTR position)
+{
+    INT_PTR line = (INT_PTR)SendMessage(editor, SCI_LINEFROMPOSITION, position, 0);
+    return (INT_PTR)SendMessage(editor, SCI_POSITIONFROMLINE, line, 0);
+}
+
+/* Start of the line after the one holding position, or the end of the document */
+static INT_PTR NextLineStartOf(HWND editor, INT_PTR position, INT_PTR documentLength)
+{
+    INT_PTR line = (INT_PTR)SendMessage(editor, SCI_LINEFROMPOSITION, position, 0);
+    INT_PTR lineCount = (INT_PTR)SendMessage(editor, SCI_GETLINECOUNT, 0, 0);
+    if (line + 1 >= lineCount) {
+        return documentLength;
+    }
+    return (INT_PTR)SendMessage(editor, SCI_POSITIONFROMLINE, line + 1, 0);
+}
+
+/* The document lines shown in the editor, taking folding and wrapping into account */
+static void GetVisibleRange(HWND editor, INT_PTR documentLength, INT_PTR* start, INT_PTR* end)
+{
+    INT_PTR firstVisible = (INT_PTR)SendMessage(editor, SCI_GETFIRSTVISIBLELINE, 0, 0);
+    INT_PTR linesOnScreen = (INT_PTR)SendMessage(editor, SCI_LINESONSCREEN, 0, 0);
+    INT_PTR firstLine = (INT_PTR)SendMessage(editor, SCI_DOCLINEFROMVISIBLE, firstVisible, 0);
+    INT_PTR lastLine = (INT_PTR)SendMessage(editor, SCI_DOCLINEFROMVISIBLE, firstVisible + linesOnScreen, 0);
+    *start = (INT_PTR)SendMessage(editor, SCI_POSITIONFROMLINE, firstLine, 0);
+    *end = NextLineStartOf(editor, (INT_PTR)SendMessage(editor, SCI_POSITIONFROMLINE, lastLine, 0), documentLength);
+    if (*start < 0) {
+        *start = 0;
+    }
+}
+
+/* The highlights are only valid for the document they were found in. A length that
+ * doesn't match means edits were missed, so the whole document is searched again. */
+static BOOL CheckDocument(OccurrenceHighlight* highlight, HWND editor)
+{
+    void* document = (void*)SendMessage(editor, SCI_GETDOCPOINTER, 0, 0);
+    if (document != highlight->document) {
+        highlight->wordLength = 0;
+        highlight->pendingCount = 0;
+        return FALSE;
+    }
+    INT_PTR documentLength = (INT_PTR)SendMessage(editor, SCI_GETLENGTH, 0, 0);
+    if (documentLength != highlight->documentLength) {
+        highlight->documentLength = documentLength;
+        ResetPending(highlight, documentLength);
+    }
+    return TRUE;
+}
+
+/* Search the part of the lines on screen still to search */
+static void SearchVisible(OccurrenceHighlight* highlight, HWND editor)
+{
+    INT_PTR visibleStart, visibleEnd;
+    GetVisibleRange(editor, highlight->documentLength, &visibleStart, &visibleEnd);
+    size_t i = 0;
+    while (i < highlight->pendingCount && highlight->pending[i].start < visibleEnd) {
+        PendingRange range = highlight->pending[i];
+        if (range.end > visibleStart) {
+            INT_PTR start = range.start > visibleStart ? range.start : visibleStart;
+            INT_PTR end = range.end < visibleEnd ? range.end : visibleEnd;
+            SearchRange(highlight, editor, start, end);
+            /* Ranges after this one may have moved down the list */
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+}
+
+BOOL HighlightOccurrences(OccurrenceHighlight* highlight, HWND editor, const char* word, int wordLength)
+{
+    if (!highlight || !editor || !word || wordLength <= 0 || wordLength >= OCCURRENCES_MAX_WORD) {
+        return TRUE;
+    }
+
+    /* Clear the previous word's highlights */
+    highlight->document = (void*)SendMessage(editor, SCI_GETDOCPOINTER, 0, 0);
+    highlight->documentLength = (INT_PTR)SendMessage(editor, SCI_GETLENGTH, 0, 0);
+    SendMessage(editor, SCI_SETINDICATORCURRENT, INDICATOR_WORD_HIGHLIGHT, 0);
+    SendMessage(editor, SCI_INDICATORCLEARRANGE, 0, highlight->documentLength);
+    ApplyIndicatorStyle(editor);
+
+    memcpy(highlight->word, word, (size_t)wordLength);
+    highlight->word[wordLength] = '\0';
+    highlight->wordLength = wordLength;
+    ResetPending(highlight, highlight->documentLength);
+
+    SearchVisible(highlight, editor);
+    return highlight->pendingCount == 0;
+}
+
+void OccurrenceHighlightNoteModification(OccurrenceHighlight* highlight, HWND editor, int modificationType,
+                                         INT_PTR position, INT_PTR length)
+{
+    if (!highlight || !editor || highlight->wordLength == 0 ||
+        !(modificationType & (SC_MOD_INSERTTEXT | SC_MOD_DELETETEXT))) {
+        return;
+    }
+    BOOL inserted = (modificationType & SC_MOD_INSERTTEXT) != 0;
+    highlight->documentLength += inserted ? length : -length;
+    if (!CheckDocument(highlight, editor)) {
+        return;
+    }
+
+    /* Move the ranges still to search with the text, as Scintilla moves the highlights */
+    size_t kept = 0;
+    for (size_t i = 0; i < highlight->pendingCount; i++) {
+        PendingRange range = highlight->pending[i];
+        if (inserted) {
+            if (range.start >= position) {
+                range.start += length;
+            }
+            if (range.end > position) {
+                range.end += length;
+            }
+        } else {
+            INT_PTR deleteEnd = position + length;
+            range.start = range.start <= position ? range.start :
+                          (range.start >= deleteEnd ? range.start - length : position);
+            range.end = range.end <= position ? range.end :
+                        (range.end >= deleteEnd ? range.end - length : position);
+        }
+        if (range.end > range.start) {
+            highlight->pending[kept++] = range;
+        }
+    }
+    highlight->pendingCount = kept;
+
+    /* The lines the change touched, which may join or split occurrences */
+    INT_PTR changeEnd = inserted ? position + length : position;
+    if (!AddPending(highlight, LineStartOf(editor, position),
+                    NextLineStartOf(editor, changeEnd, highlight->documentLength))) {
+        ResetPending(highlight, highlight->documentLength);
+    }
+}
+
+BOOL OccurrenceHighlightScan(OccurrenceHighlight* highlight, HWND editor)
+{
+    if (!highlight || !editor || highlight->wordLength == 0) {
+        return TRUE;
+    }
+    if (!CheckDocument(highlight, editor)) {
+        return TRUE;
+    }
+
+    /* Lines scrolled into view since the last step come first */
+    SearchVisible(highlight, editor);
+    if (highlight->pendingCount == 0) {
+        return TRUE;
+    }
+
+    /* A step ends just after a word so no occurrence is split between steps */
+    PendingRange range = highlight->pending[0];
+    INT_PTR end = range.end;
+    if (end - range.start > OCCURRENCES_SCAN_CHUNK) {
+        end = (INT_PTR)SendMessage(editor, SCI_WORDENDPOSITION, range.start + OCCURRENCES_SCAN_CHUNK, TRUE);
+        if (end > range.end) {
+            end = range.end;
+        }
+    }
+    SearchRange(highlight, editor, range.start, end);
+    return highlight->pendingCount == 0;
+}
+
+BOOL OccurrenceHighlightIsComplete(const OccurrenceHighlight* highlight)
+{
+    return !highlight || highlight->wordLength == 0 || highlight->pendingCount == 0;
+}
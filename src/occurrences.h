@@ -0,0 +1,44 @@
+/*
+ * Occurrence highlighting header for Notepad+
+ * Highlights every occurrence of a word, visible lines first and the rest when idle
+ */
+
+#ifndef OCCURRENCES_H
+#define OCCURRENCES_H
+
+#include <windows.h>
+
+/* Text searched per step once the visible lines are highlighted (bytes) */
+#define OCCURRENCES_SCAN_CHUNK      (2 * 1024 * 1024)
+
+/* Interval between scan steps while part of a document is left to search (milliseconds) */
+#define OCCURRENCES_SCAN_INTERVAL   20
+
+/* Longest word that can be highlighted, including the terminating NUL */
+#define OCCURRENCES_MAX_WORD        256
+
+typedef struct OccurrenceHighlight OccurrenceHighlight;
+
+/* A new highlight has no word and highlights nothing */
+OccurrenceHighlight* CreateOccurrenceHighlight(void);
+void FreeOccurrenceHighlight(OccurrenceHighlight* highlight);
+
+/* Highlight every whole word occurrence of word in an editor's document in place of the
+ * previous word. The lines on screen are highlighted straight away and the rest of the
+ * document is left to OccurrenceHighlightScan. Returns TRUE when nothing is left to scan. */
+BOOL HighlightOccurrences(OccurrenceHighlight* highlight, HWND editor, const char* word, int wordLength);
+
+/* Keep the highlights in step with the document - call for every SCN_MODIFIED of the editor
+ * with SC_MOD_INSERTTEXT or SC_MOD_DELETETEXT. The lines the change touches are searched
+ * again by the next scan, the highlights elsewhere move with the text. */
+void OccurrenceHighlightNoteModification(OccurrenceHighlight* highlight, HWND editor, int modificationType,
+                                         INT_PTR position, INT_PTR length);
+
+/* Search the next part of the document still to scan, preferring the lines on screen.
+ * Returns TRUE once the whole document is highlighted. */
+BOOL OccurrenceHighlightScan(OccurrenceHighlight* highlight, HWND editor);
+
+/* Whether the whole document is highlighted, also TRUE when there is no word */
+BOOL OccurrenceHighlightIsComplete(const OccurrenceHighlight* highlight);
+
+#endif /* OCCURRENCES_H */
@@ -372,7 +372,7 @@ BOOL DeleteRegistryConfig(void)
     LONG result;
     
     /* Delete all tab subkeys under Session first */
-    for (int i = 0; i < 100; i++) {
+    for (int i = 0; i < MAX_SESSION_TABS; i++) {
         char tabPath[MAX_PATH];
         sprintf(tabPath, "%s\\%s%d", REGISTRY_SESSION_PATH, REG_TAB_PATH_PREFIX, i);
         RegDeleteKey(REGISTRY_ROOT_KEY, tabPath);
@@ -635,7 +635,7 @@ BOOL LoadSessionFromRegistry(void* sessionData)
     }
     
     /* Load each tab */
-    for (int i = 0; i < session->tabCount && i < 100; i++) {
+    for (int i = 0; i < session->tabCount && i < MAX_SESSION_TABS; i++) {
         char tabPath[MAX_PATH];
         sprintf(tabPath, "%s\\%s%d", REGISTRY_SESSION_PATH, REG_TAB_PATH_PREFIX, i);
         
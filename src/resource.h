@@ -24,6 +24,7 @@
 #define ID_FILE_RECENT_BASE      150  /* IDs 150-159 for recent files */
 #define ID_FILE_CLEARRECENT      160
 #define ID_FILE_OPENFOLDER       161  /* Open containing folder */
+#define ID_FILE_CANCELLOAD       162  /* Cancel background file load */
 
 /* Edit menu */
 #define ID_EDIT_UNDO             201
@@ -37,6 +38,7 @@
 #define ID_EDIT_FINDNEXT         209
 #define ID_EDIT_FINDPREV         210
 #define ID_EDIT_GOTOLINE         211
+#define ID_EDIT_FINDINFILES      212
 
 /* Common line operations */
 #define ID_EDIT_DUPLICATE_LINE   220
@@ -155,7 +157,7 @@
 
 /* Find/Replace dialog control IDs */
 #define IDC_FIND_LABEL           1000
-#define IDC_REGEX                1006
+#define IDC_REGEX                1024
 #define IDC_REPLACE              1011
 #define IDC_REPLACE_ALL          1012
 /* Other find/replace IDs are defined in findreplace.h with proper guards */
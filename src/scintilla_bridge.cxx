@@ -0,0 +1,523 @@
+/*
+ * Scintilla bridge implementation for Notepad+
+ * The rest of the application is C, so the Scintilla C++ interfaces are wrapped here
+ */
+
+#include <cstddef>
+#include <cstring>
+
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <optional>
+#include <array>
+#include <memory>
+#include <algorithm>
+
+#include "ScintillaTypes.h"
+#include "ILoader.h"
+#include "Position.h"
+#include "Debugging.h"
+#include "SplitVector.h"
+#include "Partitioning.h"
+#include "RunStyles.h"
+#include "CellBuffer.h"
+#include "CharacterType.h"
+#include "CharClassify.h"
+#include "ILexer.h"
+#include "CharacterCategoryMap.h"
+#include "Decoration.h"
+#include "CaseFolder.h"
+#include "Document.h"
+#include "LiteralSearch.h"
+#include "RESearch.h"
+#include "LinearRegex.h"
+#include "UniConversion.h"
+#include "TextScanner.h"
+#include "scintilla_bridge.h"
+
+using Scintilla::FindOption;
+using Scintilla::ILoader;
+using Scintilla::Internal::CharacterClass;
+using Scintilla::Internal::CharacterIndexer;
+using Scintilla::Internal::CaseFolderUnicode;
+using Scintilla::Internal::CharClassify;
+using Scintilla::Internal::Document;
+using Scintilla::Internal::Range;
+using Scintilla::Internal::RegexError;
+using Scintilla::Internal::ILoaderLines;
+using Scintilla::Internal::RESearch;
+using Scintilla::Internal::LinearRegex;
+using Scintilla::Internal::LinearRegexText;
+using Scintilla::Internal::SplitFindFoldedCandidate;
+using Scintilla::Internal::SplitFindLiteral;
+using Scintilla::Internal::SplitMatchFoldedUTF8;
+using Scintilla::Internal::SplitView;
+using Scintilla::Internal::TextScanner;
+using Scintilla::Internal::UTF8FromUTF16Stream;
+using Scintilla::Internal::UTF8Validator;
+
+/* Append a block of UTF-8 text to the end of the loader's document */
+extern "C" int LoaderAddData(void* loader, const char* data, Sci_Position length)
+{
+    if (!loader) {
+        return LOADER_STATUS_FAILURE;
+    }
+    return static_cast<ILoader*>(loader)->AddData(data, length);
+}
+
+/* Append a block whose line starts are already known - see TextScannerLineStarts.
+ * Loaders without the fast path find the line starts again themselves. */
+extern "C" int LoaderAddDataLines(void* loader, const char* data, Sci_Position length, const Sci_Position* lineStarts, Sci_Position lineCount)
+{
+    if (!loader) {
+        return LOADER_STATUS_FAILURE;
+    }
+    ILoader* iLoader = static_cast<ILoader*>(loader);
+    if (ILoaderLines* loaderLines = dynamic_cast<ILoaderLines*>(iLoader)) {
+        return loaderLines->AddDataLines(data, length, lineStarts, lineCount);
+    }
+    return iLoader->AddData(data, length);
+}
+
+/* Finish loading - the returned document is owned by the caller */
+extern "C" void* LoaderConvertToDocument(void* loader)
+{
+    if (!loader) {
+        return nullptr;
+    }
+    return static_cast<ILoader*>(loader)->ConvertToDocument();
+}
+
+/* Discard a loader and the text added to it */
+extern "C" int LoaderRelease(void* loader)
+{
+    if (!loader) {
+        return 0;
+    }
+    return static_cast<ILoader*>(loader)->Release();
+}
+
+namespace {
+
+/* A search loader is searched this much at a time so cancelling doesn't wait for the whole
+ * document. Spans are large enough for each to be split between the search threads. */
+constexpr Sci::Position findAllSpan = 0x4000000;
+
+/* Matches fetched from each FindAll call */
+constexpr Sci::Position findAllBatch = 4096;
+
+}
+
+/* Search the copy of a document in a loader from SCI_CREATESEARCHLOADER, on any one thread */
+extern "C" Sci_Position LoaderFindAll(void* loader, const char* text, int searchFlags, unsigned int threads,
+                                      volatile long* cancelled, int (*found)(void* context, Sci_Position position),
+                                      void* context)
+{
+    Document* doc = loader ? dynamic_cast<Document*>(static_cast<ILoader*>(loader)) : nullptr;
+    if (!doc || !text || !found) {
+        return 0;
+    }
+    const FindOption flags = static_cast<FindOption>(searchFlags);
+    const Sci::Position length = static_cast<Sci::Position>(strlen(text));
+    const Sci::Position docLength = doc->Length();
+    try {
+        // Patterns that can match across a line end are searched in one go
+        const bool spans = doc->CanSearchInParallel(text, flags, length);
+        std::vector<Range> matches;
+        Sci::Position count = 0;
+        Sci::Position spanStart = 0;
+        do {
+            Sci::Position spanEnd = docLength;
+            if (spans && (docLength - spanStart > findAllSpan)) {
+                spanEnd = std::min(doc->LineStart(doc->SciLineFromPosition(spanStart + findAllSpan) + 1), docLength);
+            }
+            const bool last = spanEnd == docLength;
+            Sci::Position pos = spanStart;
+            for (;;) {
+                if (*cancelled) {
+                    return LOADER_FIND_CANCELLED;
+                }
+                matches.clear();
+                doc->FindAll(pos, spanEnd, text, flags, length, &matches, findAllBatch, threads);
+                for (const Range &match : matches) {
+                    // An empty match at the end belongs to the next span
+                    if (!last && (match.start >= spanEnd)) {
+                        break;
+                    }
+                    count++;
+                    if (!found(context, match.start)) {
+                        return count;
+                    }
+                }
+                if (static_cast<Sci::Position>(matches.size()) < findAllBatch) {
+                    break;
+                }
+                // Carry on after the last match, past it when it was empty
+                const Range &lastMatch = matches.back();
+                pos = (lastMatch.end > lastMatch.start) ? lastMatch.end : doc->NextPosition(lastMatch.end, 1);
+                if (pos >= spanEnd) {
+                    break;
+                }
+            }
+            spanStart = spanEnd;
+        } while (spanStart < docLength);
+        return count;
+    } catch (const RegexError&) {
+        return LOADER_FIND_INVALID;
+    } catch (const std::bad_alloc&) {
+        return LOADER_FIND_CANCELLED;
+    }
+}
+
+/* Create a UTF-16 to UTF-8 stream - NULL if out of memory */
+extern "C" void* UTF16StreamCreate(int bigEndian)
+{
+    return new (std::nothrow) UTF8FromUTF16Stream(bigEndian != 0);
+}
+
+/* Output space needed to convert a chunk of length bytes */
+extern "C" size_t UTF16StreamMaxOutput(size_t length)
+{
+    return UTF8FromUTF16Stream::MaxOutput(length);
+}
+
+/* Convert the next chunk - atEnd flushes any character left incomplete */
+extern "C" size_t UTF16StreamConvert(void* stream, const char* data, size_t length, char* out, size_t outLength, int atEnd)
+{
+    if (!stream) {
+        return static_cast<size_t>(-1);
+    }
+    try {
+        return static_cast<UTF8FromUTF16Stream*>(stream)->Convert(std::string_view(data, length), out, outLength, atEnd != 0);
+    } catch (const std::exception&) {
+        return static_cast<size_t>(-1);
+    }
+}
+
+extern "C" void UTF16StreamRelease(void* stream)
+{
+    delete static_cast<UTF8FromUTF16Stream*>(stream);
+}
+
+/* Create a UTF-8 validator - NULL if out of memory */
+extern "C" void* UTF8ValidatorCreate(void)
+{
+    return new (std::nothrow) UTF8Validator();
+}
+
+/* Check the next chunk - a character split by the end of the chunk is checked with the next one */
+extern "C" int UTF8ValidatorCheck(void* validator, const char* data, size_t length, int atEnd)
+{
+    if (!validator) {
+        return 0;
+    }
+    return static_cast<UTF8Validator*>(validator)->Check(std::string_view(data, length), atEnd != 0);
+}
+
+extern "C" int UTF8ValidatorAllASCII(void* validator)
+{
+    return validator ? static_cast<UTF8Validator*>(validator)->AllASCII() : 0;
+}
+
+extern "C" void UTF8ValidatorRelease(void* validator)
+{
+    delete static_cast<UTF8Validator*>(validator);
+}
+
+/* Create a text scanner - NULL if out of memory */
+extern "C" void* TextScannerCreate(int checkUTF8)
+{
+    return new (std::nothrow) TextScanner(checkUTF8 != 0);
+}
+
+extern "C" size_t TextScannerScan(void* scanner, const char* data, size_t length, int atEnd)
+{
+    if (!scanner) {
+        return static_cast<size_t>(-1);
+    }
+    try {
+        return static_cast<TextScanner*>(scanner)->Scan(std::string_view(data, length), atEnd != 0);
+    } catch (const std::exception&) {
+        /* Out of memory for the line starts */
+        return static_cast<size_t>(-1);
+    }
+}
+
+extern "C" int TextScannerAllASCII(void* scanner)
+{
+    return scanner ? static_cast<TextScanner*>(scanner)->AllASCII() : 0;
+}
+
+extern "C" const Sci_Position* TextScannerLineStarts(void* scanner, Sci_Position* lineCount)
+{
+    if (!scanner) {
+        *lineCount = 0;
+        return nullptr;
+    }
+    const std::vector<Sci::Position>& starts = static_cast<TextScanner*>(scanner)->LineStarts();
+    *lineCount = static_cast<Sci_Position>(starts.size());
+    return starts.data();
+}
+
+extern "C" void TextScannerLineEndCounts(void* scanner, Sci_Position* cr, Sci_Position* lf, Sci_Position* crlf)
+{
+    *cr = *lf = *crlf = 0;
+    if (scanner) {
+        const Scintilla::Internal::LineEndCounts& counts = static_cast<TextScanner*>(scanner)->Counts();
+        *cr = counts.cr;
+        *lf = counts.lf;
+        *crlf = counts.crlf;
+    }
+}
+
+extern "C" void TextScannerRelease(void* scanner)
+{
+    delete static_cast<TextScanner*>(scanner);
+}
+
+namespace {
+
+/* Text of one line for RESearch - reads past the end of the line as NUL like the document's
+ * indexer, and moves positions off UTF-8 trail bytes so '.' matches whole characters */
+class ByteIndexer : public CharacterIndexer {
+    const char* text;
+    Sci::Position end;
+public:
+    ByteIndexer(const char* text_, Sci::Position end_) noexcept : text(text_), end(end_) {}
+    char CharAt(Sci::Position index) const noexcept override
+    {
+        return (index >= 0 && index < end) ? text[index] : '\0';
+    }
+    Sci::Position MovePositionOutsideChar(Sci::Position pos, Sci::Position moveDir) const noexcept override
+    {
+        while (pos > 0 && pos < end && Scintilla::Internal::UTF8IsTrailByte(static_cast<unsigned char>(text[pos]))) {
+            pos += (moveDir > 0) ? 1 : -1;
+        }
+        return pos;
+    }
+};
+
+/* Bytes searched by LinearRegex as a UTF-8 document, with its word characters */
+class ByteRegexText : public LinearRegexText {
+    const CharClassify& charClass;
+public:
+    ByteRegexText(const char* text, size_t length, const CharClassify& charClass_) noexcept :
+        LinearRegexText(SplitView { text, length, text, length }, Scintilla::CpUtf8), charClass(charClass_) {}
+    bool IsDBCSLeadByte(char) const noexcept override
+    {
+        return false;
+    }
+    bool IsWordCharacter(int ch) const noexcept override
+    {
+        if (ch < 0x80) {
+            return charClass.GetClass(static_cast<unsigned char>(ch)) == CharacterClass::word;
+        }
+        /* Letters, marks and numbers, the categories up to ccNo, as Document::WordCharacterClass has them */
+        return Scintilla::Internal::CategoriseCharacter(ch) <= Scintilla::Internal::ccNo;
+    }
+};
+
+/* Finds a pattern in raw bytes the way Document::FindText finds it in a UTF-8 document, with the
+ * same matchers over a view of the bytes: SplitFindLiteral for literal text, SplitFindFoldedCandidate
+ * and SplitMatchFoldedUTF8 with the Unicode case folder when case doesn't matter, regular
+ * expressions with the built-in RESearch engine one line at a time and, with SCFIND_LINEARREGEX,
+ * with LinearRegex over the whole text so matches may continue over lines */
+class ByteSearch {
+    std::string pattern;        /* Case folded when not case sensitive */
+    bool regExp;
+    bool caseSensitive;
+    bool word;
+    bool wordStart;
+    CharClassify charClass;
+    CaseFolderUnicode caseFolder;
+    std::unique_ptr<RESearch> re;
+    std::unique_ptr<LinearRegex> linear;
+
+    bool IsWordStartAt(const char* text, size_t length, size_t pos) const noexcept
+    {
+        if (pos == 0 || pos >= length) {
+            return true;
+        }
+        const CharacterClass ccPos = charClass.GetClass(static_cast<unsigned char>(text[pos]));
+        return (ccPos == CharacterClass::word || ccPos == CharacterClass::punctuation) &&
+               (ccPos != charClass.GetClass(static_cast<unsigned char>(text[pos - 1])));
+    }
+
+    bool IsWordEndAt(const char* text, size_t length, size_t pos) const noexcept
+    {
+        if (pos == 0 || pos >= length) {
+            return true;
+        }
+        const CharacterClass ccPrev = charClass.GetClass(static_cast<unsigned char>(text[pos - 1]));
+        return (ccPrev == CharacterClass::word || ccPrev == CharacterClass::punctuation) &&
+               (ccPrev != charClass.GetClass(static_cast<unsigned char>(text[pos])));
+    }
+
+    bool MatchesWordOptions(const char* text, size_t length, size_t pos, size_t matchLength) const noexcept
+    {
+        return (!word && !wordStart) ||
+               (word && IsWordStartAt(text, length, pos) && IsWordEndAt(text, length, pos + matchLength)) ||
+               (wordStart && IsWordStartAt(text, length, pos));
+    }
+
+    bool FindLiteral(const char* text, size_t length, size_t start, size_t* matchStart, size_t* matchEnd)
+    {
+        const SplitView view { text, length, text, length };
+        const std::string_view needle(pattern);
+        size_t pos = start;
+        while (pos < length) {
+            if (caseSensitive) {
+                const ptrdiff_t found = SplitFindLiteral(view, pos, length, needle);
+                if (found < 0) {
+                    return false;
+                }
+                pos = static_cast<size_t>(found);
+                if (MatchesWordOptions(text, length, pos, needle.length())) {
+                    *matchStart = pos;
+                    *matchEnd = pos + needle.length();
+                    return true;
+                }
+                pos++;
+            } else {
+                /* Candidates are always character starts as trail bytes stop the skip first */
+                const ptrdiff_t found = SplitFindFoldedCandidate(view, pos, length, needle);
+                if (found < 0) {
+                    return false;
+                }
+                pos = static_cast<size_t>(found);
+                int widthFirstCharacter = 1;
+                const size_t lengthMatch = SplitMatchFoldedUTF8(view, pos, length, needle, caseFolder, widthFirstCharacter);
+                if (lengthMatch > 0 && MatchesWordOptions(text, length, pos, lengthMatch)) {
+                    *matchStart = pos;
+                    *matchEnd = pos + lengthMatch;
+                    return true;
+                }
+                pos += widthFirstCharacter;
+            }
+        }
+        return false;
+    }
+
+    bool FindRegex(const char* text, size_t length, size_t start, size_t* matchStart, size_t* matchEnd)
+    {
+        /* Lines are matched separately so ^ and $ match at their ends, as in documents */
+        size_t lineStart = start;
+        while (lineStart > 0 && text[lineStart - 1] != '\n') {
+            lineStart--;
+        }
+        size_t pos = start;
+        while (pos <= length) {
+            const char* newline = static_cast<const char*>(memchr(text + pos, '\n', length - pos));
+            const size_t lineEnd = newline ? static_cast<size_t>(newline - text) : length;
+            size_t endOfLine = lineEnd;
+            if (endOfLine > lineStart && text[endOfLine - 1] == '\r') {
+                endOfLine--;
+            }
+            if (pos <= endOfLine) {
+                const ByteIndexer indexer(text, static_cast<Sci::Position>(endOfLine));
+                re->SetLineRange(static_cast<Sci::Position>(lineStart), static_cast<Sci::Position>(endOfLine));
+                if (re->Execute(indexer, static_cast<Sci::Position>(pos), static_cast<Sci::Position>(endOfLine))) {
+                    *matchStart = static_cast<size_t>(re->bopat[0]);
+                    *matchEnd = static_cast<size_t>(re->eopat[0]);
+                    return true;
+                }
+            }
+            if (!newline) {
+                return false;
+            }
+            lineStart = pos = lineEnd + 1;
+        }
+        return false;
+    }
+
+    bool FindLinear(const char* text, size_t length, size_t start, size_t* matchStart, size_t* matchEnd)
+    {
+        const ByteRegexText regexText(text, length, charClass);
+        if (!linear->Search(regexText, static_cast<Sci::Position>(start), static_cast<Sci::Position>(length), false)) {
+            return false;
+        }
+        *matchStart = static_cast<size_t>(linear->bopat[0]);
+        *matchEnd = static_cast<size_t>(linear->eopat[0]);
+        return true;
+    }
+
+public:
+    ByteSearch(std::string_view pattern_, FindOption flags) :
+        pattern(pattern_),
+        regExp(Scintilla::FlagSet(flags, FindOption::RegExp)),
+        caseSensitive(Scintilla::FlagSet(flags, FindOption::MatchCase)),
+        word(Scintilla::FlagSet(flags, FindOption::WholeWord)),
+        wordStart(Scintilla::FlagSet(flags, FindOption::WordStart))
+    {
+        if (regExp && Scintilla::FlagSet(flags, FindOption::LinearRegEx)) {
+            linear = std::make_unique<LinearRegex>();
+            if (linear->Compile(pattern, caseSensitive, ByteRegexText(nullptr, 0, charClass))) {
+                linear.reset();
+            }
+        } else if (regExp) {
+            re = std::make_unique<RESearch>(&charClass);
+            if (re->Compile(pattern.data(), static_cast<Sci::Position>(pattern.length()), caseSensitive,
+                            Scintilla::FlagSet(flags, FindOption::Posix))) {
+                re.reset();
+            }
+        } else if (!caseSensitive && !pattern.empty()) {
+            /* Room for every character to fold to several, as Document::FindText allows */
+            constexpr size_t maxFoldingExpansion = 4;
+            std::vector<char> foldedPattern((pattern.length() + 1) * Scintilla::Internal::UTF8MaxBytes * maxFoldingExpansion + 1);
+            const size_t lenFolded = caseFolder.Fold(foldedPattern.data(), foldedPattern.size(),
+                                                     pattern.data(), pattern.length());
+            pattern.assign(foldedPattern.data(), lenFolded);
+        }
+    }
+
+    bool Valid() const noexcept
+    {
+        return !pattern.empty() && (!regExp || re || linear);
+    }
+
+    bool Find(const char* text, size_t length, size_t start, size_t* matchStart, size_t* matchEnd)
+    {
+        if (start > length) {
+            return false;
+        }
+        if (linear) {
+            return FindLinear(text, length, start, matchStart, matchEnd);
+        }
+        if (regExp) {
+            return FindRegex(text, length, start, matchStart, matchEnd);
+        }
+        return FindLiteral(text, length, start, matchStart, matchEnd);
+    }
+};
+
+}
+
+/* Create a searcher - NULL for an empty pattern, an invalid regular expression or out of memory */
+extern "C" void* ByteSearchCreate(const char* pattern, size_t length, int searchFlags)
+{
+    try {
+        std::unique_ptr<ByteSearch> search = std::make_unique<ByteSearch>(std::string_view(pattern, length),
+                                                                          static_cast<FindOption>(searchFlags));
+        return search->Valid() ? search.release() : nullptr;
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+/* Find the first match at or after start */
+extern "C" int ByteSearchFind(void* search, const char* text, size_t length, size_t start, size_t* matchStart, size_t* matchEnd)
+{
+    if (!search) {
+        return 0;
+    }
+    return static_cast<ByteSearch*>(search)->Find(text, length, start, matchStart, matchEnd) ? 1 : 0;
+}
+
+extern "C" void ByteSearchRelease(void* search)
+{
+    delete static_cast<ByteSearch*>(search);
+}
@@ -0,0 +1,88 @@
+/*
+ * Scintilla bridge header for Notepad+
+ * C-callable wrappers around Scintilla interfaces that are only available as C++ classes
+ */
+
+#ifndef SCINTILLA_BRIDGE_H
+#define SCINTILLA_BRIDGE_H
+
+#include <stddef.h>
+
+#include "Sci_Position.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Loader status codes (SC_STATUS_* from Scintilla.h) */
+#define LOADER_STATUS_OK        0
+#define LOADER_STATUS_FAILURE   1
+#define LOADER_STATUS_BADALLOC  2
+
+/* ILoader wrappers - the loader pointer is the value returned by SCI_CREATELOADER.
+ * Data is appended with LoaderAddData, or with LoaderAddDataLines when a TextScanner has
+ * already found the line starts in it. A completed loader is turned into a document with
+ * LoaderConvertToDocument (pass the result to SCI_SETDOCPOINTER, then SCI_RELEASEDOCUMENT).
+ * An abandoned loader must be freed with LoaderRelease. */
+int LoaderAddData(void* loader, const char* data, Sci_Position length);
+int LoaderAddDataLines(void* loader, const char* data, Sci_Position length, const Sci_Position* lineStarts, Sci_Position lineCount);
+void* LoaderConvertToDocument(void* loader);
+int LoaderRelease(void* loader);
+
+/* Find every match of text in a loader from SCI_CREATESEARCHLOADER once its text has been added.
+ * The copy can be searched on a worker thread while the document it was taken from is edited.
+ * found is called with the start of each match in order and stops the search by returning 0.
+ * Setting *cancelled stops the search between spans of lines and batches of matches.
+ * threads is as SCI_SETSEARCHTHREADS. Returns the number of matches found, LOADER_FIND_INVALID
+ * for an invalid regular expression or LOADER_FIND_CANCELLED when cancelled or out of memory. */
+#define LOADER_FIND_INVALID     (-1)
+#define LOADER_FIND_CANCELLED   (-2)
+Sci_Position LoaderFindAll(void* loader, const char* text, int searchFlags, unsigned int threads,
+                           volatile long* cancelled, int (*found)(void* context, Sci_Position position),
+                           void* context);
+
+/* Streaming UTF-16 to UTF-8 conversion (UTF8FromUTF16Stream from UniConversion).
+ * Byte pairs and surrogate pairs split between chunks are carried over to the next call.
+ * out must hold UTF16StreamMaxOutput(length) bytes. Returns the UTF-8 length or (size_t)-1. */
+void* UTF16StreamCreate(int bigEndian);
+size_t UTF16StreamMaxOutput(size_t length);
+size_t UTF16StreamConvert(void* stream, const char* data, size_t length, char* out, size_t outLength, int atEnd);
+void UTF16StreamRelease(void* stream);
+
+/* Chunked UTF-8 validation (UTF8Validator from UniConversion).
+ * UTF8ValidatorCheck returns 0 once an invalid sequence has been seen.
+ * UTF8ValidatorAllASCII returns 1 while every byte checked so far was ASCII. */
+void* UTF8ValidatorCreate(void);
+int UTF8ValidatorCheck(void* validator, const char* data, size_t length, int atEnd);
+int UTF8ValidatorAllASCII(void* validator);
+void UTF8ValidatorRelease(void* validator);
+
+/* Single pass line end and UTF-8 scan of text added to a loader (TextScanner).
+ * TextScannerScan returns the bytes consumed - less than length only when checking UTF-8 and
+ * an invalid sequence starts there, after which checking is off and the rest can be scanned again.
+ * (size_t)-1 means the scanner ran out of memory.
+ * TextScannerLineStarts returns the offsets of the lines starting in the last chunk scanned,
+ * ready for LoaderAddDataLines. The line end counts cover everything scanned. */
+void* TextScannerCreate(int checkUTF8);
+size_t TextScannerScan(void* scanner, const char* data, size_t length, int atEnd);
+int TextScannerAllASCII(void* scanner);
+const Sci_Position* TextScannerLineStarts(void* scanner, Sci_Position* lineCount);
+void TextScannerLineEndCounts(void* scanner, Sci_Position* cr, Sci_Position* lf, Sci_Position* crlf);
+void TextScannerRelease(void* scanner);
+
+/* Searching raw bytes, such as a mapped file, with the matchers documents are searched with:
+ * literal text folding case as UTF-8 documents do, or regular expressions with the built-in
+ * engine one line at a time or, with SCFIND_LINEARREGEX, the linear time engine over all the text.
+ * searchFlags are SCFIND_MATCHCASE, SCFIND_WHOLEWORD, SCFIND_WORDSTART, SCFIND_REGEXP, SCFIND_POSIX
+ * and SCFIND_LINEARREGEX. A searcher keeps match state so is used by one thread at a time.
+ * ByteSearchCreate returns NULL for an empty pattern, an invalid regular expression or out of memory.
+ * ByteSearchFind returns 1 and sets [*matchStart, *matchEnd) for the first match at or after start. */
+void* ByteSearchCreate(const char* pattern, size_t length, int searchFlags);
+int ByteSearchFind(void* search, const char* text, size_t length, size_t start, size_t* matchStart, size_t* matchEnd);
+void ByteSearchRelease(void* search);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCINTILLA_BRIDGE_H */
@@ -4,6 +4,7 @@
  */
 
 #include <windows.h>
+#include <shlobj.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -12,6 +13,8 @@
 #include "registry_config.h"
 #include "tabs.h"
 #include "window.h"
+#include "fileops.h"
+#include "autosave.h"
 #include "Scintilla.h"
 
 /* Import profiling macros from main.c when enabled */
@@ -73,7 +76,334 @@ void CleanupSession(void)
     }
 }
 
-/* Save current session to registry */
+/* Session journal - the tabs of the session are kept in %TEMP%\NotepadPlus\session.journal.
+ * Each SaveSession appends records only for what changed since the last one, so saving
+ * takes time in proportion to the edits made rather than the number of tabs open.
+ * One record per line, fields separated by tabs, ending with a checksum:
+ *   T  filePath  tempFilePath  cursor  firstLine  zoom  flags    state of one tab
+ *   O  activeIndex  filePath...                                 tab order
+ * A later T record for the same file replaces an earlier one and only the tabs in the last
+ * O record are restored. A record cut short by a crash fails its checksum and replay stops
+ * there, leaving the session as of the previous save. Once JOURNAL_COMPACT_RECORDS records
+ * have been appended the journal is rewritten with one record per open tab. */
+#define JOURNAL_FILE_NAME           "session.journal"
+#define JOURNAL_COMPACT_RECORDS     256
+#define JOURNAL_MAX_RECORD          (MAX_PATH * 2 + 64)
+
+/* Flags field of a T record */
+#define JOURNAL_TAB_MODIFIED        0x0001
+#define JOURNAL_TAB_UNSAVED         0x0002
+#define JOURNAL_TAB_PINNED          0x0004
+#define JOURNAL_TAB_WORDWRAP        0x0008
+#define JOURNAL_TAB_LINENUMBERS     0x0010
+#define JOURNAL_TAB_WHITESPACE      0x0020
+#define JOURNAL_TAB_AUTOINDENT      0x0040
+#define JOURNAL_TAB_CODEFOLDING     0x0080
+#define JOURNAL_TAB_CHANGEHISTORY   0x0100
+#define JOURNAL_TAB_SPLITVIEW       0x0200
+
+static int g_journalRecords = 0;            /* Records appended since the journal was last compacted */
+static unsigned int g_journalOrderHash = 0; /* Hash of the last O record written */
+static BOOL g_journalRestored = FALSE;      /* Open tabs match the journal they were restored from */
+
+/* Growable text buffer for journal records */
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} JournalBuffer;
+
+static BOOL JournalBufferAppend(JournalBuffer* buffer, const char* text, size_t length)
+{
+    if (buffer->length + length + 1 > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity * 2 : 4096;
+        while (capacity < buffer->length + length + 1) {
+            capacity *= 2;
+        }
+        char* data = (char*)realloc(buffer->data, capacity);
+        if (!data) {
+            return FALSE;
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->data + buffer->length, text, length);
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+    return TRUE;
+}
+
+/* FNV-1a - used for record checksums and to tell whether a record changed */
+static unsigned int JournalHash(const char* text, size_t length)
+{
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)text[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* Append a record with its checksum */
+static BOOL AppendJournalRecord(JournalBuffer* buffer, const char* record, size_t length)
+{
+    char checksum[16];
+    sprintf(checksum, "\t#%08x\n", JournalHash(record, length));
+    return JournalBufferAppend(buffer, record, length) &&
+           JournalBufferAppend(buffer, checksum, strlen(checksum));
+}
+
+/* Directory the session used to be kept in, which the system may clean out */
+static void GetLegacySessionDir(char* dir)
+{
+    GetTempPath(MAX_PATH, dir);
+    strcat(dir, "NotepadPlus\\");
+}
+
+/* Directory holding the journal and the snapshots of unsaved tabs - in the local application
+ * data folder, falling back to the temp folder when there isn't one */
+void GetSessionDir(char* dir)
+{
+    if (SUCCEEDED(SHGetFolderPath(NULL, CSIDL_LOCAL_APPDATA | CSIDL_FLAG_CREATE, NULL, SHGFP_TYPE_CURRENT, dir)) &&
+        strlen(dir) + 14 < MAX_PATH) {
+        strcat(dir, "\\NotepadPlus\\");
+    } else {
+        GetLegacySessionDir(dir);
+    }
+    CreateDirectory(dir, NULL);
+}
+
+static void GetJournalPath(char* path)
+{
+    GetSessionDir(path);
+    strcat(path, JOURNAL_FILE_NAME);
+}
+
+/* Move a journal left in the temp folder by an older version to the session directory.
+ * The snapshots it names are found by their full paths, so they can stay where they are. */
+static void MigrateLegacyJournal(void)
+{
+    char journalPath[MAX_PATH];
+    char legacyPath[MAX_PATH];
+    GetJournalPath(journalPath);
+    GetLegacySessionDir(legacyPath);
+    strcat(legacyPath, JOURNAL_FILE_NAME);
+    if (_stricmp(journalPath, legacyPath) != 0 &&
+        GetFileAttributes(journalPath) == INVALID_FILE_ATTRIBUTES &&
+        GetFileAttributes(legacyPath) != INVALID_FILE_ATTRIBUTES) {
+        MoveFileEx(legacyPath, journalPath, MOVEFILE_COPY_ALLOWED | MOVEFILE_WRITE_THROUGH);
+    }
+}
+
+/* Session state of a tab - placeholder tabs are described without creating their editor */
+static void CaptureSessionTab(const TabInfo* tab, SessionTab* sessionTab)
+{
+    memset(sessionTab, 0, sizeof(SessionTab));
+    strncpy(sessionTab->filePath, tab->filePath, MAX_PATH - 1);
+    strncpy(sessionTab->tempFilePath, tab->tempFilePath, MAX_PATH - 1);
+    sessionTab->isUnsaved = (strncmp(tab->filePath, "New ", 4) == 0);
+    sessionTab->isModified = tab->isModified;
+    sessionTab->isPinned = tab->isPinned;
+    sessionTab->autoIndent = 0; /* SCI_GETAUTOMATICINDENT not available */
+    sessionTab->codeFoldingEnabled = tab->codeFoldingEnabled;
+    sessionTab->changeHistoryEnabled = tab->changeHistoryEnabled;
+    sessionTab->isSplitView = tab->isSplitView;
+    
+    if (tab->editorHandle && !tab->loadJob) {
+        sessionTab->cursorPosition = (int)SendMessage(tab->editorHandle, SCI_GETCURRENTPOS, 0, 0);
+        sessionTab->firstVisibleLine = (int)SendMessage(tab->editorHandle, SCI_GETFIRSTVISIBLELINE, 0, 0);
+        sessionTab->zoomLevel = (int)SendMessage(tab->editorHandle, SCI_GETZOOM, 0, 0);
+        sessionTab->wordWrap = (SendMessage(tab->editorHandle, SCI_GETWRAPMODE, 0, 0) != SC_WRAP_NONE);
+        sessionTab->showLineNumbers = SendMessage(tab->editorHandle, SCI_GETMARGINWIDTHN, 0, 0) > 0;
+        sessionTab->showWhitespace = (SendMessage(tab->editorHandle, SCI_GETVIEWWS, 0, 0) != SCWS_INVISIBLE);
+        
+        /* Save zoom level to config too */
+        AppConfig* cfg = GetConfig();
+        if (cfg) {
+            cfg->zoomLevel = sessionTab->zoomLevel;
+        }
+    } else {
+        /* Not loaded yet (or still loading) - keep what the session restored */
+        sessionTab->cursorPosition = tab->sessionCursorPos;
+        sessionTab->firstVisibleLine = tab->sessionFirstLine;
+        sessionTab->zoomLevel = tab->sessionZoomLevel;
+        sessionTab->wordWrap = tab->wordWrap;
+        sessionTab->showLineNumbers = tab->showLineNumbers;
+        sessionTab->showWhitespace = tab->showWhitespace;
+    }
+}
+
+static int FormatTabRecord(const SessionTab* sessionTab, char* record)
+{
+    unsigned int flags =
+        (sessionTab->isModified ? JOURNAL_TAB_MODIFIED : 0) |
+        (sessionTab->isUnsaved ? JOURNAL_TAB_UNSAVED : 0) |
+        (sessionTab->isPinned ? JOURNAL_TAB_PINNED : 0) |
+        (sessionTab->wordWrap ? JOURNAL_TAB_WORDWRAP : 0) |
+        (sessionTab->showLineNumbers ? JOURNAL_TAB_LINENUMBERS : 0) |
+        (sessionTab->showWhitespace ? JOURNAL_TAB_WHITESPACE : 0) |
+        (sessionTab->autoIndent ? JOURNAL_TAB_AUTOINDENT : 0) |
+        (sessionTab->codeFoldingEnabled ? JOURNAL_TAB_CODEFOLDING : 0) |
+        (sessionTab->changeHistoryEnabled ? JOURNAL_TAB_CHANGEHISTORY : 0) |
+        (sessionTab->isSplitView ? JOURNAL_TAB_SPLITVIEW : 0);
+    return sprintf(record, "T\t%s\t%s\t%d\t%d\t%d\t%x", sessionTab->filePath, sessionTab->tempFilePath,
+                   sessionTab->cursorPosition, sessionTab->firstVisibleLine, sessionTab->zoomLevel, flags);
+}
+
+/* Build the O record for the current tab order */
+static BOOL FormatOrderRecord(JournalBuffer* order)
+{
+    char header[32];
+    sprintf(header, "O\t%d", GetSelectedTab());
+    BOOL ok = JournalBufferAppend(order, header, strlen(header));
+    int tabCount = GetTabCount();
+    for (int i = 0; i < tabCount && ok; i++) {
+        TabInfo* tab = GetTab(i);
+        if (tab) {
+            ok = JournalBufferAppend(order, "\t", 1) &&
+                 JournalBufferAppend(order, tab->filePath, strlen(tab->filePath));
+        }
+    }
+    return ok;
+}
+
+/* Append data to the journal file and make sure it reached the disk */
+static BOOL WriteJournalFile(const char* path, const char* data, size_t length, BOOL append)
+{
+    HANDLE file = CreateFile(path, append ? FILE_APPEND_DATA : GENERIC_WRITE, 0, NULL,
+                             append ? OPEN_ALWAYS : CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return FALSE;
+    }
+    DWORD written = 0;
+    BOOL ok = WriteFile(file, data, (DWORD)length, &written, NULL) && written == (DWORD)length;
+    ok = ok && FlushFileBuffers(file);
+    CloseHandle(file);
+    return ok;
+}
+
+/* Forget what has been written so the next save writes every tab */
+static void ResetJournalHashes(void)
+{
+    int tabCount = GetTabCount();
+    for (int i = 0; i < tabCount; i++) {
+        TabInfo* tab = GetTab(i);
+        if (tab) {
+            tab->journalHash = 0;
+        }
+    }
+    g_journalOrderHash = 0;
+}
+
+/* Rewrite the journal with one record per open tab, replacing the old one atomically */
+static BOOL CompactJournal(void)
+{
+    JournalBuffer buffer = {0};
+    JournalBuffer order = {0};
+    char record[JOURNAL_MAX_RECORD];
+    BOOL ok = TRUE;
+    
+    int tabCount = GetTabCount();
+    for (int i = 0; i < tabCount && ok; i++) {
+        TabInfo* tab = GetTab(i);
+        if (tab) {
+            SessionTab sessionTab;
+            CaptureSessionTab(tab, &sessionTab);
+            int length = FormatTabRecord(&sessionTab, record);
+            ok = AppendJournalRecord(&buffer, record, length);
+            tab->journalHash = JournalHash(record, length);
+        }
+    }
+    ok = ok && FormatOrderRecord(&order) && AppendJournalRecord(&buffer, order.data, order.length);
+    if (ok) {
+        g_journalOrderHash = JournalHash(order.data, order.length);
+    }
+    
+    char journalPath[MAX_PATH];
+    char compactPath[MAX_PATH];
+    GetJournalPath(journalPath);
+    sprintf(compactPath, "%s.new", journalPath);
+    ok = ok && WriteJournalFile(compactPath, buffer.data, buffer.length, FALSE) &&
+         MoveFileEx(compactPath, journalPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    if (ok) {
+        g_journalRecords = 0;
+    } else {
+        DeleteFile(compactPath);
+        ResetJournalHashes();
+    }
+    
+    free(buffer.data);
+    free(order.data);
+    return ok;
+}
+
+/* Snapshot the unsaved edits of every tab and append the records that changed to the
+ * journal. Placeholder tabs are recorded from what the session restored - nothing is loaded.
+ * A final update writes checkpoints without waiting for a pause and waits for the writes. */
+static BOOL AppendSessionJournal(BOOL final)
+{
+    JournalBuffer buffer = {0};
+    JournalBuffer order = {0};
+    char record[JOURNAL_MAX_RECORD];
+    int records = 0;
+    BOOL ok = TRUE;
+    
+    int tabCount = GetTabCount();
+    for (int i = 0; i < tabCount && ok; i++) {
+        TabInfo* tab = GetTab(i);
+        if (!tab) {
+            continue;
+        }
+        AutosaveTab(tab, final);
+        
+        SessionTab sessionTab;
+        CaptureSessionTab(tab, &sessionTab);
+        int length = FormatTabRecord(&sessionTab, record);
+        unsigned int hash = JournalHash(record, length);
+        if (hash != tab->journalHash) {
+            ok = AppendJournalRecord(&buffer, record, length);
+            tab->journalHash = hash;
+            records++;
+        }
+    }
+    
+    /* The snapshots the records name must be on disk before the session is left */
+    if (final) {
+        AutosaveFlush();
+    }
+    
+    ok = ok && FormatOrderRecord(&order);
+    if (ok) {
+        unsigned int orderHash = JournalHash(order.data, order.length);
+        if (orderHash != g_journalOrderHash) {
+            ok = AppendJournalRecord(&buffer, order.data, order.length);
+            g_journalOrderHash = orderHash;
+            records++;
+        }
+    }
+    
+    if (ok && buffer.length > 0) {
+        char journalPath[MAX_PATH];
+        GetJournalPath(journalPath);
+        ok = WriteJournalFile(journalPath, buffer.data, buffer.length, TRUE);
+    }
+    free(buffer.data);
+    free(order.data);
+    
+    if (ok) {
+        g_journalRecords += records;
+        if (g_journalRecords >= JOURNAL_COMPACT_RECORDS) {
+            CompactJournal();
+        }
+    } else {
+        /* The journal may be missing some of this save - write everything next time */
+        ResetJournalHashes();
+    }
+    
+    return ok;
+}
+
+/* Save current session - appends the changes since the last save to the journal */
 BOOL SaveSession(void)
 {
     /* Allow multiple saves - the flag is only used to prevent infinite recursion
@@ -86,14 +416,6 @@ BOOL SaveSession(void)
     /* Set flag to prevent recursion during this save operation */
     g_sessionSaved = TRUE;
     
-    /* Load all placeholder tabs before saving to ensure their content is preserved */
-    int tabCount = GetTabCount();
-    for (int i = 0; i < tabCount; i++) {
-        if (!IsTabLoaded(i)) {
-            LoadTabContent(i);
-        }
-    }
-    
     HWND mainWindow = GetMainWindow();
     
     /* Get window state */
@@ -117,201 +439,196 @@ BOOL SaveSession(void)
             g_session.windowHeight = wp.rcNormalPosition.bottom - wp.rcNormalPosition.top;
         }
     }
+    BOOL result = SaveWindowStateToRegistry(g_session.windowX, g_session.windowY,
+                                            g_session.windowWidth, g_session.windowHeight,
+                                            g_session.windowMaximized);
     
-    /* Get tab information (reuse tabCount from earlier) */
-    int savedTabs = 0;
+    BOOL ok = AppendSessionJournal(TRUE);
     
-    /* Get temp directory for unsaved files */
-    char tempDir[MAX_PATH];
-    GetTempPath(MAX_PATH, tempDir);
-    strcat(tempDir, "NotepadPlus\\");
-    CreateDirectory(tempDir, NULL);
+    /* Clear the flag after successful save - allows future saves */
+    g_sessionSaved = FALSE;
     
-    for (int i = 0; i < tabCount && savedTabs < MAX_SESSION_TABS; i++) {
-        TabInfo* tab = GetTab(i);
-        if (tab) {
-            /* Check if this is a new unsaved file */
-            if (strncmp(tab->filePath, "New ", 4) == 0) {
-                /* Save content to temporary file */
-                if (tab->editorHandle) {
-                    char tempFile[MAX_PATH];
-                    sprintf(tempFile, "%s%s.txt", tempDir, tab->filePath);
-                    
-                    /* Get text from editor */
-                    long textLength = (long)SendMessage(tab->editorHandle, SCI_GETLENGTH, 0, 0);
-                    if (textLength > 0) {
-                        char* buffer = (char*)malloc(textLength + 1);
-                        if (buffer) {
-                            SendMessage(tab->editorHandle, SCI_GETTEXT, textLength + 1, (LPARAM)buffer);
-                            
-                            /* Write to temp file */
-                            FILE* file = fopen(tempFile, "wb");
-                            if (file) {
-                                fwrite(buffer, 1, textLength, file);
-                                fclose(file);
-                                
-                                /* Store in session data */
-                                strncpy(g_session.tabs[savedTabs].tempFilePath, tempFile, MAX_PATH - 1);
-                                g_session.tabs[savedTabs].tempFilePath[MAX_PATH - 1] = '\0';
-                                strncpy(g_session.tabs[savedTabs].filePath, tab->filePath, MAX_PATH - 1);
-                                g_session.tabs[savedTabs].filePath[MAX_PATH - 1] = '\0';
-                                g_session.tabs[savedTabs].isUnsaved = TRUE;
-                                
-                                /* Get cursor position and zoom level */
-                                int cursorPos = (int)SendMessage(tab->editorHandle, SCI_GETCURRENTPOS, 0, 0);
-                                int firstLine = (int)SendMessage(tab->editorHandle, SCI_GETFIRSTVISIBLELINE, 0, 0);
-                                int zoomLevel = (int)SendMessage(tab->editorHandle, SCI_GETZOOM, 0, 0);
-                                
-                                g_session.tabs[savedTabs].cursorPosition = cursorPos;
-                                g_session.tabs[savedTabs].firstVisibleLine = firstLine;
-                                g_session.tabs[savedTabs].zoomLevel = zoomLevel;
-                                g_session.tabs[savedTabs].isModified = tab->isModified;
-                                g_session.tabs[savedTabs].isPinned = tab->isPinned;
-                                
-                                /* Capture per-tab view settings */
-                                g_session.tabs[savedTabs].wordWrap = (SendMessage(tab->editorHandle, SCI_GETWRAPMODE, 0, 0) != SC_WRAP_NONE);
-                                g_session.tabs[savedTabs].showLineNumbers = SendMessage(tab->editorHandle, SCI_GETMARGINWIDTHN, 0, 0) > 0;
-                                g_session.tabs[savedTabs].showWhitespace = (SendMessage(tab->editorHandle, SCI_GETVIEWWS, 0, 0) != SCWS_INVISIBLE);
-                                g_session.tabs[savedTabs].autoIndent = 0; /* SCI_GETAUTOMATICINDENT not available */
-                                g_session.tabs[savedTabs].codeFoldingEnabled = tab->codeFoldingEnabled;
-                                g_session.tabs[savedTabs].changeHistoryEnabled = tab->changeHistoryEnabled;
-                                g_session.tabs[savedTabs].isSplitView = tab->isSplitView;
-                                
-                                /* Update global config zoom level */
-                                AppConfig* cfg = GetConfig();
-                                if (cfg) {
-                                    cfg->zoomLevel = zoomLevel;
-                                }
-                                
-                                savedTabs++;
-                            }
-                            free(buffer);
-                        }
-                    } else {
-                        /* Empty unsaved file - just save metadata */
-                        sprintf(tempFile, "%s%s.txt", tempDir, tab->filePath);
-                        FILE* file = fopen(tempFile, "wb");
-                        if (file) {
-                            fclose(file);
-                            strncpy(g_session.tabs[savedTabs].tempFilePath, tempFile, MAX_PATH - 1);
-                            g_session.tabs[savedTabs].tempFilePath[MAX_PATH - 1] = '\0';
-                            strncpy(g_session.tabs[savedTabs].filePath, tab->filePath, MAX_PATH - 1);
-                            g_session.tabs[savedTabs].filePath[MAX_PATH - 1] = '\0';
-                            g_session.tabs[savedTabs].isUnsaved = TRUE;
-                            
-                            /* Get cursor position and zoom level even for empty files */
-                            int cursorPos = (int)SendMessage(tab->editorHandle, SCI_GETCURRENTPOS, 0, 0);
-                            int firstLine = (int)SendMessage(tab->editorHandle, SCI_GETFIRSTVISIBLELINE, 0, 0);
-                            int zoomLevel = (int)SendMessage(tab->editorHandle, SCI_GETZOOM, 0, 0);
-                            
-                            g_session.tabs[savedTabs].cursorPosition = cursorPos;
-                            g_session.tabs[savedTabs].firstVisibleLine = firstLine;
-                            g_session.tabs[savedTabs].zoomLevel = zoomLevel;
-                            g_session.tabs[savedTabs].isModified = FALSE;
-                            g_session.tabs[savedTabs].isPinned = tab->isPinned;
-                            savedTabs++;
-                        }
-                    }
+    return result && ok;
+}
+
+/* Capture the edits made since the last update and record what changed in the journal.
+ * Called periodically while editing so a crash loses as little as possible. */
+BOOL UpdateSessionJournal(void)
+{
+    if (g_sessionSaved) {
+        return TRUE;
+    }
+    return AppendSessionJournal(FALSE);
+}
+
+/* Split a journal line into tab separated fields in place - returns the field count */
+static int SplitJournalFields(char* line, char** fields, int maxFields)
+{
+    int count = 0;
+    fields[count++] = line;
+    for (char* p = line; *p && count < maxFields; p++) {
+        if (*p == '\t') {
+            *p = '\0';
+            fields[count++] = p + 1;
+        }
+    }
+    return count;
+}
+
+/* Rebuild the session from the journal. Returns FALSE if there is no usable journal. */
+static BOOL ReplayJournal(SessionData* session)
+{
+    char journalPath[MAX_PATH];
+    GetJournalPath(journalPath);
+    
+    FILE* file = fopen(journalPath, "rb");
+    if (!file) {
+        return FALSE;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* data = (size > 0) ? (char*)malloc((size_t)size + 1) : NULL;
+    if (!data || fread(data, 1, (size_t)size, file) != (size_t)size) {
+        free(data);
+        fclose(file);
+        return FALSE;
+    }
+    fclose(file);
+    data[size] = '\0';
+    
+    /* Latest state of every file named in the journal */
+    SessionTab* known = NULL;
+    int knownCount = 0;
+    int knownMax = 0;
+    char* lastOrder = NULL;
+    int records = 0;
+    
+    char* line = data;
+    while (*line) {
+        char* end = strchr(line, '\n');
+        if (!end) {
+            break;  /* Torn final record */
+        }
+        *end = '\0';
+        
+        char* mark = strrchr(line, '#');
+        if (!mark || mark == line || mark[-1] != '\t' ||
+            strtoul(mark + 1, NULL, 16) != JournalHash(line, (size_t)(mark - 1 - line))) {
+            break;  /* Damaged record - everything before it is still good */
+        }
+        mark[-1] = '\0';
+        records++;
+        
+        if (line[0] == 'T' && line[1] == '\t') {
+            char* fields[7];
+            if (SplitJournalFields(line, fields, 7) == 7) {
+                int index = 0;
+                while (index < knownCount && strcmp(known[index].filePath, fields[1]) != 0) {
+                    index++;
                 }
-            } else {
-                /* Regular saved file */
-                strncpy(g_session.tabs[savedTabs].filePath, tab->filePath, MAX_PATH - 1);
-                g_session.tabs[savedTabs].filePath[MAX_PATH - 1] = '\0';
-                
-                /* If file has unsaved modifications, save content to temp file */
-                if (tab->isModified && tab->editorHandle) {
-                    char tempFile[MAX_PATH];
-                    
-                    /* Create unique temp filename using hash of file path */
-                    unsigned int hash = 0;
-                    const char* p = tab->filePath;
-                    while (*p) {
-                        hash = hash * 31 + (unsigned char)*p++;
-                    }
-                    sprintf(tempFile, "%sunsaved_%u.tmp", tempDir, hash);
-                    
-                    /* Get text from editor */
-                    long textLength = (long)SendMessage(tab->editorHandle, SCI_GETLENGTH, 0, 0);
-                    char* buffer = (char*)malloc(textLength + 1);
-                    if (buffer) {
-                        SendMessage(tab->editorHandle, SCI_GETTEXT, textLength + 1, (LPARAM)buffer);
-                        
-                        /* Write to temp file */
-                        FILE* file = fopen(tempFile, "wb");
-                        if (file) {
-                            fwrite(buffer, 1, textLength, file);
-                            fclose(file);
-                            
-                            /* Store temp file path for later restoration */
-                            strncpy(g_session.tabs[savedTabs].tempFilePath, tempFile, MAX_PATH - 1);
-                            g_session.tabs[savedTabs].tempFilePath[MAX_PATH - 1] = '\0';
-                        } else {
-                            g_session.tabs[savedTabs].tempFilePath[0] = '\0';
-                        }
-                        free(buffer);
-                    } else {
-                        g_session.tabs[savedTabs].tempFilePath[0] = '\0';
+                if (index == knownMax) {
+                    int newMax = knownMax ? knownMax * 2 : 64;
+                    SessionTab* grown = (SessionTab*)realloc(known, sizeof(SessionTab) * newMax);
+                    if (!grown) {
+                        break;
                     }
-                } else {
-                    g_session.tabs[savedTabs].tempFilePath[0] = '\0';
+                    known = grown;
+                    knownMax = newMax;
                 }
-                
-                g_session.tabs[savedTabs].isUnsaved = FALSE;
-                
-                /* Get cursor position from editor */
-                if (tab->editorHandle) {
-                    int cursorPos = (int)SendMessage(tab->editorHandle, SCI_GETCURRENTPOS, 0, 0);
-                    int firstLine = (int)SendMessage(tab->editorHandle, SCI_GETFIRSTVISIBLELINE, 0, 0);
-                    int zoomLevel = (int)SendMessage(tab->editorHandle, SCI_GETZOOM, 0, 0);
-                    
-                    g_session.tabs[savedTabs].cursorPosition = cursorPos;
-                    g_session.tabs[savedTabs].firstVisibleLine = firstLine;
-                    g_session.tabs[savedTabs].zoomLevel = zoomLevel;
-                    
-                    /* Save zoom level to config too */
-                    AppConfig* cfg = GetConfig();
-                    if (cfg) {
-                        cfg->zoomLevel = zoomLevel;
-                    }
+                SessionTab* sessionTab = &known[index];
+                if (index == knownCount) {
+                    knownCount++;
                 }
-                
-                g_session.tabs[savedTabs].isModified = tab->isModified;
-                g_session.tabs[savedTabs].isPinned = tab->isPinned;
-                
-                /* Capture per-tab view settings */
-                g_session.tabs[savedTabs].wordWrap = (SendMessage(tab->editorHandle, SCI_GETWRAPMODE, 0, 0) != SC_WRAP_NONE);
-                g_session.tabs[savedTabs].showLineNumbers = SendMessage(tab->editorHandle, SCI_GETMARGINWIDTHN, 0, 0) > 0;
-                g_session.tabs[savedTabs].showWhitespace = (SendMessage(tab->editorHandle, SCI_GETVIEWWS, 0, 0) != SCWS_INVISIBLE);
-                g_session.tabs[savedTabs].autoIndent = 0; /* SCI_GETAUTOMATICINDENT not available */
-                g_session.tabs[savedTabs].codeFoldingEnabled = tab->codeFoldingEnabled;
-                g_session.tabs[savedTabs].changeHistoryEnabled = tab->changeHistoryEnabled;
-                g_session.tabs[savedTabs].isSplitView = tab->isSplitView;
-                
-                savedTabs++;
+                unsigned int flags = (unsigned int)strtoul(fields[6], NULL, 16);
+                memset(sessionTab, 0, sizeof(SessionTab));
+                strncpy(sessionTab->filePath, fields[1], MAX_PATH - 1);
+                strncpy(sessionTab->tempFilePath, fields[2], MAX_PATH - 1);
+                sessionTab->cursorPosition = atoi(fields[3]);
+                sessionTab->firstVisibleLine = atoi(fields[4]);
+                sessionTab->zoomLevel = atoi(fields[5]);
+                sessionTab->isModified = (flags & JOURNAL_TAB_MODIFIED) != 0;
+                sessionTab->isUnsaved = (flags & JOURNAL_TAB_UNSAVED) != 0;
+                sessionTab->isPinned = (flags & JOURNAL_TAB_PINNED) != 0;
+                sessionTab->wordWrap = (flags & JOURNAL_TAB_WORDWRAP) != 0;
+                sessionTab->showLineNumbers = (flags & JOURNAL_TAB_LINENUMBERS) != 0;
+                sessionTab->showWhitespace = (flags & JOURNAL_TAB_WHITESPACE) != 0;
+                sessionTab->autoIndent = (flags & JOURNAL_TAB_AUTOINDENT) != 0;
+                sessionTab->codeFoldingEnabled = (flags & JOURNAL_TAB_CODEFOLDING) != 0;
+                sessionTab->changeHistoryEnabled = (flags & JOURNAL_TAB_CHANGEHISTORY) != 0;
+                sessionTab->isSplitView = (flags & JOURNAL_TAB_SPLITVIEW) != 0;
             }
+        } else if (line[0] == 'O' && line[1] == '\t') {
+            lastOrder = line;
         }
+        line = end + 1;
     }
     
-    /* Update session counts */
-    g_session.tabCount = savedTabs;
-    g_session.activeTabIndex = GetSelectedTab();
-    
-    /* Save session to registry */
-    BOOL result = SaveSessionToRegistry(&g_session);
-    
-    /* Clear the flag after successful save - allows future saves */
-    g_sessionSaved = FALSE;
+    session->tabCount = 0;
+    session->activeTabIndex = 0;
+    if (lastOrder) {
+        char* fields[MAX_SESSION_TABS + 2];
+        int fieldCount = SplitJournalFields(lastOrder, fields, MAX_SESSION_TABS + 2);
+        session->activeTabIndex = (fieldCount > 1) ? atoi(fields[1]) : 0;
+        for (int f = 2; f < fieldCount; f++) {
+            for (int k = 0; k < knownCount; k++) {
+                if (strcmp(known[k].filePath, fields[f]) == 0) {
+                    session->tabs[session->tabCount++] = known[k];
+                    break;
+                }
+            }
+        }
+        if (session->activeTabIndex < 0 || session->activeTabIndex >= session->tabCount) {
+            session->activeTabIndex = 0;
+        }
+    }
     
-    return result;
+    g_journalRecords = records;
+    free(known);
+    free(data);
+    return lastOrder != NULL;
 }
 
-/* Load session from registry */
+/* Load session - from the journal, or from the registry as written by older versions */
 BOOL LoadSession(void)
 {
+    MigrateLegacyJournal();
+    if (ReplayJournal(&g_session)) {
+        /* Don't fail if the window state doesn't exist */
+        LoadWindowStateFromRegistry(&g_session.windowX, &g_session.windowY,
+                                    &g_session.windowWidth, &g_session.windowHeight,
+                                    &g_session.windowMaximized);
+        g_journalRestored = TRUE;
+        return TRUE;
+    }
+    
     /* Load from registry */
+    g_journalRestored = FALSE;
     return LoadSessionFromRegistry(&g_session);
 }
 
+/* The restored tabs already have records in the journal - only later changes need writing */
+static void MarkJournalRestored(void)
+{
+    char record[JOURNAL_MAX_RECORD];
+    int tabCount = GetTabCount();
+    
+    for (int i = 0; i < tabCount; i++) {
+        TabInfo* tab = GetTab(i);
+        if (tab) {
+            SessionTab sessionTab;
+            CaptureSessionTab(tab, &sessionTab);
+            tab->journalHash = JournalHash(record, FormatTabRecord(&sessionTab, record));
+        }
+    }
+    
+    JournalBuffer order = {0};
+    if (FormatOrderRecord(&order)) {
+        g_journalOrderHash = JournalHash(order.data, order.length);
+    }
+    free(order.data);
+}
+
 /* Restore session - actually open the tabs */
 BOOL RestoreSession(void)
 {
@@ -335,6 +652,7 @@ BOOL RestoreSession(void)
     /* Restore tabs in their original order - use lazy loading for fast startup:
      * Only load the active tab immediately, other tabs are loaded on demand */
     BOOL openedAnyTab = FALSE;
+    int openedTabs = 0;
     int activeTabIndex = g_session.activeTabIndex;
     
     /* Create ALL tabs in their original order, but only load content for the active tab */
@@ -375,6 +693,11 @@ BOOL RestoreSession(void)
                         /* Apply per-tab view settings safely after tab initialization */
                         ApplySessionViewSettings(tabIndex, &g_session.tabs[i]);
                         
+                        /* Placeholders catch up with their autosaved edits when they load */
+                        if (isActiveTab) {
+                            AutosaveRestoreTab(tab);
+                        }
+                        
                         UpdateTabDisplayName(tabIndex);
                     }
                 }
@@ -416,6 +739,9 @@ BOOL RestoreSession(void)
                             strncpy(tab->tempFilePath, g_session.tabs[i].tempFilePath, MAX_PATH - 1);
                             tab->tempFilePath[MAX_PATH - 1] = '\0';
                             tab->isModified = TRUE;
+                            if (isActiveTab) {
+                                AutosaveRestoreTab(tab);
+                            }
                             UpdateTabDisplayName(tabIndex);
                         }
                         
@@ -461,6 +787,7 @@ BOOL RestoreSession(void)
         
         if (tabIndex >= 0) {
             openedAnyTab = TRUE;
+            openedTabs++;
         }
     }
     
@@ -474,6 +801,16 @@ BOOL RestoreSession(void)
     /* Update next tab ID to avoid duplicates */
     UpdateNextTabId();
     
+    /* The journal's last O record names every tab it held, so when some failed to open the
+     * journal is rewritten from the open tabs - otherwise they would be restored every time */
+    if (g_journalRestored) {
+        if (openedTabs == g_session.tabCount) {
+            MarkJournalRestored();
+        } else {
+            CompactJournal();
+        }
+    }
+    
     return openedAnyTab;
 }
 
@@ -486,12 +823,19 @@ SessionData* GetSessionData(void)
 /* Check if there's a saved session */
 BOOL HasSavedSession(void)
 {
-    return HasSessionInRegistry();
+    char journalPath[MAX_PATH];
+    GetJournalPath(journalPath);
+    return GetFileAttributes(journalPath) != INVALID_FILE_ATTRIBUTES || HasSessionInRegistry();
 }
 
 /* Clear saved session */
 void ClearSession(void)
 {
+    char journalPath[MAX_PATH];
+    GetJournalPath(journalPath);
+    DeleteFile(journalPath);
+    ResetJournalHashes();
+    g_journalRecords = 0;
     ClearSessionRegistry();
     
     memset(&g_session, 0, sizeof(SessionData));
@@ -9,7 +9,7 @@
 #include <windows.h>
 
 /* Maximum number of tabs to save in session */
-#define MAX_SESSION_TABS 100
+#define MAX_SESSION_TABS 256
 
 /* Session tab information */
 typedef struct {
@@ -53,6 +53,7 @@ void CleanupSession(void);
 
 /* Session management */
 BOOL SaveSession(void);
+BOOL UpdateSessionJournal(void);
 BOOL LoadSession(void);
 BOOL RestoreSession(void);
 
@@ -63,4 +64,7 @@ SessionData* GetSessionData(void);
 BOOL HasSavedSession(void);
 void ClearSession(void);
 
+/* Directory for the session journal and the snapshots of unsaved tabs */
+void GetSessionDir(char* dir);
+
 #endif /* SESSION_H */
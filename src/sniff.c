@@ -0,0 +1,631 @@
+/*
+ * Content sniffing implementation for Notepad+
+ * Recognises scripts, configuration files and source code without an extension
+ * from the first few KB of text, using tables generated from GitHub Linguist
+ */
+
+#include <string.h>
+#include "sniff.h"
+
+/* Lines at the start and end of the window searched for a modeline */
+#define SNIFF_MODELINE_LINES 5
+
+/* Lines at the start of the window looked at for structure */
+#define SNIFF_STRUCTURE_LINES 20
+
+/* Occurrences of one keyword that score - a word repeated in a log doesn't make it code */
+#define SNIFF_MAX_REPEATS 3
+
+/* Keyword statistics must find at least this many different keywords of the winning language... */
+#define SNIFF_MIN_KEYWORDS 4
+
+/* ...reach this score... */
+#define SNIFF_MIN_SCORE 1200
+
+/* ...and average at least this weight per word of text, so prose and logs stay plain text */
+#define SNIFF_MIN_DENSITY 20
+
+static BOOL IsBlank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+static BOOL IsWordStart(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static BOOL IsWordChar(char c)
+{
+    return IsWordStart(c) || (c >= '0' && c <= '9');
+}
+
+static char LowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+/* End of the line starting at p, before its line end */
+static const char* LineEnd(const char* p, const char* end)
+{
+    const char* eol = (const char*)memchr(p, '\n', (size_t)(end - p));
+    if (!eol) {
+        eol = end;
+    }
+    if (eol > p && eol[-1] == '\r') {
+        eol--;
+    }
+    return eol;
+}
+
+/* Start of the line after the one starting at p */
+static const char* NextLine(const char* p, const char* end)
+{
+    const char* eol = (const char*)memchr(p, '\n', (size_t)(end - p));
+    return eol ? eol + 1 : end;
+}
+
+static const char* SkipBlanks(const char* p, const char* end)
+{
+    while (p < end && IsBlank(*p)) {
+        p++;
+    }
+    return p;
+}
+
+static BOOL StartsWith(const char* p, const char* end, const char* prefix)
+{
+    size_t length = strlen(prefix);
+    return (size_t)(end - p) >= length && memcmp(p, prefix, length) == 0;
+}
+
+static BOOL StartsWithNoCase(const char* p, const char* end, const char* prefix)
+{
+    size_t length = strlen(prefix);
+    if ((size_t)(end - p) < length) {
+        return FALSE;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (LowerAscii(p[i]) != prefix[i]) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* Find text within [p, end) */
+static const char* FindText(const char* p, const char* end, const char* text)
+{
+    size_t length = strlen(text);
+    while ((size_t)(end - p) >= length) {
+        const char* found = (const char*)memchr(p, text[0], (size_t)(end - p) - length + 1);
+        if (!found) {
+            return NULL;
+        }
+        if (memcmp(found, text, length) == 0) {
+            return found;
+        }
+        p = found + 1;
+    }
+    return NULL;
+}
+
+/* Language of a name used by a modeline - a Linguist alias, an interpreter or an extension */
+static LanguageType LookupLanguageName(const char* name, size_t length)
+{
+    if (length == 0 || length >= 32) {
+        return LANG_NONE;
+    }
+    LanguageType lang = LookupLanguageKey(LANGUAGE_KEY_ALIAS, name, length);
+    if (lang == LANG_NONE) {
+        lang = LookupLanguageKey(LANGUAGE_KEY_INTERPRETER, name, length);
+    }
+    if (lang == LANG_NONE) {
+        char extension[33];
+        extension[0] = '.';
+        memcpy(extension + 1, name, length);
+        lang = LookupLanguageKey(LANGUAGE_KEY_EXTENSION, extension, length + 1);
+    }
+    return lang;
+}
+
+/* Detect language from a "#!" line at the start of text, e.g. "#!/usr/bin/env python3" */
+LanguageType DetectLanguageFromShebang(const char* text, size_t length)
+{
+    if (!text || length < 3 || text[0] != '#' || text[1] != '!') {
+        return LANG_NONE;
+    }
+
+    const char* p = text + 2;
+    const char* end = LineEnd(p, text + length);
+    const char* interpreter = NULL;
+    size_t interpreterLength = 0;
+    BOOL afterEnv = FALSE;
+
+    /* The program is the first word, or the first after "env" and its options */
+    while (p < end) {
+        p = SkipBlanks(p, end);
+        const char* word = p;
+        while (p < end && !IsBlank(*p)) {
+            p++;
+        }
+        if (p == word) {
+            break;
+        }
+        if (afterEnv && word[0] == '-') {
+            continue;
+        }
+        /* Base name of the program path */
+        interpreter = word;
+        for (const char* q = word; q < p; q++) {
+            if (*q == '/' || *q == '\\') {
+                interpreter = q + 1;
+            }
+        }
+        interpreterLength = (size_t)(p - interpreter);
+        if (!afterEnv && interpreterLength == 3 && strncmp(interpreter, "env", 3) == 0) {
+            afterEnv = TRUE;
+            interpreterLength = 0;
+            continue;
+        }
+        break;
+    }
+    if (interpreterLength == 0) {
+        return LANG_NONE;
+    }
+
+    LanguageType lang = LookupLanguageKey(LANGUAGE_KEY_INTERPRETER, interpreter, interpreterLength);
+    if (lang != LANG_NONE) {
+        return lang;
+    }
+
+    /* Versioned names like python3.12 fall back to the unversioned program */
+    while (interpreterLength > 1 &&
+           ((interpreter[interpreterLength - 1] >= '0' && interpreter[interpreterLength - 1] <= '9') ||
+            interpreter[interpreterLength - 1] == '.' || interpreter[interpreterLength - 1] == '-')) {
+        interpreterLength--;
+    }
+    return LookupLanguageKey(LANGUAGE_KEY_INTERPRETER, interpreter, interpreterLength);
+}
+
+/* Emacs: "-*- mode: python -*-", "-*- python -*-" or "-*- coding: utf-8; mode: sh -*-" */
+static LanguageType DetectEmacsModeline(const char* line, const char* end)
+{
+    const char* open = FindText(line, end, "-*-");
+    if (!open) {
+        return LANG_NONE;
+    }
+    const char* p = open + 3;
+    const char* close = FindText(p, end, "-*-");
+    if (!close) {
+        return LANG_NONE;
+    }
+
+    BOOL hasVariables = FindText(p, close, ":") != NULL;
+    while (p < close) {
+        p = SkipBlanks(p, close);
+        const char* variable = p;
+        while (p < close && *p != ';') {
+            p++;
+        }
+        const char* valueEnd = p;
+        if (p < close) {
+            p++;
+        }
+        const char* value = variable;
+        if (hasVariables) {
+            if (!StartsWithNoCase(variable, valueEnd, "mode:")) {
+                continue;
+            }
+            value = SkipBlanks(variable + 5, valueEnd);
+        }
+        while (valueEnd > value && IsBlank(valueEnd[-1])) {
+            valueEnd--;
+        }
+        return LookupLanguageName(value, (size_t)(valueEnd - value));
+    }
+    return LANG_NONE;
+}
+
+/* Vim: "vim: set ft=python:", "vi: filetype=sh" or "ex: syntax=perl" after a space or at the start */
+static LanguageType DetectVimModeline(const char* line, const char* end)
+{
+    static const char* const markers[] = { "vim:", "vi:", "ex:" };
+    static const char* const options[] = { "ft=", "filetype=", "syntax=", "syn=" };
+
+    for (size_t m = 0; m < sizeof(markers) / sizeof(markers[0]); m++) {
+        const char* found = line;
+        while ((found = FindText(found, end, markers[m])) != NULL) {
+            if (found == line || IsBlank(found[-1])) {
+                break;
+            }
+            found++;
+        }
+        if (!found) {
+            continue;
+        }
+        const char* p = found + strlen(markers[m]);
+        while (p < end) {
+            /* Options are separated by blanks or colons */
+            while (p < end && (IsBlank(*p) || *p == ':')) {
+                p++;
+            }
+            for (size_t o = 0; o < sizeof(options) / sizeof(options[0]); o++) {
+                if (StartsWith(p, end, options[o])) {
+                    const char* value = p + strlen(options[o]);
+                    const char* valueEnd = value;
+                    while (valueEnd < end && !IsBlank(*valueEnd) && *valueEnd != ':') {
+                        valueEnd++;
+                    }
+                    return LookupLanguageName(value, (size_t)(valueEnd - value));
+                }
+            }
+            while (p < end && !IsBlank(*p) && *p != ':') {
+                p++;
+            }
+        }
+    }
+    return LANG_NONE;
+}
+
+static LanguageType DetectModelineInLine(const char* line, const char* end)
+{
+    LanguageType lang = DetectEmacsModeline(line, end);
+    if (lang == LANG_NONE) {
+        lang = DetectVimModeline(line, end);
+    }
+    return lang;
+}
+
+/* Detect language from a vim or emacs modeline in the first or last lines of text */
+LanguageType DetectLanguageFromModeline(const char* text, size_t length)
+{
+    if (!text || length == 0) {
+        return LANG_NONE;
+    }
+    const char* end = text + length;
+
+    /* First lines */
+    const char* line = text;
+    for (int i = 0; i < SNIFF_MODELINE_LINES && line < end; i++) {
+        LanguageType lang = DetectModelineInLine(line, LineEnd(line, end));
+        if (lang != LANG_NONE) {
+            return lang;
+        }
+        line = NextLine(line, end);
+    }
+    if (line >= end) {
+        return LANG_NONE;
+    }
+
+    /* Last lines, walking back from the end without going over the first ones again */
+    const char* firstLinesEnd = line;
+    const char* lineEnd = end;
+    for (int i = 0; i < SNIFF_MODELINE_LINES && lineEnd > firstLinesEnd; i++) {
+        const char* start = lineEnd;
+        if (start > firstLinesEnd && start[-1] == '\n') {
+            start--;
+        }
+        while (start > firstLinesEnd && start[-1] != '\n') {
+            start--;
+        }
+        LanguageType lang = DetectModelineInLine(start, LineEnd(start, lineEnd));
+        if (lang != LANG_NONE) {
+            return lang;
+        }
+        lineEnd = start;
+    }
+    return LANG_NONE;
+}
+
+/* A YAML mapping line: optional "- ", then "key:" followed by a blank or the line end */
+static BOOL IsYamlKeyLine(const char* p, const char* end, BOOL* nested)
+{
+    const char* start = p;
+    p = SkipBlanks(p, end);
+    if (StartsWith(p, end, "- ")) {
+        p = SkipBlanks(p + 2, end);
+        *nested = TRUE;
+    }
+    if (p > start) {
+        *nested = TRUE;
+    }
+    if (p >= end || !IsWordStart(*p)) {
+        return FALSE;
+    }
+    while (p < end && (IsWordChar(*p) || *p == '-' || *p == '.')) {
+        p++;
+    }
+    if (p >= end || *p != ':') {
+        return FALSE;
+    }
+    p++;
+    if (p == end) {
+        /* A key without a value opens a nested mapping */
+        *nested = TRUE;
+        return TRUE;
+    }
+    return IsBlank(*p);
+}
+
+/* Whether a line ends like a statement or block of C-like code */
+static BOOL IsStatementEnd(const char* p, const char* end)
+{
+    while (end > p && IsBlank(end[-1])) {
+        end--;
+    }
+    return end > p && strchr(";{},", end[-1]) != NULL;
+}
+
+/* A Makefile rule: "target other: prerequisites" at the start of the line */
+static BOOL IsMakeRuleLine(const char* p, const char* end)
+{
+    if (p >= end || IsBlank(*p) || *p == '#') {
+        return FALSE;
+    }
+    /* "class Name : public Base {" is C++ */
+    if (IsStatementEnd(p, end)) {
+        return FALSE;
+    }
+    /* C++ access specifiers and labels look like rules without prerequisites */
+    static const char* const labels[] = { "public:", "private:", "protected:", "default:" };
+    for (size_t i = 0; i < sizeof(labels) / sizeof(labels[0]); i++) {
+        if (StartsWith(p, end, labels[i])) {
+            return FALSE;
+        }
+    }
+    BOOL severalWords = FALSE;
+    while (p < end && *p != ':') {
+        if (*p == '$' && p + 1 < end && p[1] == '(') {
+            /* Variable reference */
+            const char* close = (const char*)memchr(p, ')', (size_t)(end - p));
+            if (!close) {
+                return FALSE;
+            }
+            p = close + 1;
+            continue;
+        }
+        if (IsBlank(*p)) {
+            severalWords = TRUE;
+        } else if (!IsWordChar(*p) && !strchr(".%/-", *p)) {
+            return FALSE;
+        }
+        p++;
+    }
+    if (p >= end) {
+        return FALSE;
+    }
+    p++;
+    /* ":=" is an assignment, "Name::Member" a C++ scope, and "class Name:" or "if x:"
+     * a block in a script */
+    if (p < end && (*p == '=' || (*p == ':' && p + 1 < end && IsWordChar(p[1])))) {
+        return FALSE;
+    }
+    return !severalWords || SkipBlanks(p, end) < end;
+}
+
+/* Detect language from how the document is laid out */
+static LanguageType DetectLanguageFromStructure(const char* text, const char* end)
+{
+    const char* p = text;
+    while (p < end && (IsBlank(*p) || *p == '\r' || *p == '\n')) {
+        p++;
+    }
+    if (p >= end) {
+        return LANG_NONE;
+    }
+
+    /* Markup prologues - XHTML is an XML declaration followed by an HTML document */
+    if (StartsWith(p, end, "<?xml")) {
+        const char* q = FindText(p, end, "?>");
+        if (q) {
+            q += 2;
+            while (q < end && (IsBlank(*q) || *q == '\r' || *q == '\n')) {
+                q++;
+            }
+            if (StartsWithNoCase(q, end, "<!doctype html") || StartsWithNoCase(q, end, "<html")) {
+                return LANG_HTML;
+            }
+        }
+        return LANG_XML;
+    }
+    if (StartsWithNoCase(p, end, "<svg")) {
+        return LANG_XML;
+    }
+    if (StartsWithNoCase(p, end, "<!doctype html") || StartsWithNoCase(p, end, "<html")) {
+        return LANG_HTML;
+    }
+    if (StartsWithNoCase(p, end, "<!doctype")) {
+        return LANG_XML;
+    }
+
+    /* JSON object or array - "[1] text" and "[section]" are not */
+    if (*p == '{' || *p == '[') {
+        const char* q = p + 1;
+        while (q < end && (IsBlank(*q) || *q == '\r' || *q == '\n')) {
+            q++;
+        }
+        if (q < end && (*q == '"' || (*p == '{' && *q == '}') || (*p == '[' && strchr("{[]", *q)))) {
+            return LANG_JSON;
+        }
+    }
+
+    /* First line markers */
+    if (StartsWith(p, end, "%YAML") || (StartsWith(p, end, "---") && LineEnd(p, end) == SkipBlanks(p + 3, end))) {
+        return LANG_YAML;
+    }
+    if (StartsWith(p, end, "diff --git ") || StartsWith(p, end, "diff -u") || StartsWith(p, end, "Index: ")) {
+        return LANG_DIFF;
+    }
+    if (StartsWith(p, end, "--- ")) {
+        const char* next = NextLine(p, end);
+        if (StartsWith(next, end, "+++ ")) {
+            return LANG_DIFF;
+        }
+    }
+    if (StartsWith(p, end, "Windows Registry Editor Version") || StartsWith(p, end, "REGEDIT4")) {
+        return LANG_WINDOWS_REGISTRY;
+    }
+
+    /* Line based formats, skipping blank and comment lines */
+    int lines = 0;
+    int yamlLines = 0;
+    BOOL yamlNested = FALSE;
+    BOOL sawSection = FALSE;
+    BOOL afterRule = FALSE;
+    for (const char* line = p; line < end && lines < SNIFF_STRUCTURE_LINES; line = NextLine(line, end)) {
+        const char* lineEnd = LineEnd(line, end);
+        /* A recipe line after a rule is a Makefile. A tab-indented line ending like a
+         * statement is code after a label instead. */
+        if (afterRule && line < lineEnd && *line == '\t' && !IsStatementEnd(line, lineEnd)) {
+            return LANG_MAKEFILE;
+        }
+        const char* first = SkipBlanks(line, lineEnd);
+        if (first == lineEnd || *first == '#' || *first == ';') {
+            continue;
+        }
+        lines++;
+        afterRule = IsMakeRuleLine(line, lineEnd);
+
+        /* Dockerfile starts with its base image, possibly after build arguments */
+        if (lines == 1 && StartsWith(line, lineEnd, "FROM ")) {
+            return LANG_DOCKERFILE;
+        }
+
+        /* INI: a section followed by a key = value line */
+        if (*line == '[' && lineEnd[-1] == ']') {
+            sawSection = TRUE;
+        } else if (sawSection && memchr(line, '=', (size_t)(lineEnd - line))) {
+            return LANG_INI;
+        }
+
+        if (IsYamlKeyLine(line, lineEnd, &yamlNested)) {
+            yamlLines++;
+        }
+    }
+
+    /* YAML needs mostly key lines and some nesting, so "Error: ..." logs don't qualify */
+    if (yamlLines >= 3 && yamlNested && yamlLines * 5 >= lines * 4) {
+        return LANG_YAML;
+    }
+    return LANG_NONE;
+}
+
+/* Detect language from how often each language's keywords appear */
+static LanguageType DetectLanguageFromKeywords(const char* text, const char* end)
+{
+    int scores[LANG_COUNT];
+    unsigned char keywords[LANG_COUNT];
+    unsigned char repeats[SNIFF_TOKEN_TABLE_SIZE];
+    memset(scores, 0, sizeof(scores));
+    memset(keywords, 0, sizeof(keywords));
+    memset(repeats, 0, sizeof(repeats));
+
+    int words = 0;
+    const char* p = text;
+    while (p < end) {
+        /* Comments are prose, not code - skip C-style ones, but not a slash-star shell glob
+         * or the "://" of a URL */
+        if (*p == '/' && p + 2 < end && (p[1] == '*' || p[1] == '/') &&
+            (p == text || (!IsWordChar(p[-1]) && p[-1] != ':' && p[-1] != '.')) &&
+            (IsBlank(p[2]) || p[2] == '\r' || p[2] == '\n' || p[2] == p[1] || p[2] == '!' || p[2] == '<')) {
+            if (p[1] == '*') {
+                const char* close = FindText(p + 2, end, "*/");
+                p = close ? close + 2 : end;
+            } else {
+                p = LineEnd(p, end);
+            }
+            continue;
+        }
+        if (!IsWordChar(*p)) {
+            p++;
+            continue;
+        }
+        const char* word = p;
+        while (p < end && IsWordChar(*p)) {
+            p++;
+        }
+        if (!IsWordStart(*word)) {
+            /* A number */
+            continue;
+        }
+        /* Preprocessor words are scored with their '#' */
+        if (word > text && word[-1] == '#') {
+            word--;
+        }
+        words++;
+
+        const SniffToken* token = LookupSniffToken(word, (size_t)(p - word));
+        if (!token) {
+            continue;
+        }
+        size_t slot = (size_t)(token - g_sniffTokens);
+        if (repeats[slot] >= SNIFF_MAX_REPEATS) {
+            continue;
+        }
+        BOOL firstTime = repeats[slot] == 0;
+        repeats[slot]++;
+        for (unsigned int i = 0; i < token->scoreCount; i++) {
+            const SniffScore* score = &g_sniffScores[token->firstScore + i];
+            scores[score->language] += score->weight;
+            if (firstTime && keywords[score->language] < 255) {
+                keywords[score->language]++;
+            }
+        }
+    }
+
+    int best = LANG_NONE;
+    for (int lang = 1; lang < LANG_COUNT; lang++) {
+        if (scores[lang] > scores[best]) {
+            best = lang;
+        }
+    }
+    /* A language whose keywords are a superset of another's (C++ and C) only wins with
+     * keywords of its own - otherwise the runner-up matched just as many */
+    int runnerUp = LANG_NONE;
+    for (int lang = 1; lang < LANG_COUNT; lang++) {
+        if (lang != best && scores[lang] > scores[runnerUp]) {
+            runnerUp = lang;
+        }
+    }
+    if (runnerUp != LANG_NONE && keywords[runnerUp] >= keywords[best] && scores[runnerUp] * 4 >= scores[best] * 3) {
+        best = runnerUp;
+    }
+    if (best == LANG_NONE || keywords[best] < SNIFF_MIN_KEYWORDS || scores[best] < SNIFF_MIN_SCORE ||
+        scores[best] < words * SNIFF_MIN_DENSITY) {
+        return LANG_NONE;
+    }
+    return (LanguageType)best;
+}
+
+/* Detect language from the start of a document */
+LanguageType SniffLanguage(const char* text, size_t length)
+{
+    if (!text || length == 0) {
+        return LANG_NONE;
+    }
+    if (length > SNIFF_WINDOW) {
+        length = SNIFF_WINDOW;
+    }
+    /* Binary files are never highlighted */
+    if (memchr(text, '\0', length)) {
+        return LANG_NONE;
+    }
+    /* Skip a UTF-8 byte order mark */
+    if (length >= 3 && memcmp(text, "\xEF\xBB\xBF", 3) == 0) {
+        text += 3;
+        length -= 3;
+    }
+
+    LanguageType lang = DetectLanguageFromShebang(text, length);
+    if (lang == LANG_NONE) {
+        lang = DetectLanguageFromModeline(text, length);
+    }
+    if (lang == LANG_NONE) {
+        lang = DetectLanguageFromStructure(text, text + length);
+    }
+    if (lang == LANG_NONE) {
+        lang = DetectLanguageFromKeywords(text, text + length);
+    }
+    return lang;
+}
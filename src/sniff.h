@@ -0,0 +1,26 @@
+/*
+ * Content sniffing header for Notepad+
+ * Detects the language of files whose name doesn't give one
+ */
+
+#ifndef SNIFF_H
+#define SNIFF_H
+
+#include <windows.h>
+#include "lexer_mappings_generated.h"
+
+/* Bytes from the start of a document that sniffing looks at */
+#define SNIFF_WINDOW 4096
+
+/* Detect language from the start of a document: shebang line, editor modeline,
+ * document structure (XML, JSON, YAML...) and finally keyword statistics.
+ * Returns LANG_NONE for plain text. Looks at no more than SNIFF_WINDOW bytes. */
+LanguageType SniffLanguage(const char* text, size_t length);
+
+/* Detect language from the interpreter on a "#!" first line */
+LanguageType DetectLanguageFromShebang(const char* text, size_t length);
+
+/* Detect language from a vim or emacs modeline in the first or last lines of text */
+LanguageType DetectLanguageFromModeline(const char* text, size_t length);
+
+#endif /* SNIFF_H */
@@ -103,6 +103,11 @@ BOOL CloneCurrentTabToNewTab(void)
         return FALSE;
     }
     
+    /* A large file's document is only the page shown, which it replaces as the view moves */
+    if (sourceTab->largeFile) {
+        return FALSE;
+    }
+    
     /* Share the document handle if possible for true split view behavior in a new tab */
     /* This ensures changes in one are reflected in the other */
     void* pDoc = (void*)SendMessage(sourceTab->editorHandle, SCI_GETDOCPOINTER, 0, 0);
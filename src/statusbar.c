@@ -101,6 +101,7 @@ BOOL InitializeStatusBar(HWND parentWindow)
     SetStatusBarText(PANE_POSITION, "Pos 1");
     SetStatusBarText(PANE_LINEEND, "CRLF");
     SetStatusBarText(PANE_ZOOM, "100%");
+    SetStatusBarText(PANE_UNDO, "Undo 0 KB");
     
     /* Set default widths */
     SetStatusBarPaneWidth(PANE_CURSOR, 80);
@@ -109,6 +110,11 @@ BOOL InitializeStatusBar(HWND parentWindow)
     SetStatusBarPaneWidth(PANE_POSITION, 80);
     SetStatusBarPaneWidth(PANE_LINEEND, 60);
     SetStatusBarPaneWidth(PANE_ZOOM, 60);
+    SetStatusBarPaneWidth(PANE_UNDO, 90);
+    SetStatusBarPaneWidth(PANE_PROGRESS, 240);
+    
+    /* Progress pane only appears while a file is loading in the background */
+    g_statusBar.panes[PANE_PROGRESS].visible = FALSE;
     
 #if DEBUG_STATUSBAR_INIT
     SB_PROFILE_MARK("After SetStatusBarText/Width");
@@ -335,18 +341,23 @@ void CalculatePaneLayout(void)
 }
 
 /* Update cursor position */
-void UpdateCursorPosition(int line, int column)
+void UpdateCursorPosition(long long line, long long column)
 {
-    char text[32];
-    sprintf(text, "Ln %d, Col %d", line + 1, column + 1);
+    char text[64];
+    /* Lines of a large file are unknown until indexing reaches them */
+    if (line < 0) {
+        sprintf(text, "Ln ?, Col %lld", column + 1);
+    } else {
+        sprintf(text, "Ln %lld, Col %lld", line + 1, column + 1);
+    }
     SetStatusBarText(PANE_CURSOR, text);
 }
 
 /* Update file position */
-void UpdateFilePosition(long position)
+void UpdateFilePosition(long long position)
 {
     char text[32];
-    sprintf(text, "Pos %ld", position + 1);
+    sprintf(text, "Pos %lld", position + 1);
     SetStatusBarText(PANE_POSITION, text);
 }
 
@@ -379,6 +390,42 @@ void UpdateZoomLevel(int zoomLevel)
     SetStatusBarText(PANE_ZOOM, text);
 }
 
+/* Update undo history memory */
+void UpdateUndoMemory(size_t bytes, BOOL spillFailed)
+{
+    char text[64];
+    int length;
+    if (bytes >= 1024 * 1024) {
+        length = sprintf(text, "Undo %.1f MB", (double)bytes / (1024.0 * 1024.0));
+    } else {
+        length = sprintf(text, "Undo %u KB", (unsigned)((bytes + 1023) / 1024));
+    }
+    /* Undo text over the limit is held in memory when its temporary file can't be written */
+    if (spillFailed) {
+        strcpy(text + length, " (no temp file)");
+    }
+    SetStatusBarPaneWidth(PANE_UNDO, spillFailed ? 180 : 90);
+    SetStatusBarText(PANE_UNDO, text);
+}
+
+/* Show the progress pane with a fill of percent (0-100) */
+void ShowStatusBarProgress(const char* text, int percent)
+{
+    if (percent < 0) percent = 0;
+    if (percent > 100) percent = 100;
+    g_statusBar.progressPercent = percent;
+    
+    SetStatusBarText(PANE_PROGRESS, text);
+    SetStatusBarPaneVisible(PANE_PROGRESS, TRUE);
+}
+
+/* Hide the progress pane */
+void HideStatusBarProgress(void)
+{
+    g_statusBar.progressPercent = 0;
+    SetStatusBarPaneVisible(PANE_PROGRESS, FALSE);
+}
+
 /* Get encoding from Scintilla */
 const char* GetEncodingFromScintilla(int encoding)
 {
@@ -444,6 +491,19 @@ const char* GetFileTypeFromPath(const char* filePath)
     return langName;
 }
 
+/* Get file type for a document in an editor - files whose name gives no language are sniffed */
+const char* GetFileTypeForEditor(HWND editor, const char* filePath)
+{
+    if (!filePath || filePath[0] == '\0') {
+        return "Text";
+    }
+    const char* langName = GetLanguageName(DetectLanguageForEditor(editor, filePath));
+    if (!langName || langName[0] == '\0') {
+        return "Text";
+    }
+    return langName;
+}
+
 /* Legacy function - kept for compatibility but uses new system */
 const char* GetFileTypeFromExtension(const char* extension)
 {
@@ -451,12 +511,8 @@ const char* GetFileTypeFromExtension(const char* extension)
         return "Text";
     }
 
-    /* Create a dummy filename with the extension for detection */
-    char dummyFilename[256];
-    sprintf(dummyFilename, "dummy%s", extension);
-
-    /* Use the generated language detection system */
-    LanguageType lang = DetectLanguage(dummyFilename);
+    /* Look the extension up directly in the generated table */
+    LanguageType lang = LookupLanguageKey(LANGUAGE_KEY_EXTENSION, extension, strlen(extension));
     return GetLanguageName(lang);
 }
 
@@ -563,6 +619,9 @@ LRESULT CALLBACK StatusBarWndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lP
                     ShowEncodingContextMenu(hwnd, x, y);
                 } else if (pane == PANE_LINEEND) {
                     ShowLineEndingContextMenu(hwnd, x, y);
+                } else if (pane == PANE_PROGRESS) {
+                    /* Clicking the progress pane cancels the load it shows */
+                    PostMessage(GetParent(hwnd), WM_COMMAND, ID_FILE_CANCELLOAD, 0);
                 }
                 return 0;
             }
@@ -642,6 +701,20 @@ void DrawStatusBarPane(HDC hdc, StatusBarPaneInfo* pane)
     SetBkMode(hdc, TRANSPARENT);
     HFONT oldFont = SelectObject(hdc, GetStatusBar()->normalFont);
     
+    /* Progress pane: thin bar under the text, filled up to the current percentage */
+    if (pane->type == PANE_PROGRESS) {
+        int barTop = pane->y + STATUSBAR_HEIGHT - 7;
+        int barWidth = pane->width - 12;
+        HBRUSH trackBrush = CreateSolidBrush(colors->statusbarBorder);
+        HBRUSH fillBrush = CreateSolidBrush(colors->statusbarFg);
+        RECT trackRect = {pane->x + 6, barTop, pane->x + 6 + barWidth, barTop + 3};
+        RECT fillRect = {pane->x + 6, barTop, pane->x + 6 + barWidth * GetStatusBar()->progressPercent / 100, barTop + 3};
+        FillRect(hdc, &trackRect, trackBrush);
+        FillRect(hdc, &fillRect, fillBrush);
+        DeleteObject(trackBrush);
+        DeleteObject(fillBrush);
+    }
+    
     /* Draw pane text with proper vertical centering */
     RECT textRect = {pane->x + 6, pane->y, pane->x + pane->width - 6, pane->y + STATUSBAR_HEIGHT - 4};
     DrawText(hdc, pane->text, -1, &textRect, DT_SINGLELINE | DT_VCENTER | DT_LEFT);
@@ -23,6 +23,8 @@ typedef enum {
     PANE_POSITION,      /* Character position in file */
     PANE_LINEEND,       /* Line ending type (CRLF, LF, CR) */
     PANE_ZOOM,          /* Zoom level */
+    PANE_UNDO,          /* Memory used by the undo history */
+    PANE_PROGRESS,      /* Background file load progress (hidden when idle) */
     PANE_COUNT          /* Number of panes */
 } StatusBarPane;
 
@@ -44,6 +46,7 @@ typedef struct {
     HBRUSH backgroundBrush;     /* Background brush */
     HPEN borderPen;             /* Border pen */
     BOOL isVisible;             /* Whether status bar is visible */
+    int progressPercent;        /* Fill of the progress pane (0-100) */
 } StatusBar;
 
 /* Status bar initialization and cleanup */
@@ -73,18 +76,24 @@ void DrawStatusBar(HDC hdc, RECT* rect);
 void DrawStatusBarPane(HDC hdc, StatusBarPaneInfo* pane);
 
 /* Information update functions */
-void UpdateCursorPosition(int line, int column);
-void UpdateFilePosition(long position);
+void UpdateCursorPosition(long long line, long long column);  /* line < 0 when unknown */
+void UpdateFilePosition(long long position);
 void UpdateFileEncoding(const char* encoding);
 void UpdateFileType(const char* fileType);
 void UpdateLineEndType(const char* lineEnd);
 void UpdateZoomLevel(int zoomLevel);
+void UpdateUndoMemory(size_t bytes, BOOL spillFailed);
+
+/* Progress pane - clicking it sends ID_FILE_CANCELLOAD to the parent window */
+void ShowStatusBarProgress(const char* text, int percent);
+void HideStatusBarProgress(void);
 
 /* Helper functions */
 const char* GetEncodingFromScintilla(int encoding);
 const char* GetLineEndTypeFromScintilla(int lineEndMode);
 const char* GetFileTypeFromExtension(const char* extension);
 const char* GetFileTypeFromPath(const char* filePath);
+const char* GetFileTypeForEditor(HWND editor, const char* filePath);
 void CalculatePaneLayout(void);
 
 /* Status bar window procedure (for custom control) */
@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "syntax.h"
+#include "sniff.h"
 #include "Scintilla.h"
 #include "SciLexer.h"
 #include "Lexilla.h"
@@ -82,7 +83,7 @@ void CleanupSyntax(void)
     /* Nothing to cleanup for static linking */
 }
 
-/* Detect language from file extension using generated mappings */
+/* Detect language from the file name and extension using the generated perfect hash */
 LanguageType DetectLanguage(const char* filePath)
 {
     /* Validate input */
@@ -90,56 +91,52 @@ LanguageType DetectLanguage(const char* filePath)
         return LANG_NONE;
     }
 
-    /* Find the last dot in the filename */
-    const char* ext = strrchr(filePath, '.');
-    if (!ext) {
+    /* Only the file name is looked at - a directory may contain dots too */
+    const char* name = filePath;
+    for (const char* p = filePath; *p; p++) {
+        if (*p == '\\' || *p == '/') {
+            name = p + 1;
+        }
+    }
+    size_t nameLength = strlen(name);
+    if (nameLength == 0) {
         return LANG_NONE;
     }
 
-    ext++; /* Skip the dot */
-    
-    /* Validate extension is not empty (filename ending with dot) */
-    if (ext[0] == '\0') {
-        return LANG_NONE;
+    /* Whole file names such as Makefile or Dockerfile come first */
+    LanguageType lang = LookupLanguageKey(LANGUAGE_KEY_FILENAME, name, nameLength);
+    if (lang != LANG_NONE) {
+        return lang;
     }
 
-    /* Convert to lowercase for comparison - with bounds checking */
-    char extLower[32] = {0};  /* Initialize to zero */
-    int i;
-    for (i = 0; ext[i] && i < 31; i++) {
-        char c = ext[i];
-        /* Only convert A-Z to lowercase */
-        if (c >= 'A' && c <= 'Z') {
-            extLower[i] = c + ('a' - 'A');
-        } else {
-            extLower[i] = c;
+    /* Then extensions, longest first so .app.src is found before .src */
+    for (const char* dot = strchr(name, '.'); dot; dot = strchr(dot + 1, '.')) {
+        lang = LookupLanguageKey(LANGUAGE_KEY_EXTENSION, dot, nameLength - (size_t)(dot - name));
+        if (lang != LANG_NONE) {
+            return lang;
         }
     }
-    extLower[i] = '\0';
 
-    /* Add dot prefix for lookup - properly initialized */
-    char extWithDot[64] = {0};  /* Initialize entire buffer to zero */
-    extWithDot[0] = '.';
-    
-    /* Safe copy of extension */
-    size_t srcLen = strlen(extLower);
-    if (srcLen > 0 && srcLen < 62) {
-        memcpy(extWithDot + 1, extLower, srcLen);
-        /* extWithDot is already null-terminated due to buffer initialization */
-    }
+    return LANG_NONE;
+}
 
-    /* Lookup in generated extension mappings with bounds check */
-    for (size_t i = 0; i < EXTENSION_MAPPING_COUNT && i < 500; i++) {
-        /* Validate entry before accessing */
-        if (!g_extensionMappings[i].extension) {
-            continue;
+/* Detect language from the file name, or for a name that doesn't give one from the
+ * start of the document already loaded in the editor */
+LanguageType DetectLanguageForEditor(HWND editor, const char* filePath)
+{
+    LanguageType lang = DetectLanguage(filePath);
+    if (lang == LANG_NONE && editor) {
+        /* Only the start of the document needs to be contiguous */
+        size_t length = (size_t)SendMessage(editor, SCI_GETLENGTH, 0, 0);
+        if (length > SNIFF_WINDOW) {
+            length = SNIFF_WINDOW;
         }
-        if (strcmp(extWithDot, g_extensionMappings[i].extension) == 0) {
-            return g_extensionMappings[i].language;
+        const char* text = (const char*)SendMessage(editor, SCI_GETRANGEPOINTER, 0, (LPARAM)length);
+        if (text) {
+            lang = SniffLanguage(text, length);
         }
     }
-
-    return LANG_NONE;
+    return lang;
 }
 
 /* Apply syntax colors based on current theme */
@@ -600,9 +597,8 @@ void ApplySyntaxHighlighting(HWND editor, LanguageType language)
     }
 }
 
-/* Apply syntax highlighting based on file path */
+/* Apply syntax highlighting based on file path, or on the content of a file without a known name */
 void ApplySyntaxHighlightingForFile(HWND editor, const char* filePath)
 {
-    LanguageType lang = DetectLanguage(filePath);
-    ApplySyntaxHighlighting(editor, lang);
+    ApplySyntaxHighlighting(editor, DetectLanguageForEditor(editor, filePath));
 }
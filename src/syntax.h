@@ -18,9 +18,12 @@ BOOL InitializeSyntax(void);
 /* Cleanup syntax highlighting system */
 void CleanupSyntax(void);
 
-/* Detect language from file extension */
+/* Detect language from file name or extension */
 LanguageType DetectLanguage(const char* filePath);
 
+/* Detect language from file name, falling back to sniffing the editor's content */
+LanguageType DetectLanguageForEditor(HWND editor, const char* filePath);
+
 /* Apply syntax highlighting to an editor window */
 void ApplySyntaxHighlighting(HWND editor, LanguageType language);
 
@@ -16,6 +16,11 @@
 #include "syntax.h"
 #include "themes.h"
 #include "fileops.h"
+#include "autosave.h"
+#include "wordindex.h"
+#include "occurrences.h"
+#include "findresults.h"
+#include "largefile.h"
 #include "statusbar.h"
 #include "toolbar.h"
 #include "syntax.h"
@@ -55,6 +60,13 @@ static BOOL g_deferExpensiveOperations = TRUE;
 /* Pre-warmed Scintilla editor for fast session restore */
 static HWND g_prewarmedEditor = NULL;
 
+/* Loads of closed tabs whose workers haven't posted WM_FILELOAD_DONE yet */
+static FileLoadJob** g_abandonedLoads = NULL;
+static int g_abandonedLoadCount = 0;
+static int g_abandonedLoadCapacity = 0;
+
+static BOOL LoadFileIntoTab(TabInfo* tab, const char* filePath, int encoding, BOOL allowBackground);
+
 /* Set deferred operations mode */
 void SetDeferredLoadingMode(BOOL defer)
 {
@@ -224,6 +236,8 @@ int AddTabFast(const char* filePath, BOOL isNewFile)
     
     /* Set minimal editor properties */
     scintillaFunc(scintillaPtr, SCI_SETCODEPAGE, CP_UTF8, 0);
+    scintillaFunc(scintillaPtr, SCI_SETSEARCHTHREADS, EDITOR_SEARCH_THREADS, 0);
+    scintillaFunc(scintillaPtr, SCI_SETUNDOMEMORYLIMIT, EDITOR_UNDO_MEMORY_LIMIT, 0);
     scintillaFunc(scintillaPtr, SCI_STYLESETFONT, STYLE_DEFAULT, (sptr_t)"Consolas");
     scintillaFunc(scintillaPtr, SCI_STYLESETSIZE, STYLE_DEFAULT, 9);
     scintillaFunc(scintillaPtr, SCI_STYLECLEARALL, 0, 0);
@@ -263,74 +277,17 @@ int AddTabFast(const char* filePath, BOOL isNewFile)
     
     /* Load file content if not a new file */
     if (!isNewFile && filePath) {
-        TABS_PROFILE_MARK("AddTabFast: before file open");
-        FILE* file = fopen(filePath, "rb");
-        if (file) {
-            /* Get file size safely */
-            if (fseek(file, 0, SEEK_END) == 0) {
-                long fileSize = ftell(file);
-                if (fileSize >= 0 && fseek(file, 0, SEEK_SET) == 0) {
-                    /* Allocate buffer - handle empty files (size 0) */
-                    char* buffer = (char*)malloc(fileSize + 1);
-                    if (buffer) {
-                    if (fileSize > 0) {
-                        size_t bytesRead = fread(buffer, 1, fileSize, file);
-                        buffer[bytesRead] = '\0';
-                        
-                        /* Detect and convert encoding (like AddTabWithFile does) */
-                        BOOL hasBOM;
-                        int encoding = DetectFileEncodingFromData(buffer, bytesRead, &hasBOM);
-                        
-                        /* Explicit BOM checks for accurate detection */
-                        if (bytesRead >= 2 && (unsigned char)buffer[0] == 0xFF && (unsigned char)buffer[1] == 0xFE) {
-                            encoding = ENCODING_UTF16_LE;
-                        } else if (bytesRead >= 2 && (unsigned char)buffer[0] == 0xFE && (unsigned char)buffer[1] == 0xFF) {
-                            encoding = ENCODING_UTF16_BE;
-                        } else if (bytesRead >= 3 && (unsigned char)buffer[0] == 0xEF && 
-                                  (unsigned char)buffer[1] == 0xBB && (unsigned char)buffer[2] == 0xBF) {
-                            encoding = ENCODING_UTF8_BOM;
-                        }
-                        
-                        /* Convert to UTF-8 if needed */
-                        char* utf8Data = buffer;
-                        if (encoding != ENCODING_UTF8) {
-                            size_t utf8Size;
-                            utf8Data = ConvertToUTF8(buffer, bytesRead, encoding, &utf8Size);
-                            if (!utf8Data) {
-                                utf8Data = buffer; /* Fallback to raw buffer if conversion fails */
-                            }
-                        }
-                        
-                        TABS_PROFILE_MARK("AddTabFast: after file read");
-                        scintillaFunc(scintillaPtr, SCI_SETTEXT, 0, (sptr_t)utf8Data);
-                        
-                        /* Free converted data if it was different from buffer */
-                        if (utf8Data != buffer) {
-                            free(utf8Data);
-                        }
-                    } else {
-                        /* Empty file - just set null terminator */
-                        buffer[0] = '\0';
-                        TABS_PROFILE_MARK("AddTabFast: after file read");
-                        scintillaFunc(scintillaPtr, SCI_SETTEXT, 0, (sptr_t)buffer);
-                    }
-                        TABS_PROFILE_MARK("AddTabFast: after SCI_SETTEXT");
-                        free(buffer);
-                        TABS_PROFILE_MARK("AddTabFast: after free buffer");
-                    }
-                }
-            }
-            fclose(file);
-            TABS_PROFILE_MARK("AddTabFast: after fclose");
-        }
+        TABS_PROFILE_MARK("AddTabFast: before LoadFileIntoEditor");
+        LoadFileIntoTab(tab, filePath, FILELOAD_DETECT_ENCODING, FALSE);
+        TABS_PROFILE_MARK("AddTabFast: after LoadFileIntoEditor");
         /* For unsaved files (temp files), don't set save point - keep as modified */
         /* The tab's isModified flag will be set later in RestoreSession */
         TABS_PROFILE_MARK("AddTabFast: after SETSAVEPOINT");
         
         /* Update file type in status bar using new language detection */
-        TABS_PROFILE_MARK("AddTabFast: before GetFileTypeFromPath");
-        const char* fileType = GetFileTypeFromPath(filePath);
-        TABS_PROFILE_MARK("AddTabFast: after GetFileTypeFromPath");
+        TABS_PROFILE_MARK("AddTabFast: before GetFileTypeForEditor");
+        const char* fileType = GetFileTypeForEditor(tab->editorHandle, filePath);
+        TABS_PROFILE_MARK("AddTabFast: after GetFileTypeForEditor");
         UpdateFileType(fileType);
         TABS_PROFILE_MARK("AddTabFast: after UpdateFileType");
         
@@ -344,17 +301,20 @@ int AddTabFast(const char* filePath, BOOL isNewFile)
     
     /* FAST PATH: Skip theme application - will be applied later via PolishEditor() */
     
-    /* Enable change history FIRST - this clears undo buffer and enables tracking */
-    if (tab->changeHistoryEnabled) {
-        EnableChangeHistory(tab->editorHandle, TRUE);
+    /* A large file's pages are read-only and keep no history */
+    if (!tab->largeFile) {
+        /* Enable change history FIRST - this clears undo buffer and enables tracking */
+        if (tab->changeHistoryEnabled) {
+            EnableChangeHistory(tab->editorHandle, TRUE);
+        }
+        
+        /* Set save point AFTER enabling change history
+         * This must be AFTER EnableChangeHistory because that function calls
+         * SCI_EMPTYUNDOBUFFER which would reset any prior save point.
+         * The save point tells change history what the "clean" baseline is. */
+        scintillaFunc(scintillaPtr, SCI_SETSAVEPOINT, 0, 0);
     }
     
-    /* Set save point AFTER enabling change history
-     * This must be AFTER EnableChangeHistory because that function calls
-     * SCI_EMPTYUNDOBUFFER which would reset any prior save point.
-     * The save point tells change history what the "clean" baseline is. */
-    scintillaFunc(scintillaPtr, SCI_SETSAVEPOINT, 0, 0);
-    
     /* Mark as loaded */
     tab->isLoaded = TRUE;
     
@@ -487,6 +447,8 @@ int AddTabFastFromTempFile(const char* filePath, const char* tempFilePath)
     
     /* Set minimal editor properties */
     scintillaFunc(scintillaPtr, SCI_SETCODEPAGE, CP_UTF8, 0);
+    scintillaFunc(scintillaPtr, SCI_SETSEARCHTHREADS, EDITOR_SEARCH_THREADS, 0);
+    scintillaFunc(scintillaPtr, SCI_SETUNDOMEMORYLIMIT, EDITOR_UNDO_MEMORY_LIMIT, 0);
     scintillaFunc(scintillaPtr, SCI_STYLESETFONT, STYLE_DEFAULT, (sptr_t)"Consolas");
     scintillaFunc(scintillaPtr, SCI_STYLESETSIZE, STYLE_DEFAULT, 9);
     scintillaFunc(scintillaPtr, SCI_STYLECLEARALL, 0, 0);
@@ -525,41 +487,18 @@ int AddTabFastFromTempFile(const char* filePath, const char* tempFilePath)
     TABS_PROFILE_MARK("AddTabFastFromTempFile: after editor setup");
     
     /* Load content from temp file (contains unsaved modifications) */
-    TABS_PROFILE_MARK("AddTabFastFromTempFile: before file open");
-    FILE* file = fopen(tempFilePath, "rb");
-    if (file) {
-        if (fseek(file, 0, SEEK_END) == 0) {
-            long fileSize = ftell(file);
-            if (fileSize >= 0 && fseek(file, 0, SEEK_SET) == 0) {
-                char* buffer = (char*)malloc(fileSize + 1);
-                if (buffer) {
-                    if (fileSize > 0) {
-                        size_t bytesRead = fread(buffer, 1, fileSize, file);
-                        buffer[bytesRead] = '\0';
-                        
-                        /* Temp files are always saved as UTF-8, so no encoding conversion needed */
-                        TABS_PROFILE_MARK("AddTabFastFromTempFile: after file read");
-                        scintillaFunc(scintillaPtr, SCI_SETTEXT, 0, (sptr_t)buffer);
-                    } else {
-                        buffer[0] = '\0';
-                        scintillaFunc(scintillaPtr, SCI_SETTEXT, 0, (sptr_t)buffer);
-                    }
-                    TABS_PROFILE_MARK("AddTabFastFromTempFile: after SCI_SETTEXT");
-                    free(buffer);
-                }
-            }
-        }
-        fclose(file);
-        TABS_PROFILE_MARK("AddTabFastFromTempFile: after fclose");
-    }
+    /* Temp files are always saved as UTF-8, so no encoding detection or conversion is needed */
+    TABS_PROFILE_MARK("AddTabFastFromTempFile: before LoadFileIntoEditor");
+    LoadFileIntoEditor(tab->editorHandle, tempFilePath, ENCODING_UTF8, NULL);
+    TABS_PROFILE_MARK("AddTabFastFromTempFile: after LoadFileIntoEditor");
     
     /* Do NOT set save point - we want this to remain modified */
     /* The original file on disk is the "saved" state, and we have unsaved changes */
     
     /* Update file type in status bar using original file path for language detection */
-    TABS_PROFILE_MARK("AddTabFastFromTempFile: before GetFileTypeFromPath");
-    const char* fileType = GetFileTypeFromPath(filePath);
-    TABS_PROFILE_MARK("AddTabFastFromTempFile: after GetFileTypeFromPath");
+    TABS_PROFILE_MARK("AddTabFastFromTempFile: before GetFileTypeForEditor");
+    const char* fileType = GetFileTypeForEditor(tab->editorHandle, filePath);
+    TABS_PROFILE_MARK("AddTabFastFromTempFile: after GetFileTypeForEditor");
     UpdateFileType(fileType);
     TABS_PROFILE_MARK("AddTabFastFromTempFile: after UpdateFileType");
     
@@ -640,6 +579,8 @@ static void InvalidateAllTabs(void);
 static void EnsureTabVisible(int index);
 static void AdjustScrollButtons(void);
 static void DrawPinIndicator(HDC hdc, int x, int y, BOOL isActiveTab);
+static BOOL LoadTabContentEx(int index, BOOL allowBackground);
+static void UpdateLoadProgressDisplay(void);
 
 /* Initialize tab system */
 BOOL InitializeTabs(HWND parentWindow)
@@ -787,6 +728,7 @@ void CleanupTabs(void)
     /* Close all tabs and cleanup */
     if (g_tabControl.tabs) {
         CloseAllTabs();
+        FinishAllTabLoads();
         free(g_tabControl.tabs);
         g_tabControl.tabs = NULL;
     }
@@ -914,6 +856,8 @@ int AddTabWithFile(const char* filePath, BOOL isNewFile)
     
     /* Set basic editor properties */
     scintillaFunc(scintillaPtr, SCI_SETCODEPAGE, CP_UTF8, 0);
+    scintillaFunc(scintillaPtr, SCI_SETSEARCHTHREADS, EDITOR_SEARCH_THREADS, 0);
+    scintillaFunc(scintillaPtr, SCI_SETUNDOMEMORYLIMIT, EDITOR_UNDO_MEMORY_LIMIT, 0);
     scintillaFunc(scintillaPtr, SCI_STYLESETFONT, STYLE_DEFAULT, (sptr_t)"Consolas");
     scintillaFunc(scintillaPtr, SCI_STYLESETSIZE, STYLE_DEFAULT, 10);
     scintillaFunc(scintillaPtr, SCI_STYLECLEARALL, 0, 0);
@@ -962,50 +906,10 @@ int AddTabWithFile(const char* filePath, BOOL isNewFile)
     
     /* If not a new file, load the file content with encoding conversion */
     if (!isNewFile && filePath) {
-        FILE* file = fopen(filePath, "rb");
-        if (file) {
-            fseek(file, 0, SEEK_END);
-            long fileSize = ftell(file);
-            fseek(file, 0, SEEK_SET);
-            
-            char* buffer = (char*)malloc(fileSize + 1);
-            if (buffer) {
-                size_t bytesRead = fread(buffer, 1, fileSize, file);
-                buffer[bytesRead] = '\0';
-                
-                /* Detect and convert encoding */
-                BOOL hasBOM;
-                int encoding = DetectFileEncodingFromData(buffer, bytesRead, &hasBOM);
-                
-                /* Explicit BOM checks */
-                if (bytesRead >= 2 && (unsigned char)buffer[0] == 0xFF && (unsigned char)buffer[1] == 0xFE) {
-                    encoding = ENCODING_UTF16_LE;
-                } else if (bytesRead >= 2 && (unsigned char)buffer[0] == 0xFE && (unsigned char)buffer[1] == 0xFF) {
-                    encoding = ENCODING_UTF16_BE;
-                } else if (bytesRead >= 3 && (unsigned char)buffer[0] == 0xEF && 
-                          (unsigned char)buffer[1] == 0xBB && (unsigned char)buffer[2] == 0xBF) {
-                    encoding = ENCODING_UTF8_BOM;
-                }
-                
-                if (encoding != ENCODING_UTF8) {
-                    size_t utf8Size;
-                    char* utf8Data = ConvertToUTF8(buffer, bytesRead, encoding, &utf8Size);
-                    if (utf8Data) {
-                        scintillaFunc(scintillaPtr, SCI_SETTEXT, 0, (sptr_t)utf8Data);
-                        free(utf8Data);
-                    } else {
-                        scintillaFunc(scintillaPtr, SCI_SETTEXT, 0, (sptr_t)buffer);
-                    }
-                } else {
-                    scintillaFunc(scintillaPtr, SCI_SETTEXT, 0, (sptr_t)buffer);
-                }
-                free(buffer);
-            }
-            fclose(file);
-        }
+        LoadFileIntoTab(tab, filePath, FILELOAD_DETECT_ENCODING, TRUE);
         
         /* Update file type in status bar using new language detection */
-        UpdateFileType(GetFileTypeFromPath(filePath));
+        UpdateFileType(GetFileTypeForEditor(tab->editorHandle, filePath));
         
         /* Add to recent files list */
         AddRecentFile(filePath);
@@ -1014,22 +918,26 @@ int AddTabWithFile(const char* filePath, BOOL isNewFile)
         UpdateFileType("Text");
     }
     
-    /* Enable change history FIRST - this clears undo buffer and enables tracking */
-    if (tab->changeHistoryEnabled) {
-        EnableChangeHistory(tab->editorHandle, TRUE);
+    /* A background load finishes these steps in CompleteTabLoad once the document is attached.
+     * A large file's pages are read-only and keep no history. */
+    if (!tab->loadJob && !tab->largeFile) {
+        /* Enable change history FIRST - this clears undo buffer and enables tracking */
+        if (tab->changeHistoryEnabled) {
+            EnableChangeHistory(tab->editorHandle, TRUE);
+        }
+        
+        /* Set save point AFTER enabling change history
+         * This must be AFTER EnableChangeHistory because that function calls
+         * SCI_EMPTYUNDOBUFFER which would reset any prior save point.
+         * The save point tells change history what the "clean" baseline is. */
+        scintillaFunc(scintillaPtr, SCI_SETSAVEPOINT, 0, 0);
     }
     
-    /* Set save point AFTER enabling change history
-     * This must be AFTER EnableChangeHistory because that function calls
-     * SCI_EMPTYUNDOBUFFER which would reset any prior save point.
-     * The save point tells change history what the "clean" baseline is. */
-    scintillaFunc(scintillaPtr, SCI_SETSAVEPOINT, 0, 0);
-    
     /* Apply current theme to the editor FIRST (this clears styles) */
     ApplyThemeToEditor(tab->editorHandle);
     
     /* Apply syntax highlighting AFTER theme (so it doesn't get overwritten) */
-    if (!isNewFile && filePath) {
+    if (!isNewFile && filePath && !tab->loadJob && !tab->largeFile) {
         ApplySyntaxHighlightingForFile(tab->editorHandle, filePath);
     }
     
@@ -1122,13 +1030,29 @@ int AddPlaceholderTab(const char* filePath, BOOL isNewFile, BOOL isPinned)
     return index;
 }
 
-/* Load content for a placeholder tab - creates editor and loads file content */
+/* Load content for a placeholder tab - creates editor and loads file content.
+ * Always loads synchronously so callers such as SaveSession see the content.
+ * Returns FALSE while a background load started by SelectTab is still running. */
 BOOL LoadTabContent(int index)
 {
     if (index < 0 || index >= g_tabControl.tabCount) {
         return FALSE;
     }
     
+    if (g_tabControl.tabs[index].loadJob) {
+        return FALSE;
+    }
+    
+    return LoadTabContentEx(index, FALSE);
+}
+
+/* Load content for a placeholder tab - large files may be loaded in the background */
+static BOOL LoadTabContentEx(int index, BOOL allowBackground)
+{
+    if (index < 0 || index >= g_tabControl.tabCount) {
+        return FALSE;
+    }
+    
     TabInfo* tab = &g_tabControl.tabs[index];
     
     /* Already loaded */
@@ -1166,6 +1090,8 @@ BOOL LoadTabContent(int index)
     
     /* Set basic editor properties */
     scintillaFunc(scintillaPtr, SCI_SETCODEPAGE, CP_UTF8, 0);
+    scintillaFunc(scintillaPtr, SCI_SETSEARCHTHREADS, EDITOR_SEARCH_THREADS, 0);
+    scintillaFunc(scintillaPtr, SCI_SETUNDOMEMORYLIMIT, EDITOR_UNDO_MEMORY_LIMIT, 0);
     scintillaFunc(scintillaPtr, SCI_STYLESETFONT, STYLE_DEFAULT, (sptr_t)"Consolas");
     scintillaFunc(scintillaPtr, SCI_STYLESETSIZE, STYLE_DEFAULT, 10);
     scintillaFunc(scintillaPtr, SCI_STYLECLEARALL, 0, 0);
@@ -1216,54 +1142,33 @@ BOOL LoadTabContent(int index)
     }
     
     if (!isNewFile || loadFromTempFile) {
-        /* Load file content with encoding conversion */
-        FILE* file = fopen(fileToLoad, "rb");
-        if (file) {
-            fseek(file, 0, SEEK_END);
-            long fileSize = ftell(file);
-            fseek(file, 0, SEEK_SET);
-            
-            char* buffer = (char*)malloc(fileSize + 1);
-            if (buffer) {
-                size_t bytesRead = fread(buffer, 1, fileSize, file);
-                buffer[bytesRead] = '\0';
-                
-                /* Detect and convert encoding */
-                BOOL hasBOM;
-                int encoding = DetectFileEncodingFromData(buffer, bytesRead, &hasBOM);
-                
-                /* Explicit BOM checks */
-                if (bytesRead >= 2 && (unsigned char)buffer[0] == 0xFF && (unsigned char)buffer[1] == 0xFE) {
-                    encoding = ENCODING_UTF16_LE;
-                } else if (bytesRead >= 2 && (unsigned char)buffer[0] == 0xFE && (unsigned char)buffer[1] == 0xFF) {
-                    encoding = ENCODING_UTF16_BE;
-                } else if (bytesRead >= 3 && (unsigned char)buffer[0] == 0xEF && 
-                          (unsigned char)buffer[1] == 0xBB && (unsigned char)buffer[2] == 0xBF) {
-                    encoding = ENCODING_UTF8_BOM;
-                }
-                
-                if (encoding != ENCODING_UTF8) {
-                    size_t utf8Size;
-                    char* utf8Data = ConvertToUTF8(buffer, bytesRead, encoding, &utf8Size);
-                    if (utf8Data) {
-                        scintillaFunc(scintillaPtr, SCI_SETTEXT, 0, (sptr_t)utf8Data);
-                        free(utf8Data);
-                    } else {
-                        scintillaFunc(scintillaPtr, SCI_SETTEXT, 0, (sptr_t)buffer);
-                    }
-                } else {
-                    scintillaFunc(scintillaPtr, SCI_SETTEXT, 0, (sptr_t)buffer);
-                }
-                free(buffer);
-            }
-            fclose(file);
-        }
+        /* Load file content with encoding conversion - temp files are always UTF-8.
+         * Temp files hold unsaved edits and are always loaded synchronously. */
+        LoadFileIntoTab(tab, fileToLoad, loadFromTempFile ? ENCODING_UTF8 : FILELOAD_DETECT_ENCODING,
+                        allowBackground && !loadFromTempFile);
         
         /* Note: Save point is set AFTER enabling change history below */
     } else {
         /* Note: Save point is set AFTER enabling change history below */
     }
     
+    /* Background load - CompleteTabLoad finishes the tab once the document is attached.
+     * A large file is shown already and has no history or highlighting to set up. */
+    if (tab->loadJob || tab->largeFile) {
+        ApplyThemeToEditor(tab->editorHandle);
+        UpdateFileType(GetFileTypeFromPath(tab->filePath));
+        scintillaFunc(scintillaPtr, SCI_SETZOOM, tab->sessionZoomLevel, 0);
+        tab->isLoaded = TRUE;
+        ShowWindow(tab->editorHandle, SW_HIDE);
+        HandleWindowResize(0, 0);
+        return TRUE;
+    }
+    
+    /* Edits autosaved after the snapshot was taken */
+    if (loadFromTempFile) {
+        AutosaveRestoreTab(tab);
+    }
+    
     /* Enable change history FIRST - this clears undo buffer and enables tracking */
     if (tab->changeHistoryEnabled) {
         EnableChangeHistory(tab->editorHandle, TRUE);
@@ -1291,7 +1196,7 @@ BOOL LoadTabContent(int index)
         ApplySyntaxHighlightingForFile(tab->editorHandle, tab->filePath);
         
         /* Update file type in status bar using new language detection */
-        UpdateFileType(GetFileTypeFromPath(tab->filePath));
+        UpdateFileType(GetFileTypeForEditor(tab->editorHandle, tab->filePath));
     } else {
         /* Update file type in status bar for new files */
         UpdateFileType("Text");
@@ -1339,6 +1244,229 @@ BOOL IsTabLoaded(int index)
     return g_tabControl.tabs[index].isLoaded;
 }
 
+/* Check if a background load is still filling the tab */
+BOOL IsTabLoading(int index)
+{
+    if (index < 0 || index >= g_tabControl.tabCount) {
+        return FALSE;
+    }
+    
+    return g_tabControl.tabs[index].loadJob != NULL;
+}
+
+/* Load a file into a tab's editor. Files of LARGEFILE_SIZE or more are shown a page at a time
+ * when the encoding is detected - tab->largeFile is set and the editor stays read-only.
+ * Files of FILELOAD_BACKGROUND_SIZE or more are streamed on a worker thread when
+ * allowBackground is set - tab->loadJob is set and the editor shows an empty read-only
+ * document until CompleteTabLoad attaches the loaded one.
+ * The tab's encoding and line ending are only updated when the encoding is detected. */
+static BOOL LoadFileIntoTab(TabInfo* tab, const char* filePath, int encoding, BOOL allowBackground)
+{
+    FileInfo fileInfo;
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (GetFileAttributesEx(filePath, GetFileExInfoStandard, &attributes)) {
+        unsigned long long fileSize = ((unsigned long long)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+        if (fileSize >= LARGEFILE_SIZE && encoding == FILELOAD_DETECT_ENCODING) {
+            tab->largeFile = OpenLargeFile(tab->editorHandle, filePath, g_tabControl.parentWindow, &fileInfo);
+            if (tab->largeFile) {
+                tab->encoding = (FileEncoding)fileInfo.encoding;
+                tab->lineEnding = (LineEnding)fileInfo.lineEnding;
+                return TRUE;
+            }
+            /* UTF-16 - fall back to loading the whole file */
+        }
+        if (fileSize >= FILELOAD_BACKGROUND_SIZE && allowBackground) {
+            tab->loadJob = StartFileLoad(tab->editorHandle, filePath, encoding, g_tabControl.parentWindow);
+            if (tab->loadJob) {
+                SendMessage(tab->editorHandle, SCI_SETREADONLY, 1, 0);
+                UpdateLoadProgressDisplay();
+                return TRUE;
+            }
+            /* Fall back to a synchronous load */
+        }
+    }
+    
+    if (!LoadFileIntoEditor(tab->editorHandle, filePath, encoding, &fileInfo)) {
+        return FALSE;
+    }
+    if (encoding == FILELOAD_DETECT_ENCODING) {
+        tab->encoding = (FileEncoding)fileInfo.encoding;
+        tab->lineEnding = (LineEnding)fileInfo.lineEnding;
+    }
+    return TRUE;
+}
+
+/* Find the tab a background load belongs to */
+static int FindTabByLoadJob(FileLoadJob* job)
+{
+    for (int i = 0; i < g_tabControl.tabCount; i++) {
+        if (g_tabControl.tabs[i].loadJob == job) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Tab whose load is shown in the status bar - the selected tab if it is loading,
+ * otherwise the first loading tab */
+static int GetDisplayedLoadTab(void)
+{
+    if (IsTabLoading(g_tabControl.selectedIndex)) {
+        return g_tabControl.selectedIndex;
+    }
+    for (int i = 0; i < g_tabControl.tabCount; i++) {
+        if (g_tabControl.tabs[i].loadJob) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Show the progress of the displayed load, or hide the progress pane when nothing is loading */
+static void UpdateLoadProgressDisplay(void)
+{
+    int index = GetDisplayedLoadTab();
+    if (index < 0) {
+        HideStatusBarProgress();
+        return;
+    }
+    
+    TabInfo* tab = &g_tabControl.tabs[index];
+    int percent = GetFileLoadProgress(tab->loadJob);
+    char text[128];
+    snprintf(text, sizeof(text), "Loading %s: %d%% (click to cancel)", tab->displayName, percent);
+    ShowStatusBarProgress(text, percent);
+}
+
+/* Keep the load of a closed tab until its worker finishes. If there is no room the load is
+ * waited for now - it has been cancelled so that is quick. */
+static void AbandonTabLoad(FileLoadJob* job)
+{
+    if (g_abandonedLoadCount == g_abandonedLoadCapacity) {
+        int capacity = g_abandonedLoadCapacity ? g_abandonedLoadCapacity * 2 : 4;
+        FileLoadJob** loads = (FileLoadJob**)realloc(g_abandonedLoads, capacity * sizeof(FileLoadJob*));
+        if (!loads) {
+            FinishFileLoad(job, NULL);
+            return;
+        }
+        g_abandonedLoads = loads;
+        g_abandonedLoadCapacity = capacity;
+    }
+    g_abandonedLoads[g_abandonedLoadCount++] = job;
+}
+
+/* Remove a load from the abandoned ones - FALSE if it isn't one of them */
+static BOOL TakeAbandonedLoad(FileLoadJob* job)
+{
+    for (int i = 0; i < g_abandonedLoadCount; i++) {
+        if (g_abandonedLoads[i] == job) {
+            g_abandonedLoads[i] = g_abandonedLoads[--g_abandonedLoadCount];
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* Cancel every background load, including those of closed tabs, and wait for the workers.
+ * Called while closing so no worker is left writing into a loader or posting to the main
+ * window as it is destroyed. Tabs still loading are left with their empty placeholder. */
+void FinishAllTabLoads(void)
+{
+    for (int i = 0; i < g_tabControl.tabCount; i++) {
+        TabInfo* tab = &g_tabControl.tabs[i];
+        if (tab->loadJob) {
+            CancelFileLoad(tab->loadJob);
+            FinishFileLoad(tab->loadJob, NULL);
+            tab->loadJob = NULL;
+        }
+    }
+    for (int i = 0; i < g_abandonedLoadCount; i++) {
+        FinishFileLoad(g_abandonedLoads[i], NULL);
+    }
+    free(g_abandonedLoads);
+    g_abandonedLoads = NULL;
+    g_abandonedLoadCount = 0;
+    g_abandonedLoadCapacity = 0;
+}
+
+/* WM_FILELOAD_PROGRESS handler */
+void UpdateTabLoadProgress(FileLoadJob* job)
+{
+    int index = FindTabByLoadJob(job);
+    if (index >= 0 && index == GetDisplayedLoadTab()) {
+        UpdateLoadProgressDisplay();
+    }
+}
+
+/* WM_FILELOAD_DONE handler - attach the loaded document and finish setting up the tab */
+void CompleteTabLoad(FileLoadJob* job)
+{
+    int index = FindTabByLoadJob(job);
+    if (index < 0) {
+        /* The tab was closed while loading - just discard the document. A job that isn't
+         * abandoned either was already finished by FinishAllTabLoads. */
+        if (TakeAbandonedLoad(job)) {
+            FinishFileLoad(job, NULL);
+        }
+        UpdateLoadProgressDisplay();
+        return;
+    }
+    
+    TabInfo* tab = &g_tabControl.tabs[index];
+    BOOL cancelled = IsFileLoadCancelled(job);
+    FileInfo fileInfo;
+    
+    tab->loadJob = NULL;
+    if (!FinishFileLoad(job, &fileInfo)) {
+        /* The tab has nothing to show without its file */
+        if (!cancelled) {
+            char message[MAX_PATH + 64];
+            snprintf(message, sizeof(message), "Failed to open file:\n%s", tab->filePath);
+            MessageBox(g_tabControl.parentWindow, message, "Error", MB_ICONERROR | MB_OK);
+        }
+        CloseTab(index);
+        if (g_tabControl.tabCount == 0) {
+            AddNewTab(NULL);
+        }
+        UpdateLoadProgressDisplay();
+        return;
+    }
+    
+    tab->encoding = (FileEncoding)fileInfo.encoding;
+    tab->lineEnding = (LineEnding)fileInfo.lineEnding;
+    
+    /* Same order as a synchronous load: change history, save point, then syntax highlighting */
+    if (tab->changeHistoryEnabled) {
+        EnableChangeHistory(tab->editorHandle, TRUE);
+    }
+    SendMessage(tab->editorHandle, SCI_SETSAVEPOINT, 0, 0);
+    ApplySyntaxHighlightingForFile(tab->editorHandle, tab->filePath);
+    
+    /* Restore the session position now that the text exists */
+    SendMessage(tab->editorHandle, SCI_GOTOPOS, tab->sessionCursorPos, 0);
+    SendMessage(tab->editorHandle, SCI_SETFIRSTVISIBLELINE, tab->sessionFirstLine, 0);
+    
+    if (index == g_tabControl.selectedIndex) {
+        UpdateFileType(GetFileTypeForEditor(tab->editorHandle, tab->filePath));
+    }
+    
+    UpdateLoadProgressDisplay();
+}
+
+/* Cancel the background load of a tab - if that tab isn't loading, the load shown in the
+ * status bar is cancelled instead. The tab is closed when WM_FILELOAD_DONE arrives. */
+BOOL CancelTabLoad(int index)
+{
+    if (!IsTabLoading(index)) {
+        index = GetDisplayedLoadTab();
+    }
+    if (index < 0) {
+        return FALSE;
+    }
+    CancelFileLoad(g_tabControl.tabs[index].loadJob);
+    return TRUE;
+}
+
 /* Close tab with confirmation if needed */
 BOOL CloseTabWithConfirmation(int index)
 {
@@ -1386,10 +1514,27 @@ BOOL CloseTab(int index)
     TabInfo* tab = &g_tabControl.tabs[index];
     BOOL wasSelected = (g_tabControl.selectedIndex == index);
     
+    /* Abandon a background load - CompleteTabLoad frees it when the worker finishes,
+     * or FinishAllTabLoads when the application closes first */
+    BOOL wasLoading = (tab->loadJob != NULL);
+    if (wasLoading) {
+        CancelFileLoad(tab->loadJob);
+        AbandonTabLoad(tab->loadJob);
+        tab->loadJob = NULL;
+    }
+    
     /* Destroy editor window */
     if (tab->editorHandle) {
         DestroyWindow(tab->editorHandle);
     }
+    FreeWordIndex(tab->wordIndex);
+    tab->wordIndex = NULL;
+    FreeOccurrenceHighlight(tab->occurrences);
+    tab->occurrences = NULL;
+    FreeFindResults(tab->findResults);
+    tab->findResults = NULL;
+    FreeLargeFile(tab->largeFile);
+    tab->largeFile = NULL;
     
     /* Adjust selected index if needed */
     int newSelectedIndex = -1;
@@ -1421,6 +1566,10 @@ BOOL CloseTab(int index)
         SelectTab(newSelectedIndex);
     }
     
+    if (wasLoading) {
+        UpdateLoadProgressDisplay();
+    }
+    
     /* Update layout */
     UpdateTabLayout();
     
@@ -1479,7 +1628,7 @@ void SelectTab(int index)
     
     /* Load tab content if not loaded (lazy loading) */
     if (!g_tabControl.tabs[index].isLoaded) {
-        if (!LoadTabContent(index)) {
+        if (!LoadTabContentEx(index, TRUE)) {
             /* Failed to load content - should not happen normally */
             return;
         }
@@ -1541,8 +1690,14 @@ void SelectTab(int index)
         int col = pos - lineStart;
         
         UpdateZoomLevel(zoomLevel);
-        UpdateCursorPosition(line, col);
-        UpdateFilePosition(pos);
+        if (tab->largeFile) {
+            UpdateLargeFileStatus(tab->largeFile);
+        } else {
+            UpdateCursorPosition(line, col);
+            UpdateFilePosition(pos);
+        }
+        UpdateUndoMemory((size_t)SendMessage(tab->editorHandle, SCI_GETUNDOMEMORY, 0, 0),
+                         (BOOL)SendMessage(tab->editorHandle, SCI_GETUNDOSPILLFAILED, 0, 0));
     }
     
     /* Update Save button state based on tab's modified state */
@@ -1558,8 +1713,10 @@ void SelectTab(int index)
     SetToolbarButtonToggled(ID_VIEW_WHITESPACE, tab->showWhitespace);
     
     /* Update file type in status bar based on current tab */
-    LanguageType lang = DetectLanguage(tab->filePath);
-    UpdateFileType(GetLanguageName(lang));
+    UpdateFileType(GetFileTypeForEditor(tab->editorHandle, tab->filePath));
+    
+    /* Find All results panel lists the current tab's matches */
+    UpdateFindResultsPanel();
     
     /* Update window title with current file path */
     extern void UpdateWindowTitle(const char* filePath);
@@ -1570,6 +1727,9 @@ void SelectTab(int index)
     BOOL isExistingFile = (strncmp(tab->filePath, "New ", 4) != 0);
     EnableToolbarButton(ID_FILE_OPENFOLDER, isExistingFile);
     
+    /* Show the progress of this tab's background load, if any */
+    UpdateLoadProgressDisplay();
+    
     /* Update layout */
     InvalidateAllTabs();
 }
@@ -74,6 +74,21 @@ typedef struct {
     int sessionFirstLine;             /* First visible line from session */
     int sessionZoomLevel;             /* Zoom level from session */
     char tempFilePath[MAX_PATH];     /* Temp file path for unsaved files during session restore */
+    struct FileLoadJob* loadJob;      /* Background load in progress (NULL when idle) */
+    BOOL sessionDirty;                /* Edited since the session last snapshotted it */
+    unsigned int journalHash;         /* Hash of the last session journal record written */
+    /* Background autosave - see autosave.c */
+    BOOL autosaveBase;                /* Snapshot and deltas on disk hold the text as of autosaveAction */
+    int autosaveAction;               /* Undo position at the last capture */
+    int autosaveLowAction;            /* Lowest undo position reached since the last capture */
+    INT_PTR autosaveLength;           /* Document length at the last capture */
+    unsigned int autosaveEditHash;    /* Hash of the edits made since the last capture */
+    size_t autosaveDeltaBytes;        /* Delta bytes written since the last checkpoint */
+    DWORD lastEditTime;               /* GetTickCount of the last edit */
+    struct WordIndex* wordIndex;      /* Words for completion, created on first use - see wordindex.c */
+    struct OccurrenceHighlight* occurrences; /* Word highlighted by double-click - see occurrences.c */
+    struct FindResults* findResults;  /* Matches listed by Find All - see findresults.c */
+    struct LargeFile* largeFile;      /* Read-only paged view of a file too large to load - see largefile.c */
 } TabInfo;
 
 /* Tab control state structure */
@@ -109,6 +124,11 @@ int AddTabWithFile(const char* filePath, BOOL isNewFile);
 int AddPlaceholderTab(const char* filePath, BOOL isNewFile, BOOL isPinned);  /* Lazy loading - creates tab without loading content */
 BOOL LoadTabContent(int index);  /* Load content for a placeholder tab */
 BOOL IsTabLoaded(int index);  /* Check if tab content is loaded */
+BOOL IsTabLoading(int index);  /* Check if a background load is still filling the tab */
+void UpdateTabLoadProgress(struct FileLoadJob* job);  /* WM_FILELOAD_PROGRESS handler */
+void CompleteTabLoad(struct FileLoadJob* job);  /* WM_FILELOAD_DONE handler */
+BOOL CancelTabLoad(int index);  /* Cancel the load of a tab, or the one shown in the status bar - FALSE when none is loading */
+void FinishAllTabLoads(void);  /* Cancel every background load and wait for its worker - when closing */
 BOOL CloseTab(int index);
 BOOL CloseTabWithConfirmation(int index);
 BOOL CloseAllTabs(void);
@@ -11,6 +11,7 @@
 #include "tabs.h"
 #include "toolbar.h"
 #include "statusbar.h"
+#include "findresults.h"
 #include "splitview.h"
 #include "config.h"
 #include "session.h"
@@ -209,6 +210,7 @@ void HandleWindowResize(int width, int height)
     int toolbarHeight = 0;
     int tabHeight = TAB_HEIGHT;
     int statusbarHeight = 0;
+    int resultsHeight = 0;
     int editorHeight;
     
     WINDOW_PROFILE_MARK("HandleWindowResize: enter");
@@ -225,6 +227,11 @@ void HandleWindowResize(int width, int height)
         statusbarHeight = GetStatusBarHeight();
     }
     
+    /* Find All results panel sits between the editor and the status bar */
+    if (IsFindResultsPanelVisible()) {
+        resultsHeight = GetFindResultsPanelHeight();
+    }
+    
     /* Calculate toolbar height */
     if (IsToolbarVisible()) {
         toolbarHeight = GetToolbarHeight();
@@ -252,7 +259,7 @@ void HandleWindowResize(int width, int height)
     WINDOW_PROFILE_MARK("HandleWindowResize: after tab layout");
     
     /* Calculate remaining height for editor */
-    editorHeight = height - currentY - statusbarHeight;
+    editorHeight = height - currentY - statusbarHeight - resultsHeight;
     if (editorHeight < 0) {
         editorHeight = 0;
     }
@@ -290,6 +297,11 @@ void HandleWindowResize(int width, int height)
         WINDOW_PROFILE_MARK("HandleWindowResize: after editor resize loop");
     }
     
+    /* Resize results panel if visible */
+    if (IsFindResultsPanelVisible()) {
+        ResizeFindResultsPanel(width, currentY + editorHeight);
+    }
+    
     /* Resize status bar if visible */
     if (IsStatusBarVisible()) {
         ResizeStatusBar(width, height - statusbarHeight);
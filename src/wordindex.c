@@ -0,0 +1,547 @@
+/*
+ * Word index implementation for Notepad+
+ *
+ * Word completion used to copy and tokenize the whole document on every keystroke.
+ * Instead each document keeps a count of every word in it: a hash table finds a
+ * word's entry when text is added or removed, and a treap ordered ignoring case
+ * answers prefix queries in O(log n + k).
+ *
+ * Edits update the words around the changed range only. Before a change the words
+ * the change touches are removed, after it the words now in that range are added.
+ * A document is first scanned in chunks from a timer - indexedEnd separates the
+ * indexed start of the document from the part still to scan, and edits past it are
+ * left to the scan.
+ */
+
+#include <windows.h>
+#include <stdlib.h>
+#include <string.h>
+#include "wordindex.h"
+#include "Scintilla.h"
+
+typedef struct WordNode {
+    struct WordNode* left;            /* Treap children, ordered ignoring case */
+    struct WordNode* right;
+    struct WordNode* next;            /* Hash chain */
+    unsigned int hash;                /* Hash of the exact word, also the treap priority */
+    unsigned int count;               /* Occurrences in the document */
+    size_t length;
+    char word[1];
+} WordNode;
+
+struct WordIndex {
+    WordNode** buckets;
+    size_t bucketCount;
+    size_t wordCount;
+    WordNode* root;
+    void* document;                   /* Scintilla document the index belongs to */
+    INT_PTR documentLength;           /* Its length as of the last change seen, -1 before the first scan */
+    INT_PTR indexedEnd;               /* Text before this position is indexed */
+    INT_PTR changeStart;              /* Word range of the change in progress, -1 when none */
+    INT_PTR changeEnd;
+};
+
+#define WORDINDEX_INITIAL_BUCKETS 1024
+
+/* Same word characters as Scintilla's default character classes */
+static BOOL IsWordByte(unsigned char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '_' || c >= 0x80;
+}
+
+static unsigned char FoldByte(unsigned char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+/* FNV-1a */
+static unsigned int HashWord(const char* word, size_t length)
+{
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)word[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* Order ignoring case, then by exact bytes so words differing in case are neighbours */
+static int CompareWords(const char* a, size_t aLength, const char* b, size_t bLength)
+{
+    size_t common = aLength < bLength ? aLength : bLength;
+    for (size_t i = 0; i < common; i++) {
+        unsigned char x = FoldByte((unsigned char)a[i]);
+        unsigned char y = FoldByte((unsigned char)b[i]);
+        if (x != y) {
+            return x < y ? -1 : 1;
+        }
+    }
+    if (aLength != bLength) {
+        return aLength < bLength ? -1 : 1;
+    }
+    return memcmp(a, b, common);
+}
+
+/* Where a word sorts relative to the words starting with prefix: 0 when it starts
+ * with it ignoring case */
+static int ComparePrefix(const WordNode* node, const char* prefix, size_t prefixLength)
+{
+    size_t common = node->length < prefixLength ? node->length : prefixLength;
+    for (size_t i = 0; i < common; i++) {
+        unsigned char x = FoldByte((unsigned char)node->word[i]);
+        unsigned char y = FoldByte((unsigned char)prefix[i]);
+        if (x != y) {
+            return x < y ? -1 : 1;
+        }
+    }
+    return node->length < prefixLength ? -1 : 0;
+}
+
+static WordNode* RotateRight(WordNode* node)
+{
+    WordNode* left = node->left;
+    node->left = left->right;
+    left->right = node;
+    return left;
+}
+
+static WordNode* RotateLeft(WordNode* node)
+{
+    WordNode* right = node->right;
+    node->right = right->left;
+    right->left = node;
+    return right;
+}
+
+static WordNode* TreapInsert(WordNode* root, WordNode* node)
+{
+    if (!root) {
+        return node;
+    }
+    if (CompareWords(node->word, node->length, root->word, root->length) < 0) {
+        root->left = TreapInsert(root->left, node);
+        if (root->left->hash > root->hash) {
+            root = RotateRight(root);
+        }
+    } else {
+        root->right = TreapInsert(root->right, node);
+        if (root->right->hash > root->hash) {
+            root = RotateLeft(root);
+        }
+    }
+    return root;
+}
+
+static WordNode* TreapRemove(WordNode* root, const WordNode* node)
+{
+    if (!root) {
+        return NULL;
+    }
+    if (root == node) {
+        /* Rotate the node down until it has at most one child */
+        if (!root->left) {
+            return root->right;
+        }
+        if (!root->right) {
+            return root->left;
+        }
+        if (root->left->hash > root->right->hash) {
+            root = RotateRight(root);
+            root->right = TreapRemove(root->right, node);
+        } else {
+            root = RotateLeft(root);
+            root->left = TreapRemove(root->left, node);
+        }
+        return root;
+    }
+    if (CompareWords(node->word, node->length, root->word, root->length) < 0) {
+        root->left = TreapRemove(root->left, node);
+    } else {
+        root->right = TreapRemove(root->right, node);
+    }
+    return root;
+}
+
+static BOOL GrowBuckets(WordIndex* index)
+{
+    size_t bucketCount = index->bucketCount * 2;
+    WordNode** buckets = (WordNode**)calloc(bucketCount, sizeof(WordNode*));
+    if (!buckets) {
+        return FALSE;
+    }
+    for (size_t i = 0; i < index->bucketCount; i++) {
+        WordNode* node = index->buckets[i];
+        while (node) {
+            WordNode* next = node->next;
+            size_t bucket = node->hash & (bucketCount - 1);
+            node->next = buckets[bucket];
+            buckets[bucket] = node;
+            node = next;
+        }
+    }
+    free(index->buckets);
+    index->buckets = buckets;
+    index->bucketCount = bucketCount;
+    return TRUE;
+}
+
+static void AddWord(WordIndex* index, const char* word, size_t length)
+{
+    unsigned int hash = HashWord(word, length);
+    WordNode** bucket = &index->buckets[hash & (index->bucketCount - 1)];
+    for (WordNode* node = *bucket; node; node = node->next) {
+        if (node->hash == hash && node->length == length && memcmp(node->word, word, length) == 0) {
+            node->count++;
+            return;
+        }
+    }
+
+    WordNode* node = (WordNode*)malloc(sizeof(WordNode) + length);
+    if (!node) {
+        return;
+    }
+    node->left = NULL;
+    node->right = NULL;
+    node->hash = hash;
+    node->count = 1;
+    node->length = length;
+    memcpy(node->word, word, length);
+    node->word[length] = '\0';
+    node->next = *bucket;
+    *bucket = node;
+    index->root = TreapInsert(index->root, node);
+    index->wordCount++;
+
+    if (index->wordCount > index->bucketCount) {
+        GrowBuckets(index);
+    }
+}
+
+static void RemoveWord(WordIndex* index, const char* word, size_t length)
+{
+    unsigned int hash = HashWord(word, length);
+    for (WordNode** link = &index->buckets[hash & (index->bucketCount - 1)]; *link; link = &(*link)->next) {
+        WordNode* node = *link;
+        if (node->hash == hash && node->length == length && memcmp(node->word, word, length) == 0) {
+            if (--node->count == 0) {
+                *link = node->next;
+                index->root = TreapRemove(index->root, node);
+                index->wordCount--;
+                free(node);
+            }
+            return;
+        }
+    }
+}
+
+static void ClearWords(WordIndex* index)
+{
+    for (size_t i = 0; i < index->bucketCount; i++) {
+        WordNode* node = index->buckets[i];
+        while (node) {
+            WordNode* next = node->next;
+            free(node);
+            node = next;
+        }
+        index->buckets[i] = NULL;
+    }
+    index->root = NULL;
+    index->wordCount = 0;
+}
+
+WordIndex* CreateWordIndex(void)
+{
+    WordIndex* index = (WordIndex*)calloc(1, sizeof(WordIndex));
+    if (!index) {
+        return NULL;
+    }
+    index->bucketCount = WORDINDEX_INITIAL_BUCKETS;
+    index->buckets = (WordNode**)calloc(index->bucketCount, sizeof(WordNode*));
+    if (!index->buckets) {
+        free(index);
+        return NULL;
+    }
+    index->documentLength = -1;
+    index->changeStart = -1;
+    return index;
+}
+
+void FreeWordIndex(WordIndex* index)
+{
+    if (!index) {
+        return;
+    }
+    ClearWords(index);
+    free(index->buckets);
+    free(index);
+}
+
+void WordIndexAddWords(WordIndex* index, const char* text, size_t length)
+{
+    size_t i = 0;
+    while (i < length) {
+        if (!IsWordByte((unsigned char)text[i])) {
+            i++;
+            continue;
+        }
+        size_t start = i;
+        while (i < length && IsWordByte((unsigned char)text[i])) {
+            i++;
+        }
+        AddWord(index, text + start, i - start);
+    }
+}
+
+void WordIndexRemoveWords(WordIndex* index, const char* text, size_t length)
+{
+    size_t i = 0;
+    while (i < length) {
+        if (!IsWordByte((unsigned char)text[i])) {
+            i++;
+            continue;
+        }
+        size_t start = i;
+        while (i < length && IsWordByte((unsigned char)text[i])) {
+            i++;
+        }
+        RemoveWord(index, text + start, i - start);
+    }
+}
+
+size_t WordIndexWordCount(const WordIndex* index)
+{
+    return index ? index->wordCount : 0;
+}
+
+typedef struct {
+    const char* prefix;
+    size_t prefixLength;
+    int maxWords;
+    int count;
+    size_t listLength;
+    const WordNode* previous;
+    const WordNode** found;
+} CompletionQuery;
+
+/* In-order walk of the words starting with the prefix, skipping subtrees outside it */
+static void CollectCompletions(const WordNode* node, CompletionQuery* query)
+{
+    while (node && query->count < query->maxWords) {
+        int order = ComparePrefix(node, query->prefix, query->prefixLength);
+        if (order < 0) {
+            node = node->right;
+            continue;
+        }
+        if (order > 0) {
+            node = node->left;
+            continue;
+        }
+        CollectCompletions(node->left, query);
+        if (query->count >= query->maxWords) {
+            return;
+        }
+        /* Words only as long as the prefix are what was typed; neighbours that differ
+         * only in case are listed once */
+        BOOL caseVariant = query->previous && query->previous->length == node->length &&
+                           ComparePrefix(query->previous, node->word, node->length) == 0;
+        if (node->length > query->prefixLength && !caseVariant) {
+            query->found[query->count++] = node;
+            query->listLength += node->length + 1;
+            query->previous = node;
+        }
+        node = node->right;
+    }
+}
+
+int WordIndexComplete(const WordIndex* index, const char* prefix, size_t prefixLength,
+                      int maxWords, char** list)
+{
+    *list = NULL;
+    if (!index || maxWords <= 0) {
+        return 0;
+    }
+
+    CompletionQuery query;
+    memset(&query, 0, sizeof(query));
+    query.prefix = prefix;
+    query.prefixLength = prefixLength;
+    query.maxWords = maxWords;
+    query.found = (const WordNode**)malloc(sizeof(WordNode*) * (size_t)maxWords);
+    if (!query.found) {
+        return 0;
+    }
+    CollectCompletions(index->root, &query);
+
+    if (query.count > 0) {
+        char* text = (char*)malloc(query.listLength);
+        if (text) {
+            char* p = text;
+            for (int i = 0; i < query.count; i++) {
+                if (i > 0) {
+                    *p++ = ' ';
+                }
+                memcpy(p, query.found[i]->word, query.found[i]->length);
+                p += query.found[i]->length;
+            }
+            *p = '\0';
+            *list = text;
+        } else {
+            query.count = 0;
+        }
+    }
+    free(query.found);
+    return query.count;
+}
+
+/* Forget everything - the document is scanned again from the start */
+static void ResetIndex(WordIndex* index, void* document, INT_PTR documentLength)
+{
+    ClearWords(index);
+    index->document = document;
+    index->documentLength = documentLength;
+    index->indexedEnd = 0;
+    index->changeStart = -1;
+}
+
+/* The index is only valid for the document it was built from */
+static void CheckDocument(WordIndex* index, HWND editor)
+{
+    void* document = (void*)SendMessage(editor, SCI_GETDOCPOINTER, 0, 0);
+    INT_PTR documentLength = (INT_PTR)SendMessage(editor, SCI_GETLENGTH, 0, 0);
+    if (document != index->document || documentLength != index->documentLength) {
+        ResetIndex(index, document, documentLength);
+    }
+}
+
+/* Word boundaries are found with the same word characters as the index uses, reading
+ * the document a little at a time so a long run of word characters stays cheap */
+#define WORDINDEX_BOUNDARY_STEP 256
+
+static INT_PTR WordStart(HWND editor, INT_PTR position)
+{
+    while (position > 0) {
+        INT_PTR step = position < WORDINDEX_BOUNDARY_STEP ? position : WORDINDEX_BOUNDARY_STEP;
+        const char* text = (const char*)SendMessage(editor, SCI_GETRANGEPOINTER, position - step, step);
+        if (!text) {
+            break;
+        }
+        for (INT_PTR i = step; i > 0; i--) {
+            if (!IsWordByte((unsigned char)text[i - 1])) {
+                return position - step + i;
+            }
+        }
+        position -= step;
+    }
+    return position;
+}
+
+static INT_PTR WordEnd(HWND editor, INT_PTR position, INT_PTR documentLength)
+{
+    while (position < documentLength) {
+        INT_PTR step = documentLength - position < WORDINDEX_BOUNDARY_STEP ? documentLength - position : WORDINDEX_BOUNDARY_STEP;
+        const char* text = (const char*)SendMessage(editor, SCI_GETRANGEPOINTER, position, step);
+        if (!text) {
+            break;
+        }
+        for (INT_PTR i = 0; i < step; i++) {
+            if (!IsWordByte((unsigned char)text[i])) {
+                return position + i;
+            }
+        }
+        position += step;
+    }
+    return position;
+}
+
+static void AddRange(WordIndex* index, HWND editor, INT_PTR start, INT_PTR end)
+{
+    if (end > start) {
+        const char* text = (const char*)SendMessage(editor, SCI_GETRANGEPOINTER, start, end - start);
+        if (text) {
+            WordIndexAddWords(index, text, (size_t)(end - start));
+        }
+    }
+}
+
+static void RemoveRange(WordIndex* index, HWND editor, INT_PTR start, INT_PTR end)
+{
+    if (end > start) {
+        const char* text = (const char*)SendMessage(editor, SCI_GETRANGEPOINTER, start, end - start);
+        if (text) {
+            WordIndexRemoveWords(index, text, (size_t)(end - start));
+        }
+    }
+}
+
+void WordIndexNoteModification(WordIndex* index, HWND editor, int modificationType,
+                               INT_PTR position, INT_PTR length)
+{
+    if (!index || !editor) {
+        return;
+    }
+
+    if (modificationType & (SC_MOD_BEFOREINSERT | SC_MOD_BEFOREDELETE)) {
+        CheckDocument(index, editor);
+        index->changeStart = -1;
+        /* Edits past the indexed part are picked up by the scan */
+        INT_PTR start = WordStart(editor, position);
+        if (start >= index->indexedEnd) {
+            return;
+        }
+        if (length > WORDINDEX_MAX_UPDATE) {
+            ResetIndex(index, index->document, index->documentLength);
+            return;
+        }
+        /* The words the change touches, including the ones it joins or splits */
+        INT_PTR changed = (modificationType & SC_MOD_BEFOREDELETE) ? position + length : position;
+        INT_PTR end = WordEnd(editor, changed, index->documentLength);
+        RemoveRange(index, editor, start, end < index->indexedEnd ? end : index->indexedEnd);
+        index->changeStart = start;
+        index->changeEnd = end;
+    } else if (modificationType & (SC_MOD_INSERTTEXT | SC_MOD_DELETETEXT)) {
+        INT_PTR delta = (modificationType & SC_MOD_INSERTTEXT) ? length : -length;
+        if (index->documentLength >= 0) {
+            index->documentLength += delta;
+        }
+        if (index->changeStart < 0) {
+            return;
+        }
+        if (index->changeEnd > index->indexedEnd) {
+            /* The change reached past the indexed part - scan again from its start */
+            index->indexedEnd = index->changeStart;
+        } else {
+            AddRange(index, editor, index->changeStart, index->changeEnd + delta);
+            index->indexedEnd += delta;
+        }
+        index->changeStart = -1;
+    }
+}
+
+BOOL WordIndexScan(WordIndex* index, HWND editor)
+{
+    if (!index || !editor) {
+        return TRUE;
+    }
+    CheckDocument(index, editor);
+    if (index->indexedEnd >= index->documentLength) {
+        return TRUE;
+    }
+
+    /* Reading across the gap of the gap buffer moves it, so a step ends at the gap and
+     * only the word there is carried over it. Steps end with a word so none is split. */
+    INT_PTR end = index->indexedEnd + WORDINDEX_SCAN_CHUNK;
+    INT_PTR gap = (INT_PTR)SendMessage(editor, SCI_GETGAPPOSITION, 0, 0);
+    if (gap > index->indexedEnd && gap < end) {
+        end = gap;
+    }
+    end = WordEnd(editor, end < index->documentLength ? end : index->documentLength, index->documentLength);
+    AddRange(index, editor, index->indexedEnd, end);
+    index->indexedEnd = end;
+    return index->indexedEnd >= index->documentLength;
+}
+
+BOOL WordIndexIsComplete(const WordIndex* index)
+{
+    return index && index->documentLength >= 0 && index->indexedEnd >= index->documentLength;
+}
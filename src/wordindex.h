@@ -0,0 +1,51 @@
+/*
+ * Word index header for Notepad+
+ * Keeps the words of a document for word completion, updated as it is edited
+ */
+
+#ifndef WORDINDEX_H
+#define WORDINDEX_H
+
+#include <windows.h>
+
+/* Text indexed per step while a document is first scanned (bytes) */
+#define WORDINDEX_SCAN_CHUNK        (1024 * 1024)
+
+/* Interval between scan steps while a document isn't fully indexed (milliseconds) */
+#define WORDINDEX_SCAN_INTERVAL     20
+
+/* Edits larger than this drop the index, which is then rebuilt by scanning (bytes) */
+#define WORDINDEX_MAX_UPDATE        (4 * 1024 * 1024)
+
+typedef struct WordIndex WordIndex;
+
+/* Index creation - a new index starts empty, with the whole document left to scan */
+WordIndex* CreateWordIndex(void);
+void FreeWordIndex(WordIndex* index);
+
+/* Add or remove every word in a piece of text */
+void WordIndexAddWords(WordIndex* index, const char* text, size_t length);
+void WordIndexRemoveWords(WordIndex* index, const char* text, size_t length);
+
+/* Number of distinct words in the index */
+size_t WordIndexWordCount(const WordIndex* index);
+
+/* Words longer than prefix that start with it ignoring case, sorted ignoring case and
+ * without duplicates that differ only in case. Returns how many words were found, at
+ * most maxWords, and sets list to them separated by spaces (free with free) when any. */
+int WordIndexComplete(const WordIndex* index, const char* prefix, size_t prefixLength,
+                      int maxWords, char** list);
+
+/* Keep the index in step with an editor's document - call for every SCN_MODIFIED of the
+ * editor with SC_MOD_BEFOREINSERT, SC_MOD_BEFOREDELETE, SC_MOD_INSERTTEXT or SC_MOD_DELETETEXT */
+void WordIndexNoteModification(WordIndex* index, HWND editor, int modificationType,
+                               INT_PTR position, INT_PTR length);
+
+/* Index the next WORDINDEX_SCAN_CHUNK of a document not fully scanned yet.
+ * Returns TRUE once the whole document is indexed. */
+BOOL WordIndexScan(WordIndex* index, HWND editor);
+
+/* Whether the whole document is indexed */
+BOOL WordIndexIsComplete(const WordIndex* index);
+
+#endif /* WORDINDEX_H */
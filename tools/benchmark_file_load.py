@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""
+Large file open benchmark for Notepad+.
+
+Generates log-style test files (100 MB, 1 GB and 4 GB by default), opens each one in
+bin/notepad+.exe and reports the time until the document is loaded, the time to first
+paint, the load throughput and the peak working set of the process.
+
+Files are UTF-8 by default; --encodings also runs UTF-16 LE/BE (with BOM) and ANSI
+(Windows-1252) files of the same size to compare the conversion paths.
+
+The executable must be built with file load profiling enabled:
+    set CFLAGS=%CFLAGS% -DPROFILE_FILE_LOAD=1
+which makes LoadFileIntoEditor append its timings to fileload_profile.txt next to the exe.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+MB = 1024 * 1024
+DEFAULT_SIZES_MB = [100, 1024, 4096]
+
+# Encoding name -> (Python codec, BOM)
+ENCODINGS = {
+    "utf8": ("utf-8", b""),
+    "utf16le": ("utf-16-le", b"\xff\xfe"),
+    "utf16be": ("utf-16-be", b"\xfe\xff"),
+    "ansi": ("cp1252", b""),
+}
+
+PROFILE_LINE = re.compile(r"\[LOAD\] (\d+) bytes (.+): ([\d.]+) ms, peak RSS ([\d.]+) MB")
+
+
+def generate_file(path: Path, size: int, encoding: str = "utf8") -> None:
+    """Write a file of roughly size bytes made of varied log lines."""
+    if path.exists() and path.stat().st_size >= size:
+        return
+    codec, bom = ENCODINGS[encoding]
+    block_lines = []
+    for i in range(4096):
+        block_lines.append(
+            "2024-01-%02d 12:%02d:%02d.%03d INFO  [worker-%d] request id=%08x path=/api/v1/items/%d status=200 bytes=%d%s\r\n"
+            % (i % 28 + 1, i % 60, (i * 7) % 60, i % 1000, i % 16, i * 2654435761 & 0xFFFFFFFF, i, i * 37,
+               # Some non-ASCII text so the conversions do real work
+               "" if encoding == "utf8" and i % 8 else " caf\u00e9 na\u00efve")
+        )
+    block = "".join(block_lines).encode(codec)
+    with open(path, "wb") as f:
+        f.write(bom)
+        written = len(bom)
+        while written < size:
+            chunk = block[: min(len(block), size - written)]
+            f.write(chunk)
+            written += len(chunk)
+
+
+def read_profile(profile: Path, size: int) -> dict:
+    """Collect the [LOAD] lines recorded for a file of the given size."""
+    results = {}
+    if not profile.exists():
+        return results
+    for line in profile.read_text(errors="replace").splitlines():
+        m = PROFILE_LINE.search(line)
+        if m and int(m.group(1)) == size:
+            results[m.group(2)] = (float(m.group(3)), float(m.group(4)))
+    return results
+
+
+def run_one(exe: Path, path: Path, timeout: float) -> dict:
+    profile = exe.parent / "fileload_profile.txt"
+    if profile.exists():
+        profile.unlink()
+    size = path.stat().st_size
+    proc = subprocess.Popen([str(exe), str(path)])
+    deadline = time.time() + timeout
+    results = {}
+    try:
+        while time.time() < deadline:
+            results = read_profile(profile, size)
+            if "first paint" in results:
+                break
+            time.sleep(0.1)
+    finally:
+        proc.kill()
+        proc.wait()
+    return results
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--exe", default=str(Path(__file__).parent.parent / "bin" / "notepad+.exe"))
+    parser.add_argument("--dir", default=tempfile.gettempdir(), help="where to create the test files")
+    parser.add_argument("--sizes", type=int, nargs="*", default=DEFAULT_SIZES_MB, help="file sizes in MB")
+    parser.add_argument("--timeout", type=float, default=600.0)
+    parser.add_argument("--keep", action="store_true", help="keep the generated files")
+    parser.add_argument("--encodings", nargs="*", default=["utf8"], choices=sorted(ENCODINGS),
+                        help="file encodings to test")
+    args = parser.parse_args()
+
+    exe = Path(args.exe)
+    if not exe.exists():
+        print("Executable not found: %s" % exe)
+        return 1
+
+    print("%10s  %8s  %14s  %14s  %10s  %14s" % ("Size", "Encoding", "Loaded (ms)", "Painted (ms)", "MB/s", "Peak RSS (MB)"))
+    for size_mb in args.sizes:
+        for encoding in args.encodings:
+            path = Path(args.dir) / ("notepadplus_bench_%dMB_%s.log" % (size_mb, encoding))
+            generate_file(path, size_mb * MB, encoding)
+            results = run_one(exe, path, args.timeout)
+            loaded = results.get("document loaded")
+            painted = results.get("first paint")
+            peak = max([r[1] for r in results.values()], default=0.0)
+            print("%8d MB  %8s  %14s  %14s  %10s  %14.1f" % (
+                size_mb,
+                encoding,
+                "%.1f" % loaded[0] if loaded else "-",
+                "%.1f" % painted[0] if painted else "-",
+                "%.1f" % (size_mb / (loaded[0] / 1000.0)) if loaded and loaded[0] > 0 else "-",
+                peak))
+            if not args.keep:
+                os.remove(path)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,216 @@
+/*
+ * Find in Files benchmark for Notepad+
+ *
+ * Measures how fast Find in Files gets through a local folder tree compared with
+ * simply reading every file in it. The baseline reads each file with ReadFile on one
+ * thread and touches every byte; Find in Files then searches the same tree for a
+ * literal word and a regular expression with one thread and with one per processor.
+ * Every pass runs twice and the second is reported, so all figures are for files in
+ * the system file cache - the first run after a reboot is bound by the disk instead.
+ *
+ * Without a folder argument, or with "-", a tree of generated source files is written
+ * to %TEMP%\notepadplus_findinfiles once and reused.
+ *
+ * Build (after build.bat) and run from the repository root:
+ *     gcc -O2 -Isrc tools/benchmark_findinfiles.c src/findinfiles.c obj/scintilla_bridge.o
+ *         obj/scintilla/libscintilla.a -lstdc++ -o bin/benchmark_findinfiles.exe
+ *     bin\benchmark_findinfiles.exe [folder] [generated size in MB]
+ */
+
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "findinfiles.h"
+#include "Scintilla.h"
+
+#define GENERATED_FILE_SIZE (256 * 1024)
+#define GENERATED_FOLDERS   20
+#define READ_BUFFER_SIZE    (1024 * 1024)
+
+static unsigned int g_seed = 12345;
+static volatile unsigned int g_sink = 0;
+
+static unsigned int Random(void)
+{
+    g_seed = g_seed * 1103515245u + 12345u;
+    return (g_seed >> 8) & 0xFFFFFF;
+}
+
+static double Now(void)
+{
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+}
+
+/* Source-like lines where about one line in 2000 has the word searched for */
+static void MakeText(char* text, size_t size)
+{
+    static const char* const words[] = {
+        "buffer", "length", "index", "window", "editor", "result", "count", "value",
+        "position", "line", "style", "text", "offset", "start", "finish"
+    };
+    size_t length = 0;
+    while (length < size) {
+        char line[160];
+        int lineLength = snprintf(line, sizeof(line), "    %s = %s(%s, %u);\r\n",
+                                  words[Random() % 15], (Random() % 2000 == 0) ? "needle" : words[Random() % 15],
+                                  words[Random() % 15], Random() % 10000);
+        if (length + (size_t)lineLength > size) {
+            lineLength = (int)(size - length);
+        }
+        memcpy(text + length, line, (size_t)lineLength);
+        length += (size_t)lineLength;
+    }
+}
+
+static BOOL GenerateTree(const char* folder, int megabytes)
+{
+    char path[MAX_PATH];
+    char* text = (char*)malloc(GENERATED_FILE_SIZE);
+    int fileCount = megabytes * 4;
+
+    if (!text) {
+        return FALSE;
+    }
+    printf("Writing %d MB of files to %s...\n", megabytes, folder);
+    CreateDirectory(folder, NULL);
+    for (int i = 0; i < fileCount; i++) {
+        snprintf(path, sizeof(path), "%s\\dir%02d", folder, i % GENERATED_FOLDERS);
+        CreateDirectory(path, NULL);
+        snprintf(path, sizeof(path), "%s\\dir%02d\\file%05d.c", folder, i % GENERATED_FOLDERS, i);
+        MakeText(text, GENERATED_FILE_SIZE);
+        HANDLE file = CreateFile(path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) {
+            free(text);
+            return FALSE;
+        }
+        DWORD written = 0;
+        WriteFile(file, text, GENERATED_FILE_SIZE, &written, NULL);
+        CloseHandle(file);
+    }
+    free(text);
+    return TRUE;
+}
+
+/* Read every file under a folder on this thread, returning the bytes read */
+static unsigned long long ReadTree(const char* folder, char* buffer, unsigned int* checksum)
+{
+    char path[MAX_PATH];
+    WIN32_FIND_DATA findData;
+    unsigned long long total = 0;
+
+    snprintf(path, sizeof(path), "%s\\*", folder);
+    HANDLE find = FindFirstFile(path, &findData);
+    if (find == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    do {
+        if (strcmp(findData.cFileName, ".") == 0 || strcmp(findData.cFileName, "..") == 0) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s\\%s", folder, findData.cFileName);
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            total += ReadTree(path, buffer, checksum);
+            continue;
+        }
+        HANDLE file = CreateFile(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file == INVALID_HANDLE_VALUE) {
+            continue;
+        }
+        DWORD read = 0;
+        while (ReadFile(file, buffer, READ_BUFFER_SIZE, &read, NULL) && read > 0) {
+            for (DWORD i = 0; i < read; i += 64) {
+                *checksum += (unsigned char)buffer[i];
+            }
+            total += read;
+        }
+        CloseHandle(file);
+    } while (FindNextFile(find, &findData));
+    FindClose(find);
+    return total;
+}
+
+static double ReadBaseline(const char* folder, double* gigabytes)
+{
+    char* buffer = (char*)malloc(READ_BUFFER_SIZE);
+    unsigned int checksum = 0;
+    double seconds = 0;
+    unsigned long long total = 0;
+
+    for (int run = 0; run < 2; run++) {
+        double start = Now();
+        total = ReadTree(folder, buffer, &checksum);
+        seconds = Now() - start;
+    }
+    free(buffer);
+    g_sink += checksum;
+    *gigabytes = (double)total / 1e9;
+    return seconds;
+}
+
+static void RunSearch(const char* folder, const char* name, const char* pattern, int flags, int threads, double baseline)
+{
+    FindInFilesOptions options;
+    FindInFilesStats stats;
+
+    memset(&options, 0, sizeof(options));
+    snprintf(options.folder, sizeof(options.folder), "%s", folder);
+    snprintf(options.pattern, sizeof(options.pattern), "%s", pattern);
+    strcpy(options.include, FINDINFILES_DEFAULT_INCLUDE);
+    strcpy(options.exclude, FINDINFILES_DEFAULT_EXCLUDE);
+    options.searchFlags = flags;
+    options.threads = threads;
+
+    for (int run = 0; run < 2; run++) {
+        FindInFilesJob* job = StartFindInFiles(&options, NULL);
+        if (!job) {
+            printf("%-8s could not start\n", name);
+            return;
+        }
+        WaitFindInFiles(job, INFINITE);
+        GetFindInFilesStats(job, &stats);
+        size_t length = 0;
+        free(FindInFilesTakeResults(job, &length));
+        FinishFindInFiles(job);
+    }
+
+    double gbPerSecond = (double)stats.bytesSearched / 1e9 / stats.seconds;
+    printf("%-8s %7d %9lld %9lld %10.3f %10.2f %9.2f\n", name, threads, (long long)stats.filesSearched,
+           (long long)stats.matches, stats.seconds, gbPerSecond, gbPerSecond / baseline);
+}
+
+int main(int argc, char** argv)
+{
+    char folder[MAX_PATH];
+    int megabytes = argc > 2 ? atoi(argv[2]) : 1024;
+    SYSTEM_INFO si;
+
+    if (argc > 1 && strcmp(argv[1], "-") != 0) {
+        snprintf(folder, sizeof(folder), "%s", argv[1]);
+    } else {
+        char temp[MAX_PATH];
+        GetTempPath(MAX_PATH, temp);
+        snprintf(folder, sizeof(folder), "%snotepadplus_findinfiles", temp);
+        if (GetFileAttributes(folder) == INVALID_FILE_ATTRIBUTES && !GenerateTree(folder, megabytes)) {
+            fprintf(stderr, "Cannot write %s\n", folder);
+            return 2;
+        }
+    }
+    GetSystemInfo(&si);
+
+    double gigabytes = 0;
+    double seconds = ReadBaseline(folder, &gigabytes);
+    double baseline = gigabytes / seconds;
+    printf("Read baseline: %.2f GB in %.3f s, %.2f GB/s on one thread\n\n", gigabytes, seconds, baseline);
+
+    printf("%-8s %7s %9s %9s %10s %10s %9s\n", "Search", "Threads", "Files", "Lines", "Time (s)", "GB/s", "x Read");
+    RunSearch(folder, "literal", "needle", SCFIND_MATCHCASE, 1, baseline);
+    RunSearch(folder, "literal", "needle", SCFIND_MATCHCASE, (int)si.dwNumberOfProcessors, baseline);
+    RunSearch(folder, "nocase", "NEEDLE", 0, (int)si.dwNumberOfProcessors, baseline);
+    RunSearch(folder, "regex", "ne+dle([a-z]+, [0-9]+)", SCFIND_REGEXP, 1, baseline);
+    RunSearch(folder, "regex", "ne+dle([a-z]+, [0-9]+)", SCFIND_REGEXP, (int)si.dwNumberOfProcessors, baseline);
+    return 0;
+}
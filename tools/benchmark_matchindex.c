@@ -0,0 +1,111 @@
+/*
+ * Match index benchmark for Notepad+
+ *
+ * Builds match indexes of growing size with matches spread as in a large log file,
+ * then reports the memory they take next to an array of match ranges, how long going
+ * to a random match and finding the first match after a random position take, and
+ * what following an edit costs - one that moves the matches after it and one that
+ * also adds a match, which rebuilds the index from the edit on.
+ *
+ * Build and run from the repository root:
+ *     gcc -O2 -Isrc tools/benchmark_matchindex.c src/matchindex.c -o bin/benchmark_matchindex.exe
+ *     bin\benchmark_matchindex.exe [largest count in millions]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "matchindex.h"
+
+#define LOOKUP_RUNS 1000000
+#define EDIT_RUNS 200
+#define REBUILD_RUNS 5
+
+static unsigned int g_seed = 12345;
+
+static double Now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+static unsigned int Random(void)
+{
+    g_seed = g_seed * 1103515245u + 12345u;
+    return (g_seed >> 8) & 0xFFFFFF;
+}
+
+int main(int argc, char** argv)
+{
+    int largest = argc > 1 ? atoi(argv[1]) : 10;
+    static const int counts[] = { 1, 5, 10, 20 };
+
+    printf("%10s %10s %12s %10s %10s %10s %10s %12s\n", "Matches", "Build (ms)", "Ranges (MB)",
+           "Index (MB)", "At (ns)", "Find (ns)", "Move (us)", "Rebuild (ms)");
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]) && counts[c] <= largest; c++) {
+        size_t count = (size_t)counts[c] * 1000000;
+
+        /* Matches a few dozen bytes apart, now and then thousands */
+        double start = Now();
+        MatchIndex* index = CreateMatchIndex();
+        INT_PTR position = 0;
+        for (size_t i = 0; i < count; i++) {
+            position += (Random() % 16 == 0) ? 1000 + Random() % 10000 : 8 + Random() % 80;
+            if (!MatchIndexAppend(index, position)) {
+                printf("Out of memory at %zu matches\n", i);
+                return 1;
+            }
+        }
+        double buildMs = (Now() - start) / 1000.0;
+        double rangesMB = (double)count * 2 * sizeof(INT_PTR) / (1024.0 * 1024.0);
+        double indexMB = ((double)count * sizeof(unsigned int) +
+                          (double)(count / MATCHINDEX_BLOCK_SIZE + 1) * sizeof(INT_PTR)) / (1024.0 * 1024.0);
+
+        /* Going to match n, as the results panel does for each row it draws */
+        volatile INT_PTR sink = 0;
+        start = Now();
+        for (int run = 0; run < LOOKUP_RUNS; run++) {
+            sink += MatchIndexAt(index, ((size_t)Random() << 8 ^ Random()) % count);
+        }
+        double atNs = (Now() - start) * 1000.0 / LOOKUP_RUNS;
+
+        /* First match after a position */
+        start = Now();
+        for (int run = 0; run < LOOKUP_RUNS; run++) {
+            sink += (INT_PTR)MatchIndexLowerBound(index, (INT_PTR)(((size_t)Random() << 8 ^ Random()) % (size_t)position));
+        }
+        double findNs = (Now() - start) * 1000.0 / LOOKUP_RUNS;
+
+        /* A character typed and deleted again - the matches after it move, none are added */
+        start = Now();
+        for (int run = 0; run < EDIT_RUNS; run++) {
+            INT_PTR at = (INT_PTR)(Random() % (unsigned int)(position / 2));
+            MatchIndexSplice(index, at, at, 1, NULL, 0);
+            MatchIndexSplice(index, at, at + 1, -1, NULL, 0);
+        }
+        double moveUs = (Now() - start) / (EDIT_RUNS * 2);
+
+        /* A match typed near the start and removed again - everything after is rebuilt */
+        start = Now();
+        for (int run = 0; run < REBUILD_RUNS; run++) {
+            INT_PTR at = MatchIndexAt(index, 10) + 1;
+            MatchIndexSplice(index, at, at, 3, &at, 1);
+            MatchIndexSplice(index, at, at + 3, -3, NULL, 0);
+        }
+        double rebuildMs = (Now() - start) / 1000.0 / (REBUILD_RUNS * 2);
+
+        if (MatchIndexCount(index) != count) {
+            printf("Index has %zu matches after the edits, expected %zu\n", MatchIndexCount(index), count);
+            return 1;
+        }
+
+        printf("%9dM %10.1f %12.1f %10.1f %10.1f %10.1f %10.1f %12.1f\n", counts[c], buildMs, rangesMB,
+               indexMB, atNs, findNs, moveUs, rebuildMs);
+        FreeMatchIndex(index);
+        (void)sink;
+    }
+    return 0;
+}
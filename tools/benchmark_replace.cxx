@@ -0,0 +1,219 @@
+/*
+ * Replace All benchmark for Notepad+
+ *
+ * Compares replacing every occurrence of a word with the loop an application writes
+ * with SCI_SEARCHINTARGET and SCI_REPLACETARGET - find the next match, delete it,
+ * insert the replacement, one undo action and four notifications per match - against
+ * Document::ReplaceAll behind SCI_REPLACEALLINTARGET, which finds every match first
+ * and then replaces them from the last back to the first inside a single undo action.
+ * Both run on Scintilla's Document directly with a watcher counting notifications,
+ * so the editor's own per-notification work (and the application's) comes on top
+ * of the loop's figures. Undo times are for stepping back to the original text, and
+ * the last column checks both ways give the same text and that one undo restores it.
+ *
+ * Build and run from the repository root:
+ *     g++ -O2 -std=c++17 -pthread -Iscintilla/include -Iscintilla/src tools/benchmark_replace.cxx
+ *         scintilla/src/{CaseConvert,CaseFolder,CellBuffer,ChangeHistory,CharacterCategoryMap,
+ *         CharClassify,Compression,Decoration,Document,LinearRegex,LiteralSearch,PerLine,
+ *         PieceTable,RESearch,RunStyles,UndoHistory,UniConversion}.cxx -o bin/benchmark_replace.exe
+ *     bin\benchmark_replace.exe [largest size in MB] [largest size for the loop in MB]
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <optional>
+#include <algorithm>
+#include <memory>
+#include <chrono>
+
+#include "ScintillaTypes.h"
+#include "ILoader.h"
+#include "ILexer.h"
+
+#include "Debugging.h"
+
+#include "CharacterCategoryMap.h"
+#include "Position.h"
+#include "SplitVector.h"
+#include "Partitioning.h"
+#include "RunStyles.h"
+#include "CellBuffer.h"
+#include "CharClassify.h"
+#include "Decoration.h"
+#include "CaseFolder.h"
+#include "Document.h"
+
+using namespace Scintilla;
+using namespace Scintilla::Internal;
+
+void Platform::Assert(const char *c, const char *file, int line) noexcept {
+    fprintf(stderr, "Assertion [%s] failed at %s %d\n", c, file, line);
+    abort();
+}
+
+void Platform::DebugPrintf(const char *format, ...) noexcept {
+    va_list pArguments;
+    va_start(pArguments, format);
+    vfprintf(stderr, format, pArguments);
+    va_end(pArguments);
+}
+
+/* Stands in for the editor, which is told about every change */
+class CountingWatcher : public DocWatcher {
+public:
+    size_t modifications = 0;
+    void NotifyModifyAttempt(Document *, void *) override {}
+    void NotifySavePoint(Document *, void *, bool) override {}
+    void NotifyModified(Document *, DocModification, void *) override { modifications++; }
+    void NotifyDeleted(Document *, void *) noexcept override {}
+    void NotifyStyleNeeded(Document *, void *, Sci::Position) override {}
+    void NotifyErrorOccurred(Document *, void *, Status) override {}
+    void NotifyGroupCompleted(Document *, void *) noexcept override {}
+};
+
+static unsigned int g_seed = 12345;
+
+static unsigned int Random() {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return (g_seed >> 8) & 0xFFFFFF;
+}
+
+static double Now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Source-like lines where about one word in 30 is the one replaced */
+static std::string MakeText(size_t size) {
+    static const char *const words[] = {
+        "buffer", "length", "index", "window", "editor", "result", "count", "value",
+        "position", "line", "style", "text", "offset", "start", "finish"
+    };
+    std::string text;
+    text.reserve(size + 64);
+    while (text.size() < size) {
+        const int wordsOnLine = 4 + Random() % 8;
+        text += "    ";
+        for (int w = 0; w < wordsOnLine; w++) {
+            text += (Random() % 30 == 0) ? "needle" : words[Random() % std::size(words)];
+            text += (w + 1 < wordsOnLine) ? " " : ";\n";
+        }
+    }
+    text.resize(size);
+    return text;
+}
+
+static std::unique_ptr<Document> MakeDocument(const std::string &text, CountingWatcher &watcher) {
+    std::unique_ptr<Document> doc = std::make_unique<Document>(DocumentOption::Default);
+    doc->SetDBCSCodePage(CpUtf8);
+    doc->SetCaseFolder(std::make_unique<CaseFolderUnicode>());
+    doc->InsertString(0, text);
+    doc->DeleteUndoHistory();
+    doc->AddWatcher(&watcher, nullptr);
+    return doc;
+}
+
+/* The SCI_SEARCHINTARGET / SCI_REPLACETARGET loop */
+static Sci::Position ReplaceLoop(Document &doc, std::string_view search, FindOption flags, std::string_view replacement) {
+    Sci::Position count = 0;
+    Sci::Position start = 0;
+    for (;;) {
+        Sci::Position length = search.length();
+        const Sci::Position pos = doc.FindText(start, doc.Length(), search.data(), flags, &length);
+        if (pos < 0) {
+            break;
+        }
+        std::string_view text = replacement;
+        std::string substituted;
+        if (FlagSet(flags, FindOption::RegExp)) {
+            Sci::Position lengthSubstituted = replacement.length();
+            substituted = doc.SubstituteByPosition(replacement.data(), &lengthSubstituted);
+            text = substituted;
+        }
+        doc.DeleteChars(pos, length);
+        doc.InsertString(pos, text);
+        start = pos + text.length() + (length == 0 ? 1 : 0);
+        count++;
+    }
+    return count;
+}
+
+/* Undo everything back to the original text, one step at a time as the user would */
+static double UndoAll(Document &doc, size_t *steps) {
+    const double start = Now();
+    *steps = 0;
+    while (doc.CanUndo()) {
+        doc.Undo();
+        (*steps)++;
+    }
+    return Now() - start;
+}
+
+static std::string Contents(const Document &doc) {
+    std::string result(doc.Length(), '\0');
+    doc.GetCharRange(result.data(), 0, doc.Length());
+    return result;
+}
+
+static void Run(const char *name, const std::string &text, std::string_view search, FindOption flags,
+    std::string_view replacement, bool runLoop) {
+    char loopColumns[64] = "           -          -           -";
+    std::string loopResult;
+    if (runLoop) {
+        CountingWatcher watcher;
+        std::unique_ptr<Document> doc = MakeDocument(text, watcher);
+        const double start = Now();
+        ReplaceLoop(*doc, search, flags, replacement);
+        const double seconds = Now() - start;
+        const size_t notifications = watcher.modifications;
+        loopResult = Contents(*doc);
+        size_t steps = 0;
+        const double undoSeconds = UndoAll(*doc, &steps);
+        snprintf(loopColumns, sizeof(loopColumns), "%12.3f %10zu %11.3f", seconds, notifications, undoSeconds);
+        doc->RemoveWatcher(&watcher, nullptr);
+    }
+
+    CountingWatcher watcher;
+    std::unique_ptr<Document> doc = MakeDocument(text, watcher);
+    Range changed;
+    const double start = Now();
+    const Sci::Position count = doc->ReplaceAll(0, doc->Length(), search.data(), flags, search.length(),
+        replacement, FlagSet(flags, FindOption::RegExp), changed);
+    const double seconds = Now() - start;
+    const size_t notifications = watcher.modifications;
+    const bool same = !runLoop || (Contents(*doc) == loopResult);
+    size_t steps = 0;
+    const double undoSeconds = UndoAll(*doc, &steps);
+    const bool restored = (steps == 1) && (Contents(*doc) == text);
+    doc->RemoveWatcher(&watcher, nullptr);
+
+    printf("%6u MB %-8s %9lld %s %12.3f %10zu %11.3f %6s\n", static_cast<unsigned int>(text.size() >> 20), name,
+        static_cast<long long>(count), loopColumns, seconds, notifications, undoSeconds,
+        (same && restored) ? "yes" : "NO");
+}
+
+int main(int argc, char **argv) {
+    const int largest = argc > 1 ? atoi(argv[1]) : 200;
+    const int largestLoop = argc > 2 ? atoi(argv[2]) : 200;
+    static const int sizes[] = { 10, 50, 200 };
+
+    printf("%9s %-8s %9s %12s %10s %11s %12s %10s %11s %6s\n", "Size", "Search", "Matches", "Loop (s)", "Notified",
+        "Undo (s)", "Batched (s)", "Notified", "Undo (s)", "Same");
+    for (const int size : sizes) {
+        if (size > largest) {
+            break;
+        }
+        const std::string text = MakeText(static_cast<size_t>(size) << 20);
+        Run("literal", text, "needle", FindOption::MatchCase, "haystack", size <= largestLoop);
+        Run("regex", text, "(ne+)dle", FindOption::RegExp | FindOption::Posix, "\\1ar", size <= largestLoop);
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * Parallel search benchmark for Notepad+
+ *
+ * Times counting and finding every match in a large document, as Count and the
+ * word highlighting do with SCI_FINDALL, with the document's text searched on one
+ * thread and split into chunks of whole lines searched on more threads. Runs
+ * Scintilla's Document directly so the figures are the search alone. The last
+ * column checks every thread count finds the same matches as one thread.
+ *
+ * Build and run from the repository root:
+ *     g++ -O2 -std=c++17 -Iscintilla/include -Iscintilla/src tools/benchmark_search.cxx
+ *         scintilla/src/{CaseConvert,CaseFolder,CellBuffer,ChangeHistory,CharacterCategoryMap,
+ *         CharClassify,Decoration,Document,PerLine,RESearch,RunStyles,
+ *         UndoHistory,UniConversion}.cxx -o bin/benchmark_search.exe
+ *     bin\benchmark_search.exe [size in MB] [most threads]
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <optional>
+#include <algorithm>
+#include <memory>
+#include <chrono>
+#include <thread>
+
+#include "ScintillaTypes.h"
+#include "ILoader.h"
+#include "ILexer.h"
+
+#include "Debugging.h"
+
+#include "CharacterCategoryMap.h"
+#include "Position.h"
+#include "SplitVector.h"
+#include "Partitioning.h"
+#include "RunStyles.h"
+#include "CellBuffer.h"
+#include "CharClassify.h"
+#include "Decoration.h"
+#include "CaseFolder.h"
+#include "Document.h"
+
+using namespace Scintilla;
+using namespace Scintilla::Internal;
+
+void Platform::Assert(const char *c, const char *file, int line) noexcept {
+    fprintf(stderr, "Assertion [%s] failed at %s %d\n", c, file, line);
+    abort();
+}
+
+void Platform::DebugPrintf(const char *format, ...) noexcept {
+    va_list pArguments;
+    va_start(pArguments, format);
+    vfprintf(stderr, format, pArguments);
+    va_end(pArguments);
+}
+
+static unsigned int g_seed = 12345;
+
+static unsigned int Random() {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return (g_seed >> 8) & 0xFFFFFF;
+}
+
+static double Now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Source-like lines where about one word in 30 is the one searched for */
+static std::string MakeText(size_t size) {
+    static const char *const words[] = {
+        "buffer", "length", "index", "window", "editor", "result", "count", "value",
+        "position", "line", "style", "text", "offset", "start", "finish"
+    };
+    std::string text;
+    text.reserve(size + 64);
+    while (text.size() < size) {
+        const int wordsOnLine = 4 + Random() % 8;
+        text += "    ";
+        for (int w = 0; w < wordsOnLine; w++) {
+            text += (Random() % 30 == 0) ? "Needle" : words[Random() % std::size(words)];
+            text += (w + 1 < wordsOnLine) ? " " : ";\n";
+        }
+    }
+    text.resize(size);
+    return text;
+}
+
+static void Run(Document &doc, const char *name, std::string_view search, FindOption flags, unsigned int mostThreads) {
+    std::vector<Range> expected;
+    doc.FindAll(0, doc.Length(), search.data(), flags, search.length(), &expected, doc.Length(), 1);
+    printf("%-10s %9zu", name, expected.size());
+    bool same = true;
+    for (unsigned int threads = 1; threads <= mostThreads; threads *= 2) {
+        double start = Now();
+        doc.FindAll(0, doc.Length(), search.data(), flags, search.length(), nullptr, 0, threads);
+        const double countSeconds = Now() - start;
+        std::vector<Range> matches;
+        start = Now();
+        doc.FindAll(0, doc.Length(), search.data(), flags, search.length(), &matches, doc.Length(), threads);
+        const double findSeconds = Now() - start;
+        same = same && (matches == expected);
+        printf(" %8.3f/%-8.3f", countSeconds, findSeconds);
+    }
+    printf(" %6s\n", same ? "yes" : "NO");
+}
+
+int main(int argc, char **argv) {
+    const int size = argc > 1 ? atoi(argv[1]) : 200;
+    const unsigned int mostThreads = argc > 2 ? atoi(argv[2]) : std::max(std::thread::hardware_concurrency(), 1U);
+
+    std::unique_ptr<Document> doc = std::make_unique<Document>(DocumentOption::Default);
+    doc->SetDBCSCodePage(CpUtf8);
+    doc->SetCaseFolder(std::make_unique<CaseFolderUnicode>());
+    doc->InsertString(0, MakeText(static_cast<size_t>(size) << 20));
+    doc->DeleteUndoHistory();
+
+    printf("%d MB, count/find all in seconds\n%-10s %9s", size, "Search", "Matches");
+    for (unsigned int threads = 1; threads <= mostThreads; threads *= 2) {
+        printf(" %8u %-8s", threads, threads == 1 ? "thread" : "threads");
+    }
+    printf(" %6s\n", "Same");
+    Run(*doc, "literal", "Needle", FindOption::MatchCase, mostThreads);
+    Run(*doc, "nocase", "needle", FindOption::None, mostThreads);
+    Run(*doc, "word", "index", FindOption::MatchCase | FindOption::WholeWord, mostThreads);
+    Run(*doc, "regex", "Ne+dle", FindOption::RegExp | FindOption::Posix, mostThreads);
+    Run(*doc, "cxx11", "Ne+dle", FindOption::RegExp | FindOption::Cxx11RegEx, mostThreads);
+    return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * Content sniffing benchmark for Notepad+
+ *
+ * Runs SniffLanguage over every file listed in tools/sniff_corpus/expected.txt,
+ * reports the files it gets wrong, the accuracy and the time per call.
+ * Sniffing runs for every extensionless file during session restore, so each
+ * call has to stay in the microseconds.
+ *
+ * Build and run from the repository root:
+ *     gcc -O2 -Isrc tools/benchmark_sniff.c src/sniff.c src/lexer_mappings_generated.c -o bin/benchmark_sniff.exe
+ *     bin\benchmark_sniff.exe [corpus directory]
+ * Exits with 1 when any file is detected wrongly.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sniff.h"
+
+#define MAX_CORPUS_FILES 256
+#define TIMING_RUNS 2000
+
+typedef struct {
+    char name[256];
+    char expected[256];
+    char* text;
+    size_t length;
+    double microseconds;
+} CorpusFile;
+
+static CorpusFile g_files[MAX_CORPUS_FILES];
+
+static double Now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+/* Read at most the sniffing window of a file, as the editor would hand it over */
+static char* ReadStart(const char* path, size_t* length)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+    char* text = (char*)malloc(SNIFF_WINDOW);
+    if (!text) {
+        fclose(file);
+        return NULL;
+    }
+    *length = fread(text, 1, SNIFF_WINDOW, file);
+    fclose(file);
+    return text;
+}
+
+static int CompareDouble(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char** argv)
+{
+    const char* corpus = argc > 1 ? argv[1] : "tools/sniff_corpus";
+    char path[512];
+    snprintf(path, sizeof(path), "%s/expected.txt", corpus);
+    FILE* manifest = fopen(path, "r");
+    if (!manifest) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return 2;
+    }
+
+    int count = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), manifest) && count < MAX_CORPUS_FILES) {
+        line[strcspn(line, "\r\n")] = '\0';
+        char* tab = strchr(line, '\t');
+        if (line[0] == '#' || !tab) {
+            continue;
+        }
+        *tab = '\0';
+        CorpusFile* file = &g_files[count];
+        snprintf(file->name, sizeof(file->name), "%s", line);
+        snprintf(file->expected, sizeof(file->expected), "%s", tab + 1);
+        snprintf(path, sizeof(path), "%s/%s", corpus, file->name);
+        file->text = ReadStart(path, &file->length);
+        if (!file->text) {
+            fprintf(stderr, "Cannot read %s\n", path);
+            fclose(manifest);
+            return 2;
+        }
+        count++;
+    }
+    fclose(manifest);
+
+    /* Accuracy */
+    int correct = 0;
+    for (int i = 0; i < count; i++) {
+        const char* detected = GetLanguageName(SniffLanguage(g_files[i].text, g_files[i].length));
+        if (strcmp(detected, g_files[i].expected) == 0) {
+            correct++;
+        } else {
+            printf("WRONG  %-20s expected %-16s got %s\n", g_files[i].name, g_files[i].expected, detected);
+        }
+    }
+    printf("Accuracy: %d of %d files (%.1f%%)\n", correct, count, count ? 100.0 * correct / count : 0.0);
+
+    /* Latency - the mean of many runs per file, then the spread over files */
+    volatile int sink = 0;
+    double* times = (double*)malloc(sizeof(double) * (count ? count : 1));
+    double total = 0;
+    for (int i = 0; i < count; i++) {
+        double start = Now();
+        for (int run = 0; run < TIMING_RUNS; run++) {
+            sink += SniffLanguage(g_files[i].text, g_files[i].length);
+        }
+        g_files[i].microseconds = (Now() - start) / TIMING_RUNS;
+        times[i] = g_files[i].microseconds;
+        total += times[i];
+    }
+    if (count > 0) {
+        qsort(times, (size_t)count, sizeof(double), CompareDouble);
+        int slowest = 0;
+        for (int i = 1; i < count; i++) {
+            if (g_files[i].microseconds > g_files[slowest].microseconds) {
+                slowest = i;
+            }
+        }
+        printf("Latency per file: mean %.2f us, median %.2f us, max %.2f us (%s, %u bytes)\n",
+               total / count, times[count / 2], times[count - 1],
+               g_files[slowest].name, (unsigned int)g_files[slowest].length);
+    }
+
+    /* Worst case: a full window of words that all have to be looked up */
+    char* words = (char*)malloc(SNIFF_WINDOW);
+    for (size_t i = 0; i < SNIFF_WINDOW; i++) {
+        words[i] = "lorem ipsum dolor sit amet while for return\n"[i % 44];
+    }
+    double start = Now();
+    for (int run = 0; run < TIMING_RUNS; run++) {
+        sink += SniffLanguage(words, SNIFF_WINDOW);
+    }
+    printf("Latency for a full %d byte window of words: %.2f us\n", SNIFF_WINDOW, (Now() - start) / TIMING_RUNS);
+
+    free(words);
+    free(times);
+    for (int i = 0; i < count; i++) {
+        free(g_files[i].text);
+    }
+    return correct == count ? 0 : 1;
+}
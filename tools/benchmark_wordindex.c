@@ -0,0 +1,234 @@
+/*
+ * Word completion benchmark for Notepad+
+ *
+ * Compares the completion latency of the old approach - copy the whole document,
+ * tokenize it with strtok, remove duplicates pairwise and build the list with strcat
+ * on every keystroke - with prefix queries on the word index, over growing documents
+ * of generated source text. Also reports how long indexing a document takes and what
+ * keeping the index up to date costs per edit.
+ *
+ * Build and run from the repository root:
+ *     gcc -O2 -Isrc tools/benchmark_wordindex.c src/wordindex.c -o bin/benchmark_wordindex.exe
+ *     bin\benchmark_wordindex.exe [largest size in MB]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "wordindex.h"
+
+#define VOCABULARY_SIZE 200000
+#define QUERY_RUNS 2000
+#define EDIT_RUNS 2000
+#define OLD_MAX_WORDS 1000
+
+static char* g_vocabulary[VOCABULARY_SIZE];
+static unsigned int g_seed = 12345;
+
+static double Now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+static unsigned int Random(void)
+{
+    g_seed = g_seed * 1103515245u + 12345u;
+    return (g_seed >> 8) & 0xFFFFFF;
+}
+
+/* Identifiers like getWindowRect or max_line_length */
+static void MakeVocabulary(void)
+{
+    static const char* const parts[] = {
+        "get", "set", "window", "line", "text", "buffer", "max", "min", "count", "index",
+        "file", "path", "name", "size", "length", "pos", "start", "end", "tab", "editor",
+        "style", "word", "char", "list", "item", "find", "replace", "load", "save", "Rect"
+    };
+    for (int i = 0; i < VOCABULARY_SIZE; i++) {
+        char word[64];
+        int partCount = 1 + (int)(Random() % 3);
+        word[0] = '\0';
+        for (int p = 0; p < partCount; p++) {
+            const char* part = parts[Random() % (sizeof(parts) / sizeof(parts[0]))];
+            if (p > 0 && Random() % 2) {
+                strcat(word, "_");
+            }
+            strcat(word, part);
+        }
+        if (Random() % 2 == 0) {
+            char number[16];
+            snprintf(number, sizeof(number), "%u", Random() % 1000);
+            strcat(word, number);
+        }
+        g_vocabulary[i] = (char*)malloc(strlen(word) + 1);
+        strcpy(g_vocabulary[i], word);
+    }
+}
+
+/* Source-like text where a few words are common and most are rare */
+static char* MakeDocument(size_t size)
+{
+    static const char* const separators[] = { " ", " ", " = ", "(", ", ", ");\n    ", ".", "\n" };
+    char* text = (char*)malloc(size + 1);
+    size_t length = 0;
+    while (length < size) {
+        unsigned int word = (Random() % 8 == 0) ? Random() % VOCABULARY_SIZE : Random() % (VOCABULARY_SIZE / 100);
+        const char* piece = g_vocabulary[word];
+        for (int part = 0; part < 2 && length < size; part++) {
+            size_t pieceLength = strlen(piece);
+            if (length + pieceLength > size) {
+                pieceLength = size - length;
+            }
+            memcpy(text + length, piece, pieceLength);
+            length += pieceLength;
+            piece = separators[Random() % (sizeof(separators) / sizeof(separators[0]))];
+        }
+    }
+    text[size] = '\0';
+    return text;
+}
+
+static int IsWordChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static int CompareStrings(const void* a, const void* b)
+{
+    return strcmp(*(const char**)a, *(const char**)b);
+}
+
+/* The per-keystroke work TriggerWordAutocompleteForEditor used to do */
+static int OldCompletion(const char* document, size_t length, const char* partialWord)
+{
+    size_t charsTyped = strlen(partialWord);
+    char* buffer = (char*)malloc(length + 1);
+    memcpy(buffer, document, length + 1);
+
+    char** words = (char**)malloc(sizeof(char*) * OLD_MAX_WORDS);
+    int wordCount = 0;
+    char* token = strtok(buffer, " \t\n\r.,;:!?()[]{}\"'<>/\\|@#$%^&*+-=~`");
+    while (token != NULL && wordCount < OLD_MAX_WORDS) {
+        if (strlen(token) > charsTyped && _strnicmp(token, partialWord, charsTyped) == 0 &&
+            strcmp(token, partialWord) != 0) {
+            int found = 0;
+            for (int i = 0; i < wordCount; i++) {
+                if (_stricmp(words[i], token) == 0) {
+                    found = 1;
+                    break;
+                }
+            }
+            if (!found) {
+                words[wordCount] = _strdup(token);
+                if (words[wordCount]) {
+                    wordCount++;
+                }
+            }
+        }
+        token = strtok(NULL, " \t\n\r.,;:!?()[]{}\"'<>/\\|@#$%^&*+-=~`");
+    }
+    free(buffer);
+
+    if (wordCount > 0) {
+        qsort(words, wordCount, sizeof(char*), CompareStrings);
+        size_t totalLen = 0;
+        for (int i = 0; i < wordCount; i++) {
+            totalLen += strlen(words[i]) + 1;
+        }
+        char* wordList = (char*)malloc(totalLen + 1);
+        wordList[0] = '\0';
+        for (int i = 0; i < wordCount; i++) {
+            if (i > 0) strcat(wordList, " ");
+            strcat(wordList, words[i]);
+        }
+        free(wordList);
+    }
+    for (int i = 0; i < wordCount; i++) {
+        free(words[i]);
+    }
+    free(words);
+    return wordCount;
+}
+
+/* A prefix of two or three characters of a vocabulary word, as typed before completing */
+static void RandomPrefix(char* prefix)
+{
+    const char* word = g_vocabulary[Random() % (VOCABULARY_SIZE / 100)];
+    size_t length = 2 + Random() % 2;
+    if (length > strlen(word)) {
+        length = strlen(word);
+    }
+    memcpy(prefix, word, length);
+    prefix[length] = '\0';
+}
+
+int main(int argc, char** argv)
+{
+    int largest = argc > 1 ? atoi(argv[1]) : 50;
+    static const int sizes[] = { 1, 10, 50, 100 };
+
+    MakeVocabulary();
+    printf("%8s %12s %12s %10s %12s %12s\n", "Size", "Old (ms)", "Index (us)", "Words", "Build (ms)", "Edit (us)");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && sizes[s] <= largest; s++) {
+        size_t size = (size_t)sizes[s] * 1024 * 1024;
+        char* document = MakeDocument(size);
+        char prefix[8];
+
+        /* Old approach - a few runs, each copies and tokenizes everything */
+        int oldRuns = sizes[s] >= 50 ? 3 : 10;
+        double start = Now();
+        for (int run = 0; run < oldRuns; run++) {
+            RandomPrefix(prefix);
+            OldCompletion(document, size, prefix);
+        }
+        double oldMs = (Now() - start) / oldRuns / 1000.0;
+
+        /* Indexing the whole document, as the scan does in the background */
+        start = Now();
+        WordIndex* index = CreateWordIndex();
+        WordIndexAddWords(index, document, size);
+        double buildMs = (Now() - start) / 1000.0;
+
+        /* Completion queries */
+        volatile int sink = 0;
+        start = Now();
+        for (int run = 0; run < QUERY_RUNS; run++) {
+            char* list = NULL;
+            RandomPrefix(prefix);
+            sink += WordIndexComplete(index, prefix, strlen(prefix), 1000, &list);
+            free(list);
+        }
+        double queryUs = (Now() - start) / QUERY_RUNS;
+
+        /* An edit: the words around the change are removed, then added back changed */
+        start = Now();
+        for (int run = 0; run < EDIT_RUNS; run++) {
+            size_t position = Random() % (size / 2);
+            size_t end = position + 40;
+            while (IsWordChar(document[position])) {
+                position++;
+            }
+            while (IsWordChar(document[end])) {
+                end++;
+            }
+            WordIndexRemoveWords(index, document + position, end - position);
+            WordIndexAddWords(index, document + position, end - position);
+        }
+        double editUs = (Now() - start) / EDIT_RUNS;
+
+        printf("%6d MB %12.2f %12.2f %10u %12.1f %12.2f\n", sizes[s], oldMs, queryUs,
+               (unsigned int)WordIndexWordCount(index), buildMs, editUs);
+
+        FreeWordIndex(index);
+        free(document);
+    }
+
+    for (int i = 0; i < VOCABULARY_SIZE; i++) {
+        free(g_vocabulary[i]);
+    }
+    return 0;
+}
@@ -8,7 +8,9 @@ This script:
 2. Downloads authoritative extension mappings from GitHub Linguist
 3. Extracts keywords from lexers (when available) or uses curated databases
 4. Generates static C lookup tables and keyword arrays
-5. Produces optimized code for instantaneous runtime access
+5. Builds a perfect hash table over extensions, file names, shebang interpreters and aliases
+6. Builds weighted keyword tables for detecting the language of files without a known name
+7. Produces optimized code for instantaneous runtime access
 """
 
 import os
@@ -20,6 +22,7 @@ import requests
 from pathlib import Path
 from typing import Dict, List, Optional, Tuple, Any
 import re
+import math
 
 class LexerCodeGenerator:
     """Generates static C code for comprehensive syntax highlighting support."""
@@ -253,6 +256,69 @@ class LexerCodeGenerator:
             },
         }
 
+        # Keyword lists above that content sniffing scores, and the Linguist language each one stands for.
+        # Markup, data formats and the registry are recognised by their structure instead.
+        self.SNIFF_KEYWORD_LANGUAGES = {
+            "python": "Python",
+            "rust": "Rust",
+            "cpp": "C++",
+            "javascript": "JavaScript",
+            "java": "Java",
+            "csharp": "C#",
+            "go": "Go",
+            "ruby": "Ruby",
+            "sql": "SQL",
+            "bash": "Shell",
+            "powershell": "PowerShell",
+            "lua": "Lua",
+            "perl": "Perl",
+            "r": "R",
+            "matlab": "MATLAB",
+            "scala": "Scala",
+            "kotlin": "Kotlin",
+            "swift": "Swift",
+            "dart": "Dart",
+            "julia": "Julia",
+            "haskell": "Haskell",
+            "clojure": "Clojure",
+            "erlang": "Erlang",
+            "fortran": "Fortran",
+            "pascal": "Pascal",
+            "ada": "Ada",
+            "vhdl": "VHDL",
+            "verilog": "Verilog",
+        }
+
+        # Keywords that are also everyday English words say nothing about code, so logs and notes
+        # full of them aren't taken for a language whose keyword list happens to contain them
+        self.SNIFF_ENGLISH_WORDS = set("""
+            a about after all an and are as at be been before block body but by can case data default
+            do down each entry error event file filter finally first for from group has have if in into
+            is it its label last left library like map may more new next no not now of on once one only
+            open or order others out over range record release report right run set should some than
+            that the this time to transport type under unit until up use used user was we were when
+            where which while will with without wait yes you
+        """.split())
+
+        # Words typical of a language's programs rather than its grammar, added to the sniffing
+        # statistics. A word preceded by '#' is only counted with the '#'.
+        self.SNIFF_EXTRA_KEYWORDS = {
+            "C": "auto break case char const continue default do double else enum extern float for goto if inline int long register restrict return short signed sizeof static struct switch typedef union unsigned void volatile while _Bool "
+                 "#include #define #ifdef #ifndef #endif #pragma printf fprintf sprintf malloc calloc free memcpy strlen NULL size_t stdio stdlib",
+            "C++": "#include #define std cout cerr endl nullptr template typename namespace vector string unique_ptr shared_ptr",
+            "Python": "self def elif None True False __init__ __name__ __main__ import print len range",
+            "Shell": "echo fi esac then done export local unset shift exit readonly",
+            "JavaScript": "function const let var require console module exports document window undefined async await prototype",
+            "Perl": "my sub use strict warnings print foreach elsif unless chomp qw",
+            "Ruby": "def end puts require attr_accessor attr_reader module elsif unless nil",
+            "Lua": "local function end then elseif nil require pairs ipairs",
+            "Go": "package func chan defer fmt Println",
+            "Rust": "fn let mut impl pub use struct enum match crate println Vec Option Some",
+            "SQL": "SELECT INSERT UPDATE DELETE CREATE TABLE ALTER DROP INTO VALUES PRIMARY KEY VARCHAR INTEGER",
+            "PowerShell": "param Write Host Output Get Set Object ForEach",
+            "Makefile": "ifeq ifneq ifdef ifndef endif endef PHONY CFLAGS LDFLAGS",
+        }
+
     def download_linguist_data(self) -> Dict[str, Any]:
         """Download GitHub Linguist language definitions."""
         print("Downloading GitHub Linguist language data...")
@@ -323,12 +389,15 @@ class LexerCodeGenerator:
 
         return keywords
 
-    def generate_language_mappings(self, linguist_data: Dict[str, Any]) -> Tuple[Dict[str, List[str]], Dict[str, str]]:
-        """Generate extension-to-language and language-to-lexer mappings."""
+    def generate_language_mappings(self, linguist_data: Dict[str, Any]) -> Tuple[Dict[str, str], Dict[str, str], Dict[str, str], Dict[str, str]]:
+        """Generate extension, file name and interpreter to language mappings and language-to-lexer mappings."""
         print("Generating language and extension mappings...")
 
-        extension_map = {}  # extension -> language_name
-        language_map = {}   # language_name -> lexer_name
+        extension_map = {}    # extension -> language_name
+        filename_map = {}     # lowercase file name -> language_name
+        interpreter_map = {}  # shebang interpreter -> language_name
+        alias_map = {}        # lowercase language name or alias -> language_name
+        language_map = {}     # language_name -> lexer_name
 
         for linguist_name, lang_data in linguist_data.items():
             if linguist_name not in self.LINGUIST_TO_SCINTILLA:
@@ -345,12 +414,20 @@ class LexerCodeGenerator:
                     ext = '.' + ext
                 extension_map[ext.lower()] = linguist_name
 
-            # Also handle filenames (like "Makefile", "Dockerfile")
+            # Exact file names (like "Makefile", "Dockerfile") - matched without case like extensions
             filenames = lang_data.get('filenames', [])
             for filename in filenames:
-                # For simplicity, we'll create pseudo-extensions for filenames
-                # This is a simplified approach
-                pass
+                filename_map[filename.lower()] = linguist_name
+
+            # Interpreters named on a shebang line (like "python3", "bash")
+            interpreters = lang_data.get('interpreters', [])
+            for interpreter in interpreters:
+                interpreter_map[interpreter.lower()] = linguist_name
+
+            # Names used in editor modelines (like "python", "sh", "make")
+            alias_map.setdefault(linguist_name.lower().replace(' ', '-'), linguist_name)
+            for alias in lang_data.get('aliases', []):
+                alias_map.setdefault(alias.lower(), linguist_name)
 
         # Add manual mappings for languages not in GitHub Linguist
         # Windows Registry files
@@ -364,8 +441,9 @@ class LexerCodeGenerator:
             extension_map[".ts"] = "TypeScript"
             extension_map[".tsx"] = "TypeScript"
 
-        print(f"Generated mappings for {len(language_map)} languages and {len(extension_map)} extensions")
-        return extension_map, language_map
+        print(f"Generated mappings for {len(language_map)} languages, {len(extension_map)} extensions, "
+              f"{len(filename_map)} file names, {len(interpreter_map)} interpreters and {len(alias_map)} aliases")
+        return extension_map, filename_map, interpreter_map, alias_map, language_map
 
     def generate_language_type_enum(self, language_map: Dict[str, str]) -> str:
         """Generate the expanded LanguageType enum."""
@@ -417,24 +495,241 @@ class LexerCodeGenerator:
 
         return "\n".join(lines)
 
-    def generate_extension_mappings(self, extension_map: Dict[str, str], language_map: Dict[str, str]) -> str:
-        """Generate the static extension to LanguageType mapping array."""
+    # Kinds of language key, in the order of the LanguageKeyKind enum
+    LANGUAGE_KEY_KINDS = ["LANGUAGE_KEY_EXTENSION", "LANGUAGE_KEY_FILENAME", "LANGUAGE_KEY_INTERPRETER",
+                          "LANGUAGE_KEY_ALIAS", "LANGUAGE_KEY_SNIFF_TOKEN"]
+
+    @staticmethod
+    def language_key_hash(kind: int, key: str) -> int:
+        """FNV-1a over the kind and the lowercased key. Must match LanguageKeyHash in the generated C code."""
+        h = ((2166136261 ^ kind) * 16777619) & 0xFFFFFFFF
+        for byte in key.lower().encode('ascii'):
+            h = ((h ^ byte) * 16777619) & 0xFFFFFFFF
+        return h
+
+    @staticmethod
+    def language_key_mix(h: int, seed: int) -> int:
+        """Scramble a key hash with a seed so each seed places keys differently.
+        Must match LanguageKeyMix in the generated C code."""
+        h ^= (seed * 0x9E3779B9) & 0xFFFFFFFF
+        h ^= h >> 16
+        h = (h * 0x85EBCA6B) & 0xFFFFFFFF
+        h ^= h >> 13
+        h = (h * 0xC2B2AE35) & 0xFFFFFFFF
+        h ^= h >> 16
+        return h
+
+    def build_perfect_hash(self, keys: List[Tuple[int, str, str]]) -> Tuple[List[Optional[Tuple[int, str, str]]], List[int]]:
+        """Place every (kind, key, enum_name) in its own slot with hash and displace.
+        Keys are first split into buckets with seed 0, then each bucket, largest first,
+        gets the first seed that sends all its keys to free slots. A lookup hashes the key
+        once, mixes the hash with seed 0 and then with the bucket's seed, and compares one entry."""
+        table_size = 1
+        while table_size * 3 < len(keys) * 4:
+            table_size *= 2
+        bucket_count = max(1, table_size // 4)
+
+        hashes = {}
+        buckets: List[List[Tuple[int, str, str]]] = [[] for _ in range(bucket_count)]
+        for entry in keys:
+            kind, key, _ = entry
+            h = self.language_key_hash(kind, key)
+            if h in hashes:
+                raise RuntimeError(f"Keys {hashes[h]!r} and {key!r} have the same hash")
+            hashes[h] = key
+            buckets[self.language_key_mix(h, 0) & (bucket_count - 1)].append(entry)
+
+        slots: List[Optional[Tuple[int, str, str]]] = [None] * table_size
+        seeds = [0] * bucket_count
+        for bucket in sorted(range(bucket_count), key=lambda b: (-len(buckets[b]), b)):
+            if not buckets[bucket]:
+                break
+            for seed in range(1, 0x10000):
+                positions = [self.language_key_mix(self.language_key_hash(kind, key), seed) & (table_size - 1)
+                             for kind, key, _ in buckets[bucket]]
+                if len(set(positions)) == len(positions) and all(slots[p] is None for p in positions):
+                    for position, entry in zip(positions, buckets[bucket]):
+                        slots[position] = entry
+                    seeds[bucket] = seed
+                    break
+            else:
+                raise RuntimeError(f"No perfect hash seed found for bucket {bucket}")
+
+        return slots, seeds
+
+    @staticmethod
+    def language_enum_name(linguist_name: str) -> str:
+        return f"LANG_{linguist_name.upper().replace(' ', '_').replace('+', 'P').replace('#', 'S').replace('-', '_')}"
+
+    def generate_language_keys(self, extension_map: Dict[str, str], filename_map: Dict[str, str],
+                               interpreter_map: Dict[str, str], alias_map: Dict[str, str]) -> Tuple[str, Dict[str, int]]:
+        """Generate the perfect hash table from extensions, file names, interpreters and aliases to LanguageType."""
+        keys = []
+        for kind, key_map in enumerate([extension_map, filename_map, interpreter_map, alias_map]):
+            for key, linguist_name in sorted(key_map.items()):
+                # Lookups fold ASCII case only and the key is embedded in a C string
+                if not key.isascii() or not key.isprintable() or '"' in key or '\\' in key:
+                    continue
+                keys.append((kind, key, self.language_enum_name(linguist_name)))
+
+        slots, seeds = self.build_perfect_hash(keys)
+        sizes = {
+            "count": len(keys),
+            "table_size": len(slots),
+            "bucket_count": len(seeds),
+            "max_length": max(len(key) for _, key, _ in keys),
+        }
+
         lines = []
-        lines.append("/* Extension to LanguageType mapping - generated from GitHub Linguist */")
-        lines.append("const ExtensionMapping g_extensionMappings[] = {")
+        lines.append("/* Extension, file name, interpreter and alias to LanguageType perfect hash - generated from GitHub Linguist */")
+        lines.append("const LanguageKey g_languageKeys[LANGUAGE_KEY_TABLE_SIZE] = {")
+        for position, entry in enumerate(slots):
+            if entry:
+                kind, key, enum_name = entry
+                lines.append(f'    [{position}] = {{"{key}", {len(key)}, {self.LANGUAGE_KEY_KINDS[kind]}, {enum_name}}},')
+        lines.append("};")
+        lines.append("")
+        lines.append("/* Second hash seed of each bucket */")
+        lines.append("static const unsigned short g_languageKeySeeds[LANGUAGE_KEY_BUCKET_COUNT] = {")
+        for start in range(0, len(seeds), 16):
+            lines.append("    " + ", ".join(str(seed) for seed in seeds[start:start + 16]) + ",")
+        lines.append("};")
+        lines.append("")
+        lines.append("/* Must match language_key_hash in tools/generate_lexer_code.py */")
+        lines.append("static unsigned int LanguageKeyHash(LanguageKeyKind kind, const char* key, size_t length) {")
+        lines.append("    unsigned int hash = (2166136261u ^ (unsigned int)kind) * 16777619u;")
+        lines.append("    for (size_t i = 0; i < length; i++) {")
+        lines.append("        unsigned char c = (unsigned char)key[i];")
+        lines.append("        if (c >= 'A' && c <= 'Z') {")
+        lines.append("            c += 'a' - 'A';")
+        lines.append("        }")
+        lines.append("        hash = (hash ^ c) * 16777619u;")
+        lines.append("    }")
+        lines.append("    return hash;")
+        lines.append("}")
+        lines.append("")
+        lines.append("/* Must match language_key_mix in tools/generate_lexer_code.py */")
+        lines.append("static unsigned int LanguageKeyMix(unsigned int hash, unsigned int seed) {")
+        lines.append("    hash ^= seed * 0x9E3779B9u;")
+        lines.append("    hash ^= hash >> 16;")
+        lines.append("    hash *= 0x85EBCA6Bu;")
+        lines.append("    hash ^= hash >> 13;")
+        lines.append("    hash *= 0xC2B2AE35u;")
+        lines.append("    hash ^= hash >> 16;")
+        lines.append("    return hash;")
+        lines.append("}")
+        lines.append("")
+        lines.append("LanguageType LookupLanguageKey(LanguageKeyKind kind, const char* key, size_t length) {")
+        lines.append("    if (!key || length == 0 || length > LANGUAGE_KEY_MAX_LENGTH) {")
+        lines.append("        return LANG_NONE;")
+        lines.append("    }")
+        lines.append("    unsigned int hash = LanguageKeyHash(kind, key, length);")
+        lines.append("    unsigned int bucket = LanguageKeyMix(hash, 0) & (LANGUAGE_KEY_BUCKET_COUNT - 1);")
+        lines.append("    unsigned int slot = LanguageKeyMix(hash, g_languageKeySeeds[bucket]) & (LANGUAGE_KEY_TABLE_SIZE - 1);")
+        lines.append("    const LanguageKey* entry = &g_languageKeys[slot];")
+        lines.append("    if (!entry->key || entry->kind != kind || entry->length != length) {")
+        lines.append("        return LANG_NONE;")
+        lines.append("    }")
+        lines.append("    for (size_t i = 0; i < length; i++) {")
+        lines.append("        char c = key[i];")
+        lines.append("        if (c >= 'A' && c <= 'Z') {")
+        lines.append("            c += 'a' - 'A';")
+        lines.append("        }")
+        lines.append("        if (c != entry->key[i]) {")
+        lines.append("            return LANG_NONE;")
+        lines.append("        }")
+        lines.append("    }")
+        lines.append("    return entry->language;")
+        lines.append("}")
+        lines.append("")
 
-        # Sort extensions for consistency
-        sorted_extensions = sorted(extension_map.items())
+        return "\n".join(lines), sizes
 
-        for ext, linguist_name in sorted_extensions:
-            # Map linguist name to enum name
-            enum_name = f"LANG_{linguist_name.upper().replace(' ', '_').replace('+', 'P').replace('#', 'S').replace('-', '_')}"
-            lines.append(f'    {{"{ext}", {enum_name}}},')
+    def generate_sniff_tokens(self, language_map: Dict[str, str]) -> Tuple[str, Dict[str, int]]:
+        """Generate the keyword statistics used to recognise source code by its content.
+        Each word scores for the languages using it, weighted by how rare it is across them:
+        a word of one language scores high, a word most languages share scores nothing."""
+        words: Dict[str, set] = {}
+        languages = set()
+        for keyword_list, linguist_name in self.SNIFF_KEYWORD_LANGUAGES.items():
+            if linguist_name not in language_map:
+                continue
+            languages.add(linguist_name)
+            for wordlist in self.LANGUAGE_KEYWORDS.get(keyword_list, {}).values():
+                for word in wordlist.split():
+                    words.setdefault(word.lower(), set()).add(linguist_name)
+        for linguist_name, wordlist in self.SNIFF_EXTRA_KEYWORDS.items():
+            if linguist_name not in language_map:
+                continue
+            languages.add(linguist_name)
+            for word in wordlist.split():
+                words.setdefault(word.lower(), set()).add(linguist_name)
+
+        entries = []
+        scores: List[Tuple[str, int]] = []
+        for word, users in sorted(words.items()):
+            if not re.fullmatch(r"#?[a-z_][a-z0-9_]*", word) or word in self.SNIFF_ENGLISH_WORDS:
+                continue
+            weight = round(100 * math.log2(len(languages) / len(users)))
+            if weight <= 0:
+                continue
+            entries.append((self.LANGUAGE_KEY_KINDS.index("LANGUAGE_KEY_SNIFF_TOKEN"), word, (len(scores), len(users))))
+            for linguist_name in sorted(users):
+                scores.append((self.language_enum_name(linguist_name), weight))
+
+        slots, seeds = self.build_perfect_hash(entries)
+        sizes = {
+            "count": len(entries),
+            "table_size": len(slots),
+            "bucket_count": len(seeds),
+            "max_length": max(len(word) for _, word, _ in entries),
+            "score_count": len(scores),
+        }
 
+        lines = []
+        lines.append("/* Content sniffing keywords - weighted by how few languages share each one */")
+        lines.append("const SniffScore g_sniffScores[SNIFF_SCORE_COUNT] = {")
+        for enum_name, weight in scores:
+            lines.append(f"    {{{enum_name}, {weight}}},")
+        lines.append("};")
+        lines.append("")
+        lines.append("const SniffToken g_sniffTokens[SNIFF_TOKEN_TABLE_SIZE] = {")
+        for position, entry in enumerate(slots):
+            if entry:
+                _, word, (first, count) = entry
+                lines.append(f'    [{position}] = {{"{word}", {len(word)}, {count}, {first}}},')
+        lines.append("};")
+        lines.append("")
+        lines.append("static const unsigned short g_sniffTokenSeeds[SNIFF_TOKEN_BUCKET_COUNT] = {")
+        for start in range(0, len(seeds), 16):
+            lines.append("    " + ", ".join(str(seed) for seed in seeds[start:start + 16]) + ",")
         lines.append("};")
         lines.append("")
+        lines.append("const SniffToken* LookupSniffToken(const char* word, size_t length) {")
+        lines.append("    if (length == 0 || length > SNIFF_TOKEN_MAX_LENGTH) {")
+        lines.append("        return NULL;")
+        lines.append("    }")
+        lines.append("    unsigned int hash = LanguageKeyHash(LANGUAGE_KEY_SNIFF_TOKEN, word, length);")
+        lines.append("    unsigned int bucket = LanguageKeyMix(hash, 0) & (SNIFF_TOKEN_BUCKET_COUNT - 1);")
+        lines.append("    unsigned int slot = LanguageKeyMix(hash, g_sniffTokenSeeds[bucket]) & (SNIFF_TOKEN_TABLE_SIZE - 1);")
+        lines.append("    const SniffToken* entry = &g_sniffTokens[slot];")
+        lines.append("    if (!entry->word || entry->length != length) {")
+        lines.append("        return NULL;")
+        lines.append("    }")
+        lines.append("    for (size_t i = 0; i < length; i++) {")
+        lines.append("        char c = word[i];")
+        lines.append("        if (c >= 'A' && c <= 'Z') {")
+        lines.append("            c += 'a' - 'A';")
+        lines.append("        }")
+        lines.append("        if (c != entry->word[i]) {")
+        lines.append("            return NULL;")
+        lines.append("        }")
+        lines.append("    }")
+        lines.append("    return entry;")
+        lines.append("}")
+        lines.append("")
 
-        return "\n".join(lines)
+        return "\n".join(lines), sizes
 
     def generate_lexer_configs(self, language_map: Dict[str, str]) -> str:
         """Generate lexer configuration mappings."""
@@ -577,7 +872,7 @@ class LexerCodeGenerator:
 
         return "\n".join(lines)
 
-    def generate_header_file(self, enum_code: str, extension_count: int) -> str:
+    def generate_header_file(self, enum_code: str, key_sizes: Dict[str, int], sniff_sizes: Dict[str, int]) -> str:
         """Generate the header file content."""
         lines = []
         lines.append("/*")
@@ -595,10 +890,32 @@ class LexerCodeGenerator:
         lines.append("")
         lines.append("")
         lines.append("/* External declarations for generated data structures */")
+        lines.append("typedef enum {")
+        lines.append("    LANGUAGE_KEY_EXTENSION,   /* Extension with its dot, e.g. \".py\" */")
+        lines.append("    LANGUAGE_KEY_FILENAME,    /* Whole file name, e.g. \"Makefile\" */")
+        lines.append("    LANGUAGE_KEY_INTERPRETER, /* Program named by a shebang line, e.g. \"python3\" */")
+        lines.append("    LANGUAGE_KEY_ALIAS,       /* Language name or alias used in modelines, e.g. \"sh\" */")
+        lines.append("    LANGUAGE_KEY_SNIFF_TOKEN  /* Keyword counted by content sniffing - see LookupSniffToken */")
+        lines.append("} LanguageKeyKind;")
+        lines.append("")
         lines.append("typedef struct {")
-        lines.append("    const char* extension;")
-        lines.append("    LanguageType language;")
-        lines.append("} ExtensionMapping;")
+        lines.append("    const char* key;          /* Lowercase, NULL for an empty slot */")
+        lines.append("    unsigned char length;")
+        lines.append("    unsigned char kind;       /* LanguageKeyKind */")
+        lines.append("    unsigned short language;  /* LanguageType */")
+        lines.append("} LanguageKey;")
+        lines.append("")
+        lines.append("typedef struct {")
+        lines.append("    const char* word;         /* Lowercase, NULL for an empty slot */")
+        lines.append("    unsigned char length;")
+        lines.append("    unsigned char scoreCount; /* Languages the word scores for */")
+        lines.append("    unsigned short firstScore; /* Index of the first in g_sniffScores */")
+        lines.append("} SniffToken;")
+        lines.append("")
+        lines.append("typedef struct {")
+        lines.append("    unsigned short language;  /* LanguageType */")
+        lines.append("    unsigned short weight;")
+        lines.append("} SniffScore;")
         lines.append("")
         lines.append("typedef struct {")
         lines.append("    LanguageType language;")
@@ -607,24 +924,41 @@ class LexerCodeGenerator:
         lines.append("    const char* keywords2;")
         lines.append("} LexerConfig;")
         lines.append("")
-        lines.append("extern const ExtensionMapping g_extensionMappings[];")
+        lines.append("extern const LanguageKey g_languageKeys[];")
+        lines.append("extern const SniffToken g_sniffTokens[];")
+        lines.append("extern const SniffScore g_sniffScores[];")
         lines.append("extern const LexerConfig g_lexerConfigs[];")
         lines.append("extern const char* g_fileFilters;")
         lines.append("")
         lines.append("/* Array size constants */")
-        lines.append(f"#define EXTENSION_MAPPING_COUNT {extension_count}")
+        lines.append(f"#define LANGUAGE_KEY_COUNT {key_sizes['count']}")
+        lines.append(f"#define LANGUAGE_KEY_TABLE_SIZE {key_sizes['table_size']}")
+        lines.append(f"#define LANGUAGE_KEY_BUCKET_COUNT {key_sizes['bucket_count']}")
+        lines.append(f"#define LANGUAGE_KEY_MAX_LENGTH {key_sizes['max_length']}")
+        lines.append(f"#define SNIFF_TOKEN_COUNT {sniff_sizes['count']}")
+        lines.append(f"#define SNIFF_TOKEN_TABLE_SIZE {sniff_sizes['table_size']}")
+        lines.append(f"#define SNIFF_TOKEN_BUCKET_COUNT {sniff_sizes['bucket_count']}")
+        lines.append(f"#define SNIFF_TOKEN_MAX_LENGTH {sniff_sizes['max_length']}")
+        lines.append(f"#define SNIFF_SCORE_COUNT {sniff_sizes['score_count']}")
         lines.append("#define LEXER_CONFIG_COUNT 66")
         lines.append("")
         lines.append("/* Function declarations for generated code */")
         lines.append("const char* GetLanguageName(LanguageType language);")
         lines.append("const char* GetLanguageShortName(LanguageType language);")
         lines.append("")
+        lines.append("/* Language of an extension, file name or interpreter in O(1), ignoring ASCII case.")
+        lines.append(" * Returns LANG_NONE when the key is not known. */")
+        lines.append("LanguageType LookupLanguageKey(LanguageKeyKind kind, const char* key, size_t length);")
+        lines.append("")
+        lines.append("/* Sniffing statistics of a word, ignoring ASCII case. Returns NULL for a word that isn't scored. */")
+        lines.append("const SniffToken* LookupSniffToken(const char* word, size_t length);")
+        lines.append("")
         lines.append("#endif /* LEXER_MAPPINGS_GENERATED_H */")
         lines.append("")
 
         return "\n".join(lines)
 
-    def generate_source_file(self, keyword_arrays: str, extension_mappings: str,
+    def generate_source_file(self, keyword_arrays: str, language_keys: str, sniff_tokens: str,
                            lexer_configs: str, file_filters: str, language_map: Dict[str, str]) -> str:
         """Generate the source file content."""
         lines = []
@@ -637,7 +971,8 @@ class LexerCodeGenerator:
         lines.append('#include "lexer_mappings_generated.h"')
         lines.append("")
         lines.append(keyword_arrays)
-        lines.append(extension_mappings)
+        lines.append(language_keys)
+        lines.append(sniff_tokens)
         lines.append(lexer_configs)
         lines.append(file_filters)
         lines.append("/* Language name lookup functions */")
@@ -694,19 +1029,20 @@ class LexerCodeGenerator:
             available_lexers = self.enumerate_lexers()
 
             # Generate mappings
-            extension_map, language_map = self.generate_language_mappings(linguist_data)
+            extension_map, filename_map, interpreter_map, alias_map, language_map = self.generate_language_mappings(linguist_data)
 
             # Generate code sections
             enum_code = self.generate_language_type_enum(language_map)
             keyword_arrays = self.generate_keyword_arrays(language_map)
-            extension_mappings = self.generate_extension_mappings(extension_map, language_map)
+            language_keys, key_sizes = self.generate_language_keys(extension_map, filename_map, interpreter_map, alias_map)
+            sniff_tokens, sniff_sizes = self.generate_sniff_tokens(language_map)
             lexer_configs = self.generate_lexer_configs(language_map)
             file_filters = self.generate_file_filters(language_map)
 
             # Generate files
-            header_content = self.generate_header_file(enum_code, len(extension_map))
+            header_content = self.generate_header_file(enum_code, key_sizes, sniff_sizes)
             source_content = self.generate_source_file(
-                keyword_arrays, extension_mappings, lexer_configs, file_filters, language_map
+                keyword_arrays, language_keys, sniff_tokens, lexer_configs, file_filters, language_map
             )
 
             # Write files
@@ -719,7 +1055,9 @@ class LexerCodeGenerator:
             print("Generated files:")
             print(f"  {self.generated_header}")
             print(f"  {self.generated_source}")
-            print(f"  Mapped {len(language_map)} languages with {len(extension_map)} extensions")
+            print(f"  Mapped {len(language_map)} languages with {key_sizes['count']} extensions, file names, interpreters "
+                  f"and aliases in a {key_sizes['table_size']} slot perfect hash table")
+            print(f"  Scored {sniff_sizes['count']} sniffing keywords")
 
         except Exception as e:
             print(f"Error during generation: {e}")